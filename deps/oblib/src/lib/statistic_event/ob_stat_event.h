@@ -140,6 +140,8 @@ STAT_EVENT_ADD_DEF(SQL_USER_LOGONS_COST_TIME_CUMULATIVE, "user logons time cumul
 STAT_EVENT_ADD_DEF(SQL_LOCAL_TIME, "sql local execute time", ObStatClassIds::SQL, 40116, false, true)
 STAT_EVENT_ADD_DEF(SQL_REMOTE_TIME, "sql remote execute time", ObStatClassIds::SQL, 40117, false, true)
 STAT_EVENT_ADD_DEF(SQL_DISTRIBUTED_TIME, "sql distributed execute time", ObStatClassIds::SQL, 40118, false, true)
+STAT_EVENT_ADD_DEF(SQL_SPILL_RAW_BYTES, "sql spill raw bytes", ObStatClassIds::SQL, 40119, true, true)
+STAT_EVENT_ADD_DEF(SQL_SPILL_COMPRESS_SAVED_BYTES, "sql spill compress saved bytes", ObStatClassIds::SQL, 40120, true, true)
 
 // CACHE
 STAT_EVENT_ADD_DEF(ROW_CACHE_HIT, "row cache hit", ObStatClassIds::CACHE, 50000, true, true)
@@ -206,6 +208,9 @@ STAT_EVENT_ADD_DEF(TABLET_CACHE_MISS, "tablet cache miss", ObStatClassIds::CACHE
 
 STAT_EVENT_ADD_DEF(SCHEMA_HISTORY_CACHE_HIT, "schema history cache hit", ObStatClassIds::CACHE, 50061, false, true)
 STAT_EVENT_ADD_DEF(SCHEMA_HISTORY_CACHE_MISS, "schema history cache miss", ObStatClassIds::CACHE, 50062, false, true)
+STAT_EVENT_ADD_DEF(KVCACHE_ADMISSION_REJECT, "kvcache admission reject", ObStatClassIds::CACHE, 50063, true, true)
+STAT_EVENT_ADD_DEF(MICRO_BLOCK_DISK_CACHE_HIT, "micro block disk cache hit", ObStatClassIds::CACHE, 50064, true, true)
+STAT_EVENT_ADD_DEF(MICRO_BLOCK_DISK_CACHE_MISS, "micro block disk cache miss", ObStatClassIds::CACHE, 50065, true, true)
 
 // STORAGE
 //STAT_EVENT_ADD_DEF(MEMSTORE_LOGICAL_READS, "MEMSTORE_LOGICAL_READS", STORAGE, "MEMSTORE_LOGICAL_READS")
@@ -279,6 +284,8 @@ STAT_EVENT_ADD_DEF(INDEX_BLOCK_CACHE_HIT, "index micro block cache hit", ObStatC
 STAT_EVENT_ADD_DEF(BLOCKSCAN_BLOCK_CNT, "blockscaned data micro block count", ObStatClassIds::STORAGE, 60088, true, true)
 STAT_EVENT_ADD_DEF(BLOCKSCAN_ROW_CNT, "blockscaned row count", ObStatClassIds::STORAGE, 60089, true, true)
 STAT_EVENT_ADD_DEF(PUSHDOWN_STORAGE_FILTER_ROW_CNT, "storage filtered row count", ObStatClassIds::STORAGE, 60090, true, true)
+STAT_EVENT_ADD_DEF(DATA_BLOCK_PREFETCH_STALL_TIME, "data micro block prefetch stall time", ObStatClassIds::STORAGE, 60091, true, true)
+STAT_EVENT_ADD_DEF(DATA_BLOCK_PREFETCH_WASTED_BYTES, "data micro block prefetch wasted bytes", ObStatClassIds::STORAGE, 60092, true, true)
 
 // backup & restore
 STAT_EVENT_ADD_DEF(BACKUP_IO_READ_COUNT, "backup io read count", ObStatClassIds::STORAGE, 69000, true, true)
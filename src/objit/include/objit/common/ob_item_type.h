@@ -2280,6 +2280,8 @@ typedef enum ObItemType
   T_COL_SKIP_INDEX_LIST,
   T_COL_SKIP_INDEX_MIN_MAX,
   T_COL_SKIP_INDEX_SUM,
+  T_COL_SKIP_INDEX_BLOOM_FILTER,
+  T_COL_SKIP_INDEX_NGRAM_BLOOM_FILTER,
   T_MAX //Attention: add a new type before T_MAX
 } ObItemType;
 
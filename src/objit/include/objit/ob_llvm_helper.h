@@ -349,6 +349,12 @@ public:
     ICMP_SLE, //< signed less or equal
   };
 
+  enum OVERFLOWTYPE {
+    SADD_WITH_OVERFLOW, //< signed add
+    SSUB_WITH_OVERFLOW, //< signed sub
+    SMUL_WITH_OVERFLOW, //< signed mul
+  };
+
 public:
   ObLLVMHelper(common::ObIAllocator &allocator)
     : allocator_(allocator),
@@ -395,6 +401,20 @@ public:
   int create_add(ObLLVMValue &value1, int64_t &value2, ObLLVMValue &result);
   int create_sub(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
   int create_sub(ObLLVMValue &value1, int64_t &value2, ObLLVMValue &result);
+  int create_mul(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
+  int create_mul(ObLLVMValue &value1, int64_t &value2, ObLLVMValue &result);
+  int create_and(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
+  int create_and(ObLLVMValue &value1, int64_t &value2, ObLLVMValue &result);
+  int create_or(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
+  int create_shl(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
+  int create_lshr(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result);
+  int create_lshr(ObLLVMValue &value1, int64_t &value2, ObLLVMValue &result);
+  // result = value1 op value2, overflow is an i1 value which is true if the result overflowed.
+  int create_arith_with_overflow(OVERFLOWTYPE type,
+                                 ObLLVMValue &value1,
+                                 ObLLVMValue &value2,
+                                 ObLLVMValue &result,
+                                 ObLLVMValue &overflow);
   int create_ret(ObLLVMValue &value);
   int create_gep(const common::ObString &name, ObLLVMValue &value, common::ObIArray<int64_t> &idxs, ObLLVMValue &result);
   int create_gep(const common::ObString &name, ObLLVMValue &value, common::ObIArray<ObLLVMValue> &idxs, ObLLVMValue &result);
@@ -18,6 +18,7 @@
 #include "llvm/IR/IRBuilder.h"
 #include "llvm/IR/Verifier.h"
 #include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/Intrinsics.h"
 #include "llvm/ExecutionEngine/ExecutionEngine.h"
 #include "llvm/Support/TargetSelect.h"
 #include "llvm/Support/DynamicLibrary.h"
@@ -1294,6 +1295,92 @@ int ObLLVMHelper::create_sub(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMVal
   return ret;
 }
 
+#define DEFINE_CREATE_BINARY_OP(name, op) \
+int ObLLVMHelper::create_##name(ObLLVMValue &value1, ObLLVMValue &value2, ObLLVMValue &result) \
+{ \
+  int ret = OB_SUCCESS; \
+  if (OB_ISNULL(jc_)) { \
+    ret = OB_NOT_INIT; \
+    LOG_WARN("jc is NULL", K(ret)); \
+  } else if (OB_ISNULL(value1.get_v()) || OB_ISNULL(value2.get_v())) { \
+    ret = OB_INVALID_ARGUMENT; \
+    LOG_WARN("value is NULL", K(value1), K(value2), K(ret)); \
+  } else { \
+    llvm::Value *value = jc_->get_builder().op(value1.get_v(), value2.get_v()); \
+    if (OB_ISNULL(value)) { \
+      ret = OB_ERR_UNEXPECTED; \
+      LOG_WARN("failed to create " #name, K(ret)); \
+    } else { \
+      result.set_v(value); \
+    } \
+  } \
+  return ret; \
+}
+
+DEFINE_CREATE_BINARY_OP(mul, CreateMul)
+DEFINE_CREATE_BINARY_OP(and, CreateAnd)
+DEFINE_CREATE_BINARY_OP(or, CreateOr)
+DEFINE_CREATE_BINARY_OP(shl, CreateShl)
+DEFINE_CREATE_BINARY_OP(lshr, CreateLShr)
+
+int ObLLVMHelper::create_arith_with_overflow(OVERFLOWTYPE type,
+                                             ObLLVMValue &value1,
+                                             ObLLVMValue &value2,
+                                             ObLLVMValue &result,
+                                             ObLLVMValue &overflow)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(jc_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("jc is NULL", K(ret));
+  } else if (OB_ISNULL(value1.get_v()) || OB_ISNULL(value2.get_v())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("value is NULL", K(value1), K(value2), K(ret));
+  } else {
+    llvm::Intrinsic::ID id = llvm::Intrinsic::not_intrinsic;
+    switch (type) {
+    case SADD_WITH_OVERFLOW: {
+      id = llvm::Intrinsic::sadd_with_overflow;
+    }
+    break;
+    case SSUB_WITH_OVERFLOW: {
+      id = llvm::Intrinsic::ssub_with_overflow;
+    }
+    break;
+    case SMUL_WITH_OVERFLOW: {
+      id = llvm::Intrinsic::smul_with_overflow;
+    }
+    break;
+    default: {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("Invalid overflow arith type", K(type), K(ret));
+    }
+    break;
+    }
+    if (OB_SUCC(ret)) {
+      llvm::Function *func = llvm::Intrinsic::getDeclaration(
+          jc_->TheModule.get(), id, value1.get_v()->getType());
+      llvm::Value *res = NULL;
+      if (OB_ISNULL(func)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("failed to get intrinsic declaration", K(type), K(ret));
+      } else if (OB_ISNULL(res = jc_->get_builder().CreateCall(
+                     func, {value1.get_v(), value2.get_v()}))) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("failed to create call", K(ret));
+      } else {
+        result.set_v(jc_->get_builder().CreateExtractValue(res, 0));
+        overflow.set_v(jc_->get_builder().CreateExtractValue(res, 1));
+        if (OB_ISNULL(result.get_v()) || OB_ISNULL(overflow.get_v())) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("failed to create extract value", K(ret));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 #define DEFINE_CREATE_ARITH_INT(name) \
 int ObLLVMHelper::create_##name(ObLLVMValue &value1, int64_t &value2, ObLLVMValue &result) \
 { \
@@ -1309,6 +1396,9 @@ int ObLLVMHelper::create_##name(ObLLVMValue &value1, int64_t &value2, ObLLVMValu
 
 DEFINE_CREATE_ARITH_INT(add)
 DEFINE_CREATE_ARITH_INT(sub)
+DEFINE_CREATE_ARITH_INT(mul)
+DEFINE_CREATE_ARITH_INT(and)
+DEFINE_CREATE_ARITH_INT(lshr)
 
 int ObLLVMHelper::create_ret(ObLLVMValue &value)
 {
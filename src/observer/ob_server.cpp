@@ -91,6 +91,7 @@
 #include "storage/compaction/ob_compaction_diagnose.h"
 #include "storage/ob_file_system_router.h"
 #include "storage/blocksstable/ob_storage_cache_suite.h"
+#include "storage/blocksstable/ob_micro_block_disk_cache.h"
 #include "storage/tablelock/ob_table_lock_rpc_client.h"
 #include "storage/compaction/ob_compaction_diagnose.h"
 #include "share/ash/ob_active_sess_hist_task.h"
@@ -673,6 +674,10 @@ void ObServer::destroy()
     OB_STORE_CACHE.destroy();
     FLOG_INFO("store cache destroyed");
 
+    FLOG_INFO("begin to destroy micro block disk cache");
+    ObMicroBlockDiskCache::get_instance().destroy();
+    FLOG_INFO("micro block disk cache destroyed");
+
     FLOG_INFO("begin to destroy tx data kv cache");
     OB_TX_DATA_KV_CACHE.destroy();
     FLOG_INFO("tx data kv cache destroyed");
@@ -2587,6 +2592,27 @@ int ObServer::init_px_target_mgr()
   return ret;
 }
 
+// the disk cache is optional, observer starts without it if the cache dir is not usable
+int ObServer::init_micro_block_disk_cache()
+{
+  int ret = OB_SUCCESS;
+  const char *dir = GCONF._micro_block_disk_cache_dir.str();
+  const int64_t cache_size = GCONF._micro_block_disk_cache_size;
+  ObMicroBlockDiskCache &disk_cache = ObMicroBlockDiskCache::get_instance();
+  if (OB_ISNULL(dir) || 0 == STRLEN(dir) || 0 == cache_size) {
+    LOG_INFO("micro block disk cache is disabled", K(dir), K(cache_size));
+  } else if (OB_FAIL(disk_cache.init(dir, cache_size))) {
+    LOG_WARN("fail to init micro block disk cache", KR(ret), K(dir), K(cache_size));
+  } else if (OB_FAIL(disk_cache.start())) {
+    LOG_WARN("fail to start micro block disk cache", KR(ret));
+  }
+  if (OB_FAIL(ret)) {
+    disk_cache.destroy();
+    ret = OB_SUCCESS;
+  }
+  return ret;
+}
+
 int ObServer::init_storage()
 {
   int ret = OB_SUCCESS;
@@ -2641,6 +2667,8 @@ int ObServer::init_storage()
                                     storage_env_.bf_cache_miss_count_threshold_,
                                     storage_env_.storage_meta_cache_priority_))) {
       LOG_WARN("Fail to init OB_STORE_CACHE, ", KR(ret), K(storage_env_.data_dir_));
+    } else if (OB_FAIL(init_micro_block_disk_cache())) {
+      LOG_WARN("fail to init micro block disk cache", KR(ret));
     } else if (OB_FAIL(ObTmpFileManager::get_instance().init())) {
       LOG_WARN("fail to init temp file manager", KR(ret));
     } else if (OB_FAIL(OB_SERVER_BLOCK_MGR.init(THE_IO_DEVICE,
@@ -273,6 +273,7 @@ private:
   int init_ts_mgr();
   int init_px_target_mgr();
   int init_storage();
+  int init_micro_block_disk_cache();
   int init_tx_data_cache();
   int init_gc_partition_adapter();
   int init_loaddata_global_stat();
@@ -245,6 +245,13 @@ int ObServerReloadConfig::operator()()
       STRNCPY(last_storage_check_mod, GCONF._storage_leak_check_mod.str(), sizeof(last_storage_check_mod));
     }
   }
+
+  {
+    int tmp_ret = ObKVGlobalCache::get_instance().reload_admission_filter(GCONF._cache_admission_filter.str());
+    if (OB_SUCCESS != tmp_ret) {
+      LOG_WARN("reload _cache_admission_filter failed", K(tmp_ret), K(GCONF._cache_admission_filter.str()));
+    }
+  }
 #ifndef ENABLE_SANITY
   {
     ObMallocAllocator::get_instance()->force_explict_500_malloc_ =
@@ -291,6 +291,10 @@ int ObInfoSchemaKvCacheTable::process_row(const ObKVCacheInst *inst)
         cells_[cell_idx].set_int(inst->status_.hold_size_);
         break;
       }
+      case ADMISSION_REJECT_CNT: {
+        cells_[cell_idx].set_int(inst->status_.admission_reject_cnt_.value());
+        break;
+      }
       default: {
         ret = OB_ERR_UNEXPECTED;
         SERVER_LOG(WARN, "Invalid column id", K(ret), K(cell_idx), K(output_column_ids_), K(col_id));
@@ -949,6 +949,78 @@ int ObKVGlobalCache::set_storage_leak_check_mod(const char *check_mod)
   return ret;
 }
 
+int ObKVGlobalCache::reload_admission_filter(const char *cache_names)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVGlobalCache has not been inited", K(ret));
+  } else if (OB_ISNULL(cache_names)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "Invalid argument", K(ret), KP(cache_names));
+  } else {
+    lib::ObMutexGuard guard(mutex_);
+    for (int64_t i = 0 ; i < cache_num_ ; ++i) {
+      if (configs_[i].is_valid_) {
+        bool enable = false;
+        ObString names(cache_names);
+        while (!enable && !names.empty()) {
+          ObString name = names.split_on(',');
+          if (name.empty()) {
+            name = names;
+            names.reset();
+          }
+          name = name.trim();
+          enable = (0 == name.compare(configs_[i].cache_name_));
+        }
+        if (enable != ATOMIC_LOAD(&configs_[i].enable_admission_filter_)) {
+          // the filters of cache insts are inited by the first put after enabled
+          ATOMIC_STORE(&configs_[i].enable_admission_filter_, enable);
+          COMMON_LOG(INFO, "set kvcache admission filter", K(i), "cache_name", configs_[i].cache_name_, K(enable));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+bool ObKVGlobalCache::admit(const int64_t cache_id, const ObIKVCacheKey &key)
+{
+  int ret = OB_SUCCESS;
+  bool admitted = true;
+  ObKVCacheInstKey inst_key(cache_id, key.get_tenant_id());
+  ObKVCacheInstHandle inst_handle;
+  if (OB_UNLIKELY(!inst_key.is_valid())
+      || !ATOMIC_LOAD(&configs_[cache_id].enable_admission_filter_)) {
+  } else if (OB_FAIL(insts_.get_cache_inst(inst_key, inst_handle))) {
+    COMMON_LOG(WARN, "Fail to get cache inst, ", K(ret), K(inst_key));
+  } else if (OB_ISNULL(inst_handle.get_inst())) {
+    ret = OB_ERR_UNEXPECTED;
+    COMMON_LOG(WARN, "The inst is NULL, ", K(ret), K(inst_key));
+  } else {
+    admitted = admit(*inst_handle.get_inst(), key);
+  }
+  return admitted;
+}
+
+bool ObKVGlobalCache::admit(ObKVCacheInst &inst, const ObIKVCacheKey &key)
+{
+  int ret = OB_SUCCESS;
+  bool admit = true;
+  if (!inst.need_admission_filter()) {
+  } else if (!inst.admission_filter_.is_inited()
+             && OB_FAIL(inst.admission_filter_.init(inst.tenant_id_))) {
+    if (OB_EAGAIN != ret && OB_INIT_TWICE != ret) {
+      COMMON_LOG(WARN, "Fail to init admission filter", K(ret), K(inst));
+    }
+  } else if (!inst.admission_filter_.record_and_admit(key.hash())) {
+    admit = false;
+    inst.status_.admission_reject_cnt_.inc();
+    EVENT_INC(KVCACHE_ADMISSION_REJECT);
+  }
+  return admit;
+}
+
 void ObKVGlobalCache::print_all_cache_info()
 {
   if (OB_UNLIKELY(!inited_)) {
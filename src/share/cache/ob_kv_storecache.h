@@ -49,7 +49,10 @@ public:
   virtual int erase(const Key &key) = 0;
   virtual int alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
       ObKVCachePair *&kvpair, ObKVCacheHandle &handle, ObKVCacheInstHandle &inst_handle) = 0;
+  // kvpair from alloc() is put without the admission filter, call admit() before alloc() if needed
   virtual int put_kvpair(ObKVCacheInstHandle &inst_handle, ObKVCachePair *kvpair, ObKVCacheHandle &handle, bool overwrite = true);
+  // whether a new kv of %key should be put, records the access of %key in the admission filter
+  virtual bool admit(const Key &key) = 0;
 };
 
 template <class Key, class Value>
@@ -71,6 +74,7 @@ public:
   virtual int get(const Key &key, const Value *&pvalue, ObKVCacheHandle &handle);
   int get_iterator(ObKVCacheIterator &iter);
   virtual int erase(const Key &key);
+  virtual bool admit(const Key &key);
   virtual int alloc(
       const uint64_t tenant_id,
       const int64_t key_size,
@@ -106,6 +110,7 @@ public:
       ObKVCacheHandle &handle, bool overwrite = true);
   virtual int get(const Key &key, const Value *&pvalue, ObKVCacheHandle &handle);
   virtual int erase(const Key &key);
+  virtual bool admit(const Key &key);
 
   int64_t get_used() const { return working_set_->get_used(); }
   int64_t get_limit() const { return working_set_->get_limit(); }
@@ -161,6 +166,8 @@ public:
                             const bool wash_single_mb,
                             lib::ObICacheWasher::ObCacheMemBlock *&wash_blocks);
   int set_storage_leak_check_mod(const char *check_mod);
+  // enable admission filter of caches in the comma separated %cache_names, disable the others
+  int reload_admission_filter(const char *cache_names);
   int get_cache_name(const int64_t cache_id, char *cache_name);
 private:
   template<class Key, class Value> friend class ObIKVCache;
@@ -173,6 +180,9 @@ private:
   void deregister_cache(const int64_t cache_id);
   int create_working_set(const ObKVCacheInstKey &inst_key, ObWorkingSet *&working_set);
   int delete_working_set(ObWorkingSet *working_set);
+  // whether a new kv of cache should be stored, always true if admission filter is disabled
+  bool admit(const int64_t cache_id, const ObIKVCacheKey &key);
+  bool admit(ObKVCacheInst &inst, const ObIKVCacheKey &key);
   int set_priority(const int64_t cache_id, const int64_t priority);
   int put(
     const int64_t cache_id,
@@ -553,6 +563,8 @@ int ObKVCache<Key, Value>::put(const Key &key, const Value &value, bool overwrit
   if (OB_UNLIKELY(!inited_)) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObKVCache has not been inited, ", K(ret));
+  } else if (!ObKVGlobalCache::get_instance().admit(cache_id_, key)) {
+    // not admitted by the frequency filter, cache miss next time
   } else if (OB_FAIL(ObKVGlobalCache::get_instance().put(cache_id_, key, value, pvalue,
       handle.mb_handle_, overwrite))) {
     if (OB_ENTRY_EXIST != ret) {
@@ -631,6 +643,12 @@ int ObKVCache<Key, Value>::erase(const Key &key)
   return ret;
 }
 
+template <class Key, class Value>
+bool ObKVCache<Key, Value>::admit(const Key &key)
+{
+  return !inited_ || ObKVGlobalCache::get_instance().admit(cache_id_, key);
+}
+
 template <class Key, class Value>
 int ObKVCache<Key, Value>::alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
     ObKVCachePair *&kvpair, ObKVCacheHandle &handle, ObKVCacheInstHandle &inst_handle)
@@ -855,6 +873,12 @@ int ObCacheWorkingSet<Key, Value>::erase(const Key &key)
   return ret;
 }
 
+template<class Key, class Value>
+bool ObCacheWorkingSet<Key, Value>::admit(const Key &key)
+{
+  return !inited_ || cache_->admit(key);
+}
+
 template<class Key, class Value>
 int ObCacheWorkingSet<Key, Value>::alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
       ObKVCachePair *&kvpair, ObKVCacheHandle &handle, ObKVCacheInstHandle &inst_handle)
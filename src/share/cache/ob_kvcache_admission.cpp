@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX COMMON
+#include "ob_kvcache_admission.h"
+#include "lib/allocator/ob_malloc.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+ObKVCacheAdmissionFilter::ObKVCacheAdmissionFilter()
+  : is_inited_(false),
+    is_initing_(false),
+    width_(0),
+    counters_(NULL),
+    record_cnt_(0),
+    sample_size_(0),
+    is_aging_(false),
+    victim_freq_(0),
+    victim_freq_sum_(0),
+    victim_sample_cnt_(0)
+{
+}
+
+ObKVCacheAdmissionFilter::~ObKVCacheAdmissionFilter()
+{
+  destroy();
+}
+
+int ObKVCacheAdmissionFilter::init(const uint64_t tenant_id, const int64_t width)
+{
+  int ret = OB_SUCCESS;
+  void *buf = NULL;
+  if (OB_UNLIKELY(is_inited())) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("The ObKVCacheAdmissionFilter has been inited, ", K(ret));
+  } else if (OB_UNLIKELY(width < static_cast<int64_t>(sizeof(uint64_t)) || 0 != (width & (width - 1)))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument, width must be power of 2, ", K(width), K(ret));
+  } else if (!ATOMIC_BCAS(&is_initing_, false, true)) {
+    ret = OB_EAGAIN;
+  } else {
+    if (OB_ISNULL(buf = ob_malloc(DEPTH * width, ObMemAttr(tenant_id, "CACHE_ADMIT")))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("Fail to allocate memory for admission counters, ", K(tenant_id), K(width), K(ret));
+    } else {
+      MEMSET(buf, 0, DEPTH * width);
+      counters_ = static_cast<uint8_t *>(buf);
+      width_ = width;
+      record_cnt_ = 0;
+      sample_size_ = SAMPLE_FACTOR * width;
+      is_aging_ = false;
+      victim_freq_ = 0;
+      victim_freq_sum_ = 0;
+      victim_sample_cnt_ = 0;
+      ATOMIC_STORE(&is_inited_, true);
+    }
+    if (OB_FAIL(ret)) {
+      ATOMIC_STORE(&is_initing_, false);
+    }
+  }
+  return ret;
+}
+
+void ObKVCacheAdmissionFilter::destroy()
+{
+  ATOMIC_STORE(&is_inited_, false);
+  if (NULL != counters_) {
+    ob_free(counters_);
+    counters_ = NULL;
+  }
+  width_ = 0;
+  record_cnt_ = 0;
+  sample_size_ = 0;
+  is_aging_ = false;
+  victim_freq_ = 0;
+  victim_freq_sum_ = 0;
+  victim_sample_cnt_ = 0;
+  ATOMIC_STORE(&is_initing_, false);
+}
+
+uint8_t ObKVCacheAdmissionFilter::record(const uint64_t hash)
+{
+  uint8_t min_freq = 0;
+  if (is_inited()) {
+    int64_t pos[DEPTH];
+    min_freq = MAX_FREQUENCY;
+    for (int64_t i = 0; i < DEPTH; ++i) {
+      pos[i] = get_pos(hash, i);
+      min_freq = MIN(min_freq, counters_[pos[i]]);
+    }
+    // conservative update, only the smallest counters are increased, the counters are not
+    // accessed atomically, lost updates under contention only make the estimation lower.
+    if (min_freq < MAX_FREQUENCY) {
+      for (int64_t i = 0; i < DEPTH; ++i) {
+        if (counters_[pos[i]] == min_freq) {
+          counters_[pos[i]] = static_cast<uint8_t>(min_freq + 1);
+        }
+      }
+      ++min_freq;
+    }
+    if (ATOMIC_AAF(&record_cnt_, 1) >= sample_size_) {
+      age();
+    }
+  }
+  return min_freq;
+}
+
+bool ObKVCacheAdmissionFilter::record_and_admit(const uint64_t hash)
+{
+  bool admit = true;
+  if (is_inited()) {
+    admit = record(hash) > get_victim_frequency();
+  }
+  return admit;
+}
+
+uint8_t ObKVCacheAdmissionFilter::estimate(const uint64_t hash) const
+{
+  uint8_t min_freq = 0;
+  if (is_inited()) {
+    min_freq = MAX_FREQUENCY;
+    for (int64_t i = 0; i < DEPTH; ++i) {
+      min_freq = MIN(min_freq, counters_[get_pos(hash, i)]);
+    }
+  }
+  return min_freq;
+}
+
+void ObKVCacheAdmissionFilter::add_victim_sample(const uint8_t freq)
+{
+  victim_freq_sum_ += freq;
+  ++victim_sample_cnt_;
+}
+
+void ObKVCacheAdmissionFilter::refresh_victim_frequency()
+{
+  uint8_t victim_freq = 0;
+  if (victim_sample_cnt_ > 0) {
+    victim_freq = static_cast<uint8_t>((victim_freq_sum_ + victim_sample_cnt_ / 2) / victim_sample_cnt_);
+  }
+  if (victim_freq != get_victim_frequency()) {
+    LOG_DEBUG("refresh kvcache admission victim frequency", K(victim_freq), K(*this));
+  }
+  ATOMIC_STORE(&victim_freq_, victim_freq);
+  victim_freq_sum_ = 0;
+  victim_sample_cnt_ = 0;
+}
+
+void ObKVCacheAdmissionFilter::age()
+{
+  if (ATOMIC_BCAS(&is_aging_, false, true)) {
+    if (ATOMIC_LOAD(&record_cnt_) >= sample_size_) {
+      // halve all one byte counters, 8 counters in one word, the high bit of each byte is
+      // cleared so that no bit is shifted into the neighbour counter
+      uint64_t *words = reinterpret_cast<uint64_t *>(counters_);
+      const int64_t word_cnt = DEPTH * width_ / static_cast<int64_t>(sizeof(uint64_t));
+      for (int64_t i = 0; i < word_cnt; ++i) {
+        words[i] = (words[i] >> 1) & 0x7F7F7F7F7F7F7F7FULL;
+      }
+      ATOMIC_STORE(&record_cnt_, sample_size_ / 2);
+      LOG_DEBUG("age kvcache admission filter", K(*this));
+    }
+    ATOMIC_STORE(&is_aging_, false);
+  }
+}
+
+}//end namespace common
+}//end namespace oceanbase
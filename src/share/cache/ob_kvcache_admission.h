@@ -0,0 +1,88 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_CACHE_OB_KVCACHE_ADMISSION_H_
+#define OCEANBASE_CACHE_OB_KVCACHE_ADMISSION_H_
+
+#include "share/ob_define.h"
+#include "lib/atomic/ob_atomic.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+// Scan resistant admission filter of one kvcache instance (one cache of one tenant).
+//
+// Access frequency of keys is estimated by a count-min sketch of one byte counters saturating
+// at MAX_FREQUENCY, both puts and get hits are recorded. After every SAMPLE_FACTOR * width
+// records all counters are halved (aging), so that the estimation only reflects recent accesses
+// and also remembers keys that were rejected or washed out recently.
+//
+// Like TinyLFU, a new key is admitted only if it is more frequent than the kvs the cache would
+// wash out to make room for it. The victim frequency is sampled by the background wash from the
+// memblocks it washes, and is 0 when the cache is not under memory pressure, so every key is
+// admitted while there is free memory.
+class ObKVCacheAdmissionFilter
+{
+public:
+  static const int64_t DEPTH = 4;
+  static const int64_t DEFAULT_WIDTH = 1L << 18;
+  static const int64_t SAMPLE_FACTOR = 10;
+  static const uint8_t MAX_FREQUENCY = 15;
+public:
+  ObKVCacheAdmissionFilter();
+  ~ObKVCacheAdmissionFilter();
+  // counters are allocated in the memory of %tenant_id, returns OB_EAGAIN if another thread is
+  // initializing the filter
+  int init(const uint64_t tenant_id, const int64_t width = DEFAULT_WIDTH);
+  void destroy();
+  inline bool is_inited() const { return ATOMIC_LOAD(&is_inited_); }
+  // record one access of key and return the estimated frequency including this access
+  uint8_t record(const uint64_t hash);
+  // record one put of key and return whether it is more frequent than the wash victims
+  bool record_and_admit(const uint64_t hash);
+  uint8_t estimate(const uint64_t hash) const;
+  // called by the background wash thread only
+  void add_victim_sample(const uint8_t freq);
+  void refresh_victim_frequency();
+  inline uint8_t get_victim_frequency() const { return ATOMIC_LOAD(&victim_freq_); }
+  TO_STRING_KV(K_(is_inited), K_(width), K_(record_cnt), K_(sample_size), K_(victim_freq));
+private:
+  inline int64_t get_pos(const uint64_t hash, const int64_t row) const
+  {
+    // double hashing, row i uses h1 + i * h2
+    const uint64_t h = hash * 0x9E3779B97F4A7C15ULL;
+    const uint64_t h1 = h >> 32;
+    const uint64_t h2 = (h & 0xFFFFFFFFULL) | 1;
+    return row * width_ + static_cast<int64_t>((h1 + row * h2) & (width_ - 1));
+  }
+  void age();
+private:
+  bool is_inited_;
+  bool is_initing_;
+  int64_t width_;
+  uint8_t *counters_; // DEPTH * width_
+  int64_t record_cnt_;
+  int64_t sample_size_;
+  bool is_aging_;
+  uint8_t victim_freq_;
+  int64_t victim_freq_sum_;
+  int64_t victim_sample_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObKVCacheAdmissionFilter);
+};
+
+}//end namespace common
+}//end namespace oceanbase
+
+#endif //OCEANBASE_CACHE_OB_KVCACHE_ADMISSION_H_
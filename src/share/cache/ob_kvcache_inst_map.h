@@ -24,6 +24,7 @@
 #include "lib/queue/ob_fixed_queue.h"
 #include "lib/lock/ob_drw_lock.h"
 #include "share/cache/ob_cache_utils.h"
+#include "share/cache/ob_kvcache_admission.h"
 #include "share/cache/ob_kvcache_struct.h"
 #include "share/ob_i_tenant_mem_limit_getter.h"
 
@@ -84,6 +85,8 @@ struct ObKVCacheInst
   bool is_delete_;
   int64_t ref_cnt_;
   ObTenantMBListHandle mb_list_handle_; // list of tenant mbs
+  // lazily inited when the admission filter of cache is enabled, freed with the inst
+  ObKVCacheAdmissionFilter admission_filter_;
   ObKVCacheInst()
     : cache_id_(0),
       tenant_id_(0),
@@ -91,7 +94,8 @@ struct ObKVCacheInst
       status_(),
       is_delete_(false),
       ref_cnt_(0),
-      mb_list_handle_() { MEMSET(handles_, 0, sizeof(handles_)); }
+      mb_list_handle_(),
+      admission_filter_() { MEMSET(handles_, 0, sizeof(handles_)); }
   bool can_destroy() const ;
   void reset() {
     cache_id_ = 0;
@@ -101,6 +105,7 @@ struct ObKVCacheInst
     is_delete_ = false;
     ref_cnt_ = 0;
     mb_list_handle_.reset();
+    admission_filter_.destroy();
     MEMSET(handles_, 0, sizeof(handles_));
   }
   bool is_valid() const { return ref_cnt_ > 0; }
@@ -112,6 +117,12 @@ struct ObKVCacheInst
 
   common::ObDLink *get_mb_list() { return mb_list_handle_.get_head(); }
 
+  // admission filter related
+  inline bool need_admission_filter() const
+  {
+    return NULL != status_.config_ && ATOMIC_LOAD(&status_.config_->enable_admission_filter_);
+  }
+
   TO_STRING_KV(K_(cache_id), K_(tenant_id), K_(is_delete), K_(status), K_(ref_cnt));
 };
 
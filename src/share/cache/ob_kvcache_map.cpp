@@ -286,6 +286,10 @@ int ObKVCacheMap::get(
               ++out_handle->recent_get_cnt_;
               iter_get_cnt = ++ iter->get_cnt_;
               iter->inst_->status_.total_hit_cnt_.inc();
+              if (iter->inst_->need_admission_filter()) {
+                // hits count in the access frequency of admission filter too
+                iter->inst_->admission_filter_.record(hash_code - cache_id);
+              }
               mb_policy = out_handle->policy_;
 
               break;
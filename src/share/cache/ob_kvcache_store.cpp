@@ -355,6 +355,7 @@ bool ObKVCacheStore::wash()
     purge_mb_handle_retire_station();
     COMMON_LOG(INFO, "Wash time detail, ", K(compute_wash_size_time), K(refresh_score_time), K(wash_time));
   }
+  refresh_admission_victim_frequency();
 
   return is_wash_valid;
 }
@@ -1162,11 +1163,46 @@ void ObKVCacheStore::wash_mbs(WashHeap &heap)
 {
   for (int64_t i = 0; i < heap.mb_cnt_; ++i) {
     if (NULL != heap.heap_) {
+      sample_admission_victim(heap.heap_[i]);
       wash_mb(heap.heap_[i]);
     }
   }
 }
 
+void ObKVCacheStore::sample_admission_victim(ObKVMemBlockHandle *mb_handle)
+{
+  if (NULL != mb_handle && add_handle_ref(mb_handle)) {
+    ObKVCacheInst *inst = mb_handle->inst_;
+    // only the full memblock referenced by nobody else is read, no kvpair is being written in it
+    if (NULL != inst && inst->need_admission_filter() && inst->admission_filter_.is_inited()
+        && FULL == ATOMIC_LOAD(&mb_handle->status_) && 2 == get_handle_ref_cnt(mb_handle)
+        && NULL != mb_handle->mem_block_) {
+      int64_t pos = 0;
+      int64_t sample_cnt = 0;
+      ObKVCachePair *kvpair = NULL;
+      while (sample_cnt < ADMISSION_VICTIM_SAMPLE_CNT
+             && NULL != (kvpair = mb_handle->mem_block_->get_next_kvpair(pos))) {
+        if (NULL != kvpair->key_) {
+          inst->admission_filter_.add_victim_sample(inst->admission_filter_.estimate(kvpair->key_->hash()));
+          ++sample_cnt;
+        }
+      }
+    }
+    de_handle_ref(mb_handle);
+  }
+}
+
+void ObKVCacheStore::refresh_admission_victim_frequency()
+{
+  // insts not washed in this round get victim frequency 0 and admit all new kvs
+  for (int64_t i = 0; i < inst_handles_.count(); ++i) {
+    ObKVCacheInst *inst = inst_handles_.at(i).get_inst();
+    if (NULL != inst && inst->admission_filter_.is_inited()) {
+      inst->admission_filter_.refresh_victim_frequency();
+    }
+  }
+}
+
 bool ObKVCacheStore::try_wash_mb(ObKVMemBlockHandle *mb_handle, const uint64_t tenant_id, void *&buf, int64_t &mb_size)
 {
   bool block_washed = false;
@@ -133,6 +133,7 @@ private:
   static const int64_t MIN_TENANT_WASH_THRESHOLD = 8L << 20;  // 8MB
   static const int64_t MAX_GLOBAL_WASH_THRESHOLD = 64L;  // 64 * 2M = 128M
   static const int64_t MIN_GLOBAL_WASH_THRESHOLD = 8L;  // 8 * 2M = 16M
+  static const int64_t ADMISSION_VICTIM_SAMPLE_CNT = 16; // sampled keys of one washed memblock
   static const int64_t FLUSH_PRESERVE_TENANT_NUM = 10; // number preversed for flush
   static const int64_t DEFAULT_TENANT_BUCKET_NUM = 64;
   struct StoreMBHandleCmp
@@ -200,6 +201,9 @@ private:
   bool is_global_wash_valid(const int64_t total_tenant_wash_block_count, const int64_t global_cache_size);
   void wash_mb(ObKVMemBlockHandle *mb_handle);
   void wash_mbs(WashHeap &heap);
+  // sample the access frequency of keys in memblock to be washed for the admission filter
+  void sample_admission_victim(ObKVMemBlockHandle *mb_handle);
+  void refresh_admission_victim_frequency();
   bool try_wash_mb(ObKVMemBlockHandle *mb_handle, const uint64_t tenant_id, void *&buf, int64_t &mb_size);
   int do_wash_mb(ObKVMemBlockHandle *mb_handle, void *&buf, int64_t &mb_size);
   int init_wash_heap(WashHeap &heap, const int64_t heap_size);
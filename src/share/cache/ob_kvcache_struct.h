@@ -98,6 +98,21 @@ public:
   }
   inline int64_t get_size() const { return atomic_pos_.buffer; }
   inline int64_t get_kv_cnt() const { return atomic_pos_.pairs; }
+  // iterate the stored kvpairs from byte offset %pos, NULL at the end, the memblock must not be
+  // written concurrently
+  inline ObKVCachePair *get_next_kvpair(int64_t &pos) const
+  {
+    ObKVCachePair *kvpair = NULL;
+    if (NULL != buffer_ && pos >= 0 && pos < atomic_pos_.buffer) {
+      kvpair = reinterpret_cast<ObKVCachePair *>(buffer_ + pos);
+      if (OB_UNLIKELY(kvpair->size_ <= 0)) {
+        kvpair = NULL;
+      } else {
+        pos += kvpair->size_;
+      }
+    }
+    return kvpair;
+  }
 private:
   static const int64_t ALIGN_SIZE = sizeof(size_t);
   AtomicInt64 atomic_pos_;
@@ -176,6 +191,8 @@ public:
   void reset();
   bool is_valid_;
   int64_t priority_;
+  // new kvs are admitted by the frequency filter, see ObKVCacheAdmissionFilter
+  bool enable_admission_filter_;
   char cache_name_[MAX_CACHE_NAME_LENGTH];
 };
 
@@ -194,6 +211,8 @@ public:
   const ObKVCacheConfig *config_;
   ObPCNonAtomicCounter total_put_cnt_;
   ObPCNonAtomicCounter total_hit_cnt_;
+  // new kvs rejected by the admission filter
+  ObPCNonAtomicCounter admission_reject_cnt_;
   int64_t kv_cnt_;
   int64_t store_size_;
   int64_t lru_mb_cnt_;
@@ -60,6 +60,11 @@ SQL_MONITOR_STATNAME_DEF(SSTABLE_INSERT_ROW_COUNT, sql_monitor_statname::INT, "s
 SQL_MONITOR_STATNAME_DEF(IO_READ_BYTES, sql_monitor_statname::CAPACITY, "total io bytes read from disk", "total io bytes read from storage")
 SQL_MONITOR_STATNAME_DEF(TOTAL_READ_BYTES, sql_monitor_statname::CAPACITY, "total bytes processed by storage", "total bytes processed by storage, including memtable")
 SQL_MONITOR_STATNAME_DEF(TOTAL_READ_ROW_COUNT, sql_monitor_statname::INT, "total rows processed by storage", "total rows processed by storage, including memtable")
+SQL_MONITOR_STATNAME_DEF(PREFETCH_STALL_TIME, sql_monitor_statname::INT, "prefetch stall time", "time waiting for the io of prefetched data micro blocks")
+SQL_MONITOR_STATNAME_DEF(PREFETCH_WASTED_BYTES, sql_monitor_statname::CAPACITY, "prefetch wasted bytes", "bytes of prefetched data micro blocks dropped unread")
+// Hybrid hash distribution
+SQL_MONITOR_STATNAME_DEF(EXCHANGE_SKEW_KEY_COUNT, sql_monitor_statname::INT, "skewed key count", "popular join keys used by hybrid hash distribution, including runtime detected keys")
+SQL_MONITOR_STATNAME_DEF(EXCHANGE_SKEW_ROW_COUNT, sql_monitor_statname::INT, "skewed row count", "rows broadcast or sent round-robin by hybrid hash distribution for popular join keys")
 
 //end
 SQL_MONITOR_STATNAME_DEF(MONITOR_STATNAME_END, sql_monitor_statname::INVALID, "monitor end", "monitor stat name end")
@@ -7027,6 +7027,7 @@ def_table_schema(
   ('total_hit_cnt', 'int', 'false'),
   ('total_miss_cnt', 'int', 'false'),
   ('hold_size', 'int', 'false'),
+  ('admission_reject_cnt', 'int', 'false'),
   ],
   vtable_route_policy = 'distributed',
   partition_columns = ['svr_ip', 'svr_port'],
@@ -21818,7 +21819,8 @@ SELECT
   HIT_RATIO,
   TOTAL_PUT_CNT,
   TOTAL_HIT_CNT,
-  TOTAL_MISS_CNT
+  TOTAL_MISS_CNT,
+  ADMISSION_REJECT_CNT
 FROM oceanbase.__all_virtual_kvcache_info
 """.replace("\n", " ")
 )
@@ -52754,7 +52756,8 @@ SELECT
   HIT_RATIO,
   TOTAL_PUT_CNT,
   TOTAL_HIT_CNT,
-  TOTAL_MISS_CNT
+  TOTAL_MISS_CNT,
+  ADMISSION_REJECT_CNT
 FROM SYS.ALL_VIRTUAL_KVCACHE_INFO
 """.replace("\n", " ")
 )
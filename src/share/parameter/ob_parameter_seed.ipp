@@ -233,9 +233,23 @@ DEF_STR_WITH_CHECKER(tableapi_transport_compress_func, OB_CLUSTER_PARAMETER, "no
 DEF_CAP(_sort_area_size, OB_TENANT_PARAMETER, "32M", "[2M,]",
         "size of maximum memory that could be used by SORT. Range: [2M,+∞)",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_sort_inmem_parallel_degree, OB_TENANT_PARAMETER, "0", "[0,64]",
+        "max threads used to sort the in-memory rows of one SORT operator, rows are sorted by "
+        "px pool threads in ranges and merged. 0 or 1 means sort in one thread. Range: [0, 64]",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_CAP(_hash_area_size, OB_TENANT_PARAMETER, "32M", "[4M,]",
         "size of maximum memory that could be used by HASH JOIN. Range: [4M,+∞)",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_sql_spill_compress_func, OB_TENANT_PARAMETER, "none",
+                     common::ObConfigCompressFuncChecker,
+                     "compressor used for blocks dumped by sql operators, compression is turned off "
+                     "automatically if the compress ratio is poor. "
+                     "Values: none, lz4_1.0, snappy_1.0, zlib_1.0, zstd_1.0, zstd_1.3.8",
+                     ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_sql_expr_jit_hot_plan_threshold, OB_TENANT_PARAMETER, "0", "[0,)",
+        "filters of vectorized operators are compiled to native code by LLVM when the cached plan "
+        "has been executed more than this number of times. 0 means disabled. Range: [0, +inf)",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 //
 DEF_BOOL(_enable_partition_level_retry, OB_CLUSTER_PARAMETER, "True",
@@ -398,6 +412,10 @@ DEF_BOOL(_px_message_compression, OB_TENANT_PARAMETER, "True",
         "Enable DTL send message with compression"
         "Value: True: enable compression False: disable compression",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_message_columnar_encoding, OB_TENANT_PARAMETER, "False",
+        "Enable DTL send data message with column-wise dictionary, RLE or bit packing encoding. "
+        "Value: True: enable columnar encoding False: disable columnar encoding",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_px_chunklist_count_ratio, OB_CLUSTER_PARAMETER, "1", "[1, 128]",
         "the ratio of the dtl buffer manager list. Range: [1, 128]",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -421,6 +439,15 @@ DEF_INT(_enable_hash_join_processor, OB_TENANT_PARAMETER, "7", "[1, 7]",
          "which path to process for hash join, default 7 to auto choose "
          "1: nest loop, 2: recursive, 4: in-memory",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_hash_join_radix_partition, OB_TENANT_PARAMETER, "False",
+         "partition the build side of in-memory hash join by radix and insert it partition by "
+         "partition when the bucket array exceeds L2 cache, and prefetch buckets in a pipeline. "
+         "Value:  True:turned on  False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_hash_table_tag_probe, OB_TENANT_PARAMETER, "False",
+         "use the tag probed (Swiss table style) hash table layout for hash group by and "
+         "hash distinct. Value:  True:turned on  False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_pushdown_storage_level, OB_TENANT_PARAMETER, "4", "[0, 4]",
         "the level of storage pushdown. Range: [0, 4] "
         "0: disabled, 1:blockscan, 2: blockscan & filter, 3: blockscan & filter & aggregate, 4: blockscan & filter & aggregate & group by",
@@ -823,6 +850,19 @@ DEF_INT(bf_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "bf cache priority
 DEF_INT(bf_cache_miss_count_threshold, OB_CLUSTER_PARAMETER, "100", "[0,)", "bf cache miss count threshold, 0 means disable bf cache. Range:[0, )",
         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(fuse_row_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "fuse row cache priority. Range:[1, )", ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR(_cache_admission_filter, OB_CLUSTER_PARAMETER, "",
+        "comma separated kvcache names whose new kvs are admitted under memory pressure only if they "
+        "are accessed more frequently than the kvs being washed, to keep the hot kvs from being washed by scans. "
+        "e.g. user_block_cache,user_row_cache,fuse_row_cache. Empty string means disabled for all caches",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR(_micro_block_disk_cache_dir, OB_CLUSTER_PARAMETER, "",
+        "local directory of the second tier micro block cache, usually on a local NVMe disk. "
+        "Empty string means the micro block disk cache is disabled",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_CAP(_micro_block_disk_cache_size, OB_CLUSTER_PARAMETER, "0M", "[0M,)",
+        "size of the second tier micro block cache file, 0 means the micro block disk cache is disabled. "
+        "Range: [0, +∞)",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 DEF_INT(storage_meta_cache_priority, OB_CLUSTER_PARAMETER, "10", "[1,)", "storage meta cache priority. Range:[1, )",
         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
@@ -956,6 +996,11 @@ DEF_INT(micro_block_merge_verify_level, OB_CLUSTER_PARAMETER, "2", "[0,3]",
         "2 : verify encoding and compression algorithm, besides encoding verification, compressed block will be decompressed to ensure data is correct"
         "3 : verify encoding, compression algorithm and lost write protect",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_micro_block_encode_parallel_degree, OB_TENANT_PARAMETER, "0", "[0,16]",
+        "threads of the tenant shared by major compactions to encode and compress the data micro blocks, "
+        "the encoded micro blocks are written in order by the merge thread. "
+        "0 means encoding in the merge thread. Range: [0, 16]",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_INT(_migrate_block_verify_level, OB_CLUSTER_PARAMETER, "1", "[0,2]",
         "specify what kind of verification should be done when migrating macro block. "
@@ -1525,6 +1570,11 @@ DEF_BOOL(_px_join_skew_handling, OB_TENANT_PARAMETER, "True",
 DEF_INT(_px_join_skew_minfreq, OB_TENANT_PARAMETER, "30", "[1,100]",
         "sets minimum frequency(%) for skewed value for parallel joins. Range: [1, 100] in integer",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_join_skew_runtime_detect, OB_TENANT_PARAMETER, "False",
+        "enables detecting skewed values of parallel hash joins by sampling build side at runtime, "
+        "even if no histogram is available. Only used when the estimated rows of the join are "
+        "large enough for its parallelism. The default value is False.",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(_enable_protocol_diagnose, OB_CLUSTER_PARAMETER, "True",
         "enables protocol layer diagnosis. The default value is False.",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
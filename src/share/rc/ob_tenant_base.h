@@ -64,6 +64,7 @@ namespace sql {
 namespace blocksstable {
   class ObSharedMacroBlockMgr;
   class ObDecodeResourcePool;
+  class ObTenantMicroBlockEncodePool;
 }
 namespace storage {
 namespace mds {
@@ -306,6 +307,7 @@ using ObTableScanIteratorObjPool = common::ObServerObjectPool<oceanbase::storage
       compaction::ObTenantTabletScheduler*,          \
       compaction::ObTenantMediumChecker*,            \
       storage::ObTenantCompactionMemPool*,           \
+      blocksstable::ObTenantMicroBlockEncodePool*,   \
       share::ObTenantDagScheduler*,                  \
       storage::ObStorageHAService*,                  \
       storage::ObTenantFreezeInfoMgr*,               \
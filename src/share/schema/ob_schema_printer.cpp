@@ -5183,6 +5183,10 @@ int ObSchemaPrinter::print_external_table_file_info(const ObTableSchema &table_s
     ObExternalFileFormat format;
     if (OB_FAIL(format.load_from_string(table_schema.get_external_file_format(), allocator))) {
       SHARE_SCHEMA_LOG(WARN, "fail to load from json string", K(ret));
+    } else if (ObExternalFileFormat::PARQUET_FORMAT == format.format_type_) {
+      if (OB_FAIL(databuff_printf(buf, buf_len, pos, "\nFORMAT (\n  TYPE = 'PARQUET'\n) "))) {
+        SHARE_SCHEMA_LOG(WARN, "fail to print FORMAT", K(ret));
+      }
     } else if (format.format_type_ != ObExternalFileFormat::CSV_FORMAT) {
       SHARE_SCHEMA_LOG(WARN, "unsupported to print file format", K(ret), K(format.format_type_));
     } else {
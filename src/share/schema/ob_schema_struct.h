@@ -8355,19 +8355,25 @@ public:
   inline void set_column_attr(uint64_t column_attr) { pack_ = column_attr; }
   inline void set_min_max() { min_max_ = 1; }
   inline void set_sum() { sum_ = 1; }
+  inline void set_bloom_filter() { bloom_filter_ = 1; }
+  inline void set_ngram_bloom_filter() { ngram_bloom_filter_ = 1; }
   inline bool has_skip_index() const { return OB_DEFAULT_SKIP_INDEX_COLUMN_ATTR != pack_; }
   inline bool has_min_max() const { return 1 == min_max_; }
   inline bool has_sum() const { return 1 == sum_; }
+  inline bool has_bloom_filter() const { return 1 == bloom_filter_; }
+  inline bool has_ngram_bloom_filter() const { return 1 == ngram_bloom_filter_; }
   inline bool operator==(const ObSkipIndexColumnAttr &other) const { return pack_ == other.pack_; }
-  TO_STRING_KV(K_(pack), K_(min_max), K_(sum));
+  TO_STRING_KV(K_(pack), K_(min_max), K_(sum), K_(bloom_filter), K_(ngram_bloom_filter));
 
   union
   {
     struct
     {
-      uint64_t min_max_       :1;
-      uint64_t sum_           :1;
-      uint64_t reserved_      :62;
+      uint64_t min_max_             :1;
+      uint64_t sum_                 :1;
+      uint64_t bloom_filter_        :1;
+      uint64_t ngram_bloom_filter_  :1;
+      uint64_t reserved_            :60;
     };
     uint64_t pack_;
   };
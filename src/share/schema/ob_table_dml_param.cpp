@@ -35,6 +35,7 @@ ObTableSchemaParam::ObTableSchemaParam(ObIAllocator &allocator)
     spatial_geo_col_id_(OB_INVALID_ID),
     spatial_cellid_col_id_(OB_INVALID_ID),
     spatial_mbr_col_id_(OB_INVALID_ID),
+    has_row_ttl_(false),
     index_name_(),
     columns_(allocator),
     col_map_(allocator),
@@ -60,6 +61,7 @@ void ObTableSchemaParam::reset()
   spatial_geo_col_id_ = OB_INVALID_ID;
   spatial_cellid_col_id_ = OB_INVALID_ID;
   spatial_mbr_col_id_ = OB_INVALID_ID;
+  has_row_ttl_ = false;
   index_name_.reset();
   columns_.reset();
   col_map_.clear();
@@ -87,6 +89,7 @@ int ObTableSchemaParam::convert(const ObTableSchema *schema)
     schema_version_ = schema->get_schema_version();
     table_type_ = schema->get_table_type();
     use_cs = !schema->is_row_store();
+    has_row_ttl_ = !schema->get_ttl_definition().empty();
   }
 
   if (OB_SUCC(ret) && schema->is_user_table() && !schema->is_heap_table()) {
@@ -342,6 +345,7 @@ int64_t ObTableSchemaParam::to_string(char *buf, const int64_t buf_len) const
        K_(index_status),
        K_(shadow_rowkey_column_num),
        K_(fulltext_col_id),
+       K_(has_row_ttl),
        K_(index_name),
        K_(pk_name),
        K_(columns),
@@ -378,6 +382,7 @@ OB_DEF_SERIALIZE(ObTableSchemaParam)
   OB_UNIS_ENCODE(spatial_geo_col_id_);
   OB_UNIS_ENCODE(spatial_cellid_col_id_);
   OB_UNIS_ENCODE(spatial_mbr_col_id_);
+  OB_UNIS_ENCODE(has_row_ttl_);
   return ret;
 }
 
@@ -423,6 +428,7 @@ OB_DEF_DESERIALIZE(ObTableSchemaParam)
   OB_UNIS_DECODE(spatial_geo_col_id_);
   OB_UNIS_DECODE(spatial_cellid_col_id_);
   OB_UNIS_DECODE(spatial_mbr_col_id_);
+  OB_UNIS_DECODE(has_row_ttl_);
   return ret;
 }
 
@@ -454,6 +460,7 @@ OB_DEF_SERIALIZE_SIZE(ObTableSchemaParam)
   OB_UNIS_ADD_LEN(spatial_geo_col_id_);
   OB_UNIS_ADD_LEN(spatial_cellid_col_id_);
   OB_UNIS_ADD_LEN(spatial_mbr_col_id_);
+  OB_UNIS_ADD_LEN(has_row_ttl_);
   return len;
 }
 
@@ -54,6 +54,7 @@ public:
   OB_INLINE uint64_t get_spatial_geo_col_id() const { return spatial_geo_col_id_; }
   OB_INLINE uint64_t get_spatial_cellid_col_id() const { return spatial_cellid_col_id_; }
   OB_INLINE uint64_t get_spatial_mbr_col_id() const { return spatial_mbr_col_id_; }
+  OB_INLINE bool has_row_ttl() const { return has_row_ttl_; }
   OB_INLINE int64_t get_column_count() const { return columns_.count(); }
   OB_INLINE const Columns &get_columns() const { return columns_; }
   OB_INLINE const ColumnMap &get_col_map() const { return col_map_; }
@@ -99,6 +100,8 @@ private:
   uint64_t spatial_geo_col_id_; // geometry column id in data table_schema.
   uint64_t spatial_cellid_col_id_; // cellid column id in index table_schema.
   uint64_t spatial_mbr_col_id_; // mbr column id in index table_schema.
+  // expired rows may be purged by major merge, updates are written as full rows
+  bool has_row_ttl_;
   common::ObString index_name_;
   //generated storage param from columns_ids_ in ObTableModify, for performance improvement
   Columns columns_;
@@ -7178,6 +7178,7 @@ int ObTableSchema::check_skip_index_valid() const
 {
   int ret = OB_SUCCESS;
   int64_t aggregate_row_size = 0;
+  int64_t aggregate_filter_size = 0;
   for (int64_t i = 0; OB_SUCC(ret) && i < column_cnt_; ++i) {
     const ObColumnSchemaV2 *column_schema = nullptr;
     int64_t column_agg_maximum_size = 0;
@@ -7190,8 +7191,8 @@ int ObTableSchema::check_skip_index_valid() const
       ret = OB_ERR_UNEXPECTED;
       LOG_USER_ERROR(OB_ERR_UNEXPECTED, "skip index on virtual generated column");
       LOG_WARN("unexpected skip index on virtual generated column", K(ret), KPC(column_schema));
-    } else if (OB_UNLIKELY(is_lob_storage(column_schema->get_meta_type().get_type()) &&
-        !ob_is_large_text(column_schema->get_meta_type().get_type()))) {
+    } else if (OB_UNLIKELY(!blocksstable::ObSkipIndexColMeta::is_column_type_supported(
+        column_schema->get_skip_index_attr(), column_schema->get_meta_type()))) {
       ret = OB_NOT_SUPPORTED;
       LOG_USER_ERROR(OB_NOT_SUPPORTED, "skip index on column with invalid column type");
       LOG_USER_ERROR(OB_NOT_SUPPORTED, ob_obj_type_str(column_schema->get_meta_type().get_type()));
@@ -7210,6 +7211,13 @@ int ObTableSchema::check_skip_index_valid() const
       LOG_USER_ERROR(OB_NOT_SUPPORTED,
       "current version of oceanbase has a limitation for skip index size in a single table, too many skip index columns");
       LOG_WARN("skip index row size too large", K(ret), KPC(column_schema), K(aggregate_row_size));
+    } else if (FALSE_IT(aggregate_filter_size += blocksstable::ObSkipIndexColMeta::calc_skip_index_filter_maximum_size(
+        column_schema->get_skip_index_attr()))) {
+    } else if (OB_UNLIKELY(aggregate_filter_size > ObSkipIndexColMeta::SKIP_INDEX_FILTER_SIZE_LIMIT)) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_USER_ERROR(OB_NOT_SUPPORTED,
+      "current version of oceanbase has a limitation for skip index size in a single table, too many bloom filter skip index columns");
+      LOG_WARN("skip index bloom filter size too large", K(ret), KPC(column_schema), K(aggregate_filter_size));
     }
   }
   return ret;
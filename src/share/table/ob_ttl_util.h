@@ -366,6 +366,20 @@ public:
   ObTableTTLExpr(): column_name_(), interval_(), time_unit_(ObTableTTLTimeUnit::INVALID), nsecond_(0), nmonth_(0), is_negative_(false) {}
   ~ObTableTTLExpr() {}
   const ObString &get_ttl_column() const { return column_name_; }
+  const char *get_time_unit_str() const
+  {
+    const char *unit_str = "INVALID";
+    switch (time_unit_) {
+      case ObTableTTLTimeUnit::SECOND: unit_str = "SECOND"; break;
+      case ObTableTTLTimeUnit::MINUTE: unit_str = "MINUTE"; break;
+      case ObTableTTLTimeUnit::HOUR: unit_str = "HOUR"; break;
+      case ObTableTTLTimeUnit::DAY: unit_str = "DAY"; break;
+      case ObTableTTLTimeUnit::MONTH: unit_str = "MONTH"; break;
+      case ObTableTTLTimeUnit::YEAR: unit_str = "YEAR"; break;
+      default: break;
+    }
+    return unit_str;
+  }
   TO_STRING_KV(K_(column_name), K_(interval), K_(time_unit));
 public:
   ObString column_name_;
@@ -3196,6 +3196,34 @@ int ObStaticEngineCG::generate_spec(ObLogExchange &op, ObPxDistTransmitSpec &spe
                 spec.dist_hash_funcs_.at(0), *op.get_popular_values(), spec.popular_values_hash_))){
       LOG_WARN("fail generate popular values", K(ret));
     }
+    if (OB_SUCC(ret) && op.need_skew_detect()
+        && OB_FAIL(generate_join_skew_detect_spec(op, spec))) {
+      LOG_WARN("fail generate join skew detect spec", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObStaticEngineCG::generate_join_skew_detect_spec(ObLogExchange &op, ObPxDistTransmitSpec &spec)
+{
+  int ret = OB_SUCCESS;
+  // producer exchange -> consumer exchange -> hash join
+  ObLogicalOperator *parent = op.get_parent();
+  while (NULL != parent && log_op_def::LOG_JOIN != parent->get_type()) {
+    parent = parent->get_parent();
+  }
+  if (OB_ISNULL(parent)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("hybrid hash distribution without join", K(ret), K(op.get_op_id()));
+  } else {
+    spec.skew_join_id_ = parent->get_op_id();
+    if (ObPQDistributeMethod::HYBRID_HASH_BROADCAST == op.get_dist_method()) {
+      // build side holds header rows while sampling, same as range distribution
+      ObSEArray<ObExpr *, 16> sampling_saving_row;
+      spec.sample_type_ = HEADER_INPUT_SAMPLE;
+      OZ(append(sampling_saving_row, spec.get_child()->output_));
+      OZ(spec.sampling_saving_row_.assign(sampling_saving_row));
+    }
   }
   return ret;
 }
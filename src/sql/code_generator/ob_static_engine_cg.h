@@ -451,6 +451,7 @@ private:
       const common::ObHashFunc &hash_func,
       const ObIArray<common::ObObj> &popular_values_expr,
       common::ObFixedArray<uint64_t, common::ObIAllocator> &popular_values_hash);
+  int generate_join_skew_detect_spec(ObLogExchange &op, ObPxDistTransmitSpec &spec);
   int generate_delete_with_das(ObLogDelete &op, ObTableDeleteSpec &spec);
 
   int fill_wf_info(ObIArray<ObExpr *> &all_expr, ObWinFunRawExpr &win_expr,
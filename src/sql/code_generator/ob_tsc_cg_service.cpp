@@ -461,6 +461,13 @@ int ObTscCgService::generate_tsc_filter(const ObLogTableScan &op, ObTableScanSpe
   if (OB_SUCC(ret)) {
     if (OB_FAIL(cg_.generate_rt_exprs(nonpushdown_filters, spec.filters_))) {
       LOG_WARN("generate filter expr failed", K(ret));
+    } else if (share::schema::EXTERNAL_TABLE == op.get_table_type() && !nonpushdown_filters.empty()) {
+      // filters are still applied by the operator, external table iterators use the copy handed
+      // to das only to skip data which can not satisfy them, e.g. row groups of parquet files
+      if (OB_FAIL(cg_.generate_rt_exprs(nonpushdown_filters,
+                                        scan_ctdef.pd_expr_spec_.pushdown_filters_))) {
+        LOG_WARN("generate external table filter hints failed", K(ret));
+      }
     }
   }
   return ret;
@@ -99,6 +99,9 @@ static DtlWriterType msg_writer_map[] =
   CONTROL_WRITER, // DH_SECOND_STAGE_REPORTING_WF_WHOLE_MSG,
   CONTROL_WRITER, // DH_OPT_STATS_GATHER_PIECE_MSG,
   CONTROL_WRITER, // DH_OPT_STATS_GATHER_WHOLE_MSG,
+  MAX_WRITER, // PX_COLUMNAR_DATUM, encoded from PX_DATUM_ROW before sending
+  CONTROL_WRITER, // DH_JOIN_SKEW_PIECE_MSG,
+  CONTROL_WRITER, // DH_JOIN_SKEW_WHOLE_MSG,
 };
 
 static_assert(ARRAYSIZEOF(msg_writer_map) == ObDtlMsgType::MAX, "invalid ms_writer_map size");
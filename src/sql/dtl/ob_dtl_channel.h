@@ -237,6 +237,8 @@ public:
   OB_INLINE ObDtlChannelWatcher *get_msg_watcher() { return msg_watcher_; }
 
   void set_compression_type(const common::ObCompressorType &type) { compressor_type_ = type; }
+  // encode data message column-wise before sending through rpc, see ObDtlColumnarEncoder.
+  void set_columnar_encoding(bool enable) { enable_columnar_encoding_ = enable; }
 
   void set_batch_id(int64_t batch_id) { batch_id_ = batch_id; }
   int64_t get_batch_id() { return batch_id_; }
@@ -290,6 +292,7 @@ protected:
   int64_t loop_idx_;
 
   common::ObCompressorType compressor_type_;
+  bool enable_columnar_encoding_;
 
   DTLChannelOwner owner_mod_;
   int64_t thread_id_;
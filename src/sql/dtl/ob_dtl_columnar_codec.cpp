@@ -0,0 +1,547 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_DTL
+
+#include "sql/dtl/ob_dtl_columnar_codec.h"
+#include <algorithm>
+#include "lib/allocator/page_arena.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "sql/dtl/ob_dtl_linked_buffer.h"
+
+namespace oceanbase {
+using namespace common;
+namespace sql {
+namespace dtl {
+
+typedef ObDtlColumnarColumnHeader ColHead;
+typedef ObChunkDatumStore::StoredRow StoredRow;
+
+namespace {
+
+// bit packed value never exceed 56 bits, it can always be accessed by one unaligned 8 bytes
+// read or write, the packed area is padded with PACK_PADDING bytes.
+const int64_t MAX_PACK_BITS = 56;
+const int64_t PACK_PADDING = sizeof(uint64_t);
+
+OB_INLINE int64_t align4(const int64_t size) { return (size + 3) & ~3L; }
+OB_INLINE int64_t align8(const int64_t size) { return (size + 7) & ~7L; }
+OB_INLINE int64_t bitmap_size(const int64_t cnt) { return align4((cnt + 7) / 8); }
+OB_INLINE int64_t packed_size(const int64_t cnt, const int64_t bits)
+{
+  return align4((cnt * bits + 7) / 8 + PACK_PADDING);
+}
+OB_INLINE int64_t bit_width(const uint64_t v) { return 0 == v ? 0 : 64 - __builtin_clzll(v); }
+
+OB_INLINE bool bitmap_test(const char *bitmap, const int64_t idx)
+{
+  return bitmap[idx >> 3] & (1 << (idx & 7));
+}
+
+OB_INLINE void bitmap_set(char *bitmap, const int64_t idx)
+{
+  bitmap[idx >> 3] = static_cast<char>(bitmap[idx >> 3] | (1 << (idx & 7)));
+}
+
+OB_INLINE void pack(char *packed, const int64_t idx, const int64_t bits, const uint64_t v)
+{
+  const int64_t bit_pos = idx * bits;
+  uint64_t word = 0;
+  MEMCPY(&word, packed + (bit_pos >> 3), sizeof(word));
+  word |= v << (bit_pos & 7);
+  MEMCPY(packed + (bit_pos >> 3), &word, sizeof(word));
+}
+
+OB_INLINE uint64_t unpack(const char *packed, const int64_t idx, const int64_t bits)
+{
+  const int64_t bit_pos = idx * bits;
+  uint64_t word = 0;
+  MEMCPY(&word, packed + (bit_pos >> 3), sizeof(word));
+  return (word >> (bit_pos & 7)) & ((1UL << bits) - 1);
+}
+
+// little endian unsigned integer of fixed length datum
+OB_INLINE uint64_t fixed_value(const ObDatum &d)
+{
+  uint64_t v = 0;
+  MEMCPY(&v, d.ptr_, d.len_);
+  return v;
+}
+
+OB_INLINE bool is_fixed_width(const int64_t width)
+{
+  return 1 == width || 2 == width || 4 == width || 8 == width;
+}
+
+OB_INLINE bool datum_equal(const ObDatum &l, const ObDatum &r)
+{
+  return l.pack_ == r.pack_ && (l.is_null() || 0 == MEMCMP(l.ptr_, r.ptr_, l.len_));
+}
+
+OB_INLINE void set_datum(ObDatum &d, const char *ptr, const uint32_t len)
+{
+  d.ptr_ = ptr;
+  d.pack_ = len;
+}
+
+// Shared memory of column encoding, sized by row count.
+struct EncodeCtx
+{
+  const StoredRow **srows_;
+  int64_t rows_;
+  int32_t *buckets_;
+  int64_t bucket_mask_;
+  uint32_t *refs_;
+  int32_t *dict_rows_;
+};
+
+struct ColumnStat
+{
+  ColumnStat() : valid_(true), has_null_(false), data_len_(0), width_(-1), min_(UINT64_MAX),
+                 max_(0), run_cnt_(0), run_len_(0), dict_cnt_(0), dict_len_(0) {}
+  bool valid_;
+  bool has_null_;
+  int64_t data_len_;
+  int64_t width_;  // -1 for no value, INT32_MAX for variable width
+  uint64_t min_;
+  uint64_t max_;
+  int64_t run_cnt_;
+  int64_t run_len_;
+  int64_t dict_cnt_; // -1 for too many distinct values
+  int64_t dict_len_;
+};
+
+void calc_column_stat(EncodeCtx &ctx, const int64_t col_idx, ColumnStat &stat)
+{
+  const ObDatum *prev = NULL;
+  for (int64_t i = 0; stat.valid_ && i < ctx.rows_; i++) {
+    const ObDatum &d = ctx.srows_[i]->cells()[col_idx];
+    if (ObDatumDesc::NONE != d.flag_) {
+      // flags are not encoded.
+      stat.valid_ = false;
+    } else if (d.is_null()) {
+      stat.has_null_ = true;
+    } else {
+      stat.data_len_ += d.len_;
+      if (stat.width_ < 0) {
+        stat.width_ = d.len_;
+      } else if (stat.width_ != d.len_) {
+        stat.width_ = INT32_MAX;
+      }
+      if (is_fixed_width(stat.width_)) {
+        const uint64_t v = fixed_value(d);
+        stat.min_ = std::min(stat.min_, v);
+        stat.max_ = std::max(stat.max_, v);
+      }
+    }
+    if (NULL == prev || !datum_equal(*prev, d)) {
+      stat.run_cnt_ += 1;
+      stat.run_len_ += d.len_;
+    }
+    prev = &d;
+  }
+  if (stat.valid_) {
+    MEMSET(ctx.buckets_, -1, sizeof(*ctx.buckets_) * (ctx.bucket_mask_ + 1));
+    const int64_t max_dict_cnt = ctx.rows_ / 2;
+    for (int64_t i = 0; stat.dict_cnt_ >= 0 && i < ctx.rows_; i++) {
+      const ObDatum &d = ctx.srows_[i]->cells()[col_idx];
+      if (d.is_null()) {
+        ctx.refs_[i] = UINT32_MAX;
+      } else {
+        int64_t idx = murmurhash(d.ptr_, d.len_, 0) & ctx.bucket_mask_;
+        while (ctx.buckets_[idx] >= 0
+               && !datum_equal(ctx.srows_[ctx.dict_rows_[ctx.buckets_[idx]]]->cells()[col_idx], d)) {
+          idx = (idx + 1) & ctx.bucket_mask_;
+        }
+        if (ctx.buckets_[idx] < 0) {
+          if (stat.dict_cnt_ >= max_dict_cnt) {
+            stat.dict_cnt_ = -1;
+          } else {
+            ctx.buckets_[idx] = static_cast<int32_t>(stat.dict_cnt_);
+            ctx.dict_rows_[stat.dict_cnt_] = static_cast<int32_t>(i);
+            stat.dict_cnt_ += 1;
+            stat.dict_len_ += d.len_;
+          }
+        }
+        if (stat.dict_cnt_ >= 0) {
+          ctx.refs_[i] = ctx.buckets_[idx];
+        }
+      }
+    }
+  }
+}
+
+void choose_encoding(const EncodeCtx &ctx, const ColumnStat &stat, ColHead &head, int64_t &size)
+{
+  const int64_t rows = ctx.rows_;
+  const int64_t null_bitmap_size = stat.has_null_ ? bitmap_size(rows) : 0;
+  head.encoding_ = ColHead::RAW;
+  head.has_null_ = stat.has_null_;
+  head.width_ = 0;
+  head.bits_ = 0;
+  head.cnt_ = 0;
+  head.base_ = 0;
+  size = null_bitmap_size + sizeof(uint32_t) * (rows + 1) + align4(stat.data_len_);
+  if (stat.dict_cnt_ >= 0) {
+    const int64_t bits = bit_width(stat.has_null_ ? stat.dict_cnt_ : stat.dict_cnt_ - 1);
+    const int64_t dict_size = sizeof(uint32_t) * (stat.dict_cnt_ + 1) + align4(stat.dict_len_)
+        + packed_size(rows, bits);
+    if (dict_size < size) {
+      size = dict_size;
+      head.encoding_ = ColHead::DICT;
+      head.bits_ = static_cast<uint8_t>(bits);
+      head.cnt_ = static_cast<uint32_t>(stat.dict_cnt_);
+    }
+  }
+  const int64_t rle_size = sizeof(uint32_t) * stat.run_cnt_
+      + (stat.has_null_ ? bitmap_size(stat.run_cnt_) : 0)
+      + sizeof(uint32_t) * (stat.run_cnt_ + 1) + align4(stat.run_len_);
+  if (rle_size < size) {
+    size = rle_size;
+    head.encoding_ = ColHead::RLE;
+    head.bits_ = 0;
+    head.cnt_ = static_cast<uint32_t>(stat.run_cnt_);
+  }
+  if (is_fixed_width(stat.width_)) {
+    const int64_t bits = bit_width(stat.max_ - stat.min_);
+    const int64_t pack_size = null_bitmap_size + packed_size(rows, bits);
+    if (bits <= MAX_PACK_BITS && pack_size < size) {
+      size = pack_size;
+      head.encoding_ = ColHead::BIT_PACK;
+      head.width_ = static_cast<uint8_t>(stat.width_);
+      head.bits_ = static_cast<uint8_t>(bits);
+      head.cnt_ = 0;
+      head.base_ = stat.min_;
+    }
+  }
+}
+
+// %buf is zeroed
+void write_column(const EncodeCtx &ctx, const int64_t col_idx, const ColHead &head, char *buf)
+{
+  const int64_t rows = ctx.rows_;
+  const int64_t null_bitmap_size = head.has_null_ ? bitmap_size(rows) : 0;
+  switch (head.encoding_) {
+    case ColHead::RAW: {
+      char *nulls = buf;
+      uint32_t *offsets = reinterpret_cast<uint32_t *>(buf + null_bitmap_size);
+      char *data = reinterpret_cast<char *>(offsets + rows + 1);
+      uint32_t off = 0;
+      for (int64_t i = 0; i < rows; i++) {
+        const ObDatum &d = ctx.srows_[i]->cells()[col_idx];
+        offsets[i] = off;
+        if (d.is_null()) {
+          bitmap_set(nulls, i);
+        } else {
+          MEMCPY(data + off, d.ptr_, d.len_);
+          off += d.len_;
+        }
+      }
+      offsets[rows] = off;
+      break;
+    }
+    case ColHead::DICT: {
+      const int64_t dict_cnt = head.cnt_;
+      uint32_t *offsets = reinterpret_cast<uint32_t *>(buf);
+      char *data = reinterpret_cast<char *>(offsets + dict_cnt + 1);
+      uint32_t off = 0;
+      for (int64_t i = 0; i < dict_cnt; i++) {
+        const ObDatum &d = ctx.srows_[ctx.dict_rows_[i]]->cells()[col_idx];
+        offsets[i] = off;
+        MEMCPY(data + off, d.ptr_, d.len_);
+        off += d.len_;
+      }
+      offsets[dict_cnt] = off;
+      char *packed = data + align4(off);
+      for (int64_t i = 0; i < rows; i++) {
+        pack(packed, i, head.bits_, UINT32_MAX == ctx.refs_[i] ? dict_cnt : ctx.refs_[i]);
+      }
+      break;
+    }
+    case ColHead::RLE: {
+      const int64_t run_cnt = head.cnt_;
+      uint32_t *run_ends = reinterpret_cast<uint32_t *>(buf);
+      char *nulls = reinterpret_cast<char *>(run_ends + run_cnt);
+      uint32_t *offsets = reinterpret_cast<uint32_t *>(
+          nulls + (head.has_null_ ? bitmap_size(run_cnt) : 0));
+      char *data = reinterpret_cast<char *>(offsets + run_cnt + 1);
+      const ObDatum *prev = NULL;
+      int64_t run = -1;
+      uint32_t off = 0;
+      for (int64_t i = 0; i < rows; i++) {
+        const ObDatum &d = ctx.srows_[i]->cells()[col_idx];
+        if (NULL == prev || !datum_equal(*prev, d)) {
+          if (run >= 0) {
+            run_ends[run] = static_cast<uint32_t>(i);
+          }
+          run += 1;
+          offsets[run] = off;
+          if (d.is_null()) {
+            bitmap_set(nulls, run);
+          } else {
+            MEMCPY(data + off, d.ptr_, d.len_);
+            off += d.len_;
+          }
+        }
+        prev = &d;
+      }
+      run_ends[run] = static_cast<uint32_t>(rows);
+      offsets[run_cnt] = off;
+      break;
+    }
+    case ColHead::BIT_PACK: {
+      char *nulls = buf;
+      char *packed = buf + null_bitmap_size;
+      for (int64_t i = 0; i < rows; i++) {
+        const ObDatum &d = ctx.srows_[i]->cells()[col_idx];
+        if (d.is_null()) {
+          bitmap_set(nulls, i);
+        } else {
+          pack(packed, i, head.bits_, fixed_value(d) - head.base_);
+        }
+      }
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+} // end anonymous namespace
+
+int ObDtlColumnarEncoder::encode_buffer(ObDtlLinkedBuffer &buffer)
+{
+  int ret = OB_SUCCESS;
+  ObChunkDatumStore::Block *blk = reinterpret_cast<ObChunkDatumStore::Block *>(buffer.buf());
+  if (!buffer.is_data_msg()
+      || PX_DATUM_ROW != buffer.msg_type()
+      || buffer.use_interm_result()
+      || buffer.is_batch_info_valid()
+      || NULL == blk
+      || blk->rows_ <= 0) {
+    // only plain datum row message is encoded, interm result and batch info
+    // depend on the row layout.
+  } else {
+    ObArenaAllocator alloc(ObMemAttr(buffer.tenant_id(), "DtlColumnarEnc"));
+    const int64_t buf_len = buffer.size();
+    char *buf = NULL;
+    int64_t size = 0;
+    bool encoded = false;
+    if (OB_ISNULL(buf = static_cast<char *>(alloc.alloc(buf_len)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(buf_len));
+    } else if (OB_FAIL(blk->swizzling(NULL))) {
+      LOG_WARN("block swizzling failed", K(ret));
+    } else {
+      if (OB_FAIL(encode(alloc, *blk, buf, buf_len, size, encoded))) {
+        LOG_WARN("encode block failed", K(ret));
+      } else if (encoded) {
+        LOG_DEBUG("columnar encode dtl buffer", K(buf_len), K(size), K(blk->rows_));
+        MEMCPY(buffer.buf(), buf, size);
+        buffer.size() = size;
+        buffer.msg_type() = PX_COLUMNAR_DATUM;
+      }
+      if (!encoded) {
+        int tmp_ret = blk->unswizzling();
+        if (OB_SUCCESS != tmp_ret) {
+          LOG_WARN("block unswizzling failed", K(tmp_ret));
+          ret = OB_SUCCESS == ret ? tmp_ret : ret;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObDtlColumnarEncoder::encode(ObIAllocator &alloc,
+                                 ObChunkDatumStore::Block &blk,
+                                 char *buf,
+                                 const int64_t buf_len,
+                                 int64_t &size,
+                                 bool &encoded)
+{
+  int ret = OB_SUCCESS;
+  encoded = false;
+  size = 0;
+  EncodeCtx ctx;
+  ctx.rows_ = blk.rows_;
+  const int64_t bucket_cnt = next_pow2(std::max(ctx.rows_ * 2, 16L));
+  ctx.bucket_mask_ = bucket_cnt - 1;
+  int64_t col_cnt = 0;
+  if (OB_ISNULL(buf) || OB_UNLIKELY(ctx.rows_ <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(ctx.rows_));
+  } else if (OB_ISNULL(ctx.srows_ = static_cast<const StoredRow **>(
+                       alloc.alloc(sizeof(*ctx.srows_) * ctx.rows_)))
+             || OB_ISNULL(ctx.buckets_ = static_cast<int32_t *>(
+                          alloc.alloc(sizeof(*ctx.buckets_) * bucket_cnt)))
+             || OB_ISNULL(ctx.refs_ = static_cast<uint32_t *>(
+                          alloc.alloc(sizeof(*ctx.refs_) * ctx.rows_)))
+             || OB_ISNULL(ctx.dict_rows_ = static_cast<int32_t *>(
+                          alloc.alloc(sizeof(*ctx.dict_rows_) * ctx.rows_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(ctx.rows_));
+  } else {
+    int64_t cur_pos = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < ctx.rows_; i++) {
+      if (OB_FAIL(blk.get_store_row(cur_pos, ctx.srows_[i]))) {
+        LOG_WARN("get store row failed", K(ret));
+      } else if (0 == i) {
+        col_cnt = ctx.srows_[i]->cnt_;
+      } else if (OB_UNLIKELY(col_cnt != ctx.srows_[i]->cnt_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("column count mismatch", K(ret), K(col_cnt), K(ctx.srows_[i]->cnt_));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    int64_t pos = align8(sizeof(ObDtlColumnarHeader) + sizeof(uint32_t) * col_cnt);
+    bool fit = pos < buf_len;
+    if (fit) {
+      MEMSET(buf, 0, pos);
+      ObDtlColumnarHeader *header = reinterpret_cast<ObDtlColumnarHeader *>(buf);
+      header->rows_ = static_cast<int32_t>(ctx.rows_);
+      header->col_cnt_ = static_cast<int32_t>(col_cnt);
+      for (int64_t col_idx = 0; fit && col_idx < col_cnt; col_idx++) {
+        ColumnStat stat;
+        ColHead head;
+        int64_t col_size = 0;
+        calc_column_stat(ctx, col_idx, stat);
+        if (!stat.valid_) {
+          fit = false;
+        } else {
+          choose_encoding(ctx, stat, head, col_size);
+          const int64_t end = align8(pos + sizeof(head) + col_size);
+          if (end >= buf_len) {
+            fit = false;
+          } else {
+            header->col_offsets_[col_idx] = static_cast<uint32_t>(pos);
+            MEMCPY(buf + pos, &head, sizeof(head));
+            MEMSET(buf + pos + sizeof(head), 0, end - pos - sizeof(head));
+            write_column(ctx, col_idx, head, buf + pos + sizeof(head));
+            pos = end;
+          }
+        }
+      }
+    }
+    if (fit) {
+      encoded = true;
+      size = pos;
+    }
+  }
+  return ret;
+}
+
+int ObDtlColumnarDecoder::decode(const char *buf,
+                                 const int64_t col_idx,
+                                 const int64_t start,
+                                 const int64_t cnt,
+                                 ObDatum *datums,
+                                 ObIAllocator &alloc)
+{
+  int ret = OB_SUCCESS;
+  const ObDtlColumnarHeader *header = reinterpret_cast<const ObDtlColumnarHeader *>(buf);
+  if (OB_ISNULL(buf) || OB_ISNULL(datums)
+      || OB_UNLIKELY(col_idx < 0 || col_idx >= header->col_cnt_
+                     || start < 0 || cnt < 0 || start + cnt > header->rows_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), KP(datums), K(col_idx), K(start), K(cnt));
+  } else {
+    const int64_t rows = header->rows_;
+    const char *col = buf + header->col_offsets_[col_idx];
+    const ColHead &head = *reinterpret_cast<const ColHead *>(col);
+    const char *payload = col + sizeof(ColHead);
+    const int64_t null_bitmap_size = head.has_null_ ? bitmap_size(rows) : 0;
+    switch (head.encoding_) {
+      case ColHead::RAW: {
+        const char *nulls = payload;
+        const uint32_t *offsets = reinterpret_cast<const uint32_t *>(payload + null_bitmap_size);
+        const char *data = reinterpret_cast<const char *>(offsets + rows + 1);
+        for (int64_t i = 0; i < cnt; i++) {
+          const int64_t row = start + i;
+          if (head.has_null_ && bitmap_test(nulls, row)) {
+            datums[i].set_null();
+          } else {
+            set_datum(datums[i], data + offsets[row], offsets[row + 1] - offsets[row]);
+          }
+        }
+        break;
+      }
+      case ColHead::DICT: {
+        const int64_t dict_cnt = head.cnt_;
+        const uint32_t *offsets = reinterpret_cast<const uint32_t *>(payload);
+        const char *data = reinterpret_cast<const char *>(offsets + dict_cnt + 1);
+        const char *packed = data + align4(offsets[dict_cnt]);
+        for (int64_t i = 0; i < cnt; i++) {
+          const int64_t ref = static_cast<int64_t>(unpack(packed, start + i, head.bits_));
+          if (ref >= dict_cnt) {
+            datums[i].set_null();
+          } else {
+            set_datum(datums[i], data + offsets[ref], offsets[ref + 1] - offsets[ref]);
+          }
+        }
+        break;
+      }
+      case ColHead::RLE: {
+        const int64_t run_cnt = head.cnt_;
+        const uint32_t *run_ends = reinterpret_cast<const uint32_t *>(payload);
+        const char *nulls = reinterpret_cast<const char *>(run_ends + run_cnt);
+        const uint32_t *offsets = reinterpret_cast<const uint32_t *>(
+            nulls + (head.has_null_ ? bitmap_size(run_cnt) : 0));
+        const char *data = reinterpret_cast<const char *>(offsets + run_cnt + 1);
+        int64_t run = std::upper_bound(run_ends, run_ends + run_cnt,
+                                       static_cast<uint32_t>(start)) - run_ends;
+        for (int64_t i = 0; i < cnt; i++) {
+          while (start + i >= run_ends[run]) {
+            run += 1;
+          }
+          if (head.has_null_ && bitmap_test(nulls, run)) {
+            datums[i].set_null();
+          } else {
+            set_datum(datums[i], data + offsets[run], offsets[run + 1] - offsets[run]);
+          }
+        }
+        break;
+      }
+      case ColHead::BIT_PACK: {
+        const int64_t width = head.width_;
+        const char *nulls = payload;
+        const char *packed = payload + null_bitmap_size;
+        char *values = NULL;
+        if (cnt > 0 && OB_ISNULL(values = static_cast<char *>(alloc.alloc(cnt * width)))) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_WARN("allocate memory failed", K(ret), K(cnt), K(width));
+        }
+        for (int64_t i = 0; OB_SUCC(ret) && i < cnt; i++) {
+          const int64_t row = start + i;
+          if (head.has_null_ && bitmap_test(nulls, row)) {
+            datums[i].set_null();
+          } else {
+            const uint64_t v = head.base_ + unpack(packed, row, head.bits_);
+            MEMCPY(values + i * width, &v, width);
+            set_datum(datums[i], values + i * width, static_cast<uint32_t>(width));
+          }
+        }
+        break;
+      }
+      default: {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unknown column encoding", K(ret), K(head.encoding_), K(col_idx));
+      }
+    }
+  }
+  return ret;
+}
+
+} // end namespace dtl
+} // end namespace sql
+} // end namespace oceanbase
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_DTL_COLUMNAR_CODEC_H
+#define OB_DTL_COLUMNAR_CODEC_H
+
+#include "lib/allocator/ob_allocator.h"
+#include "share/datum/ob_datum.h"
+#include "sql/engine/basic/ob_chunk_datum_store.h"
+
+namespace oceanbase {
+namespace sql {
+namespace dtl {
+
+class ObDtlLinkedBuffer;
+
+// Column-wise encoded PX data message (PX_COLUMNAR_DATUM).
+//
+// The rows of a PX_DATUM_ROW message (one ObChunkDatumStore::Block) are re-encoded column by
+// column before the message is sent through rpc, each column chooses the smallest encoding of:
+//   RAW:      [null bitmap] [uint32 offsets (rows + 1)] [data]
+//   DICT:     [uint32 offsets (dict_cnt + 1)] [dict data] [bit packed refs, null is dict_cnt]
+//   RLE:      [uint32 run ends (run_cnt)] [run null bitmap] [uint32 offsets (run_cnt + 1)] [data]
+//   BIT_PACK: [null bitmap] [bit packed (value - base)], for columns with fixed 1/2/4/8 bytes
+//             values, which are treated as little endian unsigned integers.
+//
+// Message layout:
+//   | ObDtlColumnarHeader | column offsets (col_cnt) | column 0 | column 1 | ... |
+// and every column starts with ObDtlColumnarColumnHeader.
+struct ObDtlColumnarHeader
+{
+  int32_t rows_;
+  int32_t col_cnt_;
+  uint32_t col_offsets_[0];
+};
+
+struct ObDtlColumnarColumnHeader
+{
+  enum Encoding
+  {
+    RAW = 0,
+    DICT = 1,
+    RLE = 2,
+    BIT_PACK = 3,
+  };
+  uint8_t encoding_;
+  uint8_t has_null_;
+  uint8_t width_;
+  uint8_t bits_;
+  uint32_t cnt_;
+  uint64_t base_;
+};
+
+class ObDtlColumnarEncoder
+{
+public:
+  // Encode PX_DATUM_ROW message to PX_COLUMNAR_DATUM in place, do nothing if the message
+  // can not be encoded or the encoded message is not smaller.
+  static int encode_buffer(ObDtlLinkedBuffer &buffer);
+
+  // Encode rows of %blk to %buf, %encoded is set to false if encoded size exceeds %buf_len.
+  // %blk must be swizzled.
+  static int encode(common::ObIAllocator &alloc,
+                    ObChunkDatumStore::Block &blk,
+                    char *buf,
+                    const int64_t buf_len,
+                    int64_t &size,
+                    bool &encoded);
+};
+
+class ObDtlColumnarDecoder
+{
+public:
+  static int64_t get_row_cnt(const char *buf)
+  {
+    return reinterpret_cast<const ObDtlColumnarHeader *>(buf)->rows_;
+  }
+  static int64_t get_col_cnt(const char *buf)
+  {
+    return reinterpret_cast<const ObDtlColumnarHeader *>(buf)->col_cnt_;
+  }
+  // Decode rows [start, start + cnt) of column %col_idx to %datums, datums point to the
+  // message buffer, or memory allocated from %alloc for BIT_PACK columns.
+  static int decode(const char *buf,
+                    const int64_t col_idx,
+                    const int64_t start,
+                    const int64_t cnt,
+                    common::ObDatum *datums,
+                    common::ObIAllocator &alloc);
+};
+
+} // end namespace dtl
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif /* OB_DTL_COLUMNAR_CODEC_H */
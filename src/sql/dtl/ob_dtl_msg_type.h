@@ -50,6 +50,9 @@ enum ObDtlMsgType {
   DH_SECOND_STAGE_REPORTING_WF_WHOLE_MSG,
   DH_OPT_STATS_GATHER_PIECE_MSG,
   DH_OPT_STATS_GATHER_WHOLE_MSG, //40
+  PX_COLUMNAR_DATUM,
+  DH_JOIN_SKEW_PIECE_MSG,
+  DH_JOIN_SKEW_WHOLE_MSG,
   MAX
 };
 
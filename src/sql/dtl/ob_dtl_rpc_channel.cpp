@@ -20,6 +20,7 @@
 #include "sql/dtl/ob_dtl.h"
 #include "sql/dtl/ob_dtl_flow_control.h"
 #include "sql/dtl/ob_dtl_channel_agent.h"
+#include "sql/dtl/ob_dtl_columnar_codec.h"
 #include "share/rc/ob_context.h"
 #include "sql/dtl/ob_dtl_channel_watcher.h"
 
@@ -318,6 +319,9 @@ int ObDtlRpcChannel::send_message(ObDtlLinkedBuffer *&buf)
       ret = OB_TIMEOUT;
       LOG_WARN("send dtl message timeout", K(ret), K(peer_),
           K(buf->timeout_ts()));
+    } else if (enable_columnar_encoding_
+               && OB_FAIL(ObDtlColumnarEncoder::encode_buffer(*buf))) {
+      LOG_WARN("columnar encode message failed", K(ret));
     } else if (OB_FAIL(msg_response_.start())) {
       LOG_WARN("start message process fail", K(ret));
     } else if (OB_FAIL(DTL.get_rpc_proxy().to(peer_).timeout(timeout_us)
@@ -21,6 +21,9 @@
 #include "lib/container/ob_2d_array.h"
 #include "sql/engine/basic/ob_chunk_datum_store.h"
 #include "sql/engine/ob_sql_mem_mgr_processor.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
 
 namespace oceanbase
 {
@@ -34,6 +37,14 @@ namespace sql
 
 
 // Auto extended hash table, extend to double buckets size if hash table is quarter filled.
+//
+// Two bucket layouts are supported:
+// 1. Default: linear probing over the bucket array, every probe step reads one bucket.
+// 2. Tag probe (Swiss table style, see set_tag_probe()): an extra control byte per bucket keeps
+//    7 bits of the hash value (or TAG_EMPTY), a probe compares TAG_GROUP_WIDTH control bytes
+//    at once and only reads the buckets whose tag matches. Optionally the head item's
+//    fixed-width key is stored inline (parallel to the buckets), so that integer keys can be
+//    compared without dereferencing the item.
 template <typename Item>
 class ObExtendHashTable
 {
@@ -41,6 +52,8 @@ public:
   const static int64_t INITIAL_SIZE = 128;
   const static int64_t SIZE_BUCKET_SCALE = 2;
   const static int64_t MAX_MEM_PERCENT = 40;
+  const static uint8_t TAG_EMPTY = 0x80;
+  const static int64_t TAG_GROUP_WIDTH = 16;
 
   struct Bucket
   {
@@ -60,7 +73,11 @@ public:
       size_(0),
       buckets_(NULL),
       allocator_("ExtendHTBucket"),
-      probe_cnt_(0)
+      probe_cnt_(0),
+      use_tag_probe_(false),
+      use_inline_key_(false),
+      tags_(NULL),
+      inline_keys_(NULL)
   {
   }
   ~ObExtendHashTable() { destroy(); }
@@ -72,8 +89,20 @@ public:
   const Item *get(const Item &item);
   // Link item to hash table, extend buckets if needed.
   // (Do not check item is exist or not)
-  int set(Item &item);
+  int set(Item &item) { return set(item, 0); }
+  // Same as above, %inline_key is saved inline if inline key is enabled.
+  int set(Item &item, const int64_t inline_key);
   int64_t size() const { return size_; }
+  // Switch bucket layout, only works before init(). Inline key only works with tag probe.
+  void set_tag_probe(const bool use_tag_probe, const bool use_inline_key)
+  {
+    if (!is_inited()) {
+      use_tag_probe_ = use_tag_probe;
+      use_inline_key_ = use_tag_probe && use_inline_key;
+    }
+  }
+  bool is_tag_probe() const { return use_tag_probe_; }
+  bool is_inline_key() const { return use_inline_key_; }
   int64_t get_probe_cnt() const { return probe_cnt_; }
   void reuse()
   {
@@ -83,6 +112,8 @@ public:
       buckets_->reuse();
       if (OB_FAIL(buckets_->init(bucket_num))) {
         SQL_ENG_LOG(ERROR, "resize bucket array failed", K(size_), K(bucket_num), K(get_bucket_num()));
+      } else if (NULL != tags_) {
+        MEMSET(tags_, TAG_EMPTY, bucket_num);
       }
     }
     size_ = 0;
@@ -98,13 +129,14 @@ public:
       allocator_.free(buckets_);
       buckets_ = NULL;
     }
+    free_tag_arrays(tags_, inline_keys_);
     allocator_.set_allocator(nullptr);
     size_ = 0;
     initial_bucket_num_ = 0;
   }
   int64_t mem_used() const
   {
-    return NULL == buckets_ ? 0 : buckets_->mem_used();
+    return NULL == buckets_ ? 0 : buckets_->mem_used() + tag_arrays_size(buckets_->count());
   }
 
   inline int64_t get_bucket_num() const
@@ -136,20 +168,94 @@ protected:
   // The returned empty bucket is the insert position for the %hash_val
   OB_INLINE const Bucket &locate_bucket(const BucketArray &buckets,
                                         const uint64_t hash_val) const
+  {
+    return buckets.at(locate_pos(buckets, tags_, hash_val));
+  }
+
+  // Same as locate_bucket(), return the position of the bucket.
+  OB_INLINE int64_t locate_pos(const BucketArray &buckets,
+                               const uint8_t *tags,
+                               const uint64_t hash_val) const
   {
     const int64_t cnt = buckets.count();
     int64_t pos = hash_val & (cnt - 1);
-    const Bucket *bucket = &buckets.at(pos);
-    // The extend logical make sure the bucket never full, loop count will always less than %cnt
-    while (hash_val != bucket->hash_ && NULL != bucket->item_) {
-      bucket = &buckets.at((++pos) & (cnt - 1));
+    if (NULL == tags) {
+      const Bucket *bucket = &buckets.at(pos);
+      // The extend logical make sure the bucket never full, loop count will always less than %cnt
+      while (hash_val != bucket->hash_ && NULL != bucket->item_) {
+        pos = (pos + 1) & (cnt - 1);
+        bucket = &buckets.at(pos);
+      }
+    } else {
+      // Probe group by group, the first group is aligned down and the control bytes before
+      // %pos are masked out, so the probe sequence is the same as the default layout.
+      const uint8_t tag = hash_tag(hash_val);
+      int64_t base = pos & ~(TAG_GROUP_WIDTH - 1);
+      uint32_t valid_mask = ~((1U << (pos - base)) - 1);
+      bool found = false;
+      while (!found) {
+        uint32_t match = 0;
+        uint32_t empty = 0;
+        match_tag_group(tags + base, tag, match, empty);
+        match &= valid_mask;
+        empty &= valid_mask;
+        // only the buckets before the first empty one belong to the probe sequence
+        match &= (0 == empty) ? ~0U : ((empty & (~empty + 1)) - 1);
+        for (; 0 != match && !found; match &= match - 1) {
+          const int64_t idx = base + __builtin_ctz(match);
+          if (buckets.at(idx).hash_ == hash_val) {
+            pos = idx;
+            found = true;
+          }
+        }
+        if (!found && 0 != empty) {
+          pos = base + __builtin_ctz(empty);
+          found = true;
+        }
+        base = (base + TAG_GROUP_WIDTH) & (cnt - 1);
+        valid_mask = ~0U;
+      }
+    }
+    return pos;
+  }
+
+  OB_INLINE static uint8_t hash_tag(const uint64_t hash_val)
+  {
+    // high 7 bits, the low bits are used for bucket position
+    return static_cast<uint8_t>(hash_val >> 57);
+  }
+
+  // Compare TAG_GROUP_WIDTH control bytes with %tag, bit i of %match is set if the i-th control
+  // byte equals to %tag, bit i of %empty is set if the i-th bucket is empty.
+  OB_INLINE static void match_tag_group(const uint8_t *group, const uint8_t tag,
+                                        uint32_t &match, uint32_t &empty)
+  {
+#if defined(__SSE2__)
+    const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+    match = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(tag)))));
+    empty = static_cast<uint32_t>(_mm_movemask_epi8(ctrl));
+#else
+    match = 0;
+    empty = 0;
+    for (int64_t i = 0; i < TAG_GROUP_WIDTH; i++) {
+      match |= static_cast<uint32_t>(group[i] == tag) << i;
+      empty |= static_cast<uint32_t>(group[i] >> 7) << i;
     }
-    return *bucket;
+#endif
+  }
+
+  OB_INLINE int64_t tag_arrays_size(const int64_t bucket_num) const
+  {
+    return (use_tag_probe_ ? bucket_num * sizeof(uint8_t) : 0)
+        + (use_inline_key_ ? bucket_num * sizeof(int64_t) : 0);
   }
 
 protected:
   DISALLOW_COPY_AND_ASSIGN(ObExtendHashTable);
   int extend();
+  int alloc_tag_arrays(const int64_t bucket_num, uint8_t *&tags, int64_t *&inline_keys);
+  void free_tag_arrays(uint8_t *&tags, int64_t *&inline_keys);
 protected:
   lib::ObMemAttr mem_attr_;
   int64_t initial_bucket_num_;
@@ -157,6 +263,12 @@ protected:
   BucketArray *buckets_;
   common::ModulePageAllocator allocator_;
   int64_t probe_cnt_;
+  bool use_tag_probe_;
+  bool use_inline_key_;
+  // control bytes of the tag probe layout, NULL for the default layout
+  uint8_t *tags_;
+  // fixed-width key of the bucket's head item, NULL if inline key is disabled
+  int64_t *inline_keys_;
 };
 
 template <typename Item>
@@ -217,21 +329,25 @@ const Item *ObExtendHashTable<Item>::get(const Item &item)
   } else {
     common::hash::hash_func<Item> hf;
     common::hash::equal_to<Item> eqf;
-    const uint64_t hash_val = hf(item);
-    Item *it = locate_bucket(*buckets_, hash_val).item_;
-    while (NULL != it) {
-      if (eqf(*it, item)) {
-        res = it;
-        break;
+    uint64_t hash_val = 0;
+    if (common::OB_SUCCESS != hf(item, hash_val)) {
+      SQL_ENG_LOG_RET(WARN, common::OB_ERR_UNEXPECTED, "hash failed");
+    } else {
+      Item *it = locate_bucket(*buckets_, hash_val).item_;
+      while (NULL != it) {
+        if (eqf(*it, item)) {
+          res = it;
+          break;
+        }
+        it = it->next();
       }
-      it = it->next();
     }
   }
   return res;
 }
 
 template <typename Item>
-int ObExtendHashTable<Item>::set(Item &item)
+int ObExtendHashTable<Item>::set(Item &item, const int64_t inline_key)
 {
   common::hash::hash_func<Item> hf;
   int ret = common::OB_SUCCESS;
@@ -250,13 +366,21 @@ int ObExtendHashTable<Item>::set(Item &item)
     if (OB_FAIL(hf(item, hash_val))) {
       SQL_ENG_LOG(WARN, "hash failed", K(ret));
     } else {
-      Bucket *bucket = const_cast<Bucket *>(&locate_bucket(*buckets_, hash_val));
+      const int64_t pos = locate_pos(*buckets_, tags_, hash_val);
+      Bucket *bucket = &buckets_->at(pos);
       if (NULL == bucket->item_) {
         bucket->hash_ = hash_val;
+        if (NULL != tags_) {
+          tags_[pos] = hash_tag(hash_val);
+        }
       } else {
         item.next() = bucket->item_;
       }
       bucket->item_ = &item;
+      if (NULL != inline_keys_) {
+        // new item is always the head of the bucket
+        inline_keys_[pos] = inline_key;
+      }
       size_ += 1;
     }
   }
@@ -272,13 +396,21 @@ int ObExtendHashTable<Item>::extend()
   int64_t new_bucket_num = 0 == pre_bucket_num ?
                           (0 == initial_bucket_num_ ? INITIAL_SIZE : initial_bucket_num_)
                           : pre_bucket_num * 2;
+  if (use_tag_probe_) {
+    // probe reads the whole control byte group
+    new_bucket_num = std::max(new_bucket_num, static_cast<int64_t>(TAG_GROUP_WIDTH));
+  }
   SQL_ENG_LOG(DEBUG, "extend hash table", K(ret), K(new_bucket_num), K(initial_bucket_num_),
               K(pre_bucket_num));
   if (new_bucket_num <= pre_bucket_num) {
   } else {
     BucketArray *new_buckets = NULL;
+    uint8_t *new_tags = NULL;
+    int64_t *new_inline_keys = NULL;
     void *buckets_buf = NULL;
-    if (OB_ISNULL(buckets_buf = allocator_.alloc(sizeof(BucketArray), mem_attr_))) {
+    if (OB_FAIL(alloc_tag_arrays(new_bucket_num, new_tags, new_inline_keys))) {
+      SQL_ENG_LOG(WARN, "failed to allocate tag arrays", K(ret), K(new_bucket_num));
+    } else if (OB_ISNULL(buckets_buf = allocator_.alloc(sizeof(BucketArray), mem_attr_))) {
       ret = OB_ALLOCATE_MEMORY_FAILED;
       SQL_ENG_LOG(WARN, "failed to allocate memory", K(ret));
     } else {
@@ -296,13 +428,23 @@ int ObExtendHashTable<Item>::extend()
       for (int64_t i = 0; i < size; i++) {
         const Bucket &old = buckets_->at(i);
         if (NULL != old.item_) {
-          const_cast<Bucket &>(locate_bucket(*new_buckets, old.hash_)) = old;
+          const int64_t pos = locate_pos(*new_buckets, new_tags, old.hash_);
+          new_buckets->at(pos) = old;
+          if (NULL != new_tags) {
+            new_tags[pos] = hash_tag(old.hash_);
+          }
+          if (NULL != new_inline_keys) {
+            new_inline_keys[pos] = inline_keys_[i];
+          }
         }
       }
       buckets_->destroy();
       allocator_.free(buckets_);
+      free_tag_arrays(tags_, inline_keys_);
 
       buckets_ = new_buckets;
+      tags_ = new_tags;
+      inline_keys_ = new_inline_keys;
     }
     if (OB_FAIL(ret)) {
       if (buckets_ == new_buckets) {
@@ -312,11 +454,54 @@ int ObExtendHashTable<Item>::extend()
         allocator_.free(new_buckets);
         new_buckets = nullptr;
       }
+      if (tags_ != new_tags || inline_keys_ != new_inline_keys) {
+        free_tag_arrays(new_tags, new_inline_keys);
+      }
     }
   }
   return ret;
 }
 
+template <typename Item>
+int ObExtendHashTable<Item>::alloc_tag_arrays(const int64_t bucket_num,
+                                              uint8_t *&tags,
+                                              int64_t *&inline_keys)
+{
+  int ret = common::OB_SUCCESS;
+  tags = NULL;
+  inline_keys = NULL;
+  if (!use_tag_probe_) {
+    // do nothing
+  } else if (OB_ISNULL(tags = static_cast<uint8_t *>(
+              allocator_.alloc(bucket_num * sizeof(uint8_t), mem_attr_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    SQL_ENG_LOG(WARN, "failed to allocate tags", K(ret), K(bucket_num));
+  } else if (use_inline_key_
+             && OB_ISNULL(inline_keys = static_cast<int64_t *>(
+                          allocator_.alloc(bucket_num * sizeof(int64_t), mem_attr_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    SQL_ENG_LOG(WARN, "failed to allocate inline keys", K(ret), K(bucket_num));
+  } else {
+    MEMSET(tags, TAG_EMPTY, bucket_num * sizeof(uint8_t));
+  }
+  if (OB_FAIL(ret)) {
+    free_tag_arrays(tags, inline_keys);
+  }
+  return ret;
+}
+
+template <typename Item>
+void ObExtendHashTable<Item>::free_tag_arrays(uint8_t *&tags, int64_t *&inline_keys)
+{
+  if (NULL != tags) {
+    allocator_.free(tags);
+    tags = NULL;
+  }
+  if (NULL != inline_keys) {
+    allocator_.free(inline_keys);
+    inline_keys = NULL;
+  }
+}
 
 //Used for calc hash for columns
 class ObHashCols
@@ -16,6 +16,7 @@
 #include "sql/engine/px/ob_px_util.h"
 #include "sql/engine/ob_physical_plan.h"
 #include "sql/engine/ob_exec_context.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase
 {
@@ -168,6 +169,10 @@ int ObHashDistinctOp::init_hash_partition_infras()
     if (MY_SPEC.by_pass_enabled_) {
       hp_infras_.set_push_down();
     }
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id_));
+    if (tenant_config.is_valid()) {
+      hp_infras_.set_tag_filter(tenant_config->_enable_hash_table_tag_probe);
+    }
     int64_t est_bucket_num = hp_infras_.est_bucket_count(est_rows, MY_SPEC.width_,
                                 MIN_BUCKET_COUNT, MAX_BUCKET_COUNT);
     if (OB_FAIL(hp_infras_.set_funcs(&MY_SPEC.hash_funcs_, &MY_SPEC.sort_collations_,
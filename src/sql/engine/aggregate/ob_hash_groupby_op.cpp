@@ -66,9 +66,12 @@ int ObGroupRowHashTable::init(ObIAllocator *allocator,
                               const ObIArray<ObExpr *> &gby_exprs,
                               ObEvalCtx *eval_ctx,
                               const common::ObIArray<ObCmpFunc> *cmp_funcs,
-                              int64_t initial_size)
+                              int64_t initial_size,
+                              const bool use_tag_probe)
 {
   int ret = OB_SUCCESS;
+  set_tag_probe(use_tag_probe, is_inline_key_exprs(gby_exprs));
+  null_key_item_ = nullptr;
   if (OB_FAIL(ObExtendHashTable<ObGroupRowItem>::init(
               allocator, mem_attr, initial_size))) {
     LOG_WARN("failed to init extended hash table", K(ret));
@@ -80,6 +83,30 @@ int ObGroupRowHashTable::init(ObIAllocator *allocator,
   return ret;
 }
 
+bool ObGroupRowHashTable::is_inline_key_exprs(const ObIArray<ObExpr *> &gby_exprs)
+{
+  // integer datum is always 8 bytes, equal datums have the same int value
+  return 1 == gby_exprs.count()
+      && nullptr != gby_exprs.at(0)
+      && ob_is_integer_type(gby_exprs.at(0)->datum_meta_.type_);
+}
+
+int ObGroupRowHashTable::set(ObGroupRowItem &item)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inline_key()) {
+    ret = ObExtendHashTable<ObGroupRowItem>::set(item);
+  } else {
+    const ObDatum &key = get_key_datum(item);
+    if (OB_FAIL(ObExtendHashTable<ObGroupRowItem>::set(item, key.is_null() ? 0 : key.get_int()))) {
+      LOG_WARN("failed to set item", K(ret));
+    } else if (key.is_null()) {
+      null_key_item_ = &item;
+    }
+  }
+  return ret;
+}
+
 int ObGroupRowHashTable::likely_equal(
   const ObGroupRowItem &left, const ObGroupRowItem &right,
   bool &result) const
@@ -177,9 +204,17 @@ int ObHashGroupByOp::inner_open()
     int64_t est_hash_mem_size = 0;
     int64_t estimate_mem_size = 0;
     int64_t init_size = 0;
+    bool use_tag_probe = false;
     ObMemAttr attr(ctx_.get_my_session()->get_effective_tenant_id(),
                    ObModIds::OB_HASH_NODE_GROUP_ROWS,
                    ObCtxIds::WORK_AREA);
+    {
+      omt::ObTenantConfigGuard tenant_config(TENANT_CONF(
+                                        ctx_.get_my_session()->get_effective_tenant_id()));
+      if (tenant_config.is_valid()) {
+        use_tag_probe = tenant_config->_enable_hash_table_tag_probe;
+      }
+    }
     if (OB_FAIL(ObPxEstimateSizeUtil::get_px_size(&ctx_,
                                                   MY_SPEC.px_est_size_factor_,
                                                   est_group_cnt,
@@ -214,7 +249,8 @@ int ObHashGroupByOp::inner_open()
                 dup_groupby_exprs_,
                 &eval_ctx_,
                 &MY_SPEC.cmp_funcs_,
-                init_size))) {
+                init_size,
+                use_tag_probe))) {
       LOG_WARN("fail to init hash map", K(ret));
     } else if (OB_FAIL(sql_mem_processor_.update_used_mem_size(get_mem_used_size()))) {
       LOG_WARN("fail to update_used_mem_size", "size", get_mem_used_size(), K(ret));
@@ -115,7 +115,8 @@ public:
 class ObGroupRowHashTable : public ObExtendHashTable<ObGroupRowItem>
 {
 public:
-  ObGroupRowHashTable() : ObExtendHashTable(), eval_ctx_(nullptr), cmp_funcs_(nullptr) {}
+  ObGroupRowHashTable()
+    : ObExtendHashTable(), eval_ctx_(nullptr), cmp_funcs_(nullptr), null_key_item_(nullptr) {}
 
   OB_INLINE const ObGroupRowItem *get(const ObGroupRowItem &item);
   OB_INLINE void prefetch(const ObBatchRows &brs, uint64_t *hash_vals) const;
@@ -124,13 +125,41 @@ public:
           const common::ObIArray<ObExpr *> &gby_exprs,
           ObEvalCtx *eval_ctx,
           const common::ObIArray<ObCmpFunc> *cmp_funcs,
-          int64_t initial_size = INITIAL_SIZE);
+          int64_t initial_size = INITIAL_SIZE,
+          const bool use_tag_probe = false);
+  int set(ObGroupRowItem &item);
+  void reuse()
+  {
+    ObExtendHashTable<ObGroupRowItem>::reuse();
+    null_key_item_ = nullptr;
+  }
+  int resize(ObIAllocator *allocator, int64_t bucket_num)
+  {
+    null_key_item_ = nullptr;
+    return ObExtendHashTable<ObGroupRowItem>::resize(allocator, bucket_num);
+  }
+  void destroy()
+  {
+    ObExtendHashTable<ObGroupRowItem>::destroy();
+    null_key_item_ = nullptr;
+  }
+  // Group by one integer column, the key can be saved inline in hash table.
+  static bool is_inline_key_exprs(const common::ObIArray<ObExpr *> &gby_exprs);
 private:
   int likely_equal(const ObGroupRowItem &left, const ObGroupRowItem &right, bool &result) const;
+  OB_INLINE const ObDatum &get_key_datum(const ObGroupRowItem &item) const
+  {
+    return item.is_expr_row_
+        ? gby_exprs_->at(0)->locate_expr_datum(*eval_ctx_, item.batch_idx_)
+        : item.groupby_store_row_->cells()[0];
+  }
 private:
   const common::ObIArray<ObExpr *> *gby_exprs_;
   ObEvalCtx *eval_ctx_;
   const common::ObIArray<ObCmpFunc> *cmp_funcs_;
+  // With inline key, the only group of NULL key is kept here instead of comparing with the
+  // inline keys, which can not represent NULL.
+  ObGroupRowItem *null_key_item_;
   static const int64_t HASH_BUCKET_PREFETCH_MAGIC_NUM = 4 * 1024;
 };
 
@@ -142,6 +171,29 @@ OB_INLINE const ObGroupRowItem *ObGroupRowHashTable::get(const ObGroupRowItem &i
   ++probe_cnt_;
   if (OB_UNLIKELY(NULL == buckets_)) {
     // do nothing
+  } else if (NULL != inline_keys_) {
+    const ObDatum &key = get_key_datum(item);
+    if (key.is_null()) {
+      res = null_key_item_;
+    } else {
+      const int64_t pos = locate_pos(*buckets_, tags_, item.hash());
+      ObGroupRowItem *it = buckets_->at(pos).item_;
+      if (NULL != it && it != null_key_item_ && inline_keys_[pos] == key.get_int()) {
+        res = it;
+      } else {
+        // head item is not equal, the other items with the same hash value are rare
+        it = NULL == it ? NULL : it->next();
+        while (NULL != it && OB_SUCC(ret)) {
+          if (OB_FAIL(likely_equal(*it, item, result))) {
+            LOG_WARN("failed to cmp", K(ret));
+          } else if (result) {
+            res = it;
+            break;
+          }
+          it = it->next();
+        }
+      }
+    }
   } else {
     const uint64_t hash_val = item.hash();
     ObGroupRowItem *it = locate_bucket(*buckets_, hash_val).item_;
@@ -164,6 +216,38 @@ OB_INLINE void ObGroupRowHashTable::prefetch(const ObBatchRows &brs, uint64_t *h
     // do nothing
   } else if (buckets_->count() <= HASH_BUCKET_PREFETCH_MAGIC_NUM) {
     // stop prefetching if hashtable is not big enough
+  } else if (NULL != tags_) {
+    // Tag probe layout: the control bytes, buckets and inline keys are all addressed by hash
+    // value, prefetch them in one pass without dependent loads.
+    auto mask = get_bucket_num() - 1;
+    for (auto i = 0; i < brs.size_; i++) {
+      if (brs.skip_->at(i)) {
+        continue;
+      }
+      const int64_t pos = hash_vals[i] & mask;
+      __builtin_prefetch(&tags_[pos], 0/* read */, 2 /*high temp locality*/);
+      __builtin_prefetch(&buckets_->at(pos), 0/* read */, 2 /*high temp locality*/);
+      if (NULL != inline_keys_) {
+        __builtin_prefetch(&inline_keys_[pos], 0/* read */, 2 /*high temp locality*/);
+      }
+    }
+    if (NULL == inline_keys_) {
+      for (auto i = 0; i < brs.size_; i++) {
+        if (brs.skip_->at(i)) {
+          continue;
+        }
+        __builtin_prefetch((buckets_->at(hash_vals[i] & mask).item_),
+                           0/* read */, 2 /*high temp locality*/);
+      }
+      for (auto i = 0; i < brs.size_; i++) {
+        auto item = buckets_->at(hash_vals[i] & mask).item_;
+        if (brs.skip_->at(i) || OB_ISNULL(item) || OB_ISNULL(item->groupby_store_row_)) {
+          continue;
+        }
+        __builtin_prefetch(item->groupby_store_row_,
+                           0/* read */, 2 /*high temp locality*/);
+      }
+    }
   } else {
     auto mask = get_bucket_num() - 1;
     for(auto i = 0; i < brs.size_; i++) {
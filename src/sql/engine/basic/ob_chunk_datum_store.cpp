@@ -19,6 +19,9 @@
 #include "lib/container/ob_se_array_iterator.h"
 #include "lib/utility/ob_tracepoint.h"
 #include "share/config/ob_server_config.h"
+#include "lib/compress/ob_compressor_pool.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
+#include "lib/stat/ob_diagnose_info.h"
 
 namespace oceanbase
 {
@@ -488,7 +491,10 @@ ObChunkDatumStore::ObChunkDatumStore(const ObLabel &label, common::ObIAllocator
     mem_hold_(0), mem_used_(0), max_hold_mem_(0),
     allocator_(NULL == alloc ? &inner_allocator_ : alloc),
     row_extend_size_(0), callback_(nullptr), batch_ctx_(NULL),
-    tmp_dump_blk_(nullptr)
+    tmp_dump_blk_(nullptr), compressor_type_(INVALID_COMPRESSOR), compressor_(NULL),
+    compress_buf_(NULL), compress_buf_size_(0), compress_disabled_(false),
+    compress_blk_cnt_(0), compress_src_size_(0), compress_dst_size_(0), dump_raw_size_(0),
+    file_blk_sizes_()
 {
   io_.fd_ = -1;
   io_.dir_id_ = -1;
@@ -519,6 +525,7 @@ int ObChunkDatumStore::init(int64_t mem_limit,
   min_blk_size_ = INT64_MAX;
   io_.fd_ = -1;
   row_extend_size_ = row_extend_size;
+  file_blk_sizes_.set_attr(ObMemAttr(tenant_id, "ChunkBlkSizes"));
   return ret;
 }
 
@@ -530,12 +537,20 @@ void ObChunkDatumStore::reset()
     if (OB_FAIL(FILE_MANAGER_INSTANCE_V2.remove(io_.fd_))) {
       LOG_WARN("remove file failed", K(ret), K_(io_.fd));
     } else {
-      LOG_INFO("close file success", K(ret), K_(io_.fd));
+      LOG_INFO("close file success", K(ret), K_(io_.fd), K_(file_size), K_(compressor_type),
+               "compress_saved_size", get_compress_saved_size(), K_(compress_disabled));
     }
     io_.fd_ = -1;
   }
   file_size_ = 0;
   n_block_in_file_ = 0;
+  compressor_ = NULL;
+  compress_disabled_ = false;
+  compress_blk_cnt_ = 0;
+  compress_src_size_ = 0;
+  compress_dst_size_ = 0;
+  dump_raw_size_ = 0;
+  file_blk_sizes_.reset();
 
   while (!blocks_.is_empty()) {
     Block *item = blocks_.remove_first();
@@ -747,9 +762,20 @@ inline int ObChunkDatumStore::dump_one_block(BlockBuffer *item)
   if (item->cur_pos_ <= 0) {
     LOG_WARN("unexpected: dump zero", K(item), K(item->cur_pos_));
   }
+  bool compressed = false;
+  // size of the block in file if not compressed
+  const int64_t raw_size = std::max(item->capacity(), min_block_size);
+  const int64_t prev_file_size = file_size_;
   item->block->magic_ = Block::MAGIC;
   if (OB_FAIL(item->get_block()->unswizzling())) {
     LOG_WARN("convert block to copyable failed", K(ret));
+  } else if (!is_file_open() && OB_FAIL(init_compressor())) {
+    LOG_WARN("init compressor failed", K(ret));
+  } else if (is_compress_enabled() && !compress_disabled_
+             && OB_FAIL(write_compressed_block(item, raw_size, compressed))) {
+    LOG_WARN("write compressed block failed", K(ret));
+  } else if (compressed) {
+    // do nothing
   } else if (item->capacity() < min_block_size) {
     if (OB_ISNULL(tmp_dump_blk_)) {
       if (OB_FAIL(alloc_block_buffer(tmp_dump_blk_, default_block_size_, false))) {
@@ -774,6 +800,11 @@ inline int ObChunkDatumStore::dump_one_block(BlockBuffer *item)
   }
   if (OB_SUCC(ret)) {
     n_block_in_file_++;
+    dump_raw_size_ += raw_size;
+    EVENT_ADD(SQL_SPILL_RAW_BYTES, raw_size);
+    if (compressed) {
+      EVENT_ADD(SQL_SPILL_COMPRESS_SAVED_BYTES, raw_size - (file_size_ - prev_file_size));
+    }
     LOG_DEBUG("RowStore Dumpped block", K_(item->block->rows),
       K_(item->cur_pos), K(item->capacity()));
   }
@@ -783,6 +814,94 @@ inline int ObChunkDatumStore::dump_one_block(BlockBuffer *item)
   return ret;
 }
 
+int ObChunkDatumStore::init_compressor()
+{
+  int ret = OB_SUCCESS;
+  if (INVALID_COMPRESSOR == compressor_type_) {
+    compressor_type_ = NONE_COMPRESSOR;
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id_));
+    if (tenant_config.is_valid()
+        && OB_FAIL(ObCompressorPool::get_instance().get_compressor_type(
+                   tenant_config->_sql_spill_compress_func, compressor_type_))) {
+      LOG_WARN("get compressor type failed", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (NONE_COMPRESSOR == compressor_type_) {
+    compressor_ = NULL;
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(compressor_type_,
+                                                                     compressor_))) {
+    LOG_WARN("get compressor failed", K(ret), K_(compressor_type));
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::write_compressed_block(BlockBuffer *item,
+                                               const int64_t raw_size,
+                                               bool &compressed)
+{
+  int ret = OB_SUCCESS;
+  compressed = false;
+  Block *blk = item->get_block();
+  const int64_t head_size = sizeof(Block) + sizeof(int64_t);
+  const int64_t src_size = item->data_size() - BlockBuffer::HEAD_SIZE;
+  int64_t max_overflow_size = 0;
+  int64_t compressed_size = 0;
+  if (OB_ISNULL(compressor_) || OB_UNLIKELY(src_size < 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected compress status", K(ret), KP_(compressor), K(src_size));
+  } else if (OB_FAIL(compressor_->get_max_overflow_size(src_size, max_overflow_size))) {
+    LOG_WARN("get max overflow size failed", K(ret), K(src_size));
+  } else if (compress_buf_size_ < head_size + src_size + max_overflow_size) {
+    const int64_t size = next_pow2(head_size + src_size + max_overflow_size);
+    free_blk_mem(compress_buf_, compress_buf_size_);
+    compress_buf_size_ = 0;
+    if (OB_ISNULL(compress_buf_ = static_cast<char *>(alloc_blk_mem(size, false)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc memory failed", K(ret), K(size));
+    } else {
+      compress_buf_size_ = size;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(compressor_->compress(blk->payload_, src_size,
+                                           compress_buf_ + head_size,
+                                           compress_buf_size_ - head_size,
+                                           compressed_size))) {
+    LOG_WARN("compress block failed", K(ret), K(src_size));
+  } else {
+    // the ratio is measured in file size, the same as the saved size
+    update_compress_ratio(raw_size, std::min(raw_size, head_size + compressed_size));
+    if (head_size + compressed_size < raw_size) {
+      Block *head = reinterpret_cast<Block *>(compress_buf_);
+      head->magic_ = Block::COMPRESSED_MAGIC;
+      head->blk_size_ = blk->blk_size_;
+      head->rows_ = blk->rows_;
+      *reinterpret_cast<int64_t *>(head->payload_) = compressed_size;
+      if (OB_FAIL(write_file(compress_buf_, head_size + compressed_size))) {
+        LOG_WARN("write compressed block to file failed", K(ret));
+      } else {
+        compressed = true;
+      }
+    }
+  }
+  return ret;
+}
+
+void ObChunkDatumStore::update_compress_ratio(const int64_t raw_size,
+                                              const int64_t file_size)
+{
+  compress_blk_cnt_ += 1;
+  compress_src_size_ += raw_size;
+  compress_dst_size_ += file_size;
+  if (compress_blk_cnt_ >= COMPRESS_SAMPLE_BLK_CNT
+      && compress_dst_size_ * 100 > compress_src_size_ * COMPRESS_DISABLE_PERCENT) {
+    compress_disabled_ = true;
+    LOG_TRACE("disable spill compression for poor compress ratio", K_(compress_blk_cnt),
+              K_(compress_src_size), K_(compress_dst_size), K_(compressor_type));
+  }
+}
+
 // only clean memory data
 int ObChunkDatumStore::clean_memory_data(bool reuse)
 {
@@ -2055,6 +2174,9 @@ int ObChunkDatumStore::write_file(void *buf, int64_t size)
       LOG_WARN("write to file failed", K(ret), K_(io), K(timeout_ms));
     }
   }
+  if (OB_SUCC(ret) && is_compress_enabled() && OB_FAIL(file_blk_sizes_.push_back(size))) {
+    LOG_WARN("push back failed", K(ret));
+  }
   if (OB_SUCC(ret)) {
     file_size_ += size;
     if (nullptr != callback_) {
@@ -2377,6 +2499,11 @@ void ObChunkDatumStore::free_tmp_dump_blk()
     free_block(tmp_dump_blk_);
     tmp_dump_blk_ = nullptr;
   }
+  if (NULL != compress_buf_) {
+    free_blk_mem(compress_buf_, compress_buf_size_);
+    compress_buf_ = NULL;
+    compress_buf_size_ = 0;
+  }
 }
 
 
@@ -2426,6 +2553,7 @@ void ObChunkDatumStore::Iterator::reset_cursor(const int64_t file_size)
   cur_iter_blk_ = nullptr;
   cur_nth_blk_ = -1;
   cur_iter_pos_ = 0;
+  cur_file_blk_idx_ = 0;
   iter_end_flag_ = IterEndState::PROCESSING;
 }
 
@@ -2513,7 +2641,11 @@ int ObChunkDatumStore::Iterator::read_next_blk()
     LOG_WARN("read corrupt data", K(ret), K(aio_blk_->magic_),
              K(store_->file_size_), K(cur_iter_pos_));
   }
-  if (OB_SUCC(ret)) {
+  if (OB_SUCC(ret) && aio_blk_->is_compressed()) {
+    if (OB_FAIL(decompress_aio_blk())) {
+      LOG_WARN("decompress block failed", K(ret));
+    }
+  } else if (OB_SUCC(ret)) {
     // data block is larger than min block
     const int64_t loaded_len = aio_blk_buf_->capacity();
     if (aio_blk_->blk_size_ > loaded_len) {
@@ -2562,18 +2694,70 @@ int ObChunkDatumStore::Iterator::prefetch_next_blk()
 {
   int ret = OB_SUCCESS;
   CK(NULL == aio_blk_);
-  const int64_t block_size = store_->min_blk_size_;
-  if (OB_FAIL(alloc_block(aio_blk_, block_size))) {
+  int64_t block_size = store_->min_blk_size_;
+  int64_t read_size = 0;
+  if (OB_FAIL(ret)) {
+  } else if (store_->is_compress_enabled()) {
+    // size of each block in file is recorded, read the whole block
+    if (OB_UNLIKELY(cur_file_blk_idx_ >= store_->file_blk_sizes_.count())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected file block index", K(ret), K_(cur_file_blk_idx),
+               K(store_->file_blk_sizes_.count()));
+    } else {
+      read_size = store_->file_blk_sizes_.at(cur_file_blk_idx_);
+      block_size = std::max(block_size, read_size + static_cast<int64_t>(sizeof(BlockBuffer)));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(alloc_block(aio_blk_, block_size))) {
     LOG_WARN("allocate block buffer failed", K(ret));
   } else {
     aio_blk_buf_ = aio_blk_->get_buffer();
-    if (OB_FAIL(aio_read((char *)aio_blk_, aio_blk_buf_->capacity()))) {
+    if (0 == read_size) {
+      read_size = aio_blk_buf_->capacity();
+    } else {
+      cur_file_blk_idx_ += 1;
+    }
+    if (OB_FAIL(aio_read((char *)aio_blk_, read_size))) {
       LOG_WARN("aio read failed", K(ret));
     }
   }
   return ret;
 }
 
+int ObChunkDatumStore::Iterator::decompress_aio_blk()
+{
+  int ret = OB_SUCCESS;
+  Block *blk = NULL;
+  const int64_t blk_size = aio_blk_->blk_size_;
+  const int64_t compressed_size = *reinterpret_cast<int64_t *>(aio_blk_->payload_);
+  int64_t payload_size = 0;
+  if (OB_ISNULL(store_->compressor_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("compressor is null", K(ret));
+  } else if (OB_FAIL(alloc_block(blk, blk_size + sizeof(BlockBuffer)))) {
+    LOG_WARN("alloc block failed", K(ret), K(blk_size));
+  } else {
+    BlockBuffer *blk_buf = blk->get_buffer();
+    if (OB_FAIL(store_->compressor_->decompress(aio_blk_->payload_ + sizeof(int64_t),
+                                                compressed_size,
+                                                blk->payload_,
+                                                blk_buf->capacity() - sizeof(Block),
+                                                payload_size))) {
+      LOG_WARN("decompress failed", K(ret), K(compressed_size), K(blk_size));
+      free_block(blk, blk_buf->mem_size());
+    } else {
+      blk->magic_ = Block::MAGIC;
+      blk->blk_size_ = static_cast<uint32_t>(blk_size);
+      blk->rows_ = aio_blk_->rows_;
+      free_block(aio_blk_, aio_blk_buf_->mem_size());
+      aio_blk_ = blk;
+      aio_blk_buf_ = blk_buf;
+    }
+  }
+  return ret;
+}
+
 int ObChunkDatumStore::Iterator::alloc_block(Block *&blk, const int64_t size)
 {
   int ret = OB_SUCCESS;
@@ -15,6 +15,7 @@
 
 #include "share/ob_define.h"
 #include "lib/container/ob_se_array.h"
+#include "lib/container/ob_array.h"
 #include "lib/allocator/page_arena.h"
 #include "lib/utility/ob_print_utils.h"
 #include "lib/list/ob_dlist.h"
@@ -25,6 +26,7 @@
 #include "storage/blocksstable/ob_tmp_file.h"
 #include "sql/engine/basic/ob_sql_mem_callback.h"
 #include "sql/engine/basic/ob_batch_result_holder.h"
+#include "lib/compress/ob_compressor.h"
 
 namespace oceanbase
 {
@@ -389,6 +391,9 @@ public:
   struct Block
   {
     static const int64_t MAGIC = 0xbc054e02d8536315;
+    // magic of compressed block in file, the block head is followed by the compressed size
+    // (int64_t) and the compressed payload. %blk_size_ is the size of uncompressed block.
+    static const int64_t COMPRESSED_MAGIC = 0xbc054e02d8536316;
     static const int32_t ROW_HEAD_SIZE = sizeof(StoredRow);
     Block() : magic_(0), blk_size_(0), rows_(0){}
 
@@ -458,7 +463,8 @@ public:
     int gen_unswizzling_payload(char *unswizzling_payload, uint32 size);
     int unswizzling();
     int swizzling(int64_t *col_cnt);
-    inline bool magic_check() { return MAGIC == magic_; }
+    inline bool magic_check() { return MAGIC == magic_ || COMPRESSED_MAGIC == magic_; }
+    inline bool is_compressed() const { return COMPRESSED_MAGIC == magic_; }
     int get_store_row(int64_t &cur_pos, const StoredRow *&sr);
     inline Block* get_next() const { return next_; }
     inline bool is_empty() { return get_buffer()->is_empty(); }
@@ -717,7 +723,8 @@ public:
                  aio_blk_(NULL),
                  aio_blk_buf_(NULL),
                  age_(NULL),
-                 blk_holder_ptr_(NULL) {}
+                 blk_holder_ptr_(NULL),
+                 cur_file_blk_idx_(0) {}
     virtual ~Iterator() { reset_cursor(0); }
     int init(ObChunkDatumStore *row_store, const IterationAge *age = NULL);
     void set_iteration_age(const IterationAge *age) { age_ = age; }
@@ -772,6 +779,8 @@ public:
     int read_next_blk();
     int aio_read(char *buf, const int64_t size);
     int aio_wait();
+    // replace the compressed %aio_blk_ with the decompressed block
+    int decompress_aio_blk();
     int alloc_block(Block *&blk, const int64_t size);
     void free_block(Block *blk, const int64_t size, bool force_free = false);
     void try_free_cached_blocks();
@@ -885,6 +894,8 @@ public:
      const IterationAge *age_;
      int64_t default_block_size_;
      IteratedBlockHolder *blk_holder_ptr_;
+     // index of the next block to read in file, used when spill compression is enabled
+     int64_t cur_file_blk_idx_;
   };
 
   struct BatchCtx
@@ -1027,7 +1038,7 @@ public:
   void set_dir_id(int64_t dir_id) { io_.dir_id_ = dir_id; }
   int alloc_dir_id();
   TO_STRING_KV(K_(tenant_id), K_(label), K_(ctx_id),  K_(mem_limit),
-      K_(row_cnt), K_(file_size), K_(enable_dump));
+      K_(row_cnt), K_(file_size), K_(enable_dump), K_(compressor_type), K_(dump_raw_size));
 
   int append_datum_store(const ObChunkDatumStore &other_store);
   int assign(const ObChunkDatumStore &other_store);
@@ -1049,6 +1060,16 @@ public:
     return io_event_observer_;
   }
   inline int64_t get_max_blk_size() const { return max_blk_size_; }
+  // Set compressor for spilled blocks, it is read from tenant config on the first dump if not set.
+  void set_compressor_type(const common::ObCompressorType type) { compressor_type_ = type; }
+  inline common::ObCompressorType get_compressor_type() const { return compressor_type_; }
+  inline bool is_compress_enabled() const { return NULL != compressor_; }
+  inline bool is_compress_disabled_by_ratio() const { return compress_disabled_; }
+  // Bytes saved by compression, compared with dumping uncompressed blocks. Both sizes are
+  // the sizes of blocks in file, the saved bytes are also added to sysstat
+  // "sql spill compress saved bytes" while dumping.
+  inline int64_t get_compress_saved_size() const { return dump_raw_size_ - file_size_; }
+  inline int64_t get_dump_raw_size() const { return dump_raw_size_; }
 private:
   OB_INLINE int add_row(const common::ObIArray<ObExpr*> &exprs, ObEvalCtx *ctx,
                         const int64_t row_size, StoredRow **stored_row);
@@ -1082,6 +1103,12 @@ private:
       mem_used_ += used;
     }
   inline int dump_one_block(BlockBuffer *item);
+  int init_compressor();
+  // Write compressed block to file, %compressed is set to false if the block is not compressed
+  // for poor compress ratio. %raw_size is the size written to file if not compressed.
+  int write_compressed_block(BlockBuffer *item, const int64_t raw_size, bool &compressed);
+  // %raw_size and %file_size are the sizes of block in file without and with compression
+  void update_compress_ratio(const int64_t raw_size, const int64_t file_size);
 
   int write_file(void *buf, int64_t size);
   int read_file(
@@ -1177,6 +1204,25 @@ private:
   BatchCtx *batch_ctx_;
   Block *tmp_dump_blk_;
 
+  // spill compression
+  // compression is disabled after COMPRESS_SAMPLE_BLK_CNT blocks compressed if the compressed
+  // size exceeds COMPRESS_DISABLE_PERCENT percent of the uncompressed size.
+  static const int64_t COMPRESS_SAMPLE_BLK_CNT = 16;
+  static const int64_t COMPRESS_DISABLE_PERCENT = 85;
+  common::ObCompressorType compressor_type_;
+  common::ObCompressor *compressor_;
+  char *compress_buf_;
+  int64_t compress_buf_size_;
+  bool compress_disabled_;
+  int64_t compress_blk_cnt_;
+  // sizes in file of the compressed blocks without and with compression
+  int64_t compress_src_size_;
+  int64_t compress_dst_size_;
+  // size in file of dumped blocks without compression, the same basis as file_size_
+  int64_t dump_raw_size_;
+  // size of each block in file, only maintained when compression is enabled
+  common::ObArray<int64_t> file_blk_sizes_;
+
   DISALLOW_COPY_AND_ASSIGN(ObChunkDatumStore);
 };
 
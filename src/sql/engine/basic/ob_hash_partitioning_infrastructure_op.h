@@ -104,7 +104,7 @@ public:
     buckets_(nullptr), allocator_(nullptr),
     hash_funcs_(nullptr), sort_collations_(nullptr), cmp_funcs_(nullptr),
     eval_ctx_(nullptr), sql_mem_processor_(nullptr), is_push_down_(false),
-    exprs_(nullptr)
+    exprs_(nullptr), use_tag_filter_(false), tags_(nullptr)
   {
   }
   ~ObHashPartitionExtendHashTable() { destroy(); }
@@ -127,12 +127,32 @@ public:
   int check_and_extend();
   int extend(const int64_t new_bucket_num);
   int64_t size() const { return size_; }
+  // Keep one tag byte per bucket, each item in the bucket list sets one bit of it by the high
+  // bits of its hash value. Probing an absent key mostly finishes on the tag byte without walking
+  // the bucket list. Only works before init().
+  void set_tag_filter(const bool use_tag_filter)
+  {
+    if (OB_ISNULL(buckets_)) {
+      use_tag_filter_ = use_tag_filter;
+    }
+  }
+  OB_INLINE static uint8_t tag_bit(const uint64_t hash_value)
+  {
+    return static_cast<uint8_t>(1 << (hash_value >> 61));
+  }
+  OB_INLINE bool may_exist(const int64_t bucket_idx, const uint64_t hash_value) const
+  {
+    return nullptr == tags_ || 0 != (tags_[bucket_idx] & tag_bit(hash_value));
+  }
 
   void reuse()
   {
     if (OB_NOT_NULL(buckets_)) {
       buckets_->set_all(nullptr);
     }
+    if (OB_NOT_NULL(tags_)) {
+      MEMSET(tags_, 0, get_bucket_num());
+    }
     size_ = 0;
     exprs_ = nullptr;
   }
@@ -153,6 +173,12 @@ public:
       }
       buckets_ = nullptr;
     }
+    if (OB_NOT_NULL(tags_)) {
+      if (nullptr != allocator_) {
+        allocator_->free(tags_);
+      }
+      tags_ = nullptr;
+    }
     if (OB_NOT_NULL(allocator_)) {
       ob_delete(allocator_);
       allocator_ = nullptr;
@@ -161,7 +187,8 @@ public:
   }
   int64_t mem_used() const
   {
-    return nullptr == buckets_ ? 0 : buckets_->mem_used();
+    return nullptr == buckets_ ? 0
+        : buckets_->mem_used() + (nullptr == tags_ ? 0 : get_bucket_num());
   }
 
   template <typename CB>
@@ -213,6 +240,7 @@ private:
     const int64_t max_hash_mem,
     const int64_t min_bucket);
   int create_bucket_array(const int64_t bucket_num, BucketArray *&new_buckets);
+  int create_tag_array(const int64_t bucket_num, uint8_t *&new_tags);
 public:
   int64_t size_;
   int64_t bucket_num_;
@@ -227,6 +255,9 @@ public:
   ObSqlMemMgrProcessor *sql_mem_processor_;
   bool is_push_down_;
   const common::ObIArray<ObExpr*> *exprs_;
+  bool use_tag_filter_;
+  // tag byte of each bucket, nullptr if tag filter is disabled
+  uint8_t *tags_;
 };
 
 template<typename HashCol, typename HashRowStore>
@@ -663,6 +694,8 @@ public:
   int64_t get_hash_table_size() const { return hash_table_.size(); }
   int64_t get_hash_store_mem_used() const { return preprocess_part_.store_.get_mem_used(); }
   void set_push_down() { is_push_down_ = true; }
+  // Only works before init_hash_table()
+  void set_tag_filter(const bool use_tag_filter) { hash_table_.set_tag_filter(use_tag_filter); }
   int process_dump(bool is_block, bool &full_by_pass);
   int extend_hash_table_l3()
   {
@@ -1391,6 +1424,9 @@ set_distinct_batch(const common::ObIArray<ObExpr *> &exprs,
         continue;
       }
       int64_t bkt_idx = (hash_values_for_batch[i] & num_cnt);
+      if (nullptr != hash_table_.tags_) {
+        __builtin_prefetch(&hash_table_.tags_[bkt_idx], 0/* read */, 2 /*high temp locality*/);
+      }
       auto &curr_bkt = buckets->at(bkt_idx);
       __builtin_prefetch(curr_bkt, 0/* read */, 2 /*high temp locality*/);
     }
@@ -1398,6 +1434,7 @@ set_distinct_batch(const common::ObIArray<ObExpr *> &exprs,
       int64_t bkt_idx = (hash_values_for_batch[i] & num_cnt);
       auto &curr_bkt = buckets->at(bkt_idx);
       if ((OB_NOT_NULL(skip) && skip->at(i))
+          || !hash_table_.may_exist(bkt_idx, hash_values_for_batch[i])
           || nullptr == curr_bkt
           || curr_bkt->hash_value_ != hash_values_for_batch[i]) {
         continue;
@@ -2609,6 +2646,11 @@ int ObHashPartitionExtendHashTable<Item>::init(
     } else if (OB_FAIL(create_bucket_array(is_push_down
                                          ? INIT_BKT_NUM_PUSH_DOWM : est_bucket_num, buckets_))) {
       SQL_ENG_LOG(WARN, "failed to create bucket array", K(ret), K(est_bucket_num));
+    } else if (OB_FAIL(create_tag_array(buckets_->count(), tags_))) {
+      SQL_ENG_LOG(WARN, "failed to create tag array", K(ret), K(est_bucket_num));
+      buckets_->destroy();
+      allocator_->free(buckets_);
+      buckets_ = nullptr;
     } else {
       SQL_ENG_LOG(DEBUG, "debug init hash part table", K(ret),
         K(est_bucket_num), K(initial_size), K(sql_mem_processor->get_mem_bound()));
@@ -2671,6 +2713,27 @@ int ObHashPartitionExtendHashTable<Item>::create_bucket_array(
   return ret;
 }
 
+template <typename Item>
+int ObHashPartitionExtendHashTable<Item>::create_tag_array(
+  const int64_t bucket_num,
+  uint8_t *&new_tags)
+{
+  int ret = OB_SUCCESS;
+  new_tags = nullptr;
+  if (!use_tag_filter_) {
+    // do nothing
+  } else if (OB_ISNULL(allocator_)) {
+    ret = OB_ERR_UNEXPECTED;
+    SQL_ENG_LOG(WARN, "allocator is null", K(ret));
+  } else if (OB_ISNULL(new_tags = static_cast<uint8_t *>(allocator_->alloc(bucket_num)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    SQL_ENG_LOG(WARN, "failed to allocate memory", K(ret), K(bucket_num));
+  } else {
+    MEMSET(new_tags, 0, bucket_num);
+  }
+  return ret;
+}
+
 template <typename Item>
 int ObHashPartitionExtendHashTable<Item>::resize(
   common::ObIAllocator *allocator, int64_t bucket_num, ObSqlMemMgrProcessor *sql_mem_processor)
@@ -2706,7 +2769,8 @@ int ObHashPartitionExtendHashTable<Item>::get(
     common::hash::hash_func<Item> hf;
     bool equal_res = false;
     uint64_t bucket_hash_val = 0;
-    Item *bucket = buckets_->at(hash_value & (get_bucket_num() - 1));
+    const int64_t bucket_idx = hash_value & (get_bucket_num() - 1);
+    Item *bucket = may_exist(bucket_idx, hash_value) ? buckets_->at(bucket_idx) : nullptr;
     ObEvalCtx::BatchInfoScopeGuard guard(*eval_ctx_);
     while (OB_SUCC(ret) && NULL != bucket) {
       if (OB_FAIL(hf(*bucket, bucket_hash_val))) {
@@ -2751,9 +2815,13 @@ int ObHashPartitionExtendHashTable<Item>::set(Item &item)
   } else if (OB_FAIL(hf(item, hash_val))) {
     SQL_ENG_LOG(WARN, "hash failed", K(ret));
   } else {
-    Item *&bucket = buckets_->at(hash_val & (get_bucket_num() - 1));
+    const int64_t bucket_idx = hash_val & (get_bucket_num() - 1);
+    Item *&bucket = buckets_->at(bucket_idx);
     item.next() = bucket;
     bucket = &item;
+    if (nullptr != tags_) {
+      tags_[bucket_idx] |= tag_bit(hash_val);
+    }
     size_ += 1;
   }
   return ret;
@@ -2766,8 +2834,9 @@ int ObHashPartitionExtendHashTable<Item>::set_distinct(Item &item, uint64_t hash
   common::hash::hash_func<Item> hf;
   //if bucket != nullptr, check is duplicate and append distinct value
   bool need_insert = true;
-  Item *&insert_bucket = buckets_->at(hash_value & (get_bucket_num() - 1));
-  Item *bucket = insert_bucket;
+  const int64_t bucket_idx = hash_value & (get_bucket_num() - 1);
+  Item *&insert_bucket = buckets_->at(bucket_idx);
+  Item *bucket = may_exist(bucket_idx, hash_value) ? insert_bucket : nullptr;
   ObEvalCtx::BatchInfoScopeGuard guard(*eval_ctx_);
   uint64_t bucket_hash_val = 0;
   if (OB_NOT_NULL(bucket)) {
@@ -2792,6 +2861,9 @@ int ObHashPartitionExtendHashTable<Item>::set_distinct(Item &item, uint64_t hash
   if (need_insert) {
     item.next() = insert_bucket;
     insert_bucket = &item;
+    if (nullptr != tags_) {
+      tags_[bucket_idx] |= tag_bit(hash_value);
+    }
     size_ += 1;
   }
   return ret;
@@ -2827,12 +2899,18 @@ int ObHashPartitionExtendHashTable<Item>::extend(const int64_t new_bucket_num)
   common::hash::hash_func<Item> hf;
   uint64_t hash_val = 0;
   BucketArray *new_buckets = NULL;
+  uint8_t *new_tags = nullptr;
   if (OB_FAIL(ret)) {
   } else if (OB_ISNULL(buckets_)) {
     ret = OB_INVALID_ARGUMENT;
     SQL_ENG_LOG(WARN, "invalid argument", K(ret), K(buckets_));
   } else if (OB_FAIL(create_bucket_array(new_bucket_num, new_buckets))) {
     SQL_ENG_LOG(WARN, "failed to create bucket array", K(ret));
+  } else if (OB_FAIL(create_tag_array(new_buckets->count(), new_tags))) {
+    SQL_ENG_LOG(WARN, "failed to create tag array", K(ret));
+    new_buckets->destroy();
+    allocator_->free(new_buckets);
+    new_buckets = nullptr;
   } else {
     // rehash
     const int64_t tmp_new_bucket_num = new_buckets->count();
@@ -2859,9 +2937,13 @@ int ObHashPartitionExtendHashTable<Item>::extend(const int64_t new_bucket_num)
             if (OB_FAIL(hf(*item, hash_val))) {
               SQL_ENG_LOG(WARN, "fail to get item hash val", K(ret));
             } else {
-              Item *&new_bucket = new_buckets->at(hash_val & (tmp_new_bucket_num - 1));
+              const int64_t new_bucket_idx = hash_val & (tmp_new_bucket_num - 1);
+              Item *&new_bucket = new_buckets->at(new_bucket_idx);
               item->next() = new_bucket;
               new_bucket = item;
+              if (nullptr != new_tags) {
+                new_tags[new_bucket_idx] |= tag_bit(hash_val);
+              }
             }
           } while (nullptr != bucket && OB_SUCC(ret));
         }
@@ -2872,6 +2954,10 @@ int ObHashPartitionExtendHashTable<Item>::extend(const int64_t new_bucket_num)
     buckets_->destroy();
     allocator_->free(buckets_);
     buckets_ = new_buckets;
+    if (nullptr != tags_) {
+      allocator_->free(tags_);
+    }
+    tags_ = new_tags;
   }
   return ret;
 }
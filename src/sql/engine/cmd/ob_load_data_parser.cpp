@@ -12,12 +12,16 @@
 
 #define USING_LOG_PREFIX  SQL_ENG
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 #include "sql/engine/cmd/ob_load_data_parser.h"
 #include "sql/resolver/cmd/ob_load_data_stmt.h"
 #include "lib/oblog/ob_log_module.h"
 #include "lib/utility/ob_print_utils.h"
 #include "lib/string/ob_hex_utils_base.h"
 #include "deps/oblib/src/lib/list/ob_dlist.h"
+#include "common/ob_target_specific.h"
 
 using namespace oceanbase::sql;
 using namespace oceanbase::common;
@@ -30,9 +34,95 @@ const char INVALID_TERM_CHAR = '\xff';
 
 const char * FORMAT_TYPE_STR[] = {
   "CSV",
+  "PARQUET",
 };
 static_assert(array_elements(FORMAT_TYPE_STR) == ObExternalFileFormat::MAX_FORMAT, "Not enough initializer for ObExternalFileFormat");
 
+static uint64_t build_special_char_mask(const char *block,
+                                        const ObCSVStructuralIndex::SpecialChars &special_chars)
+{
+  uint64_t mask = 0;
+  for (int64_t i = 0; i < ObCSVStructuralIndex::BLOCK_SIZE; ++i) {
+    mask |= static_cast<uint64_t>(special_chars.is_special_[static_cast<uint8_t>(block[i])]) << i;
+  }
+  return mask;
+}
+
+#if OB_USE_MULTITARGET_CODE
+// Compare 64 bytes with each special char by two 32 bytes vectors, the sign bit of the data
+// itself marks the non-ascii bytes.
+OB_AVX2_FUNCTION_SPECIFIC_ATTRIBUTE
+static uint64_t build_special_char_mask_avx2(const char *block,
+                                             const ObCSVStructuralIndex::SpecialChars &special_chars)
+{
+  const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block));
+  const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32));
+  __m256i lo_hit = special_chars.mark_non_ascii_ ? lo : _mm256_setzero_si256();
+  __m256i hi_hit = special_chars.mark_non_ascii_ ? hi : _mm256_setzero_si256();
+  for (int64_t i = 0; i < special_chars.cnt_; ++i) {
+    const __m256i c = _mm256_set1_epi8(special_chars.chars_[i]);
+    lo_hit = _mm256_or_si256(lo_hit, _mm256_cmpeq_epi8(lo, c));
+    hi_hit = _mm256_or_si256(hi_hit, _mm256_cmpeq_epi8(hi, c));
+  }
+  const uint64_t lo_mask = static_cast<uint32_t>(_mm256_movemask_epi8(lo_hit));
+  const uint64_t hi_mask = static_cast<uint32_t>(_mm256_movemask_epi8(hi_hit));
+  return lo_mask | (hi_mask << 32);
+}
+#endif
+
+static ObCSVStructuralIndex::BuildMaskFunc get_build_special_char_mask_func()
+{
+#if OB_USE_MULTITARGET_CODE
+  return common::is_arch_supported(ObTargetArch::AVX2)
+      ? build_special_char_mask_avx2
+      : build_special_char_mask;
+#else
+  return build_special_char_mask;
+#endif
+}
+
+static ObCSVStructuralIndex::BuildMaskFunc build_special_char_mask_func =
+    get_build_special_char_mask_func();
+
+void ObCSVStructuralIndex::add_special_char(const int64_t c)
+{
+  // chars out of range never equal to a byte of data, see ObCSVGeneralParser::scan_proto
+  if (c >= INT8_MIN && c <= UINT8_MAX) {
+    const char ch = static_cast<char>(c);
+    bool found = false;
+    for (int64_t i = 0; !found && i < special_chars_.cnt_; ++i) {
+      found = special_chars_.chars_[i] == ch;
+    }
+    if (!found && special_chars_.cnt_ < MAX_SPECIAL_CHAR_CNT) {
+      special_chars_.chars_[special_chars_.cnt_++] = ch;
+      special_chars_.is_special_[static_cast<uint8_t>(ch)] = true;
+    }
+  }
+}
+
+void ObCSVStructuralIndex::init(const int64_t field_escaped_char,
+                                const int64_t field_enclosed_char,
+                                const char field_term_c,
+                                const char line_term_c,
+                                const bool mark_non_ascii)
+{
+  special_chars_ = SpecialChars();
+  add_special_char(field_escaped_char);
+  add_special_char(field_enclosed_char);
+  add_special_char(field_term_c);
+  add_special_char(line_term_c);
+  // the trailing bytes of a multi-byte char may be equal to a special char, and mbcharlen may
+  // step over a special char for invalid data, so non-ascii bytes are handled char by char
+  special_chars_.mark_non_ascii_ = mark_non_ascii;
+  if (mark_non_ascii) {
+    for (int64_t i = 0x80; i <= UINT8_MAX; ++i) {
+      special_chars_.is_special_[i] = true;
+    }
+  }
+  build_mask_func_ = build_special_char_mask_func;
+  reuse();
+}
+
 int ObCSVGeneralFormat::init_format(const ObDataInFileStruct &format,
                                     int64_t file_column_nums,
                                     ObCollationType file_cs_type)
@@ -105,6 +195,13 @@ int ObCSVGeneralParser::init_opt_variables()
         && !opt_param_.is_same_escape_enclosed_
         && format_.field_enclosed_char_ == INT64_MAX;
 
+    const bool is_multi_byte_cs = (common::CHARSET_UTF8MB4 == format_.cs_type_
+                                   || common::CHARSET_GBK == format_.cs_type_
+                                   || common::CHARSET_GB18030 == format_.cs_type_
+                                   || common::CHARSET_GB18030_2022 == format_.cs_type_);
+    structural_index_.init(format_.field_escaped_char_, format_.field_enclosed_char_,
+                           opt_param_.field_term_c_, opt_param_.line_term_c_, is_multi_byte_cs);
+    opt_param_.use_structural_index_ = true;
   }
 
   if (OB_SUCC(ret) && OB_FAIL(fields_per_line_.prepare_allocate(format_.file_column_nums_))) {
@@ -346,6 +443,8 @@ int64_t ObExternalFileFormat::to_string(char *buf, const int64_t buf_len) const
       pos += csv_format_.to_json_kv_string(buf + pos, buf_len - pos);
       pos += origin_file_format_str_.to_json_kv_string(buf + pos, buf_len - pos);
       break;
+    case PARQUET_FORMAT:
+      break;
     default:
       pos = 0;
   }
@@ -389,6 +488,10 @@ int ObExternalFileFormat::load_from_string(const ObString &str, ObIAllocator &al
           OZ (csv_format_.load_from_json_data(format_type_node, allocator));
           OZ (origin_file_format_str_.load_from_json_data(format_type_node, allocator));
           break;
+        case PARQUET_FORMAT:
+          // values of parquet files are read as utf8 text
+          csv_format_.cs_type_ = CHARSET_UTF8MB4;
+          break;
         default:
           ret = OB_ERR_UNEXPECTED;
           LOG_WARN("invalid format type", K(ret), K(format_type_str));
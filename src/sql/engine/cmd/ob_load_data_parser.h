@@ -77,6 +77,82 @@ struct ObCSVGeneralFormat {
   OB_UNIS_VERSION(1);
 };
 
+/**
+ * @brief Structural index of csv data
+ *  Stage one of the csv parser: the positions of the bytes which may change the parsing state
+ *  (the first byte of separators, enclosed char, escaped char and the non-ascii bytes of multi-byte
+ *  charsets) are collected into a bitmap for each 64 bytes block, with AVX2 if supported.
+ *  The parser (stage two) jumps over the plain bytes between them, and only handles the marked
+ *  bytes by the original char by char logic, so the result is exactly the same.
+ */
+class ObCSVStructuralIndex
+{
+public:
+  static const int64_t BLOCK_SIZE = 64;
+  static const int64_t MAX_SPECIAL_CHAR_CNT = 4;
+  struct SpecialChars
+  {
+    SpecialChars() : cnt_(0), mark_non_ascii_(false)
+    {
+      MEMSET(chars_, 0, sizeof(chars_));
+      MEMSET(is_special_, 0, sizeof(is_special_));
+    }
+    TO_STRING_KV(K_(cnt), K_(mark_non_ascii));
+    char chars_[MAX_SPECIAL_CHAR_CNT];
+    int64_t cnt_;
+    bool mark_non_ascii_;
+    bool is_special_[256];
+  };
+  // bit i of the result is set if block[i] is special
+  typedef uint64_t (*BuildMaskFunc)(const char *block, const SpecialChars &special_chars);
+
+  ObCSVStructuralIndex()
+    : special_chars_(), build_mask_func_(nullptr), block_begin_(nullptr), block_mask_(0)
+  {}
+  void init(const int64_t field_escaped_char, const int64_t field_enclosed_char,
+            const char field_term_c, const char line_term_c, const bool mark_non_ascii);
+  // the cached block is invalid after the content of buffer changed
+  void reuse() { block_begin_ = nullptr; block_mask_ = 0; }
+  // return the first special char in [pos, end), or end if not found
+  inline const char *next_special_char(const char *pos, const char *end);
+  TO_STRING_KV(K_(special_chars), KP_(build_mask_func));
+private:
+  void add_special_char(const int64_t c);
+private:
+  SpecialChars special_chars_;
+  BuildMaskFunc build_mask_func_;
+  const char *block_begin_;
+  uint64_t block_mask_;
+};
+
+inline const char *ObCSVStructuralIndex::next_special_char(const char *pos, const char *end)
+{
+  const char *res = nullptr;
+  while (nullptr == res && pos < end) {
+    if (nullptr == block_begin_ || pos < block_begin_ || pos >= block_begin_ + BLOCK_SIZE) {
+      if (end - pos >= BLOCK_SIZE) {
+        block_begin_ = pos;
+        block_mask_ = build_mask_func_(pos, special_chars_);
+      } else {
+        // tail shorter than a block
+        while (pos < end && !special_chars_.is_special_[static_cast<uint8_t>(*pos)]) {
+          pos++;
+        }
+        res = pos;
+      }
+    }
+    if (nullptr == res) {
+      const uint64_t mask = block_mask_ >> (pos - block_begin_);
+      if (0 != mask) {
+        res = pos + __builtin_ctzll(mask);
+      } else {
+        pos = block_begin_ + BLOCK_SIZE;
+      }
+    }
+  }
+  return nullptr == res ? pos : res;
+}
+
 /**
  * @brief Fast csv general parser is mysql compatible csv parser
  *        It support single-byte or multi-byte separators
@@ -110,7 +186,8 @@ public:
       is_filling_zero_to_empty_field_(false),
       is_line_term_by_counting_field_(false),
       is_same_escape_enclosed_(false),
-      is_simple_format_(false)
+      is_simple_format_(false),
+      use_structural_index_(false)
     {}
     char line_term_c_;
     char field_term_c_;
@@ -118,6 +195,7 @@ public:
     bool is_line_term_by_counting_field_;
     bool is_same_escape_enclosed_;
     bool is_simple_format_;
+    bool use_structural_index_;
   };
 public:
   ObCSVGeneralParser() {}
@@ -247,6 +325,7 @@ protected:
   ObCSVGeneralFormat format_;
   common::ObSEArray<FieldValue, 1> fields_per_line_;
   OptParams opt_param_;
+  ObCSVStructuralIndex structural_index_;
 };
 
 
@@ -314,6 +393,9 @@ int ObCSVGeneralParser::scan_proto(const char *&str,
       ret = common::OB_BUF_NOT_ENOUGH;
     }
   }
+  if (opt_param_.use_structural_index_) {
+    structural_index_.reuse();
+  }
 
   while (OB_SUCC(ret) && str < end && line_no - blank_line_cnt < nrows) {
     bool find_new_line = false;
@@ -390,6 +472,10 @@ int ObCSVGeneralParser::scan_proto(const char *&str,
           if (!is_term) {
             int mb_len = mbcharlen<cs_type>(str, end);
             str += mb_len;
+            if (opt_param_.use_structural_index_ && str < end) {
+              // plain chars never end or escape a field
+              str = structural_index_.next_special_char(str, end);
+            }
           }
         }
       }
@@ -495,6 +581,7 @@ struct ObExternalFileFormat
   enum FormatType {
     INVALID_FORMAT = -1,
     CSV_FORMAT,
+    PARQUET_FORMAT,
     MAX_FORMAT
   };
 
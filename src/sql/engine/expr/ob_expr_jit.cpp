@@ -0,0 +1,749 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/expr/ob_expr_jit.h"
+#include "lib/wide_integer/ob_wide_integer.h"
+#include "sql/engine/ob_operator.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace jit;
+namespace sql
+{
+
+static_assert(12 == sizeof(ObDatum), "unexpected ObDatum size");
+static_assert(8 == sizeof(ObDatumPtr), "unexpected ObDatumPtr size");
+
+ObExprJitFilter::ObExprJitFilter(const uint64_t tenant_id)
+  : allocator_("SqlExprJit", OB_MALLOC_NORMAL_BLOCK_SIZE, tenant_id),
+    helper_(NULL),
+    func_(NULL),
+    leaves_(),
+    inner_exprs_()
+{
+}
+
+ObExprJitFilter::~ObExprJitFilter()
+{
+  if (NULL != helper_) {
+    helper_->~ObLLVMHelper();
+    helper_ = NULL;
+  }
+  func_ = NULL;
+  leaves_.reset();
+  inner_exprs_.reset();
+  allocator_.reset();
+}
+
+int ObExprJitFilter::filter_batch(ObEvalCtx &eval_ctx, ObBitVector &skip, const int64_t bsize,
+                                  bool &all_filtered, bool &jitted) const
+{
+  int ret = OB_SUCCESS;
+  all_filtered = false;
+  jitted = false;
+  bool applicable = true;
+  const ObDatum *leaf_datums[ObExprJitCompiler::MAX_LEAF_CNT];
+  if (OB_ISNULL(func_) || OB_UNLIKELY(leaves_.count() > ObExprJitCompiler::MAX_LEAF_CNT)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid jit filter", K(ret), K(*this));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && applicable && i < inner_exprs_.count(); i++) {
+    const ObEvalInfo &info = inner_exprs_.at(i)->get_eval_info(eval_ctx);
+    applicable = !info.projected_ && !info.evaluated_;
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && applicable && i < leaves_.count(); i++) {
+    ObExpr *e = leaves_.at(i);
+    if (OB_FAIL(e->eval_batch(eval_ctx, skip, bsize))) {
+      LOG_WARN("evaluate batch failed", K(ret), K(i));
+    } else {
+      leaf_datums[i] = e->is_batch_result()
+          ? e->locate_batch_datums(eval_ctx)
+          : &e->locate_expr_datum(eval_ctx);
+    }
+  }
+  if (OB_SUCC(ret) && applicable) {
+    // work on a copy of skip, the interpreted evaluation needs the original one if fall back.
+    char bit_vec_mem[ObBitVector::memory_size(bsize)];
+    ObBitVector *res_vec = to_bit_vector(bit_vec_mem);
+    res_vec->deep_copy(skip, bsize);
+    const int64_t output_rows = func_(bsize,
+                                      reinterpret_cast<int64_t>(res_vec->reinterpret_data<uint64_t>()),
+                                      reinterpret_cast<int64_t>(leaf_datums));
+    if (output_rows >= 0) {
+      skip.deep_copy(*res_vec, bsize);
+      all_filtered = (0 == output_rows);
+      jitted = true;
+    }
+  }
+  return ret;
+}
+
+ObExprJitCompiler::ValueClass ObExprJitCompiler::get_value_class(const ObExpr &expr,
+                                                                 int64_t &width)
+{
+  ValueClass cls = INVALID_CLASS;
+  const ObObjType type = expr.datum_meta_.type_;
+  width = 0;
+  if (ob_is_int_tc(type)) {
+    // all signed integers are stored as int64 in datum.
+    cls = INT_CLASS;
+    width = sizeof(int64_t);
+  } else if (ob_is_decimal_int(type)) {
+    width = wide::ObDecimalIntConstValue::get_int_bytes_by_precision(expr.datum_meta_.precision_);
+    if (sizeof(int32_t) == width || sizeof(int64_t) == width) {
+      cls = DECIMAL_INT_CLASS;
+    }
+  } else if (ObDateType == type) {
+    cls = DATE_CLASS;
+    width = sizeof(int32_t);
+  } else if (ObDateTimeType == type || ObTimestampType == type) {
+    cls = DATETIME_CLASS;
+    width = sizeof(int64_t);
+  }
+  return cls;
+}
+
+// Leaves are read from datums evaluated by interpreter. Exprs without evaluate function are
+// projected by others (column, exec param ...), and child output exprs are evaluated by
+// child already, their arguments may be not valid in this operator.
+bool ObExprJitCompiler::is_leaf(const ObExpr &expr, const ObIArray<ObExpr *> &evaluated)
+{
+  return IS_CONST_TYPE(expr.type_)
+      || NULL == expr.eval_func_
+      || has_exist_in_array(evaluated, const_cast<ObExpr *>(&expr));
+}
+
+bool ObExprJitCompiler::is_same_class(const ObExpr &l, const ObExpr &r)
+{
+  int64_t l_width = 0;
+  int64_t r_width = 0;
+  const ValueClass l_cls = get_value_class(l, l_width);
+  const ValueClass r_cls = get_value_class(r, r_width);
+  bool same = INVALID_CLASS != l_cls && l_cls == r_cls;
+  if (same && DECIMAL_INT_CLASS == l_cls) {
+    same = l.datum_meta_.scale_ == r.datum_meta_.scale_;
+  } else if (same && DATETIME_CLASS == l_cls) {
+    same = l.datum_meta_.type_ == r.datum_meta_.type_;
+  }
+  return same;
+}
+
+bool ObExprJitCompiler::check_value(const ObExpr &expr, const ObIArray<ObExpr *> &evaluated,
+                                    int64_t &expr_cnt)
+{
+  bool valid = ++expr_cnt <= MAX_EXPR_CNT;
+  int64_t width = 0;
+  const ValueClass cls = get_value_class(expr, width);
+  if (!valid || INVALID_CLASS == cls) {
+    valid = false;
+  } else if (is_leaf(expr, evaluated)) {
+    // do nothing
+  } else if (T_OP_ADD != expr.type_ && T_OP_MINUS != expr.type_ && T_OP_MUL != expr.type_) {
+    valid = false;
+  } else if (2 != expr.arg_cnt_ || (INT_CLASS != cls && DECIMAL_INT_CLASS != cls)) {
+    valid = false;
+  } else {
+    const ObExpr &l = *expr.args_[0];
+    const ObExpr &r = *expr.args_[1];
+    int64_t l_width = 0;
+    int64_t r_width = 0;
+    valid = cls == get_value_class(l, l_width) && cls == get_value_class(r, r_width);
+    if (valid && DECIMAL_INT_CLASS == cls) {
+      // values are calculated without scale adjustment.
+      if (T_OP_MUL == expr.type_) {
+        valid = expr.datum_meta_.scale_ == l.datum_meta_.scale_ + r.datum_meta_.scale_;
+      } else {
+        valid = expr.datum_meta_.scale_ == l.datum_meta_.scale_
+            && expr.datum_meta_.scale_ == r.datum_meta_.scale_;
+      }
+    }
+    valid = valid && check_value(l, evaluated, expr_cnt) && check_value(r, evaluated, expr_cnt);
+  }
+  return valid;
+}
+
+bool ObExprJitCompiler::check_bool(const ObExpr &expr, const ObIArray<ObExpr *> &evaluated,
+                                   int64_t &expr_cnt)
+{
+  bool valid = ++expr_cnt <= MAX_EXPR_CNT && ob_is_int_tc(expr.datum_meta_.type_);
+  if (!valid) {
+  } else if (has_exist_in_array(evaluated, const_cast<ObExpr *>(&expr))) {
+    // evaluated by child, arguments may be not valid.
+    valid = false;
+  } else if (T_OP_AND == expr.type_ || T_OP_OR == expr.type_) {
+    for (int64_t i = 0; valid && i < expr.arg_cnt_; i++) {
+      valid = check_bool(*expr.args_[i], evaluated, expr_cnt);
+    }
+  } else if (T_OP_EQ == expr.type_ || T_OP_NE == expr.type_
+             || T_OP_LT == expr.type_ || T_OP_LE == expr.type_
+             || T_OP_GT == expr.type_ || T_OP_GE == expr.type_) {
+    valid = 2 == expr.arg_cnt_
+        && is_same_class(*expr.args_[0], *expr.args_[1])
+        && check_value(*expr.args_[0], evaluated, expr_cnt)
+        && check_value(*expr.args_[1], evaluated, expr_cnt);
+  } else {
+    valid = false;
+  }
+  return valid;
+}
+
+bool ObExprJitCompiler::is_jittable(const ObIArray<ObExpr *> &filters,
+                                    const ObIArray<ObExpr *> &evaluated)
+{
+  bool jittable = !filters.empty();
+  int64_t expr_cnt = 0;
+  for (int64_t i = 0; jittable && i < filters.count(); i++) {
+    jittable = NULL != filters.at(i) && check_bool(*filters.at(i), evaluated, expr_cnt);
+  }
+  return jittable;
+}
+
+int ObExprJitCompiler::new_block(ObLLVMBasicBlock &block)
+{
+  return helper_.create_block(ObString("block"), func_, block);
+}
+
+int ObExprJitCompiler::get_leaf_idx(const ObExpr &expr, int64_t &idx)
+{
+  int ret = OB_SUCCESS;
+  idx = -1;
+  for (int64_t i = 0; i < leaves_.count() && idx < 0; i++) {
+    if (leaves_.at(i) == &expr) {
+      idx = i;
+    }
+  }
+  if (idx >= 0) {
+  } else if (leaves_.count() >= MAX_LEAF_CNT) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_TRACE("too many leaf exprs for jit", K(ret), K(leaves_.count()));
+  } else if (OB_FAIL(leaves_.push_back(const_cast<ObExpr *>(&expr)))) {
+    LOG_WARN("push back failed", K(ret));
+  } else {
+    idx = leaves_.count() - 1;
+  }
+  return ret;
+}
+
+int ObExprJitCompiler::add_inner_expr(const ObExpr &expr)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(add_var_to_array_no_dup(inner_exprs_, const_cast<ObExpr *>(&expr)))) {
+    LOG_WARN("add var to array failed", K(ret));
+  }
+  return ret;
+}
+
+// load integer of %width bytes from address %addr and extend to int64.
+int ObExprJitCompiler::gen_load(ObLLVMValue &addr, const int64_t width, ObLLVMValue &value)
+{
+  int ret = OB_SUCCESS;
+  ObLLVMType type;
+  ObLLVMType ptr_type;
+  ObLLVMValue ptr;
+  ObLLVMValue v;
+  if (OB_FAIL(helper_.get_llvm_type(sizeof(int32_t) == width ? ObInt32Type : ObIntType, type))) {
+    LOG_WARN("get llvm type failed", K(ret));
+  } else if (OB_FAIL(type.get_pointer_to(ptr_type))) {
+    LOG_WARN("get pointer type failed", K(ret));
+  } else if (OB_FAIL(helper_.create_int_to_ptr(ObString("ptr"), addr, ptr_type, ptr))) {
+    LOG_WARN("create int to ptr failed", K(ret));
+  } else if (OB_FAIL(helper_.create_load(ObString("val"), ptr, v))) {
+    LOG_WARN("create load failed", K(ret));
+  } else if (sizeof(int64_t) == width) {
+    value = v;
+  } else if (OB_FAIL(helper_.create_sext(ObString("sext"), v, i64_type_, value))) {
+    LOG_WARN("create sext failed", K(ret));
+  }
+  return ret;
+}
+
+int ObExprJitCompiler::gen_leaf(const ObExpr &expr, ObLLVMBasicBlock &null_bb, ObLLVMValue &value)
+{
+  int ret = OB_SUCCESS;
+  int64_t idx = 0;
+  int64_t width = 0;
+  get_value_class(expr, width);
+  int64_t leaf_off = 0;
+  int64_t datum_size = sizeof(ObDatum);
+  int64_t desc_off = sizeof(ObDatumPtr);
+  ObLLVMValue leaf_addr;
+  ObLLVMValue datums;
+  ObLLVMValue row_off;
+  ObLLVMValue datum_addr;
+  ObLLVMValue desc_addr;
+  ObLLVMValue pack;
+  ObLLVMValue is_null;
+  ObLLVMValue data_ptr;
+  ObLLVMBasicBlock not_null_bb;
+  if (OB_FAIL(get_leaf_idx(expr, idx))) {
+    LOG_WARN("get leaf idx failed", K(ret));
+  } else if (FALSE_IT(leaf_off = idx * static_cast<int64_t>(sizeof(ObDatum *)))) {
+  } else if (OB_FAIL(helper_.create_add(leaves_addr_, leaf_off, leaf_addr))) {
+    LOG_WARN("create add failed", K(ret));
+  } else if (OB_FAIL(gen_load(leaf_addr, sizeof(int64_t), datums))) {
+    LOG_WARN("load leaf datums failed", K(ret));
+  } else if (!expr.is_batch_result()) {
+    datum_addr = datums;
+  } else if (OB_FAIL(helper_.create_mul(loop_idx_, datum_size, row_off))) {
+    LOG_WARN("create mul failed", K(ret));
+  } else if (OB_FAIL(helper_.create_add(datums, row_off, datum_addr))) {
+    LOG_WARN("create add failed", K(ret));
+  }
+  // null_ is the highest bit of ObDatumDesc::pack_, i.e.: pack_ < 0 if null.
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(helper_.create_add(datum_addr, desc_off, desc_addr))) {
+    LOG_WARN("create add failed", K(ret));
+  } else if (OB_FAIL(gen_load(desc_addr, sizeof(int32_t), pack))) {
+    LOG_WARN("load datum desc failed", K(ret));
+  } else if (OB_FAIL(helper_.create_icmp(pack, 0, ObLLVMHelper::ICMP_SLT, is_null))) {
+    LOG_WARN("create icmp failed", K(ret));
+  } else if (OB_FAIL(new_block(not_null_bb))) {
+    LOG_WARN("create block failed", K(ret));
+  } else if (OB_FAIL(helper_.create_cond_br(is_null, null_bb, not_null_bb))) {
+    LOG_WARN("create cond br failed", K(ret));
+  } else if (OB_FAIL(helper_.set_insert_point(not_null_bb))) {
+    LOG_WARN("set insert point failed", K(ret));
+  } else if (OB_FAIL(gen_load(datum_addr, sizeof(int64_t), data_ptr))) {
+    LOG_WARN("load datum ptr failed", K(ret));
+  } else if (OB_FAIL(gen_load(data_ptr, width, value))) {
+    LOG_WARN("load datum value failed", K(ret));
+  }
+  return ret;
+}
+
+int ObExprJitCompiler::gen_value(const ObExpr &expr, ObLLVMBasicBlock &null_bb, ObLLVMValue &value)
+{
+  int ret = OB_SUCCESS;
+  if (is_leaf(expr, evaluated_)) {
+    if (OB_FAIL(gen_leaf(expr, null_bb, value))) {
+      LOG_WARN("generate leaf failed", K(ret));
+    }
+  } else {
+    ObLLVMValue l;
+    ObLLVMValue r;
+    ObLLVMValue overflow;
+    ObLLVMBasicBlock not_overflow_bb;
+    const ObLLVMHelper::OVERFLOWTYPE type = T_OP_ADD == expr.type_
+        ? ObLLVMHelper::SADD_WITH_OVERFLOW
+        : (T_OP_MINUS == expr.type_
+           ? ObLLVMHelper::SSUB_WITH_OVERFLOW : ObLLVMHelper::SMUL_WITH_OVERFLOW);
+    if (OB_FAIL(add_inner_expr(expr))) {
+      LOG_WARN("add inner expr failed", K(ret));
+    } else if (OB_FAIL(gen_value(*expr.args_[0], null_bb, l))) {
+      LOG_WARN("generate left value failed", K(ret));
+    } else if (OB_FAIL(gen_value(*expr.args_[1], null_bb, r))) {
+      LOG_WARN("generate right value failed", K(ret));
+    } else if (OB_FAIL(helper_.create_arith_with_overflow(type, l, r, value, overflow))) {
+      LOG_WARN("create arith failed", K(ret));
+    } else if (OB_FAIL(new_block(not_overflow_bb))) {
+      LOG_WARN("create block failed", K(ret));
+    } else if (OB_FAIL(helper_.create_cond_br(overflow, fallback_, not_overflow_bb))) {
+      LOG_WARN("create cond br failed", K(ret));
+    } else if (OB_FAIL(helper_.set_insert_point(not_overflow_bb))) {
+      LOG_WARN("set insert point failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObExprJitCompiler::gen_bool(const ObExpr &expr, ObLLVMBasicBlock &true_bb,
+                                ObLLVMBasicBlock &false_bb)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(add_inner_expr(expr))) {
+    LOG_WARN("add inner expr failed", K(ret));
+  } else if (T_OP_AND == expr.type_ || T_OP_OR == expr.type_) {
+    const bool is_and = T_OP_AND == expr.type_;
+    for (int64_t i = 0; OB_SUCC(ret) && i < expr.arg_cnt_; i++) {
+      ObLLVMBasicBlock next_bb;
+      if (i == expr.arg_cnt_ - 1) {
+        if (OB_FAIL(gen_bool(*expr.args_[i], true_bb, false_bb))) {
+          LOG_WARN("generate bool failed", K(ret));
+        }
+      } else if (OB_FAIL(new_block(next_bb))) {
+        LOG_WARN("create block failed", K(ret));
+      } else if (OB_FAIL(gen_bool(*expr.args_[i],
+                                  is_and ? next_bb : true_bb,
+                                  is_and ? false_bb : next_bb))) {
+        LOG_WARN("generate bool failed", K(ret));
+      } else if (OB_FAIL(helper_.set_insert_point(next_bb))) {
+        LOG_WARN("set insert point failed", K(ret));
+      }
+    }
+  } else {
+    ObLLVMValue l;
+    ObLLVMValue r;
+    ObLLVMValue cmp;
+    ObLLVMHelper::CMPTYPE cmp_type = ObLLVMHelper::ICMP_EQ;
+    switch (expr.type_) {
+      case T_OP_EQ: cmp_type = ObLLVMHelper::ICMP_EQ; break;
+      case T_OP_NE: cmp_type = ObLLVMHelper::ICMP_NE; break;
+      case T_OP_LT: cmp_type = ObLLVMHelper::ICMP_SLT; break;
+      case T_OP_LE: cmp_type = ObLLVMHelper::ICMP_SLE; break;
+      case T_OP_GT: cmp_type = ObLLVMHelper::ICMP_SGT; break;
+      case T_OP_GE: cmp_type = ObLLVMHelper::ICMP_SGE; break;
+      default: {
+        ret = OB_NOT_SUPPORTED;
+        LOG_WARN("unexpected expr type", K(ret), K(expr.type_));
+      }
+    }
+    // comparison with NULL is not true, go to %false_bb
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(gen_value(*expr.args_[0], false_bb, l))) {
+      LOG_WARN("generate left value failed", K(ret));
+    } else if (OB_FAIL(gen_value(*expr.args_[1], false_bb, r))) {
+      LOG_WARN("generate right value failed", K(ret));
+    } else if (OB_FAIL(helper_.create_icmp(l, r, cmp_type, cmp))) {
+      LOG_WARN("create icmp failed", K(ret));
+    } else if (OB_FAIL(helper_.create_cond_br(cmp, true_bb, false_bb))) {
+      LOG_WARN("create cond br failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+// Generated function:
+//
+//   int64_t func(int64_t size, uint64_t *skip, const ObDatum **leaves)
+//   {
+//     int64_t cnt = 0;
+//     for (int64_t i = 0; i < size; i++) {
+//       if (!(skip[i / 64] & (1 << i % 64))) {
+//         if (filter_1 && filter_2 && ...) {
+//           cnt++;
+//         } else {
+//           skip[i / 64] |= 1 << i % 64;
+//         }
+//       }
+//     }
+//     return cnt;
+//   fallback:
+//     return -1;
+//   }
+int ObExprJitCompiler::generate(const ObString &name, const ObIArray<ObExpr *> &filters)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObLLVMType, 3> arg_types;
+  ObLLVMFunctionType func_type;
+  ObLLVMType i64_ptr_type;
+  ObLLVMValue size;
+  ObLLVMValue skip_addr;
+  ObLLVMValue idx_ptr;
+  ObLLVMValue cnt_ptr;
+  ObLLVMValue zero;
+  ObLLVMValue one;
+  ObLLVMValue minus_one;
+  ObLLVMBasicBlock entry_bb;
+  ObLLVMBasicBlock cond_bb;
+  ObLLVMBasicBlock body_bb;
+  ObLLVMBasicBlock eval_bb;
+  ObLLVMBasicBlock pass_bb;
+  ObLLVMBasicBlock fail_bb;
+  ObLLVMBasicBlock next_bb;
+  ObLLVMBasicBlock exit_bb;
+  if (OB_FAIL(helper_.get_llvm_type(ObIntType, i64_type_))) {
+    LOG_WARN("get llvm type failed", K(ret));
+  } else if (OB_FAIL(i64_type_.get_pointer_to(i64_ptr_type))) {
+    LOG_WARN("get pointer type failed", K(ret));
+  } else if (OB_FAIL(arg_types.push_back(i64_type_))
+             || OB_FAIL(arg_types.push_back(i64_type_))
+             || OB_FAIL(arg_types.push_back(i64_type_))) {
+    LOG_WARN("push back failed", K(ret));
+  } else if (OB_FAIL(ObLLVMFunctionType::get(i64_type_, arg_types, func_type))) {
+    LOG_WARN("get function type failed", K(ret));
+  } else if (OB_FAIL(helper_.create_function(name, func_type, func_))) {
+    LOG_WARN("create function failed", K(ret));
+  } else if (OB_FAIL(func_.get_argument(0, size))
+             || OB_FAIL(func_.get_argument(1, skip_addr))
+             || OB_FAIL(func_.get_argument(2, leaves_addr_))) {
+    LOG_WARN("get argument failed", K(ret));
+  } else if (OB_FAIL(helper_.create_block(ObString("entry"), func_, entry_bb))
+             || OB_FAIL(helper_.create_block(ObString("cond"), func_, cond_bb))
+             || OB_FAIL(helper_.create_block(ObString("body"), func_, body_bb))
+             || OB_FAIL(helper_.create_block(ObString("eval"), func_, eval_bb))
+             || OB_FAIL(helper_.create_block(ObString("fail"), func_, fail_bb))
+             || OB_FAIL(helper_.create_block(ObString("next"), func_, next_bb))
+             || OB_FAIL(helper_.create_block(ObString("exit"), func_, exit_bb))
+             || OB_FAIL(helper_.create_block(ObString("fallback"), func_, fallback_))) {
+    LOG_WARN("create block failed", K(ret));
+  } else if (OB_FAIL(helper_.get_int64(0, zero))
+             || OB_FAIL(helper_.get_int64(1, one))
+             || OB_FAIL(helper_.get_int64(-1, minus_one))) {
+    LOG_WARN("get int64 failed", K(ret));
+  }
+
+  // entry: i = 0, cnt = 0
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(helper_.set_insert_point(entry_bb))) {
+    LOG_WARN("set insert point failed", K(ret));
+  } else if (OB_FAIL(helper_.create_alloca(ObString("idx"), i64_type_, idx_ptr))
+             || OB_FAIL(helper_.create_alloca(ObString("cnt"), i64_type_, cnt_ptr))) {
+    LOG_WARN("create alloca failed", K(ret));
+  } else if (OB_FAIL(helper_.create_store(zero, idx_ptr))
+             || OB_FAIL(helper_.create_store(zero, cnt_ptr))) {
+    LOG_WARN("create store failed", K(ret));
+  } else if (OB_FAIL(helper_.create_br(cond_bb))) {
+    LOG_WARN("create br failed", K(ret));
+  }
+
+  // cond: i < size
+  if (OB_SUCC(ret)) {
+    ObLLVMValue lt_size;
+    if (OB_FAIL(helper_.set_insert_point(cond_bb))) {
+      LOG_WARN("set insert point failed", K(ret));
+    } else if (OB_FAIL(helper_.create_load(ObString("i"), idx_ptr, loop_idx_))) {
+      LOG_WARN("create load failed", K(ret));
+    } else if (OB_FAIL(helper_.create_icmp(loop_idx_, size, ObLLVMHelper::ICMP_SLT, lt_size))) {
+      LOG_WARN("create icmp failed", K(ret));
+    } else if (OB_FAIL(helper_.create_cond_br(lt_size, body_bb, exit_bb))) {
+      LOG_WARN("create cond br failed", K(ret));
+    }
+  }
+
+  // body: check skip bit, word and bit are used by fail block to set skip bit.
+  ObLLVMValue word_ptr;
+  ObLLVMValue word;
+  ObLLVMValue bit;
+  if (OB_SUCC(ret)) {
+    int64_t word_shift = 6; // 64 bits per word
+    int64_t word_bytes = sizeof(uint64_t);
+    int64_t bit_mask = ObBitVector::WORD_BITS - 1;
+    ObLLVMValue word_idx;
+    ObLLVMValue word_off;
+    ObLLVMValue word_addr;
+    ObLLVMValue bit_idx;
+    ObLLVMValue masked;
+    ObLLVMValue skipped;
+    if (OB_FAIL(helper_.set_insert_point(body_bb))) {
+      LOG_WARN("set insert point failed", K(ret));
+    } else if (OB_FAIL(helper_.create_lshr(loop_idx_, word_shift, word_idx))
+               || OB_FAIL(helper_.create_mul(word_idx, word_bytes, word_off))
+               || OB_FAIL(helper_.create_add(skip_addr, word_off, word_addr))
+               || OB_FAIL(helper_.create_int_to_ptr(ObString("word_ptr"), word_addr,
+                                                    i64_ptr_type, word_ptr))
+               || OB_FAIL(helper_.create_load(ObString("word"), word_ptr, word))
+               || OB_FAIL(helper_.create_and(loop_idx_, bit_mask, bit_idx))
+               || OB_FAIL(helper_.create_shl(one, bit_idx, bit))
+               || OB_FAIL(helper_.create_and(word, bit, masked))
+               || OB_FAIL(helper_.create_icmp(masked, 0, ObLLVMHelper::ICMP_NE, skipped))) {
+      LOG_WARN("generate skip check failed", K(ret));
+    } else if (OB_FAIL(helper_.create_cond_br(skipped, next_bb, eval_bb))) {
+      LOG_WARN("create cond br failed", K(ret));
+    }
+  }
+
+  // eval: filter_1 && filter_2 && ...
+  if (OB_SUCC(ret)) {
+    if (OB_FAIL(helper_.set_insert_point(eval_bb))) {
+      LOG_WARN("set insert point failed", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < filters.count(); i++) {
+      pass_bb.reset();
+      if (OB_FAIL(new_block(pass_bb))) {
+        LOG_WARN("create block failed", K(ret));
+      } else if (OB_FAIL(gen_bool(*filters.at(i), pass_bb, fail_bb))) {
+        LOG_WARN("generate filter failed", K(ret), K(i));
+      } else if (OB_FAIL(helper_.set_insert_point(pass_bb))) {
+        LOG_WARN("set insert point failed", K(ret));
+      }
+    }
+    ObLLVMValue cnt;
+    ObLLVMValue new_cnt;
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(helper_.create_load(ObString("cnt"), cnt_ptr, cnt))
+               || OB_FAIL(helper_.create_add(cnt, one, new_cnt))
+               || OB_FAIL(helper_.create_store(new_cnt, cnt_ptr))) {
+      LOG_WARN("generate count failed", K(ret));
+    } else if (OB_FAIL(helper_.create_br(next_bb))) {
+      LOG_WARN("create br failed", K(ret));
+    }
+  }
+
+  // fail: set skip bit
+  if (OB_SUCC(ret)) {
+    ObLLVMValue new_word;
+    if (OB_FAIL(helper_.set_insert_point(fail_bb))) {
+      LOG_WARN("set insert point failed", K(ret));
+    } else if (OB_FAIL(helper_.create_or(word, bit, new_word))
+               || OB_FAIL(helper_.create_store(new_word, word_ptr))) {
+      LOG_WARN("generate set skip failed", K(ret));
+    } else if (OB_FAIL(helper_.create_br(next_bb))) {
+      LOG_WARN("create br failed", K(ret));
+    }
+  }
+
+  // next: i++
+  if (OB_SUCC(ret)) {
+    ObLLVMValue i;
+    ObLLVMValue new_i;
+    if (OB_FAIL(helper_.set_insert_point(next_bb))) {
+      LOG_WARN("set insert point failed", K(ret));
+    } else if (OB_FAIL(helper_.create_load(ObString("i"), idx_ptr, i))
+               || OB_FAIL(helper_.create_add(i, one, new_i))
+               || OB_FAIL(helper_.create_store(new_i, idx_ptr))) {
+      LOG_WARN("generate loop increment failed", K(ret));
+    } else if (OB_FAIL(helper_.create_br(cond_bb))) {
+      LOG_WARN("create br failed", K(ret));
+    }
+  }
+
+  // exit: return cnt, fallback: return -1
+  if (OB_SUCC(ret)) {
+    ObLLVMValue cnt;
+    if (OB_FAIL(helper_.set_insert_point(exit_bb))) {
+      LOG_WARN("set insert point failed", K(ret));
+    } else if (OB_FAIL(helper_.create_load(ObString("cnt"), cnt_ptr, cnt))) {
+      LOG_WARN("create load failed", K(ret));
+    } else if (OB_FAIL(helper_.create_ret(cnt))) {
+      LOG_WARN("create ret failed", K(ret));
+    } else if (OB_FAIL(helper_.set_insert_point(fallback_))) {
+      LOG_WARN("set insert point failed", K(ret));
+    } else if (OB_FAIL(helper_.create_ret(minus_one))) {
+      LOG_WARN("create ret failed", K(ret));
+    } else if (OB_FAIL(helper_.verify_function(func_))) {
+      LOG_WARN("verify function failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+void ObPlanExprJitCache::destroy()
+{
+  ObSpinLockGuard guard(lock_);
+  FOREACH_CNT(item, items_) {
+    if (NULL != item->filter_) {
+      item->filter_->~ObExprJitFilter();
+      ob_free(item->filter_);
+      item->filter_ = NULL;
+    }
+  }
+  items_.reset();
+}
+
+int ObPlanExprJitCache::get_filter(const uint64_t tenant_id, const ObOpSpec &spec,
+                                   const ObExprJitFilter *&filter)
+{
+  int ret = OB_SUCCESS;
+  bool found = false;
+  filter = NULL;
+  {
+    ObSpinLockGuard guard(lock_);
+    for (int64_t i = 0; !found && i < items_.count(); i++) {
+      if (items_.at(i).op_id_ == spec.get_id()) {
+        found = true;
+        filter = items_.at(i).filter_;
+      }
+    }
+  }
+  if (!found && ATOMIC_BCAS(&compiling_, false, true)) {
+    ObExprJitFilter *new_filter = NULL;
+    ObSEArray<ObExpr *, 16> evaluated;
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = get_evaluated_exprs(spec, evaluated))) {
+      LOG_WARN("get evaluated exprs failed", K(tmp_ret), K(spec.get_id()));
+    } else if (!ObExprJitCompiler::is_jittable(spec.filters_, evaluated)) {
+      LOG_TRACE("filters are not jittable", K(spec.get_id()));
+    } else if (OB_SUCCESS != (tmp_ret = compile(tenant_id, spec, evaluated, new_filter))) {
+      // compile failure is not an error, go on with interpreted evaluation.
+      LOG_WARN("compile filters failed", K(tmp_ret), K(spec.get_id()));
+    }
+    {
+      ObSpinLockGuard guard(lock_);
+      if (OB_FAIL(items_.push_back(Item(spec.get_id(), new_filter)))) {
+        LOG_WARN("push back failed", K(ret));
+      } else {
+        filter = new_filter;
+      }
+    }
+    if (OB_FAIL(ret) && NULL != new_filter) {
+      new_filter->~ObExprJitFilter();
+      ob_free(new_filter);
+      new_filter = NULL;
+    }
+    ATOMIC_STORE(&compiling_, false);
+  }
+  return ret;
+}
+
+int ObPlanExprJitCache::get_evaluated_exprs(const ObOpSpec &spec, ObIArray<ObExpr *> &exprs)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < spec.get_child_cnt(); i++) {
+    const ObOpSpec *child = spec.get_child(i);
+    if (OB_ISNULL(child)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("child is NULL", K(ret), K(i));
+    } else if (OB_FAIL(append_array_no_dup(exprs, child->output_))) {
+      LOG_WARN("append array failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+int ObPlanExprJitCache::compile(const uint64_t tenant_id, const ObOpSpec &spec,
+                                const ObIArray<ObExpr *> &evaluated,
+                                ObExprJitFilter *&filter)
+{
+  int ret = OB_SUCCESS;
+  const int64_t begin_ts = ObTimeUtility::current_time();
+  char name_buf[64];
+  int64_t pos = 0;
+  void *buf = NULL;
+  filter = NULL;
+  if (OB_FAIL(databuff_printf(name_buf, sizeof(name_buf), pos, "sql_jit_filter_%lu",
+                              spec.get_id()))) {
+    LOG_WARN("print function name failed", K(ret));
+  } else if (OB_ISNULL(buf = ob_malloc(sizeof(ObExprJitFilter),
+                                       ObMemAttr(tenant_id, "SqlExprJit")))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret));
+  } else {
+    filter = new (buf) ObExprJitFilter(tenant_id);
+    const ObString name(pos, name_buf);
+    if (OB_ISNULL(filter->helper_ = OB_NEWx(ObLLVMHelper, (&filter->allocator_),
+                                            filter->allocator_))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate llvm helper failed", K(ret));
+    } else if (OB_FAIL(filter->helper_->init())) {
+      LOG_WARN("init llvm helper failed", K(ret));
+    } else {
+      ObExprJitCompiler compiler(*filter->helper_, evaluated, filter->leaves_,
+                                 filter->inner_exprs_);
+      if (OB_FAIL(compiler.generate(name, spec.filters_))) {
+        LOG_WARN("generate filters failed", K(ret));
+      } else {
+        filter->helper_->compile_module(true);
+        filter->func_ = reinterpret_cast<ObJitFilterFunc>(
+            filter->helper_->get_function_address(name));
+        if (OB_ISNULL(filter->func_)) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("get function address failed", K(ret), K(name));
+        }
+      }
+    }
+    if (OB_FAIL(ret)) {
+      filter->~ObExprJitFilter();
+      ob_free(filter);
+      filter = NULL;
+    } else {
+      LOG_INFO("compiled filters of hot plan", K(spec.get_id()), K(*filter),
+               "cost", ObTimeUtility::current_time() - begin_ts);
+    }
+  }
+  return ret;
+}
+
+} // end namespace sql
+} // end namespace oceanbase
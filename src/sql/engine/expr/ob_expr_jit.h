@@ -0,0 +1,160 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_EXPR_OB_EXPR_JIT_H_
+#define OCEANBASE_SQL_ENGINE_EXPR_OB_EXPR_JIT_H_
+
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_se_array.h"
+#include "lib/lock/ob_spin_lock.h"
+#include "objit/ob_llvm_helper.h"
+#include "sql/engine/expr/ob_expr.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+class ObOpSpec;
+
+// Compiled filters of one operator: all filters are fused into one batch loop.
+//
+// Arguments are batch size, address of skip bitmap words and address of the leaf datum
+// pointer array. Returns output row count, or -1 if some row can not be calculated by the
+// compiled code (e.g. integer overflow), caller should fall back to interpreted evaluation.
+typedef int64_t (*ObJitFilterFunc)(int64_t size, int64_t skip_addr, int64_t leaves_addr);
+
+class ObExprJitFilter
+{
+public:
+  explicit ObExprJitFilter(const uint64_t tenant_id);
+  ~ObExprJitFilter();
+
+  // Filter rows of batch, the same semantic as ObOperator::filter_batch_rows().
+  // %jitted is false if compiled code is not applicable for this batch, %skip is untouched.
+  int filter_batch(ObEvalCtx &eval_ctx, ObBitVector &skip, const int64_t bsize,
+                   bool &all_filtered, bool &jitted) const;
+
+  TO_STRING_KV(KP_(func), K_(leaves), K_(inner_exprs));
+public:
+  common::ObArenaAllocator allocator_;
+  jit::ObLLVMHelper *helper_;
+  ObJitFilterFunc func_;
+  // exprs evaluated by interpreter before calling the compiled code: constants, exprs
+  // without evaluate function (projected column, exec param ...) and child output exprs.
+  common::ObSEArray<ObExpr *, 8> leaves_;
+  // exprs calculated inside the compiled code from their arguments. If one of them is
+  // projected or evaluated already, its arguments may be not valid (e.g.: only the expr
+  // itself is stored by material child), fall back to interpreted evaluation.
+  common::ObSEArray<ObExpr *, 8> inner_exprs_;
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObExprJitFilter);
+};
+
+// Generate LLVM IR for filters composed of AND, OR, comparison, +, -, * over fixed
+// width values (signed integer, decimal int in 64 bits, date and datetime).
+//
+// NULL is treated as false inside the compiled code, it is the same as the interpreted
+// result for filter since no NOT is supported.
+class ObExprJitCompiler
+{
+public:
+  static const int64_t MAX_LEAF_CNT = 64;
+  static const int64_t MAX_EXPR_CNT = 256;
+
+  ObExprJitCompiler(jit::ObLLVMHelper &helper,
+                    const common::ObIArray<ObExpr *> &evaluated,
+                    common::ObIArray<ObExpr *> &leaves,
+                    common::ObIArray<ObExpr *> &inner_exprs)
+    : helper_(helper), evaluated_(evaluated), leaves_(leaves), inner_exprs_(inner_exprs),
+      i64_type_(), func_(), loop_idx_(), leaves_addr_(), fallback_() {}
+  ~ObExprJitCompiler() {}
+
+  // %evaluated are exprs already evaluated before filtering (output of children),
+  // they are leaves even they are computed exprs.
+  static bool is_jittable(const common::ObIArray<ObExpr *> &filters,
+                          const common::ObIArray<ObExpr *> &evaluated);
+  int generate(const common::ObString &name, const common::ObIArray<ObExpr *> &filters);
+private:
+  enum ValueClass
+  {
+    INVALID_CLASS = 0,
+    INT_CLASS,
+    DECIMAL_INT_CLASS,
+    DATE_CLASS,
+    DATETIME_CLASS,
+  };
+  static ValueClass get_value_class(const ObExpr &expr, int64_t &width);
+  static bool is_leaf(const ObExpr &expr, const common::ObIArray<ObExpr *> &evaluated);
+  static bool check_value(const ObExpr &expr, const common::ObIArray<ObExpr *> &evaluated,
+                          int64_t &expr_cnt);
+  static bool check_bool(const ObExpr &expr, const common::ObIArray<ObExpr *> &evaluated,
+                         int64_t &expr_cnt);
+  static bool is_same_class(const ObExpr &l, const ObExpr &r);
+
+  int gen_bool(const ObExpr &expr, jit::ObLLVMBasicBlock &true_bb,
+               jit::ObLLVMBasicBlock &false_bb);
+  int gen_value(const ObExpr &expr, jit::ObLLVMBasicBlock &null_bb, jit::ObLLVMValue &value);
+  int gen_leaf(const ObExpr &expr, jit::ObLLVMBasicBlock &null_bb, jit::ObLLVMValue &value);
+  int get_leaf_idx(const ObExpr &expr, int64_t &idx);
+  int add_inner_expr(const ObExpr &expr);
+  int gen_load(jit::ObLLVMValue &addr, const int64_t width, jit::ObLLVMValue &value);
+  int new_block(jit::ObLLVMBasicBlock &block);
+private:
+  jit::ObLLVMHelper &helper_;
+  const common::ObIArray<ObExpr *> &evaluated_;
+  common::ObIArray<ObExpr *> &leaves_;
+  common::ObIArray<ObExpr *> &inner_exprs_;
+  jit::ObLLVMType i64_type_;
+  jit::ObLLVMFunction func_;
+  // current row index of the batch loop
+  jit::ObLLVMValue loop_idx_;
+  jit::ObLLVMValue leaves_addr_;
+  // return -1 to fall back to interpreted evaluation
+  jit::ObLLVMBasicBlock fallback_;
+  DISALLOW_COPY_AND_ASSIGN(ObExprJitCompiler);
+};
+
+// Compiled filters of a cached plan, live with the plan in plan cache.
+class ObPlanExprJitCache
+{
+public:
+  ObPlanExprJitCache() : lock_(), compiling_(false), items_() {}
+  ~ObPlanExprJitCache() { destroy(); }
+  void destroy();
+  // Get compiled filters of %spec, compile them on first access.
+  // %filter is NULL if filters are not jittable or compilation failed.
+  int get_filter(const uint64_t tenant_id, const ObOpSpec &spec,
+                 const ObExprJitFilter *&filter);
+  // Exprs already evaluated before filters of %spec are evaluated.
+  static int get_evaluated_exprs(const ObOpSpec &spec, common::ObIArray<ObExpr *> &exprs);
+private:
+  int compile(const uint64_t tenant_id, const ObOpSpec &spec,
+              const common::ObIArray<ObExpr *> &evaluated, ObExprJitFilter *&filter);
+private:
+  struct Item
+  {
+    Item() : op_id_(common::OB_INVALID_ID), filter_(NULL) {}
+    Item(uint64_t op_id, ObExprJitFilter *filter) : op_id_(op_id), filter_(filter) {}
+    TO_STRING_KV(K_(op_id), KP_(filter));
+    uint64_t op_id_;
+    ObExprJitFilter *filter_;
+  };
+  common::ObSpinLock lock_;
+  // only one thread compiles at a time, others go on with interpreted evaluation.
+  bool compiling_;
+  common::ObSEArray<Item, 4> items_;
+  DISALLOW_COPY_AND_ASSIGN(ObPlanExprJitCache);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+#endif // OCEANBASE_SQL_ENGINE_EXPR_OB_EXPR_JIT_H_
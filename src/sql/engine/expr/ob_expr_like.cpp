@@ -12,6 +12,9 @@
 
 #define USING_LOG_PREFIX SQL_ENG
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
 #include "sql/engine/expr/ob_expr_like.h"
 //#include "sql/engine/expr/ob_expr_promotion_util.h"
 #include "sql/engine/ob_exec_context.h"
@@ -767,6 +770,67 @@ int ObExprLike::like_varchar(const ObExpr &expr, ObEvalCtx &ctx,  ObDatum &expr_
   return ret;
 }
 
+typedef const char *(*SearchInstrFunc)(const char *text, const int64_t text_len,
+                                       const char *instr, const int64_t instr_len);
+
+const char *ObExprLike::search_instr(const char *text, const int64_t text_len,
+                                     const char *instr, const int64_t instr_len)
+{
+  return static_cast<const char *>(MEMMEM(text, text_len, instr, instr_len));
+}
+
+#if OB_USE_MULTITARGET_CODE
+// Compare the first and the last byte of %instr with 32 candidate positions at once,
+// and only verify the candidates whose first and last byte both matched. Candidate
+// positions are rare for a real keyword, so most text is skipped in 32 bytes step.
+OB_AVX2_FUNCTION_SPECIFIC_ATTRIBUTE
+const char *ObExprLike::search_instr_avx2(const char *text, const int64_t text_len,
+                                          const char *instr, const int64_t instr_len)
+{
+  const char *res = NULL;
+  const int64_t block_size = sizeof(__m256i);
+  if (instr_len <= 1) {
+    res = 0 == instr_len ? text : static_cast<const char *>(MEMCHR(text, instr[0], text_len));
+  } else {
+    const __m256i first = _mm256_set1_epi8(instr[0]);
+    const __m256i last = _mm256_set1_epi8(instr[instr_len - 1]);
+    int64_t pos = 0;
+    for (; NULL == res && pos + instr_len - 1 + block_size <= text_len; pos += block_size) {
+      const __m256i block_first = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(text + pos));
+      const __m256i block_last = _mm256_loadu_si256(
+          reinterpret_cast<const __m256i *>(text + pos + instr_len - 1));
+      uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+          _mm256_and_si256(_mm256_cmpeq_epi8(first, block_first),
+                           _mm256_cmpeq_epi8(last, block_last))));
+      while (0 != mask && NULL == res) {
+        const int64_t offset = pos + __builtin_ctz(mask);
+        if (0 == MEMCMP(text + offset + 1, instr + 1, instr_len - 2)) {
+          res = text + offset;
+        }
+        mask &= mask - 1;
+      }
+    }
+    if (NULL == res && pos < text_len) {
+      res = search_instr(text + pos, text_len - pos, instr, instr_len);
+    }
+  }
+  return res;
+}
+#endif
+
+static SearchInstrFunc get_search_instr_func()
+{
+#if OB_USE_MULTITARGET_CODE
+  return common::is_arch_supported(ObTargetArch::AVX2)
+      ? ObExprLike::search_instr_avx2
+      : ObExprLike::search_instr;
+#else
+  return ObExprLike::search_instr;
+#endif
+}
+
+static SearchInstrFunc search_instr_func = get_search_instr_func();
 
 template <bool percent_sign_start, bool percent_sign_end>
 int64_t ObExprLike::match_with_instr_mode(const ObString &text, const InstrInfo instr_info)
@@ -793,7 +857,7 @@ int64_t ObExprLike::match_with_instr_mode(const ObString &text, const InstrInfo
   }
   // memmem for str surrounded by %
   for (; idx < idx_end && match; idx++) {
-    char *new_text = static_cast<char*>(MEMMEM(text_ptr, text_len, instr_pos[idx], instr_len[idx]));
+    const char *new_text = search_instr_func(text_ptr, text_len, instr_pos[idx], instr_len[idx]);
     text_len -= new_text != NULL ? new_text - text_ptr + instr_len[idx] : 0;
     if (OB_UNLIKELY(text_len < 0)) {
       match = false;
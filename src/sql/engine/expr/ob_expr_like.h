@@ -14,6 +14,7 @@
 #define OCEANBASE_SQL_ENGINE_EXPR_LIKE_
 
 #include "sql/engine/expr/ob_expr_operator.h"
+#include "common/ob_target_specific.h"
 
 namespace oceanbase
 {
@@ -132,6 +133,13 @@ public:
   template <bool percent_sign_start, bool percent_sign_end>
   static int64_t match_with_instr_mode(const common::ObString &text_val,
                                        const InstrInfo instr_info);
+  // search the first occurrence of %instr in %text, return NULL if not found.
+  static const char *search_instr(const char *text, const int64_t text_len,
+                                  const char *instr, const int64_t instr_len);
+#if OB_USE_MULTITARGET_CODE
+  static const char *search_instr_avx2(const char *text, const int64_t text_len,
+                                       const char *instr, const int64_t instr_len);
+#endif
   template <typename T>
   static int calc_with_non_instr_mode(T &result,
                                       const common::ObCollationType coll_type,
@@ -166,6 +166,7 @@ ObHashJoinOp::ObHashJoinOp(ObExecContext &ctx_, const ObOpSpec &spec, ObOpInput
   part_shift_(MAX_PART_LEVEL << 3),
   part_count_(0),
   force_hash_join_spill_(false),
+  enable_radix_partition_(false),
   hash_join_processor_(7),
   tenant_id_(-1),
   input_size_(0),
@@ -420,6 +421,7 @@ int ObHashJoinOp::inner_open()
     ObTenantConfigGuard tenant_config(TENANT_CONF(session->get_effective_tenant_id()));
     if (tenant_config.is_valid()) {
       force_hash_join_spill_ = tenant_config->_force_hash_join_spill;
+      enable_radix_partition_ = tenant_config->_enable_hash_join_radix_partition;
       hash_join_processor_ = tenant_config->_enable_hash_join_processor;
       if (0 == (hash_join_processor_ & HJ_PROCESSOR_MASK)) {
         ret = OB_ERR_UNEXPECTED;
@@ -1740,8 +1742,18 @@ int ObHashJoinOp::build_hash_table_in_memory(int64_t &num_left_rows)
     // do nothing
   } else {
     PartHashJoinTable &hash_table = *cur_hash_table_;
+    // insert rows region by region for the bucket array exceeds L2 cache
+    const int64_t radix_shift = calc_radix_shift(hash_table);
     hj_batch->set_iteration_age(iter_age_);
     iter_age_.inc();
+    if (radix_shift >= 0 && OB_NOT_NULL(hash_table.buckets_)) {
+      if (OB_FAIL(radix_build_hash_table(hash_table, radix_shift, num_left_rows,
+                                         used_buckets, collisions))) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("failed to build hash table by radix partition", K(ret));
+        }
+      }
+    }
     while (OB_SUCC(ret)) {
       int64_t read_size = 0;
       if (OB_FAIL(hj_batch->get_next_batch(left_stored_rows,
@@ -2709,6 +2721,165 @@ void ObHashJoinOp::calc_cache_aware_partition_count()
     K(total_row_count), K(row_count_cache_aware));
 }
 
+int64_t ObHashJoinOp::calc_radix_shift(const PartHashJoinTable &hash_table) const
+{
+  int64_t radix_shift = -1;
+  const int64_t bucket_mem_size = hash_table.nbuckets_ * sizeof(HTBucket);
+  if (enable_radix_partition_ && l2_cache_size_ > 0 && bucket_mem_size > l2_cache_size_) {
+    // nbuckets_ is power of 2
+    const int64_t radix_bits = std::min(static_cast<int64_t>(RADIX_PART_BITS),
+        static_cast<int64_t>(63 - __builtin_clzll(bucket_mem_size / l2_cache_size_)));
+    if (radix_bits > 0) {
+      radix_shift = __builtin_ctzll(hash_table.nbuckets_) - radix_bits;
+    }
+  }
+  return radix_shift;
+}
+
+void ObHashJoinOp::radix_cluster(const RadixRow *rows, const int64_t cnt,
+                                 const uint64_t mask, const int64_t radix_shift,
+                                 RadixRow *clustered_rows)
+{
+  int64_t offsets[RADIX_PART_CNT + 1];
+  MEMSET(offsets, 0, sizeof(offsets));
+  for (int64_t i = 0; i < cnt; i++) {
+    ++offsets[((rows[i].hash_val_ & mask) >> radix_shift) + 1];
+  }
+  for (int64_t i = 1; i <= RADIX_PART_CNT; i++) {
+    offsets[i] += offsets[i - 1];
+  }
+  for (int64_t i = 0; i < cnt; i++) {
+    clustered_rows[offsets[(rows[i].hash_val_ & mask) >> radix_shift]++] = rows[i];
+  }
+}
+
+// Partition all rows of the build side by the high bits of the bucket position, then insert
+// the partitions one by one, so the buckets written by one partition stay in L2 cache.
+// The hash values are copied with the row pointers, so the partitioning reads the stored rows
+// only once. Inserting still writes the next pointer of each stored row (set_next()), the
+// rows of one partition are scattered in the chunk datum store and these writes miss cache.
+// The partitioned rows are kept in memory of mem_context_ and reported to sql_mem_processor_. Return OB_ITER_END if all rows are
+// inserted, or OB_SUCCESS without reading any row if the memory exceeds the memory bound of
+// the operator or can not be allocated, then the caller inserts rows batch by batch.
+int ObHashJoinOp::radix_build_hash_table(PartHashJoinTable &hash_table,
+                                         const int64_t radix_shift,
+                                         int64_t &num_left_rows,
+                                         int64_t &used_buckets,
+                                         int64_t &collisions)
+{
+  int ret = OB_SUCCESS;
+  const int64_t PREFETCH_BATCH_SIZE = 64;
+  const ObHashJoinStoredJoinRow *left_stored_rows[PREFETCH_BATCH_SIZE];
+  const int64_t row_cnt = left_batch_->get_row_count_in_memory();
+  const uint64_t mask = hash_table.nbuckets_ - 1;
+  RadixRow *rows = NULL;
+  RadixRow *clustered_rows = NULL;
+  void *buf = NULL;
+  const int64_t need_size = sizeof(RadixRow) * row_cnt * 2;
+  if (row_cnt <= 0 || 0 != left_batch_->get_row_count_on_disk()) {
+    // do nothing
+  } else if (get_mem_used() + need_size > sql_mem_processor_.get_mem_bound()) {
+    LOG_TRACE("exceed memory bound, insert rows batch by batch", K(row_cnt), K(need_size),
+              K(get_mem_used()), K(sql_mem_processor_.get_mem_bound()));
+  } else if (OB_ISNULL(buf = alloc_->alloc(need_size))) {
+    LOG_TRACE("no memory for radix partition, insert rows batch by batch", K(row_cnt));
+  } else if (OB_FAIL(sql_mem_processor_.update_used_mem_size(get_mem_used()))) {
+    alloc_->free(buf);
+    LOG_WARN("failed to update used mem size", K(ret));
+  } else {
+    rows = static_cast<RadixRow *>(buf);
+    clustered_rows = rows + row_cnt;
+    int64_t read_cnt = 0;
+    while (OB_SUCC(ret) && read_cnt < row_cnt) {
+      int64_t read_size = 0;
+      if (OB_FAIL(left_batch_->get_next_batch(left_stored_rows,
+                                              std::min(PREFETCH_BATCH_SIZE, row_cnt - read_cnt),
+                                              read_size))) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("get next batch failed", K(ret));
+        }
+      } else {
+        for (int64_t i = 0; OB_SUCC(ret) && i < read_size; ++i) {
+          RadixRow &row = rows[read_cnt + i];
+          row.hash_val_ = left_stored_rows[i]->get_hash_value();
+          row.stored_row_ = const_cast<ObHashJoinStoredJoinRow *>(left_stored_rows[i]);
+          if (enable_bloom_filter_ && OB_FAIL(bloom_filter_->set(row.hash_val_))) {
+            LOG_WARN("add hash value to bloom failed", K(ret), K(i));
+          }
+        }
+        if (OB_SUCC(ret)) {
+          read_cnt += read_size;
+        }
+      }
+    }
+    if (OB_ITER_END == ret || (OB_SUCC(ret) && read_cnt == row_cnt)) {
+      radix_cluster(rows, read_cnt, mask, radix_shift, clustered_rows);
+      for (int64_t i = 0; i < std::min(static_cast<int64_t>(RADIX_PREFETCH_DISTANCE), read_cnt); i++) {
+        __builtin_prefetch(&hash_table.buckets_->at(clustered_rows[i].hash_val_ & mask),
+                           1 /* write */, 3 /* high temporal locality*/);
+      }
+      for (int64_t i = 0; i < read_cnt; ++i) {
+        if (i + RADIX_PREFETCH_DISTANCE < read_cnt) {
+          __builtin_prefetch(&hash_table.buckets_->at(
+                                 clustered_rows[i + RADIX_PREFETCH_DISTANCE].hash_val_ & mask),
+                             1 /* write */, 3 /* high temporal locality*/);
+        }
+        if (is_shared_) {
+          hash_table.atomic_set(clustered_rows[i].hash_val_, clustered_rows[i].stored_row_,
+                                used_buckets, collisions);
+        } else {
+          hash_table.set(clustered_rows[i].hash_val_, clustered_rows[i].stored_row_);
+        }
+      }
+      num_left_rows += read_cnt;
+      ret = OB_ITER_END;
+    }
+    alloc_->free(buf);
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = sql_mem_processor_.update_used_mem_size(get_mem_used()))) {
+      LOG_WARN("failed to update used mem size", K(tmp_ret));
+    }
+    LOG_TRACE("build hash table by radix partition", K(ret), K(row_cnt), K(read_cnt),
+              K(radix_shift), K(hash_table.nbuckets_));
+  }
+  return ret;
+}
+
+// Probe the rows of right batch with the bucket prefetched RADIX_PREFETCH_DISTANCE rows ahead
+// of the access, rather than prefetching the whole batch at once which overflows the
+// outstanding cache misses.
+// The probe side is not radix partitioned: a batch has at most max_batch_size rows, spread
+// over up to RADIX_PART_CNT partitions, which leaves a few rows per partition and no reuse
+// of the cached buckets. Partitioning the whole probe side needs it materialized, which is
+// what the cache aware hash join (can_use_cache_aware_opt()) does.
+void ObHashJoinOp::prefetch_probe_batch()
+{
+  PartHashJoinTable &hash_table = *cur_hash_table_;
+  const uint64_t mask = hash_table.nbuckets_ - 1;
+  const int64_t cnt = right_selector_cnt_;
+  for (int64_t i = 0; i < std::min(static_cast<int64_t>(RADIX_PREFETCH_DISTANCE), cnt); i++) {
+    __builtin_prefetch(&hash_table.buckets_->at(mask & right_hash_vals_[right_selector_[i]]),
+                       0, // for read
+                       1); // low temporal locality
+  }
+  int64_t idx = 0;
+  ObHashJoinStoredJoinRow *tuple = NULL;
+  for (int64_t i = 0; i < cnt; i++) {
+    if (i + RADIX_PREFETCH_DISTANCE < cnt) {
+      __builtin_prefetch(&hash_table.buckets_->at(
+                             mask & right_hash_vals_[right_selector_[i + RADIX_PREFETCH_DISTANCE]]),
+                         0, // for read
+                         1); // low temporal locality
+    }
+    tuple = hash_table.get(right_hash_vals_[right_selector_[i]]);
+    if (NULL != tuple) {
+      cur_tuples_[idx] = tuple;
+      right_selector_[idx++] = right_selector_[i];
+    }
+  }
+  right_selector_cnt_ = idx;
+}
+
 // TEST TPCH 1TB, Q09 improve 5s-6s, about 25%~30%
 // When partition count is greater or equan than 128, then enable cache aware hash join
 bool ObHashJoinOp::can_use_cache_aware_opt()
@@ -4772,7 +4943,9 @@ int ObHashJoinOp::read_hashrow_batch()
     }
 
     // probe hash table
-    {
+    if (calc_radix_shift(*cur_hash_table_) >= 0) {
+      prefetch_probe_batch();
+    } else {
       // group prefetch
       for (int64_t i = 0; i < right_selector_cnt_; i++) {
         uint64_t mask = cur_hash_table_->nbuckets_ - 1;
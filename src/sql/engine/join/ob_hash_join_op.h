@@ -336,6 +336,13 @@ private:
   };
 private:
 
+  // build row partitioned by radix_build_hash_table()
+  struct RadixRow
+  {
+    uint64_t hash_val_;
+    ObHashJoinStoredJoinRow *stored_row_;
+  };
+
   struct HTBucket
   {
     // keep trivial constructor make ObSegmentArray use memset to construct arrays.
@@ -1062,6 +1069,17 @@ private:
                       PredFunc pred);
 
   bool can_use_cache_aware_opt();
+  // Return the shift to get the radix partition from the bucket position. The bucket array
+  // is split into at most RADIX_PART_CNT regions and each region is no smaller than L2 cache,
+  // return -1 if the bucket array fits in L2 cache or radix partition is disabled.
+  int64_t calc_radix_shift(const PartHashJoinTable &hash_table) const;
+  // Stable counting sort of the rows by radix partition, output to %clustered_rows.
+  static void radix_cluster(const RadixRow *rows, const int64_t cnt,
+                            const uint64_t mask, const int64_t radix_shift,
+                            RadixRow *clustered_rows);
+  int radix_build_hash_table(PartHashJoinTable &hash_table, const int64_t radix_shift,
+                             int64_t &num_left_rows, int64_t &used_buckets, int64_t &collisions);
+  void prefetch_probe_batch();
   int read_hashrow_normal();
   int read_hashrow_for_cache_aware(NextFunc next_func);
   int init_histograms(HashJoinHistogram *&part_histograms, int64_t part_count);
@@ -1105,6 +1123,10 @@ private:
   static const int64_t DEFAULT_MEM_LIMIT = 100 * 1024 * 1024;
 
   static const int64_t CACHE_AWARE_PART_CNT = 128;
+  // radix partitioned build of large in-memory hash table, see calc_radix_shift()
+  static const int64_t RADIX_PART_BITS = 8;
+  static const int64_t RADIX_PART_CNT = 1L << RADIX_PART_BITS;
+  static const int64_t RADIX_PREFETCH_DISTANCE = 8;
   static const int64_t BATCH_RESULT_SIZE = 512;
   static const int64_t INIT_LTB_SIZE = 64;
   static const int64_t MIN_PART_COUNT = 8;
@@ -1157,6 +1179,7 @@ private:
   int32_t part_shift_;
   int64_t part_count_;
   bool force_hash_join_spill_;
+  bool enable_radix_partition_;
   int8_t hash_join_processor_;
   int64_t tenant_id_;
   int64_t input_size_;
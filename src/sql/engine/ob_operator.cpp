@@ -16,6 +16,7 @@
 #include "ob_operator.h"
 #include "ob_operator_factory.h"
 #include "sql/engine/ob_exec_context.h"
+#include "sql/engine/ob_physical_plan.h"
 #include "common/ob_smart_call.h"
 #include "sql/engine/ob_exec_feedback_info.h"
 #include "observer/ob_server.h"
@@ -532,7 +533,8 @@ ObOperator::ObOperator(ObExecContext &exec_ctx, const ObOpSpec &spec, ObOpInput
     dummy_mem_context_(nullptr),
     dummy_ptr_(nullptr),
     #endif
-    check_stack_overflow_(false)
+    check_stack_overflow_(false),
+    jit_filter_(NULL)
 {
   eval_ctx_.max_batch_size_ = spec.max_batch_size_;
   eval_ctx_.batch_size_ = spec.max_batch_size_;
@@ -760,6 +762,8 @@ int ObOperator::open()
           LOG_WARN("init evaluate flags failed", K(ret));
         } else if (OB_FAIL(init_skip_vector())) {
           LOG_WARN("init skip vector failed", K(ret));
+        } else if (OB_FAIL(init_jit_filter())) {
+          LOG_WARN("init jit filter failed", K(ret));
         }
         #ifdef ENABLE_DEBUG_LOG
         else if (OB_FAIL(init_dummy_mem_context(ctx_.get_my_session()->get_effective_tenant_id()))) {
@@ -849,6 +853,25 @@ int ObOperator::init_skip_vector()
   return ret;
 }
 
+int ObOperator::init_jit_filter()
+{
+  int ret = OB_SUCCESS;
+  ObSQLSessionInfo *session = ctx_.get_my_session();
+  ObPhysicalPlan *plan = spec_.plan_;
+  int64_t threshold = 0;
+  if (NULL != jit_filter_ || !spec_.is_vectorized() || spec_.filters_.empty()
+      || OB_ISNULL(plan) || OB_ISNULL(session)) {
+    // do nothing
+  } else if (FALSE_IT(threshold = session->get_expr_jit_hot_plan_threshold())) {
+  } else if (threshold <= 0 || plan->stat_.execute_times_ < threshold) {
+    // not hot enough
+  } else if (OB_FAIL(plan->expr_jit_cache_.get_filter(session->get_effective_tenant_id(),
+                                                      spec_, jit_filter_))) {
+    LOG_WARN("get jit filter failed", K(ret));
+  }
+  return ret;
+}
+
 // copy from ob_phy_operator.cpp
 int ObOperator::rescan()
 {
@@ -1277,10 +1300,15 @@ int ObOperator::get_next_batch(const int64_t max_row_cnt, const ObBatchRows *&ba
         } else if (OB_FAIL(try_check_status_by_rows(brs_.size_))) {
           LOG_WARN("check status failed", K(ret));
         } else if (!spec_.filters_.empty()) {
-          if (OB_FAIL(filter_batch_rows(spec_.filters_,
-                                        *brs_.skip_,
-                                        brs_.size_,
-                                        all_filtered))) {
+          bool jitted = false;
+          if (NULL != jit_filter_
+              && OB_FAIL(jit_filter_->filter_batch(eval_ctx_, *brs_.skip_, brs_.size_,
+                                                   all_filtered, jitted))) {
+            LOG_WARN("filter batch rows with jit failed", K(ret), K_(eval_ctx));
+          } else if (!jitted && OB_FAIL(filter_batch_rows(spec_.filters_,
+                                                          *brs_.skip_,
+                                                          brs_.size_,
+                                                          all_filtered))) {
             LOG_WARN("filter batch rows failed", K(ret), K_(eval_ctx));
           } else if (all_filtered) {
             brs_.skip_->reset(brs_.size_);
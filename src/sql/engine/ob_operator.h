@@ -41,6 +41,7 @@ class ObOperator;
 class ObOpInput;
 class ObTaskInfo;
 class ObExecFeedbackNode;
+class ObExprJitFilter;
 
 struct ObPhyOpSeriCtx
 {
@@ -506,6 +507,8 @@ public:
   { fb_node_idx_ = idx; }
 protected:
   int init_skip_vector();
+  // Get compiled filters from plan if the plan is hot enough.
+  int init_jit_filter();
   // Execute filter
   // Calc buffer does not reset internally, you need to reset it appropriately.
   int filter(const common::ObIArray<ObExpr *> &exprs, bool &filtered);
@@ -658,6 +661,8 @@ protected:
   char *dummy_ptr_;
   #endif
   bool check_stack_overflow_;
+  // compiled filters, owned by plan
+  const ObExprJitFilter *jit_filter_;
   DISALLOW_COPY_AND_ASSIGN(ObOperator);
 };
 
@@ -227,6 +227,7 @@ void ObPhysicalPlan::reset()
   need_record_plan_info_ = false;
   logical_plan_.reset();
   is_enable_px_fast_reclaim_ = false;
+  expr_jit_cache_.destroy();
 }
 
 void ObPhysicalPlan::destroy()
@@ -238,6 +239,7 @@ void ObPhysicalPlan::destroy()
   expr_op_factory_.destroy();
   stat_.expected_worker_map_.destroy();
   stat_.minimal_worker_map_.destroy();
+  expr_jit_cache_.destroy();
 }
 
 int ObPhysicalPlan::copy_common_info(ObPhysicalPlan &src)
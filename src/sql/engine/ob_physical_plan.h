@@ -21,6 +21,7 @@
 #include "sql/engine/ob_physical_plan_ctx.h"
 #include "sql/engine/expr/ob_expr_operator_factory.h"
 #include "sql/engine/expr/ob_expr_frame_info.h"
+#include "sql/engine/expr/ob_expr_jit.h"
 #include "sql/executor/ob_executor.h"
 #include "sql/optimizer/ob_table_location.h"
 #include "sql/plan_cache/ob_plan_cache_util.h"
@@ -601,6 +602,8 @@ public:
 
   ObPlanStat stat_;
   ObPhyOperatorStats op_stats_;
+  // compiled filters of hot plan, see _sql_expr_jit_hot_plan_threshold
+  ObPlanExprJitCache expr_jit_cache_;
   const int64_t MAX_BINARY_CODE_LEN = 1024 * 256; //256k
   //@todo: yuchen.wyc add a temporary member to mark whether
   //the DML statement needs to be executed through get_next_row
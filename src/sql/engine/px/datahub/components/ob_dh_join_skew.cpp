@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include "sql/engine/px/datahub/components/ob_dh_join_skew.h"
+#include "sql/engine/px/datahub/ob_dh_msg_ctx.h"
+#include "sql/engine/px/ob_dfo.h"
+#include "sql/engine/px/ob_dfo_mgr.h"
+#include "sql/engine/px/ob_px_util.h"
+#include "sql/engine/px/ob_px_scheduler.h"
+#include "sql/engine/px/datahub/ob_dh_msg.h"
+
+using namespace oceanbase::sql;
+using namespace oceanbase::common;
+
+OB_SERIALIZE_MEMBER(ObJoinSkewKeyStat, hash_val_, cnt_);
+OB_SERIALIZE_MEMBER((ObJoinSkewPieceMsg, ObDatahubPieceMsg),
+                    is_build_side_, sample_row_cnt_, key_stats_);
+OB_SERIALIZE_MEMBER((ObJoinSkewWholeMsg, ObDatahubWholeMsg),
+                    sample_row_cnt_, skew_values_hash_);
+
+int ObJoinSkewPieceMsgListener::on_message(
+    ObJoinSkewPieceMsgCtx &ctx,
+    common::ObIArray<ObPxSqcMeta *> &sqcs,
+    const ObJoinSkewPieceMsg &pkt)
+{
+  int ret = OB_SUCCESS;
+  int64_t dfo_task_cnt = 0;
+  if (pkt.op_id_ != ctx.op_id_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected piece msg", K(pkt), K(ctx));
+  } else if (OB_FAIL(ctx.get_dfo_task_cnt(pkt.source_dfo_id_, dfo_task_cnt))) {
+    LOG_WARN("fail get task count of source dfo", K(ret), K(pkt));
+  } else if (pkt.is_build_side_) {
+    // task_cnt_ is initialized by the dfo which sent the first piece, maybe the probe side
+    ctx.task_cnt_ = dfo_task_cnt;
+    if (ctx.build_received_ >= ctx.task_cnt_) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("should not receive any more pkt. already get all pkt expected",
+               K(pkt), K(ctx));
+    } else if (OB_FAIL(append(ctx.key_stats_, pkt.key_stats_))) {
+      LOG_WARN("fail append key stats", K(ret));
+    } else {
+      ctx.whole_msg_.sample_row_cnt_ += pkt.sample_row_cnt_;
+      ctx.build_received_++;
+      LOG_TRACE("got a join skew build side piece msg",
+                "all_got", ctx.build_received_, "expected", ctx.task_cnt_);
+    }
+    if (OB_SUCC(ret) && ctx.build_received_ == ctx.task_cnt_) {
+      if (OB_FAIL(ctx.process_skew_keys())) {
+        LOG_WARN("fail process skew keys", K(ret));
+      } else if (OB_FAIL(ctx.send_whole_msg(sqcs))) {
+        LOG_WARN("fail to send whole msg to build side", K(ret));
+      } else if (!ctx.probe_sqcs_.empty() && OB_FAIL(ctx.send_whole_msg(ctx.probe_sqcs_))) {
+        LOG_WARN("fail to send whole msg to probe side", K(ret));
+      } else if (!ctx.probe_sqcs_.empty()) {
+        IGNORE_RETURN ctx.reset_resource();
+      }
+    }
+  } else {
+    ctx.probe_task_cnt_ = dfo_task_cnt;
+    if (ctx.probe_received_ >= ctx.probe_task_cnt_) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("should not receive any more pkt. already get all pkt expected",
+               K(pkt), K(ctx));
+    } else {
+      ctx.probe_received_++;
+      LOG_TRACE("got a join skew probe side piece msg",
+                "all_got", ctx.probe_received_, "expected", ctx.probe_task_cnt_);
+    }
+    if (OB_SUCC(ret) && ctx.probe_received_ == ctx.probe_task_cnt_) {
+      if (!ctx.whole_msg_ready_) {
+        // build side not finished sampling yet, reply after all build pieces arrived.
+        if (OB_FAIL(ctx.probe_sqcs_.assign(sqcs))) {
+          LOG_WARN("fail to save probe sqcs", K(ret));
+        }
+      } else if (OB_FAIL(ctx.send_whole_msg(sqcs))) {
+        LOG_WARN("fail to send whole msg to probe side", K(ret));
+      } else {
+        IGNORE_RETURN ctx.reset_resource();
+      }
+    }
+  }
+  return ret;
+}
+
+int ObJoinSkewPieceMsgCtx::get_dfo_task_cnt(uint64_t dfo_id, int64_t &task_cnt)
+{
+  int ret = OB_SUCCESS;
+  ObDfo *dfo = NULL;
+  if (OB_FAIL(dfo_mgr_.find_dfo_edge(dfo_id, dfo))) {
+    LOG_WARN("fail find dfo", K(ret), K(dfo_id));
+  } else if (OB_ISNULL(dfo)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("dfo is null", K(ret), K(dfo_id));
+  } else {
+    task_cnt = dfo->get_total_task_count();
+  }
+  return ret;
+}
+
+// merge key stats of all build side tasks, keys with frequency >= min_freq_ are skewed.
+int ObJoinSkewPieceMsgCtx::process_skew_keys()
+{
+  int ret = OB_SUCCESS;
+  const int64_t total = whole_msg_.sample_row_cnt_;
+  whole_msg_.skew_values_hash_.reuse();
+  if (total >= MIN_SKEW_SAMPLE_ROW_CNT && !key_stats_.empty()) {
+    std::sort(key_stats_.begin(), key_stats_.end(),
+              [](const ObJoinSkewKeyStat &l, const ObJoinSkewKeyStat &r)
+              { return l.hash_val_ < r.hash_val_; });
+    int64_t i = 0;
+    while (OB_SUCC(ret) && i < key_stats_.count()) {
+      const uint64_t hash_val = key_stats_.at(i).hash_val_;
+      int64_t cnt = 0;
+      for (; i < key_stats_.count() && key_stats_.at(i).hash_val_ == hash_val; ++i) {
+        cnt += key_stats_.at(i).cnt_;
+      }
+      if (cnt * 100 / total >= min_freq_) {
+        if (OB_FAIL(whole_msg_.skew_values_hash_.push_back(hash_val))) {
+          LOG_WARN("fail push back skew value", K(ret));
+        } else {
+          LOG_TRACE("detect a skewed join key", K(hash_val), K(cnt), K(total), K_(min_freq));
+        }
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    whole_msg_ready_ = true;
+    LOG_TRACE("join skew detect done", K_(whole_msg), K_(min_freq));
+  }
+  return ret;
+}
+
+int ObJoinSkewPieceMsgCtx::alloc_piece_msg_ctx(const ObJoinSkewPieceMsg &pkt,
+                                               ObPxCoordInfo &coord_info,
+                                               ObExecContext &ctx,
+                                               int64_t task_cnt,
+                                               ObPieceMsgCtx *&msg_ctx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(ctx.get_my_session()) ||
+      OB_ISNULL(ctx.get_physical_plan_ctx())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is null or physical plan ctx is null", K(ret));
+  } else {
+    void *buf = ctx.get_allocator().alloc(sizeof(ObJoinSkewPieceMsgCtx));
+    if (OB_ISNULL(buf)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+    } else {
+      msg_ctx = new (buf) ObJoinSkewPieceMsgCtx(pkt.op_id_, task_cnt,
+          ctx.get_physical_plan_ctx()->get_timeout_timestamp(),
+          ctx.get_my_session()->get_px_join_skew_minfreq(),
+          coord_info.dfo_mgr_);
+    }
+  }
+  return ret;
+}
+
+int ObJoinSkewPieceMsgCtx::send_whole_msg(common::ObIArray<ObPxSqcMeta *> &sqcs)
+{
+  int ret = OB_SUCCESS;
+  whole_msg_.op_id_ = op_id_;
+  ARRAY_FOREACH_X(sqcs, idx, cnt, OB_SUCC(ret)) {
+    dtl::ObDtlChannel *ch = sqcs.at(idx)->get_qc_channel();
+    if (OB_ISNULL(ch)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null expected", K(ret));
+    } else if (OB_FAIL(ch->send(whole_msg_, timeout_ts_))) {
+      LOG_WARN("fail push data to channel", K(ret));
+    } else if (OB_FAIL(ch->flush(true, false))) {
+      LOG_WARN("fail flush dtl data", K(ret));
+    } else {
+      LOG_DEBUG("dispatched join skew whole msg",
+                K(idx), K(cnt), K(whole_msg_), K(*ch));
+    }
+  }
+  if (OB_SUCC(ret) && OB_FAIL(ObPxChannelUtil::sqcs_channles_asyn_wait(sqcs))) {
+    LOG_WARN("failed to wait response", K(ret));
+  }
+  return ret;
+}
+
+void ObJoinSkewPieceMsgCtx::reset_resource()
+{
+  build_received_ = 0;
+  probe_received_ = 0;
+  whole_msg_ready_ = false;
+  whole_msg_.reset();
+  key_stats_.reuse();
+  probe_sqcs_.reuse();
+}
+
+int ObJoinSkewWholeMsg::assign(const ObJoinSkewWholeMsg &other)
+{
+  int ret = OB_SUCCESS;
+  sample_row_cnt_ = other.sample_row_cnt_;
+  if (OB_FAIL(skew_values_hash_.assign(other.skew_values_hash_))) {
+    LOG_WARN("fail assign skew values hash", K(ret));
+  }
+  return ret;
+}
@@ -0,0 +1,163 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef __OB_SQL_ENG_PX_DH_JOIN_SKEW_H__
+#define __OB_SQL_ENG_PX_DH_JOIN_SKEW_H__
+
+#include "sql/engine/px/datahub/ob_dh_msg.h"
+#include "sql/engine/px/datahub/ob_dh_dtl_proc.h"
+#include "sql/engine/px/datahub/ob_dh_msg_ctx.h"
+#include "sql/engine/px/datahub/ob_dh_msg_provider.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+class ObJoinSkewPieceMsg;
+class ObJoinSkewWholeMsg;
+typedef ObPieceMsgP<ObJoinSkewPieceMsg> ObJoinSkewPieceMsgP;
+typedef ObWholeMsgP<ObJoinSkewWholeMsg> ObJoinSkewWholeMsgP;
+class ObJoinSkewPieceMsgListener;
+class ObJoinSkewPieceMsgCtx;
+class ObPxCoordInfo;
+class ObDfoMgr;
+
+// Runtime skew detection for hybrid hash distribution of parallel hash join.
+//
+// Both transmits below the hash join use the hash join's op id as datahub op id:
+//  - build side (HYBRID_HASH_BROADCAST) samples header rows and reports the hash values
+//    of the most frequent join keys;
+//  - probe side (HYBRID_HASH_RANDOM) reports an empty piece and waits for the result.
+// QC merges the build side samples, picks keys whose frequency is above
+// _px_join_skew_minfreq and sends the same whole msg to both sides, so that
+// build rows of the hot keys are broadcast and probe rows are sent round-robin.
+struct ObJoinSkewKeyStat
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  ObJoinSkewKeyStat() : hash_val_(0), cnt_(0) {}
+  ObJoinSkewKeyStat(uint64_t hash_val, int64_t cnt) : hash_val_(hash_val), cnt_(cnt) {}
+  TO_STRING_KV(K_(hash_val), K_(cnt));
+  uint64_t hash_val_;
+  int64_t cnt_;
+};
+
+class ObJoinSkewPieceMsg
+  : public ObDatahubPieceMsg<dtl::ObDtlMsgType::DH_JOIN_SKEW_PIECE_MSG>
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  using PieceMsgListener = ObJoinSkewPieceMsgListener;
+  using PieceMsgCtx = ObJoinSkewPieceMsgCtx;
+public:
+  ObJoinSkewPieceMsg() : is_build_side_(false), sample_row_cnt_(0), key_stats_() {}
+  ~ObJoinSkewPieceMsg() = default;
+  void reset()
+  {
+    is_build_side_ = false;
+    sample_row_cnt_ = 0;
+    key_stats_.reset();
+  }
+  INHERIT_TO_STRING_KV("meta", ObDatahubPieceMsg<dtl::ObDtlMsgType::DH_JOIN_SKEW_PIECE_MSG>,
+                       K_(op_id), K_(is_build_side), K_(sample_row_cnt), K_(key_stats));
+public:
+  bool is_build_side_;
+  int64_t sample_row_cnt_;
+  // most frequent keys of the sampled rows, only set by build side
+  common::ObSEArray<ObJoinSkewKeyStat, 16> key_stats_;
+};
+
+class ObJoinSkewWholeMsg
+  : public ObDatahubWholeMsg<dtl::ObDtlMsgType::DH_JOIN_SKEW_WHOLE_MSG>
+{
+  OB_UNIS_VERSION_V(1);
+public:
+  using WholeMsgProvider = ObWholeMsgProvider<ObJoinSkewWholeMsg>;
+public:
+  ObJoinSkewWholeMsg() : sample_row_cnt_(0), skew_values_hash_() {}
+  ~ObJoinSkewWholeMsg() = default;
+  int assign(const ObJoinSkewWholeMsg &other);
+  void reset()
+  {
+    sample_row_cnt_ = 0;
+    skew_values_hash_.reset();
+  }
+  VIRTUAL_TO_STRING_KV(K_(op_id), K_(sample_row_cnt), K_(skew_values_hash));
+public:
+  int64_t sample_row_cnt_;
+  common::ObSEArray<uint64_t, 8> skew_values_hash_;
+};
+
+class ObJoinSkewPieceMsgCtx : public ObPieceMsgCtx
+{
+public:
+  // keys sampled less than this are never treated as skewed, avoid misjudgement with tiny input.
+  static const int64_t MIN_SKEW_SAMPLE_ROW_CNT = 64;
+  // max skewed keys reported by one task
+  static const int64_t MAX_SKEW_KEY_CNT = 16;
+public:
+  ObJoinSkewPieceMsgCtx(uint64_t op_id, int64_t task_cnt, int64_t timeout_ts,
+                        int64_t min_freq, ObDfoMgr &dfo_mgr)
+    : ObPieceMsgCtx(op_id, task_cnt, timeout_ts),
+      build_received_(0), probe_received_(0), probe_task_cnt_(0),
+      min_freq_(min_freq), whole_msg_ready_(false), dfo_mgr_(dfo_mgr),
+      whole_msg_(), key_stats_(), probe_sqcs_() {}
+  ~ObJoinSkewPieceMsgCtx() = default;
+  virtual void destroy()
+  {
+    key_stats_.reset();
+    probe_sqcs_.reset();
+  }
+  INHERIT_TO_STRING_KV("meta", ObPieceMsgCtx, K_(build_received), K_(probe_received),
+                       K_(probe_task_cnt), K_(min_freq), K_(whole_msg_ready));
+  virtual int send_whole_msg(common::ObIArray<ObPxSqcMeta *> &sqcs) override;
+  virtual void reset_resource() override;
+  static int alloc_piece_msg_ctx(const ObJoinSkewPieceMsg &pkt,
+                                 ObPxCoordInfo &coord_info,
+                                 ObExecContext &ctx,
+                                 int64_t task_cnt,
+                                 ObPieceMsgCtx *&msg_ctx);
+  int get_dfo_task_cnt(uint64_t dfo_id, int64_t &task_cnt);
+  int process_skew_keys();
+public:
+  int64_t build_received_;
+  int64_t probe_received_;
+  int64_t probe_task_cnt_;
+  int64_t min_freq_;
+  bool whole_msg_ready_;
+  ObDfoMgr &dfo_mgr_;
+  ObJoinSkewWholeMsg whole_msg_;
+  common::ObSEArray<ObJoinSkewKeyStat, 64> key_stats_;
+  // probe side finished before build side, send the whole msg after build side done.
+  common::ObSEArray<ObPxSqcMeta *, 8> probe_sqcs_;
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObJoinSkewPieceMsgCtx);
+};
+
+class ObJoinSkewPieceMsgListener
+{
+public:
+  ObJoinSkewPieceMsgListener() = default;
+  ~ObJoinSkewPieceMsgListener() = default;
+  static int on_message(
+      ObJoinSkewPieceMsgCtx &ctx,
+      common::ObIArray<ObPxSqcMeta *> &sqcs,
+      const ObJoinSkewPieceMsg &pkt);
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObJoinSkewPieceMsgListener);
+};
+
+}
+}
+#endif /* __OB_SQL_ENG_PX_DH_JOIN_SKEW_H__ */
+//// end of header file
@@ -29,7 +29,8 @@ namespace sql
 OB_SERIALIZE_MEMBER((ObPxDistTransmitOpInput, ObPxTransmitOpInput));
 
 OB_SERIALIZE_MEMBER((ObPxDistTransmitSpec, ObPxTransmitSpec), dist_exprs_,
-    dist_hash_funcs_, sort_cmp_funs_, sort_collations_, calc_tablet_id_expr_, popular_values_hash_);
+    dist_hash_funcs_, sort_cmp_funs_, sort_collations_, calc_tablet_id_expr_, popular_values_hash_,
+    skew_join_id_);
 
 int ObPxDistTransmitOp::inner_open()
 {
@@ -315,13 +316,19 @@ int ObPxDistTransmitOp::do_broadcast_dist()
 int ObPxDistTransmitOp::do_hybrid_hash_random_dist()
 {
   int ret = OB_SUCCESS;
-  ObHybridHashRandomSliceIdCalc slice_id_calc(
-      ctx_.get_allocator(), task_channels_.count(),
-      MY_SPEC.null_row_dist_method_,
-      &MY_SPEC.dist_exprs_, &MY_SPEC.dist_hash_funcs_,
-      &MY_SPEC.popular_values_hash_);
-  if (OB_FAIL(send_rows(slice_id_calc))) {
-    LOG_WARN("row distribution failed", K(ret));
+  if (OB_INVALID_ID != MY_SPEC.skew_join_id_ && !sample_done_
+      && OB_FAIL(do_datahub_join_skew(false/*is_build_side*/))) {
+    LOG_WARN("fail to detect join skew", K(ret));
+  } else {
+    ObHybridHashRandomSliceIdCalc slice_id_calc(
+        ctx_.get_allocator(), task_channels_.count(),
+        MY_SPEC.null_row_dist_method_,
+        &MY_SPEC.dist_exprs_, &MY_SPEC.dist_hash_funcs_,
+        &get_popular_values_hash());
+    if (OB_FAIL(send_rows(slice_id_calc))) {
+      LOG_WARN("row distribution failed", K(ret));
+    }
+    update_skew_monitor_info(slice_id_calc.get_popular_row_cnt());
   }
   return ret;
 }
@@ -329,13 +336,19 @@ int ObPxDistTransmitOp::do_hybrid_hash_random_dist()
 int ObPxDistTransmitOp::do_hybrid_hash_broadcast_dist()
 {
   int ret = OB_SUCCESS;
-  ObHybridHashBroadcastSliceIdCalc slice_id_calc(
-      ctx_.get_allocator(), task_channels_.count(),
-      MY_SPEC.null_row_dist_method_,
-      &MY_SPEC.dist_exprs_, &MY_SPEC.dist_hash_funcs_,
-      &MY_SPEC.popular_values_hash_);
-  if (OB_FAIL(send_rows(slice_id_calc))) {
-    LOG_WARN("row distribution failed", K(ret));
+  if (OB_INVALID_ID != MY_SPEC.skew_join_id_ && !sample_done_
+      && OB_FAIL(do_datahub_join_skew(true/*is_build_side*/))) {
+    LOG_WARN("fail to detect join skew", K(ret));
+  } else {
+    ObHybridHashBroadcastSliceIdCalc slice_id_calc(
+        ctx_.get_allocator(), task_channels_.count(),
+        MY_SPEC.null_row_dist_method_,
+        &MY_SPEC.dist_exprs_, &MY_SPEC.dist_hash_funcs_,
+        &get_popular_values_hash());
+    if (OB_FAIL(send_rows(slice_id_calc))) {
+      LOG_WARN("row distribution failed", K(ret));
+    }
+    update_skew_monitor_info(slice_id_calc.get_popular_row_cnt());
   }
   return ret;
 }
@@ -524,7 +537,18 @@ int ObPxDistTransmitOp::build_row_sample_piece_msg(int64_t expected_range_count,
   OZ(piece_msg.row_stores_.push_back(sample_store));
   OZ(sample_stores_.push_back(sample_store));
 
+  OZ(init_sampled_input_rows(tenant_id));
+  if (is_vectorized()) {
+    OZ(add_batch_row_for_piece_msg(*sample_store));
+  } else {
+    OZ(add_row_for_piece_msg(*sample_store));
+  }
+  return ret;
+}
 
+int ObPxDistTransmitOp::init_sampled_input_rows(const int64_t tenant_id)
+{
+  int ret = OB_SUCCESS;
   int64_t row_count = MY_SPEC.rows_;
   OZ(ObPxEstimateSizeUtil::get_px_size(
           &ctx_, MY_SPEC.px_est_size_factor_, row_count, row_count));
@@ -544,19 +568,162 @@ int ObPxDistTransmitOp::build_row_sample_piece_msg(int64_t expected_range_count,
           sql_mem_processor_.get_mem_bound(), tenant_id,
           ObCtxIds::WORK_AREA, "PxSampleRow"));
   sampled_input_rows_.set_io_observer(&io_event_observer_);
+  return ret;
+}
+
+// Build side: hold the header rows in %sampled_input_rows_ (same as range distribution
+// header sampling) and report the most frequent join key hash values of them.
+// The held rows are sent after the skewed keys are known.
+int ObPxDistTransmitOp::build_join_skew_piece_msg(ObJoinSkewPieceMsg &piece_msg)
+{
+  int ret = OB_SUCCESS;
+  int64_t tenant_id = ctx_.get_my_session()->get_effective_tenant_id();
+  ObChunkDatumStore sample_store("JOIN_SKEW_CTX");
+  ObChunkDatumStore::Iterator it;
+  ObSEArray<uint64_t, DYNAMIC_SAMPLE_ROW_COUNT> hash_vals;
+  OZ(sample_store.init(0, tenant_id, ObCtxIds::DEFAULT_CTX_ID, "JOIN_SKEW_CTX",
+                       false/*enable dump*/));
+  OZ(init_sampled_input_rows(tenant_id));
   if (is_vectorized()) {
-    OZ(add_batch_row_for_piece_msg(*sample_store));
+    OZ(add_batch_row_for_piece_msg(sample_store));
   } else {
-    OZ(add_row_for_piece_msg(*sample_store));
+    OZ(add_row_for_piece_msg(sample_store));
+  }
+  OZ(sample_store.begin(it));
+  while (OB_SUCC(ret)) {
+    const ObChunkDatumStore::StoredRow *sr = NULL;
+    uint64_t hash_val = 0;
+    if (OB_FAIL(it.get_next_row(sr))) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("fail get sampled row", K(ret));
+      }
+    } else if (OB_ISNULL(sr) || OB_UNLIKELY(sr->cnt_ != MY_SPEC.dist_hash_funcs_.count())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected sampled row", K(ret), KP(sr));
+    } else {
+      // same as ObHashSliceIdCalc::calc_hash_value()
+      for (int64_t i = 0; OB_SUCC(ret) && i < sr->cnt_; ++i) {
+        if (OB_FAIL(MY_SPEC.dist_hash_funcs_.at(i).hash_func_(sr->cells()[i],
+                                                              hash_val, hash_val))) {
+          LOG_WARN("failed to do hash", K(ret));
+        }
+      }
+      OZ(hash_vals.push_back(hash_val));
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+  }
+  if (OB_SUCC(ret)) {
+    piece_msg.sample_row_cnt_ = hash_vals.count();
+    std::sort(hash_vals.begin(), hash_vals.end());
+    int64_t i = 0;
+    while (OB_SUCC(ret) && i < hash_vals.count()) {
+      int64_t start = i;
+      for (; i < hash_vals.count() && hash_vals.at(i) == hash_vals.at(start); ++i) {
+      }
+      // a key appears only once in the sample is never skewed
+      if (i - start > 1) {
+        OZ(piece_msg.key_stats_.push_back(ObJoinSkewKeyStat(hash_vals.at(start), i - start)));
+      }
+    }
+    if (OB_SUCC(ret) && piece_msg.key_stats_.count() > ObJoinSkewPieceMsgCtx::MAX_SKEW_KEY_CNT) {
+      std::sort(piece_msg.key_stats_.begin(), piece_msg.key_stats_.end(),
+                [](const ObJoinSkewKeyStat &l, const ObJoinSkewKeyStat &r)
+                { return l.cnt_ > r.cnt_; });
+      while (piece_msg.key_stats_.count() > ObJoinSkewPieceMsgCtx::MAX_SKEW_KEY_CNT) {
+        piece_msg.key_stats_.pop_back();
+      }
+    }
+  }
+  sample_store.reset();
+  return ret;
+}
+
+int ObPxDistTransmitOp::do_datahub_join_skew(const bool is_build_side)
+{
+  int ret = OB_SUCCESS;
+  ObPxSqcHandler *handler = ctx_.get_sqc_handler();
+  if (OB_ISNULL(handler)) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("join skew detect only supported in parallel execution mode", K(ret));
+  } else {
+    ObPxSQCProxy &proxy = handler->get_sqc_proxy();
+    const ObJoinSkewWholeMsg *whole_msg = NULL;
+    ObJoinSkewPieceMsg piece_msg;
+    piece_msg.op_id_ = MY_SPEC.skew_join_id_;
+    piece_msg.thread_id_ = GETTID();
+    piece_msg.source_dfo_id_ = proxy.get_dfo_id();
+    piece_msg.target_dfo_id_ = proxy.get_dfo_id();
+    piece_msg.is_build_side_ = is_build_side;
+    if (is_build_side && OB_FAIL(build_join_skew_piece_msg(piece_msg))) {
+      LOG_WARN("fail to build join skew piece msg", K(ret));
+    } else if (OB_FAIL(proxy.get_dh_msg_sync(MY_SPEC.skew_join_id_,
+        dtl::DH_JOIN_SKEW_WHOLE_MSG,
+        piece_msg,
+        whole_msg,
+        ctx_.get_physical_plan_ctx()->get_timeout_timestamp()))) {
+      LOG_WARN("fail get join skew msg", K(ret));
+    } else if (OB_ISNULL(whole_msg)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("whole msg is unexpected", K(ret));
+    } else if (OB_FAIL(skew_values_hash_.assign(MY_SPEC.popular_values_hash_))) {
+      LOG_WARN("fail assign popular values hash", K(ret));
+    } else {
+      FOREACH_CNT_X(hash_val, whole_msg->skew_values_hash_, OB_SUCC(ret)) {
+        if (!has_exist_in_array(skew_values_hash_, *hash_val)
+            && OB_FAIL(skew_values_hash_.push_back(*hash_val))) {
+          LOG_WARN("fail push back skew value", K(ret));
+        }
+      }
+      LOG_TRACE("join skew detect succ", K(is_build_side), K(piece_msg), K(*whole_msg),
+                K(skew_values_hash_));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    sample_done_ = true;
   }
   return ret;
 }
 
+const ObIArray<uint64_t> &ObPxDistTransmitOp::get_popular_values_hash() const
+{
+  return OB_INVALID_ID == MY_SPEC.skew_join_id_
+      ? static_cast<const ObIArray<uint64_t> &>(MY_SPEC.popular_values_hash_)
+      : static_cast<const ObIArray<uint64_t> &>(skew_values_hash_);
+}
+
+void ObPxDistTransmitOp::update_skew_monitor_info(const int64_t skew_row_cnt)
+{
+  op_monitor_info_.otherstat_4_id_ = ObSqlMonitorStatIds::EXCHANGE_SKEW_KEY_COUNT;
+  op_monitor_info_.otherstat_4_value_ = get_popular_values_hash().count();
+  op_monitor_info_.otherstat_5_id_ = ObSqlMonitorStatIds::EXCHANGE_SKEW_ROW_COUNT;
+  op_monitor_info_.otherstat_5_value_ = skew_row_cnt;
+}
+
 int ObPxDistTransmitSpec::register_to_datahub(ObExecContext &ctx) const
 {
   int ret = OB_SUCCESS;
   if (OB_FAIL(ObPxTransmitSpec::register_to_datahub(ctx))) {
     LOG_WARN("failed to register init channel msg", K(ret));
+  } else if (OB_INVALID_ID != skew_join_id_) {
+    if (OB_ISNULL(ctx.get_sqc_handler())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null unexpected", K(ret));
+    } else {
+      void *buf = ctx.get_allocator().alloc(sizeof(ObJoinSkewWholeMsg::WholeMsgProvider));
+      if (OB_ISNULL(buf)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+      } else {
+        ObJoinSkewWholeMsg::WholeMsgProvider *provider =
+          new (buf)ObJoinSkewWholeMsg::WholeMsgProvider();
+        ObSqcCtx &sqc_ctx = ctx.get_sqc_handler()->get_sqc_ctx();
+        if (OB_FAIL(sqc_ctx.add_whole_msg_provider(skew_join_id_, dtl::DH_JOIN_SKEW_WHOLE_MSG,
+                                                   *provider))) {
+          LOG_WARN("fail add whole msg provider", K(ret));
+        }
+      }
+    }
   } else if (ObPQDistributeMethod::RANGE == dist_method_) {
     if (OB_ISNULL(ctx.get_sqc_handler())) {
       ret = OB_ERR_UNEXPECTED;
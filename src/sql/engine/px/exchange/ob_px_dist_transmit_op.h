@@ -16,6 +16,7 @@
 #include "ob_px_transmit_op.h"
 #include "sql/engine/sort/ob_sort_basic_info.h"
 #include "sql/engine/ob_tenant_sql_memory_manager.h"
+#include "sql/engine/px/datahub/components/ob_dh_join_skew.h"
 
 namespace oceanbase
 {
@@ -44,7 +45,8 @@ public:
     sort_cmp_funs_(alloc),
     sort_collations_(alloc),
     popular_values_hash_(alloc),
-    calc_tablet_id_expr_(NULL)
+    calc_tablet_id_expr_(NULL),
+    skew_join_id_(common::OB_INVALID_ID)
   {}
   ~ObPxDistTransmitSpec() {}
   virtual int register_to_datahub(ObExecContext &ctx) const override;
@@ -54,6 +56,9 @@ public:
   ObSortCollations sort_collations_;
   common::ObFixedArray<uint64_t, ObIAllocator> popular_values_hash_; // for hybrid hash distribution
   ObExpr *calc_tablet_id_expr_;   // for slave mapping
+  // hash join id for runtime skew detection of hybrid hash distribution,
+  // build side and probe side exchange the detected skewed keys with this datahub id.
+  uint64_t skew_join_id_;
 };
 
 class ObPxDistTransmitOp : public ObPxTransmitOp
@@ -63,7 +68,8 @@ public:
   : ObPxTransmitOp(exec_ctx, spec, input),
     mem_context_(NULL),
     profile_(ObSqlWorkAreaType::HASH_WORK_AREA),
-    sql_mem_processor_(profile_, op_monitor_info_)
+    sql_mem_processor_(profile_, op_monitor_info_),
+    skew_values_hash_()
   {}
   virtual ~ObPxDistTransmitOp() {}
 public:
@@ -87,6 +93,12 @@ private:
   int do_range_dist();
   int do_hybrid_hash_broadcast_dist();
   int do_hybrid_hash_random_dist();
+  // sample build side rows, get skewed keys detected by all tasks and merge them with
+  // the popular values from histogram.
+  int do_datahub_join_skew(const bool is_build_side);
+  int build_join_skew_piece_msg(ObJoinSkewPieceMsg &piece_msg);
+  const common::ObIArray<uint64_t> &get_popular_values_hash() const;
+  void update_skew_monitor_info(const int64_t skew_row_cnt);
 protected:
 
   // We need to send the stored input rows in random order in FULL_INPUT_SAMPLE mode,
@@ -101,6 +113,7 @@ protected:
 private:
   int build_row_sample_piece_msg(int64_t expected_range_count,
     ObDynamicSamplePieceMsg &piece_msg);
+  int init_sampled_input_rows(const int64_t tenant_id);
 
   // for range distribution to backup && restore last row/batch
   ObChunkDatumStore::ShadowStoredRow last_row_;
@@ -111,6 +124,8 @@ private:
   lib::MemoryContext mem_context_;
   ObSqlWorkAreaProfile profile_;
   ObSqlMemMgrProcessor sql_mem_processor_;
+  // popular values from histogram and skewed keys detected at runtime
+  common::ObSEArray<uint64_t, 8> skew_values_hash_;
 };
 
 } // end namespace sql
@@ -373,6 +373,8 @@ int ObPxTransmitOp::init_channel(ObPxTransmitOpInput &trans_input)
         ch->set_enable_channel_sync(min_cluster_version >= CLUSTER_VERSION_4_1_0_0);
         ch->set_batch_id(px_batch_id);
         ch->set_compression_type(dfc_.get_compressor_type());
+        ch->set_columnar_encoding(dfc_.enable_columnar_encoding()
+                                  && min_cluster_version >= CLUSTER_VERSION_4_3_0_1);
         ch->set_operator_owner();
         ch->set_thread_id(thread_id);
       }
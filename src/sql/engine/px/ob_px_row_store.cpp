@@ -187,7 +187,10 @@ int ObReceiveRowReader::add_buffer(dtl::ObDtlLinkedBuffer &buf, bool &transferre
   } else {
     // add buffer to receive list.
     int64_t rows = 0;
-    if (dtl::PX_DATUM_ROW == buf.msg_type()) {
+    if (is_columnar(buf)) {
+      // columnar message is decoded to expr datums directly, no swizzling needed.
+      rows = dtl::ObDtlColumnarDecoder::get_row_cnt(buf.buf());
+    } else if (dtl::PX_DATUM_ROW == buf.msg_type()) {
       auto block = reinterpret_cast<ObChunkDatumStore::Block *>(buf.buf());
       rows = block->rows_;
       if (rows > 0 && OB_FAIL(block->swizzling(NULL))) {
@@ -265,27 +268,28 @@ void ObReceiveRowReader::move_to_iterated(const int64_t rows)
   cur_iter_pos_ = 0;
 }
 
+template <typename BLOCK>
+dtl::ObDtlLinkedBuffer *ObReceiveRowReader::next_iter_buffer()
+{
+  if (NULL != recv_head_ && cur_iter_rows_ == buffer_rows<BLOCK>(*recv_head_)) {
+    move_to_iterated(cur_iter_rows_);
+  }
+  return recv_head_;
+}
+
 template <typename BLOCK, typename ROW>
 const ROW *ObReceiveRowReader::next_store_row()
 {
   const ROW *srow = NULL;
-  if (NULL != recv_head_) {
-    BLOCK *b = reinterpret_cast<BLOCK *>(recv_head_->buf());
-    if (cur_iter_rows_ == b->rows_) {
-      move_to_iterated(b->rows_);
-      if (NULL != recv_head_) {
-        b = reinterpret_cast<BLOCK *>(recv_head_->buf());
-      } else {
-        b = NULL;
-      }
-    }
-    if (NULL != b) {
-      int ret = b->get_store_row(cur_iter_pos_, srow);
-      if (OB_FAIL(ret)) {
-        LOG_WARN("fetch store row failed", K(ret));
-      } else {
-        cur_iter_rows_ += 1;
-      }
+  dtl::ObDtlLinkedBuffer *buf = next_iter_buffer<BLOCK>();
+  // stop at columnar message, which is iterated by attach_columnar_rows()
+  if (NULL != buf && !is_columnar(*buf)) {
+    BLOCK *b = reinterpret_cast<BLOCK *>(buf->buf());
+    int ret = b->get_store_row(cur_iter_pos_, srow);
+    if (OB_FAIL(ret)) {
+      LOG_WARN("fetch store row failed", K(ret));
+    } else {
+      cur_iter_rows_ += 1;
     }
   }
   return srow;
@@ -327,14 +331,33 @@ int ObReceiveRowReader::to_expr(const ObChunkDatumStore::StoredRow *srow,
       }
     }
     // deep copy dynamic const expr datum
-    if (dynamic_const_exprs.count() > 0) {
-      for (int64_t i = 0; OB_SUCC(ret) && i < dynamic_const_exprs.count(); i++) {
-        ObExpr *expr = dynamic_const_exprs.at(i);
-        if (0 == expr->res_buf_off_) {
-          // for compat 4.0, do nothing
-        } else if (OB_FAIL(expr->deep_copy_self_datum(eval_ctx))) {
-          LOG_WARN("fail to deep copy datum", K(ret), K(eval_ctx), K(*expr));
-        }
+    if (OB_FAIL(deep_copy_dynamic_const_exprs(dynamic_const_exprs, eval_ctx, 0))) {
+      LOG_WARN("deep copy dynamic const exprs failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+// %read_rows is zero for non-vectorized execution.
+int ObReceiveRowReader::deep_copy_dynamic_const_exprs(
+    const ObIArray<ObExpr*> &dynamic_const_exprs,
+    ObEvalCtx &eval_ctx,
+    const int64_t read_rows)
+{
+  int ret = OB_SUCCESS;
+  if (dynamic_const_exprs.count() > 0) {
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx);
+    if (read_rows > 0) {
+      batch_info_guard.set_batch_size(read_rows);
+      batch_info_guard.set_batch_idx(0);
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < dynamic_const_exprs.count(); i++) {
+      ObExpr *expr = dynamic_const_exprs.at(i);
+      OB_ASSERT(read_rows <= 0 || !expr->is_batch_result());
+      if (0 == expr->res_buf_off_) {
+        // for compat 4.0, do nothing
+      } else if (OB_FAIL(expr->deep_copy_self_datum(eval_ctx))) {
+        LOG_WARN("fail to deep copy datum", K(ret), K(eval_ctx), K(*expr));
       }
     }
   }
@@ -357,12 +380,29 @@ int ObReceiveRowReader::get_next_row(const ObIArray<ObExpr*> &exprs,
     }
   } else {
     free_iterated_buffers();
-    const ObChunkDatumStore::StoredRow *srow
-        = next_store_row<ObChunkDatumStore::Block, ObChunkDatumStore::StoredRow>();
-    if (NULL == srow) {
-      ret = OB_ITER_END;
+    dtl::ObDtlLinkedBuffer *buf = next_iter_buffer<ObChunkDatumStore::Block>();
+    if (NULL != buf && is_columnar(*buf)) {
+      // rows of the same batch (see ObPxReceiveOp::wrap_get_next_batch) may still
+      // reference decoded values, only reuse memory when a new message is started.
+      if (0 == cur_iter_rows_) {
+        decode_alloc_.reuse();
+      }
+      if (OB_FAIL(attach_columnar_rows(exprs, eval_ctx, buf->buf(), cur_iter_rows_, 1,
+                                       eval_ctx.get_batch_idx()))) {
+        LOG_WARN("attach columnar rows failed", K(ret));
+      } else if (OB_FAIL(deep_copy_dynamic_const_exprs(dynamic_const_exprs, eval_ctx, 0))) {
+        LOG_WARN("deep copy dynamic const exprs failed", K(ret));
+      } else {
+        cur_iter_rows_ += 1;
+      }
     } else {
-      ret = to_expr(srow, dynamic_const_exprs, exprs, eval_ctx);
+      const ObChunkDatumStore::StoredRow *srow
+          = next_store_row<ObChunkDatumStore::Block, ObChunkDatumStore::StoredRow>();
+      if (NULL == srow) {
+        ret = OB_ITER_END;
+      } else {
+        ret = to_expr(srow, dynamic_const_exprs, exprs, eval_ctx);
+      }
     }
   }
 
@@ -400,22 +440,47 @@ int ObReceiveRowReader::attach_rows(const common::ObIArray<ObExpr*> &exprs,
       }
     }
     // deep copy dynamic const expr datum
-    if (OB_SUCC(ret) && dynamic_const_exprs.count() > 0 && read_rows > 0) {
-      ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx);
-      batch_info_guard.set_batch_size(read_rows);
-      batch_info_guard.set_batch_idx(0);
-      for (int64_t i = 0; OB_SUCC(ret) && i < dynamic_const_exprs.count(); i++) {
-        ObExpr *expr = dynamic_const_exprs.at(i);
-        OB_ASSERT(!expr->is_batch_result());
-        if (0 == expr->res_buf_off_) {
-          // for compat 4.0, do nothing
-        } else if (OB_FAIL(expr->deep_copy_self_datum(eval_ctx))) {
-          LOG_WARN("fail to deep copy datum", K(ret), K(eval_ctx), K(*expr));
+    if (OB_SUCC(ret) && read_rows > 0
+        && OB_FAIL(deep_copy_dynamic_const_exprs(dynamic_const_exprs, eval_ctx, read_rows))) {
+      LOG_WARN("deep copy dynamic const exprs failed", K(ret));
+    }
+  }
+
+  return ret;
+}
+
+int ObReceiveRowReader::attach_columnar_rows(const common::ObIArray<ObExpr*> &exprs,
+                                             ObEvalCtx &eval_ctx,
+                                             const char *buf,
+                                             const int64_t start,
+                                             const int64_t read_rows,
+                                             const int64_t dst_idx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(buf) || OB_UNLIKELY(dtl::ObDtlColumnarDecoder::get_col_cnt(buf) != exprs.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid columnar message", K(ret), KP(buf), K(exprs.count()));
+  } else {
+    for (int64_t col_idx = 0; OB_SUCC(ret) && col_idx < exprs.count(); col_idx++) {
+      ObExpr *e = exprs.at(col_idx);
+      if (e->is_static_const_) {
+        continue;
+      } else {
+        ObDatum *datums = e->locate_batch_datums(eval_ctx)
+                          + (e->is_batch_result() ? dst_idx : 0);
+        if (OB_FAIL(dtl::ObDtlColumnarDecoder::decode(buf, col_idx, start,
+                                                      e->is_batch_result() ? read_rows : 1,
+                                                      datums, decode_alloc_))) {
+          LOG_WARN("decode column failed", K(ret), K(col_idx), K(start), K(read_rows));
+        } else {
+          e->set_evaluated_projected(eval_ctx);
+          ObEvalInfo &info = e->get_eval_info(eval_ctx);
+          info.notnull_ = false;
+          info.point_to_frame_ = false;
         }
       }
     }
   }
-
   return ret;
 }
 
@@ -447,16 +512,33 @@ int ObReceiveRowReader::get_next_batch(const ObIArray<ObExpr*> &exprs,
   } else {
     free_iterated_buffers();
     read_rows = 0;
-    const Store::StoredRow *srow = NULL;
-    while (read_rows < max_rows
-           && NULL != (srow = next_store_row<Store::Block, Store::StoredRow>())) {
-      srows[read_rows++] = srow;
-    }
-    if (0 == read_rows) {
-      ret = OB_ITER_END;
+    dtl::ObDtlLinkedBuffer *buf = next_iter_buffer<Store::Block>();
+    if (NULL != buf && is_columnar(*buf)) {
+      // batch never cross columnar message boundary
+      read_rows = std::min(max_rows, buffer_rows<Store::Block>(*buf) - cur_iter_rows_);
+      decode_alloc_.reuse();
+      if (OB_FAIL(attach_columnar_rows(exprs, eval_ctx, buf->buf(), cur_iter_rows_,
+                                       read_rows, 0))) {
+        LOG_WARN("attach columnar rows failed", K(ret));
+      } else if (read_rows > 0
+                 && OB_FAIL(deep_copy_dynamic_const_exprs(dynamic_const_exprs, eval_ctx,
+                                                          read_rows))) {
+        LOG_WARN("deep copy dynamic const exprs failed", K(ret));
+      } else {
+        cur_iter_rows_ += read_rows;
+      }
     } else {
-      LOG_DEBUG("read rows", K(read_rows), KP(this));
-      OZ(attach_rows(exprs, dynamic_const_exprs, eval_ctx, srows, read_rows));
+      const Store::StoredRow *srow = NULL;
+      while (read_rows < max_rows
+             && NULL != (srow = next_store_row<Store::Block, Store::StoredRow>())) {
+        srows[read_rows++] = srow;
+      }
+      if (0 == read_rows) {
+        ret = OB_ITER_END;
+      } else {
+        LOG_DEBUG("read rows", K(read_rows), KP(this));
+        OZ(attach_rows(exprs, dynamic_const_exprs, eval_ctx, srows, read_rows));
+      }
     }
   }
   return ret;
@@ -477,6 +559,8 @@ void ObReceiveRowReader::reset()
 
   datum_iter_ = NULL;
   row_iter_ = NULL;
+
+  decode_alloc_.reset();
 }
 
 
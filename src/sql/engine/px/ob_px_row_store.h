@@ -14,12 +14,14 @@
 #define _OB_SQL_ENGINE_PX_NEW_ROW_H_
 
 #include "lib/allocator/ob_allocator.h"
+#include "lib/allocator/page_arena.h"
 #include "common/row/ob_row.h"
 #include "common/object/ob_object.h"
 #include "sql/dtl/ob_dtl_channel.h"
 #include "sql/dtl/ob_dtl_msg_type.h"
 #include "sql/dtl/ob_dtl_processor.h"
 #include "sql/dtl/ob_dtl_linked_buffer.h"
+#include "sql/dtl/ob_dtl_columnar_codec.h"
 #include "sql/engine/basic/ob_chunk_row_store.h"
 #include "sql/engine/basic/ob_chunk_datum_store.h"
 
@@ -39,7 +41,8 @@ public:
       cur_iter_rows_(0),
       recv_list_rows_(0),
       datum_iter_(NULL),
-      row_iter_(NULL)
+      row_iter_(NULL),
+      decode_alloc_("PxColumnarDec")
   {
   }
   ~ObReceiveRowReader()
@@ -83,6 +86,16 @@ public:
                           const ObChunkDatumStore::StoredRow **srows,
                           const int64_t read_rows);
 
+  // decode rows [start, start + read_rows) of PX_COLUMNAR_DATUM message to batch datums
+  // [dst_idx, dst_idx + read_rows) of %exprs directly. Dynamic const exprs are not
+  // copied, which is left to the caller.
+  int attach_columnar_rows(const common::ObIArray<ObExpr*> &exprs,
+                           ObEvalCtx &eval_ctx,
+                           const char *buf,
+                           const int64_t start,
+                           const int64_t read_rows,
+                           const int64_t dst_idx);
+
   // get row interface for PX_CHUNK_ROW
   int get_next_row(common::ObNewRow &row);
 
@@ -107,6 +120,25 @@ private:
   // return NULL for iterate end.
   const ROW *next_store_row();
 
+  // move head buffer to iterated list if all rows iterated, return the new head buffer.
+  template <typename BLOCK>
+  dtl::ObDtlLinkedBuffer *next_iter_buffer();
+
+  template <typename BLOCK>
+  static int64_t buffer_rows(dtl::ObDtlLinkedBuffer &buf)
+  {
+    return is_columnar(buf)
+        ? dtl::ObDtlColumnarDecoder::get_row_cnt(buf.buf())
+        : reinterpret_cast<BLOCK *>(buf.buf())->rows_;
+  }
+  static bool is_columnar(const dtl::ObDtlLinkedBuffer &buf)
+  {
+    return dtl::PX_COLUMNAR_DATUM == buf.msg_type();
+  }
+  static int deep_copy_dynamic_const_exprs(const ObIArray<ObExpr*> &dynamic_const_exprs,
+                                           ObEvalCtx &eval_ctx,
+                                           const int64_t read_rows);
+
   void move_to_iterated(const int64_t rows);
   void free(dtl::ObDtlLinkedBuffer *buf);
   inline void free_iterated_buffers()
@@ -131,6 +163,10 @@ private:
   // store iterator for interm result iteration.
   ObChunkDatumStore::Iterator *datum_iter_;
   ObChunkRowStore::Iterator *row_iter_;
+
+  // memory of decoded bit packed values of columnar message, reused when a new message
+  // is started in row iteration or for each get batch call.
+  common::ObArenaAllocator decode_alloc_;
 };
 
 class ObPxNewRow
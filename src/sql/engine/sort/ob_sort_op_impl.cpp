@@ -17,6 +17,9 @@
 #include "sql/engine/ob_tenant_sql_memory_manager.h"
 #include "storage/blocksstable/encoding/ob_encoding_query_util.h"
 #include "lib/container/ob_iarray.h"
+#include "lib/lock/ob_thread_cond.h"
+#include "observer/omt/ob_tenant.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase
 {
@@ -354,7 +357,7 @@ int ObSortOpImpl::ObAdaptiveQS::compare_vals(int64_t l, int64_t r,
 
 ObSortOpImpl::Compare::Compare()
   : ret_(OB_SUCCESS), sort_collations_(nullptr), sort_cmp_funs_(nullptr),
-    exec_ctx_(nullptr), cmp_count_(0), cmp_start_(0), cmp_end_(0)
+    exec_ctx_(nullptr), cmp_count_(0), cmp_start_(0), cmp_end_(0), stop_ret_(nullptr)
 {
 }
 
@@ -388,7 +391,7 @@ int ObSortOpImpl::Compare::fast_check_status()
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY((cmp_count_++ & 8191) == 8191)) {
-    ret = exec_ctx_->check_status();
+    ret = NULL != stop_ret_ ? ATOMIC_LOAD(stop_ret_) : exec_ctx_->check_status();
   }
   return ret;
 }
@@ -576,7 +579,7 @@ ObSortOpImpl::ObSortOpImpl(ObMonitorNode &op_monitor_info)
     io_event_observer_(nullptr), buckets_(NULL), max_bucket_cnt_(0), part_hash_nodes_(NULL),
     max_node_cnt_(0), part_cnt_(0), topn_cnt_(INT64_MAX), outputted_rows_cnt_(0),
     is_fetch_with_ties_(false), topn_heap_(NULL), ties_array_pos_(0), ties_array_(),
-    last_ties_row_(NULL), rows_(NULL)
+    last_ties_row_(NULL), rows_(NULL), parallel_sort_degree_(0)
 {
 }
 
@@ -663,6 +666,11 @@ int ObSortOpImpl::init(
       datum_store_.set_allocator(mem_context_->get_malloc_allocator());
       datum_store_.set_io_event_observer(io_event_observer_);
       profile_.set_exec_ctx(exec_ctx);
+      omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id));
+      parallel_sort_degree_ = tenant_config.is_valid()
+          ? tenant_config->_sort_inmem_parallel_degree : 0;
+      parallel_sort_degree_ = parallel_sort_degree_ > MAX_PARALLEL_SORT_DEGREE
+          ? MAX_PARALLEL_SORT_DEGREE : parallel_sort_degree_;
       op_monitor_info_.otherstat_2_id_ = ObSqlMonitorStatIds::SORT_MERGE_SORT_ROUND;
       op_monitor_info_.otherstat_2_value_ = 1;
       ObPhysicalPlanCtx *plan_ctx = NULL;
@@ -1667,8 +1675,14 @@ int ObSortOpImpl::sort_inmem_data()
           }
         }
       }
+      bool parallel_sorted = false;
       if (part_cnt_ > 0) {
         do_partition_sort(*rows_, begin, rows_->count());
+      } else if (parallel_sort_degree_ > 1
+                 && OB_FAIL(parallel_sort_inmem_data(begin, parallel_sorted))) {
+        LOG_WARN("parallel sort in-memory data failed", K(ret));
+      } else if (parallel_sorted) {
+        // do nothing
       } else if (enable_encode_sortkey_) {
         bool can_encode = true;
         ObAdaptiveQS aqs(*rows_, mem_context_->get_malloc_allocator());
@@ -1736,6 +1750,227 @@ int ObSortOpImpl::sort_inmem_data()
   return ret;
 }
 
+void ObSortOpImpl::ParallelSortTask::sort(
+    common::ObIArray<ObChunkDatumStore::StoredRow *> &rows)
+{
+  int &ret = ret_;
+  if (comp_.enable_encode_sortkey_) {
+    ObAdaptiveQS aqs(rows, allocator_);
+    if (OB_FAIL(aqs.init(rows, allocator_, begin_, end_, can_encode_))) {
+      LOG_WARN("failed to init aqs", K(ret));
+    } else if (can_encode_) {
+      aqs.sort(begin_, end_);
+    } else {
+      comp_.enable_encode_sortkey_ = false;
+      std::sort(&rows.at(begin_), &rows.at(0) + end_, CopyableComparer(comp_));
+    }
+  } else {
+    std::sort(&rows.at(begin_), &rows.at(0) + end_, CopyableComparer(comp_));
+  }
+  if (OB_SUCC(ret) && OB_SUCCESS != comp_.ret_) {
+    ret = comp_.ret_;
+    LOG_WARN("compare failed", K(ret));
+  }
+}
+
+int ObSortOpImpl::parallel_sort_inmem_data(const int64_t begin, bool &sorted)
+{
+  int ret = OB_SUCCESS;
+  sorted = false;
+  const int64_t row_cnt = rows_->count() - begin;
+  const int64_t task_cnt = std::min(parallel_sort_degree_,
+                                    row_cnt / PARALLEL_SORT_MIN_ROWS_PER_THREAD);
+  // extra memory: merge output and encoded sort key items of adaptive quick sort, the
+  // latter is allocated by arena of each task, which is not in %mem_context_.
+  const int64_t task_mem_size = ParallelSortTask::get_mem_size(row_cnt, enable_encode_sortkey_);
+  const int64_t extra_mem_size = row_cnt * sizeof(ObChunkDatumStore::StoredRow *) + task_mem_size;
+  ObIAllocator &alloc = mem_context_->get_malloc_allocator();
+  omt::ObPxPools *px_pools = MTL(omt::ObPxPools*);
+  omt::ObPxPool *px_pool = NULL;
+  ParallelSortTask *tasks = NULL;
+  ObChunkDatumStore::StoredRow **sorted_rows = NULL;
+  int64_t submitted_cnt = 0;
+  // error code of the query, px pool threads stop sorting once it is set.
+  int stop_ret = OB_SUCCESS;
+  ObThreadCond finish_cond;
+  if (task_cnt <= 1) {
+    // too few rows, sort in current thread
+  } else if (mem_context_->used() + extra_mem_size > get_memory_limit()) {
+    LOG_TRACE("no memory for parallel sort, fall back to serial sort", K(row_cnt),
+              K(extra_mem_size), K(mem_context_->used()), K(get_memory_limit()));
+  } else if (OB_ISNULL(px_pools)) {
+    LOG_TRACE("no px pools in current tenant, fall back to serial sort");
+  } else if (OB_FAIL(px_pools->get_or_create(THIS_WORKER.get_group_id(), px_pool))) {
+    LOG_WARN("get px pool failed", K(ret));
+  } else if (OB_FAIL(finish_cond.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    LOG_WARN("init thread cond failed", K(ret));
+  } else if (OB_ISNULL(tasks = static_cast<ParallelSortTask *>(
+              alloc.alloc(sizeof(ParallelSortTask) * task_cnt)))
+             || OB_ISNULL(sorted_rows = static_cast<ObChunkDatumStore::StoredRow **>(
+              alloc.alloc(sizeof(ObChunkDatumStore::StoredRow *) * row_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(task_cnt), K(row_cnt));
+  } else {
+    int64_t constructed_cnt = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < task_cnt; i++) {
+      ParallelSortTask *task = new (&tasks[i]) ParallelSortTask(tenant_id_);
+      constructed_cnt += 1;
+      task->begin_ = begin + row_cnt * i / task_cnt;
+      task->end_ = begin + row_cnt * (i + 1) / task_cnt;
+      if (OB_FAIL(task->comp_.init(sort_collations_, sort_cmp_funs_, exec_ctx_,
+                                   comp_.enable_encode_sortkey_))) {
+        LOG_WARN("init compare failed", K(ret));
+      }
+    }
+    // arenas of tasks are not allocated from %mem_context_, add them to sql memory manager.
+    sql_mem_processor_.alloc(task_mem_size);
+    // the first range is sorted by current thread, ranges failed to submit (no idle
+    // thread in px pool) are sorted by current thread too.
+    common::ObIArray<ObChunkDatumStore::StoredRow *> *rows = rows_;
+    ObThreadCond *cond = &finish_cond;
+    const ObCurTraceId::TraceId trace_id = *ObCurTraceId::get_trace_id();
+    const lib::Worker::CompatMode compat_mode = lib::get_compat_mode();
+    for (int64_t i = 1; OB_SUCC(ret) && i < task_cnt; i++) {
+      ParallelSortTask *task = &tasks[i];
+      auto func = [task, rows, cond, trace_id, compat_mode]() {
+        lib::CompatModeGuard compat_guard(compat_mode);
+        ObCurTraceId::set(trace_id);
+        task->sort(*rows);
+        ObCurTraceId::reset();
+        ObThreadCondGuard guard(*cond);
+        task->finished_ = true;
+        cond->broadcast();
+      };
+      task->comp_.set_stop_ret(&stop_ret);
+      if (OB_SUCCESS != px_pool->submit(func)) {
+        task->comp_.set_stop_ret(NULL);
+        break;
+      } else {
+        submitted_cnt += 1;
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < task_cnt; i++) {
+      if (i > 0 && i <= submitted_cnt) {
+        // sorted in px pool
+      } else if (FALSE_IT(tasks[i].sort(*rows_))) {
+      } else if (OB_FAIL(tasks[i].ret_)) {
+        LOG_WARN("sort range in current thread failed", K(ret), K(i));
+        ATOMIC_STORE(&stop_ret, ret);
+      }
+    }
+    // always wait submitted tasks, they are referencing %tasks and %rows_. Px pool threads
+    // can not see kill or interrupt of the query, check it here and stop them.
+    for (int64_t i = 1; i <= submitted_cnt; i++) {
+      bool finished = false;
+      while (!finished) {
+        {
+          ObThreadCondGuard guard(finish_cond);
+          if (!(finished = tasks[i].finished_)) {
+            finish_cond.wait(PARALLEL_SORT_WAIT_INTERVAL_MS);
+            finished = tasks[i].finished_;
+          }
+        }
+        if (!finished && OB_SUCC(ret) && OB_FAIL(exec_ctx_->check_status())) {
+          LOG_WARN("check status failed, stop parallel sort", K(ret));
+          ATOMIC_STORE(&stop_ret, ret);
+        }
+      }
+    }
+    // the real memory of arenas is known after sorting
+    int64_t task_mem_used = 0;
+    for (int64_t i = 0; i < constructed_cnt; i++) {
+      task_mem_used += tasks[i].allocator_.total();
+    }
+    sql_mem_processor_.alloc(task_mem_used - task_mem_size);
+    for (int64_t i = 0; OB_SUCC(ret) && i < task_cnt; i++) {
+      if (OB_FAIL(tasks[i].ret_)) {
+        LOG_WARN("parallel sort task failed", K(ret), K(i), K(tasks[i]));
+      } else if (!tasks[i].can_encode_) {
+        enable_encode_sortkey_ = false;
+        comp_.enable_encode_sortkey_ = false;
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(merge_parallel_sorted_rows(tasks, task_cnt, sorted_rows))) {
+      LOG_WARN("merge parallel sorted rows failed", K(ret));
+    } else {
+      for (int64_t i = 0; i < row_cnt; i++) {
+        rows_->at(begin + i) = sorted_rows[i];
+      }
+      sorted = true;
+      LOG_TRACE("parallel sort in-memory data", K(row_cnt), K(task_cnt), K(submitted_cnt));
+    }
+    for (int64_t i = 0; i < constructed_cnt; i++) {
+      tasks[i].~ParallelSortTask();
+    }
+    sql_mem_processor_.alloc(-task_mem_used);
+  }
+  if (NULL != tasks) {
+    alloc.free(tasks);
+    tasks = NULL;
+  }
+  if (NULL != sorted_rows) {
+    alloc.free(sorted_rows);
+    sorted_rows = NULL;
+  }
+  return ret;
+}
+
+// merge sorted ranges of %tasks to %sorted_rows, the begin_ of task is used as cursor.
+int ObSortOpImpl::merge_parallel_sorted_rows(ParallelSortTask *tasks, const int64_t task_cnt,
+                                             ObChunkDatumStore::StoredRow **sorted_rows)
+{
+  int ret = OB_SUCCESS;
+  ObIAllocator &alloc = mem_context_->get_malloc_allocator();
+  ParallelMergeCompare merge_cmp(comp_);
+  ParallelMergeLoserTree *loser_tree = NULL;
+  if (OB_ISNULL(tasks) || OB_ISNULL(sorted_rows)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(tasks), KP(sorted_rows));
+  } else if (OB_ISNULL(loser_tree = OB_NEWx(ParallelMergeLoserTree, (&alloc), merge_cmp))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret));
+  } else if (OB_FAIL(loser_tree->init(task_cnt, alloc))) {
+    LOG_WARN("init loser tree failed", K(ret), K(task_cnt));
+  } else {
+    ParallelMergeItem item;
+    for (int64_t i = 0; OB_SUCC(ret) && i < task_cnt; i++) {
+      item.row_ = rows_->at(tasks[i].begin_++);
+      item.task_idx_ = i;
+      if (OB_FAIL(loser_tree->push(item))) {
+        LOG_WARN("push loser tree failed", K(ret));
+      }
+    }
+    int64_t idx = 0;
+    const ParallelMergeItem *top = NULL;
+    while (OB_SUCC(ret) && !loser_tree->empty()) {
+      if (OB_FAIL(loser_tree->rebuild())) {
+        LOG_WARN("rebuild loser tree failed", K(ret));
+      } else if (OB_FAIL(loser_tree->top(top))) {
+        LOG_WARN("get loser tree top failed", K(ret));
+      } else {
+        ParallelSortTask &task = tasks[top->task_idx_];
+        item.task_idx_ = top->task_idx_;
+        sorted_rows[idx++] = top->row_;
+        if (OB_FAIL(loser_tree->pop())) {
+          LOG_WARN("pop loser tree failed", K(ret));
+        } else if (task.begin_ < task.end_) {
+          item.row_ = rows_->at(task.begin_++);
+          if (OB_FAIL(loser_tree->push(item))) {
+            LOG_WARN("push loser tree failed", K(ret));
+          }
+        }
+      }
+    }
+  }
+  if (NULL != loser_tree) {
+    loser_tree->~ParallelMergeLoserTree();
+    alloc.free(loser_tree);
+    loser_tree = NULL;
+  }
+  return ret;
+}
+
 int ObSortOpImpl::sort()
 {
   int ret = OB_SUCCESS;
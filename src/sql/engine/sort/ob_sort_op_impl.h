@@ -15,6 +15,7 @@
 
 #include "lib/container/ob_array.h"
 #include "lib/container/ob_heap.h"
+#include "lib/container/ob_loser_tree.h"
 #include "sql/engine/basic/ob_chunk_datum_store.h"
 #include "sql/engine/ob_sql_mem_mgr_processor.h"
 #include "sql/engine/sort/ob_sort_basic_info.h"
@@ -72,6 +73,11 @@ public:
   static const int64_t EXTEND_MULTIPLE = 2;
   static const int64_t MAX_MERGE_WAYS = 256;
   static const int64_t INMEMORY_MERGE_SORT_WARN_WAYS = 10000;
+  // parallel in-memory sort: minimum rows sorted by each thread and max threads
+  static const int64_t PARALLEL_SORT_MIN_ROWS_PER_THREAD = 64 * 1024;
+  static const int64_t MAX_PARALLEL_SORT_DEGREE = 64;
+  // interval of checking query status while waiting px pool threads
+  static const int64_t PARALLEL_SORT_WAIT_INTERVAL_MS = 10;
 
   explicit ObSortOpImpl(ObMonitorNode &op_monitor_info);
   virtual ~ObSortOpImpl();
@@ -276,6 +282,9 @@ public:
     void reset() { this->~Compare(); new (this)Compare(); }
 
     int fast_check_status();
+    // Check %stop_ret instead of exec_ctx_->check_status(), for compare in threads other than
+    // the query worker, which has no session interrupt and throttle state of the query.
+    void set_stop_ret(const int *stop_ret) { stop_ret_ = stop_ret; }
 
     int64_t get_cnt() { return cnt_; }
 
@@ -295,6 +304,7 @@ public:
     int64_t cmp_count_;
     int64_t cmp_start_;
     int64_t cmp_end_;
+    const int *stop_ret_;
   private:
     int64_t cnt_;
     DISALLOW_COPY_AND_ASSIGN(Compare);
@@ -394,6 +404,53 @@ public:
       common::ObIAllocator &alloc_;
   };
 
+  // Sort rows in [begin_, end_) of the in-memory rows, executed in px pool thread
+  // for parallel in-memory sort.
+  class ParallelSortTask
+  {
+  public:
+    explicit ParallelSortTask(const uint64_t tenant_id)
+      : ret_(common::OB_SUCCESS), begin_(0), end_(0), can_encode_(true), finished_(false),
+        allocator_("SortParallel", common::OB_MALLOC_NORMAL_BLOCK_SIZE, tenant_id), comp_() {}
+    ~ParallelSortTask() {}
+    void sort(common::ObIArray<ObChunkDatumStore::StoredRow *> &rows);
+    // memory to be allocated by %allocator_ for sorting the range
+    static int64_t get_mem_size(const int64_t row_cnt, const bool encode_sortkey)
+    {
+      return encode_sortkey ? row_cnt * static_cast<int64_t>(sizeof(AQSItem)) : 0;
+    }
+    TO_STRING_KV(K_(ret), K_(begin), K_(end), K_(can_encode), K_(finished));
+  public:
+    int ret_;
+    int64_t begin_;
+    int64_t end_;
+    bool can_encode_;
+    bool finished_;
+    common::ObArenaAllocator allocator_;
+    Compare comp_;
+  private:
+    DISALLOW_COPY_AND_ASSIGN(ParallelSortTask);
+  };
+  struct ParallelMergeItem
+  {
+    ObChunkDatumStore::StoredRow *row_;
+    int64_t task_idx_;
+    TO_STRING_KV(KP_(row), K_(task_idx));
+  };
+  class ParallelMergeCompare
+  {
+  public:
+    explicit ParallelMergeCompare(Compare &compare) : compare_(compare) {}
+    int cmp(const ParallelMergeItem &l, const ParallelMergeItem &r, int64_t &cmp_ret)
+    {
+      cmp_ret = compare_(l.row_, r.row_) ? -1 : 1;
+      return compare_.ret_;
+    }
+    Compare &compare_;
+  };
+  typedef common::ObLoserTree<ParallelMergeItem, ParallelMergeCompare, MAX_PARALLEL_SORT_DEGREE>
+      ParallelMergeLoserTree;
+
 protected:
   class MemEntifyFreeGuard
   {
@@ -462,6 +519,11 @@ protected:
     return !use_heap_sort_ && rows_->count() > datum_store_.get_row_cnt();
   }
   int sort_inmem_data();
+  // Split rows in [begin, rows_->count()) into ranges, sort them in px pool threads and
+  // merge with loser tree. %sorted is false if fall back to serial sort.
+  int parallel_sort_inmem_data(const int64_t begin, bool &sorted);
+  int merge_parallel_sorted_rows(ParallelSortTask *tasks, const int64_t task_cnt,
+                                 ObChunkDatumStore::StoredRow **sorted_rows);
   int do_dump();
 
   template <typename Input>
@@ -607,6 +669,8 @@ protected:
   ObChunkDatumStore::StoredRow *last_ties_row_;
   common::ObIArray<ObChunkDatumStore::StoredRow *> *rows_;
   ObChunkDatumStore::IteratedBlockHolder blk_holder_;
+  // max threads of in-memory sort, see _sort_inmem_parallel_degree
+  int64_t parallel_sort_degree_;
 };
 
 class ObInMemoryTopnSortImpl;
@@ -0,0 +1,1704 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+#include "ob_parquet_file_reader.h"
+
+#include <cmath>
+#include "lib/compress/ob_compressor_pool.h"
+#include "lib/timezone/ob_time_convert.h"
+#include "lib/utility/ob_fast_convert.h"
+#include "lib/utility/ob_print_utils.h"
+#include "common/ob_smart_call.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+typedef ObParquetThriftDecoder TD;
+
+static const char BOOL_TRUE_TEXT[] = "1";
+static const char BOOL_FALSE_TEXT[] = "0";
+static const int64_t MAX_DECIMAL_PRECISION = 38;
+static const int64_t MAX_DECIMAL_BYTES = 16;
+static const int32_t MAX_BIT_WIDTH = 32;
+// julian day number of 1970-01-01, used by the legacy INT96 timestamps
+static const int64_t JULIAN_DAY_OF_EPOCH = 2440588;
+// days of 0000-01-01, the min value of date
+static const int64_t MIN_DATE_VAL = DATETIME_MIN_VAL / USECS_PER_DAY;
+// text buffer slot holding a value of a typed datum
+static const int64_t TYPED_VALUE_LEN = sizeof(int64_t);
+
+template <typename T>
+static OB_INLINE T read_le(const char *ptr)
+{
+  T value;
+  MEMCPY(&value, ptr, sizeof(T));
+  return value;
+}
+
+static OB_INLINE int64_t floor_div(const int64_t value, const int64_t divisor)
+{
+  int64_t res = value / divisor;
+  if (value % divisor < 0) {
+    --res;
+  }
+  return res;
+}
+
+static int64_t format_decimal(const __int128 value, const int32_t scale, char *buf)
+{
+  char digits[MAX_DECIMAL_PRECISION + 8];
+  int64_t digit_cnt = 0;
+  int64_t pos = 0;
+  unsigned __int128 abs_value = value < 0 ? -static_cast<unsigned __int128>(value)
+                                          : static_cast<unsigned __int128>(value);
+  do {
+    digits[digit_cnt++] = static_cast<char>('0' + static_cast<int>(abs_value % 10));
+    abs_value /= 10;
+  } while (abs_value > 0);
+  while (digit_cnt <= scale) {
+    digits[digit_cnt++] = '0';
+  }
+  if (value < 0) {
+    buf[pos++] = '-';
+  }
+  for (int64_t i = digit_cnt - 1; i >= scale; --i) {
+    buf[pos++] = digits[i];
+  }
+  if (scale > 0) {
+    buf[pos++] = '.';
+    for (int64_t i = scale - 1; i >= 0; --i) {
+      buf[pos++] = digits[i];
+    }
+  }
+  return pos;
+}
+
+/***************** ObParquetThriftDecoder *****************/
+
+int ObParquetThriftDecoder::read_varint(uint64_t &value)
+{
+  int ret = OB_SUCCESS;
+  bool is_end = false;
+  int64_t shift = 0;
+  value = 0;
+  while (OB_SUCC(ret) && !is_end) {
+    if (OB_UNLIKELY(pos_ >= len_ || shift > 63)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid thrift varint", K(ret), KPC(this));
+    } else {
+      const uint8_t byte = buf_[pos_++];
+      value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+      shift += 7;
+      is_end = (0 == (byte & 0x80));
+    }
+  }
+  return ret;
+}
+
+int ObParquetThriftDecoder::read_byte(int8_t &value)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(pos_ >= len_)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("unexpected end of thrift data", K(ret), KPC(this));
+  } else {
+    value = static_cast<int8_t>(buf_[pos_++]);
+  }
+  return ret;
+}
+
+int ObParquetThriftDecoder::read_i32(int32_t &value)
+{
+  int ret = OB_SUCCESS;
+  uint64_t v = 0;
+  if (OB_FAIL(read_varint(v))) {
+    LOG_WARN("fail to read varint", K(ret));
+  } else {
+    // zigzag
+    value = static_cast<int32_t>(static_cast<uint32_t>(v >> 1) ^ -static_cast<uint32_t>(v & 1));
+  }
+  return ret;
+}
+
+int ObParquetThriftDecoder::read_i64(int64_t &value)
+{
+  int ret = OB_SUCCESS;
+  uint64_t v = 0;
+  if (OB_FAIL(read_varint(v))) {
+    LOG_WARN("fail to read varint", K(ret));
+  } else {
+    value = static_cast<int64_t>((v >> 1) ^ -(v & 1));
+  }
+  return ret;
+}
+
+int ObParquetThriftDecoder::read_binary(ObString &value)
+{
+  int ret = OB_SUCCESS;
+  uint64_t len = 0;
+  if (OB_FAIL(read_varint(len))) {
+    LOG_WARN("fail to read binary length", K(ret));
+  } else if (OB_UNLIKELY(len > static_cast<uint64_t>(len_ - pos_))) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid thrift binary length", K(ret), K(len), KPC(this));
+  } else {
+    value.assign_ptr(reinterpret_cast<const char *>(buf_ + pos_), static_cast<int32_t>(len));
+    pos_ += len;
+  }
+  return ret;
+}
+
+int ObParquetThriftDecoder::read_field_begin(int16_t &last_field_id,
+                                             int16_t &field_id,
+                                             int8_t &field_type)
+{
+  int ret = OB_SUCCESS;
+  int8_t byte = 0;
+  if (OB_FAIL(read_byte(byte))) {
+    LOG_WARN("fail to read field header", K(ret));
+  } else if (CT_STOP == (byte & 0x0f)) {
+    field_type = CT_STOP;
+  } else {
+    const int16_t delta = static_cast<uint8_t>(byte) >> 4;
+    field_type = byte & 0x0f;
+    if (0 != delta) {
+      field_id = last_field_id + delta;
+    } else {
+      int32_t id = 0;
+      if (OB_FAIL(read_i32(id))) {
+        LOG_WARN("fail to read field id", K(ret));
+      } else {
+        field_id = static_cast<int16_t>(id);
+      }
+    }
+    last_field_id = field_id;
+  }
+  return ret;
+}
+
+int ObParquetThriftDecoder::read_list_begin(int8_t &elem_type, int64_t &size)
+{
+  int ret = OB_SUCCESS;
+  int8_t byte = 0;
+  if (OB_FAIL(read_byte(byte))) {
+    LOG_WARN("fail to read list header", K(ret));
+  } else {
+    elem_type = byte & 0x0f;
+    size = static_cast<uint8_t>(byte) >> 4;
+    if (15 == size) {
+      uint64_t v = 0;
+      if (OB_FAIL(read_varint(v))) {
+        LOG_WARN("fail to read list size", K(ret));
+      } else {
+        size = static_cast<int64_t>(v);
+      }
+    }
+    // every element takes one byte at least
+    if (OB_SUCC(ret) && OB_UNLIKELY(size < 0 || size > len_ - pos_)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid thrift list size", K(ret), K(size), KPC(this));
+    }
+  }
+  return ret;
+}
+
+int ObParquetThriftDecoder::skip(const int8_t type)
+{
+  int ret = OB_SUCCESS;
+  uint64_t v = 0;
+  int8_t byte = 0;
+  ObString str;
+  if (OB_UNLIKELY(++depth_ > MAX_NESTED_DEPTH)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("thrift data nested too deep", K(ret), KPC(this));
+  } else {
+    switch (type) {
+      case CT_BOOLEAN_TRUE:
+      case CT_BOOLEAN_FALSE:
+        // value of a boolean field is carried by its type
+        break;
+      case CT_BYTE:
+        ret = read_byte(byte);
+        break;
+      case CT_I16:
+      case CT_I32:
+      case CT_I64:
+        ret = read_varint(v);
+        break;
+      case CT_DOUBLE:
+        if (OB_UNLIKELY(len_ - pos_ < 8)) {
+          ret = OB_INVALID_DATA;
+        } else {
+          pos_ += 8;
+        }
+        break;
+      case CT_BINARY:
+        ret = read_binary(str);
+        break;
+      case CT_LIST:
+      case CT_SET: {
+        int8_t elem_type = CT_STOP;
+        int64_t size = 0;
+        if (OB_FAIL(read_list_begin(elem_type, size))) {
+          LOG_WARN("fail to read list header", K(ret));
+        }
+        for (int64_t i = 0; OB_SUCC(ret) && i < size; ++i) {
+          // boolean element of a list takes one byte
+          if (CT_BOOLEAN_TRUE == elem_type || CT_BOOLEAN_FALSE == elem_type) {
+            ret = read_byte(byte);
+          } else {
+            ret = skip(elem_type);
+          }
+        }
+        break;
+      }
+      case CT_MAP: {
+        int8_t kv_type = 0;
+        if (OB_FAIL(read_varint(v))) {
+          LOG_WARN("fail to read map size", K(ret));
+        } else if (OB_UNLIKELY(v > static_cast<uint64_t>(len_ - pos_))) {
+          ret = OB_INVALID_DATA;
+        } else if (v > 0 && OB_FAIL(read_byte(kv_type))) {
+          LOG_WARN("fail to read map types", K(ret));
+        }
+        for (uint64_t i = 0; OB_SUCC(ret) && i < v; ++i) {
+          if (OB_FAIL(skip(static_cast<uint8_t>(kv_type) >> 4))) {
+          } else if (OB_FAIL(skip(kv_type & 0x0f))) {
+          }
+        }
+        break;
+      }
+      case CT_STRUCT: {
+        int16_t last_field_id = 0;
+        int16_t field_id = 0;
+        int8_t field_type = CT_STOP;
+        bool is_end = false;
+        while (OB_SUCC(ret) && !is_end) {
+          if (OB_FAIL(read_field_begin(last_field_id, field_id, field_type))) {
+          } else if (CT_STOP == field_type) {
+            is_end = true;
+          } else {
+            ret = skip(field_type);
+          }
+        }
+        break;
+      }
+      default:
+        ret = OB_INVALID_DATA;
+        break;
+    }
+    if (OB_FAIL(ret)) {
+      LOG_WARN("fail to skip thrift value", K(ret), K(type), KPC(this));
+    }
+  }
+  --depth_;
+  return ret;
+}
+
+/***************** metadata *****************/
+
+#define PARSE_THRIFT_STRUCT_BEGIN(decoder)                                            \
+  int16_t last_field_id = 0;                                                          \
+  int16_t field_id = 0;                                                               \
+  int8_t field_type = TD::CT_STOP;                                                    \
+  bool is_end = false;                                                                \
+  while (OB_SUCC(ret) && !is_end) {                                                   \
+    if (OB_FAIL(decoder.read_field_begin(last_field_id, field_id, field_type))) {     \
+      LOG_WARN("fail to read thrift field", K(ret));                                  \
+    } else if (TD::CT_STOP == field_type) {                                           \
+      is_end = true;
+
+#define PARSE_THRIFT_STRUCT_END(decoder)                                              \
+    } else if (OB_FAIL(decoder.skip(field_type))) {                                   \
+      LOG_WARN("fail to skip thrift field", K(ret), K(field_id), K(field_type));      \
+    }                                                                                 \
+  }
+
+struct ObParquetSchemaElement
+{
+  ObParquetSchemaElement()
+    : type_(-1), type_length_(0), repetition_(ObParquetType::REQUIRED), name_(), num_children_(0),
+      converted_type_(ObParquetType::CONVERTED_NONE), scale_(0), precision_(0),
+      logical_type_(ObParquetType::LOGICAL_NONE), time_unit_(ObParquetType::UNIT_NONE),
+      is_signed_(true), is_adjusted_to_utc_(false) {}
+  TO_STRING_KV(K_(type), K_(name), K_(repetition), K_(num_children), K_(converted_type),
+               K_(logical_type));
+  int32_t type_;
+  int32_t type_length_;
+  int32_t repetition_;
+  ObString name_;
+  int32_t num_children_;
+  int32_t converted_type_;
+  int32_t scale_;
+  int32_t precision_;
+  int32_t logical_type_;
+  int32_t time_unit_;
+  bool is_signed_;
+  bool is_adjusted_to_utc_;
+};
+
+struct ObParquetPageHeader
+{
+  ObParquetPageHeader()
+    : type_(-1), uncompressed_page_size_(-1), compressed_page_size_(-1), num_values_(0),
+      encoding_(ObParquetType::PLAIN), def_level_encoding_(ObParquetType::RLE),
+      def_levels_byte_length_(0), rep_levels_byte_length_(0), is_compressed_(true) {}
+  TO_STRING_KV(K_(type), K_(uncompressed_page_size), K_(compressed_page_size), K_(num_values),
+               K_(encoding), K_(def_level_encoding), K_(def_levels_byte_length),
+               K_(rep_levels_byte_length), K_(is_compressed));
+  int32_t type_;
+  int32_t uncompressed_page_size_;
+  int32_t compressed_page_size_;
+  int32_t num_values_;
+  int32_t encoding_;
+  int32_t def_level_encoding_;
+  int32_t def_levels_byte_length_;
+  int32_t rep_levels_byte_length_;
+  bool is_compressed_;
+};
+
+static int parse_time_unit(TD &decoder, int32_t &time_unit)
+{
+  int ret = OB_SUCCESS;
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (TD::CT_STRUCT == field_type) {
+      time_unit = field_id;
+      ret = decoder.skip(field_type);
+  PARSE_THRIFT_STRUCT_END(decoder)
+  return ret;
+}
+
+static int parse_time_type(TD &decoder, ObParquetSchemaElement &element)
+{
+  int ret = OB_SUCCESS;
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (1 == field_id && (TD::CT_BOOLEAN_TRUE == field_type
+                                 || TD::CT_BOOLEAN_FALSE == field_type)) {
+      element.is_adjusted_to_utc_ = (TD::CT_BOOLEAN_TRUE == field_type);
+    } else if (2 == field_id && TD::CT_STRUCT == field_type) {
+      ret = parse_time_unit(decoder, element.time_unit_);
+  PARSE_THRIFT_STRUCT_END(decoder)
+  return ret;
+}
+
+static int parse_decimal_type(TD &decoder, ObParquetSchemaElement &element)
+{
+  int ret = OB_SUCCESS;
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (1 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(element.scale_);
+    } else if (2 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(element.precision_);
+  PARSE_THRIFT_STRUCT_END(decoder)
+  return ret;
+}
+
+static int parse_int_type(TD &decoder, ObParquetSchemaElement &element)
+{
+  int ret = OB_SUCCESS;
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (2 == field_id && (TD::CT_BOOLEAN_TRUE == field_type
+                                 || TD::CT_BOOLEAN_FALSE == field_type)) {
+      element.is_signed_ = (TD::CT_BOOLEAN_TRUE == field_type);
+  PARSE_THRIFT_STRUCT_END(decoder)
+  return ret;
+}
+
+static int parse_logical_type(TD &decoder, ObParquetSchemaElement &element)
+{
+  int ret = OB_SUCCESS;
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (TD::CT_STRUCT == field_type) {
+      element.logical_type_ = field_id;
+      switch (field_id) {
+        case ObParquetType::LOGICAL_DECIMAL:
+          ret = parse_decimal_type(decoder, element);
+          break;
+        case ObParquetType::LOGICAL_TIME:
+        case ObParquetType::LOGICAL_TIMESTAMP:
+          ret = parse_time_type(decoder, element);
+          break;
+        case ObParquetType::LOGICAL_INTEGER:
+          ret = parse_int_type(decoder, element);
+          break;
+        default:
+          ret = decoder.skip(field_type);
+          break;
+      }
+  PARSE_THRIFT_STRUCT_END(decoder)
+  return ret;
+}
+
+static int parse_schema_element(TD &decoder, ObParquetSchemaElement &element)
+{
+  int ret = OB_SUCCESS;
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (1 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(element.type_);
+    } else if (2 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(element.type_length_);
+    } else if (3 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(element.repetition_);
+    } else if (4 == field_id && TD::CT_BINARY == field_type) {
+      ret = decoder.read_binary(element.name_);
+    } else if (5 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(element.num_children_);
+    } else if (6 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(element.converted_type_);
+    } else if (7 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(element.scale_);
+    } else if (8 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(element.precision_);
+    } else if (10 == field_id && TD::CT_STRUCT == field_type) {
+      ret = parse_logical_type(decoder, element);
+  PARSE_THRIFT_STRUCT_END(decoder)
+  return ret;
+}
+
+static int parse_statistics(TD &decoder, const int32_t physical_type, ObParquetStatistics &stats)
+{
+  int ret = OB_SUCCESS;
+  ObString deprecated_min;
+  ObString deprecated_max;
+  ObString min;
+  ObString max;
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (1 == field_id && TD::CT_BINARY == field_type) {
+      ret = decoder.read_binary(deprecated_max);
+    } else if (2 == field_id && TD::CT_BINARY == field_type) {
+      ret = decoder.read_binary(deprecated_min);
+    } else if (3 == field_id && TD::CT_I64 == field_type) {
+      ret = decoder.read_i64(stats.null_count_);
+    } else if (5 == field_id && TD::CT_BINARY == field_type) {
+      ret = decoder.read_binary(max);
+    } else if (6 == field_id && TD::CT_BINARY == field_type) {
+      ret = decoder.read_binary(min);
+  PARSE_THRIFT_STRUCT_END(decoder)
+  if (OB_SUCC(ret)) {
+    if (!min.empty() && !max.empty()) {
+      stats.min_ = min;
+      stats.max_ = max;
+      stats.has_min_max_ = true;
+    } else if (!deprecated_min.empty() && !deprecated_max.empty()
+               && ObParquetType::BYTE_ARRAY != physical_type
+               && ObParquetType::FIXED_LEN_BYTE_ARRAY != physical_type) {
+      // the deprecated fields are compared as signed values, which is right for numbers only
+      stats.min_ = deprecated_min;
+      stats.max_ = deprecated_max;
+      stats.has_min_max_ = true;
+    }
+  }
+  return ret;
+}
+
+static int parse_column_meta(TD &decoder, ObParquetColumnChunkMeta &meta)
+{
+  int ret = OB_SUCCESS;
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (1 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(meta.physical_type_);
+    } else if (4 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(meta.codec_);
+    } else if (5 == field_id && TD::CT_I64 == field_type) {
+      ret = decoder.read_i64(meta.num_values_);
+    } else if (7 == field_id && TD::CT_I64 == field_type) {
+      ret = decoder.read_i64(meta.total_compressed_size_);
+    } else if (9 == field_id && TD::CT_I64 == field_type) {
+      ret = decoder.read_i64(meta.data_page_offset_);
+    } else if (11 == field_id && TD::CT_I64 == field_type) {
+      ret = decoder.read_i64(meta.dictionary_page_offset_);
+    } else if (12 == field_id && TD::CT_STRUCT == field_type) {
+      // statistics follows the type field
+      ret = parse_statistics(decoder, meta.physical_type_, meta.stats_);
+  PARSE_THRIFT_STRUCT_END(decoder)
+  return ret;
+}
+
+static int parse_column_chunk(TD &decoder, ObParquetColumnChunkMeta &meta)
+{
+  int ret = OB_SUCCESS;
+  bool has_meta = false;
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (1 == field_id && TD::CT_BINARY == field_type) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("column chunk in another file is not supported", K(ret));
+    } else if (3 == field_id && TD::CT_STRUCT == field_type) {
+      has_meta = true;
+      ret = parse_column_meta(decoder, meta);
+  PARSE_THRIFT_STRUCT_END(decoder)
+  if (OB_SUCC(ret) && OB_UNLIKELY(!has_meta)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("column chunk without meta data", K(ret));
+  }
+  return ret;
+}
+
+static int parse_row_group(TD &decoder,
+                           ObIArray<ObParquetColumnChunkMeta> &column_chunks,
+                           ObParquetRowGroupMeta &row_group)
+{
+  int ret = OB_SUCCESS;
+  row_group.column_offset_ = column_chunks.count();
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (1 == field_id && TD::CT_LIST == field_type) {
+      int8_t elem_type = TD::CT_STOP;
+      int64_t size = 0;
+      if (OB_FAIL(decoder.read_list_begin(elem_type, size))) {
+        LOG_WARN("fail to read column chunk list", K(ret));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < size; ++i) {
+        ObParquetColumnChunkMeta chunk;
+        if (OB_FAIL(parse_column_chunk(decoder, chunk))) {
+          LOG_WARN("fail to parse column chunk", K(ret), K(i));
+        } else if (OB_FAIL(column_chunks.push_back(chunk))) {
+          LOG_WARN("fail to push back", K(ret));
+        }
+      }
+      row_group.column_count_ = size;
+    } else if (3 == field_id && TD::CT_I64 == field_type) {
+      ret = decoder.read_i64(row_group.num_rows_);
+  PARSE_THRIFT_STRUCT_END(decoder)
+  return ret;
+}
+
+static int parse_data_page_header(TD &decoder, ObParquetPageHeader &header)
+{
+  int ret = OB_SUCCESS;
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (1 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(header.num_values_);
+    } else if (2 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(header.encoding_);
+    } else if (3 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(header.def_level_encoding_);
+  PARSE_THRIFT_STRUCT_END(decoder)
+  return ret;
+}
+
+static int parse_dictionary_page_header(TD &decoder, ObParquetPageHeader &header)
+{
+  int ret = OB_SUCCESS;
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (1 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(header.num_values_);
+    } else if (2 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(header.encoding_);
+  PARSE_THRIFT_STRUCT_END(decoder)
+  return ret;
+}
+
+static int parse_data_page_header_v2(TD &decoder, ObParquetPageHeader &header)
+{
+  int ret = OB_SUCCESS;
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (1 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(header.num_values_);
+    } else if (4 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(header.encoding_);
+    } else if (5 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(header.def_levels_byte_length_);
+    } else if (6 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(header.rep_levels_byte_length_);
+    } else if (7 == field_id && (TD::CT_BOOLEAN_TRUE == field_type
+                                 || TD::CT_BOOLEAN_FALSE == field_type)) {
+      header.is_compressed_ = (TD::CT_BOOLEAN_TRUE == field_type);
+  PARSE_THRIFT_STRUCT_END(decoder)
+  return ret;
+}
+
+static int parse_page_header(TD &decoder, ObParquetPageHeader &header)
+{
+  int ret = OB_SUCCESS;
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (1 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(header.type_);
+    } else if (2 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(header.uncompressed_page_size_);
+    } else if (3 == field_id && TD::CT_I32 == field_type) {
+      ret = decoder.read_i32(header.compressed_page_size_);
+    } else if (5 == field_id && TD::CT_STRUCT == field_type) {
+      ret = parse_data_page_header(decoder, header);
+    } else if (7 == field_id && TD::CT_STRUCT == field_type) {
+      ret = parse_dictionary_page_header(decoder, header);
+    } else if (8 == field_id && TD::CT_STRUCT == field_type) {
+      ret = parse_data_page_header_v2(decoder, header);
+  PARSE_THRIFT_STRUCT_END(decoder)
+  if (OB_SUCC(ret) && OB_UNLIKELY(header.uncompressed_page_size_ < 0
+                                  || header.compressed_page_size_ < 0
+                                  || header.num_values_ < 0)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid page header", K(ret), K(header));
+  }
+  return ret;
+}
+
+bool ObParquetColumnDesc::is_unsigned_int() const
+{
+  return (ObParquetType::LOGICAL_INTEGER == logical_type_ && !is_signed_)
+      || (converted_type_ >= ObParquetType::CONVERTED_UINT_8
+          && converted_type_ <= ObParquetType::CONVERTED_UINT_64);
+}
+
+bool ObParquetColumnDesc::is_decimal() const
+{
+  return ObParquetType::LOGICAL_DECIMAL == logical_type_
+      || ObParquetType::CONVERTED_DECIMAL == converted_type_;
+}
+
+bool ObParquetColumnDesc::is_date() const
+{
+  return ObParquetType::LOGICAL_DATE == logical_type_
+      || ObParquetType::CONVERTED_DATE == converted_type_;
+}
+
+bool ObParquetColumnDesc::is_time() const
+{
+  return ObParquetType::LOGICAL_TIME == logical_type_
+      || ObParquetType::CONVERTED_TIME_MILLIS == converted_type_
+      || ObParquetType::CONVERTED_TIME_MICROS == converted_type_;
+}
+
+bool ObParquetColumnDesc::is_timestamp() const
+{
+  return ObParquetType::LOGICAL_TIMESTAMP == logical_type_
+      || ObParquetType::CONVERTED_TIMESTAMP_MILLIS == converted_type_
+      || ObParquetType::CONVERTED_TIMESTAMP_MICROS == converted_type_;
+}
+
+bool ObParquetColumnDesc::is_plain_number() const
+{
+  return (ObParquetType::INT32 == physical_type_ || ObParquetType::INT64 == physical_type_
+          || ObParquetType::FLOAT == physical_type_ || ObParquetType::DOUBLE == physical_type_)
+      && !is_unsigned_int() && !is_decimal() && !is_date() && !is_time() && !is_timestamp();
+}
+
+template <typename T>
+static bool is_out_of_range(const ObItemType cmp_type, const T &min, const T &max, const T &value)
+{
+  bool out_of_range = false;
+  switch (cmp_type) {
+    case T_OP_EQ:
+      out_of_range = value < min || value > max;
+      break;
+    case T_OP_LT:
+      out_of_range = min >= value;
+      break;
+    case T_OP_LE:
+      out_of_range = min > value;
+      break;
+    case T_OP_GT:
+      out_of_range = max <= value;
+      break;
+    case T_OP_GE:
+      out_of_range = max < value;
+      break;
+    default:
+      break;
+  }
+  return out_of_range;
+}
+
+int ObParquetColumnChunkMeta::can_skip(const ObParquetColumnDesc &desc,
+                                       const ObItemType cmp_type,
+                                       const ObObjTypeClass value_tc,
+                                       const ObDatum &value,
+                                       bool &can_skip) const
+{
+  int ret = OB_SUCCESS;
+  const ObString &min = stats_.min_;
+  const ObString &max = stats_.max_;
+  can_skip = false;
+  if (value.is_null()) {
+    // compare with null is never true, which is left to the filter
+  } else if (num_values_ > 0 && stats_.null_count_ == num_values_) {
+    can_skip = true;
+  } else if (!stats_.has_min_max_) {
+    // no statistics
+  } else if (ObIntTC == value_tc && desc.is_plain_number()
+             && (ObParquetType::INT32 == physical_type_ || ObParquetType::INT64 == physical_type_)) {
+    const int64_t width = ObParquetType::INT32 == physical_type_ ? 4 : 8;
+    if (min.length() == width && max.length() == width) {
+      const int64_t min_v = 4 == width ? read_le<int32_t>(min.ptr()) : read_le<int64_t>(min.ptr());
+      const int64_t max_v = 4 == width ? read_le<int32_t>(max.ptr()) : read_le<int64_t>(max.ptr());
+      can_skip = is_out_of_range(cmp_type, min_v, max_v, value.get_int());
+    }
+  } else if (ObFloatTC == value_tc && desc.is_plain_number()
+             && ObParquetType::FLOAT == physical_type_) {
+    if (min.length() == sizeof(float) && max.length() == sizeof(float)) {
+      const float min_v = read_le<float>(min.ptr());
+      const float max_v = read_le<float>(max.ptr());
+      if (!std::isnan(min_v) && !std::isnan(max_v)) {
+        can_skip = is_out_of_range(cmp_type, min_v, max_v, value.get_float());
+      }
+    }
+  } else if (ObDoubleTC == value_tc && desc.is_plain_number()
+             && ObParquetType::DOUBLE == physical_type_) {
+    if (min.length() == sizeof(double) && max.length() == sizeof(double)) {
+      const double min_v = read_le<double>(min.ptr());
+      const double max_v = read_le<double>(max.ptr());
+      if (!std::isnan(min_v) && !std::isnan(max_v)) {
+        can_skip = is_out_of_range(cmp_type, min_v, max_v, value.get_double());
+      }
+    }
+  } else if (ObDateTC == value_tc && desc.is_date() && ObParquetType::INT32 == physical_type_) {
+    // both of parquet DATE and ObDate are days since 1970-01-01
+    if (min.length() == sizeof(int32_t) && max.length() == sizeof(int32_t)) {
+      const int32_t min_v = read_le<int32_t>(min.ptr());
+      const int32_t max_v = read_le<int32_t>(max.ptr());
+      can_skip = is_out_of_range(cmp_type, min_v, max_v, value.get_date());
+    }
+  }
+  return ret;
+}
+
+void ObParquetFileMeta::reset()
+{
+  num_rows_ = 0;
+  columns_.reuse();
+  row_groups_.reuse();
+  column_chunks_.reuse();
+}
+
+int ObParquetFileMeta::parse_schema(const ObIArray<ObParquetSchemaElement> &elements,
+                                    int64_t &idx,
+                                    const int32_t def_level,
+                                    const int32_t rep_level,
+                                    const int64_t depth)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(idx >= elements.count() || depth > ObParquetThriftDecoder::MAX_NESTED_DEPTH)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid parquet schema", K(ret), K(idx), K(depth), K(elements.count()));
+  } else {
+    const ObParquetSchemaElement &element = elements.at(idx++);
+    const int32_t cur_def_level = def_level + (ObParquetType::REQUIRED == element.repetition_ ? 0 : 1);
+    const int32_t cur_rep_level = rep_level + (ObParquetType::REPEATED == element.repetition_ ? 1 : 0);
+    if (element.num_children_ > 0) {
+      for (int64_t i = 0; OB_SUCC(ret) && i < element.num_children_; ++i) {
+        if (OB_FAIL(SMART_CALL(parse_schema(elements, idx, cur_def_level, cur_rep_level, depth + 1)))) {
+          LOG_WARN("fail to parse schema", K(ret));
+        }
+      }
+    } else if (OB_UNLIKELY(element.type_ < ObParquetType::BOOLEAN
+                           || element.type_ > ObParquetType::FIXED_LEN_BYTE_ARRAY)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid parquet leaf column type", K(ret), K(element));
+    } else {
+      ObParquetColumnDesc desc;
+      desc.name_ = element.name_;
+      desc.physical_type_ = element.type_;
+      desc.type_length_ = element.type_length_;
+      desc.converted_type_ = element.converted_type_;
+      desc.logical_type_ = element.logical_type_;
+      desc.time_unit_ = element.time_unit_;
+      desc.scale_ = element.scale_;
+      desc.precision_ = element.precision_;
+      desc.is_signed_ = element.is_signed_;
+      // the legacy converted timestamps are defined as adjusted to UTC, int96 ones are local
+      desc.is_adjusted_to_utc_ = ObParquetType::LOGICAL_TIMESTAMP == element.logical_type_
+                                 ? element.is_adjusted_to_utc_
+                                 : (ObParquetType::CONVERTED_TIMESTAMP_MILLIS == element.converted_type_
+                                    || ObParquetType::CONVERTED_TIMESTAMP_MICROS == element.converted_type_);
+      desc.max_def_level_ = cur_def_level;
+      desc.max_rep_level_ = cur_rep_level;
+      if (OB_FAIL(columns_.push_back(desc))) {
+        LOG_WARN("fail to push back column", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetFileMeta::parse(const char *buf, const int64_t len)
+{
+  int ret = OB_SUCCESS;
+  TD decoder(buf, len);
+  ObSEArray<ObParquetSchemaElement, 16> elements;
+  reset();
+  PARSE_THRIFT_STRUCT_BEGIN(decoder)
+    } else if (2 == field_id && TD::CT_LIST == field_type) {
+      int8_t elem_type = TD::CT_STOP;
+      int64_t size = 0;
+      if (OB_FAIL(decoder.read_list_begin(elem_type, size))) {
+        LOG_WARN("fail to read schema list", K(ret));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < size; ++i) {
+        ObParquetSchemaElement element;
+        if (OB_FAIL(parse_schema_element(decoder, element))) {
+          LOG_WARN("fail to parse schema element", K(ret));
+        } else if (OB_FAIL(elements.push_back(element))) {
+          LOG_WARN("fail to push back", K(ret));
+        }
+      }
+    } else if (3 == field_id && TD::CT_I64 == field_type) {
+      ret = decoder.read_i64(num_rows_);
+    } else if (4 == field_id && TD::CT_LIST == field_type) {
+      int8_t elem_type = TD::CT_STOP;
+      int64_t size = 0;
+      if (OB_FAIL(decoder.read_list_begin(elem_type, size))) {
+        LOG_WARN("fail to read row group list", K(ret));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < size; ++i) {
+        ObParquetRowGroupMeta row_group;
+        if (OB_FAIL(parse_row_group(decoder, column_chunks_, row_group))) {
+          LOG_WARN("fail to parse row group", K(ret), K(i));
+        } else if (OB_FAIL(row_groups_.push_back(row_group))) {
+          LOG_WARN("fail to push back", K(ret));
+        }
+      }
+  PARSE_THRIFT_STRUCT_END(decoder)
+
+  if (OB_FAIL(ret)) {
+  } else if (OB_UNLIKELY(elements.empty())) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("parquet schema is empty", K(ret));
+  } else {
+    // the first element is the root
+    int64_t idx = 1;
+    for (int64_t i = 0; OB_SUCC(ret) && i < elements.at(0).num_children_; ++i) {
+      if (OB_FAIL(parse_schema(elements, idx, 0, 0, 1))) {
+        LOG_WARN("fail to parse schema", K(ret));
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_groups_.count(); ++i) {
+      if (OB_UNLIKELY(row_groups_.at(i).column_count_ != columns_.count()
+                      || row_groups_.at(i).num_rows_ < 0)) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("invalid row group", K(ret), K(i), K(row_groups_.at(i)), K(columns_.count()));
+      }
+    }
+  }
+  return ret;
+}
+
+#undef PARSE_THRIFT_STRUCT_BEGIN
+#undef PARSE_THRIFT_STRUCT_END
+
+/***************** ObParquetRleDecoder *****************/
+
+void ObParquetRleDecoder::reset()
+{
+  pos_ = nullptr;
+  end_ = nullptr;
+  bit_width_ = 0;
+  rle_left_ = 0;
+  rle_value_ = 0;
+  bp_left_ = 0;
+  bp_data_ = nullptr;
+  bp_bit_offset_ = 0;
+}
+
+int ObParquetRleDecoder::init(const char *buf, const int64_t len, const int32_t bit_width)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_UNLIKELY(len < 0 || bit_width < 0 || bit_width > MAX_BIT_WIDTH)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid rle data", K(ret), K(len), K(bit_width));
+  } else {
+    pos_ = reinterpret_cast<const uint8_t *>(buf);
+    end_ = pos_ + len;
+    bit_width_ = bit_width;
+  }
+  return ret;
+}
+
+int ObParquetRleDecoder::next_run()
+{
+  int ret = OB_SUCCESS;
+  uint64_t header = 0;
+  int64_t shift = 0;
+  bool is_end = false;
+  while (OB_SUCC(ret) && !is_end) {
+    if (OB_UNLIKELY(pos_ >= end_ || shift > 63)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("rle data is exhausted", K(ret), KP_(pos), KP_(end));
+    } else {
+      header |= static_cast<uint64_t>(*pos_ & 0x7f) << shift;
+      is_end = (0 == (*pos_ & 0x80));
+      shift += 7;
+      ++pos_;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (header & 1) {
+    // bit-packed run of groups of 8 values, the group count of a corrupted header is bounded by
+    // the bytes left before multiplying, so that the run never goes beyond the data
+    const uint64_t groups = header >> 1;
+    const int64_t left_bytes = end_ - pos_;
+    int64_t bytes = 0;
+    int64_t values = 0;
+    if (0 == bit_width_) {
+      values = static_cast<int64_t>(MIN(groups, static_cast<uint64_t>(INT64_MAX / 8))) * 8;
+    } else if (groups > static_cast<uint64_t>(left_bytes / bit_width_)) {
+      // the last run may be truncated
+      bytes = left_bytes;
+      values = bytes * 8 / bit_width_;
+    } else {
+      bytes = static_cast<int64_t>(groups) * bit_width_;
+      values = static_cast<int64_t>(groups) * 8;
+    }
+    bp_data_ = pos_;
+    bp_bit_offset_ = 0;
+    bp_left_ = values;
+    pos_ += bytes;
+  } else {
+    const int64_t value_bytes = (bit_width_ + 7) / 8;
+    if (OB_UNLIKELY(value_bytes > end_ - pos_)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid rle run", K(ret), K(value_bytes));
+    } else {
+      rle_value_ = 0;
+      for (int64_t i = 0; i < value_bytes; ++i) {
+        rle_value_ |= static_cast<uint32_t>(pos_[i]) << (8 * i);
+      }
+      // keep a corrupted run inside the bit width, callers rely on it for levels
+      rle_value_ &= static_cast<uint32_t>((1ULL << bit_width_) - 1);
+      rle_left_ = static_cast<int64_t>(header >> 1);
+      pos_ += value_bytes;
+    }
+  }
+  return ret;
+}
+
+int ObParquetRleDecoder::get_batch(uint32_t *values, const int64_t count)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t mask = (1ULL << bit_width_) - 1;
+  int64_t got = 0;
+  while (OB_SUCC(ret) && got < count) {
+    if (rle_left_ > 0) {
+      const int64_t n = MIN(count - got, rle_left_);
+      for (int64_t i = 0; i < n; ++i) {
+        values[got + i] = rle_value_;
+      }
+      rle_left_ -= n;
+      got += n;
+    } else if (bp_left_ > 0) {
+      const int64_t n = MIN(count - got, bp_left_);
+      for (int64_t i = 0; i < n; ++i) {
+        const int64_t byte_offset = bp_bit_offset_ >> 3;
+        const int64_t shift = bp_bit_offset_ & 7;
+        const int64_t byte_cnt = (shift + bit_width_ + 7) >> 3;
+        uint64_t word = 0;
+        for (int64_t j = 0; j < byte_cnt; ++j) {
+          word |= static_cast<uint64_t>(bp_data_[byte_offset + j]) << (8 * j);
+        }
+        values[got + i] = static_cast<uint32_t>((word >> shift) & mask);
+        bp_bit_offset_ += bit_width_;
+      }
+      bp_left_ -= n;
+      got += n;
+    } else if (OB_FAIL(next_run())) {
+      LOG_WARN("fail to decode next run", K(ret), K(count), K(got));
+    }
+  }
+  return ret;
+}
+
+/***************** ObParquetColumnReader *****************/
+
+bool ObParquetColumnReader::can_read_as(const ObParquetColumnDesc &desc, const ObObjType type)
+{
+  bool can_read = false;
+  switch (type) {
+    case ObIntType:
+      // unsigned int64 may not fit
+      can_read = (ObParquetType::INT32 == desc.physical_type_
+                  && (desc.is_plain_number() || desc.is_unsigned_int()))
+                 || (ObParquetType::INT64 == desc.physical_type_ && desc.is_plain_number());
+      break;
+    case ObFloatType:
+      can_read = ObParquetType::FLOAT == desc.physical_type_;
+      break;
+    case ObDoubleType:
+      can_read = ObParquetType::DOUBLE == desc.physical_type_;
+      break;
+    case ObDateType:
+      can_read = ObParquetType::INT32 == desc.physical_type_ && desc.is_date();
+      break;
+    case ObDateTimeType:
+      can_read = ObParquetType::INT96 == desc.physical_type_
+                 || (ObParquetType::INT64 == desc.physical_type_ && desc.is_timestamp()
+                     && !desc.is_adjusted_to_utc_);
+      break;
+    case ObTimestampType:
+      can_read = ObParquetType::INT64 == desc.physical_type_ && desc.is_timestamp()
+                 && desc.is_adjusted_to_utc_;
+      break;
+    default:
+      break;
+  }
+  return can_read;
+}
+
+void ObParquetColumnReader::reset()
+{
+  allocator_ = nullptr;
+  datum_type_ = ObVarcharType;
+  datum_scale_ = -1;
+  tz_info_ = nullptr;
+  buf_ = nullptr;
+  len_ = 0;
+  pos_ = 0;
+  max_batch_size_ = 0;
+  page_left_values_ = 0;
+  value_encoding_ = ObParquetType::PLAIN;
+  def_decoder_.reset();
+  index_decoder_.reset();
+  plain_pos_ = nullptr;
+  plain_end_ = nullptr;
+  bool_bit_offset_ = 0;
+  dict_ = nullptr;
+  dict_count_ = 0;
+  def_levels_ = nullptr;
+  indexes_ = nullptr;
+}
+
+int ObParquetColumnReader::init(const ObParquetColumnDesc &desc,
+                                const ObParquetColumnChunkMeta &meta,
+                                const char *buf,
+                                const int64_t len,
+                                const int64_t max_batch_size,
+                                const ObObjType datum_type,
+                                const int16_t datum_scale,
+                                const ObTimeZoneInfo *tz_info,
+                                ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  desc_ = desc;
+  meta_ = meta;
+  buf_ = buf;
+  len_ = len;
+  allocator_ = &allocator;
+  datum_type_ = datum_type;
+  datum_scale_ = datum_scale;
+  tz_info_ = tz_info;
+  max_batch_size_ = MAX(1, max_batch_size);
+  if (OB_UNLIKELY(ObVarcharType != datum_type && !can_read_as(desc, datum_type))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("column can not be read as the type", K(ret), K(desc), K(datum_type));
+  } else if (OB_UNLIKELY(desc.max_rep_level_ > 0 || desc.max_def_level_ > 1)) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("nested parquet column is not supported", K(ret), K(desc));
+    LOG_USER_ERROR(OB_NOT_SUPPORTED, "nested parquet column");
+  } else if (OB_UNLIKELY(desc.is_decimal() && (desc.scale_ < 0 || desc.scale_ > MAX_DECIMAL_PRECISION))) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("decimal scale is not supported", K(ret), K(desc));
+  } else if (OB_ISNULL(def_levels_ = static_cast<uint32_t *>(
+                       allocator.alloc(sizeof(uint32_t) * max_batch_size_)))
+             || OB_ISNULL(indexes_ = static_cast<uint32_t *>(
+                          allocator.alloc(sizeof(uint32_t) * max_batch_size_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc memory", K(ret), K(max_batch_size_));
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::decompress(const char *src,
+                                      const int64_t src_len,
+                                      const int64_t dst_len,
+                                      const char *&dst)
+{
+  int ret = OB_SUCCESS;
+  ObCompressorType compressor_type = INVALID_COMPRESSOR;
+  ObCompressor *compressor = nullptr;
+  char *buf = nullptr;
+  int64_t data_len = 0;
+  switch (meta_.codec_) {
+    case ObParquetType::UNCOMPRESSED:
+      compressor_type = NONE_COMPRESSOR;
+      break;
+    case ObParquetType::SNAPPY:
+      compressor_type = SNAPPY_COMPRESSOR;
+      break;
+    case ObParquetType::ZSTD:
+      compressor_type = ZSTD_COMPRESSOR;
+      break;
+    case ObParquetType::LZ4_RAW:
+      compressor_type = LZ4_191_COMPRESSOR;
+      break;
+    default:
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("parquet compression codec is not supported", K(ret), K(meta_.codec_));
+      LOG_USER_ERROR(OB_NOT_SUPPORTED, "parquet compression codec other than snappy, zstd, lz4_raw");
+      break;
+  }
+  if (OB_FAIL(ret)) {
+  } else if (NONE_COMPRESSOR == compressor_type || 0 == dst_len) {
+    if (OB_UNLIKELY(src_len != dst_len)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid uncompressed page", K(ret), K(src_len), K(dst_len));
+    } else {
+      dst = src;
+    }
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(compressor_type, compressor))) {
+    LOG_WARN("fail to get compressor", K(ret), K(compressor_type));
+  } else if (OB_ISNULL(buf = static_cast<char *>(allocator_->alloc(dst_len)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc memory", K(ret), K(dst_len));
+  } else if (OB_FAIL(compressor->decompress(src, src_len, buf, dst_len, data_len))) {
+    LOG_WARN("fail to decompress page", K(ret), K(compressor_type), K(src_len), K(dst_len));
+  } else if (OB_UNLIKELY(data_len != dst_len)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("unexpected decompressed size", K(ret), K(data_len), K(dst_len));
+  } else {
+    dst = buf;
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::decode_dictionary(const char *data,
+                                             const int64_t data_len,
+                                             const int64_t num_values)
+{
+  int ret = OB_SUCCESS;
+  char *text_pos = nullptr;
+  plain_pos_ = data;
+  plain_end_ = data + data_len;
+  if (OB_UNLIKELY(ObParquetType::BOOLEAN == desc_.physical_type_)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("boolean column with dictionary", K(ret));
+  } else if (OB_UNLIKELY(num_values < 0 || num_values > data_len)) {
+    // every value other than boolean takes one byte at least
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid dictionary size", K(ret), K(num_values), K(data_len));
+  } else if (OB_ISNULL(dict_ = static_cast<ObDatum *>(
+                       allocator_->alloc(sizeof(ObDatum) * MAX(1, num_values))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc memory", K(ret), K(num_values));
+  } else if (need_text_buf() && OB_ISNULL(text_pos = static_cast<char *>(
+                                  allocator_->alloc(MAX_VALUE_TEXT_LEN * MAX(1, num_values))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc memory", K(ret), K(num_values));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < num_values; ++i) {
+      new (&dict_[i]) ObDatum();
+      if (OB_FAIL(decode_plain(dict_[i], text_pos))) {
+        LOG_WARN("fail to decode dictionary value", K(ret), K(i), K(num_values));
+      }
+    }
+    dict_count_ = num_values;
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::next_data_page()
+{
+  int ret = OB_SUCCESS;
+  bool found = false;
+  while (OB_SUCC(ret) && !found) {
+    ObParquetPageHeader header;
+    TD decoder(buf_ + pos_, len_ - pos_);
+    const char *data = nullptr;
+    const char *page = nullptr;
+    const char *values = nullptr;
+    int64_t values_len = 0;
+    if (OB_UNLIKELY(pos_ >= len_)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("no more page in column chunk", K(ret), KPC(this));
+    } else if (OB_FAIL(parse_page_header(decoder, header))) {
+      LOG_WARN("fail to parse page header", K(ret), KPC(this));
+    } else if (OB_UNLIKELY(header.compressed_page_size_ > len_ - pos_ - decoder.get_pos())) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("page exceeds column chunk", K(ret), K(header), KPC(this));
+    } else {
+      data = buf_ + pos_ + decoder.get_pos();
+      pos_ += decoder.get_pos() + header.compressed_page_size_;
+    }
+    if (OB_FAIL(ret)) {
+    } else if (ObParquetType::DICTIONARY_PAGE == header.type_) {
+      if (OB_UNLIKELY(ObParquetType::PLAIN != header.encoding_
+                      && ObParquetType::PLAIN_DICTIONARY != header.encoding_)) {
+        ret = OB_NOT_SUPPORTED;
+        LOG_WARN("dictionary encoding is not supported", K(ret), K(header));
+      } else if (OB_FAIL(decompress(data, header.compressed_page_size_,
+                                    header.uncompressed_page_size_, page))) {
+        LOG_WARN("fail to decompress dictionary page", K(ret));
+      } else if (OB_FAIL(decode_dictionary(page, header.uncompressed_page_size_, header.num_values_))) {
+        LOG_WARN("fail to decode dictionary", K(ret), K(header));
+      }
+    } else if (ObParquetType::DATA_PAGE == header.type_) {
+      if (OB_FAIL(decompress(data, header.compressed_page_size_,
+                             header.uncompressed_page_size_, page))) {
+        LOG_WARN("fail to decompress data page", K(ret));
+      } else {
+        values = page;
+        values_len = header.uncompressed_page_size_;
+        if (desc_.max_def_level_ > 0) {
+          int32_t levels_len = 0;
+          if (OB_UNLIKELY(ObParquetType::RLE != header.def_level_encoding_)) {
+            ret = OB_NOT_SUPPORTED;
+            LOG_WARN("definition level encoding is not supported", K(ret), K(header));
+          } else if (OB_UNLIKELY(values_len < 4
+                                 || (levels_len = read_le<int32_t>(values)) < 0
+                                 || levels_len > values_len - 4)) {
+            ret = OB_INVALID_DATA;
+            LOG_WARN("invalid definition levels", K(ret), K(levels_len), K(header));
+          } else if (OB_FAIL(def_decoder_.init(values + 4, levels_len, 1))) {
+            LOG_WARN("fail to init definition levels", K(ret));
+          } else {
+            values += 4 + levels_len;
+            values_len -= 4 + levels_len;
+          }
+        }
+        found = true;
+      }
+    } else if (ObParquetType::DATA_PAGE_V2 == header.type_) {
+      const int64_t levels_len = static_cast<int64_t>(header.rep_levels_byte_length_)
+                                 + header.def_levels_byte_length_;
+      if (OB_UNLIKELY(header.rep_levels_byte_length_ < 0 || header.def_levels_byte_length_ < 0
+                      || levels_len > header.compressed_page_size_
+                      || levels_len > header.uncompressed_page_size_)) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("invalid page v2 levels", K(ret), K(header));
+      } else if (desc_.max_def_level_ > 0
+                 && OB_FAIL(def_decoder_.init(data + header.rep_levels_byte_length_,
+                                              header.def_levels_byte_length_, 1))) {
+        LOG_WARN("fail to init definition levels", K(ret));
+      } else if (!header.is_compressed_) {
+        values = data + levels_len;
+        values_len = header.compressed_page_size_ - levels_len;
+        found = true;
+      } else if (OB_FAIL(decompress(data + levels_len,
+                                    header.compressed_page_size_ - levels_len,
+                                    header.uncompressed_page_size_ - levels_len,
+                                    values))) {
+        LOG_WARN("fail to decompress data page", K(ret));
+      } else {
+        values_len = header.uncompressed_page_size_ - levels_len;
+        found = true;
+      }
+    } else {
+      // skip index page
+    }
+
+    if (OB_SUCC(ret) && found) {
+      value_encoding_ = header.encoding_;
+      page_left_values_ = header.num_values_;
+      found = header.num_values_ > 0;
+      switch (header.encoding_) {
+        case ObParquetType::PLAIN:
+          plain_pos_ = values;
+          plain_end_ = values + values_len;
+          bool_bit_offset_ = 0;
+          break;
+        case ObParquetType::PLAIN_DICTIONARY:
+        case ObParquetType::RLE_DICTIONARY:
+          if (OB_ISNULL(dict_)) {
+            ret = OB_INVALID_DATA;
+            LOG_WARN("dictionary page is missing", K(ret), KPC(this));
+          } else if (values_len > 0) {
+            ret = index_decoder_.init(values + 1, values_len - 1, static_cast<uint8_t>(values[0]));
+          } else {
+            ret = index_decoder_.init(values, 0, 0);
+          }
+          break;
+        case ObParquetType::RLE:
+          if (OB_UNLIKELY(ObParquetType::BOOLEAN != desc_.physical_type_ || values_len < 4)) {
+            ret = OB_NOT_SUPPORTED;
+            LOG_WARN("rle encoding is not supported", K(ret), K(desc_), K(values_len));
+          } else {
+            ret = index_decoder_.init(values + 4, MIN(values_len - 4, read_le<int32_t>(values)), 1);
+          }
+          break;
+        default:
+          ret = OB_NOT_SUPPORTED;
+          LOG_WARN("parquet encoding is not supported", K(ret), K(header));
+          LOG_USER_ERROR(OB_NOT_SUPPORTED, "parquet encoding other than plain, dictionary and rle");
+          break;
+      }
+    }
+  }
+  return ret;
+}
+
+int64_t ObParquetColumnReader::get_value_width() const
+{
+  int64_t width = 0;
+  switch (desc_.physical_type_) {
+    case ObParquetType::INT32:
+    case ObParquetType::FLOAT:
+      width = 4;
+      break;
+    case ObParquetType::INT64:
+    case ObParquetType::DOUBLE:
+      width = 8;
+      break;
+    case ObParquetType::INT96:
+      width = 12;
+      break;
+    case ObParquetType::FIXED_LEN_BYTE_ARRAY:
+      width = desc_.type_length_;
+      break;
+    default:
+      break;
+  }
+  return width;
+}
+
+bool ObParquetColumnReader::need_text_buf() const
+{
+  bool need = true;
+  if (ObParquetType::BOOLEAN == desc_.physical_type_) {
+    need = false;
+  } else if (ObParquetType::BYTE_ARRAY == desc_.physical_type_
+             || ObParquetType::FIXED_LEN_BYTE_ARRAY == desc_.physical_type_) {
+    need = desc_.is_decimal();
+  }
+  return need;
+}
+
+int ObParquetColumnReader::render_decimal(const char *ptr,
+                                          const int64_t len,
+                                          ObDatum &datum,
+                                          char *&text_pos) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(len <= 0 || len > MAX_DECIMAL_BYTES)) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("decimal is too large", K(ret), K(len), K(desc_));
+  } else {
+    // big-endian two's complement
+    __int128 unscaled = static_cast<int8_t>(ptr[0]) < 0 ? -1 : 0;
+    for (int64_t i = 0; i < len; ++i) {
+      unscaled = static_cast<__int128>((static_cast<unsigned __int128>(unscaled) << 8)
+                                       | static_cast<uint8_t>(ptr[i]));
+    }
+    const int64_t text_len = format_decimal(unscaled, desc_.scale_, text_pos);
+    datum.set_string(text_pos, static_cast<uint32_t>(text_len));
+    text_pos += text_len;
+  }
+  return ret;
+}
+
+// microseconds since the epoch of an INT64 or INT96 timestamp
+int ObParquetColumnReader::get_timestamp_usec(const char *ptr, int64_t &usec) const
+{
+  int ret = OB_SUCCESS;
+  if (ObParquetType::INT96 == desc_.physical_type_) {
+    // nanoseconds of the day followed by the julian day
+    const int64_t nanos = read_le<int64_t>(ptr);
+    const int64_t julian_day = read_le<int32_t>(ptr + 8);
+    if (OB_UNLIKELY(nanos < 0 || nanos > USECS_PER_DAY * 1000
+                    || julian_day - JULIAN_DAY_OF_EPOCH > INT64_MAX / USECS_PER_DAY - 1
+                    || julian_day - JULIAN_DAY_OF_EPOCH < INT64_MIN / USECS_PER_DAY + 1)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid nanoseconds of int96 timestamp", K(ret), K(nanos), K(julian_day));
+    } else {
+      usec = (julian_day - JULIAN_DAY_OF_EPOCH) * USECS_PER_DAY + nanos / 1000;
+    }
+  } else {
+    const int64_t v = read_le<int64_t>(ptr);
+    usec = v;
+    if (ObParquetType::UNIT_MILLIS == desc_.time_unit_
+        || ObParquetType::CONVERTED_TIMESTAMP_MILLIS == desc_.converted_type_) {
+      if (OB_UNLIKELY(v > INT64_MAX / 1000 || v < INT64_MIN / 1000)) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("timestamp out of range", K(ret), K(v), K(desc_));
+      } else {
+        usec = v * 1000;
+      }
+    } else if (ObParquetType::UNIT_NANOS == desc_.time_unit_) {
+      usec = floor_div(v, 1000);
+    }
+  }
+  return ret;
+}
+
+// values of a typed datum are kept in slots of the text buffer, so that the datums never write
+// into the memory they happen to point to, which may be a dictionary value of the last batch
+int ObParquetColumnReader::decode_typed(const char *ptr, ObDatum &datum, char *&text_pos) const
+{
+  int ret = OB_SUCCESS;
+  datum.ptr_ = text_pos;
+  switch (datum_type_) {
+    case ObIntType:
+      if (ObParquetType::INT64 == desc_.physical_type_) {
+        datum.set_int(read_le<int64_t>(ptr));
+      } else if (desc_.is_unsigned_int()) {
+        datum.set_int(static_cast<uint32_t>(read_le<int32_t>(ptr)));
+      } else {
+        datum.set_int(read_le<int32_t>(ptr));
+      }
+      break;
+    case ObFloatType:
+      datum.set_float(read_le<float>(ptr));
+      break;
+    case ObDoubleType:
+      datum.set_double(read_le<double>(ptr));
+      break;
+    case ObDateType: {
+      const int32_t v = read_le<int32_t>(ptr);
+      if (OB_UNLIKELY(v < MIN_DATE_VAL || v > DATE_MAX_VAL)) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("date out of range", K(ret), K(v), K(desc_));
+      } else {
+        datum.set_date(v);
+      }
+      break;
+    }
+    case ObDateTimeType:
+    case ObTimestampType: {
+      int64_t usec = 0;
+      if (OB_FAIL(get_timestamp_usec(ptr, usec))) {
+        LOG_WARN("fail to get timestamp", K(ret), K(desc_));
+      } else if (FALSE_IT(ObTimeConverter::round_datetime(datum_scale_, usec))) {
+      } else if (OB_UNLIKELY(ObDateTimeType == datum_type_
+                             ? (usec < DATETIME_MIN_VAL || usec > DATETIME_MAX_VAL)
+                             : (usec < MYSQL_TIMESTAMP_MIN_VAL || usec > MYSQL_TIMESTAMP_MAX_VAL))) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("timestamp out of range", K(ret), K(usec), K(desc_), K_(datum_type));
+      } else {
+        datum.set_datetime(usec);
+      }
+      break;
+    }
+    default:
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected datum type", K(ret), K_(datum_type), K(desc_));
+      break;
+  }
+  if (OB_SUCC(ret)) {
+    text_pos += TYPED_VALUE_LEN;
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::render(const char *ptr, ObDatum &datum, char *&text_pos) const
+{
+  int ret = OB_SUCCESS;
+  int64_t text_len = 0;
+  switch (desc_.physical_type_) {
+    case ObParquetType::INT32: {
+      const int32_t v = read_le<int32_t>(ptr);
+      if (desc_.is_date()) {
+        ret = ObTimeConverter::date_to_str(v, text_pos, MAX_VALUE_TEXT_LEN, text_len);
+      } else if (desc_.is_time()) {
+        ret = ObTimeConverter::time_to_str(v * 1000LL, 6, text_pos, MAX_VALUE_TEXT_LEN, text_len);
+      } else if (desc_.is_decimal()) {
+        text_len = format_decimal(v, desc_.scale_, text_pos);
+      } else if (desc_.is_unsigned_int()) {
+        text_len = ObFastFormatInt::format_unsigned(static_cast<uint32_t>(v), text_pos);
+      } else {
+        text_len = ObFastFormatInt::format_signed(v, text_pos);
+      }
+      break;
+    }
+    case ObParquetType::INT64: {
+      const int64_t v = read_le<int64_t>(ptr);
+      if (desc_.is_timestamp() || desc_.is_time()) {
+        int64_t usec = 0;
+        if (OB_FAIL(get_timestamp_usec(ptr, usec))) {
+          LOG_WARN("fail to get timestamp", K(ret), K(desc_));
+        } else if (desc_.is_time()) {
+          ret = ObTimeConverter::time_to_str(usec, 6, text_pos, MAX_VALUE_TEXT_LEN, text_len);
+        } else {
+          // an instant is rendered in the session time zone, in which column_conv parses it
+          ret = ObTimeConverter::datetime_to_str(usec, desc_.is_adjusted_to_utc_ ? tz_info_ : NULL,
+                                                 ObString(), 6, text_pos, MAX_VALUE_TEXT_LEN,
+                                                 text_len);
+        }
+      } else if (desc_.is_decimal()) {
+        text_len = format_decimal(v, desc_.scale_, text_pos);
+      } else if (desc_.is_unsigned_int()) {
+        text_len = ObFastFormatInt::format_unsigned(static_cast<uint64_t>(v), text_pos);
+      } else {
+        text_len = ObFastFormatInt::format_signed(v, text_pos);
+      }
+      break;
+    }
+    case ObParquetType::INT96: {
+      int64_t usec = 0;
+      if (OB_FAIL(get_timestamp_usec(ptr, usec))) {
+        LOG_WARN("fail to get timestamp", K(ret), K(desc_));
+      } else {
+        ret = ObTimeConverter::datetime_to_str(usec, NULL, ObString(), 6, text_pos,
+                                               MAX_VALUE_TEXT_LEN, text_len);
+      }
+      break;
+    }
+    case ObParquetType::FLOAT:
+      ret = databuff_printf(text_pos, MAX_VALUE_TEXT_LEN, text_len, "%.9g", read_le<float>(ptr));
+      break;
+    case ObParquetType::DOUBLE:
+      ret = databuff_printf(text_pos, MAX_VALUE_TEXT_LEN, text_len, "%.17g", read_le<double>(ptr));
+      break;
+    default:
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected physical type", K(ret), K(desc_));
+      break;
+  }
+  if (OB_FAIL(ret)) {
+    LOG_WARN("fail to render value", K(ret), K(desc_));
+  } else {
+    datum.set_string(text_pos, static_cast<uint32_t>(text_len));
+    text_pos += text_len;
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::decode_plain(ObDatum &datum, char *&text_pos)
+{
+  int ret = OB_SUCCESS;
+  const int64_t left = plain_end_ - plain_pos_;
+  if (ObParquetType::BOOLEAN == desc_.physical_type_) {
+    if (OB_UNLIKELY((bool_bit_offset_ >> 3) >= left)) {
+      ret = OB_INVALID_DATA;
+    } else {
+      const bool v = (plain_pos_[bool_bit_offset_ >> 3] >> (bool_bit_offset_ & 7)) & 1;
+      datum.set_string(v ? BOOL_TRUE_TEXT : BOOL_FALSE_TEXT, 1);
+      ++bool_bit_offset_;
+    }
+  } else if (ObParquetType::BYTE_ARRAY == desc_.physical_type_) {
+    int32_t len = 0;
+    if (OB_UNLIKELY(left < 4 || (len = read_le<int32_t>(plain_pos_)) < 0 || len > left - 4)) {
+      ret = OB_INVALID_DATA;
+    } else if (desc_.is_decimal()) {
+      ret = render_decimal(plain_pos_ + 4, len, datum, text_pos);
+      plain_pos_ += 4 + len;
+    } else {
+      datum.set_string(plain_pos_ + 4, static_cast<uint32_t>(len));
+      plain_pos_ += 4 + len;
+    }
+  } else {
+    const int64_t width = get_value_width();
+    if (OB_UNLIKELY(width <= 0 || width > left)) {
+      ret = OB_INVALID_DATA;
+    } else if (is_typed()) {
+      ret = decode_typed(plain_pos_, datum, text_pos);
+    } else if (ObParquetType::FIXED_LEN_BYTE_ARRAY != desc_.physical_type_) {
+      ret = render(plain_pos_, datum, text_pos);
+    } else if (desc_.is_decimal()) {
+      ret = render_decimal(plain_pos_, width, datum, text_pos);
+    } else {
+      datum.set_string(plain_pos_, static_cast<uint32_t>(width));
+    }
+    plain_pos_ += width;
+  }
+  if (OB_FAIL(ret)) {
+    LOG_WARN("fail to decode plain value", K(ret), K(left), KPC(this));
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::decode_values(const int64_t count, ObDatum *datums, char *&text_pos)
+{
+  int ret = OB_SUCCESS;
+  const bool is_nullable = desc_.max_def_level_ > 0;
+  int64_t not_null_cnt = count;
+  if (is_nullable) {
+    if (OB_FAIL(def_decoder_.get_batch(def_levels_, count))) {
+      LOG_WARN("fail to decode definition levels", K(ret), K(count));
+    } else {
+      not_null_cnt = 0;
+      for (int64_t i = 0; i < count; ++i) {
+        not_null_cnt += def_levels_[i];
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (ObParquetType::PLAIN_DICTIONARY == value_encoding_
+             || ObParquetType::RLE_DICTIONARY == value_encoding_
+             || ObParquetType::RLE == value_encoding_) {
+    const bool is_dict = ObParquetType::RLE != value_encoding_;
+    if (OB_FAIL(index_decoder_.get_batch(indexes_, not_null_cnt))) {
+      LOG_WARN("fail to decode dictionary indexes", K(ret), K(not_null_cnt));
+    }
+    for (int64_t i = 0, k = 0; OB_SUCC(ret) && i < count; ++i) {
+      if (is_nullable && 0 == def_levels_[i]) {
+        datums[i].set_null();
+      } else if (!is_dict) {
+        datums[i].set_string(indexes_[k++] ? BOOL_TRUE_TEXT : BOOL_FALSE_TEXT, 1);
+      } else if (OB_UNLIKELY(indexes_[k] >= dict_count_)) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("dictionary index out of range", K(ret), K(indexes_[k]), K_(dict_count));
+      } else {
+        datums[i].set_datum(dict_[indexes_[k++]]);
+      }
+    }
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < count; ++i) {
+      if (is_nullable && 0 == def_levels_[i]) {
+        datums[i].set_null();
+      } else if (OB_FAIL(decode_plain(datums[i], text_pos))) {
+        LOG_WARN("fail to decode value", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::read(const int64_t count, ObDatum *datums, ObIAllocator &text_allocator)
+{
+  int ret = OB_SUCCESS;
+  char *text_pos = nullptr;
+  int64_t read_cnt = 0;
+  if (OB_ISNULL(buf_) || OB_ISNULL(datums)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("column reader is not inited", K(ret), KP(datums));
+  } else if (need_text_buf() && count > 0
+             && OB_ISNULL(text_pos = static_cast<char *>(
+                          text_allocator.alloc(MAX_VALUE_TEXT_LEN * count)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc memory", K(ret), K(count));
+  }
+  while (OB_SUCC(ret) && read_cnt < count) {
+    if (page_left_values_ <= 0 && OB_FAIL(next_data_page())) {
+      LOG_WARN("fail to load next page", K(ret));
+    } else {
+      const int64_t n = MIN(MIN(count - read_cnt, page_left_values_), max_batch_size_);
+      if (OB_FAIL(decode_values(n, datums + read_cnt, text_pos))) {
+        LOG_WARN("fail to decode values", K(ret), K(n));
+      } else {
+        read_cnt += n;
+        page_left_values_ -= n;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObParquetColumnReader::skip(const int64_t count, ObIAllocator &text_allocator)
+{
+  int ret = OB_SUCCESS;
+  int64_t left = count;
+  ObDatum *datums = nullptr;
+  while (OB_SUCC(ret) && left > 0) {
+    if (page_left_values_ <= 0 && OB_FAIL(next_data_page())) {
+      LOG_WARN("fail to load next page", K(ret));
+    } else if (left >= page_left_values_) {
+      left -= page_left_values_;
+      page_left_values_ = 0;
+    } else if (OB_ISNULL(datums) && OB_ISNULL(datums = static_cast<ObDatum *>(
+                                     text_allocator.alloc(sizeof(ObDatum) * max_batch_size_)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc memory", K(ret));
+    } else {
+      const int64_t n = MIN(left, max_batch_size_);
+      if (OB_FAIL(read(n, datums, text_allocator))) {
+        LOG_WARN("fail to read values", K(ret), K(n));
+      } else {
+        left -= n;
+      }
+    }
+  }
+  return ret;
+}
+
+}
+}
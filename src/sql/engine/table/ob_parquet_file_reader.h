@@ -0,0 +1,398 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_PARQUET_FILE_READER_H_
+#define OB_PARQUET_FILE_READER_H_
+
+#include "lib/string/ob_string.h"
+#include "lib/allocator/ob_allocator.h"
+#include "lib/container/ob_se_array.h"
+#include "common/object/ob_obj_type.h"
+#include "objit/common/ob_item_type.h"
+#include "share/datum/ob_datum.h"
+
+namespace oceanbase
+{
+namespace common
+{
+class ObTimeZoneInfo;
+}
+namespace sql
+{
+
+/*
+ * Self-contained decoder of the apache parquet file format used by the external table scan.
+ *
+ * Only the parts needed to read flat schemas are implemented:
+ *   - file metadata in thrift compact protocol (schema, row groups, column chunk statistics)
+ *   - data pages v1/v2 and dictionary pages
+ *   - PLAIN, PLAIN_DICTIONARY/RLE_DICTIONARY and RLE(boolean) encodings
+ *   - UNCOMPRESSED, SNAPPY, ZSTD and LZ4_RAW codecs
+ * Values of a column mapped directly from a file column of the same type are decoded into datums
+ * of the column type. Others are rendered as text the same way a csv field is, and column_conv of
+ * the external table casts them into the column type.
+ */
+class ObParquetType
+{
+public:
+  static const int64_t MAGIC_LEN = 4;
+  static const int64_t FOOTER_LEN = 8; // metadata length(4) + magic "PAR1"
+
+  enum PhysicalType
+  {
+    BOOLEAN = 0,
+    INT32 = 1,
+    INT64 = 2,
+    INT96 = 3,
+    FLOAT = 4,
+    DOUBLE = 5,
+    BYTE_ARRAY = 6,
+    FIXED_LEN_BYTE_ARRAY = 7,
+  };
+  enum ConvertedType
+  {
+    CONVERTED_NONE = -1,
+    CONVERTED_UTF8 = 0,
+    CONVERTED_DECIMAL = 5,
+    CONVERTED_DATE = 6,
+    CONVERTED_TIME_MILLIS = 7,
+    CONVERTED_TIME_MICROS = 8,
+    CONVERTED_TIMESTAMP_MILLIS = 9,
+    CONVERTED_TIMESTAMP_MICROS = 10,
+    CONVERTED_UINT_8 = 11,
+    CONVERTED_UINT_16 = 12,
+    CONVERTED_UINT_32 = 13,
+    CONVERTED_UINT_64 = 14,
+    CONVERTED_INT_8 = 15,
+    CONVERTED_INT_16 = 16,
+    CONVERTED_INT_32 = 17,
+    CONVERTED_INT_64 = 18,
+  };
+  // field id of the LogicalType union
+  enum LogicalType
+  {
+    LOGICAL_NONE = 0,
+    LOGICAL_STRING = 1,
+    LOGICAL_MAP = 2,
+    LOGICAL_LIST = 3,
+    LOGICAL_ENUM = 4,
+    LOGICAL_DECIMAL = 5,
+    LOGICAL_DATE = 6,
+    LOGICAL_TIME = 7,
+    LOGICAL_TIMESTAMP = 8,
+    LOGICAL_INTEGER = 10,
+    LOGICAL_UNKNOWN = 11,
+    LOGICAL_JSON = 12,
+    LOGICAL_BSON = 13,
+    LOGICAL_UUID = 14,
+  };
+  enum TimeUnit
+  {
+    UNIT_NONE = 0,
+    UNIT_MILLIS = 1,
+    UNIT_MICROS = 2,
+    UNIT_NANOS = 3,
+  };
+  enum Repetition
+  {
+    REQUIRED = 0,
+    OPTIONAL = 1,
+    REPEATED = 2,
+  };
+  enum Encoding
+  {
+    PLAIN = 0,
+    PLAIN_DICTIONARY = 2,
+    RLE = 3,
+    BIT_PACKED = 4,
+    DELTA_BINARY_PACKED = 5,
+    DELTA_LENGTH_BYTE_ARRAY = 6,
+    DELTA_BYTE_ARRAY = 7,
+    RLE_DICTIONARY = 8,
+    BYTE_STREAM_SPLIT = 9,
+  };
+  enum PageType
+  {
+    DATA_PAGE = 0,
+    INDEX_PAGE = 1,
+    DICTIONARY_PAGE = 2,
+    DATA_PAGE_V2 = 3,
+  };
+  enum Codec
+  {
+    UNCOMPRESSED = 0,
+    SNAPPY = 1,
+    GZIP = 2,
+    LZO = 3,
+    BROTLI = 4,
+    LZ4 = 5,
+    ZSTD = 6,
+    LZ4_RAW = 7,
+  };
+};
+
+// reader of the thrift compact protocol, just enough to decode parquet metadata
+class ObParquetThriftDecoder
+{
+public:
+  enum CompactType
+  {
+    CT_STOP = 0,
+    CT_BOOLEAN_TRUE = 1,
+    CT_BOOLEAN_FALSE = 2,
+    CT_BYTE = 3,
+    CT_I16 = 4,
+    CT_I32 = 5,
+    CT_I64 = 6,
+    CT_DOUBLE = 7,
+    CT_BINARY = 8,
+    CT_LIST = 9,
+    CT_SET = 10,
+    CT_MAP = 11,
+    CT_STRUCT = 12,
+  };
+  static const int64_t MAX_NESTED_DEPTH = 64;
+
+  ObParquetThriftDecoder(const char *buf, const int64_t len)
+    : buf_(reinterpret_cast<const uint8_t *>(buf)), len_(len), pos_(0), depth_(0) {}
+  // @field_type is CT_STOP at the end of a struct
+  int read_field_begin(int16_t &last_field_id, int16_t &field_id, int8_t &field_type);
+  int read_list_begin(int8_t &elem_type, int64_t &size);
+  int read_byte(int8_t &value);
+  int read_i32(int32_t &value);
+  int read_i64(int64_t &value);
+  int read_binary(common::ObString &value);
+  int skip(const int8_t type);
+  int64_t get_pos() const { return pos_; }
+  TO_STRING_KV(KP_(buf), K_(len), K_(pos), K_(depth));
+private:
+  int read_varint(uint64_t &value);
+private:
+  const uint8_t *buf_;
+  int64_t len_;
+  int64_t pos_;
+  int64_t depth_;
+};
+
+struct ObParquetStatistics
+{
+  ObParquetStatistics() : min_(), max_(), null_count_(-1), has_min_max_(false) {}
+  common::ObString min_;
+  common::ObString max_;
+  int64_t null_count_;
+  bool has_min_max_;
+  TO_STRING_KV(K_(null_count), K_(has_min_max), K(min_.length()), K(max_.length()));
+};
+
+struct ObParquetColumnDesc
+{
+  ObParquetColumnDesc()
+    : name_(), physical_type_(ObParquetType::BYTE_ARRAY), type_length_(0),
+      converted_type_(ObParquetType::CONVERTED_NONE), logical_type_(ObParquetType::LOGICAL_NONE),
+      time_unit_(ObParquetType::UNIT_NONE), scale_(0), precision_(0), is_signed_(true),
+      is_adjusted_to_utc_(false), max_def_level_(0), max_rep_level_(0) {}
+  bool is_unsigned_int() const;
+  bool is_decimal() const;
+  bool is_date() const;
+  bool is_time() const;
+  bool is_timestamp() const;
+  // plain integer or floating number, whose statistics can be compared with a column value
+  bool is_plain_number() const;
+  TO_STRING_KV(K_(name), K_(physical_type), K_(type_length), K_(converted_type), K_(logical_type),
+               K_(time_unit), K_(scale), K_(precision), K_(is_signed), K_(is_adjusted_to_utc),
+               K_(max_def_level), K_(max_rep_level));
+
+  common::ObString name_;
+  int32_t physical_type_;
+  int32_t type_length_;
+  int32_t converted_type_;
+  int32_t logical_type_;
+  int32_t time_unit_;
+  int32_t scale_;
+  int32_t precision_;
+  bool is_signed_;
+  // timestamps are instants in UTC rather than local date times
+  bool is_adjusted_to_utc_;
+  int32_t max_def_level_;
+  int32_t max_rep_level_;
+};
+
+struct ObParquetColumnChunkMeta
+{
+  ObParquetColumnChunkMeta()
+    : physical_type_(ObParquetType::BYTE_ARRAY), codec_(ObParquetType::UNCOMPRESSED), num_values_(0),
+      total_compressed_size_(0), data_page_offset_(-1), dictionary_page_offset_(-1), stats_() {}
+  int64_t get_start_offset() const
+  {
+    return dictionary_page_offset_ > 0 && dictionary_page_offset_ < data_page_offset_
+        ? dictionary_page_offset_ : data_page_offset_;
+  }
+  /*
+   * Whether no row of the chunk can satisfy `value_of_column @cmp_type @value`, decided by the
+   * min/max statistics. Only integer, floating number and date columns are checked.
+   */
+  int can_skip(const ObParquetColumnDesc &desc,
+               const ObItemType cmp_type,
+               const common::ObObjTypeClass value_tc,
+               const common::ObDatum &value,
+               bool &can_skip) const;
+  TO_STRING_KV(K_(physical_type), K_(codec), K_(num_values), K_(total_compressed_size),
+               K_(data_page_offset), K_(dictionary_page_offset), K_(stats));
+
+  int32_t physical_type_;
+  int32_t codec_;
+  int64_t num_values_;
+  int64_t total_compressed_size_;
+  int64_t data_page_offset_;
+  int64_t dictionary_page_offset_;
+  ObParquetStatistics stats_;
+};
+
+struct ObParquetRowGroupMeta
+{
+  ObParquetRowGroupMeta() : num_rows_(0), column_offset_(0), column_count_(0) {}
+  TO_STRING_KV(K_(num_rows), K_(column_offset), K_(column_count));
+  int64_t num_rows_;
+  int64_t column_offset_; // the first chunk of the row group in ObParquetFileMeta::column_chunks_
+  int64_t column_count_;
+};
+
+struct ObParquetSchemaElement;
+class ObParquetFileMeta
+{
+public:
+  ObParquetFileMeta() : num_rows_(0) {}
+  void reset();
+  // @buf is the serialized FileMetaData, strings of the meta still point into it.
+  int parse(const char *buf, const int64_t len);
+  int64_t get_column_count() const { return columns_.count(); }
+  int64_t get_row_group_count() const { return row_groups_.count(); }
+  const ObParquetColumnDesc &get_column(const int64_t idx) const { return columns_.at(idx); }
+  const ObParquetRowGroupMeta &get_row_group(const int64_t idx) const { return row_groups_.at(idx); }
+  const ObParquetColumnChunkMeta &get_column_chunk(const int64_t row_group_idx,
+                                                   const int64_t column_idx) const
+  {
+    return column_chunks_.at(row_groups_.at(row_group_idx).column_offset_ + column_idx);
+  }
+  int64_t get_num_rows() const { return num_rows_; }
+  TO_STRING_KV(K_(num_rows), K_(columns), K_(row_groups));
+private:
+  int parse_schema(const common::ObIArray<ObParquetSchemaElement> &elements,
+                   int64_t &idx,
+                   const int32_t def_level,
+                   const int32_t rep_level,
+                   const int64_t depth);
+private:
+  int64_t num_rows_;
+  common::ObSEArray<ObParquetColumnDesc, 16> columns_;
+  common::ObSEArray<ObParquetRowGroupMeta, 4> row_groups_;
+  common::ObSEArray<ObParquetColumnChunkMeta, 64> column_chunks_;
+};
+
+// decoder of the RLE / bit-packing hybrid encoding, used by levels and dictionary indices
+class ObParquetRleDecoder
+{
+public:
+  ObParquetRleDecoder() { reset(); }
+  void reset();
+  int init(const char *buf, const int64_t len, const int32_t bit_width);
+  int get_batch(uint32_t *values, const int64_t count);
+private:
+  int next_run();
+private:
+  const uint8_t *pos_;
+  const uint8_t *end_;
+  int32_t bit_width_;
+  int64_t rle_left_;
+  uint32_t rle_value_;
+  int64_t bp_left_;
+  const uint8_t *bp_data_;
+  int64_t bp_bit_offset_;
+};
+
+/*
+ * Reads the values of one column chunk. The whole chunk is loaded into @buf by the caller and
+ * must stay valid, as well as the allocator, until the values read are consumed.
+ */
+class ObParquetColumnReader
+{
+public:
+  // text buffer reserved for each rendered value
+  static const int64_t MAX_VALUE_TEXT_LEN = 64;
+
+  // whether values of @desc can be decoded into datums of @type without column_conv
+  static bool can_read_as(const ObParquetColumnDesc &desc, const common::ObObjType type);
+
+  ObParquetColumnReader() { reset(); }
+  void reset();
+  /*
+   * Values are decoded into datums of @datum_type rounded to @datum_scale, which is checked by
+   * can_read_as(), or rendered as text if it is ObVarcharType. Timestamps adjusted to UTC are
+   * rendered in @tz_info.
+   */
+  int init(const ObParquetColumnDesc &desc,
+           const ObParquetColumnChunkMeta &meta,
+           const char *buf,
+           const int64_t len,
+           const int64_t max_batch_size,
+           const common::ObObjType datum_type,
+           const int16_t datum_scale,
+           const common::ObTimeZoneInfo *tz_info,
+           common::ObIAllocator &allocator);
+  bool is_typed() const { return common::ObVarcharType != datum_type_; }
+  // read next @count values, values of the batch are allocated from @text_allocator
+  int read(const int64_t count, common::ObDatum *datums, common::ObIAllocator &text_allocator);
+  int skip(const int64_t count, common::ObIAllocator &text_allocator);
+  TO_STRING_KV(K_(desc), K_(meta), K_(len), K_(pos), K_(datum_type), K_(datum_scale),
+               K_(page_left_values), K_(value_encoding), K_(dict_count));
+private:
+  int next_data_page();
+  int decompress(const char *src, const int64_t src_len, const int64_t dst_len, const char *&dst);
+  int decode_dictionary(const char *data, const int64_t data_len, const int64_t num_values);
+  int decode_values(const int64_t count, common::ObDatum *datums, char *&text_pos);
+  int decode_plain(common::ObDatum &datum, char *&text_pos);
+  int decode_typed(const char *ptr, common::ObDatum &datum, char *&text_pos) const;
+  int get_timestamp_usec(const char *ptr, int64_t &usec) const;
+  int render(const char *ptr, common::ObDatum &datum, char *&text_pos) const;
+  int render_decimal(const char *ptr, const int64_t len, common::ObDatum &datum, char *&text_pos) const;
+  int64_t get_value_width() const;
+  bool need_text_buf() const;
+private:
+  ObParquetColumnDesc desc_;
+  ObParquetColumnChunkMeta meta_;
+  common::ObIAllocator *allocator_;
+  common::ObObjType datum_type_;
+  int16_t datum_scale_;
+  const common::ObTimeZoneInfo *tz_info_;
+  const char *buf_;
+  int64_t len_;
+  int64_t pos_;
+  int64_t max_batch_size_;
+  // current data page
+  int64_t page_left_values_;
+  int32_t value_encoding_;
+  ObParquetRleDecoder def_decoder_;
+  ObParquetRleDecoder index_decoder_;
+  const char *plain_pos_;
+  const char *plain_end_;
+  int64_t bool_bit_offset_;
+  // decoded dictionary values, referenced by the datums read
+  common::ObDatum *dict_;
+  int64_t dict_count_;
+  uint32_t *def_levels_;
+  uint32_t *indexes_;
+};
+
+}
+}
+
+#endif // OB_PARQUET_FILE_READER_H_
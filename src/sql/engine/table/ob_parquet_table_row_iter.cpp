@@ -0,0 +1,647 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+#include "ob_parquet_table_row_iter.h"
+
+#include "sql/engine/expr/ob_expr_column_conv.h"
+#include "sql/session/ob_sql_session_info.h"
+#include "share/external_table/ob_external_table_utils.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+namespace sql
+{
+
+static const char PARQUET_MAGIC[] = "PAR1";
+
+ObParquetTableRowIterator::~ObParquetTableRowIterator()
+{
+  if (nullptr != bit_vector_cache_) {
+    allocator_.free(bit_vector_cache_);
+  }
+}
+
+int ObParquetTableRowIterator::init_exprs(const storage::ObTableScanParam *scan_param)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(scan_param)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("scan param is null", K(ret));
+  } else {
+    if (scan_param->column_ids_.count() != scan_param->output_exprs_->count()) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("column ids not equal to access expr", K(ret));
+    }
+    for (int i = 0; OB_SUCC(ret) && i < scan_param->column_ids_.count(); i++) {
+      ObExpr *cur_expr = scan_param->output_exprs_->at(i);
+      switch (scan_param->column_ids_.at(i)) {
+        case OB_HIDDEN_LINE_NUMBER_COLUMN_ID:
+          line_number_expr_ = cur_expr;
+          break;
+        case OB_HIDDEN_FILE_ID_COLUMN_ID:
+          file_id_expr_ = cur_expr;
+          break;
+        default:
+          OZ (column_exprs_.push_back(cur_expr));
+          break;
+      }
+    }
+    if (OB_SUCC(ret) && column_exprs_.count() != scan_param->ext_column_convert_exprs_->count()) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("column expr not equal to convert convert expr", K(ret),
+               K(column_exprs_), KPC(scan_param->ext_column_convert_exprs_));
+    }
+    for (int i = 0; OB_SUCC(ret) && i < scan_param->ext_file_column_exprs_->count(); i++) {
+      if (OB_UNLIKELY(scan_param->ext_file_column_exprs_->at(i)->extra_ < 1)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("invalid file column expr", K(ret), K(i));
+      } else {
+        OZ (column_readers_.push_back(ObParquetColumnReader()));
+        OZ (column_exists_.push_back(false));
+      }
+    }
+  }
+  return ret;
+}
+
+// the file column of a table column defined as `metadata$filecolN` with an optional cast
+int ObParquetTableRowIterator::get_file_column_leaf_idx(const ObExpr *convert_expr,
+                                                        int64_t &leaf_idx) const
+{
+  int ret = OB_SUCCESS;
+  const ObExpr *value_expr = NULL;
+  leaf_idx = -1;
+  if (OB_ISNULL(convert_expr)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("convert expr is null", K(ret));
+  } else if (T_FUN_COLUMN_CONV == convert_expr->type_
+             && convert_expr->arg_cnt_ > ObExprColumnConv::VALUE_EXPR) {
+    value_expr = convert_expr->args_[ObExprColumnConv::VALUE_EXPR];
+    while (OB_NOT_NULL(value_expr) && T_FUN_SYS_CAST == value_expr->type_
+           && value_expr->arg_cnt_ > 0) {
+      value_expr = value_expr->args_[0];
+    }
+    if (OB_NOT_NULL(value_expr) && T_PSEUDO_EXTERNAL_FILE_COL == value_expr->type_
+        && value_expr->extra_ >= 1) {
+      leaf_idx = static_cast<int64_t>(value_expr->extra_) - 1;
+    }
+  }
+  return ret;
+}
+
+// the number of references to @target in the expr tree of @root
+static int64_t get_expr_ref_count(const ObExpr *root, const ObExpr *target)
+{
+  int64_t count = 0;
+  if (root == target) {
+    count = 1;
+  } else if (OB_NOT_NULL(root)) {
+    for (int64_t i = 0; i < root->arg_cnt_; ++i) {
+      count += get_expr_ref_count(root->args_[i], target);
+    }
+  }
+  return count;
+}
+
+/*
+ * Pick columns whose column_conv only casts a file column into the column type, the casts and
+ * accuracy check of column_conv are done by the reader for the types below. The file column must
+ * not be used by other columns, whose column_conv still needs the text.
+ */
+int ObParquetTableRowIterator::init_direct_columns(const storage::ObTableScanParam *scan_param)
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray &file_column_exprs = *(scan_param->ext_file_column_exprs_);
+  const ExprFixedArray &convert_exprs = *(scan_param->ext_column_convert_exprs_);
+  for (int64_t i = 0; OB_SUCC(ret) && i < file_column_exprs.count(); ++i) {
+    OZ (direct_column_idxs_.push_back(-1));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < column_exprs_.count(); ++i) {
+    OZ (direct_reader_idxs_.push_back(-1));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && !lib::is_oracle_mode() && i < column_exprs_.count(); ++i) {
+    const ObDatumMeta &meta = column_exprs_.at(i)->datum_meta_;
+    const ObExpr *convert_expr = convert_exprs.at(i);
+    const ObExpr *value_expr = NULL;
+    bool is_supported = false;
+    switch (meta.type_) {
+      case ObIntType:
+      case ObDateType:
+      case ObDateTimeType:
+      case ObTimestampType:
+        is_supported = true;
+        break;
+      case ObFloatType:
+      case ObDoubleType:
+        // float(M,D) is rounded by column_conv
+        is_supported = meta.scale_ < 0;
+        break;
+      default:
+        break;
+    }
+    if (!is_supported || OB_ISNULL(convert_expr) || T_FUN_COLUMN_CONV != convert_expr->type_
+        || convert_expr->arg_cnt_ <= ObExprColumnConv::VALUE_EXPR) {
+    } else {
+      value_expr = convert_expr->args_[ObExprColumnConv::VALUE_EXPR];
+      while (is_supported && OB_NOT_NULL(value_expr) && T_FUN_SYS_CAST == value_expr->type_
+             && value_expr->arg_cnt_ > 0) {
+        // a cast into another type changes the value
+        is_supported = meta.type_ == value_expr->datum_meta_.type_;
+        value_expr = value_expr->args_[0];
+      }
+    }
+    for (int64_t j = 0; is_supported && j < file_column_exprs.count(); ++j) {
+      if (file_column_exprs.at(j) == value_expr) {
+        int64_t ref_count = 0;
+        for (int64_t k = 0; k < convert_exprs.count(); ++k) {
+          ref_count += get_expr_ref_count(convert_exprs.at(k), value_expr);
+        }
+        if (1 == ref_count) {
+          direct_column_idxs_.at(j) = i;
+          direct_reader_idxs_.at(i) = j;
+        }
+      }
+    }
+  }
+  LOG_DEBUG("parquet direct columns", K(ret), K(direct_column_idxs_), K(direct_reader_idxs_));
+  return ret;
+}
+
+bool ObParquetTableRowIterator::is_direct_column(const int64_t column_idx) const
+{
+  const int64_t reader_idx = direct_reader_idxs_.at(column_idx);
+  return reader_idx >= 0 && column_readers_.at(reader_idx).is_typed();
+}
+
+/*
+ * Pick filters like `c1 > 10` whose column is read from a file column without any computation.
+ * Row groups are skipped by the min/max statistics of the file column, while the filters are
+ * still applied by the table scan operator.
+ */
+int ObParquetTableRowIterator::init_skip_filters(const storage::ObTableScanParam *scan_param)
+{
+  int ret = OB_SUCCESS;
+  const ObExprPtrIArray *filters = scan_param->op_filters_;
+  for (int64_t i = 0; OB_SUCC(ret) && OB_NOT_NULL(filters) && i < filters->count(); ++i) {
+    const ObExpr *filter = filters->at(i);
+    SkipFilter skip_filter;
+    int64_t column_idx = -1;
+    if (OB_ISNULL(filter)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("filter is null", K(ret), K(i));
+    } else if (2 != filter->arg_cnt_
+               || (T_OP_EQ != filter->type_ && T_OP_LT != filter->type_
+                   && T_OP_LE != filter->type_ && T_OP_GT != filter->type_
+                   && T_OP_GE != filter->type_)) {
+      // not supported
+    } else {
+      skip_filter.cmp_type_ = filter->type_;
+      for (int64_t j = 0; j < column_exprs_.count(); ++j) {
+        if (column_exprs_.at(j) == filter->args_[0] && filter->args_[1]->is_const_expr()) {
+          column_idx = j;
+          skip_filter.value_expr_ = filter->args_[1];
+        } else if (column_exprs_.at(j) == filter->args_[1] && filter->args_[0]->is_const_expr()) {
+          // `10 < c1` is the same as `c1 > 10`
+          column_idx = j;
+          skip_filter.value_expr_ = filter->args_[0];
+          switch (filter->type_) {
+            case T_OP_LT: skip_filter.cmp_type_ = T_OP_GT; break;
+            case T_OP_LE: skip_filter.cmp_type_ = T_OP_GE; break;
+            case T_OP_GT: skip_filter.cmp_type_ = T_OP_LT; break;
+            case T_OP_GE: skip_filter.cmp_type_ = T_OP_LE; break;
+            default: break;
+          }
+        }
+      }
+    }
+    if (OB_SUCC(ret) && column_idx >= 0) {
+      const ObObjType column_type = column_exprs_.at(column_idx)->datum_meta_.type_;
+      // a column of narrower types may truncate values of the file in non-strict mode
+      if ((ObIntType == column_type || ObFloatType == column_type
+           || ObDoubleType == column_type || ObDateType == column_type)
+          && column_type == skip_filter.value_expr_->datum_meta_.type_) {
+        skip_filter.value_tc_ = ob_obj_type_class(column_type);
+        if (OB_FAIL(get_file_column_leaf_idx(scan_param->ext_column_convert_exprs_->at(column_idx),
+                                             skip_filter.column_leaf_idx_))) {
+          LOG_WARN("fail to get file column", K(ret), K(column_idx));
+        } else if (skip_filter.column_leaf_idx_ >= 0
+                   && OB_FAIL(skip_filters_.push_back(skip_filter))) {
+          LOG_WARN("fail to push back", K(ret));
+        }
+      }
+    }
+  }
+  LOG_DEBUG("parquet skip filters", K(ret), K(skip_filters_));
+  return ret;
+}
+
+int ObParquetTableRowIterator::init(const storage::ObTableScanParam *scan_param)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(scan_param)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("scan param is null", K(ret));
+  } else {
+    lib::ObMemAttr attr(scan_param->tenant_id_, "ParquetRowIter");
+    allocator_.set_attr(attr);
+    file_allocator_.set_attr(attr);
+    row_group_allocator_.set_attr(attr);
+    batch_allocator_.set_attr(attr);
+    OZ (ObExternalTableRowIterator::init(scan_param));
+    OZ (init_exprs(scan_param));
+    OZ (init_skip_filters(scan_param));
+    OZ (init_direct_columns(scan_param));
+    OZ (data_access_driver_.init(scan_param_->external_file_location_, scan_param->external_file_access_info_));
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::get_next_file_and_line_number(const int64_t task_idx,
+                                                             ObString &file_url,
+                                                             int64_t &file_id,
+                                                             int64_t &start_line,
+                                                             int64_t &end_line)
+{
+  int ret = OB_SUCCESS;
+  if (task_idx >= scan_param_->key_ranges_.count()) {
+    ret = OB_ITER_END;
+  } else if (OB_FAIL(ObExternalTableUtils::resolve_line_number_range(
+                                                              scan_param_->key_ranges_.at(task_idx),
+                                                              ObExternalTableUtils::LINE_NUMBER,
+                                                              start_line,
+                                                              end_line))) {
+    LOG_WARN("failed to resolve range in external table", K(ret));
+  } else {
+    file_url = scan_param_->key_ranges_.at(task_idx).get_start_key().get_obj_ptr()[ObExternalTableUtils::FILE_URL].get_string();
+    file_id = scan_param_->key_ranges_.at(task_idx).get_start_key().get_obj_ptr()[ObExternalTableUtils::FILE_ID].get_int();
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::read_fully(char *buf, const int64_t len, const int64_t offset)
+{
+  int ret = OB_SUCCESS;
+  int64_t total_read = 0;
+  while (OB_SUCC(ret) && total_read < len) {
+    int64_t read_size = 0;
+    if (OB_FAIL(data_access_driver_.pread(buf + total_read, len - total_read,
+                                          offset + total_read, read_size))) {
+      LOG_WARN("fail to read file", K(ret), K(url_), K(len), K(offset), K(total_read));
+    } else if (OB_UNLIKELY(read_size <= 0)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("unexpected end of file", K(ret), K(url_), K(len), K(offset), K(total_read));
+    } else {
+      total_read += read_size;
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::open_next_file()
+{
+  int ret = OB_SUCCESS;
+  ObString location = scan_param_->external_file_location_;
+
+  if (data_access_driver_.is_opened()) {
+    data_access_driver_.close();
+  }
+  file_meta_.reset();
+  row_group_allocator_.reuse();
+  file_allocator_.reuse();
+
+  do {
+    ObString file_url;
+    int64_t file_id = 0;
+    int64_t start_line = 0;
+    int64_t end_line = 0;
+    int64_t task_idx = state_.file_idx_++;
+    url_.reuse();
+    ret = get_next_file_and_line_number(task_idx, file_url, file_id, start_line, end_line);
+    if (OB_SUCC(ret)) {
+      state_.cur_file_id_ = file_id;
+      state_.cur_line_number_ = MAX(start_line, MIN_EXTERNAL_TABLE_LINE_NUMBER);
+      state_.end_line_number_ = end_line;
+      const char *split_char = "/";
+      OZ (url_.append_fmt("%.*s%s%.*s", location.length(), location.ptr(),
+                                        (location.empty() || location[location.length() - 1] == '/') ? "" : split_char,
+                                        file_url.length(), file_url.ptr()));
+      OZ (data_access_driver_.get_file_size(url_.string(), state_.file_size_));
+    }
+    LOG_DEBUG("try next file", K(ret), K(url_), K(file_url), K(state_));
+  } while (OB_SUCC(ret) && 0 >= state_.file_size_); //skip empty file
+  OZ (data_access_driver_.open(url_.string()), url_);
+
+  // footer: metadata, 4-byte length of metadata, "PAR1"
+  if (OB_SUCC(ret)) {
+    char footer[ObParquetType::FOOTER_LEN];
+    char *meta_buf = NULL;
+    int32_t meta_len = 0;
+    if (OB_UNLIKELY(state_.file_size_ < ObParquetType::MAGIC_LEN + ObParquetType::FOOTER_LEN)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("file is too small to be a parquet file", K(ret), K(url_), K(state_));
+    } else if (OB_FAIL(read_fully(footer, ObParquetType::FOOTER_LEN,
+                                  state_.file_size_ - ObParquetType::FOOTER_LEN))) {
+      LOG_WARN("fail to read footer", K(ret), K(url_));
+    } else if (OB_UNLIKELY(0 != MEMCMP(footer + sizeof(int32_t), PARQUET_MAGIC,
+                                       ObParquetType::MAGIC_LEN))) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("not a parquet file", K(ret), K(url_));
+    } else if (FALSE_IT(MEMCPY(&meta_len, footer, sizeof(int32_t)))) {
+    } else if (OB_UNLIKELY(meta_len <= 0
+                           || meta_len > state_.file_size_ - ObParquetType::MAGIC_LEN
+                                                           - ObParquetType::FOOTER_LEN)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("invalid length of parquet metadata", K(ret), K(meta_len), K(url_), K(state_));
+    } else if (OB_ISNULL(meta_buf = static_cast<char *>(file_allocator_.alloc(meta_len)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc memory", K(ret), K(meta_len));
+    } else if (OB_FAIL(read_fully(meta_buf, meta_len,
+                                  state_.file_size_ - ObParquetType::FOOTER_LEN - meta_len))) {
+      LOG_WARN("fail to read parquet metadata", K(ret), K(url_));
+    } else if (OB_FAIL(file_meta_.parse(meta_buf, meta_len))) {
+      LOG_WARN("fail to parse parquet metadata", K(ret), K(url_));
+    } else {
+      state_.next_row_group_idx_ = 0;
+      state_.next_row_group_first_line_ = MIN_EXTERNAL_TABLE_LINE_NUMBER;
+      state_.row_group_end_line_ = state_.cur_line_number_;
+      for (int64_t i = 0; i < column_exists_.count(); ++i) {
+        const int64_t leaf_idx = scan_param_->ext_file_column_exprs_->at(i)->extra_ - 1;
+        column_exists_.at(i) = leaf_idx < file_meta_.get_column_count();
+      }
+    }
+  }
+
+  LOG_DEBUG("open external file", K(ret), K(url_), K(state_), K(location));
+
+  return ret;
+}
+
+int ObParquetTableRowIterator::check_row_group_skipped(const int64_t row_group_idx,
+                                                       ObEvalCtx &eval_ctx,
+                                                       bool &skipped)
+{
+  int ret = OB_SUCCESS;
+  skipped = false;
+  for (int64_t i = 0; OB_SUCC(ret) && !skipped && i < skip_filters_.count(); ++i) {
+    const SkipFilter &filter = skip_filters_.at(i);
+    ObDatum *value = NULL;
+    if (filter.column_leaf_idx_ >= file_meta_.get_column_count()) {
+      // the column is null in this file, which is left to the filter
+    } else if (OB_FAIL(filter.value_expr_->eval(eval_ctx, value))) {
+      LOG_WARN("fail to eval filter value", K(ret), K(filter));
+    } else if (OB_FAIL(file_meta_.get_column_chunk(row_group_idx, filter.column_leaf_idx_).can_skip(
+                         file_meta_.get_column(filter.column_leaf_idx_),
+                         filter.cmp_type_, filter.value_tc_, *value, skipped))) {
+      LOG_WARN("fail to check column chunk", K(ret), K(filter));
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::open_next_row_group(ObEvalCtx &eval_ctx)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_group_idx = state_.next_row_group_idx_;
+  const ObParquetRowGroupMeta &row_group = file_meta_.get_row_group(row_group_idx);
+  const int64_t first_line = state_.next_row_group_first_line_;
+  const int64_t end_line = first_line + row_group.num_rows_;
+  bool skipped = false;
+  state_.next_row_group_idx_++;
+  state_.next_row_group_first_line_ = end_line;
+  if (end_line <= state_.cur_line_number_) {
+    // out of the range of the task
+  } else if (OB_FAIL(check_row_group_skipped(row_group_idx, eval_ctx, skipped))) {
+    LOG_WARN("fail to check row group", K(ret), K(row_group_idx));
+  } else if (skipped) {
+    LOG_DEBUG("skip row group by statistics", K(url_), K(row_group_idx), K(row_group));
+    state_.cur_line_number_ = end_line;
+  } else {
+    const int64_t max_batch_size = MAX(1, eval_ctx.max_batch_size_);
+    const int64_t skip_rows = state_.cur_line_number_ - first_line;
+    const ObSQLSessionInfo *session = eval_ctx.exec_ctx_.get_my_session();
+    const ObTimeZoneInfo *tz_info = OB_ISNULL(session) ? NULL : session->get_timezone_info();
+    row_group_allocator_.reuse();
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_readers_.count(); ++i) {
+      ObParquetColumnReader &reader = column_readers_.at(i);
+      const int64_t leaf_idx = scan_param_->ext_file_column_exprs_->at(i)->extra_ - 1;
+      const int64_t column_idx = direct_column_idxs_.at(i);
+      ObObjType datum_type = ObVarcharType;
+      int16_t datum_scale = -1;
+      char *buf = NULL;
+      reader.reset();
+      if (!column_exists_.at(i)) {
+        // read as null
+      } else {
+        const ObParquetColumnChunkMeta &chunk = file_meta_.get_column_chunk(row_group_idx, leaf_idx);
+        const int64_t start = chunk.get_start_offset();
+        const int64_t len = chunk.total_compressed_size_;
+        if (column_idx >= 0) {
+          const ObDatumMeta &meta = column_exprs_.at(column_idx)->datum_meta_;
+          if (ObParquetColumnReader::can_read_as(file_meta_.get_column(leaf_idx), meta.type_)) {
+            datum_type = meta.type_;
+            datum_scale = meta.scale_;
+          }
+        }
+        if (OB_UNLIKELY(start < ObParquetType::MAGIC_LEN || len <= 0
+                        || len > state_.file_size_ - ObParquetType::FOOTER_LEN - start)) {
+          ret = OB_INVALID_DATA;
+          LOG_WARN("invalid column chunk", K(ret), K(url_), K(chunk), K(state_));
+        } else if (OB_ISNULL(buf = static_cast<char *>(row_group_allocator_.alloc(len)))) {
+          ret = OB_ALLOCATE_MEMORY_FAILED;
+          LOG_WARN("fail to alloc memory", K(ret), K(len));
+        } else if (OB_FAIL(read_fully(buf, len, start))) {
+          LOG_WARN("fail to read column chunk", K(ret), K(chunk));
+        } else if (OB_FAIL(reader.init(file_meta_.get_column(leaf_idx), chunk, buf, len,
+                                       max_batch_size, datum_type, datum_scale, tz_info,
+                                       row_group_allocator_))) {
+          LOG_WARN("fail to init column reader", K(ret), K(url_), K(leaf_idx));
+        } else if (skip_rows > 0 && OB_FAIL(reader.skip(skip_rows, batch_allocator_))) {
+          LOG_WARN("fail to skip rows", K(ret), K(url_), K(leaf_idx), K(skip_rows));
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      state_.row_group_end_line_ = MIN(end_line - 1, state_.end_line_number_) + 1;
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::prepare_rows(ObEvalCtx &eval_ctx)
+{
+  int ret = OB_SUCCESS;
+  while (OB_SUCC(ret) && state_.cur_line_number_ >= state_.row_group_end_line_) {
+    if (state_.next_row_group_idx_ >= file_meta_.get_row_group_count()
+        || state_.next_row_group_first_line_ > state_.end_line_number_) {
+      if (OB_FAIL(open_next_file())) {
+        //do not print log
+      }
+    } else if (OB_FAIL(open_next_row_group(eval_ctx))) {
+      LOG_WARN("fail to open row group", K(ret), K(state_));
+    }
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::read_file_columns(const int64_t count,
+                                                 ObEvalCtx &eval_ctx,
+                                                 const bool is_batch)
+{
+  int ret = OB_SUCCESS;
+  const ExprFixedArray &file_column_exprs = *(scan_param_->ext_file_column_exprs_);
+  bool is_oracle_mode = lib::is_oracle_mode();
+  for (int64_t i = 0; OB_SUCC(ret) && i < file_column_exprs.count(); ++i) {
+    // typed values are read into the column directly
+    ObExpr *expr = column_readers_.at(i).is_typed() ? column_exprs_.at(direct_column_idxs_.at(i))
+                                                    : file_column_exprs.at(i);
+    ObDatum *datums = is_batch ? expr->locate_batch_datums(eval_ctx)
+                               : &expr->locate_datum_for_write(eval_ctx);
+    if (!column_exists_.at(i)) {
+      for (int64_t j = 0; j < count; ++j) {
+        datums[j].set_null();
+      }
+    } else if (OB_FAIL(column_readers_.at(i).read(count, datums, batch_allocator_))) {
+      LOG_WARN("fail to read column", K(ret), K(url_), K(i), K(state_));
+    } else if (is_oracle_mode) {
+      for (int64_t j = 0; j < count; ++j) {
+        if (!datums[j].is_null() && 0 == datums[j].len_) {
+          datums[j].set_null();
+        }
+      }
+    }
+    expr->set_evaluated_flag(eval_ctx);
+  }
+  return ret;
+}
+
+int ObParquetTableRowIterator::get_next_row()
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx &eval_ctx = scan_param_->op_->get_eval_ctx();
+  batch_allocator_.reuse();
+  if (OB_FAIL(prepare_rows(eval_ctx))) {
+    if (OB_ITER_END != ret) {
+      LOG_WARN("fail to prepare rows", K(ret));
+    }
+  } else if (OB_FAIL(read_file_columns(1, eval_ctx, false))) {
+    LOG_WARN("fail to read file columns", K(ret));
+  } else {
+    if (OB_NOT_NULL(file_id_expr_)) {
+      ObDatum &datum = file_id_expr_->locate_datum_for_write(eval_ctx);
+      datum.set_int(state_.cur_file_id_);
+    }
+    if (OB_NOT_NULL(line_number_expr_)) {
+      ObDatum &datum = line_number_expr_->locate_datum_for_write(eval_ctx);
+      datum.set_int(state_.cur_line_number_);
+    }
+    state_.cur_line_number_++;
+  }
+
+  for (int i = 0; OB_SUCC(ret) && i < column_exprs_.count(); i++) {
+    ObExpr *column_expr = column_exprs_.at(i);
+    ObExpr *column_convert_expr = scan_param_->ext_column_convert_exprs_->at(i);
+    ObDatum *convert_datum = NULL;
+    if (is_direct_column(i)) {
+      // read by read_file_columns
+    } else if (OB_FAIL(column_convert_expr->eval(eval_ctx, convert_datum))) {
+      LOG_WARN("fail to eval column convert expr", K(ret), K(i));
+    } else {
+      column_expr->locate_datum_for_write(eval_ctx) = *convert_datum;
+      column_expr->set_evaluated_flag(eval_ctx);
+    }
+  }
+
+  return ret;
+}
+
+int ObParquetTableRowIterator::get_next_rows(int64_t &count, int64_t capacity)
+{
+  int ret = OB_SUCCESS;
+  ObEvalCtx &eval_ctx = scan_param_->op_->get_eval_ctx();
+  int64_t returned_row_cnt = 0;
+
+  if (OB_ISNULL(bit_vector_cache_)) {
+    void *mem = nullptr;
+    if (OB_ISNULL(mem = allocator_.alloc(ObBitVector::memory_size(eval_ctx.max_batch_size_)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc memory for skip", K(ret), K(eval_ctx.max_batch_size_));
+    } else {
+      bit_vector_cache_ = to_bit_vector(mem);
+      bit_vector_cache_->reset(eval_ctx.max_batch_size_);
+    }
+  }
+  batch_allocator_.reuse();
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(prepare_rows(eval_ctx))) {
+    if (OB_ITER_END != ret) {
+      LOG_WARN("fail to prepare rows", K(ret));
+    }
+  } else if (FALSE_IT(returned_row_cnt = MIN(MIN(capacity, eval_ctx.max_batch_size_),
+                                             state_.row_group_end_line_ - state_.cur_line_number_))) {
+  } else if (OB_FAIL(read_file_columns(returned_row_cnt, eval_ctx, true))) {
+    LOG_WARN("fail to read file columns", K(ret));
+  } else {
+    if (OB_NOT_NULL(file_id_expr_)) {
+      ObDatum *datums = file_id_expr_->locate_batch_datums(eval_ctx);
+      for (int64_t i = 0; i < returned_row_cnt; i++) {
+        datums[i].set_int(state_.cur_file_id_);
+      }
+      file_id_expr_->set_evaluated_flag(eval_ctx);
+    }
+    if (OB_NOT_NULL(line_number_expr_)) {
+      ObDatum *datums = line_number_expr_->locate_batch_datums(eval_ctx);
+      for (int64_t i = 0; i < returned_row_cnt; i++) {
+        datums[i].set_int(state_.cur_line_number_ + i);
+      }
+      line_number_expr_->set_evaluated_flag(eval_ctx);
+    }
+    state_.cur_line_number_ += returned_row_cnt;
+  }
+
+  for (int i = 0; OB_SUCC(ret) && i < column_exprs_.count(); i++) {
+    ObExpr *column_expr = column_exprs_.at(i);
+    ObExpr *column_convert_expr = scan_param_->ext_column_convert_exprs_->at(i);
+    if (is_direct_column(i)) {
+      // read by read_file_columns
+    } else if (OB_FAIL(column_convert_expr->eval_batch(eval_ctx, *bit_vector_cache_,
+                                                       returned_row_cnt))) {
+      LOG_WARN("fail to eval column convert expr", K(ret), K(i));
+    } else {
+      MEMCPY(column_expr->locate_batch_datums(eval_ctx),
+             column_convert_expr->locate_batch_datums(eval_ctx), sizeof(ObDatum) * returned_row_cnt);
+      column_expr->set_evaluated_flag(eval_ctx);
+    }
+  }
+
+  count = returned_row_cnt;
+
+  return ret;
+}
+
+void ObParquetTableRowIterator::reset()
+{
+  // reset state_ to initial values for rescan
+  state_.reuse();
+  file_meta_.reset();
+  for (int64_t i = 0; i < column_readers_.count(); ++i) {
+    column_readers_.at(i).reset();
+  }
+  batch_allocator_.reuse();
+  row_group_allocator_.reuse();
+  file_allocator_.reuse();
+}
+
+}
+}
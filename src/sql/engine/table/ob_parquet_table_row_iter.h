@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_PARQUET_TABLE_ROW_ITER_H_
+#define OB_PARQUET_TABLE_ROW_ITER_H_
+
+#include "sql/engine/expr/ob_expr.h"
+#include "sql/engine/table/ob_external_table_access_service.h"
+#include "sql/engine/table/ob_parquet_file_reader.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+class ObParquetTableRowIterator : public ObExternalTableRowIterator {
+public:
+  static const int64_t MIN_EXTERNAL_TABLE_FILE_ID = 1;
+  static const int64_t MIN_EXTERNAL_TABLE_LINE_NUMBER = 1;
+
+public:
+  /*
+   * Line number of a parquet file is the row number in the file, starting from 1.
+   * Rows of [cur_line_number_, row_group_end_line_) are left in the current row group.
+   */
+  struct StateValues {
+    StateValues() :
+      file_idx_(0), file_size_(0), cur_file_id_(MIN_EXTERNAL_TABLE_FILE_ID),
+      cur_line_number_(MIN_EXTERNAL_TABLE_LINE_NUMBER), end_line_number_(INT64_MAX),
+      row_group_end_line_(MIN_EXTERNAL_TABLE_LINE_NUMBER), next_row_group_idx_(0),
+      next_row_group_first_line_(MIN_EXTERNAL_TABLE_LINE_NUMBER) {}
+    int64_t file_idx_;
+    int64_t file_size_;
+    int64_t cur_file_id_;
+    int64_t cur_line_number_;
+    int64_t end_line_number_;
+    int64_t row_group_end_line_;
+    int64_t next_row_group_idx_;
+    int64_t next_row_group_first_line_;
+    void reuse() {
+      file_idx_ = 0;
+      file_size_ = 0;
+      cur_file_id_ = MIN_EXTERNAL_TABLE_FILE_ID;
+      cur_line_number_ = MIN_EXTERNAL_TABLE_LINE_NUMBER;
+      end_line_number_ = INT64_MAX;
+      row_group_end_line_ = MIN_EXTERNAL_TABLE_LINE_NUMBER;
+      next_row_group_idx_ = 0;
+      next_row_group_first_line_ = MIN_EXTERNAL_TABLE_LINE_NUMBER;
+    }
+    TO_STRING_KV(K(file_idx_), K(file_size_), K(cur_file_id_), K(cur_line_number_),
+                 K(end_line_number_), K(row_group_end_line_), K(next_row_group_idx_),
+                 K(next_row_group_first_line_));
+  };
+
+  // `column @cmp_type value_expr` from the filters of the scan, used to skip row groups
+  struct SkipFilter {
+    SkipFilter() : cmp_type_(T_INVALID), column_leaf_idx_(-1), value_tc_(ObMaxTC), value_expr_(NULL) {}
+    ObItemType cmp_type_;
+    int64_t column_leaf_idx_;
+    ObObjTypeClass value_tc_;
+    ObExpr *value_expr_;
+    TO_STRING_KV(K_(cmp_type), K_(column_leaf_idx), K_(value_tc), KP_(value_expr));
+  };
+
+  ObParquetTableRowIterator()
+    : bit_vector_cache_(NULL), line_number_expr_(NULL), file_id_expr_(NULL) {}
+  virtual ~ObParquetTableRowIterator();
+  int init(const storage::ObTableScanParam *scan_param) override;
+  int get_next_row() override;
+  int get_next_rows(int64_t &count, int64_t capacity) override;
+
+  virtual int get_next_row(ObNewRow *&row) override {
+    UNUSED(row);
+    return common::OB_ERR_UNEXPECTED;
+  }
+
+  virtual void reset() override;
+
+private:
+  int init_exprs(const storage::ObTableScanParam *scan_param);
+  int init_skip_filters(const storage::ObTableScanParam *scan_param);
+  int init_direct_columns(const storage::ObTableScanParam *scan_param);
+  int get_file_column_leaf_idx(const ObExpr *convert_expr, int64_t &leaf_idx) const;
+  bool is_direct_column(const int64_t column_idx) const;
+  int get_next_file_and_line_number(const int64_t task_idx,
+                                    common::ObString &file_url,
+                                    int64_t &file_id,
+                                    int64_t &start_line,
+                                    int64_t &end_line);
+  int read_fully(char *buf, const int64_t len, const int64_t offset);
+  int open_next_file();
+  int open_next_row_group(ObEvalCtx &eval_ctx);
+  int check_row_group_skipped(const int64_t row_group_idx, ObEvalCtx &eval_ctx, bool &skipped);
+  int prepare_rows(ObEvalCtx &eval_ctx);
+  int read_file_columns(const int64_t count, ObEvalCtx &eval_ctx, const bool is_batch);
+private:
+  ObBitVector *bit_vector_cache_;
+  StateValues state_;
+  common::ObMalloc allocator_;
+  // holds the file metadata, reset when moving to the next file
+  common::ObArenaAllocator file_allocator_;
+  // holds column chunks, decompressed pages and dictionaries of the current row group
+  common::ObArenaAllocator row_group_allocator_;
+  // holds the values of the current batch
+  common::ObArenaAllocator batch_allocator_;
+  ObExternalDataAccessDriver data_access_driver_;
+  ObSqlString url_;
+  ObParquetFileMeta file_meta_;
+  ObSEArray<ObExpr*, 16> column_exprs_;
+  ObExpr *line_number_expr_;
+  ObExpr *file_id_expr_;
+  // column readers of ext_file_column_exprs_, the leaf column of a reader is extra_ - 1
+  ObSEArray<ObParquetColumnReader, 16> column_readers_;
+  ObSEArray<bool, 16> column_exists_;
+  /*
+   * A column defined as a file column referenced by no other column is read directly as the
+   * column type when the file column is of the same type, without rendering text for column_conv.
+   * direct_column_idxs_ holds the column of each reader, -1 if none, and direct_reader_idxs_
+   * holds the reader of each column, -1 if none.
+   */
+  ObSEArray<int64_t, 16> direct_column_idxs_;
+  ObSEArray<int64_t, 16> direct_reader_idxs_;
+  ObSEArray<SkipFilter, 4> skip_filters_;
+};
+
+}
+}
+
+#endif // OB_PARQUET_TABLE_ROW_ITER_H_
@@ -13,6 +13,7 @@
 #define USING_LOG_PREFIX SQL_ENG
 #include "sql/engine/window_function/ob_window_function_op.h"
 #include "lib/utility/utility.h"
+#include "lib/alloc/ob_malloc_allocator.h"
 #include "share/object/ob_obj_cast.h"
 #include "common/row/ob_row_util.h"
 #include "sql/session/ob_sql_session_info.h"
@@ -412,6 +413,104 @@ int ObWindowFunctionOp::AggrCell::final(ObDatum &val)
   return ret;
 }
 
+int ObWindowFunctionOp::ExtremumSegTree::init(const int64_t first_row_idx,
+                                               const int64_t row_cnt,
+                                               const bool is_max,
+                                               ObDatumCmpFuncType cmp_func)
+{
+  int ret = OB_SUCCESS;
+  reuse();
+  if (OB_UNLIKELY(row_cnt <= 0) || OB_ISNULL(cmp_func)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_cnt), KP(cmp_func));
+  } else if (OB_ISNULL(datums_ = static_cast<ObDatum *>(
+                       alloc_.alloc(sizeof(ObDatum) * row_cnt)))
+             || OB_ISNULL(nodes_ = static_cast<int64_t *>(
+                          alloc_.alloc(sizeof(int64_t) * row_cnt * 2)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc memory", K(ret), K(row_cnt));
+  } else {
+    first_row_idx_ = first_row_idx;
+    row_cnt_ = row_cnt;
+    is_max_ = is_max;
+    cmp_func_ = cmp_func;
+  }
+  return ret;
+}
+
+int ObWindowFunctionOp::ExtremumSegTree::set_leaf(const int64_t row_idx, const ObDatum &datum)
+{
+  int ret = OB_SUCCESS;
+  const int64_t idx = row_idx - first_row_idx_;
+  if (OB_UNLIKELY(idx < 0 || idx >= row_cnt_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid row index", K(ret), K(row_idx), K(*this));
+  } else if (OB_FAIL(datums_[idx].deep_copy(datum, alloc_))) {
+    LOG_WARN("failed to deep copy datum", K(ret));
+  } else {
+    nodes_[row_cnt_ + idx] = datum.is_null() ? -1 : idx;
+  }
+  return ret;
+}
+
+int ObWindowFunctionOp::ExtremumSegTree::build()
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = row_cnt_ - 1; OB_SUCC(ret) && i > 0; i--) {
+    if (OB_FAIL(better(nodes_[2 * i], nodes_[2 * i + 1], nodes_[i]))) {
+      LOG_WARN("failed to compare", K(ret));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    built_ = true;
+  }
+  return ret;
+}
+
+int ObWindowFunctionOp::ExtremumSegTree::query(const int64_t head,
+                                               const int64_t tail,
+                                               int64_t &row_idx) const
+{
+  int ret = OB_SUCCESS;
+  int64_t res = -1;
+  int64_t l = head - first_row_idx_;
+  int64_t r = tail - first_row_idx_ + 1;
+  if (OB_UNLIKELY(!built_ || l < 0 || r > row_cnt_ || l >= r)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid frame", K(ret), K(head), K(tail), K(*this));
+  } else {
+    for (l += row_cnt_, r += row_cnt_; OB_SUCC(ret) && l < r; l >>= 1, r >>= 1) {
+      if ((l & 1) && OB_FAIL(better(res, nodes_[l++], res))) {
+        LOG_WARN("failed to compare", K(ret));
+      } else if ((r & 1) && OB_FAIL(better(res, nodes_[--r], res))) {
+        LOG_WARN("failed to compare", K(ret));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    row_idx = -1 == res ? -1 : res + first_row_idx_;
+  }
+  return ret;
+}
+
+int ObWindowFunctionOp::ExtremumSegTree::better(const int64_t l, const int64_t r,
+                                                int64_t &res) const
+{
+  int ret = OB_SUCCESS;
+  int cmp_ret = 0;
+  if (-1 == l || -1 == r) {
+    res = -1 == l ? r : l;
+  } else if (OB_FAIL(cmp_func_(datums_[l], datums_[r], cmp_ret))) {
+    LOG_WARN("failed to compare", K(ret));
+  } else if (0 == cmp_ret) {
+    // prefer the latter row which stays longer in sliding frame
+    res = std::max(l, r);
+  } else {
+    res = (cmp_ret > 0) == is_max_ ? l : r;
+  }
+  return ret;
+}
+
 DEF_TO_STRING(ObWindowFunctionOp::AggrCell)
 {
   int64_t pos = 0;
@@ -1710,6 +1809,111 @@ int ObWindowFunctionOp::compute_push_down_by_pass(WinFuncCell &wf_cell, common::
   return ret;
 }
 
+int ObWindowFunctionOp::check_seg_tree_mem_exceed(const int64_t mem_size, bool &exceed)
+{
+  int ret = OB_SUCCESS;
+  exceed = false;
+  lib::ObMallocAllocator *instance = lib::ObMallocAllocator::get_instance();
+  lib::ObTenantCtxAllocatorGuard allocator = NULL;
+  if (input_rows_.cur_->ra_rs_.is_file_open()) {
+    exceed = true;
+  } else if (OB_ISNULL(instance)) {
+    ret = OB_ERR_SYS;
+    LOG_WARN("NULL allocator", K(ret));
+  } else if (OB_ISNULL(allocator = instance->get_tenant_ctx_allocator(
+      ctx_.get_my_session()->get_effective_tenant_id(), ObCtxIds::WORK_AREA))) {
+    // no tenant allocator, do nothing
+  } else if (allocator->get_limit() / 100 * ExtremumSegTree::MEM_PCT_TRIGGER
+             <= allocator->get_hold() + mem_size) {
+    exceed = true;
+  }
+  if (exceed) {
+    LOG_TRACE("segment tree exceeds memory", K(mem_size), K(input_rows_.cur_->ra_rs_.is_file_open()));
+  }
+  return ret;
+}
+
+int ObWindowFunctionOp::build_extremum_seg_tree(AggrCell &aggr_func)
+{
+  int ret = OB_SUCCESS;
+  const ObAggrInfo &aggr_info = aggr_func.wf_info_.aggr_info_;
+  const int64_t first_row_idx = aggr_func.part_first_row_idx_;
+  const int64_t row_cnt = get_part_end_idx() - first_row_idx + 1;
+  const ObRADatumStore::StoredRow *row = NULL;
+  ObDatum *datum = NULL;
+  bool exceed = false;
+  if (OB_UNLIKELY(1 != aggr_info.param_exprs_.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected param count", K(ret), K(aggr_info.param_exprs_.count()));
+  } else if (OB_FAIL(check_seg_tree_mem_exceed(ExtremumSegTree::estimate_mem_size(row_cnt),
+                                               exceed))) {
+    LOG_WARN("failed to check memory", K(ret), K(row_cnt));
+  } else if (exceed) {
+    // do nothing
+  } else if (OB_FAIL(aggr_func.seg_tree_.init(first_row_idx, row_cnt,
+                                              T_FUN_MAX == aggr_info.get_expr_type(),
+                                              aggr_info.expr_->basic_funcs_->null_first_cmp_))) {
+    LOG_WARN("failed to init segment tree", K(ret), K(first_row_idx), K(row_cnt));
+  }
+  for (int64_t i = first_row_idx; OB_SUCC(ret) && !exceed && i < first_row_idx + row_cnt; ++i) {
+    if (OB_FAIL(input_rows_.cur_->get_row(i, row))) {
+      LOG_WARN("get cur row failed", K(ret), K(i));
+    } else if (FALSE_IT(clear_evaluated_flag())) {
+    } else if (OB_FAIL(row->to_expr(get_all_expr(), eval_ctx_))) {
+      LOG_WARN("Failed to to_expr", K(ret));
+    } else if (OB_FAIL(aggr_info.param_exprs_.at(0)->eval(eval_ctx_, datum))) {
+      LOG_WARN("failed to eval param expr", K(ret));
+    } else if (OB_FAIL(aggr_func.seg_tree_.set_leaf(i, *datum))) {
+      LOG_WARN("failed to set leaf", K(ret), K(i));
+    } else if (0 == (i - first_row_idx + 1) % ExtremumSegTree::MEM_CHECK_INTERVAL
+               && OB_FAIL(check_seg_tree_mem_exceed(0, exceed))) {
+      LOG_WARN("failed to check memory", K(ret), K(i));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (exceed) {
+    // restart the aggregation directly in this partition
+    aggr_func.seg_tree_.disable();
+  } else if (OB_FAIL(aggr_func.seg_tree_.build())) {
+    LOG_WARN("failed to build segment tree", K(ret));
+  }
+  LOG_TRACE("build extremum segment tree", K(ret), K(exceed), K(aggr_func.seg_tree_));
+  return ret;
+}
+
+int ObWindowFunctionOp::restart_extremum_by_seg_tree(AggrCell &aggr_func,
+                                                     const Frame &frame,
+                                                     bool &restarted)
+{
+  int ret = OB_SUCCESS;
+  int64_t row_idx = -1;
+  const ObRADatumStore::StoredRow *row = NULL;
+  restarted = false;
+  if (!aggr_func.seg_tree_.is_built() && OB_FAIL(build_extremum_seg_tree(aggr_func))) {
+    LOG_WARN("failed to build segment tree", K(ret));
+  } else if (!aggr_func.seg_tree_.is_built()) {
+    // exceeds memory, do nothing
+  } else if (OB_FAIL(aggr_func.seg_tree_.query(frame.head_, frame.tail_, row_idx))) {
+    LOG_WARN("failed to query segment tree", K(ret), K(frame));
+  } else {
+    // all values of frame are null, aggregate the first row to get null result
+    row_idx = -1 == row_idx ? frame.head_ : row_idx;
+    aggr_func.reset_for_restart();
+    if (OB_FAIL(input_rows_.cur_->get_row(row_idx, row))) {
+      LOG_WARN("get cur row failed", K(ret), K(row_idx));
+    } else if (FALSE_IT(clear_evaluated_flag())) {
+    } else if (OB_FAIL(row->to_expr(get_all_expr(), eval_ctx_))) {
+      LOG_WARN("Failed to to_expr", K(ret));
+    } else if (OB_FAIL(aggr_func.trans(*row))) {
+      LOG_WARN("trans failed", K(ret));
+    } else {
+      aggr_func.aggr_processor_.get_removal_info().max_min_index_ = row_idx;
+      restarted = true;
+    }
+  }
+  return ret;
+}
+
 int ObWindowFunctionOp::compute(RowsReader &row_reader, WinFuncCell &wf_cell,
     const int64_t row_idx, ObDatum &val)
 {
@@ -1752,6 +1956,7 @@ int ObWindowFunctionOp::compute(RowsReader &row_reader, WinFuncCell &wf_cell,
       if (wf_cell.is_aggr()) {
         AggrCell *aggr_func = static_cast<AggrCell *>(&wf_cell);
         const ObRADatumStore::StoredRow *cur_row = NULL;
+        bool restarted_by_seg_tree = false;
         if (!Frame::same_frame(last_valid_frame, new_frame)) {
           if (!Frame::need_restart_aggr(aggr_func->can_inv(), last_valid_frame, new_frame,
                                         aggr_func->aggr_processor_.get_removal_info(),
@@ -1816,7 +2021,14 @@ int ObWindowFunctionOp::compute(RowsReader &row_reader, WinFuncCell &wf_cell,
                 }
               }
             }
-          } else {
+          } else if (common::REMOVE_EXTRENUM == wf_cell.wf_info_.remove_type_
+                     && !MY_SPEC.is_push_down()
+                     && (aggr_func->seg_tree_.is_built()
+                         || aggr_func->seg_tree_.need_build(new_frame))
+                     && OB_FAIL(restart_extremum_by_seg_tree(*aggr_func, new_frame,
+                                                             restarted_by_seg_tree))) {
+            LOG_WARN("failed to restart by segment tree", K(ret), K(new_frame));
+          } else if (!restarted_by_seg_tree) {
             aggr_func->reset_for_restart();
             if (common::REMOVE_EXTRENUM == wf_cell.wf_info_.remove_type_) {
               // reset max_min index as head of new frame
@@ -3228,6 +3440,9 @@ int ObWindowFunctionOp::compute_wf_values(const WinFuncCell *end, int64_t &check
   int64_t prev_wf_pby_expr_count = -1; // prev_wf_pby_expr_count transmit to datahub
   for (WinFuncCell *wf = first; OB_SUCC(ret) && wf != end; wf = wf->get_next()) {
     wf->reset_for_restart();
+    if (wf->is_aggr()) {
+      static_cast<AggrCell *>(wf)->seg_tree_.reuse();
+    }
     ObDatum result_datum;
     RowsReader row_reader(*input_rows_.cur_);
     if (wf == wf_list_.get_last()) {
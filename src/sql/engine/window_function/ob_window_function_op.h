@@ -554,6 +554,81 @@ public:
     Frame last_valid_frame_;
   };
 
+  // Segment tree of the extremum row over the rows of current partition, used by MIN/MAX
+  // aggregation over sliding frames. When the extremum slides out of the frame, the new
+  // extremum is found in O(log(n)) instead of restarting the aggregation over the whole frame.
+  class ExtremumSegTree
+  {
+  public:
+    // build the tree after this many restarts in one partition
+    static const int64_t MIN_RESTART_CNT = 2;
+    // frames smaller than this are restarted directly
+    static const int64_t MIN_FRAME_SIZE = 64;
+
+    // memory check interval of building the tree
+    static const int64_t MEM_CHECK_INTERVAL = 1024;
+    // not built if the work area of tenant is used over this percent, see check_seg_tree_mem_exceed()
+    static const int64_t MEM_PCT_TRIGGER = 80;
+
+    // allocated in work area like the rows of RowsStore
+    explicit ExtremumSegTree(const int64_t tenant_id)
+      : alloc_(lib::ObMemAttr(tenant_id, "WfSegTree", common::ObCtxIds::WORK_AREA)),
+        datums_(NULL), nodes_(NULL), first_row_idx_(0), row_cnt_(0),
+        is_max_(true), cmp_func_(NULL), restart_cnt_(0), built_(false), disabled_(false)
+    {}
+    ~ExtremumSegTree() { reuse(); }
+    void reuse()
+    {
+      alloc_.reset();
+      datums_ = NULL;
+      nodes_ = NULL;
+      first_row_idx_ = 0;
+      row_cnt_ = 0;
+      restart_cnt_ = 0;
+      built_ = false;
+      disabled_ = false;
+    }
+    // free the memory and restart the aggregation directly in current partition
+    void disable()
+    {
+      reuse();
+      disabled_ = true;
+    }
+    bool need_build(const Frame &frame)
+    {
+      return !built_ && !disabled_ && frame.tail_ - frame.head_ + 1 >= MIN_FRAME_SIZE
+          && ++restart_cnt_ > MIN_RESTART_CNT;
+    }
+    bool is_built() const { return built_; }
+    int64_t get_mem_used() const { return alloc_.total(); }
+    // memory of the tree over %row_cnt rows, not including the deep copied data of datums
+    static int64_t estimate_mem_size(const int64_t row_cnt)
+    { return row_cnt * (sizeof(common::ObDatum) + sizeof(int64_t) * 2); }
+    int init(const int64_t first_row_idx, const int64_t row_cnt, const bool is_max,
+             common::ObDatumCmpFuncType cmp_func);
+    int set_leaf(const int64_t row_idx, const common::ObDatum &datum);
+    int build();
+    // Get row index of the extremum in [head, tail], -1 returned if all datums are null.
+    int query(const int64_t head, const int64_t tail, int64_t &row_idx) const;
+    TO_STRING_KV(K_(first_row_idx), K_(row_cnt), K_(is_max), K_(restart_cnt), K_(built),
+                 K_(disabled), "mem_used", get_mem_used());
+  private:
+    int better(const int64_t l, const int64_t r, int64_t &res) const;
+  private:
+    common::ObArenaAllocator alloc_;
+    common::ObDatum *datums_;
+    // nodes_[1, row_cnt_) are internal nodes, nodes_[row_cnt_, 2 * row_cnt_) are leaves,
+    // node stores the index of extremum datum, -1 for null
+    int64_t *nodes_;
+    int64_t first_row_idx_;
+    int64_t row_cnt_;
+    bool is_max_;
+    common::ObDatumCmpFuncType cmp_func_;
+    int64_t restart_cnt_;
+    bool built_;
+    bool disabled_;
+  };
+
   class AggrCell : public WinFuncCell
   {
   public:
@@ -563,7 +638,8 @@ public:
         aggr_processor_(op_.eval_ctx_, aggr_infos, "WindowAggProc", op.get_monitor_info(), tenant_id),
         result_(),
         got_result_(false),
-        remove_type_(wf_info.remove_type_)
+        remove_type_(wf_info.remove_type_),
+        seg_tree_(tenant_id)
     {}
     virtual ~AggrCell() { aggr_processor_.destroy(); }
     int trans(const ObRADatumStore::StoredRow &row)
@@ -607,6 +683,7 @@ public:
     ObDatum result_;
     bool got_result_;
     uint64_t remove_type_;
+    ExtremumSegTree seg_tree_;
   };
 
   class NonAggrCell : public WinFuncCell
@@ -812,6 +889,14 @@ protected:
   int compute(RowsReader &row_reader, WinFuncCell &wf_cell, const int64_t row_idx,
               common::ObDatum &val);
   int compute_push_down_by_pass(WinFuncCell &wf_cell, common::ObDatum &val);
+  // Check whether the segment tree of %mem_size exceeds the memory, by the same trigger of
+  // dumping the rows of RowsStore: the input rows are dumped or the work area of tenant is
+  // used over ExtremumSegTree::MEM_PCT_TRIGGER percent.
+  int check_seg_tree_mem_exceed(const int64_t mem_size, bool &exceed);
+  int build_extremum_seg_tree(AggrCell &aggr_func);
+  // Restart MIN/MAX aggregation of %frame with the extremum row found by segment tree,
+  // %restarted is false if the tree can not be built for the memory.
+  int restart_extremum_by_seg_tree(AggrCell &aggr_func, const Frame &frame, bool &restarted);
   int check_same_partition(const ExprFixedArray &other_exprs,
                            bool &is_same_part,
                            const ExprFixedArray *curr_exprs = NULL);
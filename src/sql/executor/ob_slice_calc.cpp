@@ -1418,6 +1418,9 @@ int ObHybridHashSliceIdCalcBase::check_if_popular_value(ObEvalCtx &eval_ctx, boo
         }
       }
     }
+    if (is_popular) {
+      popular_row_cnt_++;
+    }
   }
   return ret;
 }
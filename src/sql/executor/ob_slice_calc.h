@@ -705,7 +705,8 @@ public:
                               const ObIArray<uint64_t> *popular_values_hash)
       : hash_calc_(alloc, slice_cnt, null_row_dist_method, dist_exprs, hash_funcs),
         popular_values_hash_(popular_values_hash),
-        use_hash_lookup_(false)
+        use_hash_lookup_(false),
+        popular_row_cnt_(0)
   {
     int ret = OB_SUCCESS;
     if (popular_values_hash && popular_values_hash->count() > 3) {
@@ -731,12 +732,15 @@ public:
       (void) popular_values_map_.destroy();
     }
   }
+  // rows matched popular values, for sql plan monitor
+  int64_t get_popular_row_cnt() const { return popular_row_cnt_; }
 protected:
   int check_if_popular_value(ObEvalCtx &eval_ctx, bool &is_popular);
   ObHashSliceIdCalc hash_calc_;
   const common::ObIArray<uint64_t> *popular_values_hash_;
   common::hash::ObHashSet<uint64_t, common::hash::NoPthreadDefendMode> popular_values_map_;
   bool use_hash_lookup_;
+  int64_t popular_row_cnt_;
 };
 
 // broadcast side of px hybrid hash send
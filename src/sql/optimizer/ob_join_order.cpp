@@ -5578,6 +5578,7 @@ int JoinPath::assign(const JoinPath &other, common::ObIAllocator *allocator)
   join_algo_ = other.join_algo_;
   join_dist_algo_ = other.join_dist_algo_;
   is_slave_mapping_ = other.is_slave_mapping_;
+  need_skew_detect_ = other.need_skew_detect_;
   join_type_ = other.join_type_;
   need_mat_ = other.need_mat_;
   left_need_sort_ = other.left_need_sort_;
@@ -5897,12 +5898,26 @@ int JoinPath::compute_join_path_plan_type()
   return ret;
 }
 
+// Runtime skew detection makes the probe side wait until every build side task has
+// sampled its header rows and QC has merged the samples, the build side rows are held
+// meanwhile. Only pay for it when the join is parallel, the build side has enough rows
+// for a meaningful sample, and each worker gets enough rows for an imbalance to matter.
+bool JoinPath::need_runtime_skew_detect(const int64_t parallel,
+                                        const double build_rows,
+                                        const double probe_rows)
+{
+  return parallel > 1
+         && build_rows >= static_cast<double>(parallel * SKEW_DETECT_MIN_BUILD_ROWS_PER_DOP)
+         && build_rows + probe_rows >= static_cast<double>(parallel * SKEW_DETECT_MIN_ROWS_PER_DOP);
+}
+
 int JoinPath::compute_hash_hash_sharding_info()
 {
   int ret = OB_SUCCESS;
   ObLogPlan *log_plan = NULL;
   ObIAllocator *allocator = NULL;
   if (OB_ISNULL(left_path_) || OB_ISNULL(left_path_->parent_) || OB_ISNULL(parent_) ||
+      OB_ISNULL(right_path_) ||
       OB_ISNULL(allocator = left_path_->parent_->get_allocator()) ||
       OB_ISNULL(log_plan = left_path_->parent_->get_plan())) {
     ret = OB_ERR_UNEXPECTED;
@@ -5947,15 +5962,21 @@ int JoinPath::compute_hash_hash_sharding_info()
       // should check is_naaj - #issue/46230785
       if (OB_SUCC(ret) && !is_naaj_ && 1 == equal_join_conditions_.count()) {
         ObArray<ObObj> popular_values;
+        bool need_skew_detect = false;
         if (OB_FAIL(log_plan->check_if_use_hybrid_hash_distribution(
                     log_plan->get_optimizer_context(),
                     log_plan->get_stmt(),
                     join_type_,
                     *right_expr,
-                    popular_values))) {
+                    popular_values,
+                    need_skew_detect))) {
           LOG_WARN("fail check if use hybrid hash distribution", K(ret));
-        } else if (popular_values.count() > 0) {
-          use_hybrid_hash_dm_ = true;
+        } else {
+          need_skew_detect_ = need_skew_detect
+              && need_runtime_skew_detect(std::max(left_path_->parallel_, right_path_->parallel_),
+                                          left_path_->get_path_output_rows(),
+                                          right_path_->get_path_output_rows());
+          use_hybrid_hash_dm_ = popular_values.count() > 0 || need_skew_detect_;
         }
       }
     }
@@ -7001,6 +7022,7 @@ void JoinPath::reuse()
   join_algo_ = INVALID_JOIN_ALGO;
   join_dist_algo_ = DistAlgo::DIST_INVALID_METHOD;
   is_slave_mapping_ = false;
+  need_skew_detect_ = false;
   join_type_ = UNKNOWN_JOIN;
   need_mat_ = false;
   left_need_sort_ = false;
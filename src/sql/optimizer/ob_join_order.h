@@ -723,6 +723,7 @@ struct EstimateCostInfo {
       join_dist_algo_(DistAlgo::DIST_INVALID_METHOD),
       is_slave_mapping_(false),
       use_hybrid_hash_dm_(false),
+      need_skew_detect_(false),
       join_type_(UNKNOWN_JOIN),
       need_mat_(false),
       left_need_sort_(false),
@@ -758,6 +759,7 @@ struct EstimateCostInfo {
         join_dist_algo_(join_dist_algo),
         is_slave_mapping_(is_slave_mapping),
         use_hybrid_hash_dm_(false),
+        need_skew_detect_(false),
         join_type_(join_type),
         need_mat_(need_mat),
         left_need_sort_(false),
@@ -936,6 +938,15 @@ struct EstimateCostInfo {
       }
       return ret;
     }
+    // build side rows of each worker needed by runtime skew detection, a task samples
+    // at most 90 header rows, fewer build rows make the sample meaningless.
+    static const int64_t SKEW_DETECT_MIN_BUILD_ROWS_PER_DOP = 1000;
+    // join input rows of each worker needed by runtime skew detection
+    static const int64_t SKEW_DETECT_MIN_ROWS_PER_DOP = 10000;
+    // cost check of runtime skew detection for hybrid hash distribution
+    static bool need_runtime_skew_detect(const int64_t parallel,
+                                         const double build_rows,
+                                         const double probe_rows);
     static int compute_join_path_parallel_and_server_info(const common::ObAddr &local_server_addr,
                                                           const Path *left_path,
                                                           const Path *right_path,
@@ -984,6 +995,7 @@ struct EstimateCostInfo {
     DistAlgo join_dist_algo_; // e.g, partition_wise_join, repartition, hash-hash
     bool is_slave_mapping_; // whether should enable slave mapping
     bool use_hybrid_hash_dm_; // if use hybrid hash distribution method for hash-hash dm
+    bool need_skew_detect_; // if detect skewed values at runtime for hybrid hash dm
     ObJoinType join_type_;
     bool need_mat_;
     // for merge joins only
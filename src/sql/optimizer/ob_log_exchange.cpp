@@ -588,6 +588,7 @@ int ObLogExchange::set_exchange_info(const ObExchangeInfo &exch_info)
       LOG_WARN("failed to assign sort keys", K(ret));
     } else {
       is_rollup_hybrid_ = exch_info.is_rollup_hybrid_;
+      need_skew_detect_ = exch_info.need_skew_detect_;
       need_null_aware_shuffle_ = exch_info.need_null_aware_shuffle_;
       calc_part_id_expr_ = exch_info.calc_part_id_expr_;
       is_wf_hybrid_ = exch_info.is_wf_hybrid_;
@@ -47,6 +47,7 @@ public:
       repartition_sub_keys_(),
       repartition_func_exprs_(),
       calc_part_id_expr_(NULL),
+      need_skew_detect_(false),
       dist_method_(ObPQDistributeMethod::LOCAL), // pull to local
       unmatch_row_dist_method_(ObPQDistributeMethod::LOCAL),
       null_row_dist_method_(ObNullDistributeMethod::NONE),
@@ -98,6 +99,7 @@ public:
   const common::ObIArray<ObRawExpr *> &get_repart_func_exprs() const {return repartition_func_exprs_;}
   const common::ObIArray<ObExchangeInfo::HashExpr> &get_hash_dist_exprs() const {return hash_dist_exprs_;}
   const common::ObIArray<common::ObObj> *get_popular_values() const {return &popular_values_;}
+  bool need_skew_detect() const { return need_skew_detect_; }
   const ObRawExpr *get_calc_part_id_expr() { return calc_part_id_expr_; }
   ObRepartitionType get_repartition_type() const {return repartition_type_;}
   int64_t get_repartition_ref_table_id() const {return repartition_ref_table_id_;}
@@ -237,6 +239,7 @@ private:
   ObRawExpr *calc_part_id_expr_;
   common::ObSEArray<ObExchangeInfo::HashExpr, 4, common::ModulePageAllocator, true> hash_dist_exprs_;
   common::ObSEArray<ObObj, 20, common::ModulePageAllocator, true> popular_values_; // for hybrid hash distr
+  bool need_skew_detect_; // for hybrid hash distr, detect skewed values at runtime
 
   ObPQDistributeMethod::Type dist_method_;
   ObPQDistributeMethod::Type unmatch_row_dist_method_;
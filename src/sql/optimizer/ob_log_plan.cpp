@@ -4566,6 +4566,7 @@ int ObLogPlan::compute_join_exchange_info(JoinPath &join_path,
     if (join_path.is_slave_mapping_) {
       if (OB_FAIL(compute_hash_distribution_info(join_path.join_type_,
                                                  join_path.use_hybrid_hash_dm_,
+                                                 join_path.need_skew_detect_,
                                                  join_path.equal_join_conditions_,
                                                  join_path.left_path_->parent_->get_output_tables(),
                                                  left_exch_info,
@@ -4594,6 +4595,7 @@ int ObLogPlan::compute_join_exchange_info(JoinPath &join_path,
       if (join_path.is_slave_mapping_) {
         if (OB_FAIL(compute_hash_distribution_info(join_path.join_type_,
                                                    join_path.use_hybrid_hash_dm_,
+                                                   join_path.need_skew_detect_,
                                                    join_path.equal_join_conditions_,
                                                    join_path.left_path_->parent_->get_output_tables(),
                                                    left_exch_info,
@@ -4625,6 +4627,7 @@ int ObLogPlan::compute_join_exchange_info(JoinPath &join_path,
       if (join_path.is_slave_mapping_) {
         if (OB_FAIL(compute_hash_distribution_info(join_path.join_type_,
                                                    join_path.use_hybrid_hash_dm_,
+                                                   join_path.need_skew_detect_,
                                                    join_path.equal_join_conditions_,
                                                    join_path.left_path_->parent_->get_output_tables(),
                                                    left_exch_info,
@@ -4711,6 +4714,7 @@ int ObLogPlan::compute_join_exchange_info(JoinPath &join_path,
   } else if (DistAlgo::DIST_HASH_HASH == join_path.join_dist_algo_) {
     if (OB_FAIL(compute_hash_distribution_info(join_path.join_type_,
                                                join_path.use_hybrid_hash_dm_,
+                                               join_path.need_skew_detect_,
                                                join_path.equal_join_conditions_,
                                                join_path.left_path_->parent_->get_output_tables(),
                                                left_exch_info,
@@ -4884,11 +4888,13 @@ int ObLogPlan::check_if_use_hybrid_hash_distribution(ObOptimizerContext &optimiz
                                                      const ObDMLStmt *stmt,
                                                      ObJoinType join_type,
                                                      ObRawExpr  &expr,
-                                                     ObIArray<ObObj> &popular_values) const
+                                                     ObIArray<ObObj> &popular_values,
+                                                     bool &need_skew_detect) const
 {
   int ret = OB_SUCCESS;
   ObSQLSessionInfo* session_info = optimizer_ctx.get_session_info();
   bool enable_skew_handling = optimizer_ctx.get_session_info()->get_px_join_skew_handling();
+  need_skew_detect = false;
   if (OB_SUCC(ret)
       && enable_skew_handling
       && expr.is_column_ref_expr()
@@ -4905,6 +4911,10 @@ int ObLogPlan::check_if_use_hybrid_hash_distribution(ObOptimizerContext &optimiz
       LOG_WARN("fail get hisstogram by join exprs", K(ret));
     } else if (OB_FAIL(get_popular_values_hash(get_allocator(), handle, popular_values))) {
       LOG_WARN("fail get popular values hash", K(ret));
+    } else {
+      // histogram may be missing or stale, the build side may sample the skewed values,
+      // see JoinPath::need_runtime_skew_detect() for the cost check.
+      need_skew_detect = session_info->get_px_join_skew_runtime_detect();
     }
   }
   return ret;
@@ -4978,6 +4988,7 @@ int ObLogPlan::assign_right_popular_value_to_left(ObExchangeInfo &left_exch_info
 
 int ObLogPlan::compute_hash_distribution_info(const ObJoinType &join_type,
                                               const bool enable_hybrid_hash_dm,
+                                              const bool need_skew_detect,
                                               const ObIArray<ObRawExpr*> &join_exprs,
                                               const ObRelIds &left_table_set,
                                               ObExchangeInfo &left_exch_info,
@@ -5018,16 +5029,21 @@ int ObLogPlan::compute_hash_distribution_info(const ObJoinType &join_type,
       // for now, only support hybrid hash DM with only 1 base column join condition
       // after DSQ supported, we can do better with more scenarios.
       if (enable_hybrid_hash_dm && right_exch_info.hash_dist_exprs_.count() > 0) {
+        bool can_skew_detect = false;
         if (OB_FAIL(check_if_use_hybrid_hash_distribution(
                     optimizer_context_,
                     get_stmt(),
                     join_type,
                     *right_exch_info.hash_dist_exprs_.at(0).expr_,
-                    right_exch_info.popular_values_))) {
+                    right_exch_info.popular_values_,
+                    can_skew_detect))) {
           LOG_WARN("fail check use hybrid hash dist", K(ret));
         } else if (OB_FAIL(assign_right_popular_value_to_left(left_exch_info, right_exch_info))) {
           LOG_WARN("fail to assign right exch info popular value to left", K(ret), K(left_exch_info), K(right_exch_info));
         } else {
+          // whether runtime detection pays off is decided by join path with row estimation
+          right_exch_info.need_skew_detect_ = can_skew_detect && need_skew_detect;
+          left_exch_info.need_skew_detect_ = right_exch_info.need_skew_detect_;
           left_exch_info.dist_method_ = ObPQDistributeMethod::HYBRID_HASH_BROADCAST;
           right_exch_info.dist_method_ = ObPQDistributeMethod::HYBRID_HASH_RANDOM;
         }
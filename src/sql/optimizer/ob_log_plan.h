@@ -450,7 +450,8 @@ public:
                                             const ObDMLStmt *stmt,
                                             ObJoinType join_type,
                                             ObRawExpr  &expr,
-                                            common::ObIArray<common::ObObj> &popular_values) const;
+                                            common::ObIArray<common::ObObj> &popular_values,
+                                            bool &need_skew_detect) const;
   int get_source_table_info(ObLogicalOperator &child_op,
                                uint64_t source_table_id,
                                ObShardingInfo *&sharding_info,
@@ -602,6 +603,7 @@ public:
 
   int compute_hash_distribution_info(const ObJoinType &join_type,
                                      const bool enable_hybrid_hash_dm,
+                                     const bool need_skew_detect,
                                      const ObIArray<ObRawExpr*> &join_exprs,
                                      const ObRelIds &left_table_set,
                                      ObExchangeInfo &left_exch_info,
@@ -193,6 +193,7 @@ int ObExchangeInfo::assign(ObExchangeInfo &other)
     repartition_table_name_ = other.repartition_table_name_;
     calc_part_id_expr_ = other.calc_part_id_expr_;
     dist_method_ = other.dist_method_;
+    need_skew_detect_ = other.need_skew_detect_;
     unmatch_row_dist_method_ = other.unmatch_row_dist_method_;
     null_row_dist_method_ = other.null_row_dist_method_;
     slave_mapping_type_ = other.slave_mapping_type_;
@@ -443,6 +443,7 @@ struct ObExchangeInfo
     calc_part_id_expr_(NULL),
     hash_dist_exprs_(),
     popular_values_(),
+    need_skew_detect_(false),
     dist_method_(ObPQDistributeMethod::LOCAL), // pull to local
     unmatch_row_dist_method_(ObPQDistributeMethod::LOCAL),
     null_row_dist_method_(ObNullDistributeMethod::NONE),
@@ -499,6 +500,8 @@ struct ObExchangeInfo
   common::ObSEArray<HashExpr, 4> hash_dist_exprs_;
   // for hybrid hash distr
   common::ObSEArray<ObObj, 20> popular_values_;
+  // detect skewed values by sampling build side at runtime
+  bool need_skew_detect_;
   ObPQDistributeMethod::Type dist_method_;
   ObPQDistributeMethod::Type unmatch_row_dist_method_;
   ObNullDistributeMethod::Type null_row_dist_method_;
@@ -536,6 +539,7 @@ struct ObExchangeInfo
                K_(repartition_sub_keys),
                K_(hash_dist_exprs),
                "dist_method", ObPQDistributeMethod::get_type_string(dist_method_),
+               K_(need_skew_detect),
                K_(repartition_func_exprs),
                K_(repart_all_tablet_ids),
                K_(slave_mapping_type),
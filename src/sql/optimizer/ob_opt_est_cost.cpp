@@ -338,9 +338,11 @@ int ObOptEstCost::cost_table_for_parallel(const ObCostTableScanInfo &est_cost_in
   return ret;
 }
 
-double ObOptEstCost::cost_late_materialization_table_get(int64_t column_cnt, MODEL_TYPE model_type)
+double ObOptEstCost::cost_late_materialization_table_get(int64_t column_cnt,
+                                                         bool use_column_store,
+                                                         MODEL_TYPE model_type)
 {
-  return get_model(model_type).cost_late_materialization_table_get(column_cnt);
+  return get_model(model_type).cost_late_materialization_table_get(column_cnt, use_column_store);
 }
 
 void ObOptEstCost::cost_late_materialization_table_join(double left_card,
@@ -362,12 +364,14 @@ void ObOptEstCost::cost_late_materialization_table_join(double left_card,
 void ObOptEstCost::cost_late_materialization(double left_card,
                                              double left_cost,
                                              int64_t column_count,
+                                             bool use_column_store,
                                              double &cost,
                                              MODEL_TYPE model_type)
 {
   get_model(model_type).cost_late_materialization(left_card,
                                                   left_cost,
                                                   column_count,
+                                                  use_column_store,
                                                   cost);
 }
 
@@ -148,7 +148,9 @@ public:
                                      double &cost,
                                      MODEL_TYPE model_type);
 
-  static double cost_late_materialization_table_get(int64_t column_cnt, MODEL_TYPE model_type);
+  static double cost_late_materialization_table_get(int64_t column_cnt,
+                                                    bool use_column_store,
+                                                    MODEL_TYPE model_type);
 
   static void cost_late_materialization_table_join(double left_card,
                                                    double left_cost,
@@ -161,6 +163,7 @@ public:
   static void cost_late_materialization(double left_card,
                                         double left_cost,
                                         int64_t column_count,
+                                        bool use_column_store,
                                         double &cost,
                                         MODEL_TYPE model_type);
 
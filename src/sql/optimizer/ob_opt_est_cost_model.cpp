@@ -1160,12 +1160,16 @@ double ObOptEstCostModel::cost_material(const double rows, const double average_
 }
 
 
-double ObOptEstCostModel::cost_late_materialization_table_get(int64_t column_cnt)
+double ObOptEstCostModel::cost_late_materialization_table_get(int64_t column_cnt,
+                                                              bool use_column_store)
 {
   double op_cost = 0.0;
   bool is_get = true;
-  bool use_column_store = false;
+  // column store reads one micro block from each column group fetched by the table get
   double io_cost = cost_params_.MICRO_BLOCK_SEQ_COST;
+  if (use_column_store && column_cnt > 1) {
+    io_cost *= column_cnt;
+  }
   double cpu_cost = (cost_params_.CPU_TUPLE_COST
                          + project_params_[use_column_store][is_get][PROJECT_INT] * column_cnt);
   op_cost = io_cost + cpu_cost;
@@ -1193,11 +1197,12 @@ void ObOptEstCostModel::cost_late_materialization_table_join(double left_card,
 void ObOptEstCostModel::cost_late_materialization(double left_card,
 																									double left_cost,
 																									int64_t column_count,
+																									bool use_column_store,
 																									double &cost)
 {
   double op_cost = 0.0;
   double right_card = 1.0;
-  double right_cost = cost_late_materialization_table_get(column_count);
+  double right_cost = cost_late_materialization_table_get(column_count, use_column_store);
   cost_late_materialization_table_join(left_card,
                                        left_cost,
                                        right_card,
@@ -908,7 +908,7 @@ public:
 
   double cost_hash(double rows, const ObIArray<ObRawExpr *> &hash_exprs);
 
-  double cost_late_materialization_table_get(int64_t column_cnt);
+  double cost_late_materialization_table_get(int64_t column_cnt, bool use_column_store);
 
   void cost_late_materialization_table_join(double left_card,
 																						double left_cost,
@@ -919,6 +919,7 @@ public:
   void cost_late_materialization(double left_card,
 																double left_cost,
 																int64_t column_count,
+																bool use_column_store,
 																double &cost);
 
   int get_sort_cmp_cost(const common::ObIArray<sql::ObExprResType> &types, double &cost);
@@ -7078,16 +7078,24 @@ int ObSelectLogPlan::generate_late_materialization_table_get(ObLogTableScan *ind
     table_scan->get_table_name() = table_item->alias_name_.length() > 0 ?
                                    table_item->alias_name_ : table_item->table_name_;
     // set card and cost
-    table_scan->set_card(1.0);
-    table_scan->set_op_cost(ObOptEstCost::cost_late_materialization_table_get(stmt->get_column_size(),
-                                                                              get_optimizer_context().get_cost_model_type()));
-    table_scan->set_cost(table_scan->get_op_cost());
-    est_cost_info->output_row_count_ = 1.0;
-    est_cost_info->phy_query_range_row_count_ = 1.0;
-    est_cost_info->logical_query_range_row_count_ = 1.0;
-    est_cost_info->use_column_store_ = false;
-    table_scan->set_est_cost_info(est_cost_info);
-    table_get = table_scan;
+    int64_t fetch_column_cnt = 0;
+    bool fetch_by_column_group = false;
+    if (OB_FAIL(get_late_materialization_fetch_info(index_scan, fetch_column_cnt, fetch_by_column_group))) {
+      LOG_WARN("failed to get late materialization fetch info", K(ret));
+    } else {
+      table_scan->set_card(1.0);
+      table_scan->set_op_cost(ObOptEstCost::cost_late_materialization_table_get(
+                                  fetch_column_cnt,
+                                  fetch_by_column_group,
+                                  get_optimizer_context().get_cost_model_type()));
+      table_scan->set_cost(table_scan->get_op_cost());
+      est_cost_info->output_row_count_ = 1.0;
+      est_cost_info->phy_query_range_row_count_ = 1.0;
+      est_cost_info->logical_query_range_row_count_ = 1.0;
+      est_cost_info->use_column_store_ = false;
+      table_scan->set_est_cost_info(est_cost_info);
+      table_get = table_scan;
+    }
   }
   return ret;
 }
@@ -7248,12 +7256,18 @@ int ObSelectLogPlan::if_plan_need_late_materialization(ObLogicalOperator *top,
   // update cost for late materialization
   if (OB_SUCC(ret) && need) {
     double op_cost = 0.0;
+    int64_t fetch_column_cnt = 0;
+    bool fetch_by_column_group = false;
     // estimate cost
     if (OB_FAIL(ObOptEstCost::cost_table(*table_scan->get_est_cost_info(),
                                           table_scan->get_parallel(),
                                           op_cost,
                                           get_optimizer_context().get_cost_model_type()))) {
       LOG_WARN("failed to get index access info", K(ret));
+    } else if (OB_FAIL(get_late_materialization_fetch_info(table_scan,
+                                                           fetch_column_cnt,
+                                                           fetch_by_column_group))) {
+      LOG_WARN("failed to get late materialization fetch info", K(ret));
     } else if (OB_FAIL(child_sort->est_cost())) {
       LOG_WARN("failed to compute property", K(ret));
     } else if (OB_FAIL(top->est_cost())) {
@@ -7261,7 +7275,8 @@ int ObSelectLogPlan::if_plan_need_late_materialization(ObLogicalOperator *top,
     } else {
       ObOptEstCost::cost_late_materialization(top->get_card(),
                                               top->get_cost(),
-                                              stmt->get_column_size(),
+                                              fetch_column_cnt,
+                                              fetch_by_column_group,
                                               late_mater_cost,
                                               get_optimizer_context().get_cost_model_type());
       table_scan->set_cost(op_cost);
@@ -7475,6 +7490,57 @@ int ObSelectLogPlan::adjust_est_cost_info_for_column_store_plan(ObLogTableScan *
   return ret;
 }
 
+// Row store table get reads the whole row, all columns of stmt are projected by it.
+// Column store table get only projects the columns which are not accessed by the driving
+// scan, e.g. the wide select list of `select * ... order by ... limit`. Storage reads them
+// from the row store column group if there is one, otherwise one micro block per column group.
+int ObSelectLogPlan::get_late_materialization_fetch_info(const ObLogTableScan *index_scan,
+                                                         int64_t &column_cnt,
+                                                         bool &fetch_by_column_group)
+{
+  int ret = OB_SUCCESS;
+  const ObDMLStmt *stmt = NULL;
+  const ObTableSchema *table_schema = NULL;
+  bool has_all_column_group = false;
+  column_cnt = 0;
+  fetch_by_column_group = false;
+  if (OB_ISNULL(index_scan) || OB_ISNULL(index_scan->get_est_cost_info()) ||
+      OB_ISNULL(stmt = get_stmt()) || OB_ISNULL(get_optimizer_context().get_sql_schema_guard())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("get unexpected null", K(index_scan), K(stmt), K(ret));
+  } else if (!index_scan->use_column_store()) {
+    column_cnt = stmt->get_column_size();
+  } else if (OB_FAIL(get_optimizer_context().get_sql_schema_guard()->get_table_schema(
+                     index_scan->get_table_id(),
+                     index_scan->get_ref_table_id(),
+                     stmt,
+                     table_schema))) {
+    LOG_WARN("failed to get table schema", K(ret));
+  } else if (OB_ISNULL(table_schema)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("get unexpected null", K(table_schema), K(ret));
+  } else if (OB_FAIL(table_schema->has_all_column_group(has_all_column_group))) {
+    LOG_WARN("failed to check has row store", K(ret));
+  } else {
+    fetch_by_column_group = !has_all_column_group;
+    const ObIArray<uint64_t> &access_columns = index_scan->get_est_cost_info()->access_columns_;
+    for (int64_t i = 0; OB_SUCC(ret) && i < stmt->get_column_size(); i++) {
+      const ColumnItem *item = stmt->get_column_item(i);
+      if (OB_ISNULL(item) || OB_ISNULL(item->get_expr())) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("get unexpected null", K(item), K(ret));
+      } else if (item->table_id_ != index_scan->get_table_id() ||
+                 item->get_expr()->is_virtual_generated_column() ||
+                 ObOptimizerUtil::find_item(access_columns, item->base_cid_)) {
+        // do nothing
+      } else {
+        ++column_cnt;
+      }
+    }
+  }
+  return ret;
+}
+
 int ObSelectLogPlan::if_stmt_need_late_materialization(bool &need)
 {
   int ret = OB_SUCCESS;
@@ -861,6 +861,10 @@ private:
   int adjust_est_cost_info_for_column_store_plan(ObLogTableScan *table_scan,
                                                  ObIArray<uint64_t> &used_column_ids);
 
+  int get_late_materialization_fetch_info(const ObLogTableScan *index_scan,
+                                          int64_t &column_cnt,
+                                          bool &fetch_by_column_group);
+
   int if_stmt_need_late_materialization(bool &need);
 
   int candi_allocate_unpivot();
@@ -83,6 +83,7 @@ static const NonReservedKeyword Mysql_none_reserved_keywords[] =
   {"blob", BLOB},
   {"block", BLOCK},
   {"block_size", BLOCK_SIZE},
+  {"bloom_filter", BLOOM_FILTER},
   {"bool", BOOL},
   {"boolean", BOOLEAN},
   {"bootstrap", BOOTSTRAP},
@@ -537,6 +538,7 @@ static const NonReservedKeyword Mysql_none_reserved_keywords[] =
   {"nested", NESTED},
   {"new", NEW},
   {"next", NEXT},
+  {"ngram_bloom_filter", NGRAM_BLOOM_FILTER},
   {"no", NO},
   {"no_write_to_binlog", NO_WRITE_TO_BINLOG},
   {"noarchivelog", NOARCHIVELOG},
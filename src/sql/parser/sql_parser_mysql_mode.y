@@ -309,7 +309,7 @@ END_P SET_VAR DELIMITER
         MULTILINESTRING MULTIPOINT MULTIPOLYGON MUTEX MYSQL_ERRNO MIGRATION MAX_USED_PART_ID MAXIMIZE
         MATERIALIZED MEMBER MEMSTORE_PERCENT MINVALUE MY_NAME
 
-        NAME NAMES NAMESPACE NATIONAL NCHAR NDB NDBCLUSTER NESTED NEW NEXT NO NOAUDIT NODEGROUP NONE NORMAL NOW NOWAIT
+        NAME NAMES NAMESPACE NATIONAL NCHAR NDB NDBCLUSTER NESTED NEW NEXT NGRAM_BLOOM_FILTER NO NOAUDIT NODEGROUP NONE NORMAL NOW NOWAIT
         NOMINVALUE NOMAXVALUE NOORDER NOCYCLE NOCACHE NO_WAIT NULLS NUMBER NVARCHAR NTILE NTH_VALUE NOARCHIVELOG NETWORK NOPARALLEL
         NULL_IF_EXETERNAL
 
@@ -18382,6 +18382,14 @@ MIN_MAX
 {
   malloc_terminal_node($$, result->malloc_pool_, T_COL_SKIP_INDEX_SUM)
 }
+| BLOOM_FILTER
+{
+  malloc_terminal_node($$, result->malloc_pool_, T_COL_SKIP_INDEX_BLOOM_FILTER);
+}
+| NGRAM_BLOOM_FILTER
+{
+  malloc_terminal_node($$, result->malloc_pool_, T_COL_SKIP_INDEX_NGRAM_BLOOM_FILTER);
+}
 ;
 
 unreserved_keyword:
@@ -18762,6 +18770,7 @@ ACCOUNT
 |       NESTED
 |       NEW
 |       NEXT
+|       NGRAM_BLOOM_FILTER
 |       NO
 |       NOARCHIVELOG
 |       NOAUDIT
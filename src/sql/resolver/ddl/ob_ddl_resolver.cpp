@@ -2252,6 +2252,8 @@ int ObDDLResolver::resolve_file_format(const ParseNode *node, ObExternalFileForm
         ObString string_v = ObString(node->children_[0]->str_len_, node->children_[0]->str_value_).trim_space_only();
         if (0 == string_v.case_compare("CSV")) {
           format.format_type_ = ObExternalFileFormat::CSV_FORMAT;
+        } else if (0 == string_v.case_compare("PARQUET")) {
+          format.format_type_ = ObExternalFileFormat::PARQUET_FORMAT;
         } else {
           ObSqlString err_msg;
           err_msg.append_fmt("format '%.*s'", string_v.length(), string_v.ptr());
@@ -11272,6 +11274,19 @@ int ObDDLResolver::build_column_group(
   return ret;
 }
 
+// aggregate rows with bloom filters can't be read by observers before 4.3.0.1
+int ObDDLResolver::check_skip_index_bloom_filter_supported(const uint64_t tenant_data_version)
+{
+  int ret = OB_SUCCESS;
+  if (tenant_data_version < DATA_VERSION_4_3_0_1) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("tenant data version is less than 4.3.0.1, bloom filter skip index is not supported",
+        K(ret), K(tenant_data_version));
+    LOG_USER_ERROR(OB_NOT_SUPPORTED, "tenant data version is less than 4.3.0.1, bloom filter skip index");
+  }
+  return ret;
+}
+
 int ObDDLResolver::resolve_column_skip_index(
     const ParseNode &skip_index_node,
     ObColumnSchemaV2 &column_schema)
@@ -11319,6 +11334,22 @@ int ObDDLResolver::resolve_column_skip_index(
           //   skip_index_column_attr.set_sum();
           //   break;
           // }
+          case T_COL_SKIP_INDEX_BLOOM_FILTER: {
+            if (OB_FAIL(check_skip_index_bloom_filter_supported(tenant_data_version))) {
+              LOG_WARN("bloom filter skip index is not supported", K(ret), K(tenant_data_version));
+            } else {
+              skip_index_column_attr.set_bloom_filter();
+            }
+            break;
+          }
+          case T_COL_SKIP_INDEX_NGRAM_BLOOM_FILTER: {
+            if (OB_FAIL(check_skip_index_bloom_filter_supported(tenant_data_version))) {
+              LOG_WARN("ngram bloom filter skip index is not supported", K(ret), K(tenant_data_version));
+            } else {
+              skip_index_column_attr.set_ngram_bloom_filter();
+            }
+            break;
+          }
           default: {
             ret = OB_NOT_SUPPORTED;
             LOG_WARN("invalid skip index type", K(ret), K(i), K(type_node->type_));
@@ -535,6 +535,7 @@ protected:
   int resolve_column_skip_index(
       const ParseNode &skip_index_node,
       share::schema::ObColumnSchemaV2 &column_schema);
+  int check_skip_index_bloom_filter_supported(const uint64_t tenant_data_version);
   int check_skip_index(share::schema::ObTableSchema &table_schema);
   /*
   int resolve_generated_column_definition(
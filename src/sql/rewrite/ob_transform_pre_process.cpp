@@ -44,6 +44,7 @@
 #include "sql/privilege_check/ob_ora_priv_check.h"
 #include "sql/resolver/dml/ob_insert_all_stmt.h"
 #include "sql/engine/expr/ob_expr_align_date4cmp.h"
+#include "share/table/ob_ttl_util.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::share;
@@ -171,6 +172,15 @@ int ObTransformPreProcess::transform_one_stmt(common::ObIArray<ObParentDMLStmt>
         LOG_TRACE("succeed to transform for temporary table", K(is_happened), K(ret));
       }
     }
+    if (OB_SUCC(ret)) {
+      if (OB_FAIL(transform_for_ttl_table(stmt, is_happened))) {
+        LOG_WARN("failed to transform for ttl table", K(ret));
+      } else {
+        trans_happened |= is_happened;
+        OPT_TRACE("transform for ttl table:", is_happened);
+        LOG_TRACE("succeed to transform for ttl table", K(is_happened), K(ret));
+      }
+    }
     if (OB_SUCC(ret)) {
       if (OB_FAIL(transform_outerjoin_exprs(stmt, is_happened))) {
         LOG_WARN("failed to transform outer join exprs", K(ret));
@@ -3216,6 +3226,160 @@ int ObTransformPreProcess::collect_all_tableitem(ObDMLStmt *stmt,
   return ret;
 }
 
+/**
+ * @brief transform_for_ttl_table
+ * rows expired by the ttl definition are invisible to user queries before they are
+ * deleted by the ttl task or purged by major compaction, add filter
+ *   (c IS NULL OR c + INTERVAL n unit > NOW(6))
+ * for each ttl expr, so that it could be pushed down to storage as other filters.
+ * UPDATE and DELETE on a single table get the same filter so they agree with SELECT,
+ * the target of a multi table DML can't be replaced by a view and is left as is.
+ */
+int ObTransformPreProcess::transform_for_ttl_table(ObDMLStmt *&stmt, bool &trans_happened)
+{
+  int ret = OB_SUCCESS;
+  trans_happened = false;
+  if (OB_ISNULL(stmt) || OB_ISNULL(ctx_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("null stmt or ctx", K(ret), K(stmt), K(ctx_));
+  } else if (OB_ISNULL(ctx_->session_info_) || OB_ISNULL(ctx_->schema_checker_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session info or schema checker is NULL", K(ret));
+  } else if ((stmt->is_select_stmt()
+              || ((stmt->is_update_stmt() || stmt->is_delete_stmt()) && stmt->is_single_table_stmt()))
+             && ObSQLSessionInfo::USER_SESSION == ctx_->session_info_->get_session_type()) {
+    // inner sessions (e.g. the ttl task) still need to see the expired rows
+    common::ObArray<TableItem*> table_item_list;
+    for (int64_t i = 0; OB_SUCC(ret) && i < stmt->get_from_item_size(); ++i) {
+      const FromItem &from_item = stmt->get_from_item(i);
+      if (from_item.is_joined_) {
+        JoinedTable *joined_table_item = stmt->get_joined_table(from_item.table_id_);
+        if (OB_FAIL(collect_all_tableitem(stmt, joined_table_item, table_item_list))) {
+          LOG_WARN("failed to collect table item", K(ret));
+        }
+      } else if (OB_FAIL(collect_all_tableitem(stmt,
+                                               stmt->get_table_item_by_id(from_item.table_id_),
+                                               table_item_list))) {
+        LOG_WARN("failed to collect table item", K(ret));
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < table_item_list.count(); ++i) {
+      TableItem *table_item = table_item_list.at(i);
+      const ObTableSchema *table_schema = NULL;
+      if (OB_ISNULL(table_item)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("table item is null", K(ret));
+      } else if (!table_item->is_basic_table() || table_item->is_link_table()) {
+        // do nothing
+      } else if (OB_FAIL(ctx_->schema_checker_->get_table_schema(ctx_->session_info_->get_effective_tenant_id(),
+                                                                 table_item->ref_id_,
+                                                                 table_schema))) {
+        LOG_WARN("failed to get table schema", K(ret), K(table_item->ref_id_));
+      } else if (OB_ISNULL(table_schema)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("table should not be null", K(ret), K(table_item->ref_id_));
+      } else if (table_schema->get_ttl_definition().empty()) {
+        // do nothing
+      } else if (stmt->is_single_table_stmt()) {
+        if (OB_FAIL(add_filter_for_ttl_table(*stmt, *table_item, *table_schema))) {
+          LOG_WARN("failed to add filter for ttl table", K(ret));
+        } else {
+          trans_happened = true;
+        }
+      } else {
+        // same as temporary table, add the filter inside a view to keep outer join semantics
+        TableItem *view_table = NULL;
+        ObSelectStmt *ref_query = NULL;
+        TableItem *child_table = NULL;
+        if (OB_FAIL(ObTransformUtils::replace_with_empty_view(ctx_, stmt, view_table, table_item))) {
+          LOG_WARN("failed to create empty view table", K(ret));
+        } else if (OB_FAIL(ObTransformUtils::create_inline_view(ctx_, stmt, view_table, table_item))) {
+          LOG_WARN("failed to create inline view", K(ret));
+        } else if (!view_table->is_generated_table()
+                   || OB_ISNULL(ref_query = view_table->ref_query_)
+                   || !ref_query->is_single_table_stmt()
+                   || OB_ISNULL(child_table = ref_query->get_table_item(0))) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("get unexpected view table", K(ret), K(*view_table));
+        } else if (OB_FAIL(add_filter_for_ttl_table(*ref_query, *child_table, *table_schema))) {
+          LOG_WARN("failed to add filter for ttl table", K(ret));
+        } else {
+          trans_happened = true;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObTransformPreProcess::add_filter_for_ttl_table(ObDMLStmt &stmt,
+                                                    const TableItem &table_item,
+                                                    const ObTableSchema &table_schema)
+{
+  int ret = OB_SUCCESS;
+  ObTableTTLChecker ttl_checker;
+  if (OB_ISNULL(ctx_) || OB_ISNULL(ctx_->session_info_) || OB_ISNULL(ctx_->expr_factory_)
+      || OB_ISNULL(stmt.get_query_ctx())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("some parameter is NULL", K(ret), K(ctx_));
+  } else if (OB_FAIL(ttl_checker.init(table_schema, false/*in_full_column_order*/))) {
+    LOG_WARN("failed to parse ttl definition", K(ret), K(table_schema.get_ttl_definition()));
+  }
+  const ObIArray<ObTableTTLExpr> &ttl_exprs = ttl_checker.get_ttl_definition();
+  for (int64_t i = 0; OB_SUCC(ret) && i < ttl_exprs.count(); ++i) {
+    const ObTableTTLExpr &ttl_expr = ttl_exprs.at(i);
+    ObSqlString predicate_str;
+    ObSEArray<ObQualifiedName, 1> columns;
+    ObSEArray<ObRawExpr*, 2> or_params;
+    ObRawExpr *predicate_expr = NULL;
+    ObRawExpr *not_expired_expr = NULL;
+    ObRawExpr *is_null_expr = NULL;
+    ObRawExpr *filter_expr = NULL;
+    ColumnItem *col_item = NULL;
+    if (OB_FAIL(predicate_str.assign_fmt("`%.*s` + INTERVAL %ld %s > NOW(6)",
+                                         ttl_expr.column_name_.length(), ttl_expr.column_name_.ptr(),
+                                         ttl_expr.interval_, ttl_expr.get_time_unit_str()))) {
+      LOG_WARN("failed to build ttl predicate", K(ret), K(ttl_expr));
+    } else if (OB_FAIL(ObRawExprUtils::build_rls_predicate_expr(predicate_str.string(),
+                                                               *ctx_->expr_factory_,
+                                                               *ctx_->session_info_,
+                                                               columns,
+                                                               predicate_expr))) {
+      LOG_WARN("failed to build ttl predicate expr", K(ret), K(predicate_str));
+    } else if (OB_FAIL(build_rls_filter_expr(stmt, table_item, columns, predicate_expr,
+                                             not_expired_expr))) {
+      LOG_WARN("failed to build ttl filter expr", K(ret));
+    } else if (OB_ISNULL(col_item = stmt.get_column_item(table_item.table_id_,
+                                                         ttl_expr.column_name_))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("ttl column item not found", K(ret), K(ttl_expr));
+    } else if (OB_FAIL(ObRawExprUtils::build_is_not_null_expr(*ctx_->expr_factory_,
+                                                              col_item->expr_,
+                                                              false/*is_not_null*/,
+                                                              is_null_expr))) {
+      LOG_WARN("failed to build is null expr", K(ret));
+    } else if (OB_FAIL(or_params.push_back(is_null_expr))
+               || OB_FAIL(or_params.push_back(not_expired_expr))) {
+      LOG_WARN("failed to push back expr", K(ret));
+    } else if (OB_FAIL(ObRawExprUtils::build_or_exprs(*ctx_->expr_factory_, or_params,
+                                                      filter_expr))) {
+      LOG_WARN("failed to build or expr", K(ret));
+    } else if (OB_FAIL(filter_expr->formalize(ctx_->session_info_))) {
+      LOG_WARN("failed to formalize expr", K(ret));
+    } else if (OB_FAIL(filter_expr->pull_relation_id())) {
+      LOG_WARN("failed to pull relation id", K(ret));
+    } else if (OB_FAIL(stmt.add_condition_expr(filter_expr))) {
+      LOG_WARN("failed to add ttl filter", K(ret));
+    } else {
+      if (filter_expr->has_flag(CNT_CUR_TIME)) {
+        stmt.get_query_ctx()->fetch_cur_time_ = true;
+      }
+      LOG_TRACE("add ttl filter succeed", K(stmt.get_condition_exprs()), KPC(filter_expr));
+    }
+  }
+  return ret;
+}
+
 #ifdef OB_BUILD_LABEL_SECURITY
 /**
  * 假如t1的安全列是 c_label，对应的安全策略是 policy_name, 会在下面三种语句添加filter
@@ -286,6 +286,13 @@ struct DistinctObjMeta
 	int add_filter_for_temporary_table(ObDMLStmt &stmt,
 	                                   const TableItem &table_item,
                                      bool is_trans_scope_temp_table);
+  /*
+   * following functions are used for table with ttl definition
+   */
+  int transform_for_ttl_table(ObDMLStmt *&stmt, bool &trans_happened);
+  int add_filter_for_ttl_table(ObDMLStmt &stmt,
+                               const TableItem &table_item,
+                               const share::schema::ObTableSchema &table_schema);
 #ifdef OB_BUILD_LABEL_SECURITY
 	int transform_for_label_se_table(ObDMLStmt *stmt, bool &trans_happened);
   int add_filter_for_label_se_table(ObDMLStmt &stmt,
@@ -645,6 +645,7 @@ public:
                                  enable_bloom_filter_(true),
                                  px_join_skew_handling_(true),
                                  px_join_skew_minfreq_(30),
+                                 px_join_skew_runtime_detect_(false),
                                  at_type_(ObAuditTrailType::NONE),
                                  sort_area_size_(128*1024*1024),
                                  hash_area_size_(128*1024*1024),
@@ -653,6 +654,7 @@ public:
                                  range_optimizer_max_mem_size_(128*1024*1024),
                                  enable_column_store_(false),
                                  enable_decimal_int_type_(false),
+                                 expr_jit_hot_plan_threshold_(0),
                                  print_sample_ppm_(0),
                                  last_check_ec_ts_(0),
                                  session_(session)
@@ -672,9 +674,11 @@ public:
     int64_t get_print_sample_ppm() const { return ATOMIC_LOAD(&print_sample_ppm_); }
     bool get_px_join_skew_handling() const { return px_join_skew_handling_; }
     int64_t get_px_join_skew_minfreq() const { return px_join_skew_minfreq_; }
+    bool get_px_join_skew_runtime_detect() const { return px_join_skew_runtime_detect_; }
     int64_t get_range_optimizer_max_mem_size() const { return range_optimizer_max_mem_size_; }
     bool get_enable_column_store() const { return enable_column_store_; }
     bool get_enable_decimal_int_type() const { return enable_decimal_int_type_; }
+    int64_t get_expr_jit_hot_plan_threshold() const { return expr_jit_hot_plan_threshold_; }
   private:
     //租户级别配置项缓存session 上，避免每次获取都需要刷新
     bool is_external_consistent_;
@@ -684,6 +688,7 @@ public:
     bool enable_bloom_filter_;
     bool px_join_skew_handling_;
     int64_t px_join_skew_minfreq_;
+    bool px_join_skew_runtime_detect_;
     ObAuditTrailType at_type_;
     int64_t sort_area_size_;
     int64_t hash_area_size_;
@@ -692,6 +697,7 @@ public:
     int64_t range_optimizer_max_mem_size_;
     bool enable_column_store_;
     bool enable_decimal_int_type_;
+    int64_t expr_jit_hot_plan_threshold_;
     // for record sys config print_sample_ppm
     int64_t print_sample_ppm_;
     int64_t last_check_ec_ts_;
@@ -1206,6 +1212,16 @@ public:
     cached_tenant_config_info_.refresh();
     return cached_tenant_config_info_.get_px_join_skew_handling();
   }
+  bool get_px_join_skew_runtime_detect()
+  {
+    cached_tenant_config_info_.refresh();
+    return cached_tenant_config_info_.get_px_join_skew_runtime_detect();
+  }
+  int64_t get_expr_jit_hot_plan_threshold()
+  {
+    cached_tenant_config_info_.refresh();
+    return cached_tenant_config_info_.get_expr_jit_hot_plan_threshold();
+  }
 
   bool is_enable_sql_extension()
   {
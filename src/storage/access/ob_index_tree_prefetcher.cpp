@@ -140,6 +140,9 @@ int ObIndexTreePrefetcher::single_prefetch(ObSSTableReadHandle &read_handle)
   } else if (ObStoreRowIterator::IteratorSingleGet == iter_type_ &&
              OB_FAIL(lookup_in_cache(read_handle))) {
     LOG_WARN("Failed to lookup_in_cache", K(ret));
+  } else if (ObSSTableRowState::IN_BLOCK == read_handle.row_state_ &&
+             OB_FAIL(check_rowkey_bloom_filter(read_handle))) {
+    LOG_WARN("Failed to check rowkey bloom filter", K(ret));
   } else if (ObSSTableRowState::IN_BLOCK == read_handle.row_state_) {
     if (OB_FAIL(init_index_scanner(index_scanner_))) {
       LOG_WARN("Fail to init index scanner", K(ret));
@@ -343,6 +346,46 @@ int ObIndexTreePrefetcher::check_bloom_filter(
   return ret;
 }
 
+const ObRowkeyBloomFilter *ObIndexTreePrefetcher::get_rowkey_bloom_filter(const ObDatumRowkey &rowkey) const
+{
+  const ObRowkeyBloomFilter *bf = nullptr;
+  const ObSSTableMeta &sstable_meta = sstable_meta_handle_.get_sstable_meta();
+  // the filter is built on the whole schema rowkey
+  if (!access_ctx_->query_flag_.is_index_back()
+      && sstable_meta.get_rowkey_bloom_filter().is_valid()
+      && rowkey.get_datum_cnt() == sstable_meta.get_schema_rowkey_column_count()) {
+    bf = &sstable_meta.get_rowkey_bloom_filter();
+  }
+  return bf;
+}
+
+int ObIndexTreePrefetcher::check_rowkey_bloom_filter(ObSSTableReadHandle &read_handle)
+{
+  int ret = OB_SUCCESS;
+  uint64_t hash = 0;
+  const ObRowkeyBloomFilter *bf = get_rowkey_bloom_filter(*read_handle.rowkey_);
+  if (nullptr == bf) {
+  } else if (OB_FAIL(read_handle.rowkey_->murmurhash(0, *datum_utils_, hash))) {
+    LOG_WARN("Fail to calc rowkey hash", K(ret), KPC(read_handle.rowkey_));
+  } else {
+    update_rowkey_bloom_filter_stat(bf->may_contain(hash), read_handle);
+  }
+  return ret;
+}
+
+void ObIndexTreePrefetcher::update_rowkey_bloom_filter_stat(
+    const bool is_contain,
+    ObSSTableReadHandle &read_handle)
+{
+  if (is_contain) {
+    read_handle.is_bf_contain_ = true;
+  } else {
+    read_handle.row_state_ = ObSSTableRowState::NOT_EXIST;
+    ++access_ctx_->table_store_stat_.bf_filter_cnt_;
+  }
+  ++access_ctx_->table_store_stat_.bf_access_cnt_;
+}
+
 int ObIndexTreePrefetcher::prefetch_block_data(
     blocksstable::ObMicroIndexInfo &index_block_info,
     ObMicroBlockDataHandle &micro_handle,
@@ -374,6 +417,11 @@ void ObIndexTreeMultiPrefetcher::reset()
   prefetched_rowkey_cnt_ = 0;
   rowkeys_ = nullptr;
   ext_read_handles_.reset();
+  bf_batch_start_idx_ = -1;
+  bf_batch_cnt_ = 0;
+  pending_data_blocks_.reset();
+  io_index_infos_.reset();
+  io_micro_handles_.reset();
   ObIndexTreePrefetcher::reset();
 }
 
@@ -383,6 +431,9 @@ void ObIndexTreeMultiPrefetcher::reuse()
   prefetch_rowkey_idx_ = 0;
   prefetched_rowkey_cnt_ = 0;
   rowkeys_ = nullptr;
+  bf_batch_start_idx_ = -1;
+  bf_batch_cnt_ = 0;
+  pending_data_blocks_.reuse();
   ObIndexTreePrefetcher::reuse();
 }
 
@@ -432,6 +483,8 @@ int ObIndexTreeMultiPrefetcher::switch_context(
   } else {
     rowkeys_ = static_cast<const common::ObIArray<blocksstable::ObDatumRowkey> *> (query_range);
     max_handle_prefetching_cnt_ = min(rowkeys_->count(), MAX_MULTIGET_MICRO_DATA_HANDLE_CNT);
+    bf_batch_start_idx_ = -1;
+    bf_batch_cnt_ = 0;
     if (OB_FAIL(ext_read_handles_.prepare_reallocate(max_handle_prefetching_cnt_))) {
       LOG_WARN("Fail to init read_handles", K(ret), K(max_handle_prefetching_cnt_));
     } else if (!is_rescan_) {
@@ -478,6 +531,9 @@ int ObIndexTreeMultiPrefetcher::multi_prefetch()
         if (OB_FAIL(ObStoreRowIterator::IteratorMultiGet == iter_type_ &&
                     lookup_in_cache(read_handle))) {
           LOG_WARN("Failed to lookup_in_cache", K(ret));
+        } else if (ObSSTableRowState::IN_BLOCK == read_handle.row_state_ &&
+                   OB_FAIL(check_rowkey_bloom_filter_batch(read_handle))) {
+          LOG_WARN("Failed to check rowkey bloom filter", K(ret));
         } else if (ObSSTableRowState::IN_BLOCK == read_handle.row_state_) {
           if (OB_FAIL(sstable_->get_index_tree_root(index_block_))) {
             LOG_WARN("Fail to get index block root", K(ret));
@@ -531,6 +587,38 @@ int ObIndexTreeMultiPrefetcher::multi_prefetch()
         }
       }
     }
+    if (OB_SUCC(ret) && OB_FAIL(prefetch_pending_data_blocks())) {
+      LOG_WARN("Fail to prefetch pending data blocks", K(ret), KPC(this));
+    }
+    pending_data_blocks_.reuse();
+  }
+  return ret;
+}
+
+int ObIndexTreeMultiPrefetcher::check_rowkey_bloom_filter_batch(ObSSTableReadHandleExt &read_handle)
+{
+  int ret = OB_SUCCESS;
+  const int64_t rowkey_idx = read_handle.range_idx_;
+  const ObRowkeyBloomFilter *bf = get_rowkey_bloom_filter(*read_handle.rowkey_);
+  if (nullptr == bf) {
+  } else if (rowkey_idx >= bf_batch_start_idx_ && rowkey_idx < bf_batch_start_idx_ + bf_batch_cnt_) {
+    update_rowkey_bloom_filter_stat(bf_batch_contains_[rowkey_idx - bf_batch_start_idx_], read_handle);
+  } else {
+    uint64_t hashes[ObRowkeyBloomFilter::BATCH_SIZE];
+    const int64_t batch_cnt = MIN(ObRowkeyBloomFilter::BATCH_SIZE, rowkeys_->count() - rowkey_idx);
+    bf_batch_start_idx_ = -1;
+    bf_batch_cnt_ = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_cnt; ++i) {
+      if (OB_FAIL(rowkeys_->at(rowkey_idx + i).murmurhash(0, *datum_utils_, hashes[i]))) {
+        LOG_WARN("Fail to calc rowkey hash", K(ret), K(rowkey_idx), K(i));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      bf->batch_may_contain(hashes, batch_cnt, bf_batch_contains_);
+      bf_batch_start_idx_ = rowkey_idx;
+      bf_batch_cnt_ = batch_cnt;
+      update_rowkey_bloom_filter_stat(bf_batch_contains_[0], read_handle);
+    }
   }
   return ret;
 }
@@ -574,11 +662,16 @@ int ObIndexTreeMultiPrefetcher::drill_down(
   } else {
     // hold block cache of the parent temporaliy to avoid freed
     ObMicroBlockDataHandle &next_handle = read_handle.get_read_handle();
-    if (OB_FAIL(prefetch_block_data(index_block_info, next_handle, cur_level_is_leaf))) {
+    if (cur_level_is_leaf) {
+      if (OB_FAIL(prefetch_data_block(index_block_info, next_handle))) {
+        LOG_WARN("fail to prefetch data block", K(ret), K(read_handle), K(index_block_info));
+      } else {
+        read_handle.set_cur_micro_handle(next_handle);
+        mark_cur_rowkey_prefetched(read_handle);
+      }
+    } else if (OB_FAIL(prefetch_block_data(index_block_info, next_handle, cur_level_is_leaf))) {
       LOG_WARN("fail to prefetch_block_data", K(ret), K(read_handle), K(index_block_info), K(cur_level_is_leaf));
     } else if (FALSE_IT(read_handle.set_cur_micro_handle(next_handle))) {
-    } else if (cur_level_is_leaf) {
-      mark_cur_rowkey_prefetched(read_handle);
     } else if (force_prefetch || ObSSTableMicroBlockState::IN_BLOCK_CACHE == next_handle.block_state_) {
       if (ObSSTableMicroBlockState::IN_BLOCK_CACHE == next_handle.block_state_) {
         LOG_DEBUG("cur handle is in cache", K(read_handle), K(index_block_info), K(next_handle));
@@ -607,6 +700,98 @@ int ObIndexTreeMultiPrefetcher::drill_down(
   return ret;
 }
 
+int ObIndexTreeMultiPrefetcher::prefetch_data_block(
+    ObMicroIndexInfo &index_block_info,
+    ObMicroBlockDataHandle &micro_handle)
+{
+  int ret = OB_SUCCESS;
+  if (is_rescan_ && last_handle_hit(index_block_info, true, micro_handle)) {
+    ++access_ctx_->table_store_stat_.block_cache_hit_cnt_;
+    LOG_DEBUG("last micro block handle hits", K(index_block_info), K(last_micro_block_handle_), K(micro_handle));
+  } else if (OB_FAIL(access_ctx_->micro_block_handle_mgr_.get_micro_block_handle(
+              index_block_info,
+              true, /* is data block */
+              false, /* need submit io */
+              micro_handle))) {
+    if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != ret)) {
+      LOG_WARN("Fail to get micro block handle from handle mgr", K(ret), K(index_block_info));
+    } else {
+      ObPendingDataBlock pending_block;
+      pending_block.index_info_ = index_block_info;
+      pending_block.micro_handle_ = &micro_handle;
+      if (OB_FAIL(pending_data_blocks_.push_back(pending_block))) {
+        LOG_WARN("Fail to push back pending data block", K(ret), K(pending_block));
+      }
+    }
+  } else if (is_rescan_ && micro_handle.in_block_state()) {
+    last_micro_block_handle_ = micro_handle;
+  }
+  return ret;
+}
+
+int ObIndexTreeMultiPrefetcher::prefetch_pending_data_blocks()
+{
+  int ret = OB_SUCCESS;
+  if (!pending_data_blocks_.empty()) {
+    io_index_infos_.reuse();
+    io_micro_handles_.reuse();
+    std::sort(pending_data_blocks_.begin(), pending_data_blocks_.end());
+    for (int64_t i = 0; OB_SUCC(ret) && i < pending_data_blocks_.count(); ++i) {
+      const ObPendingDataBlock &pending_block = pending_data_blocks_.at(i);
+      if (i > 0 && pending_block.is_same_block(pending_data_blocks_.at(i - 1))) {
+      } else if (OB_FAIL(io_index_infos_.push_back(pending_block.index_info_))) {
+        LOG_WARN("Fail to push back index info", K(ret), K(pending_block));
+      } else if (OB_FAIL(io_micro_handles_.push_back(pending_block.micro_handle_))) {
+        LOG_WARN("Fail to push back micro handle", K(ret), K(pending_block));
+      }
+    }
+    int64_t start_idx = 0;
+    for (int64_t i = 1; OB_SUCC(ret) && i <= io_index_infos_.count(); ++i) {
+      if (i < io_index_infos_.count() &&
+          can_coalesce_io(io_index_infos_.at(start_idx), io_index_infos_.at(i - 1), io_index_infos_.at(i))) {
+      } else if (OB_FAIL(submit_data_block_io(start_idx, i - start_idx))) {
+        LOG_WARN("Fail to submit data block io", K(ret), K(start_idx), K(i));
+      } else {
+        start_idx = i;
+      }
+    }
+    // the rowkeys in the same data block share the io
+    const ObPendingDataBlock *first_block = nullptr;
+    for (int64_t i = 0; OB_SUCC(ret) && i < pending_data_blocks_.count(); ++i) {
+      const ObPendingDataBlock &pending_block = pending_data_blocks_.at(i);
+      if (nullptr != first_block && pending_block.is_same_block(*first_block)) {
+        *pending_block.micro_handle_ = *first_block->micro_handle_;
+      } else {
+        first_block = &pending_block;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObIndexTreeMultiPrefetcher::submit_data_block_io(const int64_t start_idx, const int64_t block_count)
+{
+  int ret = OB_SUCCESS;
+  ObMicroBlockHandleMgr &handle_mgr = access_ctx_->micro_block_handle_mgr_;
+  if (1 == block_count || handle_mgr.reach_hold_limit()) {
+    for (int64_t i = start_idx; OB_SUCC(ret) && i < start_idx + block_count; ++i) {
+      if (OB_FAIL(handle_mgr.get_micro_block_handle(
+                  io_index_infos_.at(i),
+                  true, /* is data block */
+                  true, /* need submit io */
+                  *io_micro_handles_.at(i)))) {
+        LOG_WARN("Fail to get micro block handle from handle mgr", K(ret), K(io_index_infos_.at(i)));
+      }
+    }
+  } else if (OB_FAIL(handle_mgr.prefetch_multi_data_block(
+              io_index_infos_, start_idx, block_count, io_micro_handles_))) {
+    LOG_WARN("Fail to prefetch multi data blocks", K(ret), K(start_idx), K(block_count));
+  } else {
+    LOG_DEBUG("coalesce data block io", K(start_idx), K(block_count), K(io_index_infos_.at(start_idx)));
+  }
+  return ret;
+}
+
 ////////////////////////////////// MultiPassPrefetcher /////////////////////////////////////////////
 template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
 ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::~ObIndexTreeMultiPassPrefetcher()
@@ -617,6 +802,7 @@ ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::~ObIn
 template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
 void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::reset()
 {
+  recycle_unread_data_blocks();
   for (int64_t i = 0; i < DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT; i++) {
     micro_data_handles_[i].reset();
   }
@@ -635,15 +821,21 @@ void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::
   agg_row_store_ = nullptr;
   max_micro_handle_cnt_ = 0;
   prefetch_depth_ = 1;
+  max_prefetch_depth_ = DATA_PREFETCH_DEPTH;
   total_micro_data_cnt_ = 0;
+  last_io_stall_cnt_ = 0;
+  is_read_ahead_ = false;
   query_range_ = nullptr;
   border_rowkey_.reset();
   read_handles_.reset();
+  read_ahead_index_infos_.reset();
+  read_ahead_handles_.reset();
 }
 
 template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
 void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::reuse()
 {
+  recycle_unread_data_blocks();
   ObIndexTreePrefetcher::reuse();
   clean_blockscan_check_info();
   is_prefetch_end_ = false;
@@ -657,6 +849,9 @@ void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::
   agg_row_store_ = nullptr;
   prefetch_depth_ = 1;
   total_micro_data_cnt_ = 0;
+  is_read_ahead_ = false;
+  read_ahead_index_infos_.reuse();
+  read_ahead_handles_.reuse();
   for (int64_t i = 0; i < tree_handle_cap_; i++) {
     tree_handles_[i].reuse();
   }
@@ -700,7 +895,7 @@ int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::g
 {
   int ret = OB_SUCCESS;
   depth = 0;
-  prefetch_depth_ = MIN(2 * prefetch_depth_, DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT);
+  update_prefetch_depth(micro_data_prefetch_idx_ - cur_micro_data_fetch_idx_ - 1);
   if (need_check_prefetch_depth_) {
     int64_t prefetch_micro_cnt = MAX(1,
           (access_ctx_->limit_param_->offset_ + access_ctx_->limit_param_->limit_ - access_ctx_->out_cnt_ + \
@@ -712,6 +907,111 @@ int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::g
   return ret;
 }
 
+template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
+void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::update_prefetch_depth(const int64_t prefetched_ahead_cnt)
+{
+  const int64_t io_stall_cnt = access_ctx_->micro_block_handle_mgr_.get_io_stall_count();
+  const bool is_stalled = io_stall_cnt != last_io_stall_cnt_ || prefetched_ahead_cnt <= 0;
+  last_io_stall_cnt_ = io_stall_cnt;
+  if (is_stalled) {
+    if (prefetch_depth_ >= max_prefetch_depth_ && max_prefetch_depth_ < DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT) {
+      max_prefetch_depth_++;
+    }
+    prefetch_depth_ = MIN(2 * prefetch_depth_, max_prefetch_depth_);
+  }
+  is_read_ahead_ = prefetch_depth_ >= DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT && is_sequential_scan();
+}
+
+template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
+void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::recycle_unread_data_blocks()
+{
+  int64_t wasted_bytes = 0;
+  if (max_micro_handle_cnt_ > 0) {
+    for (int64_t i = MAX(cur_micro_data_fetch_idx_ + 1, 0); i < micro_data_prefetch_idx_; i++) {
+      const ObMicroBlockDataHandle &micro_handle = micro_data_handles_[i % max_micro_handle_cnt_];
+      if (ObSSTableMicroBlockState::IN_BLOCK_IO == micro_handle.block_state_) {
+        wasted_bytes += micro_handle.micro_info_.size_;
+      }
+    }
+  }
+  if (wasted_bytes > 0) {
+    max_prefetch_depth_ = MAX(1, max_prefetch_depth_ / 2);
+    EVENT_ADD(ObStatEventIds::DATA_BLOCK_PREFETCH_WASTED_BYTES, wasted_bytes);
+    LOG_DEBUG("drop unread prefetched data blocks", K(wasted_bytes), K_(max_prefetch_depth),
+              K_(cur_micro_data_fetch_idx), K_(micro_data_prefetch_idx));
+  }
+}
+
+template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
+int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::prefetch_data_block(
+    ObMicroIndexInfo &block_info,
+    ObMicroBlockDataHandle &micro_handle)
+{
+  int ret = OB_SUCCESS;
+  if (!is_read_ahead_) {
+    if (OB_FAIL(prefetch_block_data(block_info, micro_handle))) {
+      LOG_WARN("fail to prefetch_block_data", K(ret), K(block_info));
+    }
+  } else if (OB_FAIL(access_ctx_->micro_block_handle_mgr_.get_micro_block_handle(
+              block_info,
+              true, /* is data block */
+              false, /* need submit io */
+              micro_handle))) {
+    if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != ret)) {
+      LOG_WARN("Fail to get micro block handle from handle mgr", K(ret), K(block_info));
+    } else if (OB_FAIL(read_ahead_index_infos_.push_back(block_info))) {
+      LOG_WARN("Fail to push back index info", K(ret), K(block_info));
+    } else if (OB_FAIL(read_ahead_handles_.push_back(&micro_handle))) {
+      LOG_WARN("Fail to push back micro handle", K(ret));
+    }
+  }
+  return ret;
+}
+
+template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
+int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::submit_read_ahead_io()
+{
+  int ret = OB_SUCCESS;
+  ObMicroBlockHandleMgr &handle_mgr = access_ctx_->micro_block_handle_mgr_;
+  const int64_t block_cnt = read_ahead_index_infos_.count();
+  int64_t start_idx = 0;
+  for (int64_t i = 1; OB_SUCC(ret) && i <= block_cnt; ++i) {
+    if (i < block_cnt) {
+      const ObMicroIndexInfo &start_info = read_ahead_index_infos_.at(start_idx);
+      const ObMicroIndexInfo &prev_info = read_ahead_index_infos_.at(i - 1);
+      const ObMicroIndexInfo &cur_info = read_ahead_index_infos_.at(i);
+      const int64_t prev_end = prev_info.get_block_offset() + prev_info.get_block_size();
+      const int64_t cur_end = cur_info.get_block_offset() + cur_info.get_block_size();
+      if (start_info.get_macro_id() == cur_info.get_macro_id() &&
+          static_cast<int64_t>(cur_info.get_block_offset()) == prev_end &&
+          cur_end - static_cast<int64_t>(start_info.get_block_offset()) <= MAX_READ_AHEAD_IO_SIZE) {
+        // adjacent block in the same macro block
+        continue;
+      }
+    }
+    if (1 == i - start_idx || handle_mgr.reach_hold_limit()) {
+      for (int64_t j = start_idx; OB_SUCC(ret) && j < i; ++j) {
+        if (OB_FAIL(handle_mgr.get_micro_block_handle(
+                    read_ahead_index_infos_.at(j),
+                    true, /* is data block */
+                    true, /* need submit io */
+                    *read_ahead_handles_.at(j)))) {
+          LOG_WARN("Fail to get micro block handle from handle mgr", K(ret), K(read_ahead_index_infos_.at(j)));
+        }
+      }
+    } else if (OB_FAIL(handle_mgr.prefetch_multi_data_block(
+                read_ahead_index_infos_, start_idx, i - start_idx, read_ahead_handles_))) {
+      LOG_WARN("Fail to prefetch multi data blocks", K(ret), K(start_idx), K(i));
+    } else {
+      LOG_DEBUG("read ahead data blocks", K(start_idx), K(i), K(read_ahead_index_infos_.at(start_idx)));
+    }
+    start_idx = i;
+  }
+  read_ahead_index_infos_.reuse();
+  read_ahead_handles_.reuse();
+  return ret;
+}
+
 template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
 int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::init(
     const int iter_type,
@@ -889,7 +1189,8 @@ template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
 int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::prefetch()
 {
   int ret = OB_SUCCESS;
-  const int32_t prefetch_limit = MAX(2, max_micro_handle_cnt_ / 2);
+  // the blocks prefetched ahead of the consumer are limited by the adaptive prefetch depth
+  const int32_t prefetch_limit = MAX(2, MIN(max_micro_handle_cnt_ / 2, prefetch_depth_));
   if (IS_NOT_INIT) {
     ret = OB_NOT_INIT;
     LOG_WARN("ObIndexTreeMultiPassPrefetcher not init", K(ret));
@@ -1082,8 +1383,8 @@ int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::p
             if (OB_UNLIKELY(OB_ITER_END != ret)) {
               LOG_WARN("Fail to check row lock", K(ret), K(block_info), KPC(this));
             }
-          } else if (OB_FAIL(prefetch_block_data(block_info, micro_data_handles_[prefetch_micro_idx]))) {
-            LOG_WARN("fail to prefetch_block_data", K(ret), K(block_info));
+          } else if (OB_FAIL(prefetch_data_block(block_info, micro_data_handles_[prefetch_micro_idx]))) {
+            LOG_WARN("fail to prefetch data block", K(ret), K(block_info));
           }
 
           if OB_SUCC(ret) {
@@ -1108,6 +1409,13 @@ int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::p
         prefetched_cnt = 0;
       }
     }
+    if ((OB_SUCC(ret) || OB_ITER_END == ret) && !read_ahead_index_infos_.empty()) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_TMP_FAIL(submit_read_ahead_io())) {
+        LOG_WARN("Fail to submit read ahead io", K(tmp_ret));
+        ret = tmp_ret;
+      }
+    }
   }
   LOG_DEBUG("[INDEX BLOCK] prefetched info", K(ret),  KPC(this));
   return ret;
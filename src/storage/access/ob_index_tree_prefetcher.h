@@ -163,6 +163,10 @@ protected:
       const ObMicroIndexInfo &index_info,
       const bool is_multi_check,
       ObSSTableReadHandle &read_handle);
+  // rowkey bloom filter in the sstable meta, nullptr if it can not be used for %rowkey
+  const ObRowkeyBloomFilter *get_rowkey_bloom_filter(const ObDatumRowkey &rowkey) const;
+  int check_rowkey_bloom_filter(ObSSTableReadHandle &read_handle);
+  void update_rowkey_bloom_filter_stat(const bool is_contain, ObSSTableReadHandle &read_handle);
   int prefetch_block_data(
       ObMicroIndexInfo &index_block_info,
       ObMicroBlockDataHandle &micro_handle,
@@ -253,13 +257,36 @@ public:
     ObMicroBlockDataHandle micro_handles_[DEFAULT_MULTIGET_MICRO_DATA_HANDLE_CNT];
   };
   typedef ObReallocatedFixedArray<ObSSTableReadHandleExt> ReadHandleExtArray;
+  // cache missed data block of a rowkey, whose io is submitted at the end of multi_prefetch
+  struct ObPendingDataBlock {
+    ObPendingDataBlock() : index_info_(), micro_handle_(nullptr) {}
+    bool is_same_block(const ObPendingDataBlock &other) const
+    {
+      return index_info_.get_block_offset() == other.index_info_.get_block_offset() &&
+             index_info_.parent_macro_id_ == other.index_info_.parent_macro_id_;
+    }
+    bool operator<(const ObPendingDataBlock &other) const
+    {
+      return index_info_.parent_macro_id_ == other.index_info_.parent_macro_id_ ?
+          index_info_.get_block_offset() < other.index_info_.get_block_offset() :
+          index_info_.parent_macro_id_ < other.index_info_.parent_macro_id_;
+    }
+    TO_STRING_KV(K_(index_info), KP_(micro_handle));
+    ObMicroIndexInfo index_info_;
+    ObMicroBlockDataHandle *micro_handle_;
+  };
   ObIndexTreeMultiPrefetcher() :
       fetch_rowkey_idx_(0),
       prefetch_rowkey_idx_(0),
       prefetched_rowkey_cnt_(0),
       max_handle_prefetching_cnt_(0),
       rowkeys_(nullptr),
-      ext_read_handles_()
+      ext_read_handles_(),
+      bf_batch_start_idx_(-1),
+      bf_batch_cnt_(0),
+      pending_data_blocks_(),
+      io_index_infos_(),
+      io_micro_handles_()
   {}
   virtual ~ObIndexTreeMultiPrefetcher() { reset(); }
   virtual void reset() override;
@@ -300,11 +327,40 @@ public:
   const common::ObIArray<blocksstable::ObDatumRowkey> *rowkeys_;
   ReadHandleExtArray ext_read_handles_;
 private:
+  // the rowkey bloom filter is probed for a batch of rowkeys starting from %read_handle
+  int check_rowkey_bloom_filter_batch(ObSSTableReadHandleExt &read_handle);
   int drill_down(
       const MacroBlockId &macro_id,
       ObSSTableReadHandleExt &read_handle,
       const bool cur_level_is_leaf,
       const bool force_prefetch);
+  // the io of a cache missed data block is delayed to prefetch_pending_data_blocks, so that the
+  // missed blocks of the rowkeys in one multi_prefetch can be coalesced
+  int prefetch_data_block(ObMicroIndexInfo &index_block_info, ObMicroBlockDataHandle &micro_handle);
+  int prefetch_pending_data_blocks();
+  int submit_data_block_io(const int64_t start_idx, const int64_t block_count);
+  OB_INLINE bool can_coalesce_io(
+      const ObMicroIndexInfo &start_info,
+      const ObMicroIndexInfo &prev_info,
+      const ObMicroIndexInfo &cur_info) const
+  {
+    const int64_t prev_end = prev_info.get_block_offset() + prev_info.get_block_size();
+    const int64_t cur_end = cur_info.get_block_offset() + cur_info.get_block_size();
+    return start_info.parent_macro_id_ == cur_info.parent_macro_id_ &&
+           static_cast<int64_t>(cur_info.get_block_offset()) - prev_end <= MAX_COALESCE_IO_GAP &&
+           cur_end - static_cast<int64_t>(start_info.get_block_offset()) <= MAX_COALESCE_IO_SIZE;
+  }
+private:
+  // blocks separated by less than MAX_COALESCE_IO_GAP bytes are read by one io, the gap is
+  // read and dropped
+  static const int64_t MAX_COALESCE_IO_GAP = 16L << 10; // 16KB
+  static const int64_t MAX_COALESCE_IO_SIZE = 512L << 10; // 512KB
+  int64_t bf_batch_start_idx_;
+  int64_t bf_batch_cnt_;
+  bool bf_batch_contains_[ObRowkeyBloomFilter::BATCH_SIZE];
+  common::ObSEArray<ObPendingDataBlock, 4> pending_data_blocks_;
+  common::ObSEArray<ObMicroIndexInfo, 4> io_index_infos_;
+  common::ObSEArray<ObMicroBlockDataHandle *, 4> io_micro_handles_;
 };
 
 template <int32_t DATA_PREFETCH_DEPTH = 32, int32_t INDEX_PREFETCH_DEPTH = 3>
@@ -324,13 +380,18 @@ public:
       need_check_prefetch_depth_(false),
       tree_handle_cap_(0),
       prefetch_depth_(1),
+      max_prefetch_depth_(DATA_PREFETCH_DEPTH),
       max_range_prefetching_cnt_(0),
       max_micro_handle_cnt_(0),
       total_micro_data_cnt_(0),
+      last_io_stall_cnt_(0),
+      is_read_ahead_(false),
       query_range_(nullptr),
       border_rowkey_(),
       read_handles_(),
-      tree_handles_(nullptr)
+      tree_handles_(nullptr),
+      read_ahead_index_infos_(),
+      read_ahead_handles_()
   {}
   virtual ~ObIndexTreeMultiPassPrefetcher();
   virtual void reset() override;
@@ -393,6 +454,7 @@ public:
                        K_(is_prefetch_end), K_(cur_range_fetch_idx), K_(cur_range_prefetch_idx), K_(max_range_prefetching_cnt),
                        K_(cur_micro_data_fetch_idx), K_(micro_data_prefetch_idx), K_(max_micro_handle_cnt),
                        K_(iter_type), K_(cur_level), K_(index_tree_height), K_(prefetch_depth),
+                       K_(max_prefetch_depth), K_(last_io_stall_cnt), K_(is_read_ahead),
                        K_(total_micro_data_cnt), KP_(query_range), K_(border_rowkey), K_(tree_handle_cap),
                        K_(can_blockscan), K_(need_check_prefetch_depth),
                        K(ObArrayWrap<ObIndexTreeLevelHandle>(tree_handles_, index_tree_height_)));
@@ -427,8 +489,26 @@ protected:
   void reset_tree_handles();
   virtual int init_tree_handles(const int64_t count);
   virtual int get_prefetch_depth(int64_t &depth);
+  // Adaptive prefetch depth of data blocks:
+  // the depth doubles (up to max_prefetch_depth_) while the consumer is stalled, i.e. waits for the
+  // io of a prefetched block or finds no block prefetched ahead, and is kept otherwise.
+  // max_prefetch_depth_ is kept across rescans, it is halved when prefetched blocks are dropped unread
+  // (e.g. the scan is stopped by limit) and grows by one when the consumer stalls at the max depth.
+  void update_prefetch_depth(const int64_t prefetched_ahead_cnt);
+  void recycle_unread_data_blocks();
+  // For forward sequential scans whose depth reaches the max, the cache missed data blocks of one
+  // prefetch round are read ahead by macro block: adjacent blocks in the same macro block are read by one io.
+  int prefetch_data_block(ObMicroIndexInfo &block_info, ObMicroBlockDataHandle &micro_handle);
+  int submit_read_ahead_io();
+  OB_INLINE bool is_sequential_scan() const
+  {
+    return (ObStoreRowIterator::IteratorScan == iter_type_ || ObStoreRowIterator::IteratorCOScan == iter_type_) &&
+        !need_check_prefetch_depth_ &&
+        !access_ctx_->query_flag_.is_reverse_scan();
+  }
 
   static const int32_t DEFAULT_SCAN_RANGE_PREFETCH_CNT = 4;
+  static const int64_t MAX_READ_AHEAD_IO_SIZE = 2L << 20; // 2MB, the default macro block size
   static const int32_t DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT = DATA_PREFETCH_DEPTH;
   static const int32_t INDEX_TREE_PREFETCH_DEPTH = INDEX_PREFETCH_DEPTH;
   static const int32_t SSTABLE_MICRO_AVG_COUNT = 100;
@@ -603,9 +683,12 @@ protected:
   bool need_check_prefetch_depth_;
   int16_t tree_handle_cap_;
   int16_t prefetch_depth_;
+  int16_t max_prefetch_depth_;
   int32_t max_range_prefetching_cnt_;
   int32_t max_micro_handle_cnt_;
   int64_t total_micro_data_cnt_;
+  int64_t last_io_stall_cnt_;
+  bool is_read_ahead_;
   union {
     const common::ObIArray<blocksstable::ObDatumRowkey> *rowkeys_; // for multi get/multi exist/single exist
     const blocksstable::ObDatumRange *range_; // for scan
@@ -618,6 +701,9 @@ protected:
   ObIndexTreeLevelHandle *tree_handles_;
   ObMicroIndexInfo micro_data_infos_[DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT];
   ObMicroBlockDataHandle micro_data_handles_[DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT];
+  // cache missed data blocks of current prefetch round to read ahead
+  common::ObSEArray<ObMicroIndexInfo, 4> read_ahead_index_infos_;
+  common::ObSEArray<ObMicroBlockDataHandle *, 4> read_ahead_handles_;
 };
 
 }
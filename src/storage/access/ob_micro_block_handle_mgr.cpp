@@ -82,7 +82,7 @@ int ObMicroBlockDataHandle::get_micro_block_data(
     const bool is_data_block)
 {
   int ret = OB_SUCCESS;
-  if (ObSSTableMicroBlockState::NEED_SYNC_IO == block_state_ || OB_FAIL(get_loaded_block_data(block_data))) {
+  if (ObSSTableMicroBlockState::NEED_SYNC_IO == block_state_ || OB_FAIL(get_loaded_block_data(block_data, is_data_block))) {
     if (is_loaded_block_ && loaded_block_data_.is_valid()) {
       LOG_DEBUG("Use sync loaded index block data", K_(macro_block_id),
                 K(loaded_block_data_), K_(io_handle));
@@ -166,7 +166,7 @@ ObMicroBlockDataHandle & ObMicroBlockDataHandle::operator=(const ObMicroBlockDat
   return *this;
 }
 
-int ObMicroBlockDataHandle::get_loaded_block_data(ObMicroBlockData &block_data)
+int ObMicroBlockDataHandle::get_loaded_block_data(ObMicroBlockData &block_data, const bool is_data_block)
 {
   int ret = OB_SUCCESS;
   const ObMicroBlockData *pblock = NULL;
@@ -179,8 +179,12 @@ int ObMicroBlockDataHandle::get_loaded_block_data(ObMicroBlockData &block_data)
       block_data = *pblock;
     }
   } else if (ObSSTableMicroBlockState::IN_BLOCK_IO == block_state_) {
+    const bool is_io_stall = !io_handle_.is_finished();
+    const int64_t wait_begin_time = is_io_stall ? ObTimeUtility::current_time() : 0;
     if (OB_FAIL(io_handle_.wait())) {
       LOG_WARN("Fail to wait micro block io, ", K(ret));
+    } else if (is_io_stall && nullptr != handle_mgr_ &&
+               FALSE_IT(handle_mgr_->add_io_stall(is_data_block, ObTimeUtility::current_time() - wait_begin_time))) {
     } else if (NULL == (io_buf = io_handle_.get_buffer())) {
       ret = OB_INVALID_IO_BUFFER;
       LOG_WARN("Fail to get block data, io may be failed, ", K(ret));
@@ -231,6 +235,7 @@ ObMicroBlockHandleMgr::ObMicroBlockHandleMgr()
     data_block_use_cache_limit_(DEFAULT_DATA_BLOCK_USE_CACHE_LIMIT),
     hold_limit_(HOLD_LIMIT_BASE),
     current_hold_size_(0),
+    io_stall_cnt_(0),
     use_data_block_cache_(true),
     enable_limit_(true),
     is_inited_(false)
@@ -254,6 +259,7 @@ void ObMicroBlockHandleMgr::reset()
   data_block_use_cache_limit_ = DEFAULT_DATA_BLOCK_USE_CACHE_LIMIT;
   hold_limit_ = HOLD_LIMIT_BASE;
   current_hold_size_ = 0;
+  io_stall_cnt_ = 0;
   use_data_block_cache_ = true;
   enable_limit_ = true;
   block_io_allocator_.reset();
@@ -357,6 +363,58 @@ int ObMicroBlockHandleMgr::get_micro_block_handle(
   return ret;
 }
 
+int ObMicroBlockHandleMgr::prefetch_multi_data_block(
+    ObIArray<ObMicroIndexInfo> &micro_index_infos,
+    const int64_t start_idx,
+    const int64_t block_count,
+    ObIArray<ObMicroBlockDataHandle *> &micro_handles)
+{
+  int ret = OB_SUCCESS;
+  ObMultiBlockIOParam io_param;
+  io_param.micro_index_infos_ = &micro_index_infos;
+  io_param.start_index_ = start_idx;
+  io_param.block_count_ = block_count;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Block handle manager is not inited", K(ret));
+  } else if (OB_UNLIKELY(!io_param.is_valid() || micro_handles.count() != micro_index_infos.count())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), K(io_param), K(micro_handles.count()));
+  } else {
+    const uint64_t tenant_id = MTL_ID();
+    const MacroBlockId &macro_id = micro_index_infos.at(start_idx).get_macro_id();
+    const bool use_cache = query_flag_->is_use_block_cache() && use_data_block_cache_;
+    ObMacroBlockHandle macro_handle;
+    if (OB_FAIL(data_block_cache_->prefetch(tenant_id, macro_id, io_param, use_cache, macro_handle))) {
+      LOG_WARN("Fail to prefetch multi data blocks", K(ret), K(macro_id), K(io_param));
+    } else {
+      for (int64_t i = 0; i < block_count; ++i) {
+        ObMicroBlockDataHandle &micro_block_handle = *micro_handles.at(start_idx + i);
+        const int64_t size = micro_index_infos.at(start_idx + i).get_block_size();
+        cache_miss(true);
+        micro_block_handle.block_state_ = ObSSTableMicroBlockState::IN_BLOCK_IO;
+        micro_block_handle.block_index_ = static_cast<int32_t>(i);
+        current_hold_size_ += micro_block_handle.get_handle_size();
+        micro_block_handle.io_handle_ = macro_handle;
+        micro_block_handle.allocator_ = &block_io_allocator_;
+        micro_block_handle.need_release_data_buf_ = true;
+        if (use_cache) {
+          update_data_block_io_size(size);
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockHandleMgr::add_io_stall(const bool is_data_block, const int64_t wait_time)
+{
+  if (is_data_block) {
+    ++io_stall_cnt_;
+    EVENT_ADD(ObStatEventIds::DATA_BLOCK_PREFETCH_STALL_TIME, wait_time);
+  }
+}
+
 void ObMicroBlockHandleMgr::dec_hold_size(ObMicroBlockDataHandle &handle)
 {
   current_hold_size_ -= handle.get_handle_size();
@@ -70,7 +70,7 @@ struct ObMicroBlockDataHandle {
   bool is_loaded_block_;
 
 private:
-  int get_loaded_block_data(blocksstable::ObMicroBlockData &block_data);
+  int get_loaded_block_data(blocksstable::ObMicroBlockData &block_data, const bool is_data_block);
   void try_release_loaded_block();
 };
 
@@ -86,12 +86,24 @@ public:
       const bool is_data_block,
       const bool need_submit_io,
       ObMicroBlockDataHandle &micro_block_handle);
+  // submit one io for the data blocks [start_idx, start_idx + block_count) of %micro_index_infos,
+  // which are cache missed blocks of the same macro block sorted by offset. %micro_handles[i] is
+  // the handle got by get_micro_block_handle without io of %micro_index_infos[i].
+  int prefetch_multi_data_block(
+      common::ObIArray<blocksstable::ObMicroIndexInfo> &micro_index_infos,
+      const int64_t start_idx,
+      const int64_t block_count,
+      common::ObIArray<ObMicroBlockDataHandle *> &micro_handles);
 
   void dec_hold_size(ObMicroBlockDataHandle &handle);
   bool reach_hold_limit() const;
+  // the reader waits %wait_time us for the io of a prefetched block, only the stalls on data blocks
+  // are counted as the data block prefetch depth is adjusted by them
+  void add_io_stall(const bool is_data_block, const int64_t wait_time);
+  OB_INLINE int64_t get_io_stall_count() const { return io_stall_cnt_; }
   OB_INLINE bool is_valid() const { return is_inited_; }
   TO_STRING_KV(K_(is_inited), K_(enable_limit), K_(current_hold_size), K_(hold_limit),
-               K_(data_block_submit_io_size), K_(data_block_use_cache_limit), K_(update_limit_count),
+               K_(data_block_submit_io_size), K_(data_block_use_cache_limit), K_(update_limit_count), K_(io_stall_cnt),
                KPC_(query_flag), KPC_(table_store_stat), KP_(data_block_cache), KP_(index_block_cache));
 private:
   int update_limit();
@@ -114,6 +126,7 @@ private:
   int64_t data_block_use_cache_limit_;
   int64_t hold_limit_;
   int64_t current_hold_size_;
+  int64_t io_stall_cnt_;
   bool use_data_block_cache_;
   bool enable_limit_;
   bool is_inited_;
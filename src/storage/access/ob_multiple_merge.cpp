@@ -462,7 +462,10 @@ int ObMultipleMerge::get_next_normal_rows(int64_t &count, int64_t capacity)
         }
       }
 
+      // groups held by group by pushdown are output before any row of fuse path
       if (OB_FAIL(ret)) {
+      } else if (OB_FAIL(vector_store->flush_group_by_rows())) {
+        LOG_WARN("fail to flush group by rows", K(ret));
       } else if (vector_store->is_end()) {
         // 1. batch full; 2. end of micro block with row returned;
         // 3. pushdown changed with row returned; 4. limit/offset end
@@ -12,6 +12,7 @@
 
 #define USING_LOG_PREFIX STORAGE
 #include "ob_pushdown_aggregate.h"
+#include "lib/hash_func/murmur_hash.h"
 #include "sql/engine/ob_exec_context.h"
 #include "sql/engine/expr/ob_expr_util.h"
 #include "sql/engine/aggregate/ob_aggregate_util.h"
@@ -508,6 +509,40 @@ int ObAggCell::eval_index_info(const blocksstable::ObMicroIndexInfo &index_info,
   return ret;
 }
 
+int ObAggCell::eval_ref_cnts_in_group_by(
+    const common::ObDatum *datums,
+    const uint32_t *ref_cnts,
+    const int64_t distinct_cnt,
+    const bool is_group_by_col)
+{
+  UNUSEDx(datums, ref_cnts, distinct_cnt, is_group_by_col);
+  int ret = OB_NOT_SUPPORTED;
+  LOG_WARN("Not supported to eval with ref cnts", K(ret), K_(agg_type));
+  return ret;
+}
+
+int ObAggCell::deep_copy_group_by_result(const int64_t start, const int64_t end, common::ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(nullptr == group_by_result_datum_buf_ || start < 0 || end > group_by_result_datum_buf_->get_capacity())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), K(start), K(end), KPC(group_by_result_datum_buf_));
+  }
+  for (int64_t i = start; OB_SUCC(ret) && i < end; ++i) {
+    common::ObDatum &result_datum = group_by_result_datum_buf_->at(i);
+    char *buf = nullptr;
+    if (result_datum.is_null() || 0 == result_datum.len_) {
+    } else if (OB_ISNULL(buf = static_cast<char *>(allocator.alloc(result_datum.len_)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("Failed to alloc memory", K(ret), K(result_datum));
+    } else {
+      MEMCPY(buf, result_datum.ptr_, result_datum.len_);
+      result_datum.ptr_ = buf;
+    }
+  }
+  return ret;
+}
+
 int ObAggCell::copy_output_row(const int32_t datum_offset)
 {
   int ret = OB_SUCCESS;
@@ -970,6 +1005,28 @@ int ObCountAggCell::eval_batch_in_group_by(
   return ret;
 }
 
+int ObCountAggCell::eval_ref_cnts_in_group_by(
+    const common::ObDatum *datums,
+    const uint32_t *ref_cnts,
+    const int64_t distinct_cnt,
+    const bool is_group_by_col)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(nullptr == ref_cnts || distinct_cnt <= 0 || (is_group_by_col && nullptr == datums))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), KP(datums), KP(ref_cnts), K(distinct_cnt), K(is_group_by_col));
+  } else {
+    for (int64_t i = 0; i < distinct_cnt; ++i) {
+      if (0 == ref_cnts[i] || (exclude_null_ && datums[i].is_null())) {
+      } else {
+        common::ObDatum &result_datum = group_by_result_datum_buf_->at(i);
+        result_datum.set_int(result_datum.get_int() + ref_cnts[i]);
+      }
+    }
+  }
+  return ret;
+}
+
 int ObCountAggCell::copy_output_row(const int32_t datum_offset)
 {
   int ret = OB_SUCCESS;
@@ -1238,6 +1295,41 @@ int ObMinAggCell::eval_batch_in_group_by(
   return ret;
 }
 
+int ObMinAggCell::eval_ref_cnts_in_group_by(
+    const common::ObDatum *datums,
+    const uint32_t *ref_cnts,
+    const int64_t distinct_cnt,
+    const bool is_group_by_col)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(nullptr == datums || nullptr == ref_cnts || distinct_cnt <= 0 || !is_group_by_col)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), KP(datums), KP(ref_cnts), K(distinct_cnt), K(is_group_by_col));
+  } else if (OB_UNLIKELY(nullptr == cmp_fun_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected state", K(ret), KP(cmp_fun_));
+  } else {
+    // every distinct value is compared once no matter how many rows refer to it,
+    // the distinct datums are valid in this micro block, so no deep copy is needed
+    for (int64_t i = 0; OB_SUCC(ret) && i < distinct_cnt; ++i) {
+      const common::ObDatum &datum = datums[i];
+      if (0 == ref_cnts[i] || datum.is_null()) {
+      } else {
+        common::ObDatum &result_datum = group_by_result_datum_buf_->at(i);
+        int cmp_ret = 0;
+        if (!result_datum.is_null() && OB_FAIL(cmp_fun_(result_datum, datum, cmp_ret))) {
+          LOG_WARN("Failed to cmp", K(ret), K(result_datum), K(datum));
+        } else if (result_datum.is_null() || cmp_ret > 0) {
+          if (OB_FAIL(result_datum.from_storage_datum(datum, basic_info_.agg_expr_->obj_datum_map_))) {
+            LOG_WARN("Failed to clone datum", K(ret), K(datum), K(basic_info_.agg_expr_->obj_datum_map_));
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 ObMaxAggCell::ObMaxAggCell(const ObAggCellBasicInfo &basic_info, common::ObIAllocator &allocator)
     : ObAggCell(basic_info, allocator),
       group_by_ref_array_(nullptr),
@@ -1395,6 +1487,41 @@ int ObMaxAggCell::eval_batch_in_group_by(
   return ret;
 }
 
+int ObMaxAggCell::eval_ref_cnts_in_group_by(
+    const common::ObDatum *datums,
+    const uint32_t *ref_cnts,
+    const int64_t distinct_cnt,
+    const bool is_group_by_col)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(nullptr == datums || nullptr == ref_cnts || distinct_cnt <= 0 || !is_group_by_col)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), KP(datums), KP(ref_cnts), K(distinct_cnt), K(is_group_by_col));
+  } else if (OB_UNLIKELY(nullptr == cmp_fun_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected state", K(ret), KP(cmp_fun_));
+  } else {
+    // every distinct value is compared once no matter how many rows refer to it,
+    // the distinct datums are valid in this micro block, so no deep copy is needed
+    for (int64_t i = 0; OB_SUCC(ret) && i < distinct_cnt; ++i) {
+      const common::ObDatum &datum = datums[i];
+      if (0 == ref_cnts[i] || datum.is_null()) {
+      } else {
+        common::ObDatum &result_datum = group_by_result_datum_buf_->at(i);
+        int cmp_ret = 0;
+        if (!result_datum.is_null() && OB_FAIL(cmp_fun_(result_datum, datum, cmp_ret))) {
+          LOG_WARN("Failed to cmp", K(ret), K(result_datum), K(datum));
+        } else if (result_datum.is_null() || cmp_ret < 0) {
+          if (OB_FAIL(result_datum.from_storage_datum(datum, basic_info_.agg_expr_->obj_datum_map_))) {
+            LOG_WARN("Failed to clone datum", K(ret), K(datum), K(basic_info_.agg_expr_->obj_datum_map_));
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 ObSumAggCell::ObSumAggCell(const ObAggCellBasicInfo &basic_info, common::ObIAllocator &allocator)
     : ObAggCell(basic_info, allocator),
       obj_tc_(ObNullTC),
@@ -1803,6 +1930,86 @@ int ObSumAggCell::eval_batch_in_group_by(
   return ret;
 }
 
+int ObSumAggCell::eval_ref_cnts_in_group_by(
+    const common::ObDatum *datums,
+    const uint32_t *ref_cnts,
+    const int64_t distinct_cnt,
+    const bool is_group_by_col)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(nullptr == datums || nullptr == ref_cnts || distinct_cnt <= 0 ||
+                  !can_eval_with_ref_cnts(is_group_by_col))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), KP(datums), KP(ref_cnts), K(distinct_cnt), K(is_group_by_col), K_(obj_tc));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < distinct_cnt; ++i) {
+      const common::ObDatum &datum = datums[i];
+      if (0 == ref_cnts[i] || datum.is_null()) {
+      } else if (OB_FAIL(eval_with_ref_cnt(datum, ref_cnts[i], static_cast<int32_t>(i)))) {
+        LOG_WARN("Failed to eval with ref cnt", K(ret), K(i), K(ref_cnts[i]), K_(obj_tc));
+      }
+    }
+  }
+  return ret;
+}
+
+// add datum * ref_cnt to the result, falls back to adding the datum ref_cnt times
+// if the product of int or uint overflows
+int ObSumAggCell::eval_with_ref_cnt(
+    const common::ObDatum &datum,
+    const uint32_t ref_cnt,
+    const int32_t datum_offset)
+{
+  int ret = OB_SUCCESS;
+  blocksstable::ObStorageDatum product_datum;
+  product_datum.reuse();
+  bool eval_per_row = false;
+  if (1 == ref_cnt) {
+    eval_per_row = true;
+  } else if (ObObjTypeClass::ObIntTC == obj_tc_) {
+    int64_t product = 0;
+    if (__builtin_mul_overflow(datum.get_int(), static_cast<int64_t>(ref_cnt), &product)) {
+      eval_per_row = true;
+    } else {
+      product_datum.set_int(product);
+    }
+  } else if (ObObjTypeClass::ObUIntTC == obj_tc_) {
+    uint64_t product = 0;
+    if (__builtin_mul_overflow(datum.get_uint(), static_cast<uint64_t>(ref_cnt), &product)) {
+      eval_per_row = true;
+    } else {
+      product_datum.set_uint(product);
+    }
+  } else if (ObObjTypeClass::ObNumberTC == obj_tc_) {
+    char buf_alloc[common::number::ObNumber::MAX_CALC_BYTE_LEN * 2];
+    ObDataBuffer allocator(buf_alloc, sizeof(buf_alloc));
+    common::number::ObNumber value_nmb(datum.get_number());
+    common::number::ObNumber cnt_nmb;
+    common::number::ObNumber product_nmb;
+    if (OB_FAIL(cnt_nmb.from(static_cast<int64_t>(ref_cnt), allocator))) {
+      LOG_WARN("Failed to convert ref cnt to number", K(ret), K(ref_cnt));
+    } else if (OB_FAIL(value_nmb.mul_v3(cnt_nmb, product_nmb, allocator))) {
+      LOG_WARN("number mul failed", K(ret), K(value_nmb), K(cnt_nmb));
+    } else {
+      product_datum.set_number(product_nmb);
+    }
+  } else {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected type to eval with ref cnt", K(ret), K_(obj_tc));
+  }
+  if (OB_FAIL(ret)) {
+  } else if (eval_per_row) {
+    for (uint32_t i = 0; OB_SUCC(ret) && i < ref_cnt; ++i) {
+      if (OB_FAIL((this->*eval_func_)(datum, datum_offset))) {
+        LOG_WARN("Fail to eval", K(ret), K(obj_tc_));
+      }
+    }
+  } else if (OB_FAIL((this->*eval_func_)(product_datum, datum_offset))) {
+    LOG_WARN("Fail to eval", K(ret), K(obj_tc_), K(product_datum));
+  }
+  return ret;
+}
+
 int ObSumAggCell::copy_output_row(const int32_t datum_offset)
 {
   int ret = OB_SUCCESS;
@@ -2683,11 +2890,22 @@ ObGroupByCell::ObGroupByCell(const int64_t batch_size, common::ObIAllocator &all
     distinct_cnt_(0),
     ref_cnt_(0),
     refs_buf_(nullptr),
+    ref_cnts_buf_(nullptr),
+    ref_cnts_buf_size_(0),
+    ref_cnts_offset_(0),
+    ref_cnts_count_(0),
+    is_ref_cnts_valid_(false),
     need_extract_distinct_(false),
     distinct_projector_buf_(nullptr),
     agg_datum_buf_(nullptr),
     is_processing_(false),
     projected_cnt_(0),
+    can_merge_micro_block_(false),
+    is_merging_(false),
+    held_cnt_(0),
+    group_buckets_(nullptr),
+    group_bucket_cnt_(0),
+    merge_allocator_("ObStorageAgg", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID()),
     agg_cell_factory_(allocator),
     allocator_(allocator)
 {
@@ -2707,6 +2925,12 @@ void ObGroupByCell::reset()
     allocator_.free(refs_buf_);
     refs_buf_ = nullptr;
   }
+  if (nullptr != ref_cnts_buf_) {
+    allocator_.free(ref_cnts_buf_);
+    ref_cnts_buf_ = nullptr;
+  }
+  ref_cnts_buf_size_ = 0;
+  is_ref_cnts_valid_ = false;
   need_extract_distinct_ = false;
   free_group_by_buf(allocator_, distinct_projector_buf_);
   if (nullptr != agg_datum_buf_) {
@@ -2716,6 +2940,15 @@ void ObGroupByCell::reset()
   }
   is_processing_ = false;
   projected_cnt_ = 0;
+  can_merge_micro_block_ = false;
+  is_merging_ = false;
+  held_cnt_ = 0;
+  if (nullptr != group_buckets_) {
+    allocator_.free(group_buckets_);
+    group_buckets_ = nullptr;
+  }
+  group_bucket_cnt_ = 0;
+  merge_allocator_.reset();
 }
 
 void ObGroupByCell::reuse()
@@ -2725,12 +2958,16 @@ void ObGroupByCell::reuse()
   for (int64_t i = 0; i < agg_cells_.count(); ++i) {
     agg_cells_.at(i)->reuse();
   }
+  is_ref_cnts_valid_ = false;
   need_extract_distinct_ = false;
   if (nullptr != distinct_projector_buf_) {
     distinct_projector_buf_->fill_items(-1);
   }
   is_processing_ = false;
   projected_cnt_ = 0;
+  is_merging_ = false;
+  held_cnt_ = 0;
+  merge_allocator_.reuse();
 }
 
 int ObGroupByCell::init(const ObTableAccessParam &param, sql::ObEvalCtx &eval_ctx)
@@ -2798,6 +3035,14 @@ int ObGroupByCell::init(const ObTableAccessParam &param, sql::ObEvalCtx &eval_ct
         std::sort(agg_cells_.begin(), agg_cells_.end(),
                   [](ObAggCell *a, ObAggCell *b) { return a->get_col_offset() < b->get_col_offset(); });
       }
+      // the group by values and aggregate results of held groups are kept by value or deep copied,
+      // which is not possible for the obj and lob datums
+      can_merge_micro_block_ = OBJ_DATUM_FULL != group_by_col_expr_->obj_datum_map_ &&
+                               !is_lob_storage(group_by_col_expr_->datum_meta_.type_);
+      for (int64_t i = 0; can_merge_micro_block_ && i < agg_cells_.count(); ++i) {
+        const ObAggCell *agg_cell = agg_cells_.at(i);
+        can_merge_micro_block_ = OBJ_DATUM_FULL != agg_cell->get_agg_expr()->obj_datum_map_ && !agg_cell->is_lob_col();
+      }
       void *buf = nullptr;
       if (OB_ISNULL(buf = allocator_.alloc(sizeof(uint32_t) * batch_size_))) {
         ret = common::OB_ALLOCATE_MEMORY_FAILED;
@@ -2827,6 +3072,16 @@ int ObGroupByCell::eval_batch(
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("Unexpected state, not load distinct yet", K(ret));
   } else if (agg_cells_.at(agg_idx)->finished()) {
+  } else if (!is_default_datum && agg_cells_.at(agg_idx)->can_eval_with_ref_cnts(is_group_by_col)) {
+    // aggregate on the row count of each dict ref instead of each row
+    if (OB_FAIL(prepare_ref_cnts(count, ref_offset))) {
+      LOG_WARN("Failed to prepare ref cnts", K(ret), K(count), K(ref_offset));
+    } else if (OB_FAIL(agg_cells_.at(agg_idx)->eval_ref_cnts_in_group_by(
+        datums, ref_cnts_buf_, distinct_cnt_, is_group_by_col))) {
+      LOG_WARN("Failed to eval ref cnts in group by", K(ret));
+    } else {
+      agg_cells_.at(agg_idx)->set_group_by_result_cnt(distinct_cnt_);
+    }
   } else if (OB_FAIL(agg_cells_.at(agg_idx)->eval_batch_in_group_by(
       datums, count, refs_buf_ + ref_offset, distinct_cnt_, is_group_by_col, is_default_datum))) {
     LOG_WARN("Failed to eval batch with in group by", K(ret));
@@ -2836,6 +3091,43 @@ int ObGroupByCell::eval_batch(
   return ret;
 }
 
+int ObGroupByCell::prepare_ref_cnts(const int64_t count, const uint32_t ref_offset)
+{
+  int ret = OB_SUCCESS;
+  if (is_ref_cnts_valid_ && ref_offset == ref_cnts_offset_ && count == ref_cnts_count_) {
+    // already counted by previous aggregate cell
+  } else if (OB_UNLIKELY(count <= 0 || ref_offset + count > ref_cnt_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument", K(ret), K(count), K(ref_offset), K(ref_cnt_));
+  } else {
+    if (distinct_cnt_ > ref_cnts_buf_size_) {
+      const int64_t size = MAX(distinct_cnt_, batch_size_);
+      void *buf = nullptr;
+      if (OB_ISNULL(buf = allocator_.alloc(sizeof(uint32_t) * size))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("Failed to alloc memory", K(ret), K(size));
+      } else {
+        if (nullptr != ref_cnts_buf_) {
+          allocator_.free(ref_cnts_buf_);
+        }
+        ref_cnts_buf_ = static_cast<uint32_t*>(buf);
+        ref_cnts_buf_size_ = size;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      const uint32_t *refs = refs_buf_ + ref_offset;
+      MEMSET(ref_cnts_buf_, 0, sizeof(uint32_t) * distinct_cnt_);
+      for (int64_t i = 0; i < count; ++i) {
+        ref_cnts_buf_[refs[i]]++;
+      }
+      ref_cnts_offset_ = ref_offset;
+      ref_cnts_count_ = count;
+      is_ref_cnts_valid_ = true;
+    }
+  }
+  return ret;
+}
+
 int ObGroupByCell::copy_output_row(const int64_t batch_idx)
 {
   int ret = OB_SUCCESS;
@@ -2985,6 +3277,7 @@ int ObGroupByCell::extract_distinct()
   } else {
     common::ObDatum *group_by_col_datums = group_by_col_datum_buf_->get_group_by_datums();
     common::ObDatum *tmp_group_by_datums = tmp_group_by_datum_buf_->get_group_by_datums();
+    const int64_t prev_distinct_cnt = distinct_cnt_;
     for (int64_t i = 0; OB_SUCC(ret) && i < ref_cnt_; ++i) {
       uint32_t &ref = refs_buf_[i];
       if (OB_UNLIKELY(ref >= group_by_col_datum_buf_->get_capacity())) {
@@ -2999,7 +3292,19 @@ int ObGroupByCell::extract_distinct()
           } else if (OB_FAIL(group_by_col_datums[distinct_cnt_].from_storage_datum(tmp_group_by_datums[ref], group_by_col_expr_->obj_datum_map_))) {
             LOG_WARN("Failed to clone datum", K(ret), K(tmp_group_by_datums[ref]), K(group_by_col_expr_->obj_datum_map_));
           }
-          if (OB_SUCC(ret)) {
+          if (OB_FAIL(ret)) {
+          } else if (is_merging_) {
+            // the value may be a group of previous micro blocks
+            int64_t group_idx = -1;
+            int64_t bucket_idx = -1;
+            find_group(group_by_col_datums[distinct_cnt_], group_idx, bucket_idx);
+            if (-1 == group_idx) {
+              group_buckets_[bucket_idx] = static_cast<int32_t>(distinct_cnt_);
+              group_idx = distinct_cnt_++;
+            }
+            distinct_projector = static_cast<int16_t>(group_idx);
+            ref = static_cast<uint32_t>(group_idx);
+          } else {
             distinct_projector = distinct_cnt_;
             ref = distinct_cnt_;
             distinct_cnt_++;
@@ -3011,11 +3316,140 @@ int ObGroupByCell::extract_distinct()
 
       }
     }
+    is_ref_cnts_valid_ = false;
+    if (OB_SUCC(ret) && distinct_cnt_ > prev_distinct_cnt) {
+      // groups added by this batch of rows are not aggregated yet
+      for (int64_t i = 0; i < agg_cells_.count(); ++i) {
+        agg_cells_.at(i)->reset_finished();
+      }
+    }
     LOG_DEBUG("[GROUP BY PUSHDOWN]", K(ret), K(ref_cnt_), K(distinct_cnt_));
   }
   return ret;
 }
 
+int ObGroupByCell::hold_group_by_result()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!can_hold_group_by_result())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected state to hold group by result", K(ret), KPC(this));
+  } else if (!is_merging_) {
+    if (OB_FAIL(prepare_group_buckets())) {
+      LOG_WARN("Failed to prepare group buckets", K(ret));
+    } else {
+      const common::ObDatum *group_by_col_datums = group_by_col_datum_buf_->get_group_by_datums();
+      for (int64_t i = 0; i < distinct_cnt_; ++i) {
+        int64_t group_idx = -1;
+        int64_t bucket_idx = -1;
+        find_group(group_by_col_datums[i], group_idx, bucket_idx);
+        if (-1 == group_idx) {
+          group_buckets_[bucket_idx] = static_cast<int32_t>(i);
+        }
+      }
+      held_cnt_ = 0;
+      is_merging_ = true;
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(deep_copy_held_groups())) {
+    LOG_WARN("Failed to deep copy held groups", K(ret));
+  } else {
+    held_cnt_ = distinct_cnt_;
+  }
+  LOG_DEBUG("[GROUP BY PUSHDOWN]", K(ret), K_(held_cnt), K_(distinct_cnt));
+  return ret;
+}
+
+int ObGroupByCell::collect_merged_result()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_merging_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected state, no held groups", K(ret), KPC(this));
+  } else if (OB_FAIL(collect_result())) {
+    LOG_WARN("Failed to collect result", K(ret));
+  } else {
+    is_merging_ = false;
+  }
+  return ret;
+}
+
+int ObGroupByCell::prepare_group_buckets()
+{
+  int ret = OB_SUCCESS;
+  if (nullptr == group_buckets_) {
+    // load factor is not more than 0.5 as the group count is less than the batch size
+    const int64_t bucket_cnt = next_pow2(batch_size_ * 2);
+    void *buf = nullptr;
+    if (OB_ISNULL(buf = allocator_.alloc(sizeof(int32_t) * bucket_cnt))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("Failed to alloc memory", K(ret), K(bucket_cnt));
+    } else {
+      group_buckets_ = static_cast<int32_t *>(buf);
+      group_bucket_cnt_ = bucket_cnt;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    MEMSET(group_buckets_, -1, sizeof(int32_t) * group_bucket_cnt_);
+  }
+  return ret;
+}
+
+// the group by values of the new groups and the results of min/max/first_row on group by column
+// may refer to the memory of current micro block, which is released after the micro block is scanned
+int ObGroupByCell::deep_copy_held_groups()
+{
+  int ret = OB_SUCCESS;
+  const bool is_string_datum = OBJ_DATUM_STRING == group_by_col_expr_->obj_datum_map_;
+  if (is_string_datum || ob_is_decimal_int(group_by_col_expr_->datum_meta_.type_)) {
+    common::ObDatum *group_by_col_datums = group_by_col_datum_buf_->get_group_by_datums();
+    for (int64_t i = held_cnt_; OB_SUCC(ret) && i < distinct_cnt_; ++i) {
+      common::ObDatum &datum = group_by_col_datums[i];
+      char *buf = nullptr;
+      if (datum.is_null() || 0 == datum.len_) {
+      } else if (OB_ISNULL(buf = static_cast<char *>(merge_allocator_.alloc(datum.len_)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("Failed to alloc memory", K(ret), K(datum));
+      } else {
+        MEMCPY(buf, datum.ptr_, datum.len_);
+        datum.ptr_ = buf;
+      }
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < agg_cells_.count(); ++i) {
+    ObAggCell *agg_cell = agg_cells_.at(i);
+    const ObPDAggType agg_type = agg_cell->get_type();
+    if (group_by_col_offset_ != agg_cell->get_col_offset() ||
+        OBJ_DATUM_STRING != agg_cell->get_agg_expr()->obj_datum_map_ ||
+        (ObPDAggType::PD_MIN != agg_type && ObPDAggType::PD_MAX != agg_type && ObPDAggType::PD_FIRST_ROW != agg_type)) {
+    } else if (OB_FAIL(agg_cell->deep_copy_group_by_result(held_cnt_, distinct_cnt_, merge_allocator_))) {
+      LOG_WARN("Failed to deep copy group by result", K(ret), KPC(agg_cell));
+    }
+  }
+  return ret;
+}
+
+void ObGroupByCell::find_group(const common::ObDatum &datum, int64_t &group_idx, int64_t &bucket_idx) const
+{
+  const common::ObDatum *group_by_col_datums = group_by_col_datum_buf_->get_group_by_datums();
+  const uint64_t mask = static_cast<uint64_t>(group_bucket_cnt_ - 1);
+  const uint64_t hash = datum.is_null() ? 0 : common::murmurhash(datum.ptr_, datum.len_, 0);
+  group_idx = -1;
+  bucket_idx = static_cast<int64_t>(hash & mask);
+  while (-1 == group_idx && -1 != group_buckets_[bucket_idx]) {
+    const common::ObDatum &group_datum = group_by_col_datums[group_buckets_[bucket_idx]];
+    if (datum.is_null() != group_datum.is_null()) {
+    } else if (datum.is_null() ||
+               (datum.len_ == group_datum.len_ && 0 == MEMCMP(datum.ptr_, group_datum.ptr_, datum.len_))) {
+      group_idx = group_buckets_[bucket_idx];
+    }
+    if (-1 == group_idx) {
+      bucket_idx = static_cast<int64_t>((bucket_idx + 1) & mask);
+    }
+  }
+}
+
 int ObGroupByCell::assign_agg_cells(const sql::ObExpr *col_expr, common::ObIArray<int32_t> &agg_idxs)
 {
   int ret = OB_SUCCESS;
@@ -3063,6 +3497,9 @@ int64_t ObGroupByCell::to_string(char *buf, const int64_t buf_len) const
        K_(ref_cnt),
        K_(is_processing),
        K_(projected_cnt),
+       K_(can_merge_micro_block),
+       K_(is_merging),
+       K_(held_cnt),
        KPC_(group_by_col_datum_buf));
   J_COMMA();
   J_KV(K(ObArrayWrap<uint32_t>(refs_buf_, ref_cnt_)));
@@ -252,6 +252,18 @@ public:
       const int64_t distinct_cnt,
       const bool is_group_by_col = false,
       const bool is_default_datum = false) = 0;
+  // For group by pushdown when the aggregate result only depends on the row count of each distinct value,
+  // ref_cnts[i] is the row count of the i-th distinct value in current batch
+  virtual bool can_eval_with_ref_cnts(const bool is_group_by_col) const { UNUSED(is_group_by_col); return false; }
+  virtual int eval_ref_cnts_in_group_by(
+      const common::ObDatum *datums,
+      const uint32_t *ref_cnts,
+      const int64_t distinct_cnt,
+      const bool is_group_by_col);
+  // deep copy the results of groups in [start, end) which may refer to the memory of current micro block
+  int deep_copy_group_by_result(const int64_t start, const int64_t end, common::ObIAllocator &allocator);
+  // more groups are added after all the previous groups are aggregated
+  OB_INLINE void reset_finished() { aggregated_ = false; }
   virtual int copy_output_row(const int32_t datum_offset);
   virtual int copy_output_rows(const int32_t datum_offset);
   virtual int collect_result(sql::ObEvalCtx &ctx, bool need_padding);
@@ -334,6 +346,13 @@ public:
       const int64_t distinct_cnt,
       const bool is_group_by_col = false,
       const bool is_default_datum = false) override;
+  virtual bool can_eval_with_ref_cnts(const bool is_group_by_col) const override
+  { return !exclude_null_ || is_group_by_col; }
+  virtual int eval_ref_cnts_in_group_by(
+      const common::ObDatum *datums,
+      const uint32_t *ref_cnts,
+      const int64_t distinct_cnt,
+      const bool is_group_by_col) override;
   virtual int copy_output_row(const int32_t datum_offset) override;
   virtual int copy_output_rows(const int32_t datum_offset) override;
   virtual int collect_result(sql::ObEvalCtx &ctx, bool need_padding) override;
@@ -366,6 +385,12 @@ public:
       const int64_t distinct_cnt,
       const bool is_group_by_col = false,
       const bool is_default_datum = false) override;
+  virtual bool can_eval_with_ref_cnts(const bool is_group_by_col) const override { return is_group_by_col; }
+  virtual int eval_ref_cnts_in_group_by(
+      const common::ObDatum *datums,
+      const uint32_t *ref_cnts,
+      const int64_t distinct_cnt,
+      const bool is_group_by_col) override;
   INHERIT_TO_STRING_KV("ObAggCell", ObAggCell, K_(cmp_fun));
 private:
   ObDatumCmpFuncType cmp_fun_;
@@ -394,6 +419,12 @@ public:
       const int64_t distinct_cnt,
       const bool is_group_by_col = false,
       const bool is_default_datum = false) override;
+  virtual bool can_eval_with_ref_cnts(const bool is_group_by_col) const override { return is_group_by_col; }
+  virtual int eval_ref_cnts_in_group_by(
+      const common::ObDatum *datums,
+      const uint32_t *ref_cnts,
+      const int64_t distinct_cnt,
+      const bool is_group_by_col) override;
   INHERIT_TO_STRING_KV("ObAggCell", ObAggCell, K_(cmp_fun));
 private:
   ObDatumCmpFuncType cmp_fun_;
@@ -428,6 +459,19 @@ public:
       const int64_t distinct_cnt,
       const bool is_group_by_col = false,
       const bool is_default_datum = false) override;
+  // the sum of a distinct value is the value multiplied by its row count, float, double and
+  // decimal int are still summed row by row to keep the rounding and the arg width of the result
+  virtual bool can_eval_with_ref_cnts(const bool is_group_by_col) const override
+  {
+    return is_group_by_col && (ObObjTypeClass::ObIntTC == obj_tc_ ||
+                               ObObjTypeClass::ObUIntTC == obj_tc_ ||
+                               ObObjTypeClass::ObNumberTC == obj_tc_);
+  }
+  virtual int eval_ref_cnts_in_group_by(
+      const common::ObDatum *datums,
+      const uint32_t *ref_cnts,
+      const int64_t distinct_cnt,
+      const bool is_group_by_col) override;
   virtual int copy_output_row(const int32_t datum_offset) override;
   virtual int copy_output_rows(const int32_t datum_offset) override;
   virtual int collect_result(sql::ObEvalCtx &ctx, bool need_padding) override;
@@ -447,6 +491,7 @@ private:
   int eval_float(const common::ObDatum &datum, const int32_t datum_offset);
   int eval_double(const common::ObDatum &datum, const int32_t datum_offset);
   int eval_number(const common::ObDatum &datum, const int32_t datum_offset);
+  int eval_with_ref_cnt(const common::ObDatum &datum, const uint32_t ref_cnt, const int32_t datum_offset);
   template<typename RES_T, typename ARG_T>
   int eval_decimal_int(const common::ObDatum &datum, const int32_t datum_offset);
   template<typename ARG_T>
@@ -629,7 +674,7 @@ public:
   OB_INLINE common::ObDatum *get_group_by_col_datums() const { return group_by_col_datum_buf_->get_group_by_datums(); }
   OB_INLINE common::ObIArray<ObAggCell*> &get_agg_cells() { return agg_cells_; }
   OB_INLINE int64_t get_ref_cnt() const { return ref_cnt_; }
-  OB_INLINE void set_ref_cnt(const int64_t ref_cnt) { ref_cnt_ = ref_cnt; }
+  OB_INLINE void set_ref_cnt(const int64_t ref_cnt) { ref_cnt_ = ref_cnt; is_ref_cnts_valid_ = false; }
   OB_INLINE uint32_t *get_refs_buf() { return refs_buf_; }
   OB_INLINE bool need_read_reference() const { return need_extract_distinct_ || agg_cells_.count() > 0; }
   OB_INLINE bool need_do_aggregate() const { return agg_cells_.count() > 0; }
@@ -639,6 +684,13 @@ public:
   OB_INLINE bool is_processing() const { return is_processing_; }
   OB_INLINE void set_is_processing(const bool is_processing) { is_processing_ = is_processing; }
   OB_INLINE void reset_projected_cnt() { projected_cnt_ = 0; }
+  // groups of consecutive micro blocks are merged into one sql batch,
+  // the groups are held until the batch is full or the next micro block can not do group by
+  OB_INLINE bool is_merging() const { return is_merging_; }
+  OB_INLINE bool can_hold_group_by_result() const
+  { return can_merge_micro_block_ && !is_processing_ && !is_exceed_sql_batch() && 0 < distinct_cnt_ && distinct_cnt_ < batch_size_; }
+  int hold_group_by_result();
+  int collect_merged_result();
   template <typename T>
   int decide_use_group_by(const int64_t row_cnt, const int64_t read_cnt, const int64_t distinct_cnt, const T *bitmap, bool &use_group_by)
   {
@@ -649,20 +701,34 @@ public:
                    distinct_cnt < row_cnt * USE_GROUP_BY_DISTINCT_RATIO &&
                    (!is_valid_bitmap ||
                     bitmap->popcnt() * USE_GROUP_BY_FILTER_FACTOR > bitmap->size());
-    if (use_group_by) {
+    if (use_group_by && is_merging_) {
+      // the distinct values are always extracted and merged into the held groups,
+      // the result buffers are not cleared as they hold the groups of previous micro blocks
+      use_group_by = distinct_cnt_ + distinct_cnt < batch_size_;
+      if (!use_group_by) {
+      } else if (OB_FAIL(prepare_tmp_group_by_buf())) {
+        LOG_WARN("Failed to init extra info", K(ret));
+      } else {
+        distinct_projector_buf_->fill_items(-1);
+      }
+    } else if (use_group_by) {
       if ((is_valid_bitmap || read_cnt < row_cnt) && OB_FAIL(prepare_tmp_group_by_buf())) {
         LOG_WARN("Failed to init extra info", K(ret));
       } else if (OB_FAIL(reserve_group_by_buf(distinct_cnt + 1))) {
         LOG_WARN("Failed to prepare group by datum buf", K(ret));
       }
     }
-    LOG_DEBUG("[GROUP BY PUSHDOWN]", K(ret), K(row_cnt), K(read_cnt), K(distinct_cnt), K(is_valid_bitmap), K(use_group_by),
+    LOG_DEBUG("[GROUP BY PUSHDOWN]", K(ret), K(row_cnt), K(read_cnt), K(distinct_cnt), K(is_valid_bitmap), K(use_group_by), K_(is_merging),
         "popcnt", is_valid_bitmap ? bitmap->popcnt() : 0,
         "size", is_valid_bitmap ? bitmap->size() : 0);
     return ret;
   }
   DECLARE_TO_STRING;
 private:
+  int prepare_ref_cnts(const int64_t count, const uint32_t ref_offset);
+  int prepare_group_buckets();
+  int deep_copy_held_groups();
+  void find_group(const common::ObDatum &datum, int64_t &group_idx, int64_t &bucket_idx) const;
   static const int64_t DEFAULT_AGG_CELL_CNT = 2;
   static const int64_t USE_GROUP_BY_READ_CNT_FACTOR = 2;
   static constexpr double USE_GROUP_BY_DISTINCT_RATIO = 0.5;
@@ -680,12 +746,28 @@ private:
   int64_t distinct_cnt_;
   int64_t ref_cnt_;
   uint32_t *refs_buf_;
+  // row count of each distinct value in refs_buf_[ref_cnts_offset_, ref_cnts_offset_ + ref_cnts_count_),
+  // shared by the aggregate cells which only depend on the row count of each group
+  uint32_t *ref_cnts_buf_;
+  int64_t ref_cnts_buf_size_;
+  uint32_t ref_cnts_offset_;
+  int64_t ref_cnts_count_;
+  bool is_ref_cnts_valid_;
   // the 3 following members is for extracting distinct values from rows with bitmap
   bool need_extract_distinct_;
   ObGroupByExtendableBuf<int16_t> *distinct_projector_buf_;
   ObAggDatumBuf *agg_datum_buf_;
   bool is_processing_;
   int64_t projected_cnt_;
+  // the following members are for merging the groups of consecutive micro blocks,
+  // groups are matched by the binary value of group by column in an open addressing hash table
+  bool can_merge_micro_block_;
+  bool is_merging_;
+  // groups in [0, held_cnt_) are deep copied and do not refer to the memory of micro blocks
+  int64_t held_cnt_;
+  int32_t *group_buckets_;
+  int64_t group_bucket_cnt_;
+  common::ObArenaAllocator merge_allocator_;
   ObPDAggFactory agg_cell_factory_;
   common::ObIAllocator &allocator_;
   DISALLOW_COPY_AND_ASSIGN(ObGroupByCell);
@@ -108,20 +108,22 @@ int ObSSTableIndexFilter::is_filtered_by_skipping_index(
   if (OB_UNLIKELY(nullptr == node.filter_ || 1 != node.filter_->get_col_offsets().count())) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("Unexpected filter in skipping filter node", K(ret), KPC_(node.filter));
+  } else if (node.filter_->is_filter_constant()) {
+    // Filter result is constant already by another skipping index of the same filter.
   } else if (index_info.apply_skipping_filter_result(node.filter_)) {
     // There is no need to check skipping index because filter result is contant already.
   } else {
-    auto *white_filter = static_cast<sql::ObWhiteFilterExecutor *>(node.filter_);
-    const uint32_t col_offset = white_filter->get_col_offsets(is_cg_).at(0);
+    auto *physical_filter = static_cast<sql::ObPhysicalFilterExecutor *>(node.filter_);
+    const uint32_t col_offset = physical_filter->get_col_offsets(is_cg_).at(0);
     const uint32_t col_idx = static_cast<uint32_t>(read_info->get_columns_index().at(col_offset));
     if (OB_FAIL(skip_filter_executor_.falsifiable_pushdown_filter(col_idx,
                                                                   node.skip_index_type_,
                                                                   index_info,
-                                                                  *white_filter,
+                                                                  *physical_filter,
                                                                   allocator))) {
-      LOG_WARN("Fail to falsifiable pushdown filter", K(ret), K(white_filter));
+      LOG_WARN("Fail to falsifiable pushdown filter", K(ret), KPC(physical_filter));
     } else {
-      node.is_skipping_index_used_ = white_filter->is_filter_constant();
+      node.is_skipping_index_used_ = physical_filter->is_filter_constant();
     }
   }
   return ret;
@@ -153,9 +155,9 @@ int ObSSTableIndexFilter::extract_skipping_filter_from_tree(
     sql::ObPushdownFilterExecutor &filter)
 {
   int ret = OB_SUCCESS;
-  // We maybe use skipping index for black filter in the future, such as like('abc%'), a + b > 3.
-  if (filter.is_filter_white_node()) {
-    auto &white_filter = static_cast<sql::ObWhiteFilterExecutor &>(filter);
+  // Black filter on single column may use ngram bloom filter, such as like('%abc%').
+  if (filter.is_filter_white_node()
+      || (filter.is_filter_black_node() && 1 == filter.get_col_ids().count())) {
     IndexList index_list;
     if (OB_FAIL(find_skipping_index(read_info, filter, index_list))) {
       LOG_WARN("Fail to find useful skipping index", K(ret));
@@ -198,8 +200,15 @@ int ObSSTableIndexFilter::find_skipping_index(
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("Unexpected column meta", K(column_id), K(index), KPC(read_info));
     } else {
-      const bool has_min_max = column_extend->at(index).skip_index_attr_.has_min_max();
-      if (has_min_max && OB_FAIL(index_list.push_back(blocksstable::ObSkipIndexType::MIN_MAX))) {
+      const share::schema::ObSkipIndexColumnAttr &skip_index_attr = column_extend->at(index).skip_index_attr_;
+      if (skip_index_attr.has_min_max()
+          && OB_FAIL(index_list.push_back(blocksstable::ObSkipIndexType::MIN_MAX))) {
+        LOG_WARN("Fail to push back skip index type", K(ret));
+      } else if (skip_index_attr.has_bloom_filter()
+          && OB_FAIL(index_list.push_back(blocksstable::ObSkipIndexType::BLOOM_FILTER))) {
+        LOG_WARN("Fail to push back skip index type", K(ret));
+      } else if (skip_index_attr.has_ngram_bloom_filter()
+          && OB_FAIL(index_list.push_back(blocksstable::ObSkipIndexType::NGRAM_BLOOM_FILTER))) {
         LOG_WARN("Fail to push back skip index type", K(ret));
       }
     }
@@ -283,6 +292,16 @@ int ObSSTableIndexFilterExtracter::extract_skipping_filter(
         LOG_WARN("Fail to extract min max index skipping filter", K(ret), K(skip_index_type));
       }
       break;
+    case blocksstable::ObSkipIndexType::BLOOM_FILTER:
+      if (OB_FAIL(ObSSTableIndexFilterExtracter::extract_bloom_filter_skipping_filter(filter, node))) {
+        LOG_WARN("Fail to extract bloom filter index skipping filter", K(ret), K(skip_index_type));
+      }
+      break;
+    case blocksstable::ObSkipIndexType::NGRAM_BLOOM_FILTER:
+      if (OB_FAIL(ObSSTableIndexFilterExtracter::extract_ngram_bloom_filter_skipping_filter(filter, node))) {
+        LOG_WARN("Fail to extract ngram bloom filter index skipping filter", K(ret), K(skip_index_type));
+      }
+      break;
     default:
       // There are more skipping index types in the future.
       ret = OB_ERR_UNEXPECTED;
@@ -308,5 +327,44 @@ int ObSSTableIndexFilterExtracter::extract_min_max_skipping_filter(
   return ret;
 }
 
+int ObSSTableIndexFilterExtracter::extract_bloom_filter_skipping_filter(
+    const sql::ObPushdownFilterExecutor &filter,
+    ObSkippingFilterNode &node)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!filter.is_filter_node())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected not physical filter node", K(ret), K(filter.get_type()));
+  } else if (filter.is_filter_black_node()) {
+    node.set_useless();
+  } else {
+    const sql::ObWhiteFilterOperatorType op_type =
+        static_cast<const sql::ObWhiteFilterExecutor &>(filter).get_op_type();
+    if (sql::WHITE_OP_EQ == op_type || sql::WHITE_OP_IN == op_type) {
+      node.skip_index_type_ = blocksstable::ObSkipIndexType::BLOOM_FILTER;
+    } else {
+      node.set_useless();
+    }
+  }
+  return ret;
+}
+
+int ObSSTableIndexFilterExtracter::extract_ngram_bloom_filter_skipping_filter(
+    const sql::ObPushdownFilterExecutor &filter,
+    ObSkippingFilterNode &node)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!filter.is_filter_node())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected not physical filter node", K(ret), K(filter.get_type()));
+  } else if (filter.is_filter_white_node()) {
+    node.set_useless();
+  } else {
+    // like exprs in the black filter are checked when filtering
+    node.skip_index_type_ = blocksstable::ObSkipIndexType::NGRAM_BLOOM_FILTER;
+  }
+  return ret;
+}
+
 } // namespace storage
 } // namespace oceanbase
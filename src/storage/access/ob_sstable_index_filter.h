@@ -136,6 +136,12 @@ private:
   static int extract_min_max_skipping_filter(
       const sql::ObPushdownFilterExecutor &filter,
       ObSkippingFilterNode &node);
+  static int extract_bloom_filter_skipping_filter(
+      const sql::ObPushdownFilterExecutor &filter,
+      ObSkippingFilterNode &node);
+  static int extract_ngram_bloom_filter_skipping_filter(
+      const sql::ObPushdownFilterExecutor &filter,
+      ObSkippingFilterNode &node);
 };
 } // namespace storage
 } // namespace oceanbase
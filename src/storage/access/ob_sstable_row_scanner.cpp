@@ -449,8 +449,9 @@ int ObSSTableRowScanner<PrefetchType>::fetch_rows(ObSSTableReadHandle &read_hand
           LOG_TRACE("[Vectorized] pushdown status changed, pushdown=>fuse", K(ret),
                     K(prefetcher_.cur_micro_data_fetch_idx_));
         } else {
-          // should do prefetch as all the prefetched micros may be read
-          need_prefetch = iter_param_->enable_pd_aggregate();
+          // should do prefetch as all the prefetched micros may be read,
+          // group by pushdown merges the groups of consecutive micros into one batch
+          need_prefetch = iter_param_->enable_pd_aggregate() || iter_param_->enable_pd_group_by();
         }
       }
     }
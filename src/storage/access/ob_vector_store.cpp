@@ -36,7 +36,8 @@ ObVectorStore::ObVectorStore(
     col_params_(*context_.stmt_allocator_),
     group_idx_expr_(nullptr),
     default_row_(),
-    group_by_cell_(nullptr)
+    group_by_cell_(nullptr),
+    held_group_idx_(0)
   {}
 
 ObVectorStore::~ObVectorStore()
@@ -59,6 +60,7 @@ void ObVectorStore::reset()
     context_.stmt_allocator_->free(group_by_cell_);
     group_by_cell_ = nullptr;
   }
+  held_group_idx_ = 0;
 }
 
 int ObVectorStore::init(const ObTableAccessParam &param)
@@ -214,6 +216,11 @@ int ObVectorStore::fill_rows(
     // defense code: data cross fuse and micro block is banned
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("Unexpected vector store count", K(ret), K(count_));
+  } else if (nullptr != group_by_cell_ && group_by_cell_->is_merging() && group_idx != held_group_idx_) {
+    // groups of different range groups are not merged, this micro block is filled in next batch
+    if (OB_FAIL(flush_group_by_rows())) {
+      LOG_WARN("Failed to flush group by rows", K(ret));
+    }
   } else if (OB_FAIL(check_can_group_by(reader, begin_index, end_index, res, can_group_by))) {
     LOG_WARN("Failed to checkout pushdown group by", K(ret));
   } else if (can_group_by) {
@@ -222,6 +229,11 @@ int ObVectorStore::fill_rows(
         LOG_WARN("Failed to fill group by rows", K(ret));
       }
     }
+  } else if (nullptr != group_by_cell_ && group_by_cell_->is_merging()) {
+    // output the held groups first, this micro block is filled in next batch
+    if (OB_FAIL(flush_group_by_rows())) {
+      LOG_WARN("Failed to flush group by rows", K(ret));
+    }
   } else if (OB_FAIL(fill_output_rows(group_idx, reader, begin_index, end_index, res))) {
     if (OB_UNLIKELY(OB_ITER_END != ret)) {
       LOG_WARN("Failed to fill output rows", K(ret));
@@ -299,9 +311,25 @@ int ObVectorStore::fill_group_by_rows(
 {
   int ret = OB_SUCCESS;
   int64_t output_cnt = 0;
+  bool is_held = false;
   if (!group_by_cell_->is_processing()) {
     if (OB_FAIL(do_group_by(group_idx, reader, begin_index, end_index, res))) {
       LOG_WARN("Failed to do group by", K(ret));
+    } else if (group_by_cell_->can_hold_group_by_result()) {
+      // the groups of following micro blocks are merged into the groups held in this batch
+      if (OB_FAIL(group_by_cell_->hold_group_by_result())) {
+        LOG_WARN("Failed to hold group by result", K(ret));
+      } else {
+        is_held = true;
+      }
+    } else if (group_by_cell_->is_merging()) {
+      if (OB_FAIL(group_by_cell_->collect_merged_result())) {
+        LOG_WARN("Failed to collect merged result", K(ret));
+      } else {
+        output_cnt = group_by_cell_->get_distinct_cnt();
+      }
+    } else if (OB_FAIL(group_by_cell_->collect_result())) {
+      LOG_WARN("Failed to collect result", K(ret));
     } else if (!group_by_cell_->is_exceed_sql_batch()) {
       output_cnt = group_by_cell_->get_distinct_cnt();
     } else {
@@ -310,6 +338,10 @@ int ObVectorStore::fill_group_by_rows(
     }
   }
   if (OB_FAIL(ret)) {
+  } else if (is_held) {
+    held_group_idx_ = group_idx;
+    begin_index = end_index;
+    ret = OB_ITER_END;
   } else if (group_by_cell_->is_processing()) {
     if (OB_FAIL(group_by_cell_->output_extra_group_by_result(output_cnt))) {
       if (OB_LIKELY(OB_ITER_END == ret)) {
@@ -380,6 +412,8 @@ int ObVectorStore::do_group_by(
   blocksstable::ObIMicroBlockDecoder *decoder = static_cast<blocksstable::ObIMicroBlockDecoder*>(reader);
   const int32_t group_by_col_offset = group_by_cell_->get_group_by_col_offset();
   const char **cell_data = group_by_cell_->get_cell_datas();
+  // distinct values of this micro block are extracted after the held groups
+  const int64_t held_distinct_cnt = group_by_cell_->is_merging() ? group_by_cell_->get_distinct_cnt() : 0;
   if (OB_FAIL(decoder->read_distinct(group_by_col_offset,
       nullptr == cell_data ? cell_data_ptrs_ : cell_data, *group_by_cell_))) {
     LOG_WARN("Failed to read distinct", K(ret));
@@ -387,7 +421,7 @@ int ObVectorStore::do_group_by(
     const bool need_extract_distinct = group_by_cell_->need_extract_distinct();
     const bool need_do_aggregate = group_by_cell_->need_do_aggregate();
     if (need_extract_distinct) {
-      group_by_cell_->set_distinct_cnt(0);
+      group_by_cell_->set_distinct_cnt(held_distinct_cnt);
     }
     while (OB_SUCC(ret)) {
       if (OB_FAIL(get_row_ids(reader, begin_index, end_index, row_capacity, false, res))) {
@@ -411,13 +445,29 @@ int ObVectorStore::do_group_by(
     if (OB_UNLIKELY(OB_ITER_END != ret)) {
       LOG_WARN("Unexpected ret, should be OB_ITER_END", K(ret));
       ret = OB_ERR_UNEXPECTED;
-    } else if (OB_FAIL(group_by_cell_->collect_result())) {
-      LOG_WARN("Failed to collect result", K(ret));
+    } else {
+      ret = OB_SUCCESS;
     }
   }
   return ret;
 }
 
+int ObVectorStore::flush_group_by_rows()
+{
+  int ret = OB_SUCCESS;
+  if (nullptr == group_by_cell_ || !group_by_cell_->is_merging()) {
+  } else if (OB_FAIL(group_by_cell_->collect_merged_result())) {
+    LOG_WARN("Failed to collect merged result", K(ret));
+  } else {
+    count_ = group_by_cell_->get_distinct_cnt();
+    eval_ctx_.set_batch_idx(count_);
+    fill_group_idx(held_group_idx_);
+    EVENT_ADD(ObStatEventIds::SSSTORE_READ_ROW_COUNT, count_);
+    set_end();
+  }
+  return ret;
+}
+
 int ObVectorStore::fill_rows(const int64_t group_idx, const int64_t row_count)
 {
   int ret = OB_SUCCESS;
@@ -60,6 +60,8 @@ public:
   OB_INLINE ObGroupByCell *get_group_by_cell() { return group_by_cell_; }
   virtual int reuse_capacity(const int64_t capacity) override;
   virtual bool is_empty() const override final { return 0 == count_; }
+  // output the groups of previous micro blocks held by group by pushdown and end this batch
+  int flush_group_by_rows();
   DECLARE_TO_STRING;
 private:
   void fill_group_idx(const int64_t group_idx);
@@ -99,6 +101,8 @@ private:
   sql::ObExpr *group_idx_expr_;
   blocksstable::ObDatumRow default_row_;
   ObGroupByCell *group_by_cell_;
+  // range group idx of the held groups
+  int64_t held_group_idx_;
 };
 
 }
@@ -100,6 +100,13 @@ ObCSFilterFunctionFactory::ObCSFilterFunctionFactory()
 
   INIT_FILTER_OP_FUNCS_4(dict_val_bt_funcs_, ObCSDictFilterFuncProducer, produce_dict_val_bt_tranverse);
   INIT_FILTER_OP_FUNCS_4(dict_val_in_funcs_, ObCSDictFilterFuncProducer, produce_dict_val_in_tranverse);
+
+  init_integer_batch_filter_funcs<false>();
+#if defined ( __x86_64__ )
+  if (is_avx512_valid()) {
+    init_integer_avx512_batch_filter_funcs();
+  }
+#endif
 }
 
 ObCSFilterFunctionFactory &ObCSFilterFunctionFactory::instance()
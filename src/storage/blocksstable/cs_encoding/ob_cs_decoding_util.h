@@ -133,6 +133,14 @@ typedef int (*cs_dict_tranverse_ref) (
             const sql::ObPushdownFilterExecutor *parent,
             common::ObBitmap &result_bitmap);
 
+typedef void (*cs_integer_equal_range) (
+            const char *buf,
+            const uint64_t datum_val,
+            const int64_t row_start,
+            const int64_t row_end,
+            int64_t &lower_idx,
+            int64_t &upper_idx);
+
 template <typename DataType>
 struct CSEqualsOp
 {
@@ -437,6 +445,179 @@ public:
   }
 };
 
+// Batch version of ObCSIntegerFilterOpFunc, used when there is no parent filter. The loops are
+// branch free and write the byte-per-row result bitmap directly, so they are vectorized by the
+// compiler. IS_AVX512 only separates the instantiations in ob_cs_decoding_util_simd.cpp, which is
+// compiled with AVX-512 enabled, from the generic ones.
+// If ExistNullBitmap, null rows are set in result_bitmap before filtering and will be reset here.
+template <typename ValDataType, typename Op, bool ExistNullBitmap, bool IS_AVX512>
+class ObCSIntegerBatchFilterOpFunc
+{
+public:
+  static const int64_t IN_OP_BATCH_SIZE = 256;
+
+  static int compare_op_tranverse(const char *buf, const uint64_t datum_val,
+    const int64_t row_start, const int64_t row_count,
+    const sql::ObPushdownFilterExecutor *parent, ObBitmap &result_bitmap)
+  {
+    UNUSED(parent);
+    const ValDataType cast_datum_val = *reinterpret_cast<const ValDataType *>(&datum_val);
+    const ValDataType *__restrict start_pos = reinterpret_cast<const ValDataType *>(buf) + row_start;
+    uint8_t *__restrict res = result_bitmap.get_data();
+    for (int64_t i = 0; i < row_count; ++i) {
+      set_result(Op::apply(start_pos[i], cast_datum_val), res[i]);
+    }
+    return common::OB_SUCCESS;
+  }
+
+  static int between_op_tranverse(const char *buf, const uint64_t *datums_val,
+    const int64_t row_start, const int64_t row_count,
+    const sql::ObPushdownFilterExecutor *parent, ObBitmap &result_bitmap)
+  {
+    UNUSED(parent);
+    const ValDataType left_boundary = *reinterpret_cast<const ValDataType *>(datums_val);
+    const ValDataType right_boundary = *reinterpret_cast<const ValDataType *>(datums_val + 1);
+    const ValDataType *__restrict start_pos = reinterpret_cast<const ValDataType *>(buf) + row_start;
+    uint8_t *__restrict res = result_bitmap.get_data();
+    for (int64_t i = 0; i < row_count; ++i) {
+      const ValDataType cur_val = start_pos[i];
+      set_result((cur_val >= left_boundary) & (cur_val <= right_boundary), res[i]);
+    }
+    return common::OB_SUCCESS;
+  }
+
+  static int between_op_tranverse_with_null(const char *buf, const uint64_t *datums_val,
+    const uint64_t null_replaced_val, const int64_t row_start, const int64_t row_count,
+    const sql::ObPushdownFilterExecutor *parent, ObBitmap &result_bitmap)
+  {
+    UNUSED(parent);
+    const ValDataType left_boundary = *reinterpret_cast<const ValDataType *>(datums_val);
+    const ValDataType right_boundary = *reinterpret_cast<const ValDataType *>(datums_val + 1);
+    const ValDataType cast_null_val = *reinterpret_cast<const ValDataType *>(&null_replaced_val);
+    const ValDataType *__restrict start_pos = reinterpret_cast<const ValDataType *>(buf) + row_start;
+    uint8_t *__restrict res = result_bitmap.get_data();
+    for (int64_t i = 0; i < row_count; ++i) {
+      const ValDataType cur_val = start_pos[i];
+      res[i] |= (cur_val != cast_null_val) & (cur_val >= left_boundary) & (cur_val <= right_boundary);
+    }
+    return common::OB_SUCCESS;
+  }
+
+  // the rows are filtered by IN_OP_BATCH_SIZE, and each valid filter value is compared with all the
+  // rows of the batch, so it is only used when hash set is not needed
+  static int in_op_tranverse(const char *buf, const bool *filter_vals_valid, const uint64_t *filter_vals,
+    const int64_t filter_val_cnt, const int64_t row_start, const int64_t row_count,
+    const uint64_t base_val, const sql::ObPushdownFilterExecutor *parent, ObBitmap &result_bitmap)
+  {
+    UNUSED(parent);
+    const ValDataType *start_pos = reinterpret_cast<const ValDataType *>(buf) + row_start;
+    uint8_t *__restrict res = result_bitmap.get_data();
+    uint8_t matched[IN_OP_BATCH_SIZE];
+    for (int64_t batch_start = 0; batch_start < row_count; batch_start += IN_OP_BATCH_SIZE) {
+      const int64_t batch_cnt = MIN(IN_OP_BATCH_SIZE, row_count - batch_start);
+      in_match_batch(start_pos + batch_start, batch_cnt, filter_vals_valid, filter_vals,
+          filter_val_cnt, base_val, matched);
+      for (int64_t i = 0; i < batch_cnt; ++i) {
+        set_result(matched[i], res[batch_start + i]);
+      }
+    }
+    return common::OB_SUCCESS;
+  }
+
+  static int in_op_tranverse_with_null(const char *buf, const uint64_t null_replaced_val,
+    const bool *filter_vals_valid, const uint64_t *filter_vals, const int64_t filter_val_cnt,
+    const int64_t row_start, const int64_t row_count, const uint64_t base_val,
+    const sql::ObPushdownFilterExecutor *parent, ObBitmap &result_bitmap)
+  {
+    UNUSED(parent);
+    const ValDataType cast_null_val = *reinterpret_cast<const ValDataType *>(&null_replaced_val);
+    const ValDataType *start_pos = reinterpret_cast<const ValDataType *>(buf) + row_start;
+    uint8_t *__restrict res = result_bitmap.get_data();
+    uint8_t matched[IN_OP_BATCH_SIZE];
+    for (int64_t batch_start = 0; batch_start < row_count; batch_start += IN_OP_BATCH_SIZE) {
+      const int64_t batch_cnt = MIN(IN_OP_BATCH_SIZE, row_count - batch_start);
+      const ValDataType *__restrict batch_pos = start_pos + batch_start;
+      in_match_batch(batch_pos, batch_cnt, filter_vals_valid, filter_vals, filter_val_cnt, base_val, matched);
+      for (int64_t i = 0; i < batch_cnt; ++i) {
+        res[batch_start + i] |= matched[i] & (batch_pos[i] != cast_null_val);
+      }
+    }
+    return common::OB_SUCCESS;
+  }
+
+private:
+  OB_INLINE static void set_result(const uint8_t matched, uint8_t &res)
+  {
+    if (ExistNullBitmap) {
+      // res is 1 for null row
+      res = (res ^ 1) & matched;
+    } else {
+      res |= matched;
+    }
+  }
+
+  OB_INLINE static void in_match_batch(const ValDataType *__restrict vals, const int64_t batch_cnt,
+    const bool *filter_vals_valid, const uint64_t *filter_vals, const int64_t filter_val_cnt,
+    const uint64_t base_val, uint8_t *__restrict matched)
+  {
+    MEMSET(matched, 0, batch_cnt);
+    for (int64_t j = 0; j < filter_val_cnt; ++j) {
+      if (filter_vals_valid[j]) {
+        const uint64_t datum_val = filter_vals[j] - base_val;
+        const ValDataType cast_datum_val = *reinterpret_cast<const ValDataType *>(&datum_val);
+        for (int64_t i = 0; i < batch_cnt; ++i) {
+          matched[i] |= (vals[i] == cast_datum_val);
+        }
+      }
+    }
+  }
+};
+
+// Search the equal range of a value in the sorted integer stream of a rowkey column.
+// The branch free binary search narrows the range down to LINEAR_SEARCH_SIZE rows, then the rows
+// less than the value are counted in a plain loop, which is vectorized to compare many rows at once.
+template <typename ValDataType, bool IS_AVX512>
+class ObCSIntegerBoundSearchFunc
+{
+public:
+  static const int64_t LINEAR_SEARCH_SIZE = 64;
+
+  static void equal_range(const char *buf, const uint64_t datum_val,
+    const int64_t row_start, const int64_t row_end, int64_t &lower_idx, int64_t &upper_idx)
+  {
+    const ValDataType cast_datum_val = *reinterpret_cast<const ValDataType *>(&datum_val);
+    const ValDataType *vals = reinterpret_cast<const ValDataType *>(buf);
+    lower_idx = bound_search<false>(vals, cast_datum_val, row_start, row_end);
+    upper_idx = bound_search<true>(vals, cast_datum_val, lower_idx, row_end);
+  }
+
+private:
+  // return the first row not less than (IS_UPPER: greater than) %val in [begin, end)
+  template <bool IS_UPPER>
+  OB_INLINE static int64_t bound_search(const ValDataType *__restrict vals, const ValDataType val,
+    const int64_t begin, const int64_t end)
+  {
+    int64_t base = begin;
+    int64_t len = end - begin;
+    while (len > LINEAR_SEARCH_SIZE) {
+      const int64_t half = len / 2;
+      base = is_before<IS_UPPER>(vals[base + half], val) ? base + half : base;
+      len -= half;
+    }
+    int64_t before_cnt = 0;
+    for (int64_t i = 0; i < len; ++i) {
+      before_cnt += is_before<IS_UPPER>(vals[base + i], val);
+    }
+    return base + before_cnt;
+  }
+
+  template <bool IS_UPPER>
+  OB_INLINE static bool is_before(const ValDataType cur_val, const ValDataType val)
+  {
+    return IS_UPPER ? cur_val <= val : cur_val < val;
+  }
+};
+
 template <typename ValDataType, typename Op, bool ExistParent>
 class ObCSDictFilterOpFunc
 {
@@ -616,6 +797,71 @@ struct ObCSIntegerFilterFuncProducerWithNull
   }
 };
 
+template <bool EXIST_NULL_BITMAP, int32_t VAL_WIDTH_TAG, bool IS_AVX512>
+struct ObCSIntegerBatchFilterFuncProducer
+{
+  static cs_integer_compare_tranverse produce_integer_cmp_tranverse(
+    const sql::ObWhiteFilterOperatorType op_type)
+  {
+    typedef typename ObEncodingTypeInference<false, VAL_WIDTH_TAG>::Type ValDataType;
+    cs_integer_compare_tranverse func = nullptr;
+    switch (op_type) {
+      case sql::ObWhiteFilterOperatorType::WHITE_OP_EQ:
+        func = ObCSIntegerBatchFilterOpFunc<ValDataType, CSEqualsOp<ValDataType>, EXIST_NULL_BITMAP, IS_AVX512>::compare_op_tranverse;
+        break;
+      case sql::ObWhiteFilterOperatorType::WHITE_OP_LE:
+        func = ObCSIntegerBatchFilterOpFunc<ValDataType, CSLessOrEqualsOp<ValDataType>, EXIST_NULL_BITMAP, IS_AVX512>::compare_op_tranverse;
+        break;
+      case sql::ObWhiteFilterOperatorType::WHITE_OP_LT:
+        func = ObCSIntegerBatchFilterOpFunc<ValDataType, CSLessOp<ValDataType>, EXIST_NULL_BITMAP, IS_AVX512>::compare_op_tranverse;
+        break;
+      case sql::ObWhiteFilterOperatorType::WHITE_OP_GE:
+        func = ObCSIntegerBatchFilterOpFunc<ValDataType, CSGreaterOrEqualsOp<ValDataType>, EXIST_NULL_BITMAP, IS_AVX512>::compare_op_tranverse;
+        break;
+      case sql::ObWhiteFilterOperatorType::WHITE_OP_GT:
+        func = ObCSIntegerBatchFilterOpFunc<ValDataType, CSGreaterOp<ValDataType>, EXIST_NULL_BITMAP, IS_AVX512>::compare_op_tranverse;
+        break;
+      case sql::ObWhiteFilterOperatorType::WHITE_OP_NE:
+        func = ObCSIntegerBatchFilterOpFunc<ValDataType, CSNotEqualsOp<ValDataType>, EXIST_NULL_BITMAP, IS_AVX512>::compare_op_tranverse;
+        break;
+      default:
+        func = nullptr;
+        break;
+    }
+    return func;
+  }
+
+  static cs_integer_bt_tranverse produce_integer_bt_tranverse()
+  {
+    typedef typename ObEncodingTypeInference<false, VAL_WIDTH_TAG>::Type ValDataType;
+    return ObCSIntegerBatchFilterOpFunc<ValDataType, CSBetweenOp<ValDataType>, EXIST_NULL_BITMAP, IS_AVX512>::between_op_tranverse;
+  }
+
+  static cs_integer_in_tranverse produce_integer_in_tranverse()
+  {
+    typedef typename ObEncodingTypeInference<false, VAL_WIDTH_TAG>::Type ValDataType;
+    return ObCSIntegerBatchFilterOpFunc<ValDataType, CSEqualsOp<ValDataType>, EXIST_NULL_BITMAP, IS_AVX512>::in_op_tranverse;
+  }
+
+  static cs_integer_bt_tranverse_with_null produce_integer_bt_tranverse_with_null()
+  {
+    typedef typename ObEncodingTypeInference<false, VAL_WIDTH_TAG>::Type ValDataType;
+    return ObCSIntegerBatchFilterOpFunc<ValDataType, CSBetweenOp<ValDataType>, false, IS_AVX512>::between_op_tranverse_with_null;
+  }
+
+  static cs_integer_in_tranverse_with_null produce_integer_in_tranverse_with_null()
+  {
+    typedef typename ObEncodingTypeInference<false, VAL_WIDTH_TAG>::Type ValDataType;
+    return ObCSIntegerBatchFilterOpFunc<ValDataType, CSEqualsOp<ValDataType>, false, IS_AVX512>::in_op_tranverse_with_null;
+  }
+
+  static cs_integer_equal_range produce_integer_equal_range()
+  {
+    typedef typename ObEncodingTypeInference<false, VAL_WIDTH_TAG>::Type ValDataType;
+    return ObCSIntegerBoundSearchFunc<ValDataType, IS_AVX512>::equal_range;
+  }
+};
+
 template <bool EXIST_PARENT, int32_t VAL_WIDTH_TAG>
 struct ObCSDictRefFilterFuncProducer
 {
@@ -698,7 +944,9 @@ public:
   {
     int32_t val_width_tag = get_value_len_tag_map()[val_width_size];
     const bool exist_parent = (nullptr != parent);
-    cs_integer_compare_tranverse func = integer_cmp_funcs_[exist_null_bitmap][exist_parent][val_width_tag][op_type];
+    cs_integer_compare_tranverse func = can_skip_parent_check(parent)
+        ? integer_cmp_batch_funcs_[exist_null_bitmap][val_width_tag][op_type]
+        : integer_cmp_funcs_[exist_null_bitmap][exist_parent][val_width_tag][op_type];
     return func(buf, datum_val, row_start, row_count, parent, result_bitmap);
   }
 
@@ -709,7 +957,9 @@ public:
   {
     int32_t val_width_tag = get_value_len_tag_map()[val_width_size];
     const bool exist_parent = (nullptr != parent);
-    cs_integer_bt_tranverse func = integer_bt_funcs_[exist_null_bitmap][exist_parent][val_width_tag];
+    cs_integer_bt_tranverse func = can_skip_parent_check(parent)
+        ? integer_bt_batch_funcs_[exist_null_bitmap][val_width_tag]
+        : integer_bt_funcs_[exist_null_bitmap][exist_parent][val_width_tag];
     return func(buf, datums_val, row_start, row_count, parent, result_bitmap);
   }
 
@@ -720,7 +970,9 @@ public:
   {
     int32_t val_width_tag = get_value_len_tag_map()[val_width_size];
     const bool exist_parent = (nullptr != parent);
-    cs_integer_bt_tranverse_with_null func = integer_bt_null_funcs_[exist_parent][val_width_tag];
+    cs_integer_bt_tranverse_with_null func = can_skip_parent_check(parent)
+        ? integer_bt_null_batch_funcs_[val_width_tag]
+        : integer_bt_null_funcs_[exist_parent][val_width_tag];
     return func(buf, datums_val, null_replaced_val, row_start, row_count, parent, result_bitmap);
   }
 
@@ -731,7 +983,9 @@ public:
   {
     int32_t val_width_tag = get_value_len_tag_map()[val_width_size];
     const bool exist_parent = (nullptr != parent);
-    cs_integer_in_tranverse func = integer_in_funcs_[exist_null_bitmap][exist_parent][val_width_tag];
+    cs_integer_in_tranverse func = (can_skip_parent_check(parent) && can_use_batch_in_op(filter_val_cnt, row_count))
+        ? integer_in_batch_funcs_[exist_null_bitmap][val_width_tag]
+        : integer_in_funcs_[exist_null_bitmap][exist_parent][val_width_tag];
     return func(buf, filter_vals_valid, filter_vals, filter_val_cnt,
         row_start, row_count, base_val, parent, result_bitmap);
   }
@@ -743,7 +997,9 @@ public:
   {
     int32_t val_width_tag = get_value_len_tag_map()[val_width_size];
     const bool exist_parent = (nullptr != parent);
-    cs_integer_in_tranverse_with_null func = integer_in_null_funcs_[exist_parent][val_width_tag];
+    cs_integer_in_tranverse_with_null func = (can_skip_parent_check(parent) && can_use_batch_in_op(filter_val_cnt, row_count))
+        ? integer_in_null_batch_funcs_[val_width_tag]
+        : integer_in_null_funcs_[exist_parent][val_width_tag];
     return func(buf, null_replaced_val, filter_vals_valid, filter_vals, filter_val_cnt,
         row_start, row_count, base_val, parent, result_bitmap);
   }
@@ -796,9 +1052,34 @@ public:
     return func(dict_ref_buf, row_start, row_count, ref_bitmap, parent, result_bitmap);
   }
 
+  // %lower_idx and %upper_idx are the first rows not less than and greater than %datum_val in
+  // [row_start, row_end) of the sorted integer stream %buf
+  OB_INLINE void integer_equal_range(const char *buf, const uint32_t val_width_size,
+    const uint64_t datum_val, const int64_t row_start, const int64_t row_end,
+    int64_t &lower_idx, int64_t &upper_idx)
+  {
+    const int32_t val_width_tag = get_value_len_tag_map()[val_width_size];
+    cs_integer_equal_range func = integer_equal_range_funcs_[val_width_tag];
+    func(buf, datum_val, row_start, row_end, lower_idx, upper_idx);
+  }
+
 private:
   ObCSFilterFunctionFactory();
   ~ObCSFilterFunctionFactory() = default;
+  template <bool IS_AVX512>
+  void init_integer_batch_filter_funcs();
+  // defined in ob_cs_decoding_util_simd.cpp
+  void init_integer_avx512_batch_filter_funcs();
+  // batch funcs compute all the rows, they are used if no row can be skipped by parent
+  OB_INLINE static bool can_skip_parent_check(const sql::ObPushdownFilterExecutor *parent)
+  {
+    return nullptr == parent || !parent->need_check_row_filter();
+  }
+  OB_INLINE static bool can_use_batch_in_op(const int64_t filter_val_cnt, const int64_t row_count)
+  {
+    CHECK_USE_HASHSET_FOR_IN_OP(filter_val_cnt, row_count);
+    return !use_hash_set;
+  }
   DISALLOW_COPY_AND_ASSIGN(ObCSFilterFunctionFactory);
 private:
   ObMultiDimArray_T<cs_integer_compare_tranverse, 2/*exist_null_bitmap*/, 2/*exist_parent*/, 4/*val_tag*/, 6/*op*/> integer_cmp_funcs_;
@@ -806,6 +1087,13 @@ private:
   ObMultiDimArray_T<cs_integer_bt_tranverse_with_null, 2/*exist_parent*/, 4/*val_tag*/> integer_bt_null_funcs_;
   ObMultiDimArray_T<cs_integer_in_tranverse, 2/*exist_null_bitmap*/, 2/*exist_parent*/, 4/*val_tag*/> integer_in_funcs_;
   ObMultiDimArray_T<cs_integer_in_tranverse_with_null, 2/*exist_parent*/, 4/*val_tag*/> integer_in_null_funcs_;
+  // batch funcs for filter without parent
+  ObMultiDimArray_T<cs_integer_compare_tranverse, 2/*exist_null_bitmap*/, 4/*val_tag*/, 6/*op*/> integer_cmp_batch_funcs_;
+  ObMultiDimArray_T<cs_integer_bt_tranverse, 2/*exist_null_bitmap*/, 4/*val_tag*/> integer_bt_batch_funcs_;
+  ObMultiDimArray_T<cs_integer_bt_tranverse_with_null, 4/*val_tag*/> integer_bt_null_batch_funcs_;
+  ObMultiDimArray_T<cs_integer_in_tranverse, 2/*exist_null_bitmap*/, 4/*val_tag*/> integer_in_batch_funcs_;
+  ObMultiDimArray_T<cs_integer_in_tranverse_with_null, 4/*val_tag*/> integer_in_null_batch_funcs_;
+  ObMultiDimArray_T<cs_integer_equal_range, 4/*val_tag*/> integer_equal_range_funcs_;
 
   ObMultiDimArray_T<cs_dict_val_compare_tranverse, 4/*val_tag*/, 6/*op*/> dict_val_cmp_funcs_;
   ObMultiDimArray_T<cs_dict_val_bt_tranverse, 4/*val_tag*/> dict_val_bt_funcs_;
@@ -814,6 +1102,48 @@ private:
   ObMultiDimArray_T<cs_dict_tranverse_ref, 2/*exist_parent*/, 4/*val_tag*/> dict_scan_ref_funcs_;
 };
 
+// two-dimensitional array, 2*4, with IS_AVX512
+#define INIT_BATCH_FILTER_OP_FUNCS_2P4(func_arr, producer, produce_func) \
+  func_arr[0][0] = producer<false, 0, IS_AVX512>::produce_func(); \
+  func_arr[1][0] = producer<true, 0, IS_AVX512>::produce_func(); \
+  func_arr[0][1] = producer<false, 1, IS_AVX512>::produce_func(); \
+  func_arr[1][1] = producer<true, 1, IS_AVX512>::produce_func(); \
+  func_arr[0][2] = producer<false, 2, IS_AVX512>::produce_func(); \
+  func_arr[1][2] = producer<true, 2, IS_AVX512>::produce_func(); \
+  func_arr[0][3] = producer<false, 3, IS_AVX512>::produce_func(); \
+  func_arr[1][3] = producer<true, 3, IS_AVX512>::produce_func(); \
+
+// three-dimensitional array, 2*4*6, with IS_AVX512
+#define INIT_BATCH_FILTER_OP_FUNCS_2P4P6(func_arr, producer, produce_func) \
+  func_arr[0][0][op_type] = producer<false, 0, IS_AVX512>::produce_func(static_cast<sql::ObWhiteFilterOperatorType>(op_type)); \
+  func_arr[1][0][op_type] = producer<true, 0, IS_AVX512>::produce_func(static_cast<sql::ObWhiteFilterOperatorType>(op_type)); \
+  func_arr[0][1][op_type] = producer<false, 1, IS_AVX512>::produce_func(static_cast<sql::ObWhiteFilterOperatorType>(op_type)); \
+  func_arr[1][1][op_type] = producer<true, 1, IS_AVX512>::produce_func(static_cast<sql::ObWhiteFilterOperatorType>(op_type)); \
+  func_arr[0][2][op_type] = producer<false, 2, IS_AVX512>::produce_func(static_cast<sql::ObWhiteFilterOperatorType>(op_type)); \
+  func_arr[1][2][op_type] = producer<true, 2, IS_AVX512>::produce_func(static_cast<sql::ObWhiteFilterOperatorType>(op_type)); \
+  func_arr[0][3][op_type] = producer<false, 3, IS_AVX512>::produce_func(static_cast<sql::ObWhiteFilterOperatorType>(op_type)); \
+  func_arr[1][3][op_type] = producer<true, 3, IS_AVX512>::produce_func(static_cast<sql::ObWhiteFilterOperatorType>(op_type)); \
+
+// one-dimensitional array, 4, with IS_AVX512
+#define INIT_BATCH_FILTER_OP_FUNCS_4(func_arr, producer, produce_func) \
+  func_arr[0] = producer<false, 0, IS_AVX512>::produce_func(); \
+  func_arr[1] = producer<false, 1, IS_AVX512>::produce_func(); \
+  func_arr[2] = producer<false, 2, IS_AVX512>::produce_func(); \
+  func_arr[3] = producer<false, 3, IS_AVX512>::produce_func(); \
+
+template <bool IS_AVX512>
+void ObCSFilterFunctionFactory::init_integer_batch_filter_funcs()
+{
+  INIT_BATCH_FILTER_OP_FUNCS_2P4(integer_bt_batch_funcs_, ObCSIntegerBatchFilterFuncProducer, produce_integer_bt_tranverse);
+  INIT_BATCH_FILTER_OP_FUNCS_2P4(integer_in_batch_funcs_, ObCSIntegerBatchFilterFuncProducer, produce_integer_in_tranverse);
+  INIT_BATCH_FILTER_OP_FUNCS_4(integer_bt_null_batch_funcs_, ObCSIntegerBatchFilterFuncProducer, produce_integer_bt_tranverse_with_null);
+  INIT_BATCH_FILTER_OP_FUNCS_4(integer_in_null_batch_funcs_, ObCSIntegerBatchFilterFuncProducer, produce_integer_in_tranverse_with_null);
+  INIT_BATCH_FILTER_OP_FUNCS_4(integer_equal_range_funcs_, ObCSIntegerBatchFilterFuncProducer, produce_integer_equal_range);
+  for (int32_t op_type = 0; op_type < 6; ++op_type) {
+    INIT_BATCH_FILTER_OP_FUNCS_2P4P6(integer_cmp_batch_funcs_, ObCSIntegerBatchFilterFuncProducer, produce_integer_cmp_tranverse);
+  }
+}
+
 class ObCSDecodingUtil
 {
 public:
@@ -844,6 +1174,26 @@ public:
     return ((*(uint8_t *)(bitmap + idx/8)) & (1 << (7 - idx%8))) > 0;
   }
 
+  // set res[i] to 1 if bit (row_start + i) of bitmap is set, the bit order is the same as test_bit
+  static OB_INLINE void batch_test_bits(const char *bitmap, const int64_t row_start,
+                                        const int64_t row_count, uint8_t *res)
+  {
+    const uint8_t *bits = reinterpret_cast<const uint8_t *>(bitmap);
+    int64_t i = 0;
+    for (; i < row_count && 0 != ((row_start + i) & 7); ++i) {
+      res[i] |= (bits[(row_start + i) >> 3] >> (7 - ((row_start + i) & 7))) & 1;
+    }
+    for (; i + 8 <= row_count; i += 8) {
+      const uint8_t byte = bits[(row_start + i) >> 3];
+      for (int64_t j = 0; j < 8; ++j) {
+        res[i + j] |= (byte >> (7 - j)) & 1;
+      }
+    }
+    for (; i < row_count; ++i) {
+      res[i] |= (bits[(row_start + i) >> 3] >> (7 - ((row_start + i) & 7))) & 1;
+    }
+  }
+
   static OB_INLINE bool can_convert_to_integer(const ObObjType col_type, bool &is_signed_data)
   {
     bool can_convert = false;
@@ -0,0 +1,30 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_cs_decoding_util.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// The batch filter and bound search kernels are plain loops, this file is compiled with AVX2 and AVX-512 enabled
+// so that they are vectorized with 256 and 512 bits registers. Only called if is_avx512_valid().
+void ObCSFilterFunctionFactory::init_integer_avx512_batch_filter_funcs()
+{
+  init_integer_batch_filter_funcs<true>();
+}
+
+}  // end namespace blocksstable
+}  // end namespace oceanbase
@@ -1886,6 +1886,30 @@ int ObDictColumnDecoder::cmp_ref_and_set_result(
   return ret;
 }
 
+// branch free version of set_bitmap_with_bitset on typed refs, used if no row can be skipped by parent
+template <typename RefType>
+static void batch_set_bitmap_with_bitset(
+    const char *ref_buf,
+    const sql::ObBitVector *ref_bitset,
+    const int64_t row_start,
+    const int64_t row_cnt,
+    const bool has_null,
+    const uint64_t null_replaced_val,
+    const bool flag,
+    uint8_t *__restrict res)
+{
+  const RefType *__restrict refs = reinterpret_cast<const RefType *>(ref_buf) + row_start;
+  const RefType null_ref = static_cast<RefType>(null_replaced_val);
+  const uint8_t flag_val = flag;
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    const RefType cur_ref = refs[i];
+    const uint8_t is_null = has_null & (cur_ref == null_ref);
+    // null ref may be out of the range of ref_bitset
+    const uint8_t hit = (is_null ^ 1) & ref_bitset->exist(is_null ? 0 : cur_ref);
+    res[i] = ((res[i] & (hit ^ 1)) | (hit & flag_val)) & (is_null ^ 1);
+  }
+}
+
 int ObDictColumnDecoder::set_bitmap_with_bitset(
     const uint32_t ref_width_size,
     const char *ref_buf,
@@ -1900,20 +1924,45 @@ int ObDictColumnDecoder::set_bitmap_with_bitset(
 {
   int ret = OB_SUCCESS;
   // NOTICE: for performance, not check param
-  uint64_t cur_ref = 0;
-  for (int64_t i = 0; OB_SUCC(ret) && (i < row_cnt); ++i) {
-    const int64_t row_id = i + row_start;
-    if ((nullptr != parent) && parent->can_skip_filter(i)) {
-      // skip
-    } else {
-      ENCODING_ADAPT_MEMCPY(&cur_ref, ref_buf + row_id * ref_width_size, ref_width_size);
-      if (has_null && (cur_ref == null_replaced_val)) {
-        if (OB_FAIL(result_bitmap.set(i, false))) {
-          LOG_WARN("fail to set bitmap", KR(ret), K(i), K(row_id));
-        }
-      } else if (ref_bitset->exist(cur_ref)) {
-        if (OB_FAIL(result_bitmap.set(i, flag))) {
-          LOG_WARN("fail to set bitmap", KR(ret), K(i), K(row_id), K(flag));
+  if (nullptr == parent || !parent->need_check_row_filter()) {
+    uint8_t *res = result_bitmap.get_data();
+    switch (ref_width_size) {
+      case 1:
+        batch_set_bitmap_with_bitset<uint8_t>(ref_buf, ref_bitset, row_start, row_cnt, has_null,
+            null_replaced_val, flag, res);
+        break;
+      case 2:
+        batch_set_bitmap_with_bitset<uint16_t>(ref_buf, ref_bitset, row_start, row_cnt, has_null,
+            null_replaced_val, flag, res);
+        break;
+      case 4:
+        batch_set_bitmap_with_bitset<uint32_t>(ref_buf, ref_bitset, row_start, row_cnt, has_null,
+            null_replaced_val, flag, res);
+        break;
+      case 8:
+        batch_set_bitmap_with_bitset<uint64_t>(ref_buf, ref_bitset, row_start, row_cnt, has_null,
+            null_replaced_val, flag, res);
+        break;
+      default:
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected ref width size", KR(ret), K(ref_width_size));
+    }
+  } else {
+    uint64_t cur_ref = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && (i < row_cnt); ++i) {
+      const int64_t row_id = i + row_start;
+      if (parent->can_skip_filter(i)) {
+        // skip
+      } else {
+        ENCODING_ADAPT_MEMCPY(&cur_ref, ref_buf + row_id * ref_width_size, ref_width_size);
+        if (has_null && (cur_ref == null_replaced_val)) {
+          if (OB_FAIL(result_bitmap.set(i, false))) {
+            LOG_WARN("fail to set bitmap", KR(ret), K(i), K(row_id));
+          }
+        } else if (ref_bitset->exist(cur_ref)) {
+          if (OB_FAIL(result_bitmap.set(i, flag))) {
+            LOG_WARN("fail to set bitmap", KR(ret), K(i), K(row_id), K(flag));
+          }
         }
       }
     }
@@ -2060,6 +2109,19 @@ int ObDictColumnDecoder::read_distinct(
   return ret;
 }
 
+template <typename RefType>
+static void batch_read_refs(
+    const char *ref_data,
+    const int64_t *row_ids,
+    const int64_t row_cap,
+    uint32_t *__restrict refs)
+{
+  const RefType *__restrict ref_arr = reinterpret_cast<const RefType *>(ref_data);
+  for (int64_t i = 0; i < row_cap; ++i) {
+    refs[i] = ref_arr[row_ids[i]];
+  }
+}
+
 int ObDictColumnDecoder::read_reference(
     const ObColumnCSDecoderCtx &ctx,
     const int64_t *row_ids,
@@ -2085,8 +2147,20 @@ int ObDictColumnDecoder::read_reference(
         LOG_WARN("Failed to extrace null count", K(ret));
       }
     } else {
-      for (int64_t i = 0; i < row_cap; ++i) {
-        ENCODING_ADAPT_MEMCPY(group_by_ref_buf + i, dict_ctx.ref_data_ + row_ids[i] * width_size, width_size);
+      switch (width_size) {
+        case 1:
+          batch_read_refs<uint8_t>(dict_ctx.ref_data_, row_ids, row_cap, group_by_ref_buf);
+          break;
+        case 2:
+          batch_read_refs<uint16_t>(dict_ctx.ref_data_, row_ids, row_cap, group_by_ref_buf);
+          break;
+        case 4:
+          batch_read_refs<uint32_t>(dict_ctx.ref_data_, row_ids, row_cap, group_by_ref_buf);
+          break;
+        default:
+          for (int64_t i = 0; i < row_cap; ++i) {
+            ENCODING_ADAPT_MEMCPY(group_by_ref_buf + i, dict_ctx.ref_data_ + row_ids[i] * width_size, width_size);
+          }
       }
     }
   }
@@ -89,6 +89,54 @@ int ObIntegerColumnDecoder::get_null_count(
   return ret;
 }
 
+int ObIntegerColumnDecoder::equal_range(
+    const ObIntegerColumnDecoderCtx &ctx,
+    const common::ObDatum &datum,
+    const int64_t begin_idx,
+    const int64_t end_idx,
+    int64_t &lower_idx,
+    int64_t &upper_idx,
+    bool &is_located)
+{
+  int ret = OB_SUCCESS;
+  is_located = false;
+  bool is_col_signed = false;
+  const ObObjType store_col_type = ctx.col_header_->get_store_obj_type();
+  if (OB_UNLIKELY(begin_idx < 0 || begin_idx > end_idx)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(begin_idx), K(end_idx));
+  } else if (!ctx.has_no_null() || datum.is_null() || datum.is_ext() ||
+             ObDecimalIntTC == ob_obj_type_class(store_col_type) ||
+             !ObCSDecodingUtil::can_convert_to_integer(store_col_type, is_col_signed)) {
+    // compare with decoded datums
+  } else {
+    bool is_datum_signed = false;
+    uint64_t datum_val = 0;
+    int64_t datum_val_size = 0;
+    uint64_t base_diff = 0;
+    const ObIntegerStreamMeta &stream_meta = ctx.ctx_->meta_;
+    const uint64_t base_value = stream_meta.is_use_base() * stream_meta.base_value_;
+    const uint32_t store_width_size = stream_meta.get_uint_width_size();
+    (void)ObCSDecodingUtil::check_datum_not_over_8bytes(
+        store_col_type, datum, is_datum_signed, datum_val, datum_val_size);
+    if (ObCSDecodingUtil::is_less_than_with_diff(
+        datum_val, datum_val_size, is_datum_signed, base_value, 8, is_col_signed, base_diff)) {
+      // less than all the rows
+      lower_idx = begin_idx;
+      upper_idx = begin_idx;
+    } else if (~INTEGER_MASK_TABLE[store_width_size] & base_diff) {
+      // greater than all the rows
+      lower_idx = end_idx;
+      upper_idx = end_idx;
+    } else {
+      ObCSFilterFunctionFactory::instance().integer_equal_range(
+          ctx.data_, store_width_size, base_diff, begin_idx, end_idx, lower_idx, upper_idx);
+    }
+    is_located = true;
+  }
+  return ret;
+}
+
 int ObIntegerColumnDecoder::pushdown_operator(
     const sql::ObPushdownFilterExecutor *parent,
     const ObColumnCSDecoderCtx &col_ctx,
@@ -106,14 +154,8 @@ int ObIntegerColumnDecoder::pushdown_operator(
     ret = OB_NOT_SUPPORTED;
   } else {
     if (integer_ctx.has_null_bitmap()) {
-      for (int64_t i = 0; OB_SUCC(ret) && (i < row_cnt); ++i) {
-        const int64_t row_id = pd_filter_info.start_ + i;
-        if (ObCSDecodingUtil::test_bit(integer_ctx.null_bitmap_, row_id)) {
-          if (OB_FAIL(result_bitmap.set(i))) {
-            LOG_WARN("fail to set bitmap", KR(ret), K(i), K(row_id));
-          }
-        }
-      }
+      ObCSDecodingUtil::batch_test_bits(integer_ctx.null_bitmap_, pd_filter_info.start_, row_cnt,
+          result_bitmap.get_data());
     }
     if (OB_SUCC(ret)) {
       const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
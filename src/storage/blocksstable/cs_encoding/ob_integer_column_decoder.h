@@ -46,6 +46,16 @@ public:
       const sql::PushdownFilterInfo &pd_filter_info,
       common::ObBitmap &result_bitmap) const override;
 
+  // Locate the rows equal to %datum in [begin_idx, end_idx) of a sorted rowkey column with the
+  // encoded integer stream, is_located is false if the column or the datum is not supported.
+  static int equal_range(const ObIntegerColumnDecoderCtx &ctx,
+                         const common::ObDatum &datum,
+                         const int64_t begin_idx,
+                         const int64_t end_idx,
+                         int64_t &lower_idx,
+                         int64_t &upper_idx,
+                         bool &is_located);
+
 private:
   static int nu_nn_operator(const ObIntegerColumnDecoderCtx &ctx,
                             const sql::ObPushdownFilterExecutor *parent,
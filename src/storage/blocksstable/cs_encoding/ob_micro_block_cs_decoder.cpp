@@ -198,6 +198,19 @@ int ObColumnCSDecoder::quick_compare(const ObStorageDatum &left,
   return ret;
 }
 
+int ObColumnCSDecoder::equal_range(const ObStorageDatum &datum, const int64_t begin_idx,
+  const int64_t end_idx, int64_t &lower_idx, int64_t &upper_idx, bool &is_located) const
+{
+  int ret = OB_SUCCESS;
+  is_located = false;
+  if (!ctx_->is_integer_type()) {
+  } else if (OB_FAIL(ObIntegerColumnDecoder::equal_range(
+      ctx_->integer_ctx_, datum, begin_idx, end_idx, lower_idx, upper_idx, is_located))) {
+    LOG_WARN("fail to locate equal range", K(ret), K(datum), K(begin_idx), K(end_idx));
+  }
+  return ret;
+}
+
 /////////////////////// acquire decoder from local ///////////////////////
 typedef int (*local_decode_acquire_func)(ObCSDecoderPool &local_decoder_pool,
                                    const ObIColumnCSDecoder *&decoder);
@@ -549,13 +562,24 @@ int ObCSEncodeBlockGetReader::locate_row(const ObDatumRowkey &rowkey,
     // reader_
     const int64_t rowkey_cnt = rowkey.get_datum_cnt();
     const ObStorageDatum *datums = rowkey.datums_;
+    const int64_t row_count = transform_helper_.get_micro_block_header()->row_count_;
+    int64_t lower_idx = 0;
+    int64_t upper_idx = row_count;
+    bool is_located = false;
+    if (rowkey_cnt > 0 && OB_FAIL(decoders_[0].equal_range(
+        datums[0], 0, row_count, lower_idx, upper_idx, is_located))) {
+      LOG_WARN("fail to locate leading rowkey column", K(ret), K(rowkey));
+    } else if (is_located && 1 == rowkey_cnt && lower_idx < upper_idx) {
+      found = true;
+      row_id = lower_idx;
+    }
     // binary search
-    int32_t high = transform_helper_.get_micro_block_header()->row_count_ - 1;
-    int32_t low = 0;
+    int32_t high = static_cast<int32_t>(upper_idx) - 1;
+    int32_t low = static_cast<int32_t>(lower_idx);
     int32_t middle = 0;
     int32_t cmp_result = 0;
 
-    while (OB_SUCC(ret) && low <= high) {
+    while (OB_SUCC(ret) && !found && low <= high) {
       middle = (low + high) >> 1;
       cmp_result = 0;
       for (int64_t i = 0; OB_SUCC(ret) && 0 == cmp_result && i < rowkey_cnt; ++i) {
@@ -1081,6 +1105,84 @@ int ObMicroBlockCSDecoder::compare_rowkey(
   }
   return ret;
 }
+
+int ObMicroBlockCSDecoder::find_bound(const ObDatumRowkey &key, const bool lower_bound,
+  const int64_t begin_idx, int64_t &row_idx, bool &equal)
+{
+  int ret = OB_SUCCESS;
+  equal = false;
+  row_idx = ObIMicroBlockReaderInfo::INVALID_ROW_INDEX;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(begin_idx >= row_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(begin_idx), K_(row_count));
+  } else if (OB_FAIL(find_bound(key, lower_bound, begin_idx, row_count_, row_idx, equal))) {
+    LOG_WARN("fail to find bound", K(ret), K(key), K(lower_bound), K(begin_idx));
+  }
+  return ret;
+}
+
+int ObMicroBlockCSDecoder::find_bound(const ObDatumRange &range, const int64_t begin_idx,
+  int64_t &row_idx, bool &equal, int64_t &end_key_begin_idx, int64_t &end_key_end_idx)
+{
+  int ret = OB_SUCCESS;
+  int64_t lower_idx = begin_idx;
+  int64_t upper_idx = row_count_;
+  bool is_located = false;
+  equal = false;
+  row_idx = ObIMicroBlockReaderInfo::INVALID_ROW_INDEX;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(!range.is_valid() || begin_idx < 0 || begin_idx > row_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(range), K(begin_idx), K_(row_count));
+  } else if (range.get_start_key().get_datum_cnt() > 0 && OB_FAIL(decoders_[0].equal_range(
+      range.get_start_key().datums_[0], begin_idx, row_count_, lower_idx, upper_idx, is_located))) {
+    LOG_WARN("fail to locate leading rowkey column", K(ret), K(range), K(begin_idx));
+  } else if (!is_located) {
+    if (OB_FAIL(ObIMicroBlockDecoder::find_bound(
+        range, begin_idx, row_idx, equal, end_key_begin_idx, end_key_end_idx))) {
+      LOG_WARN("fail to find bound", K(ret), K(range), K(begin_idx));
+    }
+  } else if (1 == range.get_start_key().get_datum_cnt() || lower_idx == upper_idx) {
+    equal = lower_idx < upper_idx;
+    row_idx = lower_idx;
+  } else if (OB_FAIL(ObIMicroBlockDecoder::find_bound(
+      range.get_start_key(), true/*lower_bound*/, lower_idx, upper_idx, row_idx, equal))) {
+    LOG_WARN("fail to find bound", K(ret), K(range), K(lower_idx), K(upper_idx));
+  }
+  return ret;
+}
+
+int ObMicroBlockCSDecoder::find_bound(const ObDatumRowkey &key, const bool lower_bound,
+  const int64_t begin_idx, const int64_t end_idx, int64_t &row_idx, bool &equal)
+{
+  int ret = OB_SUCCESS;
+  int64_t lower_idx = begin_idx;
+  int64_t upper_idx = end_idx;
+  bool is_located = false;
+  equal = false;
+  row_idx = ObIMicroBlockReaderInfo::INVALID_ROW_INDEX;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(!key.is_valid() || begin_idx < 0 || begin_idx > end_idx || end_idx > row_count_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key), K(begin_idx), K(end_idx), K_(row_count));
+  } else if (OB_FAIL(decoders_[0].equal_range(key.datums_[0], begin_idx, end_idx, lower_idx, upper_idx, is_located))) {
+    LOG_WARN("fail to locate leading rowkey column", K(ret), K(key), K(begin_idx), K(end_idx));
+  } else if (is_located && (1 == key.get_datum_cnt() || lower_idx == upper_idx)) {
+    equal = lower_idx < upper_idx;
+    row_idx = lower_bound ? lower_idx : upper_idx;
+  } else if (OB_FAIL(ObIMicroBlockDecoder::find_bound(key, lower_bound, lower_idx, upper_idx, row_idx, equal))) {
+    LOG_WARN("fail to find bound", K(ret), K(key), K(lower_bound), K(lower_idx), K(upper_idx));
+  }
+  return ret;
+}
+
 int ObMicroBlockCSDecoder::compare_rowkey(const ObDatumRange &range,
                                           const int64_t index,
                                           int32_t &start_key_compare_result,
@@ -45,6 +45,10 @@ public:
   // performance critical, do not check parameters
   int quick_compare(const ObStorageDatum &left, const ObStorageDatumCmpFunc &cmp_func,
     const int64_t row_id, int32_t &cmp_ret);
+  // used for locate row in micro block by the leading rowkey column without decoding,
+  // is_located is false if not supported by the column encoding
+  int equal_range(const ObStorageDatum &datum, const int64_t begin_idx, const int64_t end_idx,
+    int64_t &lower_idx, int64_t &upper_idx, bool &is_located) const;
 
   int batch_decode(const int64_t *row_ids, const int64_t row_cap, common::ObDatum *datums);
   int get_row_count(
@@ -194,6 +198,8 @@ public:
     const ObDatumRowkey &rowkey, const int64_t index, int32_t &compare_result) override;
   virtual int compare_rowkey(const ObDatumRange &range, const int64_t index,
     int32_t &start_key_compare_result, int32_t &end_key_compare_result) override;
+  virtual int find_bound(const ObDatumRowkey &key, const bool lower_bound, const int64_t begin_idx,
+    int64_t &row_idx, bool &equal) override;
 
   // Filter interface for filter pushdown
   int filter_pushdown_filter(const sql::ObPushdownFilterExecutor *parent,
@@ -245,6 +251,14 @@ public:
   virtual int get_group_by_aggregate_result(const int64_t *row_ids, const char **cell_datas,
     const int64_t row_cap, storage::ObGroupByCell &group_by_cell) override;
 
+protected:
+  // the leading rowkey column is searched first without decoding if it is integer encoded, and the
+  // rest columns are only compared in the rows equal to it
+  virtual int find_bound(const ObDatumRange &range, const int64_t begin_idx, int64_t &row_idx,
+    bool &equal, int64_t &end_key_begin_idx, int64_t &end_key_end_idx) override;
+  virtual int find_bound(const ObDatumRowkey &key, const bool lower_bound, const int64_t begin_idx,
+    const int64_t end_idx, int64_t &row_idx, bool &equal) override;
+
 private:
   // use inner_reset to reuse the decoder buffer
   // the column count would not change in most cases
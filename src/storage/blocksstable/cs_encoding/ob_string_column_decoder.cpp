@@ -353,6 +353,27 @@ struct FilterTranverseDatumInit
 };
 static bool filter_tranverse_datum_inited = ObNDArrayIniter<FilterTranverseDatumInit, 5, 3, 2>::apply();
 
+template<int32_t offset_width_V>
+static void set_zero_length_bitmap(
+    const ObStringColumnDecoderCtx &ctx,
+    const int64_t row_start,
+    const int64_t row_count,
+    common::ObBitmap &result_bitmap)
+{
+  typedef typename ObCSEncodingStoreTypeInference<offset_width_V>::Type OffsetIntType;
+  const OffsetIntType *__restrict offset_arr = reinterpret_cast<const OffsetIntType *>(ctx.offset_data_);
+  uint8_t *__restrict res = result_bitmap.get_data();
+  int64_t i = 0;
+  if (0 == row_start) {
+    res[0] |= (0 == offset_arr[0]);
+    i = 1;
+  }
+  for (; i < row_count; ++i) {
+    const int64_t row_id = row_start + i;
+    res[i] |= (offset_arr[row_id] == offset_arr[row_id - 1]);
+  }
+}
+
 
 int ObStringColumnDecoder::pushdown_operator(
     const sql::ObPushdownFilterExecutor *parent,
@@ -433,8 +454,31 @@ int ObStringColumnDecoder::nunn_operator(
   int ret = OB_SUCCESS;
   const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
 
-  if (!ctx.has_no_null()) {
-    const bool is_fixed_len_str = ctx.str_ctx_->meta_.is_fixed_len_string();
+  const bool is_fixed_len_str = ctx.str_ctx_->meta_.is_fixed_len_string();
+  if (ctx.has_no_null()) {
+    // no null, result bitmap is all false
+  } else if (ctx.has_null_bitmap()) {
+    ObCSDecodingUtil::batch_test_bits(ctx.null_bitmap_, row_start, row_count, result_bitmap.get_data());
+  } else if (ctx.is_null_replaced() && !is_fixed_len_str) {
+    // zero length is null, compare adjacent offsets without materializing datums
+    switch (ctx.offset_ctx_->meta_.width_) {
+      case ObIntegerStream::UintWidth::UW_1_BYTE:
+        set_zero_length_bitmap<ObIntegerStream::UintWidth::UW_1_BYTE>(ctx, row_start, row_count, result_bitmap);
+        break;
+      case ObIntegerStream::UintWidth::UW_2_BYTE:
+        set_zero_length_bitmap<ObIntegerStream::UintWidth::UW_2_BYTE>(ctx, row_start, row_count, result_bitmap);
+        break;
+      case ObIntegerStream::UintWidth::UW_4_BYTE:
+        set_zero_length_bitmap<ObIntegerStream::UintWidth::UW_4_BYTE>(ctx, row_start, row_count, result_bitmap);
+        break;
+      case ObIntegerStream::UintWidth::UW_8_BYTE:
+        set_zero_length_bitmap<ObIntegerStream::UintWidth::UW_8_BYTE>(ctx, row_start, row_count, result_bitmap);
+        break;
+      default:
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected offset width", KR(ret), K(ctx));
+    }
+  } else {
     const bool need_padding = (ctx.obj_meta_.is_fixed_len_char_type() && nullptr != ctx.col_param_);
 
     ObFunction<int(const ObObjMeta &obj_meta, const ObDatum &cur_datum, const int64_t idx)> op_handle =
@@ -1531,6 +1531,21 @@ int ObDictDecoder::batch_read_distinct(
     ref_buf[i] = static_cast<uint32_t>(ref); \
   }
 
+template <typename RefType>
+static void batch_read_refs(
+    const unsigned char *col_data,
+    const int64_t *row_ids,
+    const int64_t row_cap,
+    uint32_t *__restrict refs)
+{
+  // the ref array may be unaligned in the micro block
+  for (int64_t i = 0; i < row_cap; ++i) {
+    RefType ref = 0;
+    MEMCPY(&ref, col_data + row_ids[i] * sizeof(RefType), sizeof(RefType));
+    refs[i] = ref;
+  }
+}
+
 int ObDictDecoder::read_reference(
     const ObColumnDecoderCtx &ctx,
     const int64_t *row_ids,
@@ -1567,8 +1582,20 @@ int ObDictDecoder::read_reference(
         LOG_WARN("Unpack size larger than 64 bit", K(ret), K(row_ref_size));
       }
     } else {
-      for (int64_t i = 0; i < row_cap; ++i) {
-        MEMCPY(ref_buf + i, col_data + row_ids[i] * row_ref_size, row_ref_size);
+      switch (row_ref_size) {
+        case 1:
+          batch_read_refs<uint8_t>(col_data, row_ids, row_cap, ref_buf);
+          break;
+        case 2:
+          batch_read_refs<uint16_t>(col_data, row_ids, row_cap, ref_buf);
+          break;
+        case 4:
+          batch_read_refs<uint32_t>(col_data, row_ids, row_cap, ref_buf);
+          break;
+        default:
+          for (int64_t i = 0; i < row_cap; ++i) {
+            MEMCPY(ref_buf + i, col_data + row_ids[i] * row_ref_size, row_ref_size);
+          }
       }
     }
   }
@@ -233,6 +233,100 @@ int ObColMinAggregator::get_result(const ObStorageDatum *&result)
   return ret;
 }
 
+int ObColBloomFilterAggregator::init(const ObColDesc &col_desc, ObStorageDatum &result)
+{
+  int ret = OB_SUCCESS;
+  if (OB_NOT_NULL(result_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("Init twice", K(ret));
+  } else {
+    obj_type_ = col_desc.col_type_.get_type();
+    cs_type_ = col_desc.col_type_.get_collation_type();
+    sql::ObExprBasicFuncs *basic_funcs = ObDatumFuncs::get_basic_func(obj_type_, cs_type_);
+    hash_func_ = basic_funcs->murmur_hash_;
+    result_ = &result;
+    result_->set_null();
+    MEMSET(bits_, 0, sizeof(bits_));
+    if (is_lob_storage(obj_type_)) {
+      set_not_aggregate();
+    }
+    LOG_DEBUG("[SKIP INDEX] init bloom filter aggregator", K(obj_type_), K(can_aggregate_));
+  }
+  return ret;
+}
+
+void ObColBloomFilterAggregator::reuse()
+{
+  if (nullptr != result_) {
+    result_->set_null();
+  }
+  MEMSET(bits_, 0, sizeof(bits_));
+  if (is_lob_storage(obj_type_)) {
+    set_not_aggregate();
+  } else {
+    can_aggregate_ = true;
+  }
+}
+
+int ObColBloomFilterAggregator::eval(const ObStorageDatum &datum, const bool is_data)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(result_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not init", K(ret));
+  } else if (!can_aggregate_ || datum.is_nop()) {
+    // Skip
+  } else if (is_data) {
+    if (!datum.is_null() && OB_FAIL(add_value(datum))) {
+      LOG_WARN("Fail to add value to bloom filter", K(ret), K(datum), K_(obj_type));
+    }
+  } else if (datum.is_null() || !ObSkipIndexBloomFilter::is_valid_size(datum.len_)) {
+    // bloom filter of lower level is not stored, e.g. saturated or built by older version
+    set_not_aggregate();
+  } else {
+    ObSkipIndexBloomFilter::merge(datum.ptr_, datum.len_, bits_, sizeof(bits_));
+  }
+  return ret;
+}
+
+int ObColBloomFilterAggregator::add_value(const ObStorageDatum &datum)
+{
+  int ret = OB_SUCCESS;
+  uint64_t hash = 0;
+  if (OB_FAIL(hash_func_(datum, ObSkipIndexBloomFilter::HASH_SEED, hash))) {
+    LOG_WARN("Fail to calc hash of datum", K(ret), K(datum), K_(obj_type));
+  } else {
+    ObSkipIndexBloomFilter::add(hash, bits_, sizeof(bits_));
+  }
+  return ret;
+}
+
+int ObColBloomFilterAggregator::get_result(const ObStorageDatum *&result)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(result_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not init", K(ret));
+  } else {
+    if (can_aggregate_ && !ObSkipIndexBloomFilter::is_saturated(bits_, sizeof(bits_))) {
+      MEMCPY(result_bits_, bits_, sizeof(bits_));
+      const int64_t result_size = ObSkipIndexBloomFilter::fold(result_bits_, sizeof(result_bits_));
+      result_->set_string(result_bits_, static_cast<uint32_t>(result_size));
+    } else {
+      result_->set_nop();
+    }
+    result = result_;
+  }
+  return ret;
+}
+
+int ObColNgramBloomFilterAggregator::add_value(const ObStorageDatum &datum)
+{
+  int ret = OB_SUCCESS;
+  ObSkipIndexBloomFilter::add_ngrams(cs_type_, datum.get_string(), bits_, sizeof(bits_));
+  return ret;
+}
+
 ObSkipIndexAggregator::ObSkipIndexAggregator()
   : allocator_(nullptr),
     col_aggs_(),
@@ -390,7 +484,8 @@ int ObSkipIndexAggregator::get_aggregated_row(const ObDatumRow *&aggregated_row)
       } else if (OB_ISNULL(result)) {
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("Fail to get aggregated column result", K(ret), K(i));
-      } else if (OB_UNLIKELY(result->len_ > ObSkipIndexColMeta::MAX_SKIP_INDEX_COL_LENGTH
+      } else if (OB_UNLIKELY(result->len_ > ObSkipIndexColMeta::get_agg_col_length_limit(
+          static_cast<ObSkipIndexColType>(full_agg_metas_->at(i).col_type_))
           || result->is_outrow())) {
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("Unexpected aggregated result datum", K(ret), K(result), K(i), K_(full_agg_metas));
@@ -449,6 +544,11 @@ int ObSkipIndexAggregator::calc_max_agg_size(
             cur_max_cell_size += sizeof(int64_t);
             break;
           }
+          case ObSkipIndexColType::SK_IDX_BLOOM_FILTER:
+          case ObSkipIndexColType::SK_IDX_NGRAM_BLOOM_FILTER: {
+            cur_max_cell_size += ObSkipIndexColMeta::get_agg_col_length_limit(idx_type);
+            break;
+          }
           default: {
             ret = OB_NOT_SUPPORTED;
             LOG_WARN("Not support skip index aggregate type", K(ret), K(idx_type));
@@ -508,6 +608,20 @@ int ObSkipIndexAggregator::init_col_aggregators(
         }
         break;
       }
+      case ObSkipIndexColType::SK_IDX_BLOOM_FILTER: {
+        if (OB_FAIL(init_col_aggregator<ObColBloomFilterAggregator>(
+            full_col_descs.at(col_idx), agg_result_->storage_datums_[i], allocator))) {
+          LOG_WARN("Fail to allocate column aggregator", K(ret));
+        }
+        break;
+      }
+      case ObSkipIndexColType::SK_IDX_NGRAM_BLOOM_FILTER: {
+        if (OB_FAIL(init_col_aggregator<ObColNgramBloomFilterAggregator>(
+            full_col_descs.at(col_idx), agg_result_->storage_datums_[i], allocator))) {
+          LOG_WARN("Fail to allocate column aggregator", K(ret));
+        }
+        break;
+      }
       default: {
         ret = OB_NOT_SUPPORTED;
         LOG_WARN("Not supported skip index aggregate type", K(ret), K(idx_type));
@@ -94,6 +94,51 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObColMinAggregator);
 };
 
+// Build bloom filter from data rows, or merge bloom filters of lower level index rows.
+// The filter is built in the max size and folded to fit the distinct values when stored.
+class ObColBloomFilterAggregator : public ObIColAggregator
+{
+public:
+  ObColBloomFilterAggregator()
+    : hash_func_(nullptr), result_(nullptr), obj_type_(ObObjType::ObMaxType),
+      cs_type_(CS_TYPE_INVALID)
+  {
+    MEMSET(bits_, 0, sizeof(bits_));
+    MEMSET(result_bits_, 0, sizeof(result_bits_));
+  }
+  virtual ~ObColBloomFilterAggregator() {}
+
+  int init(const ObColDesc &col_desc, ObStorageDatum &result) override;
+  void reset() override { new (this) ObColBloomFilterAggregator(); }
+  void reuse() override;
+  int eval(const ObStorageDatum &datum, const bool is_data) override;
+  int get_result(const ObStorageDatum *&result) override;
+protected:
+  virtual int add_value(const ObStorageDatum &datum);
+protected:
+  sql::ObExprHashFuncType hash_func_;
+  ObStorageDatum *result_;
+  ObObjType obj_type_;
+  ObCollationType cs_type_;
+  char bits_[ObSkipIndexBloomFilter::MAX_FILTER_SIZE];
+  // folded filter of the result, bits_ is kept for the rows evaluated later
+  char result_bits_[ObSkipIndexBloomFilter::MAX_FILTER_SIZE];
+  DISALLOW_COPY_AND_ASSIGN(ObColBloomFilterAggregator);
+};
+
+// Bloom filter of the ngrams in string values.
+class ObColNgramBloomFilterAggregator : public ObColBloomFilterAggregator
+{
+public:
+  ObColNgramBloomFilterAggregator() : ObColBloomFilterAggregator() {}
+  virtual ~ObColNgramBloomFilterAggregator() {}
+
+  void reset() override { new (this) ObColNgramBloomFilterAggregator(); }
+protected:
+  int add_value(const ObStorageDatum &datum) override;
+  DISALLOW_COPY_AND_ASSIGN(ObColNgramBloomFilterAggregator);
+};
+
 class ObSkipIndexAggregator final
 {
 public:
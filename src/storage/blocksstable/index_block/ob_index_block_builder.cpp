@@ -67,6 +67,8 @@ void ObIndexTreeRootCtx::reset()
   meta_block_offset_ = 0;
   meta_block_size_ = 0;
   last_macro_size_ = 0;
+  rowkey_hashes_.destroy();
+  need_rowkey_bloom_filter_ = false;
 }
 
 int ObIndexTreeRootCtx::init(common::ObIAllocator &allocator)
@@ -83,6 +85,7 @@ int ObIndexTreeRootCtx::init(common::ObIAllocator &allocator)
     ret = OB_ERR_UNEXPECTED;
     STORAGE_LOG(WARN, "fail to new ObMacroMetasArray", K(ret));
   } else {
+    rowkey_hashes_.set_attr(ObMemAttr(MTL_ID(), "RkBfHashes"));
     allocator_ = &allocator;
     is_inited_ = true;
   }
@@ -209,6 +212,7 @@ ObSSTableMergeRes::ObSSTableMergeRes()
     data_checksum_(0),
     use_old_macro_block_count_(0),
     data_column_checksums_(),
+    rowkey_bloom_filter_(),
     compressor_type_(ObCompressorType::INVALID_COMPRESSOR),
     encrypt_id_(0),
     master_key_id_(0),
@@ -222,6 +226,7 @@ ObSSTableMergeRes::ObSSTableMergeRes()
     data_block_ids_.set_attr(attr);
     other_block_ids_.set_attr(attr);
     data_column_checksums_.set_attr(attr);
+    rowkey_bloom_filter_.set_attr(attr);
   }
 }
 ObSSTableMergeRes::~ObSSTableMergeRes()
@@ -260,6 +265,7 @@ void ObSSTableMergeRes::reset()
   data_checksum_ = 0;
   use_old_macro_block_count_ = 0;
   data_column_checksums_.reset();
+  rowkey_bloom_filter_.destroy();
   compressor_type_ = ObCompressorType::INVALID_COMPRESSOR;
   encrypt_id_ = 0;
   master_key_id_ = 0;
@@ -339,6 +345,10 @@ int ObSSTableMergeRes::assign(const ObSSTableMergeRes &src)
         }
       }
     }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(rowkey_bloom_filter_.assign(src.rowkey_bloom_filter_))) {
+      STORAGE_LOG(WARN, "failed to assign rowkey bloom filter", K(ret));
+    }
   }
   return ret;
 }
@@ -858,6 +868,31 @@ int ObSSTableIndexBuilder::generate_macro_blocks_info(ObSSTableMergeRes &res)
   return ret;
 }
 
+int ObSSTableIndexBuilder::build_rowkey_bloom_filter(ObSSTableMergeRes &res)
+{
+  int ret = OB_SUCCESS;
+  bool need_build = true;
+  int64_t row_count = 0;
+  for (int64_t i = 0; need_build && i < roots_.count(); ++i) {
+    // the rowkeys of reused blocks are unknown, no filter for the whole sstable
+    need_build = roots_[i]->need_rowkey_bloom_filter_;
+    row_count += roots_[i]->rowkey_hashes_.count();
+  }
+  if (!need_build || 0 == row_count || row_count > ObRowkeyBloomFilter::MAX_ROW_COUNT) {
+    STORAGE_LOG(DEBUG, "skip building rowkey bloom filter", K(need_build), K(row_count));
+  } else if (OB_FAIL(ObRowkeyBloomFilter::prepare(row_count, res.rowkey_bloom_filter_))) {
+    STORAGE_LOG(WARN, "fail to prepare rowkey bloom filter", K(ret), K(row_count));
+  } else {
+    for (int64_t i = 0; i < roots_.count(); ++i) {
+      const ObArray<uint64_t> &hashes = roots_[i]->rowkey_hashes_;
+      for (int64_t j = 0; j < hashes.count(); ++j) {
+        ObRowkeyBloomFilter::add(hashes.at(j), res.rowkey_bloom_filter_);
+      }
+    }
+  }
+  return ret;
+}
+
 int ObSSTableIndexBuilder::accumulate_macro_column_checksum(
     const ObDataMacroBlockMeta &meta, ObSSTableMergeRes &res)
 {
@@ -953,6 +988,8 @@ int ObSSTableIndexBuilder::close(
     STORAGE_LOG(WARN, "fail to build meta tree", K(ret));
   } else if (OB_FAIL(generate_macro_blocks_info(res))) {
     STORAGE_LOG(WARN, "fail to generate id list", K(ret));
+  } else if (OB_FAIL(build_rowkey_bloom_filter(res))) {
+    STORAGE_LOG(WARN, "fail to build rowkey bloom filter", K(ret));
   }
 
   if (OB_SUCC(ret) && OB_LIKELY(!is_closed_)) {
@@ -1765,6 +1802,9 @@ int ObDataIndexBlockBuilder::init(
   } else if (OB_FAIL(sstable_builder.init_builder_ptrs(sstable_builder_, index_store_desc,
       leaf_store_desc_, index_tree_root_ctx_, macro_meta_list_))) {
     STORAGE_LOG(WARN, "fail to init referemce pointer members", K(ret));
+  } else if (OB_FAIL(check_need_rowkey_bloom_filter(data_store_desc,
+      index_tree_root_ctx_->need_rowkey_bloom_filter_))) {
+    STORAGE_LOG(WARN, "fail to check need rowkey bloom filter", K(ret));
   } else if (OB_UNLIKELY(index_store_desc->get_row_store_type() != data_store_desc.get_row_store_type()
       && (index_store_desc->get_row_store_type() == FLAT_ROW_STORE
           || data_store_desc.get_row_store_type() == FLAT_ROW_STORE)
@@ -2102,6 +2142,55 @@ int ObDataIndexBlockBuilder::set_parallel_task_idx(const int64_t task_idx)
   return ret;
 }
 
+// The sstable meta with rowkey bloom filter can't be deserialized by observers before 4.3.0.1,
+// which may happen during migration or rebuild in the upgrade.
+int ObDataIndexBlockBuilder::check_need_rowkey_bloom_filter(
+    const ObDataStoreDesc &data_store_desc,
+    bool &need_rowkey_bloom_filter)
+{
+  int ret = OB_SUCCESS;
+  uint64_t data_version = 0;
+  need_rowkey_bloom_filter = false;
+  if (data_store_desc.is_cg()) {
+  } else if (data_store_desc.is_major_merge_type()) {
+    need_rowkey_bloom_filter = data_store_desc.get_major_working_cluster_version() >= DATA_VERSION_4_3_0_1;
+  } else if (!compaction::is_multi_version_merge(data_store_desc.get_merge_type())) {
+  } else if (OB_FAIL(GET_MIN_DATA_VERSION(MTL_ID(), data_version))) {
+    STORAGE_LOG(WARN, "fail to get data version", K(ret));
+  } else {
+    need_rowkey_bloom_filter = data_version >= DATA_VERSION_4_3_0_1;
+  }
+  return ret;
+}
+
+int ObDataIndexBlockBuilder::add_rowkey_hash(const uint64_t hash)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(index_tree_root_ctx_)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected null index_tree_root_ctx_", K(ret));
+  } else if (!index_tree_root_ctx_->need_rowkey_bloom_filter_) {
+  } else {
+    ObArray<uint64_t> &hashes = index_tree_root_ctx_->rowkey_hashes_;
+    if (!hashes.empty() && hashes.at(hashes.count() - 1) == hash) {
+      // multi version rows of the same rowkey
+    } else if (hashes.count() >= ObRowkeyBloomFilter::MAX_ROW_COUNT) {
+      disable_rowkey_bloom_filter();
+    } else if (OB_FAIL(hashes.push_back(hash))) {
+      STORAGE_LOG(WARN, "fail to push back rowkey hash", K(ret));
+    }
+  }
+  return ret;
+}
+
+void ObDataIndexBlockBuilder::disable_rowkey_bloom_filter()
+{
+  if (OB_NOT_NULL(index_tree_root_ctx_)) {
+    index_tree_root_ctx_->need_rowkey_bloom_filter_ = false;
+    index_tree_root_ctx_->rowkey_hashes_.destroy();
+  }
+}
+
 int ObDataIndexBlockBuilder::generate_macro_row(ObMacroBlock &macro_block,
                                                 const MacroBlockId &block_id)
 {
@@ -57,6 +57,8 @@ public:
      meta_block_offset_(0),
      meta_block_size_(0),
      last_macro_size_(0),
+     rowkey_hashes_(),
+     need_rowkey_bloom_filter_(false),
      is_inited_(false) {}
   ~ObIndexTreeRootCtx();
   int init(common::ObIAllocator &allocator);
@@ -68,7 +70,8 @@ public:
 
   TO_STRING_KV(KP(allocator_), K_(last_key), K_(data_column_cnt), K_(data_blocks_cnt),
       K_(use_old_macro_block_count), K_(meta_block_offset), K_(meta_block_size),
-      K_(last_macro_size), KP(macro_metas_), K_(is_inited));
+      K_(last_macro_size), KP(macro_metas_), "rowkey_hash_cnt", rowkey_hashes_.count(),
+      K_(need_rowkey_bloom_filter), K_(is_inited));
   common::ObIAllocator *allocator_;
   //TODO :replace by task id
   ObDatumRowkey last_key_;
@@ -80,6 +83,9 @@ public:
   int64_t meta_block_offset_;
   int64_t meta_block_size_;
   int64_t last_macro_size_;
+  // hashes of the rowkeys written by the data macro block writer, for the rowkey bloom filter
+  common::ObArray<uint64_t> rowkey_hashes_;
+  bool need_rowkey_bloom_filter_;
   bool is_inited_;
   DISALLOW_COPY_AND_ASSIGN(ObIndexTreeRootCtx);
 };
@@ -220,7 +226,7 @@ public:
   }
   TO_STRING_KV(K_(root_desc), K_(data_root_desc), K(data_block_ids_.count()), K(other_block_ids_.count()),
       K_(index_blocks_cnt), K_(data_blocks_cnt), K_(micro_block_cnt),
-      K_(data_column_cnt), K_(data_column_checksums),
+      K_(data_column_cnt), K_(data_column_checksums), "rowkey_bloom_filter_word_cnt", rowkey_bloom_filter_.count(),
       K_(row_count), K_(max_merged_trans_version), K_(contain_uncommitted_row),
       K_(occupy_size), K_(original_size), K_(data_checksum), K_(use_old_macro_block_count),
       K_(compressor_type), K_(root_row_store_type), K_(nested_offset), K_(nested_size),
@@ -242,6 +248,8 @@ public:
   int64_t data_checksum_;
   int64_t use_old_macro_block_count_;
   common::ObSEArray<int64_t, 1> data_column_checksums_;
+  // words of the rowkey bloom filter, empty if the filter is not built
+  common::ObArray<uint64_t> rowkey_bloom_filter_;
   common::ObCompressorType compressor_type_;
   int64_t encrypt_id_;
   int64_t master_key_id_;
@@ -327,6 +335,9 @@ public:
   int append_macro_block(const ObDataMacroBlockMeta &macro_meta);
   int cal_macro_meta_block_size(const ObDatumRowkey &rowkey, int64_t &estimate_block_size);
   int set_parallel_task_idx(const int64_t task_idx);
+  // rowkey bloom filter of the sstable is only built if the rowkey of every row is added
+  int add_rowkey_hash(const uint64_t hash);
+  void disable_rowkey_bloom_filter();
   inline int64_t get_estimate_index_block_size() const { return estimate_leaf_block_size_; }
   inline int64_t get_estimate_meta_block_size() const { return estimate_meta_block_size_; }
   int close(const ObDatumRowkey &last_key,
@@ -341,6 +352,9 @@ private:
   virtual int insert_and_update_index_tree(const ObDatumRow *index_row) override;
   int append_next_row(const ObMicroBlockDesc &micro_block_desc, ObIndexBlockRowDesc &macro_row_desc);
   int add_row_offset(ObIndexBlockRowDesc &row_desc);
+  static int check_need_rowkey_bloom_filter(
+      const ObDataStoreDesc &data_store_desc,
+      bool &need_rowkey_bloom_filter);
 private:
   ObSSTableIndexBuilder *sstable_builder_;
   compaction::ObLocalArena task_allocator_;  // Used to apply for memory whose lifetime is task
@@ -522,6 +536,7 @@ private:
   int merge_index_tree(ObSSTableMergeRes &res);
   int build_meta_tree(ObSSTableMergeRes &res);
   int generate_macro_blocks_info(ObSSTableMergeRes &res);
+  int build_rowkey_bloom_filter(ObSSTableMergeRes &res);
   int accumulate_macro_column_checksum(
       const ObDataMacroBlockMeta &meta, ObSSTableMergeRes &res);
   void clean_status();
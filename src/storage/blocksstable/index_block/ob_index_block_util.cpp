@@ -50,6 +50,18 @@ int ObSkipIndexColMeta::append_skip_index_meta(
       STORAGE_LOG(WARN, "failed to push sum skip index meta", K(ret));
     }
   }
+
+  if (OB_SUCC(ret) && skip_idx_attr.has_bloom_filter()) {
+    if (OB_FAIL(skip_idx_metas.push_back(ObSkipIndexColMeta(col_idx, ObSkipIndexColType::SK_IDX_BLOOM_FILTER)))) {
+      STORAGE_LOG(WARN, "failed to push bloom filter skip index meta", K(ret));
+    }
+  }
+
+  if (OB_SUCC(ret) && skip_idx_attr.has_ngram_bloom_filter()) {
+    if (OB_FAIL(skip_idx_metas.push_back(ObSkipIndexColMeta(col_idx, ObSkipIndexColType::SK_IDX_NGRAM_BLOOM_FILTER)))) {
+      STORAGE_LOG(WARN, "failed to push ngram bloom filter skip index meta", K(ret));
+    }
+  }
   return ret;
 }
 
@@ -91,5 +103,38 @@ int ObSkipIndexColMeta::calc_skip_index_maximum_size(
   return ret;
 }
 
+int64_t ObSkipIndexColMeta::calc_skip_index_filter_maximum_size(
+    const share::schema::ObSkipIndexColumnAttr &skip_idx_attr)
+{
+  int64_t max_size = 0;
+  if (skip_idx_attr.has_bloom_filter()) {
+    max_size += ObSkipIndexBloomFilter::MAX_FILTER_SIZE;
+  }
+  if (skip_idx_attr.has_ngram_bloom_filter()) {
+    max_size += ObSkipIndexBloomFilter::MAX_FILTER_SIZE;
+  }
+  return max_size;
+}
+
+bool ObSkipIndexColMeta::is_column_type_supported(
+    const share::schema::ObSkipIndexColumnAttr &skip_idx_attr,
+    const ObObjMeta &obj_meta)
+{
+  bool is_supported = true;
+  const ObObjType obj_type = obj_meta.get_type();
+  if (is_lob_storage(obj_type) && !ob_is_large_text(obj_type)) {
+    is_supported = false;
+  } else if (skip_idx_attr.has_bloom_filter()
+      && (is_lob_storage(obj_type) || ob_is_decimal_int(obj_type))) {
+    // hash of decimal int depends on the precision of the value
+    is_supported = false;
+  } else if (skip_idx_attr.has_ngram_bloom_filter()
+      && ((ObVarcharType != obj_type && ObNVarchar2Type != obj_type)
+          || !ObSkipIndexBloomFilter::is_ngram_collation_supported(obj_meta.get_collation_type()))) {
+    is_supported = false;
+  }
+  return is_supported;
+}
+
 } // namespace blocksstable
 } // namespace oceanbase
\ No newline at end of file
@@ -14,6 +14,7 @@
 #define OCEANBASE_BLOCKSSTABLE_OB_INDEX_BLOCK_UTIL_
 
 #include "share/datum/ob_datum.h"
+#include "ob_skip_index_bloom_filter.h"
 
 namespace oceanbase
 {
@@ -27,7 +28,7 @@ struct ObSkipIndexColumnAttr;
 namespace blocksstable
 {
 
-// Only MIN_MAX skipping index is supported now.
+// BLOOM_FILTER is used by equal and in filters, NGRAM_BLOOM_FILTER is used by like filters.
 enum ObSkipIndexType : uint8_t
 {
   MIN_MAX,
@@ -43,6 +44,8 @@ enum ObSkipIndexColType : uint8_t
   SK_IDX_MAX,
   SK_IDX_NULL_COUNT,
   SK_IDX_SUM,
+  SK_IDX_BLOOM_FILTER,
+  SK_IDX_NGRAM_BLOOM_FILTER,
   SK_IDX_MAX_COL_TYPE
 };
 
@@ -51,7 +54,9 @@ struct ObSkipIndexColMeta
   // For data with length larger than 40 bytes(normally string), we will store the prefix as min/max
   static constexpr int64_t MAX_SKIP_INDEX_COL_LENGTH = 40;
   static constexpr int64_t SKIP_INDEX_ROW_SIZE_LIMIT = 1 << 10; // 1kb
-  static constexpr int64_t MAX_AGG_COLUMN_PER_ROW = 3; // min / max / null count
+  // bloom filters of a table are limited separately, agg row offsets are at most 2 bytes
+  static constexpr int64_t SKIP_INDEX_FILTER_SIZE_LIMIT = 16 << 10; // 16kb
+  static constexpr int64_t MAX_AGG_COLUMN_PER_ROW = 5; // min / max / null count / bloom filter / ngram bloom filter
   static constexpr ObObjDatumMapType NULL_CNT_COL_TYPE = OBJ_DATUM_8BYTE_DATA;
   static_assert(common::OBJ_DATUM_NUMBER_RES_SIZE == MAX_SKIP_INDEX_COL_LENGTH,
       "Buffer size of ObStorageDatum and maximum size of skip index data is equal to maximum size of ObNumber");
@@ -84,6 +89,21 @@ struct ObSkipIndexColMeta
       const ObObjType obj_type,
       const int16_t precision,
       int64_t &max_size);
+  // maximum size of the bloom filters of a column, not counted in calc_skip_index_maximum_size
+  static int64_t calc_skip_index_filter_maximum_size(
+      const share::schema::ObSkipIndexColumnAttr &skip_idx_attr);
+  static bool is_column_type_supported(
+      const share::schema::ObSkipIndexColumnAttr &skip_idx_attr,
+      const ObObjMeta &obj_meta);
+  // Maximum length of aggregated data, only bloom filters are not truncated to MAX_SKIP_INDEX_COL_LENGTH
+  static OB_INLINE int64_t get_agg_col_length_limit(const ObSkipIndexColType col_type)
+  {
+    int64_t limit = MAX_SKIP_INDEX_COL_LENGTH;
+    if (SK_IDX_BLOOM_FILTER == col_type || SK_IDX_NGRAM_BLOOM_FILTER == col_type) {
+      limit = ObSkipIndexBloomFilter::MAX_FILTER_SIZE;
+    }
+    return limit;
+  }
 
   TO_STRING_KV(K_(pack), K_(col_idx), K_(col_type));
 
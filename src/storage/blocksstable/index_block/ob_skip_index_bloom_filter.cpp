@@ -0,0 +1,180 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_skip_index_bloom_filter.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace blocksstable
+{
+
+void ObSkipIndexBloomFilter::add(const uint64_t hash, char *bits, const int64_t size)
+{
+  const uint64_t h = mix(hash);
+  const int64_t word_cnt = size / static_cast<int64_t>(sizeof(uint64_t));
+  char *word_ptr = bits + ((h >> 32) % word_cnt) * sizeof(uint64_t);
+  uint64_t word = 0;
+  // filter buffer in aggregate row may be unaligned
+  MEMCPY(&word, word_ptr, sizeof(uint64_t));
+  word |= get_word_mask(h);
+  MEMCPY(word_ptr, &word, sizeof(uint64_t));
+}
+
+bool ObSkipIndexBloomFilter::may_contain(const uint64_t hash, const char *bits, const int64_t size)
+{
+  const uint64_t h = mix(hash);
+  const int64_t word_cnt = size / static_cast<int64_t>(sizeof(uint64_t));
+  const uint64_t mask = get_word_mask(h);
+  uint64_t word = 0;
+  MEMCPY(&word, bits + ((h >> 32) % word_cnt) * sizeof(uint64_t), sizeof(uint64_t));
+  return mask == (word & mask);
+}
+
+void ObSkipIndexBloomFilter::merge(
+    const char *src,
+    const int64_t src_size,
+    char *dst,
+    const int64_t dst_size)
+{
+  // word i of %dst takes the values of word i % src_word_cnt of %src since sizes are power of 2
+  for (int64_t i = 0; i < dst_size; ++i) {
+    dst[i] |= src[i & (src_size - 1)];
+  }
+}
+
+int64_t ObSkipIndexBloomFilter::fold(char *bits, const int64_t size)
+{
+  int64_t folded_size = size;
+  bool need_fold = true;
+  while (need_fold && folded_size > MIN_FILTER_SIZE) {
+    const int64_t half_size = folded_size / 2;
+    int64_t set_bit_cnt = 0;
+    for (int64_t i = 0; i < half_size; ++i) {
+      set_bit_cnt += __builtin_popcount(static_cast<uint8_t>(bits[i] | bits[i + half_size]));
+    }
+    if (set_bit_cnt * FOLD_FILL_RATIO > half_size * 8) {
+      need_fold = false;
+    } else {
+      for (int64_t i = 0; i < half_size; ++i) {
+        bits[i] |= bits[i + half_size];
+      }
+      folded_size = half_size;
+    }
+  }
+  return folded_size;
+}
+
+bool ObSkipIndexBloomFilter::is_saturated(const char *bits, const int64_t size)
+{
+  int64_t set_bit_cnt = 0;
+  for (int64_t i = 0; i < size; ++i) {
+    set_bit_cnt += __builtin_popcount(static_cast<uint8_t>(bits[i]));
+  }
+  return set_bit_cnt * 2 > size * 8;
+}
+
+bool ObSkipIndexBloomFilter::is_ngram_collation_supported(const ObCollationType cs_type)
+{
+  // characters are compared one by one in these collations, no contraction or expansion
+  return CS_TYPE_UTF8MB4_BIN == cs_type
+      || CS_TYPE_UTF8MB4_GENERAL_CI == cs_type
+      || CS_TYPE_BINARY == cs_type;
+}
+
+void ObSkipIndexBloomFilter::add_ngrams(
+    const ObCollationType cs_type,
+    const ObString &str,
+    char *bits,
+    const int64_t size)
+{
+  // start offsets of the last NGRAM_LENGTH characters
+  int64_t char_starts[NGRAM_LENGTH] = {0};
+  int64_t char_cnt = 0;
+  int64_t pos = 0;
+  while (pos < str.length()) {
+    const int64_t char_len = get_char_length(cs_type, str.ptr() + pos, str.length() - pos);
+    char_starts[char_cnt % NGRAM_LENGTH] = pos;
+    ++char_cnt;
+    pos += char_len;
+    if (char_cnt >= NGRAM_LENGTH) {
+      const int64_t ngram_start = char_starts[char_cnt % NGRAM_LENGTH];
+      add(hash_ngram(cs_type, str.ptr() + ngram_start, pos - ngram_start), bits, size);
+    }
+  }
+}
+
+int ObSkipIndexBloomFilter::may_match_like_pattern(
+    const ObCollationType cs_type,
+    const ObString &pattern,
+    const ObString &escape,
+    const char *bits,
+    const int64_t size,
+    bool &may_match)
+{
+  int ret = OB_SUCCESS;
+  may_match = true;
+  if (OB_UNLIKELY(nullptr == bits || size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(bits), K(size));
+  } else if (!is_ngram_collation_supported(cs_type) || escape.length() > 1) {
+    // can not split the pattern into characters the same way as the values
+  } else {
+    const bool has_escape = 1 == escape.length();
+    const char escape_char = has_escape ? escape.ptr()[0] : '\0';
+    // the last NGRAM_LENGTH literal characters, escape characters are removed
+    char chars[NGRAM_LENGTH][MAX_NGRAM_CHAR_LENGTH];
+    int64_t char_lens[NGRAM_LENGTH] = {0};
+    char ngram[NGRAM_LENGTH * MAX_NGRAM_CHAR_LENGTH];
+    int64_t char_cnt = 0;
+    int64_t pos = 0;
+    while (may_match && pos < pattern.length()) {
+      const char *cur = pattern.ptr() + pos;
+      int64_t char_len = get_char_length(cs_type, cur, pattern.length() - pos);
+      bool is_literal = true;
+      if (1 == char_len && ('%' == *cur || '_' == *cur)) {
+        // wildcard breaks the literal run
+        is_literal = false;
+        char_cnt = 0;
+      } else if (has_escape && 1 == char_len && escape_char == *cur && pos + 1 < pattern.length()) {
+        pos += char_len;
+        cur = pattern.ptr() + pos;
+        char_len = get_char_length(cs_type, cur, pattern.length() - pos);
+      }
+      if (!is_literal) {
+      } else if (OB_UNLIKELY(char_len > MAX_NGRAM_CHAR_LENGTH)) {
+        break;
+      } else {
+        const int64_t slot = char_cnt % NGRAM_LENGTH;
+        MEMCPY(chars[slot], cur, char_len);
+        char_lens[slot] = char_len;
+        ++char_cnt;
+        if (char_cnt >= NGRAM_LENGTH) {
+          int64_t ngram_len = 0;
+          for (int64_t i = 0; i < NGRAM_LENGTH; ++i) {
+            const int64_t idx = (char_cnt + i) % NGRAM_LENGTH;
+            MEMCPY(ngram + ngram_len, chars[idx], char_lens[idx]);
+            ngram_len += char_lens[idx];
+          }
+          may_match = may_contain(hash_ngram(cs_type, ngram, ngram_len), bits, size);
+        }
+      }
+      pos += char_len;
+    }
+  }
+  return ret;
+}
+
+} // namespace blocksstable
+} // namespace oceanbase
@@ -0,0 +1,113 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_BLOCKSSTABLE_OB_SKIP_INDEX_BLOOM_FILTER_H_
+#define OCEANBASE_BLOCKSSTABLE_OB_SKIP_INDEX_BLOOM_FILTER_H_
+
+#include "lib/charset/ob_charset.h"
+#include "lib/string/ob_string.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// Bloom filters stored as skip index aggregate columns.
+//
+// The filter is a blocked bloom filter on 64-bit words: one word is selected by the hash modulo
+// the word count and HASH_BIT_COUNT bits are set in it. The size is a power of 2 between
+// MIN_FILTER_SIZE and MAX_FILTER_SIZE. A filter is built in MAX_FILTER_SIZE and folded in half
+// while at most 1/FOLD_FILL_RATIO of the bits are set, so its size follows the distinct value
+// count of the block. A smaller filter is merged into a larger one by repeating it, so the filter
+// of an index row is the union of the filters of the rows below it. A filter with more than half
+// of the bits set prunes nearly nothing, it is not stored by the aggregator.
+//
+// The ngram filter contains the hashes of every NGRAM_LENGTH characters in the string values,
+// a LIKE pattern can not match any value of the block if one ngram of its literal parts is
+// not in the filter.
+class ObSkipIndexBloomFilter
+{
+public:
+  static constexpr int64_t MIN_FILTER_SIZE = 64; // 512 bits
+  static constexpr int64_t MAX_FILTER_SIZE = 4L << 10; // 32768 bits, about 5K distinct values
+  static constexpr int64_t FOLD_FILL_RATIO = 3;
+  static constexpr int64_t HASH_BIT_COUNT = 4;
+  static constexpr uint64_t HASH_SEED = 0x5BD1E995;
+  static constexpr int64_t NGRAM_LENGTH = 3;
+  // maximum bytes of one character of the collations supported by ngram filter
+  static constexpr int64_t MAX_NGRAM_CHAR_LENGTH = 4;
+  static_assert(0 == (MIN_FILTER_SIZE & (MIN_FILTER_SIZE - 1)) && 0 == (MAX_FILTER_SIZE & (MAX_FILTER_SIZE - 1))
+      && MIN_FILTER_SIZE >= static_cast<int64_t>(sizeof(uint64_t)) && MIN_FILTER_SIZE <= MAX_FILTER_SIZE,
+      "bloom filter sizes should be power of 2 words");
+public:
+  static OB_INLINE bool is_valid_size(const int64_t size)
+  {
+    return size >= MIN_FILTER_SIZE && size <= MAX_FILTER_SIZE && 0 == (size & (size - 1));
+  }
+  static void add(const uint64_t hash, char *bits, const int64_t size);
+  static bool may_contain(const uint64_t hash, const char *bits, const int64_t size);
+  // or %src into %dst, %src_size should not be larger than %dst_size
+  static void merge(const char *src, const int64_t src_size, char *dst, const int64_t dst_size);
+  // fold %bits in place to the smallest size keeping the fill ratio, return the folded size
+  static int64_t fold(char *bits, const int64_t size);
+  static bool is_saturated(const char *bits, const int64_t size);
+
+  static bool is_ngram_collation_supported(const common::ObCollationType cs_type);
+  static void add_ngrams(
+      const common::ObCollationType cs_type,
+      const common::ObString &str,
+      char *bits,
+      const int64_t size);
+  // %may_match is false only if no string with all the ngrams in %bits matches %pattern.
+  static int may_match_like_pattern(
+      const common::ObCollationType cs_type,
+      const common::ObString &pattern,
+      const common::ObString &escape,
+      const char *bits,
+      const int64_t size,
+      bool &may_match);
+private:
+  static OB_INLINE uint64_t mix(uint64_t hash)
+  {
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+  static OB_INLINE uint64_t get_word_mask(const uint64_t hash)
+  {
+    uint64_t mask = 0;
+    for (int64_t i = 0; i < HASH_BIT_COUNT; ++i) {
+      mask |= 1ULL << ((hash >> (i * 6)) & 63);
+    }
+    return mask;
+  }
+  static OB_INLINE int64_t get_char_length(
+      const common::ObCollationType cs_type, const char *str, const int64_t len)
+  {
+    // malformed bytes are taken as one character on both build and probe side
+    const int64_t char_len = static_cast<int64_t>(common::ObCharset::charpos(cs_type, str, len, 1));
+    return char_len <= 0 ? 1 : MIN(char_len, len);
+  }
+  static OB_INLINE uint64_t hash_ngram(
+      const common::ObCollationType cs_type, const char *str, const int64_t len)
+  {
+    return common::ObCharset::hash(cs_type, str, len, HASH_SEED, true, NULL);
+  }
+};
+
+} // namespace blocksstable
+} // namespace oceanbase
+
+#endif // OCEANBASE_BLOCKSSTABLE_OB_SKIP_INDEX_BLOOM_FILTER_H_
@@ -10,6 +10,7 @@
 
 #define USING_LOG_PREFIX STORAGE
 #include "storage/blocksstable/index_block/ob_skip_index_filter_executor.h"
+#include "share/datum/ob_datum_funcs.h"
 namespace oceanbase
 {
 namespace blocksstable
@@ -49,7 +50,7 @@ int ObSkipIndexFilterExecutor::falsifiable_pushdown_filter(
     const uint32_t col_idx,
     const ObSkipIndexType index_type,
     const ObMicroIndexInfo &index_info,
-    sql::ObWhiteFilterExecutor &filter,
+    sql::ObPhysicalFilterExecutor &filter,
     common::ObIAllocator &allocator)
 {
   int ret = OB_SUCCESS;
@@ -62,11 +63,33 @@ int ObSkipIndexFilterExecutor::falsifiable_pushdown_filter(
   } else {
     switch (index_type) {
       case ObSkipIndexType::MIN_MAX: {
-        if (OB_FAIL(filter_on_min_max(col_idx, index_info.get_row_count(), filter, allocator))) {
+        if (OB_UNLIKELY(!filter.is_filter_white_node())) {
+          ret = OB_INVALID_ARGUMENT;
+          LOG_WARN("Unexpected filter for min_max", K(ret), K(filter));
+        } else if (OB_FAIL(filter_on_min_max(col_idx, index_info.get_row_count(),
+            static_cast<sql::ObWhiteFilterExecutor &>(filter), allocator))) {
           LOG_WARN("Fail to filter on min_max", K(ret), K(col_idx));
         }
         break;
       }
+      case ObSkipIndexType::BLOOM_FILTER: {
+        if (OB_UNLIKELY(!filter.is_filter_white_node())) {
+          ret = OB_INVALID_ARGUMENT;
+          LOG_WARN("Unexpected filter for bloom filter", K(ret), K(filter));
+        } else if (OB_FAIL(filter_on_bloom_filter(col_idx, static_cast<sql::ObWhiteFilterExecutor &>(filter)))) {
+          LOG_WARN("Fail to filter on bloom filter", K(ret), K(col_idx));
+        }
+        break;
+      }
+      case ObSkipIndexType::NGRAM_BLOOM_FILTER: {
+        if (OB_UNLIKELY(!filter.is_filter_black_node())) {
+          ret = OB_INVALID_ARGUMENT;
+          LOG_WARN("Unexpected filter for ngram bloom filter", K(ret), K(filter));
+        } else if (OB_FAIL(filter_on_ngram_bloom_filter(col_idx, static_cast<sql::ObBlackFilterExecutor &>(filter)))) {
+          LOG_WARN("Fail to filter on ngram bloom filter", K(ret), K(col_idx));
+        }
+        break;
+      }
       default :
         ret = OB_NOT_SUPPORTED;
         LOG_WARN("unsupported skip index type", K(ret), K(index_type));
@@ -224,6 +247,160 @@ int ObSkipIndexFilterExecutor::filter_on_min_max(
   return ret;
 }
 
+bool ObSkipIndexFilterExecutor::is_bloom_filter_hash_compatible(
+    const ObObjMeta &col_meta,
+    const ObObjMeta &param_meta)
+{
+  bool is_compatible = false;
+  if (col_meta.get_type() == param_meta.get_type()) {
+    is_compatible = !col_meta.is_string_type()
+        || col_meta.get_collation_type() == param_meta.get_collation_type();
+  } else {
+    // all integer types are hashed as 64-bit value
+    is_compatible = col_meta.get_type_class() == param_meta.get_type_class()
+        && (ObIntTC == col_meta.get_type_class() || ObUIntTC == col_meta.get_type_class());
+  }
+  return is_compatible;
+}
+
+int ObSkipIndexFilterExecutor::filter_on_bloom_filter(
+    const uint32_t col_idx,
+    sql::ObWhiteFilterExecutor &filter)
+{
+  int ret = OB_SUCCESS;
+  sql::ObBoolMask &fal_desc = filter.get_filter_bool_mask();
+  const sql::ObExpr *filter_expr = filter.get_filter_node().expr_;
+  const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
+  ObStorageDatum bloom_datum;
+  fal_desc.set_uncertain();
+  if (sql::WHITE_OP_EQ != op_type && sql::WHITE_OP_IN != op_type) {
+    // only equal and in filters can be falsified by bloom filter
+  } else if (filter.is_cmp_op_with_null_ref_value()) {
+    fal_desc.set_always_false();
+  } else if (OB_ISNULL(filter_expr) || OB_UNLIKELY(filter_expr->arg_cnt_ < 2)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected filter expr", K(ret), KP(filter_expr));
+  } else if (FALSE_IT(meta_.col_idx_ = col_idx)) {
+  } else if (FALSE_IT(meta_.col_type_ = SK_IDX_BLOOM_FILTER)) {
+  } else if (OB_FAIL(agg_row_reader_.read(meta_, bloom_datum))) {
+    LOG_WARN("Failed read agg bloom filter", K(ret), K(meta_));
+  } else if (bloom_datum.is_null() || !ObSkipIndexBloomFilter::is_valid_size(bloom_datum.len_)) {
+    // bloom filter not stored, e.g. saturated or progressive merge
+  } else {
+    const ObObjMeta &col_meta = filter_expr->args_[0]->obj_meta_;
+    const sql::ObExprHashFuncType hash_func = ObDatumFuncs::get_basic_func(
+        col_meta.get_type(), col_meta.get_collation_type())->murmur_hash_;
+    const common::ObIArray<common::ObDatum> &datums = filter.get_datums();
+    bool may_contain = false;
+    // datum params are evaluated from the args except the column reference in order
+    int64_t datum_idx = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && !may_contain && i < filter_expr->arg_cnt_; ++i) {
+      const sql::ObExpr *arg = filter_expr->args_[i];
+      uint64_t hash = 0;
+      if (T_REF_COLUMN == arg->type_) {
+        continue;
+      } else if (OB_UNLIKELY(datum_idx >= datums.count())) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("Unexpected datum count", K(ret), K(datum_idx), K(datums.count()));
+      } else if (datums.at(datum_idx).is_null()) {
+        // null never equals to any value
+      } else if (!is_bloom_filter_hash_compatible(col_meta, arg->obj_meta_)) {
+        may_contain = true;
+      } else if (OB_FAIL(hash_func(datums.at(datum_idx), ObSkipIndexBloomFilter::HASH_SEED, hash))) {
+        LOG_WARN("Fail to calc hash of filter datum", K(ret), K(datums.at(datum_idx)));
+      } else {
+        may_contain = ObSkipIndexBloomFilter::may_contain(
+            hash, bloom_datum.ptr_, bloom_datum.len_);
+      }
+      ++datum_idx;
+    }
+    if (OB_SUCC(ret) && !may_contain) {
+      fal_desc.set_always_false();
+    }
+  }
+  LOG_DEBUG("[SKIP INDEX] filter on bloom filter", K(ret), K(col_idx), K(op_type), K(fal_desc.bmt_));
+  return ret;
+}
+
+int ObSkipIndexFilterExecutor::filter_on_ngram_bloom_filter(
+    const uint32_t col_idx,
+    sql::ObBlackFilterExecutor &filter)
+{
+  int ret = OB_SUCCESS;
+  sql::ObBoolMask &fal_desc = filter.get_filter_bool_mask();
+  sql::ObPushdownBlackFilterNode &filter_node = filter.get_filter_node();
+  ObStorageDatum ngram_datum;
+  fal_desc.set_uncertain();
+  meta_.col_idx_ = col_idx;
+  meta_.col_type_ = SK_IDX_NGRAM_BLOOM_FILTER;
+  if (OB_FAIL(agg_row_reader_.read(meta_, ngram_datum))) {
+    LOG_WARN("Failed read agg ngram bloom filter", K(ret), K(meta_));
+  } else if (ngram_datum.is_null() || !ObSkipIndexBloomFilter::is_valid_size(ngram_datum.len_)) {
+    // ngram bloom filter not stored
+  } else {
+    // filter exprs of black filter are and-ed, one like expr can not match means the filter is false
+    bool may_match = true;
+    for (int64_t i = 0; OB_SUCC(ret) && may_match && i < filter_node.filter_exprs_.count(); ++i) {
+      const sql::ObExpr *expr = filter_node.filter_exprs_.at(i);
+      if (OB_ISNULL(expr)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("Unexpected null filter expr", K(ret), K(i));
+      } else if (OB_FAIL(check_like_expr_on_ngram(*expr, filter.get_op().get_eval_ctx(), ngram_datum, may_match))) {
+        LOG_WARN("Fail to check like expr on ngram bloom filter", K(ret), KPC(expr));
+      }
+    }
+    if (OB_SUCC(ret) && !may_match) {
+      fal_desc.set_always_false();
+    }
+  }
+  LOG_DEBUG("[SKIP INDEX] filter on ngram bloom filter", K(ret), K(col_idx), K(fal_desc.bmt_));
+  return ret;
+}
+
+int ObSkipIndexFilterExecutor::check_like_expr_on_ngram(
+    const sql::ObExpr &like_expr,
+    sql::ObEvalCtx &eval_ctx,
+    const common::ObDatum &filter_datum,
+    bool &may_match)
+{
+  int ret = OB_SUCCESS;
+  may_match = true;
+  if (T_OP_LIKE != like_expr.type_ || 3 != like_expr.arg_cnt_) {
+    // other black filter exprs can not be falsified by ngram
+  } else {
+    const sql::ObExpr *text = like_expr.args_[0];
+    const sql::ObExpr *pattern = like_expr.args_[1];
+    const sql::ObExpr *escape = like_expr.args_[2];
+    ObDatum *pattern_datum = nullptr;
+    ObDatum *escape_datum = nullptr;
+    if (OB_ISNULL(text) || OB_ISNULL(pattern) || OB_ISNULL(escape)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("Unexpected null like args", K(ret), KP(text), KP(pattern), KP(escape));
+    } else if (T_REF_COLUMN != text->type_
+        || !pattern->is_static_const_
+        || !escape->is_static_const_
+        || !pattern->obj_meta_.is_string_type()
+        || text->obj_meta_.get_collation_type() != pattern->obj_meta_.get_collation_type()) {
+      // pattern and escape should be constant in the whole execution, and compared with the
+      // collation of column
+    } else if (OB_FAIL(pattern->eval(eval_ctx, pattern_datum))) {
+      LOG_WARN("Fail to eval like pattern", K(ret));
+    } else if (OB_FAIL(escape->eval(eval_ctx, escape_datum))) {
+      LOG_WARN("Fail to eval like escape", K(ret));
+    } else if (pattern_datum->is_null() || escape_datum->is_null()) {
+    } else if (OB_FAIL(ObSkipIndexBloomFilter::may_match_like_pattern(
+        text->obj_meta_.get_collation_type(),
+        pattern_datum->get_string(),
+        escape_datum->get_string(),
+        filter_datum.ptr_,
+        filter_datum.len_,
+        may_match))) {
+      LOG_WARN("Fail to check like pattern on ngram bloom filter", K(ret));
+    }
+  }
+  return ret;
+}
+
 inline int ObSkipIndexFilterExecutor::pad_column(const ObObjMeta &obj_meta,
                                           const share::schema::ObColumnParam *col_param,
                                           common::ObIAllocator &padding_alloc,
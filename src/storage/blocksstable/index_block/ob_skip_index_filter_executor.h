@@ -37,10 +37,22 @@ public:
   int falsifiable_pushdown_filter(const uint32_t col_idx,
                                   const ObSkipIndexType index_type,
                                   const ObMicroIndexInfo &index_info,
-                                  sql::ObWhiteFilterExecutor &filter,
+                                  sql::ObPhysicalFilterExecutor &filter,
                                   common::ObIAllocator &allocator);
 
 private:
+  // equal and in filters
+  int filter_on_bloom_filter(const uint32_t col_idx,
+                             sql::ObWhiteFilterExecutor &filter);
+  // like filters in black filter
+  int filter_on_ngram_bloom_filter(const uint32_t col_idx,
+                                   sql::ObBlackFilterExecutor &filter);
+  int check_like_expr_on_ngram(const sql::ObExpr &like_expr,
+                               sql::ObEvalCtx &eval_ctx,
+                               const common::ObDatum &filter_datum,
+                               bool &may_match);
+  static bool is_bloom_filter_hash_compatible(const common::ObObjMeta &col_meta,
+                                              const common::ObObjMeta &param_meta);
   int filter_on_min_max(const uint32_t col_idx,
                         const uint64_t row_count,
                         sql::ObWhiteFilterExecutor &filter,
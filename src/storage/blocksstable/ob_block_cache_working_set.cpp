@@ -174,6 +174,20 @@ int ObBlockCacheWorkingSet::erase(const Key &key)
   return ret;
 }
 
+bool ObBlockCacheWorkingSet::admit(const Key &key)
+{
+  int ret = OB_SUCCESS;
+  bool admitted = true;
+  BaseBlockCache *cache = NULL;
+  if (!inited_) {
+  } else if (OB_FAIL(get_cache(cache))) {
+    LOG_WARN("get_cache failed", K(ret));
+  } else {
+    admitted = cache->admit(key);
+  }
+  return admitted;
+}
+
 int ObBlockCacheWorkingSet::create_working_set_if_need()
 {
   int ret = OB_SUCCESS;
@@ -43,6 +43,7 @@ public:
       common::ObKVCacheHandle &handle, bool overwrite = true);
   virtual int get(const Key &key, const Value *&pvalue, common::ObKVCacheHandle &handle);
   virtual int erase(const Key &key);
+  virtual bool admit(const Key &key);
   virtual int alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
       ObKVCachePair *&kvpair, ObKVCacheHandle &handle, ObKVCacheInstHandle &inst_handle) override;
 private:
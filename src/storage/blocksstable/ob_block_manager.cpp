@@ -25,6 +25,7 @@
 #include "share/rc/ob_tenant_base.h"
 #include "storage/blocksstable/ob_block_manager.h"
 #include "storage/blocksstable/ob_macro_block_struct.h"
+#include "storage/blocksstable/ob_micro_block_disk_cache.h"
 #include "storage/blocksstable/ob_sstable_meta.h"
 #include "storage/blocksstable/ob_tmp_file_store.h"
 #include "storage/slog_ckpt/ob_server_checkpoint_slog_handler.h"
@@ -462,6 +463,7 @@ int ObBlockManager::first_mark_device()
     LOG_WARN("fail to first mark blocks before running", K(ret));
   } else {
     blk_seq_generator_.update_sequence(iter.get_max_write_sequence());
+    ObMicroBlockDiskCache::get_instance().set_restart_write_seq(iter.get_max_write_sequence());
     enable_mark_sweep();
   }
   return ret;
@@ -854,25 +854,33 @@ void ObMacroBloomFilterCacheWriter::set_not_need_build()
 }
 
 int ObMacroBloomFilterCacheWriter::append(const common::ObArray<uint32_t> &hashs)
+{
+  return hashs.empty() ? OB_SUCCESS : append(&hashs.at(0), hashs.count());
+}
+
+int ObMacroBloomFilterCacheWriter::append(const uint32_t *hashs, const int64_t count)
 {
   int ret = OB_SUCCESS;
   if (IS_NOT_INIT) {
     ret = OB_NOT_INIT;
     STORAGE_LOG(WARN, "ObMacroBloomFilterCacheWriter not init", K(ret));
+  } else if (OB_UNLIKELY(count < 0 || (count > 0 && OB_ISNULL(hashs)))) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "Invalid argument", K(ret), KP(hashs), K(count));
   } else if (!need_build_) {
     ret = OB_NOT_SUPPORTED;
     STORAGE_LOG(WARN, "Not need build bloomfilter, ", K_(need_build), K(ret));
-  } else if (get_row_count() + hashs.count() > max_row_count_) {
+  } else if (get_row_count() + count > max_row_count_) {
     ret = OB_NOT_SUPPORTED;
-    STORAGE_LOG(INFO, "Bloomfilter is full, ", K_(max_row_count), K(get_row_count()), K(hashs.count()));
+    STORAGE_LOG(INFO, "Bloomfilter is full, ", K_(max_row_count), K(get_row_count()), K(count));
     bf_cache_value_.reuse();
     need_build_ = false;
   } else {
-    for (int i = 0; OB_SUCC(ret) && i < hashs.count(); ++i) {
-      if (OB_FAIL(bf_cache_value_.insert(hashs.at(i)))) {
+    for (int64_t i = 0; OB_SUCC(ret) && i < count; ++i) {
+      if (OB_FAIL(bf_cache_value_.insert(hashs[i]))) {
         bf_cache_value_.reuse();
         need_build_ = false;
-        STORAGE_LOG(WARN, "bloomfilter insert hash value failed, ", K(i), K(hashs.at(i)), K(ret));
+        STORAGE_LOG(WARN, "bloomfilter insert hash value failed, ", K(i), K(hashs[i]), K(ret));
       }
     }
   }
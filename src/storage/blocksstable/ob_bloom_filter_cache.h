@@ -244,6 +244,7 @@ public:
   void reuse();
   void set_not_need_build();
   int append(const common::ObArray<uint32_t> &hashs);
+  int append(const uint32_t *hashs, const int64_t count);
   bool can_merge(const ObMacroBloomFilterCacheWriter &other);
   int merge(const ObMacroBloomFilterCacheWriter &other);
   int flush_to_cache(const uint64_t tenant_id, const MacroBlockId& macro_id);
@@ -138,6 +138,8 @@ public:
   bool is_valid() const { return nullptr != rowkey_ && nullptr != datum_utils_; }
   const ObDatumRowkey *get_rowkey() const { return rowkey_; }
   int compare(const ObDatumRowkeyWrapper &other, int &cmp) const { return rowkey_->compare(*(other.get_rowkey()), *datum_utils_, cmp); }
+  // no inline prefix in btree nodes, always compare the full rowkey
+  void get_prefix(uint64_t &prefix, uint8_t &domain) const { prefix = 0; domain = 0; }
   const ObStorageDatum *get_ptr() const { return rowkey_->get_datum_ptr(); }
   const char *repr() const { return to_cstring(rowkey_); }
   TO_STRING_KV(KPC_(rowkey), KPC_(datum_utils));
@@ -24,12 +24,15 @@
 #include "storage/blocksstable/index_block/ob_index_block_macro_iterator.h"
 #include "storage/blocksstable/index_block/ob_index_block_row_struct.h"
 #include "storage/blocksstable/ob_macro_block_writer.h"
+#include "storage/blocksstable/ob_micro_block_encode_pool.h"
 #include "storage/blocksstable/cs_encoding/ob_micro_block_cs_encoder.h"
 #include "storage/ddl/ob_ddl_redo_log_writer.h"
 #include "storage/ob_i_store.h"
 #include "storage/ob_sstable_struct.h"
+#include "storage/compaction/ob_compaction_util.h"
 #include "storage/blocksstable/ob_logic_macro_id.h"
 #include "storage/blocksstable/cs_encoding/ob_cs_encoding_util.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase
 {
@@ -390,6 +393,337 @@ void ObMicroBlockAdaptiveSplitter::ObMicroCompressionInfo::update(const int64_t
     }
 }
 
+/**
+ * ---------------------------------------------------------ObMicroBlockEncodeTask--------------------------------------------------------------
+ */
+ObMicroBlockEncodeTask::ObMicroBlockEncodeTask()
+  : pipeline_(nullptr),
+    micro_writer_(nullptr),
+    micro_helper_(),
+    micro_block_desc_(),
+    raw_micro_block_desc_(),
+    last_key_(),
+    aggregated_row_(),
+    has_aggregated_row_(false),
+    block_size_(0),
+    ret_(OB_SUCCESS),
+    state_(FILLING),
+    allocator_("MicroEncTask"),
+    block_allocator_("MicroEncTask")
+{
+}
+
+ObMicroBlockEncodeTask::~ObMicroBlockEncodeTask()
+{
+  reset();
+}
+
+int ObMicroBlockEncodeTask::init(const ObDataStoreDesc &data_store_desc, const int64_t verify_level)
+{
+  int ret = OB_SUCCESS;
+  reset();
+  if (OB_FAIL(ObMacroBlockWriter::build_micro_writer(&data_store_desc,
+                                                     allocator_,
+                                                     micro_writer_,
+                                                     verify_level))) {
+    STORAGE_LOG(WARN, "fail to build micro writer", K(ret));
+  } else if (OB_FAIL(micro_helper_.open(data_store_desc, allocator_))) {
+    STORAGE_LOG(WARN, "Failed to open micro helper", K(ret), K(data_store_desc));
+  }
+  return ret;
+}
+
+void ObMicroBlockEncodeTask::reset()
+{
+  if (OB_NOT_NULL(micro_writer_)) {
+    micro_writer_->~ObIMicroBlockWriter();
+    allocator_.free(micro_writer_);
+    micro_writer_ = nullptr;
+  }
+  micro_helper_.reset();
+  micro_block_desc_.reset();
+  raw_micro_block_desc_.reset();
+  last_key_.reset();
+  aggregated_row_.reset();
+  has_aggregated_row_ = false;
+  block_size_ = 0;
+  ret_ = OB_SUCCESS;
+  state_ = FILLING;
+  block_allocator_.reset();
+  allocator_.reset();
+}
+
+void ObMicroBlockEncodeTask::reuse()
+{
+  if (OB_NOT_NULL(micro_writer_)) {
+    micro_writer_->reuse();
+  }
+  micro_block_desc_.reset();
+  raw_micro_block_desc_.reset();
+  last_key_.reset();
+  has_aggregated_row_ = false;
+  block_size_ = 0;
+  ret_ = OB_SUCCESS;
+  state_ = FILLING;
+  block_allocator_.reuse();
+}
+
+int ObMicroBlockEncodeTask::save_block_info(const ObDatumRowkey &last_key, const ObDatumRow *aggregated_row)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(last_key.deep_copy(last_key_, block_allocator_))) {
+    STORAGE_LOG(WARN, "Fail to deep copy last key", K(ret), K(last_key));
+  } else if (nullptr == aggregated_row) {
+    has_aggregated_row_ = false;
+  } else if (!aggregated_row_.is_valid()
+      && OB_FAIL(aggregated_row_.init(allocator_, aggregated_row->get_capacity()))) {
+    STORAGE_LOG(WARN, "Fail to init aggregated row", K(ret), KPC(aggregated_row));
+  } else if (OB_FAIL(aggregated_row_.deep_copy(*aggregated_row, block_allocator_))) {
+    STORAGE_LOG(WARN, "Fail to deep copy aggregated row", K(ret), KPC(aggregated_row));
+  } else {
+    has_aggregated_row_ = true;
+  }
+  return ret;
+}
+
+void ObMicroBlockEncodeTask::encode(const bool need_pre_warm)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(micro_writer_->build_micro_block_desc(micro_block_desc_))) {
+    STORAGE_LOG(WARN, "failed to build micro block desc", K(ret));
+  } else {
+    micro_block_desc_.last_rowkey_ = last_key_;
+    block_size_ = micro_block_desc_.buf_size_;
+    if (need_pre_warm && OB_FAIL(save_raw_micro_block_desc())) {
+      STORAGE_LOG(WARN, "failed to save raw micro block desc", K(ret), K_(micro_block_desc));
+    // encrypted micro blocks are never encoded in the pipeline, the iv args are unused
+    } else if (OB_FAIL(micro_helper_.compress_encrypt_micro_block(micro_block_desc_, 0, 0))) {
+      micro_writer_->dump_diagnose_info(); // ignore dump error
+      STORAGE_LOG(WARN, "failed to compress and encrypt micro block", K(ret), K_(micro_block_desc));
+    }
+  }
+  ret_ = ret;
+}
+
+int ObMicroBlockEncodeTask::save_raw_micro_block_desc()
+{
+  int ret = OB_SUCCESS;
+  // the header is filled in place by compression, keep the uncompressed one for the pre warmer
+  const int64_t header_size = micro_block_desc_.header_->header_size_;
+  char *buf = nullptr;
+  if (OB_ISNULL(buf = static_cast<char *>(block_allocator_.alloc(header_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to alloc micro block header", K(ret), K(header_size));
+  } else {
+    MEMCPY(buf, micro_block_desc_.header_, header_size);
+    raw_micro_block_desc_ = micro_block_desc_;
+    raw_micro_block_desc_.header_ = reinterpret_cast<const ObMicroBlockHeader *>(buf);
+  }
+  return ret;
+}
+
+/**
+ * ---------------------------------------------------------ObMicroBlockEncodePipeline--------------------------------------------------------------
+ */
+ObMicroBlockEncodePipeline::ObMicroBlockEncodePipeline(common::ObIAllocator &allocator)
+  : allocator_(allocator),
+    cond_(),
+    encode_pool_(nullptr),
+    tasks_(nullptr),
+    task_cnt_(0),
+    submit_idx_(0),
+    write_idx_(0),
+    queued_cnt_(0),
+    need_pre_warm_(false),
+    is_inited_(false)
+{
+}
+
+ObMicroBlockEncodePipeline::~ObMicroBlockEncodePipeline()
+{
+  destroy();
+}
+
+int ObMicroBlockEncodePipeline::init(
+    const ObDataStoreDesc &data_store_desc,
+    ObTenantMicroBlockEncodePool &encode_pool,
+    const int64_t task_cnt)
+{
+  int ret = OB_SUCCESS;
+  void *buf = nullptr;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    STORAGE_LOG(WARN, "init twice", K(ret));
+  } else if (OB_UNLIKELY(!data_store_desc.is_valid() || task_cnt <= 1)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(data_store_desc), K(task_cnt));
+  } else if (OB_FAIL(cond_.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    STORAGE_LOG(WARN, "fail to init thread cond", K(ret));
+  } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObMicroBlockEncodeTask) * task_cnt))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to alloc encode tasks", K(ret), K(task_cnt));
+  } else {
+    tasks_ = static_cast<ObMicroBlockEncodeTask *>(buf);
+    for (int64_t i = 0; i < task_cnt; ++i) {
+      new (tasks_ + i) ObMicroBlockEncodeTask();
+    }
+    task_cnt_ = task_cnt;
+    for (int64_t i = 0; OB_SUCC(ret) && i < task_cnt_; ++i) {
+      if (OB_FAIL(tasks_[i].init(data_store_desc, GCONF.micro_block_merge_verify_level))) {
+        STORAGE_LOG(WARN, "fail to init encode task", K(ret), K(i));
+      } else {
+        tasks_[i].pipeline_ = this;
+      }
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    encode_pool_ = &encode_pool;
+    need_pre_warm_ = data_store_desc.need_pre_warm();
+    is_inited_ = true;
+  } else {
+    destroy();
+  }
+  return ret;
+}
+
+void ObMicroBlockEncodePipeline::destroy()
+{
+  if (cond_.is_inited()) {
+    ObThreadCondGuard guard(cond_);
+    // the tasks still in queue of the encode pool are skipped by the threads
+    for (int64_t i = 0; OB_NOT_NULL(tasks_) && i < task_cnt_; ++i) {
+      if (ObMicroBlockEncodeTask::SUBMITTED == tasks_[i].state_) {
+        tasks_[i].state_ = ObMicroBlockEncodeTask::FILLING;
+      }
+    }
+    while (queued_cnt_ > 0 && nullptr != encode_pool_ && !encode_pool_->is_stopped()) {
+      cond_.wait(WAIT_INTERVAL_MS);
+    }
+  }
+  if (OB_NOT_NULL(tasks_)) {
+    for (int64_t i = 0; i < task_cnt_; ++i) {
+      tasks_[i].~ObMicroBlockEncodeTask();
+    }
+    allocator_.free(tasks_);
+    tasks_ = nullptr;
+  }
+  cond_.destroy();
+  encode_pool_ = nullptr;
+  task_cnt_ = 0;
+  submit_idx_ = 0;
+  write_idx_ = 0;
+  queued_cnt_ = 0;
+  need_pre_warm_ = false;
+  is_inited_ = false;
+}
+
+int ObMicroBlockEncodePipeline::submit_filling_task()
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "not init", K(ret));
+  } else if (OB_UNLIKELY(is_full())) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "no free task to submit", K(ret), KPC(this));
+  } else {
+    ObMicroBlockEncodeTask &task = get_filling_task();
+    {
+      ObThreadCondGuard guard(cond_);
+      task.state_ = ObMicroBlockEncodeTask::SUBMITTED;
+      ++submit_idx_;
+      ++queued_cnt_;
+    }
+    if (OB_TMP_FAIL(encode_pool_->push_task(task))) {
+      // the queue is full or the pool is stopped, the task is encoded by the merge thread
+      ObThreadCondGuard guard(cond_);
+      --queued_cnt_;
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockEncodePipeline::handle_queued_task(ObMicroBlockEncodeTask &task)
+{
+  bool need_encode = false;
+  {
+    ObThreadCondGuard guard(cond_);
+    // the task may be encoded by the merge thread already, or the slot is filled by the next block
+    if (ObMicroBlockEncodeTask::SUBMITTED == task.state_) {
+      task.state_ = ObMicroBlockEncodeTask::ENCODING;
+      need_encode = true;
+    }
+  }
+  if (need_encode) {
+    task.encode(need_pre_warm_);
+  }
+  ObThreadCondGuard guard(cond_);
+  if (need_encode) {
+    task.state_ = ObMicroBlockEncodeTask::ENCODED;
+  }
+  --queued_cnt_;
+  cond_.broadcast();
+}
+
+int ObMicroBlockEncodePipeline::get_encoded_task(const bool need_wait, ObMicroBlockEncodeTask *&task)
+{
+  int ret = OB_SUCCESS;
+  task = nullptr;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "not init", K(ret));
+  } else if (OB_UNLIKELY(!has_pending_task())) {
+    ret = OB_ITER_END;
+  } else {
+    ObMicroBlockEncodeTask &oldest_task = tasks_[write_idx_ % task_cnt_];
+    bool need_encode = false;
+    {
+      ObThreadCondGuard guard(cond_);
+      if (!need_wait) {
+      } else if (ObMicroBlockEncodeTask::SUBMITTED == oldest_task.state_) {
+        oldest_task.state_ = ObMicroBlockEncodeTask::ENCODING;
+        need_encode = true;
+      } else {
+        // only wait for the task being encoded by a thread of the encode pool
+        while (ObMicroBlockEncodeTask::ENCODING == oldest_task.state_) {
+          cond_.wait(WAIT_INTERVAL_MS);
+        }
+      }
+    }
+    if (need_encode) {
+      oldest_task.encode(need_pre_warm_);
+    }
+    ObThreadCondGuard guard(cond_);
+    if (need_encode) {
+      oldest_task.state_ = ObMicroBlockEncodeTask::ENCODED;
+    }
+    if (ObMicroBlockEncodeTask::ENCODED == oldest_task.state_) {
+      task = &oldest_task;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockEncodePipeline::release_encoded_task()
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "not init", K(ret));
+  } else if (OB_UNLIKELY(!has_pending_task()
+      || ObMicroBlockEncodeTask::ENCODED != tasks_[write_idx_ % task_cnt_].state_)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "no encoded task to release", K(ret), KPC(this));
+  } else {
+    ObThreadCondGuard guard(cond_);
+    tasks_[write_idx_ % task_cnt_].reuse();
+    ++write_idx_;
+  }
+  return ret;
+}
+
 /**
  * ---------------------------------------------------------ObMacroBlockWriter--------------------------------------------------------------
  */
@@ -400,6 +734,7 @@ ObMacroBlockWriter::ObMacroBlockWriter(const bool is_need_macro_buffer)
     reader_helper_(),
     hash_index_builder_(),
     micro_helper_(),
+    reused_row_cnts_(),
     current_index_(0),
     current_macro_seq_(0),
     last_micro_size_(INT64_MAX),
@@ -415,6 +750,7 @@ ObMacroBlockWriter::ObMacroBlockWriter(const bool is_need_macro_buffer)
     rowkey_allocator_("MaBlkWriter"),
     macro_reader_(),
     micro_rowkey_hashs_(),
+    need_bf_cache_writer_(false),
     lock_(common::ObLatchIds::MACRO_WRITER_LOCK),
     datum_row_(),
     aggregated_row_(nullptr),
@@ -422,6 +758,7 @@ ObMacroBlockWriter::ObMacroBlockWriter(const bool is_need_macro_buffer)
     callback_(nullptr),
     builder_(NULL),
     data_block_pre_warmer_(),
+    encode_pipeline_(nullptr),
     io_buf_(nullptr)
 {
 }
@@ -434,6 +771,13 @@ ObMacroBlockWriter::~ObMacroBlockWriter()
 void ObMacroBlockWriter::reset()
 {
   data_store_desc_ = nullptr;
+  if (OB_NOT_NULL(encode_pipeline_)) {
+    // micro writer belongs to the encode task it is filling
+    micro_writer_ = nullptr;
+    encode_pipeline_->~ObMicroBlockEncodePipeline();
+    allocator_.free(encode_pipeline_);
+    encode_pipeline_ = nullptr;
+  }
   if (OB_NOT_NULL(micro_writer_)) {
     micro_writer_->~ObIMicroBlockWriter();
     allocator_.free(micro_writer_);
@@ -446,6 +790,8 @@ void ObMacroBlockWriter::reset()
   macro_blocks_[1].reset();
   bf_cache_writer_[0].reset();
   bf_cache_writer_[1].reset();
+  reused_row_cnts_[0] = 0;
+  reused_row_cnts_[1] = 0;
   current_index_ = 0;
   current_macro_seq_ = 0;
   last_micro_size_ = INT64_MAX;
@@ -457,6 +803,7 @@ void ObMacroBlockWriter::reset()
   last_key_with_L_flag_ = false;
   is_macro_or_micro_block_reused_ = false;
   micro_rowkey_hashs_.reset();
+  need_bf_cache_writer_ = false;
   datum_row_.reset();
   if (OB_NOT_NULL(builder_)) {
     builder_->~ObDataIndexBlockBuilder();
@@ -552,6 +899,12 @@ int ObMacroBlockWriter::open(
     } else {
       builder_ = nullptr;
     }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(open_bf_cache_writer(data_store_desc))) {
+      STORAGE_LOG(WARN, "Failed to open bloom filter cache writer", K(ret));
+    } else if (OB_FAIL(init_encode_pipeline(data_store_desc))) {
+      STORAGE_LOG(WARN, "Failed to init micro block encode pipeline", K(ret));
+    }
   }
   return ret;
 }
@@ -583,6 +936,8 @@ int ObMacroBlockWriter::append(const ObDataMacroBlockMeta &macro_meta)
 
   if (micro_writer_->get_row_count() > 0 && OB_FAIL(build_micro_block())) {
     LOG_WARN("Fail to build current micro block", K(ret));
+  } else if (nullptr != encode_pipeline_ && OB_FAIL(write_encoded_micro_blocks(true/*wait_all*/))) {
+    LOG_WARN("Fail to write encoded micro blocks", K(ret));
   } else if (OB_FAIL(try_switch_macro_block())) {
     LOG_WARN("Fail to flush and switch macro block", K(ret));
   } else if (OB_UNLIKELY(!macro_meta.is_valid()) || OB_ISNULL(builder_)) {
@@ -593,6 +948,7 @@ int ObMacroBlockWriter::append(const ObDataMacroBlockMeta &macro_meta)
   } else if (OB_FAIL(flush_reuse_macro_block(macro_meta))) {
       LOG_WARN("Fail to flush reuse macro block", K(ret), K(macro_meta));
   } else {
+    disable_rowkey_bloom_filter();
     is_macro_or_micro_block_reused_ = true;
     last_key_with_L_flag_ = false; // clear flag
     if (nullptr != merge_info_) {
@@ -662,6 +1018,8 @@ int ObMacroBlockWriter::append_row(const ObDatumRow &row, const int64_t split_si
       STORAGE_LOG(WARN, "Fail to update_micro_commit_info", K(ret), K(row));
     } else if (OB_FAIL(save_last_key(*row_to_append))) {
       STORAGE_LOG(WARN, "Fail to save last key, ", K(ret), K(row));
+    } else if (OB_FAIL(add_rowkey_hash(*row_to_append))) {
+      STORAGE_LOG(WARN, "Fail to add rowkey hash", K(ret), K(row));
     } else if (nullptr != data_aggregator_ && OB_FAIL(data_aggregator_->eval(*row_to_append))) {
       STORAGE_LOG(WARN, "Fail to evaluate aggregate data", K(ret));
     } else if (OB_FAIL(micro_block_adaptive_splitter_.check_need_split(micro_writer_->get_block_size(), micro_writer_->get_row_count(),
@@ -712,6 +1070,11 @@ int ObMacroBlockWriter::append_micro_block(const ObMicroBlock &micro_block, cons
         STORAGE_LOG(WARN, "build_micro_block failed", K(ret));
       }
     }
+    if (OB_SUCC(ret) && nullptr != encode_pipeline_) {
+      if (OB_FAIL(write_encoded_micro_blocks(true/*wait_all*/))) {
+        STORAGE_LOG(WARN, "Fail to write encoded micro blocks", K(ret));
+      }
+    }
     if (OB_SUCC(ret)) {
       ObMicroBlockDesc micro_block_desc;
       ObMicroBlockHeader header_for_rewrite;
@@ -721,8 +1084,12 @@ int ObMacroBlockWriter::append_micro_block(const ObMicroBlock &micro_block, cons
         STORAGE_LOG(WARN, "Failed to eval aggregated data from reused micro block", K(ret));
       } else if (OB_FAIL(write_micro_block(micro_block_desc))) {
         STORAGE_LOG(WARN, "Failed to write micro block, ", K(ret), K(micro_block_desc));
-      } else if (NULL != merge_info_) {
-        merge_info_->multiplexed_micro_count_in_new_macro_++;
+      } else {
+        disable_rowkey_bloom_filter();
+        reused_row_cnts_[current_index_] += micro_block_desc.row_count_;
+        if (NULL != merge_info_) {
+          merge_info_->multiplexed_micro_count_in_new_macro_++;
+        }
       }
 
       if (OB_SUCC(ret) && nullptr != data_aggregator_) {
@@ -753,14 +1120,20 @@ int ObMacroBlockWriter::append_micro_block(
   if (OB_ISNULL(data_store_desc_)) {
     ret = OB_NOT_INIT;
     STORAGE_LOG(WARN, "The ObMacroBlockWriter has not been opened, ", K(ret), KP(data_store_desc_));
+  } else if (nullptr != encode_pipeline_ && OB_FAIL(write_encoded_micro_blocks(true/*wait_all*/))) {
+    STORAGE_LOG(WARN, "Fail to write encoded micro blocks", K(ret));
   } else if (OB_FAIL(save_last_key(micro_block_desc.last_rowkey_))) {
     STORAGE_LOG(WARN, "fail to save last ke", K(ret), K(micro_block_desc));
   } else if (OB_FAIL(agg_micro_block(micro_index_info))) {
     STORAGE_LOG(WARN, "fail to aggregate micro block", K(ret), K(micro_index_info));
   } else if (OB_FAIL(write_micro_block(micro_block_desc))) {
     STORAGE_LOG(WARN, "fail to write micro block", K(ret), K(micro_block_desc));
-  } else if (nullptr != data_aggregator_) {
-    data_aggregator_->reuse();
+  } else {
+    disable_rowkey_bloom_filter();
+    reused_row_cnts_[current_index_] += micro_block_desc.row_count_;
+    if (nullptr != data_aggregator_) {
+      data_aggregator_->reuse();
+    }
   }
   return ret;
 }
@@ -789,6 +1162,8 @@ int ObMacroBlockWriter::close()
     STORAGE_LOG(WARN, "exceptional situation", K(ret), K_(data_store_desc), K_(micro_writer));
   } else if (micro_writer_->get_row_count() > 0 && OB_FAIL(build_micro_block())) {
     STORAGE_LOG(WARN, "macro block writer fail to build current micro block.", K(ret));
+  } else if (nullptr != encode_pipeline_ && OB_FAIL(write_encoded_micro_blocks(true/*wait_all*/))) {
+    STORAGE_LOG(WARN, "Fail to write encoded micro blocks", K(ret));
   } else {
     ObMacroBlock &current_block = macro_blocks_[current_index_];
     ObMacroBloomFilterCacheWriter &current_bf_writer = bf_cache_writer_[current_index_];
@@ -1036,6 +1411,10 @@ int ObMacroBlockWriter::build_micro_block()
   if (micro_writer_->get_row_count() <= 0) {
     ret = OB_INNER_STAT_ERROR;
     STORAGE_LOG(WARN, "micro_block_writer is empty", K(ret));
+  } else if (nullptr != encode_pipeline_) {
+    if (OB_FAIL(submit_micro_block_encode_task())) {
+      STORAGE_LOG(WARN, "Fail to submit micro block encode task", K(ret));
+    }
   } else if (OB_FAIL(build_hash_index_block())) {
     STORAGE_LOG(WARN, "Failed to build hash index block", K(ret));
   } else if (OB_FAIL(micro_writer_->build_micro_block_desc(micro_block_desc))) {
@@ -1234,7 +1613,7 @@ int ObMacroBlockWriter::build_micro_block_desc_with_rewrite(
   return ret;
 }
 
-int ObMacroBlockWriter::write_micro_block(ObMicroBlockDesc &micro_block_desc)
+int ObMacroBlockWriter::write_micro_block(ObMicroBlockDesc &micro_block_desc, const bool is_aggregated)
 {
   int ret = OB_SUCCESS;
   int64_t data_offset = 0;
@@ -1245,7 +1624,7 @@ int ObMacroBlockWriter::write_micro_block(ObMicroBlockDesc &micro_block_desc)
     // only used to write data block
     micro_block_desc.macro_id_ = ObIndexBlockRowHeader::DEFAULT_IDX_ROW_MACRO_ID;
     micro_block_desc.block_offset_ = macro_blocks_[current_index_].get_data_size();
-    if (nullptr != data_aggregator_ &&
+    if (nullptr != data_aggregator_ && !is_aggregated &&
         OB_FAIL(data_aggregator_->get_aggregated_row(micro_block_desc.aggregated_row_))) {
       STORAGE_LOG(WARN, "Fail to get aggregated row", K(ret), KPC_(data_aggregator));
     } else if (OB_FAIL(builder_->append_row(micro_block_desc, macro_blocks_[current_index_]))) {
@@ -1300,6 +1679,136 @@ int ObMacroBlockWriter::write_micro_block(ObMicroBlockDesc &micro_block_desc)
   return ret;
 }
 
+int ObMacroBlockWriter::init_encode_pipeline(const ObDataStoreDesc &data_store_desc)
+{
+  int ret = OB_SUCCESS;
+  int64_t thread_cnt = 0;
+  void *buf = nullptr;
+  ObTenantMicroBlockEncodePool *encode_pool = MTL(ObTenantMicroBlockEncodePool *);
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+  if (tenant_config.is_valid()) {
+    thread_cnt = tenant_config->_micro_block_encode_parallel_degree;
+  }
+  if (thread_cnt <= 0
+      || nullptr == encode_pool
+      || !data_store_desc.is_major_merge_type()
+      || !data_store_desc.encoding_enabled()
+      || data_store_desc.is_cg()
+      || nullptr == builder_) {
+    // encode micro blocks in the merge thread
+#ifdef OB_BUILD_TDE_SECURITY
+  } else if (share::ObEncryptionUtil::need_encrypt(
+      static_cast<ObCipherOpMode>(data_store_desc.get_encrypt_id()))) {
+    // the iv of an encrypted micro block depends on its offset in the macro block
+#endif
+  } else if (OB_FAIL(encode_pool->adjust_thread_cnt(thread_cnt))) {
+    STORAGE_LOG(WARN, "fail to adjust micro block encode thread count", K(ret), K(thread_cnt));
+  } else if (encode_pool->get_thread_cnt() <= 0) {
+    // the encode pool of tenant is stopped
+  } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObMicroBlockEncodePipeline)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    STORAGE_LOG(WARN, "fail to alloc micro block encode pipeline", K(ret));
+  } else if (FALSE_IT(encode_pipeline_ = new (buf) ObMicroBlockEncodePipeline(allocator_))) {
+  // one more task for the merge thread to fill while the threads are encoding
+  } else if (OB_FAIL(encode_pipeline_->init(data_store_desc, *encode_pool,
+      encode_pool->get_thread_cnt() + 1))) {
+    STORAGE_LOG(WARN, "fail to init micro block encode pipeline", K(ret), K(thread_cnt));
+  } else {
+    // rows are appended into the micro writer of the filling encode task from now on
+    micro_writer_->~ObIMicroBlockWriter();
+    allocator_.free(micro_writer_);
+    micro_writer_ = encode_pipeline_->get_filling_task().micro_writer_;
+  }
+
+  if (OB_FAIL(ret) && nullptr != encode_pipeline_) {
+    encode_pipeline_->~ObMicroBlockEncodePipeline();
+    allocator_.free(encode_pipeline_);
+    encode_pipeline_ = nullptr;
+  }
+  return ret;
+}
+
+int ObMacroBlockWriter::submit_micro_block_encode_task()
+{
+  int ret = OB_SUCCESS;
+  const ObDatumRow *aggregated_row = nullptr;
+  ObMicroBlockEncodeTask &task = encode_pipeline_->get_filling_task();
+  if (OB_UNLIKELY(task.micro_writer_ != micro_writer_)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected micro writer of filling task", K(ret), KP(task.micro_writer_), KP_(micro_writer));
+  } else if (nullptr != data_aggregator_ && OB_FAIL(data_aggregator_->get_aggregated_row(aggregated_row))) {
+    STORAGE_LOG(WARN, "Fail to get aggregated row", K(ret), KPC_(data_aggregator));
+  } else if (OB_FAIL(task.save_block_info(last_key_, aggregated_row))) {
+    STORAGE_LOG(WARN, "Fail to save micro block info", K(ret), K_(last_key));
+  } else if (OB_FAIL(encode_pipeline_->submit_filling_task())) {
+    STORAGE_LOG(WARN, "Fail to submit encode task", K(ret), KPC_(encode_pipeline));
+  } else if (OB_FAIL(write_encoded_micro_blocks(false/*wait_all*/))) {
+    STORAGE_LOG(WARN, "Fail to write encoded micro blocks", K(ret));
+  } else {
+    micro_writer_ = encode_pipeline_->get_filling_task().micro_writer_;
+  }
+  return ret;
+}
+
+int ObMacroBlockWriter::write_encoded_micro_blocks(const bool wait_all)
+{
+  int ret = OB_SUCCESS;
+  bool need_write = true;
+  while (OB_SUCC(ret) && need_write && encode_pipeline_->has_pending_task()) {
+    // keep writing the encoded blocks in order, wait for the oldest one only when the filling
+    // task is still taken by it or all the blocks should be written
+    const bool need_wait = wait_all || encode_pipeline_->is_full();
+    ObMicroBlockEncodeTask *task = nullptr;
+    if (OB_FAIL(encode_pipeline_->get_encoded_task(need_wait, task))) {
+      STORAGE_LOG(WARN, "Fail to get encoded task", K(ret), KPC_(encode_pipeline));
+    } else if (nullptr == task) {
+      need_write = false;
+    } else if (OB_FAIL(write_encoded_micro_block(*task))) {
+      STORAGE_LOG(WARN, "Fail to write encoded micro block", K(ret), KPC(task));
+    } else if (OB_FAIL(encode_pipeline_->release_encoded_task())) {
+      STORAGE_LOG(WARN, "Fail to release encoded task", K(ret), KPC_(encode_pipeline));
+    }
+  }
+  return ret;
+}
+
+int ObMacroBlockWriter::write_encoded_micro_block(ObMicroBlockEncodeTask &task)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  ObMicroBlockDesc &micro_block_desc = task.micro_block_desc_;
+  if (OB_FAIL(task.ret_)) {
+    STORAGE_LOG(WARN, "Fail to encode micro block", K(ret), K(task));
+  } else {
+    micro_block_desc.aggregated_row_ = task.has_aggregated_row_ ? &task.aggregated_row_ : nullptr;
+    if (data_block_pre_warmer_.is_valid()
+        && OB_TMP_FAIL(data_block_pre_warmer_.reserve_kvpair(task.raw_micro_block_desc_))) {
+      if (OB_BUF_NOT_ENOUGH != tmp_ret) {
+        STORAGE_LOG(WARN, "Fail to reserve data block cache value", K(tmp_ret));
+      }
+    }
+    if (OB_FAIL(write_micro_block(micro_block_desc, true/*is_aggregated*/))) {
+      STORAGE_LOG(WARN, "fail to write micro block ", K(ret), K(micro_block_desc));
+    } else if (OB_FAIL(micro_block_adaptive_splitter_.update_compression_info(micro_block_desc.row_count_,
+        task.block_size_, micro_block_desc.buf_size_))) {
+      STORAGE_LOG(WARN, "Fail to update_compression_info", K(ret), K(micro_block_desc));
+    }
+    if (OB_FAIL(ret) || !data_block_pre_warmer_.is_valid() || OB_TMP_FAIL(tmp_ret)) {
+    } else if (OB_TMP_FAIL(data_block_pre_warmer_.update_and_put_kvpair(micro_block_desc))) {
+      STORAGE_LOG(WARN, "Fail to build data cache key and put into cache", K(tmp_ret));
+    }
+    data_block_pre_warmer_.reuse();
+  }
+
+  if (OB_SUCC(ret) && OB_NOT_NULL(merge_info_)) {
+    merge_info_->original_size_ += task.block_size_;
+    merge_info_->compressed_size_ += micro_block_desc.buf_size_;
+  }
+  STORAGE_LOG(DEBUG, "write encoded micro block", "tablet_id", data_store_desc_->get_tablet_id(),
+    K(micro_block_desc), K(ret), K(tmp_ret));
+  return ret;
+}
+
 int ObMacroBlockWriter::try_active_flush_macro_block()
 {
   int ret = OB_SUCCESS;
@@ -1359,6 +1868,8 @@ int ObMacroBlockWriter::flush_macro_block(ObMacroBlock &macro_block)
   } else if (OB_NOT_NULL(builder_)
       && OB_FAIL(builder_->generate_macro_row(macro_block, macro_handle.get_macro_id()))) {
     STORAGE_LOG(WARN, "fail to generate macro row", K(ret), K_(current_macro_seq));
+  } else if (OB_FAIL(flush_bf_cache_writer(macro_block, macro_handle.get_macro_id()))) {
+    STORAGE_LOG(WARN, "fail to flush bloom filter of macro block", K(ret), K_(current_macro_seq));
   } else if (OB_FAIL(macro_block.flush(macro_handle, block_write_ctx_))) {
     STORAGE_LOG(WARN, "macro block writer fail to flush macro block.", K(ret));
   } else if (OB_NOT_NULL(callback_) && OB_FAIL(callback_->write(macro_handle,
@@ -1594,6 +2105,33 @@ int ObMacroBlockWriter::save_last_key(const ObDatumRow &row)
   }
   return ret;
 }
+int ObMacroBlockWriter::add_rowkey_hash(const ObDatumRow &row)
+{
+  int ret = OB_SUCCESS;
+  ObDatumRowkey rowkey;
+  uint64_t hash = 0;
+  if (OB_ISNULL(builder_) || data_store_desc_->is_cg()) {
+    // no rowkey bloom filter
+  } else if (OB_FAIL(rowkey.assign(row.storage_datums_, data_store_desc_->get_schema_rowkey_col_cnt()))) {
+    STORAGE_LOG(WARN, "Failed to assign rowkey", K(ret));
+  } else if (OB_FAIL(rowkey.murmurhash(0, data_store_desc_->get_datum_utils(), hash))) {
+    STORAGE_LOG(WARN, "Failed to calc rowkey hash", K(ret), K(rowkey));
+  } else if (OB_FAIL(builder_->add_rowkey_hash(hash))) {
+    STORAGE_LOG(WARN, "Failed to add rowkey hash", K(ret));
+  } else if (need_bf_cache_writer_ && OB_FAIL(micro_rowkey_hashs_.push_back(static_cast<uint32_t>(hash)))) {
+    STORAGE_LOG(WARN, "Failed to push back rowkey hash", K(ret));
+  }
+  return ret;
+}
+
+void ObMacroBlockWriter::disable_rowkey_bloom_filter()
+{
+  // rowkeys in reused blocks are not added to the filter
+  if (OB_NOT_NULL(builder_)) {
+    builder_->disable_rowkey_bloom_filter();
+  }
+}
+
 int ObMacroBlockWriter::save_last_key(const ObDatumRowkey &last_key)
 {
   int ret = OB_SUCCESS;
@@ -1727,13 +2265,62 @@ int ObMacroBlockWriter::build_micro_writer(const ObDataStoreDesc *data_store_des
   return ret;
 }
 
-int ObMacroBlockWriter::open_bf_cache_writer(
-    const ObDataStoreDesc &desc,
-    const int64_t bloomfilter_size)
+// Merge puts the bloom filter of each data macro block into the bloom filter cache when the
+// block is flushed, so big sstables without a rowkey bloom filter in the sstable meta are
+// filtered without waiting for empty reads. Evicted filters are rebuilt by ObBloomFilterBuildTask.
+int ObMacroBlockWriter::open_bf_cache_writer(const ObDataStoreDesc &desc)
 {
   int ret = OB_SUCCESS;
   bf_cache_writer_[0].reset();
   bf_cache_writer_[1].reset();
+  reused_row_cnts_[0] = 0;
+  reused_row_cnts_[1] = 0;
+  micro_rowkey_hashs_.reuse();
+  need_bf_cache_writer_ = OB_NOT_NULL(builder_)
+      && !desc.is_cg()
+      && GCONF.bf_cache_miss_count_threshold > 0
+      && (desc.is_major_merge_type() || compaction::is_multi_version_merge(desc.get_merge_type()));
+  return ret;
+}
+
+// The rows of reused micro blocks have no hash, so the first (row count - reused row count)
+// hashes are the rowkeys of %macro_block. A macro block with reused micro blocks has no filter.
+int ObMacroBlockWriter::flush_bf_cache_writer(
+    const ObMacroBlock &macro_block,
+    const MacroBlockId &macro_id)
+{
+  int ret = OB_SUCCESS;
+  ObMacroBloomFilterCacheWriter &bf_writer = bf_cache_writer_[current_index_];
+  const int64_t reused_row_cnt = reused_row_cnts_[current_index_];
+  const int64_t hash_cnt = macro_block.get_row_count() - reused_row_cnt;
+  if (!need_bf_cache_writer_ || hash_cnt <= 0) {
+  } else if (OB_UNLIKELY(hash_cnt > micro_rowkey_hashs_.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected rowkey hash count", K(ret), K(hash_cnt), K(reused_row_cnt),
+        "pending_hash_cnt", micro_rowkey_hashs_.count());
+  } else {
+    int tmp_ret = OB_SUCCESS;
+    bf_writer.reset();
+    if (reused_row_cnt > 0) {
+    } else if (OB_TMP_FAIL(bf_writer.init(data_store_desc_->get_schema_rowkey_col_cnt(), hash_cnt))) {
+      STORAGE_LOG(WARN, "Failed to init bloom filter cache writer", K(tmp_ret), K(hash_cnt));
+    } else if (OB_TMP_FAIL(bf_writer.append(&micro_rowkey_hashs_.at(0), hash_cnt))) {
+      STORAGE_LOG(WARN, "Failed to append rowkey hashes", K(tmp_ret), K(hash_cnt));
+    } else if (OB_TMP_FAIL(bf_writer.flush_to_cache(MTL_ID(), macro_id))) {
+      STORAGE_LOG(WARN, "Failed to flush bloom filter to cache", K(tmp_ret), K(macro_id));
+    }
+    bf_writer.reset();
+    // keep the hashes of the rows not flushed yet
+    const int64_t remain_cnt = micro_rowkey_hashs_.count() - hash_cnt;
+    if (remain_cnt > 0) {
+      MEMMOVE(&micro_rowkey_hashs_.at(0), &micro_rowkey_hashs_.at(hash_cnt),
+          remain_cnt * sizeof(uint32_t));
+    }
+    while (micro_rowkey_hashs_.count() > remain_cnt) {
+      micro_rowkey_hashs_.pop_back();
+    }
+  }
+  reused_row_cnts_[current_index_] = 0;
   return ret;
 }
 
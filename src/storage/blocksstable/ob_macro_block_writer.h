@@ -33,6 +33,7 @@
 #include "ob_macro_block_bare_iterator.h"
 #include "ob_micro_block_checksum_helper.h"
 #include "storage/compaction/ob_compaction_memory_context.h"
+#include "lib/lock/ob_thread_cond.h"
 
 namespace oceanbase
 {
@@ -126,6 +127,88 @@ private:
   ObMicroCompressionInfo compression_infos_[DEFAULT_MICRO_ROW_COUNT + 1]; //compression_infos_[0] for total compression info
 };
 
+class ObMicroBlockEncodePipeline;
+class ObTenantMicroBlockEncodePool;
+// A filled data micro block waiting to be encoded and compressed by the encode pipeline.
+// The merge thread appends rows into micro_writer_ and saves the last rowkey and the aggregated
+// row of the block before submitting it, the worker builds micro_block_desc_ and compresses it.
+struct ObMicroBlockEncodeTask
+{
+public:
+  enum State : int8_t
+  {
+    FILLING = 0,
+    SUBMITTED,
+    ENCODING,
+    ENCODED
+  };
+  ObMicroBlockEncodeTask();
+  ~ObMicroBlockEncodeTask();
+  int init(const ObDataStoreDesc &data_store_desc, const int64_t verify_level);
+  void reset();
+  void reuse();
+  int save_block_info(const ObDatumRowkey &last_key, const ObDatumRow *aggregated_row);
+  void encode(const bool need_pre_warm);
+  TO_STRING_KV(K_(micro_block_desc), K_(raw_micro_block_desc), K_(last_key), K_(has_aggregated_row),
+      K_(block_size), K_(ret), K_(state));
+private:
+  int save_raw_micro_block_desc();
+public:
+  ObMicroBlockEncodePipeline *pipeline_;
+  ObIMicroBlockWriter *micro_writer_;
+  ObMicroBlockBufferHelper micro_helper_;
+  ObMicroBlockDesc micro_block_desc_;
+  // uncompressed micro block with a copy of its header, for the data block cache pre warmer
+  ObMicroBlockDesc raw_micro_block_desc_;
+  ObDatumRowkey last_key_;
+  ObDatumRow aggregated_row_;
+  bool has_aggregated_row_;
+  int64_t block_size_;
+  int ret_;
+  State state_;
+  compaction::ObLocalArena allocator_;
+  compaction::ObLocalArena block_allocator_; // reused for every micro block
+};
+
+// Encodes and compresses the data micro blocks of one macro block writer on the threads of
+// ObTenantMicroBlockEncodePool. Tasks form a ring: the merge thread fills tasks_[submit_idx_] and
+// pushes it into the tenant pool, and writes the encoded tasks from tasks_[write_idx_] into the
+// macro block, so micro blocks keep their order and offsets are still assigned by the writer.
+// A task not taken by any thread yet is encoded by the merge thread when it has to be written,
+// so the merge thread never waits for the queue of the tenant pool.
+class ObMicroBlockEncodePipeline
+{
+public:
+  ObMicroBlockEncodePipeline(common::ObIAllocator &allocator);
+  ~ObMicroBlockEncodePipeline();
+  int init(const ObDataStoreDesc &data_store_desc, ObTenantMicroBlockEncodePool &encode_pool, const int64_t task_cnt);
+  void destroy();
+  OB_INLINE ObMicroBlockEncodeTask &get_filling_task() { return tasks_[submit_idx_ % task_cnt_]; }
+  OB_INLINE bool has_pending_task() const { return write_idx_ < submit_idx_; }
+  // the filling task is taken by the oldest pending task, which has to be written first
+  OB_INLINE bool is_full() const { return submit_idx_ - write_idx_ >= task_cnt_; }
+  int submit_filling_task();
+  // get the oldest pending task if it is encoded, encode it or wait for its encoding if %need_wait
+  int get_encoded_task(const bool need_wait, ObMicroBlockEncodeTask *&task);
+  int release_encoded_task();
+  // called by the threads of encode pool
+  void handle_queued_task(ObMicroBlockEncodeTask &task);
+  TO_STRING_KV(K_(task_cnt), K_(submit_idx), K_(write_idx), K_(queued_cnt), K_(need_pre_warm), K_(is_inited));
+private:
+  static const int64_t WAIT_INTERVAL_MS = 100;
+  common::ObIAllocator &allocator_;
+  common::ObThreadCond cond_;
+  ObTenantMicroBlockEncodePool *encode_pool_;
+  ObMicroBlockEncodeTask *tasks_;
+  int64_t task_cnt_;
+  int64_t submit_idx_;
+  int64_t write_idx_;
+  // tasks pushed into the encode pool and not handled yet, the pipeline can not be freed before
+  int64_t queued_cnt_;
+  bool need_pre_warm_;
+  bool is_inited_;
+};
+
 class ObMacroBlockWriter
 {
 public:
@@ -168,7 +251,11 @@ protected:
   virtual int build_micro_block();
   virtual int try_switch_macro_block();
   virtual bool is_keep_freespace() const {return false; }
-  inline bool is_dirty() const { return macro_blocks_[current_index_].is_dirty() || 0 != micro_writer_->get_row_count(); }
+  inline bool is_dirty() const
+  {
+    return macro_blocks_[current_index_].is_dirty() || 0 != micro_writer_->get_row_count()
+        || (nullptr != encode_pipeline_ && encode_pipeline_->has_pending_task());
+  }
   inline int64_t get_curr_micro_writer_row_count() const { return micro_writer_->get_row_count(); }
   inline int64_t get_macro_data_size() const { return macro_blocks_[current_index_].get_data_size() + micro_writer_->get_block_size(); }
 
@@ -192,7 +279,12 @@ private:
       ObMicroBlockDesc &micro_block_desc,
       ObMicroBlockHeader &header);
   int build_micro_block_desc_with_reuse(const ObMicroBlock &micro_block, ObMicroBlockDesc &micro_block_desc);
-  int write_micro_block(ObMicroBlockDesc &micro_block_desc);
+  // %is_aggregated means the aggregated row of the micro block is already set in %micro_block_desc
+  int write_micro_block(ObMicroBlockDesc &micro_block_desc, const bool is_aggregated = false);
+  int init_encode_pipeline(const ObDataStoreDesc &data_store_desc);
+  int submit_micro_block_encode_task();
+  int write_encoded_micro_blocks(const bool wait_all);
+  int write_encoded_micro_block(ObMicroBlockEncodeTask &task);
   int check_micro_block_need_merge(const ObMicroBlock &micro_block, bool &need_merge);
   int merge_micro_block(const ObMicroBlock &micro_block);
   int flush_macro_block(ObMacroBlock &macro_block);
@@ -202,13 +294,16 @@ private:
   int check_write_complete(const MacroBlockId &macro_block_id);
   int save_last_key(const ObDatumRow &row);
   int save_last_key(const ObDatumRowkey &last_key);
+  int add_rowkey_hash(const ObDatumRow &row);
+  void disable_rowkey_bloom_filter();
   int add_row_checksum(const ObDatumRow &row);
   int calc_micro_column_checksum(
       const int64_t column_cnt,
       ObIMicroBlockReader &reader,
       int64_t *column_checksum);
   int flush_reuse_macro_block(const ObDataMacroBlockMeta &macro_meta);
-  int open_bf_cache_writer(const ObDataStoreDesc &desc, const int64_t bloomfilter_size);
+  int open_bf_cache_writer(const ObDataStoreDesc &desc);
+  int flush_bf_cache_writer(const ObMacroBlock &macro_block, const MacroBlockId &macro_id);
   int update_micro_commit_info(const ObDatumRow &row);
   void dump_micro_block(ObIMicroBlockWriter &micro_writer);
   void dump_macro_block(ObMacroBlock &macro_block);
@@ -229,6 +324,7 @@ private:
   ObMicroBlockBufferHelper micro_helper_;
   ObMacroBlock macro_blocks_[2];
   ObMacroBloomFilterCacheWriter bf_cache_writer_[2];//associate with macro_blocks
+  int64_t reused_row_cnts_[2]; // rows of reused micro blocks in macro_blocks, not in the bloom filter
   int64_t current_index_;
   int64_t current_macro_seq_;        // set by sstable layer;
   int64_t last_micro_size_;
@@ -244,7 +340,9 @@ private:
   compaction::ObLocalArena allocator_;
   compaction::ObLocalArena rowkey_allocator_;
   blocksstable::ObMacroBlockReader macro_reader_;
+  // rowkey hashes of the appended rows not flushed with a macro block yet, in append order
   common::ObArray<uint32_t> micro_rowkey_hashs_;
+  bool need_bf_cache_writer_;
   common::SpinRWLock lock_;
   blocksstable::ObDatumRow datum_row_;
   blocksstable::ObDatumRow *aggregated_row_;
@@ -253,6 +351,7 @@ private:
   ObDataIndexBlockBuilder *builder_;
   ObMicroBlockAdaptiveSplitter micro_block_adaptive_splitter_;
   ObDataBlockCachePreWarmer data_block_pre_warmer_;
+  ObMicroBlockEncodePipeline *encode_pipeline_;
   char *io_buf_;
 };
 
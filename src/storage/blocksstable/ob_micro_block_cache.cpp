@@ -13,6 +13,7 @@
 #define USING_LOG_PREFIX STORAGE
 
 #include "storage/blocksstable/ob_micro_block_cache.h"
+#include "storage/blocksstable/ob_micro_block_disk_cache.h"
 #include "storage/blocksstable/ob_block_manager.h"
 #include "storage/blocksstable/ob_macro_block_handle.h"
 #include "storage/blocksstable/ob_shared_macro_block_manager.h"
@@ -297,13 +298,14 @@ int ObMultiBlockIOParam::get_block_des_info(ObMicroBlockDesMeta &des_meta) const
 
 void ObMultiBlockIOCtx::reset()
 {
-  micro_index_infos_ = nullptr;
+  micro_offsets_ = nullptr;
+  micro_sizes_ = nullptr;
   block_count_ = 0;
 }
 
 bool ObMultiBlockIOCtx::is_valid() const
 {
-  return OB_NOT_NULL(micro_index_infos_) && block_count_ > 0;
+  return OB_NOT_NULL(micro_offsets_) && OB_NOT_NULL(micro_sizes_) && block_count_ > 0;
 }
 
 /*---------------------------------------ObIMicroBlockIOCallback-------------------------------------*/
@@ -315,6 +317,8 @@ ObIMicroBlockIOCallback::ObIMicroBlockIOCallback()
     tenant_id_(OB_INVALID_TENANT_ID),
     block_id_(),
     offset_(0),
+    block_size_(0),
+    disk_cache_lsn_(-1),
     block_des_meta_(),
     use_block_cache_(true)
 {
@@ -393,9 +397,19 @@ int ObIMicroBlockIOCallback::process_block(
         LOG_WARN("Fail to get kvcache", K(ret));
       } else if (OB_UNLIKELY(OB_SUCCESS == (ret = kvcache->get(key, micro_block, cache_handle)))) {
         // entry exist, no need to put
+      } else if (!kvcache->admit(key)) {
+        // rejected by the admission filter, copy the block out of cache without allocating a kvpair
+        if (OB_FAIL(read_block_and_copy(header, *reader, buffer, size, block_data, micro_block, cache_handle))) {
+          LOG_WARN("Fail to read micro block and copy to cache value", K(ret));
+        }
       } else if (OB_FAIL(cache_->put_cache_block(
           block_des_meta_, buffer, key, *reader, *allocator_, micro_block, cache_handle))) {
         LOG_WARN("Failed to put block to cache", K(ret));
+      } else if (ObMicroBlockDiskCache::get_instance().is_enabled()) {
+        int tmp_ret = OB_SUCCESS;
+        if (OB_TMP_FAIL(ObMicroBlockDiskCache::get_instance().put(key, block_des_meta_, buffer))) {
+          LOG_WARN("Failed to put block to disk cache", K(tmp_ret), K(key));
+        }
       }
     }
 
@@ -406,6 +420,47 @@ int ObIMicroBlockIOCallback::process_block(
   return ret;
 }
 
+// The entry read from the micro block disk cache may have been overwritten after the index
+// lookup, read the block from data file in that case.
+int ObIMicroBlockIOCallback::get_disk_cache_block(
+    const char *entry_buf,
+    const int64_t entry_size,
+    const char *&block_buf)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockCacheKey key(tenant_id_, block_id_, offset_, block_size_);
+  if (OB_FAIL(ObMicroBlockDiskCache::get_instance().check_entry(
+      key, disk_cache_lsn_, entry_buf, entry_size, block_des_meta_, block_buf))) {
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      LOG_WARN("Fail to check micro block disk cache entry", K(ret), K(key), K_(disk_cache_lsn));
+    } else if (OB_ISNULL(allocator_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("Unexpected null allocator", K(ret), K(key));
+    } else {
+      ObMacroBlockHandle macro_handle;
+      ObMacroBlockReadInfo read_info;
+      read_info.macro_block_id_ = block_id_;
+      read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_DATA_READ);
+      read_info.io_desc_.set_group_id(ObIOModule::MICRO_BLOCK_CACHE_IO);
+      read_info.offset_ = offset_;
+      read_info.size_ = block_size_;
+      read_info.io_timeout_ms_ = GCONF._data_storage_io_timeout / 1000L;
+      if (OB_ISNULL(read_info.buf_ = static_cast<char *>(allocator_->alloc(block_size_)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("Fail to allocate memory", K(ret), K_(block_size));
+      } else if (OB_FAIL(ObBlockManager::read_block(read_info, macro_handle))) {
+        LOG_WARN("Fail to read block", K(ret), K(read_info));
+        allocator_->free(read_info.buf_);
+      } else {
+        // freed with the callback
+        data_buffer_ = read_info.buf_;
+        block_buf = data_buffer_;
+      }
+    }
+  }
+  return ret;
+}
+
 int ObIMicroBlockIOCallback::read_block_and_copy(
     const ObMicroBlockHeader &header,
     ObMacroBlockReader &reader,
@@ -491,10 +546,19 @@ int ObAsyncSingleMicroBlockIOCallback::inner_process(const char *data_buffer, co
     LOG_WARN("invalid data buffer size", K(ret), K(size), KP(data_buffer));
   } else {
     ObMacroBlockReader *reader = nullptr;
+    const char *block_buf = data_buffer;
+    int64_t block_size = size;
     if (OB_ISNULL(reader = GET_TSI_MULT(ObMacroBlockReader, 1))) {
       ret = OB_ALLOCATE_MEMORY_FAILED;
       LOG_WARN("Fail to allocate ObMacroBlockReader, ", K(ret));
-    } else if (OB_FAIL(process_block(reader, data_buffer, offset_, size, micro_block_, cache_handle_))) {
+    } else if (disk_cache_lsn_ < 0) {
+    } else if (OB_FAIL(get_disk_cache_block(data_buffer, size, block_buf))) {
+      LOG_WARN("Fail to get block from micro block disk cache entry", K(ret), K_(disk_cache_lsn));
+    } else {
+      block_size = block_size_;
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(process_block(reader, block_buf, offset_, block_size, micro_block_, cache_handle_))) {
       LOG_WARN("process_block failed", K(ret));
     }
   }
@@ -519,6 +583,7 @@ ObMultiDataBlockIOCallback::ObMultiDataBlockIOCallback()
 ObMultiDataBlockIOCallback::~ObMultiDataBlockIOCallback()
 {
   free_result();
+  free_io_ctx();
 }
 
 int64_t ObMultiDataBlockIOCallback::size() const
@@ -547,8 +612,8 @@ int ObMultiDataBlockIOCallback::inner_process(const char *data_buffer, const int
 
     const int64_t block_count = io_ctx_.block_count_;
     for (int64_t i = 0; OB_SUCC(ret) && i < block_count; ++i) {
-      const int64_t data_size = io_ctx_.micro_index_infos_[i].get_block_size();
-      const int64_t data_offset = io_ctx_.micro_index_infos_[i].get_block_offset() - offset_;
+      const int64_t data_size = io_ctx_.micro_sizes_[i];
+      const int64_t data_offset = io_ctx_.micro_offsets_[i] - offset_;
       if (OB_FAIL(process_block(
           reader,
           data_buffer + data_offset,
@@ -578,40 +643,27 @@ int ObMultiDataBlockIOCallback::set_io_ctx(
     const ObMultiBlockIOParam &io_param)
 {
   int ret = OB_SUCCESS;
+  void *ptr = nullptr;
+  const int64_t block_count = io_param.block_count_;
   if (OB_UNLIKELY(!io_param.is_valid())) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("invalid io_param", K(ret), K(io_param));
-  } else {
-    io_ctx_.micro_index_infos_ = &io_param.micro_index_infos_->at(io_param.start_index_);
-    io_ctx_.block_count_ = io_param.block_count_;
-  }
-  return ret;
-}
-
-int ObMultiDataBlockIOCallback::deep_copy_ctx(
-    const ObMultiBlockIOCtx &io_ctx)
-{
-  int ret = OB_SUCCESS;
-  if (OB_UNLIKELY(!io_ctx.is_valid())) {
-    ret = OB_INVALID_ARGUMENT;
-    LOG_WARN("invalid io_ctx", K(ret), K(io_ctx));
   } else if (OB_ISNULL(allocator_)) {
     ret = OB_INNER_STAT_ERROR;
     LOG_WARN("allocator_ is null", K(ret), KP(allocator_));
+  } else if (OB_ISNULL(ptr = allocator_->alloc(sizeof(int64_t) * block_count * 2))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc memory failed", K(ret), K(block_count));
   } else {
-    void *ptr = nullptr;
-    int64_t alloc_size = sizeof(ObMicroIndexInfo) * io_ctx.block_count_;
-    if (OB_ISNULL(ptr = allocator_->alloc(alloc_size))) {
-      ret = OB_ALLOCATE_MEMORY_FAILED;
-      LOG_WARN("alloc memory failed", K(ret), K(alloc_size));
-    } else {
-      io_ctx_.micro_index_infos_ = reinterpret_cast<ObMicroIndexInfo *>(ptr);
-      MEMCPY(io_ctx_.micro_index_infos_, io_ctx.micro_index_infos_, alloc_size);
-    }
-
-    if (OB_SUCC(ret)) {
-      io_ctx_.block_count_ = io_ctx.block_count_;
+    // the index infos of the io param may be reused by the caller before the io is done
+    io_ctx_.micro_offsets_ = reinterpret_cast<int64_t *>(ptr);
+    io_ctx_.micro_sizes_ = io_ctx_.micro_offsets_ + block_count;
+    for (int64_t i = 0; i < block_count; ++i) {
+      const ObMicroIndexInfo &micro_info = io_param.micro_index_infos_->at(io_param.start_index_ + i);
+      io_ctx_.micro_offsets_[i] = micro_info.get_block_offset();
+      io_ctx_.micro_sizes_[i] = micro_info.get_block_size();
     }
+    io_ctx_.block_count_ = block_count;
   }
   return ret;
 }
@@ -641,6 +693,15 @@ int ObMultiDataBlockIOCallback::alloc_result()
   return ret;
 }
 
+void ObMultiDataBlockIOCallback::free_io_ctx()
+{
+  if (OB_NOT_NULL(allocator_) && OB_NOT_NULL(io_ctx_.micro_offsets_)) {
+    // sizes share the buffer of offsets
+    allocator_->free(io_ctx_.micro_offsets_);
+  }
+  io_ctx_.reset();
+}
+
 void ObMultiDataBlockIOCallback::free_result()
 {
   if (OB_NOT_NULL(allocator_)) {
@@ -815,6 +876,8 @@ int ObIMicroBlockCache::prefetch(
     callback.tenant_id_ = tenant_id;
     callback.block_id_ = macro_id;
     callback.offset_ = idx_row.get_block_offset();
+    callback.block_size_ = idx_row.get_block_size();
+    callback.disk_cache_lsn_ = -1;
     callback.block_des_meta_.compressor_type_ = idx_row_header->get_compressor_type();
     callback.block_des_meta_.encrypt_id_ = idx_row_header->get_encrypt_id();
     callback.block_des_meta_.master_key_id_ = idx_row_header->get_master_key_id();
@@ -829,9 +892,14 @@ int ObIMicroBlockCache::prefetch(
     read_info.offset_ = idx_row.get_block_offset();
     read_info.size_ = idx_row.get_block_size();
     read_info.io_timeout_ms_ = max(THIS_WORKER.get_timeout_remain() / 1000, 0);
-    if (OB_FAIL(ObBlockManager::async_read_block(read_info, macro_handle))) {
-      STORAGE_LOG(WARN, "Fail to async read block, ", K(ret), K(read_info));
-    } else {
+    if (OB_FAIL(prefetch_from_disk_cache(read_info, macro_handle, callback))) {
+      if (OB_ENTRY_NOT_EXIST != ret) {
+        STORAGE_LOG(WARN, "Fail to async read micro block disk cache, ", K(ret), K(read_info));
+      } else if (OB_FAIL(ObBlockManager::async_read_block(read_info, macro_handle))) {
+        STORAGE_LOG(WARN, "Fail to async read block, ", K(ret), K(read_info));
+      }
+    }
+    if (OB_SUCC(ret)) {
       EVENT_INC(ObStatEventIds::IO_READ_PREFETCH_MICRO_COUNT);
       EVENT_ADD(ObStatEventIds::IO_READ_PREFETCH_MICRO_BYTES, idx_row.get_block_size());
     }
@@ -860,6 +928,8 @@ int ObIMicroBlockCache::prefetch(
     callback.tenant_id_ = tenant_id;
     callback.block_id_ = macro_id;
     callback.offset_ = offset;
+    callback.block_size_ = size;
+    callback.disk_cache_lsn_ = -1;
     callback.use_block_cache_ = use_cache;
     // fill read info
     ObMacroBlockReadInfo read_info;
@@ -880,6 +950,34 @@ int ObIMicroBlockCache::prefetch(
   return ret;
 }
 
+// Read the cached entry of the block from the micro block disk cache with the io manager, the
+// callback gets the block out of the entry. Return OB_ENTRY_NOT_EXIST if it is not cached.
+int ObIMicroBlockCache::prefetch_from_disk_cache(
+    const ObMacroBlockReadInfo &read_info,
+    ObMacroBlockHandle &macro_handle,
+    ObIMicroBlockIOCallback &callback)
+{
+  int ret = OB_SUCCESS;
+  ObMicroBlockDiskCache &disk_cache = ObMicroBlockDiskCache::get_instance();
+  if (!callback.use_block_cache_ || !disk_cache.is_enabled()) {
+    ret = OB_ENTRY_NOT_EXIST;
+  } else {
+    const ObMicroBlockCacheKey key(callback.tenant_id_, read_info.macro_block_id_, read_info.offset_, read_info.size_);
+    const int64_t timeout_us = min(read_info.io_timeout_ms_, GCONF._data_storage_io_timeout / 1000L) * 1000L;
+    macro_handle.reuse();
+    if (OB_FAIL(disk_cache.async_get(key, read_info.io_desc_, timeout_us, read_info.io_callback_,
+        macro_handle.get_io_handle(), callback.disk_cache_lsn_))) {
+      if (OB_ENTRY_NOT_EXIST == ret) {
+        callback.disk_cache_lsn_ = -1;
+      } else {
+        // the callback is released with the io request
+        LOG_WARN("Fail to async get micro block disk cache", K(ret), K(key));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObIMicroBlockCache::add_put_size(const int64_t put_size)
 {
   UNUSED(put_size);
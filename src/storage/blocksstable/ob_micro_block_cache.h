@@ -132,14 +132,16 @@ struct ObMultiBlockIOParam
 struct ObMultiBlockIOCtx
 {
   ObMultiBlockIOCtx()
-    : micro_index_infos_(nullptr), hit_cache_bitmap_(nullptr), block_count_(0) {}
+    : micro_offsets_(nullptr), micro_sizes_(nullptr), block_count_(0) {}
   virtual ~ObMultiBlockIOCtx() {}
   void reset();
   bool is_valid() const;
-  ObMicroIndexInfo *micro_index_infos_;
-  bool *hit_cache_bitmap_;
+  // offsets and sizes of the micro blocks in the macro block, copied from the index infos of the
+  // io param, whose row headers may be released before the io is done
+  int64_t *micro_offsets_;
+  int64_t *micro_sizes_;
   int64_t block_count_;
-  TO_STRING_KV(KP_(micro_index_infos), KP_(hit_cache_bitmap), K_(block_count));
+  TO_STRING_KV(KP_(micro_offsets), KP_(micro_sizes), K_(block_count));
 };
 
 class ObIPutSizeStat
@@ -168,6 +170,7 @@ protected:
       const int64_t size,
       const ObMicroBlockCacheValue *&micro_block,
       common::ObKVCacheHandle &cache_handle);
+  int get_disk_cache_block(const char *entry_buf, const int64_t entry_size, const char *&block_buf);
 private:
   int read_block_and_copy(
       const ObMicroBlockHeader &header,
@@ -187,6 +190,9 @@ protected:
   uint64_t tenant_id_;
   MacroBlockId block_id_;
   int64_t offset_;
+  int64_t block_size_;
+  // position of the entry in the micro block disk cache, -1 if read from data file
+  int64_t disk_cache_lsn_;
   ObMicroBlockDesMeta block_des_meta_;
   bool use_block_cache_;
   char encrypt_key_[share::OB_MAX_TABLESPACE_ENCRYPT_KEY_LENGTH];
@@ -222,8 +228,7 @@ public:
 private:
   friend class ObDataMicroBlockCache;
   int set_io_ctx(const ObMultiBlockIOParam &io_param);
-  void reset_io_ctx() { io_ctx_.reset(); }
-  int deep_copy_ctx(const ObMultiBlockIOCtx &io_ctx);
+  void free_io_ctx();
   int alloc_result();
   void free_result();
   DISALLOW_COPY_AND_ASSIGN(ObMultiDataBlockIOCallback);
@@ -317,7 +322,6 @@ public:
       int64_t &kvpair_size) = 0;
   virtual ObMicroBlockData::Type get_type() = 0;
   virtual int add_put_size(const int64_t put_size) override;
-
 protected:
   int prefetch(
       const uint64_t tenant_id,
@@ -325,6 +329,10 @@ protected:
       const ObMicroIndexInfo& idx_row,
       ObMacroBlockHandle &macro_handle,
       ObIMicroBlockIOCallback &callback);
+  int prefetch_from_disk_cache(
+      const ObMacroBlockReadInfo &read_info,
+      ObMacroBlockHandle &macro_handle,
+      ObIMicroBlockIOCallback &callback);
   int prefetch(
       const uint64_t tenant_id,
       const MacroBlockId &macro_id,
@@ -0,0 +1,613 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+#include "storage/blocksstable/ob_micro_block_disk_cache.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include "lib/checksum/ob_crc64.h"
+#include "lib/file/file_directory_utils.h"
+#include "lib/stat/ob_diagnose_info.h"
+#include "share/io/ob_io_manager.h"
+#include "share/ob_encryption_util.h"
+#include "share/rc/ob_tenant_base.h"
+#include "storage/blocksstable/ob_micro_block_cache.h"
+#include "storage/blocksstable/ob_micro_block_header.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace blocksstable
+{
+
+static const char *MICRO_BLOCK_DISK_CACHE_FILE_NAME = "micro_block_cache.dat";
+static const char *MICRO_BLOCK_DISK_CACHE_LABEL = "MicroDiskCache";
+
+int64_t ObMicroBlockDiskCacheSuperBlock::calc_checksum() const
+{
+  ObMicroBlockDiskCacheSuperBlock super_block = *this;
+  super_block.checksum_ = 0;
+  return static_cast<int64_t>(ob_crc64(&super_block, sizeof(super_block)));
+}
+
+bool ObMicroBlockDiskCacheSuperBlock::is_valid() const
+{
+  return MAGIC == magic_
+      && VERSION == version_
+      && checksum_ == calc_checksum();
+}
+
+int64_t ObMicroBlockDiskCacheEntryHeader::calc_header_checksum() const
+{
+  ObMicroBlockDiskCacheEntryHeader header = *this;
+  header.header_checksum_ = 0;
+  return static_cast<int64_t>(ob_crc64(&header, sizeof(header)));
+}
+
+bool ObMicroBlockDiskCacheEntryHeader::is_valid() const
+{
+  return MAGIC == magic_
+      && VERSION == version_
+      && sizeof(ObMicroBlockDiskCacheEntryHeader) == header_size_
+      && lsn_ >= 0
+      && size_ > 0
+      && header_checksum_ == calc_header_checksum();
+}
+
+ObMicroBlockDiskCache::ObMicroBlockDiskCache()
+  : is_inited_(false),
+    fd_(-1),
+    aio_fd_(),
+    file_size_(0),
+    restart_write_seq_(-1),
+    write_lsn_(0),
+    evict_lsn_(0),
+    index_(),
+    fill_queue_(),
+    io_buf_(nullptr)
+{
+  MEMSET(path_, 0, sizeof(path_));
+}
+
+ObMicroBlockDiskCache::~ObMicroBlockDiskCache()
+{
+  destroy();
+}
+
+ObMicroBlockDiskCache &ObMicroBlockDiskCache::get_instance()
+{
+  static ObMicroBlockDiskCache instance_;
+  return instance_;
+}
+
+int ObMicroBlockDiskCache::init(const char *dir, const int64_t cache_size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t file_size = lower_align(cache_size, DIO_READ_ALIGN_SIZE);
+  int aio_fd = -1;
+  const ObMemAttr attr(OB_SERVER_TENANT_ID, MICRO_BLOCK_DISK_CACHE_LABEL);
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("micro block disk cache init twice", K(ret));
+  } else if (OB_ISNULL(dir) || OB_UNLIKELY(0 == STRLEN(dir) || file_size < MIN_CACHE_FILE_SIZE)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(dir), K(cache_size));
+  } else if (OB_FAIL(FileDirectoryUtils::create_full_path(dir))) {
+    LOG_WARN("fail to create micro block disk cache dir", K(ret), K(dir));
+  } else if (OB_FAIL(databuff_printf(path_, sizeof(path_), "%s/%s", dir, MICRO_BLOCK_DISK_CACHE_FILE_NAME))) {
+    LOG_WARN("fail to print micro block disk cache file path", K(ret), K(dir));
+  } else if ((fd_ = ::open(path_, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR)) < 0) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to open micro block disk cache file", K(ret), K_(path), K(errno), KERRMSG);
+  } else if ((aio_fd = ::open(path_, O_RDONLY | O_DIRECT)) < 0
+      && (EINVAL != errno || (aio_fd = ::open(path_, O_RDONLY)) < 0)) {
+    // fall back to buffered io if the file system does not support direct io
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to open micro block disk cache file for aio", K(ret), K_(path), K(errno), KERRMSG);
+  } else if (FALSE_IT(aio_fd_ = ObIOFd(THE_IO_DEVICE, ObIOFd::NORMAL_FILE_ID, aio_fd))) {
+  } else if (0 != ::ftruncate(fd_, SUPER_BLOCK_SIZE + file_size)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to truncate micro block disk cache file", K(ret), K_(path), K(file_size), K(errno), KERRMSG);
+  } else if (OB_FAIL(index_.create(
+      max(file_size / OB_DEFAULT_SSTABLE_BLOCK_SIZE, 1024L), attr, attr))) {
+    LOG_WARN("fail to create micro block disk cache index", K(ret), K(file_size));
+  } else if (OB_FAIL(fill_queue_.init(FILL_QUEUE_SIZE, MICRO_BLOCK_DISK_CACHE_LABEL))) {
+    LOG_WARN("fail to init fill queue", K(ret));
+  } else if (OB_ISNULL(io_buf_ = static_cast<char *>(ob_malloc(IO_BUF_SIZE, attr)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate io buf", K(ret));
+  } else {
+    file_size_ = file_size;
+    restart_write_seq_ = -1;
+    write_lsn_ = 0;
+    evict_lsn_ = 0;
+    is_inited_ = true;
+    LOG_INFO("micro block disk cache inited", K_(path), K_(file_size));
+  }
+  if (OB_FAIL(ret) && !is_inited_) {
+    destroy();
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::start()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("micro block disk cache not init", K(ret));
+  } else if (OB_FAIL(share::ObThreadPool::start())) {
+    LOG_WARN("fail to start micro block disk cache fill thread", K(ret));
+  }
+  return ret;
+}
+
+void ObMicroBlockDiskCache::stop()
+{
+  share::ObThreadPool::stop();
+}
+
+void ObMicroBlockDiskCache::wait()
+{
+  share::ObThreadPool::wait();
+}
+
+void ObMicroBlockDiskCache::destroy()
+{
+  stop();
+  wait();
+  share::ObThreadPool::destroy();
+  is_inited_ = false;
+  if (fill_queue_.is_inited()) {
+    void *task = nullptr;
+    while (OB_SUCCESS == fill_queue_.pop(task)) {
+      free_task(static_cast<FillTask *>(task));
+    }
+    fill_queue_.destroy();
+  }
+  index_.destroy();
+  if (nullptr != io_buf_) {
+    ob_free(io_buf_);
+    io_buf_ = nullptr;
+  }
+  if (fd_ >= 0) {
+    ::close(fd_);
+    fd_ = -1;
+  }
+  if (aio_fd_.second_id_ >= 0) {
+    ::close(static_cast<int>(aio_fd_.second_id_));
+  }
+  aio_fd_.reset();
+  file_size_ = 0;
+  restart_write_seq_ = -1;
+  write_lsn_ = 0;
+  evict_lsn_ = 0;
+}
+
+void ObMicroBlockDiskCache::run1()
+{
+  int ret = OB_SUCCESS;
+  lib::set_thread_name("MicroDiskCache");
+  // entries in the file are unknown until the block manager tells the restart write seq
+  while (!has_set_stop() && ATOMIC_LOAD(&restart_write_seq_) < 0) {
+    ob_usleep(FILL_WAIT_TIMEOUT_US);
+  }
+  if (!has_set_stop() && OB_FAIL(recover())) {
+    LOG_WARN("fail to recover micro block disk cache, start with an empty one", K(ret));
+    index_.reuse();
+    write_lsn_ = 0;
+    evict_lsn_ = 0;
+  }
+  while (!has_set_stop()) {
+    void *task = nullptr;
+    if (OB_SUCCESS == fill_queue_.pop(task, FILL_WAIT_TIMEOUT_US)) {
+      if (OB_FAIL(write_entry(*static_cast<FillTask *>(task)))) {
+        LOG_WARN("fail to write micro block disk cache entry", K(ret));
+      }
+      free_task(static_cast<FillTask *>(task));
+    }
+  }
+}
+
+// Called in ObBlockManager::first_mark_device() before any macro block is allocated, the super
+// block is written here so that the bound is persisted before the write seq moves on.
+void ObMicroBlockDiskCache::set_restart_write_seq(const int64_t write_seq)
+{
+  int ret = OB_SUCCESS;
+  ObMicroBlockDiskCacheSuperBlock super_block;
+  int64_t max_valid_write_seq = write_seq;
+  if (OB_UNLIKELY(!is_inited_)) {
+    // disabled
+  } else if (OB_UNLIKELY(write_seq < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(write_seq));
+  } else if (OB_FAIL(read_super_block(super_block))) {
+    LOG_WARN("fail to read micro block disk cache super block", K(ret));
+  } else if (FALSE_IT(max_valid_write_seq = super_block.is_cleaning_
+      ? min(super_block.max_valid_write_seq_, write_seq) : write_seq)) {
+  } else if (OB_FAIL(write_super_block(max_valid_write_seq, true /* is_cleaning */))) {
+    // the cache stays empty in this boot
+    LOG_WARN("fail to write micro block disk cache super block", K(ret), K(max_valid_write_seq));
+  } else {
+    ATOMIC_STORE(&restart_write_seq_, max_valid_write_seq);
+    LOG_INFO("micro block disk cache starts recovery", K(write_seq), K(super_block), K(max_valid_write_seq));
+  }
+}
+
+int ObMicroBlockDiskCache::async_get(
+    const ObMicroBlockCacheKey &key,
+    const ObIOFlag &io_desc,
+    const int64_t timeout_us,
+    ObIOCallback *callback,
+    ObIOHandle &io_handle,
+    int64_t &lsn)
+{
+  int ret = OB_SUCCESS;
+  lsn = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_ENTRY_NOT_EXIST;
+  } else if (OB_ISNULL(callback)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key), KP(callback));
+  } else if (OB_FAIL(index_.get_refactored(key.hash(), lsn))) {
+    if (OB_HASH_NOT_EXIST == ret) {
+      ret = OB_ENTRY_NOT_EXIST;
+      EVENT_INC(ObStatEventIds::MICRO_BLOCK_DISK_CACHE_MISS);
+    } else {
+      LOG_WARN("fail to get micro block disk cache index", K(ret), K(key));
+    }
+  } else {
+    ObIOInfo io_info;
+    io_info.tenant_id_ = MTL_ID();
+    if (is_virtual_tenant_id(io_info.tenant_id_) || 0 == io_info.tenant_id_) {
+      io_info.tenant_id_ = OB_SERVER_TENANT_ID;
+    }
+    io_info.fd_ = aio_fd_;
+    io_info.offset_ = get_file_offset(lsn);
+    io_info.size_ = get_entry_size(key.get_micro_block_id().size_);
+    io_info.flag_ = io_desc;
+    io_info.flag_.set_read();
+    io_info.callback_ = callback;
+    io_info.timeout_us_ = timeout_us;
+    if (OB_FAIL(ObIOManager::get_instance().aio_read(io_info, io_handle))) {
+      LOG_WARN("fail to aio read micro block disk cache file", K(ret), K(key), K(lsn), K(io_info));
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::check_entry(
+    const ObMicroBlockCacheKey &key,
+    const int64_t lsn,
+    const char *entry_buf,
+    const int64_t entry_size,
+    ObMicroBlockDesMeta &des_meta,
+    const char *&block_buf)
+{
+  int ret = OB_SUCCESS;
+  const int64_t size = key.get_micro_block_id().size_;
+  block_buf = nullptr;
+  if (OB_ISNULL(entry_buf)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key), KP(entry_buf));
+  } else {
+    const ObMicroBlockDiskCacheEntryHeader &header =
+        *reinterpret_cast<const ObMicroBlockDiskCacheEntryHeader *>(entry_buf);
+    const char *data = entry_buf + sizeof(ObMicroBlockDiskCacheEntryHeader);
+    // the entry may have been overwritten by newer entries, the micro block checksum is also
+    // checked as the block read from data file
+    if (get_entry_size(size) != entry_size
+        || !header.is_valid()
+        || header.lsn_ != lsn
+        || !is_same_key(header, key)
+        || header.data_checksum_ != static_cast<int64_t>(ob_crc64(data, size))
+        || OB_SUCCESS != ObMicroBlockHeader::deserialize_and_check_record(data, size, MICRO_BLOCK_HEADER_MAGIC)) {
+      ret = OB_ENTRY_NOT_EXIST;
+      LOG_DEBUG("micro block disk cache entry is no longer valid", K(key), K(lsn), K(entry_size), K(header));
+      EVENT_INC(ObStatEventIds::MICRO_BLOCK_DISK_CACHE_MISS);
+      erase(key.hash(), lsn);
+    } else {
+      des_meta.compressor_type_ = static_cast<ObCompressorType>(header.compressor_type_);
+      des_meta.row_store_type_ = static_cast<ObRowStoreType>(header.row_store_type_);
+      des_meta.encrypt_id_ = 0;
+      des_meta.master_key_id_ = 0;
+      des_meta.encrypt_key_ = nullptr;
+      block_buf = data;
+      EVENT_INC(ObStatEventIds::MICRO_BLOCK_DISK_CACHE_HIT);
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::put(
+    const ObMicroBlockCacheKey &key,
+    const ObMicroBlockDesMeta &des_meta,
+    const char *buf)
+{
+  int ret = OB_SUCCESS;
+  const ObMicroBlockId &micro_id = key.get_micro_block_id();
+  int64_t lsn = 0;
+  void *ptr = nullptr;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("micro block disk cache not init", K(ret));
+  } else if (OB_ISNULL(buf) || OB_UNLIKELY(!micro_id.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key), KP(buf));
+  } else if (share::ObEncryptionUtil::need_encrypt(static_cast<ObCipherOpMode>(des_meta.encrypt_id_))) {
+    // never write decryptable blocks to local disk
+  } else if (OB_SUCCESS == index_.get_refactored(key.hash(), lsn)) {
+    // already cached
+  } else if (OB_ISNULL(ptr = ob_malloc(sizeof(FillTask) + micro_id.size_,
+                                       ObMemAttr(OB_SERVER_TENANT_ID, MICRO_BLOCK_DISK_CACHE_LABEL)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate fill task", K(ret), K(micro_id));
+  } else {
+    FillTask *task = new (ptr) FillTask();
+    ObMicroBlockDiskCacheEntryHeader &header = task->header_;
+    header.magic_ = ObMicroBlockDiskCacheEntryHeader::MAGIC;
+    header.version_ = ObMicroBlockDiskCacheEntryHeader::VERSION;
+    header.header_size_ = sizeof(ObMicroBlockDiskCacheEntryHeader);
+    header.tenant_id_ = key.get_tenant_id();
+    header.macro_first_id_ = micro_id.macro_id_.first_id();
+    header.macro_second_id_ = micro_id.macro_id_.second_id();
+    header.macro_third_id_ = micro_id.macro_id_.third_id();
+    header.offset_ = micro_id.offset_;
+    header.size_ = micro_id.size_;
+    header.compressor_type_ = des_meta.compressor_type_;
+    header.row_store_type_ = des_meta.row_store_type_;
+    MEMCPY(reinterpret_cast<char *>(task + 1), buf, micro_id.size_);
+    if (OB_FAIL(fill_queue_.push(task))) {
+      // fill thread is too busy, just drop it
+      free_task(task);
+      ret = OB_SUCCESS;
+    }
+  }
+  return ret;
+}
+
+void ObMicroBlockDiskCache::build_key(const ObMicroBlockDiskCacheEntryHeader &header, ObMicroBlockCacheKey &key)
+{
+  key.set(header.tenant_id_,
+          MacroBlockId(header.macro_first_id_, header.macro_second_id_, header.macro_third_id_),
+          header.offset_,
+          header.size_);
+}
+
+bool ObMicroBlockDiskCache::is_same_key(const ObMicroBlockDiskCacheEntryHeader &header, const ObMicroBlockCacheKey &key)
+{
+  const ObMicroBlockId &micro_id = key.get_micro_block_id();
+  return header.tenant_id_ == key.get_tenant_id()
+      && header.macro_first_id_ == micro_id.macro_id_.first_id()
+      && header.macro_second_id_ == micro_id.macro_id_.second_id()
+      && header.macro_third_id_ == micro_id.macro_id_.third_id()
+      && header.offset_ == micro_id.offset_
+      && header.size_ == micro_id.size_;
+}
+
+int ObMicroBlockDiskCache::read_file(char *buf, const int64_t size, const int64_t offset, int64_t &read_size)
+{
+  int ret = OB_SUCCESS;
+  read_size = 0;
+  while (OB_SUCC(ret) && read_size < size) {
+    const ssize_t sz = ::pread(fd_, buf + read_size, size - read_size, offset + read_size);
+    if (sz < 0) {
+      if (EINTR != errno) {
+        ret = OB_IO_ERROR;
+        LOG_WARN("fail to pread", K(ret), K_(fd), K(size), K(offset), K(errno), KERRMSG);
+      }
+    } else if (0 == sz) {
+      break;
+    } else {
+      read_size += sz;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::write_file(const char *buf, const int64_t size, const int64_t offset)
+{
+  int ret = OB_SUCCESS;
+  int64_t write_size = 0;
+  while (OB_SUCC(ret) && write_size < size) {
+    const ssize_t sz = ::pwrite(fd_, buf + write_size, size - write_size, offset + write_size);
+    if (sz <= 0) {
+      if (EINTR != errno) {
+        ret = OB_IO_ERROR;
+        LOG_WARN("fail to pwrite", K(ret), K_(fd), K(size), K(offset), K(errno), KERRMSG);
+      }
+    } else {
+      write_size += sz;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::read_super_block(ObMicroBlockDiskCacheSuperBlock &super_block)
+{
+  int ret = OB_SUCCESS;
+  int64_t read_size = 0;
+  if (OB_FAIL(read_file(reinterpret_cast<char *>(&super_block), sizeof(super_block), 0, read_size))) {
+    LOG_WARN("fail to read micro block disk cache super block", K(ret));
+  } else if (sizeof(super_block) != read_size || !super_block.is_valid()) {
+    // new cache file or the format is changed, nothing left in it can be trusted. The write
+    // seq of macro blocks starts from 1, so none of the entries is valid.
+    super_block.is_cleaning_ = true;
+    super_block.max_valid_write_seq_ = 0;
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::write_super_block(const int64_t max_valid_write_seq, const bool is_cleaning)
+{
+  int ret = OB_SUCCESS;
+  ObMicroBlockDiskCacheSuperBlock super_block;
+  super_block.magic_ = ObMicroBlockDiskCacheSuperBlock::MAGIC;
+  super_block.version_ = ObMicroBlockDiskCacheSuperBlock::VERSION;
+  super_block.is_cleaning_ = is_cleaning;
+  super_block.max_valid_write_seq_ = max_valid_write_seq;
+  super_block.checksum_ = super_block.calc_checksum();
+  if (OB_FAIL(write_file(reinterpret_cast<const char *>(&super_block), sizeof(super_block), 0))) {
+    LOG_WARN("fail to write micro block disk cache super block", K(ret), K(super_block));
+  } else if (0 != ::fdatasync(fd_)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("fail to sync micro block disk cache file", K(ret), K_(fd), K(errno), KERRMSG);
+  }
+  return ret;
+}
+
+// Scan the whole cache file and index all entries whose header is valid. Entries start at
+// ENTRY_ALIGN_SIZE aligned offsets, a newer entry may start in the middle of an older one,
+// so every aligned offset is checked. Entries of macro blocks above the restart write seq may
+// refer to a different block in this boot, their headers are zeroed before the super block
+// is marked clean.
+int ObMicroBlockDiskCache::recover()
+{
+  int ret = OB_SUCCESS;
+  const int64_t start_time = ObTimeUtility::current_time();
+  const int64_t max_valid_write_seq = ATOMIC_LOAD(&restart_write_seq_);
+  const int64_t buf_size = IO_BUF_SIZE;
+  int64_t max_end_lsn = 0;
+  int64_t recover_cnt = 0;
+  int64_t drop_cnt = 0;
+  for (int64_t pos = 0; OB_SUCC(ret) && pos < file_size_ && !has_set_stop(); pos += buf_size) {
+    const int64_t size = min(buf_size, file_size_ - pos);
+    int64_t read_size = 0;
+    if (OB_FAIL(read_file(io_buf_, size, SUPER_BLOCK_SIZE + pos, read_size))) {
+      LOG_WARN("fail to read micro block disk cache file", K(ret), K(pos), K(size));
+    }
+    for (int64_t off = 0; OB_SUCC(ret) && off + ENTRY_ALIGN_SIZE <= read_size; off += ENTRY_ALIGN_SIZE) {
+      ObMicroBlockDiskCacheEntryHeader &header =
+          *reinterpret_cast<ObMicroBlockDiskCacheEntryHeader *>(io_buf_ + off);
+      if (ObMicroBlockDiskCacheEntryHeader::MAGIC == header.magic_
+          && header.is_valid()
+          && pos + off == header.lsn_ % file_size_) {
+        const MacroBlockId macro_id(header.macro_first_id_, header.macro_second_id_, header.macro_third_id_);
+        ObMicroBlockCacheKey key;
+        int64_t lsn = 0;
+        build_key(header, key);
+        if (macro_id.write_seq() > max_valid_write_seq) {
+          MEMSET(&header, 0, sizeof(header));
+          if (OB_FAIL(write_file(io_buf_ + off, sizeof(header), SUPER_BLOCK_SIZE + pos + off))) {
+            LOG_WARN("fail to drop micro block disk cache entry", K(ret), K(pos), K(off));
+          } else {
+            ++drop_cnt;
+          }
+        } else if (OB_SUCCESS == index_.get_refactored(key.hash(), lsn) && lsn > header.lsn_) {
+        } else if (OB_FAIL(index_.set_refactored(key.hash(), header.lsn_, 1 /* overwrite */))) {
+          LOG_WARN("fail to set micro block disk cache index", K(ret), K(header));
+        } else {
+          ++recover_cnt;
+          max_end_lsn = max(max_end_lsn,
+              header.lsn_ + get_entry_align_size(header.header_size_ + header.size_));
+        }
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (has_set_stop()) {
+    // the super block is still cleaning, next boot scans again
+  } else if (OB_FAIL(write_super_block(max_valid_write_seq, false /* is_cleaning */))) {
+    LOG_WARN("fail to write micro block disk cache super block", K(ret), K(max_valid_write_seq));
+  } else {
+    write_lsn_ = max_end_lsn;
+    evict_lsn_ = max(0L, max_end_lsn - file_size_);
+    LOG_INFO("micro block disk cache recovered", K(*this), K(recover_cnt), K(drop_cnt),
+             "cost_us", ObTimeUtility::current_time() - start_time);
+  }
+  return ret;
+}
+
+int ObMicroBlockDiskCache::write_entry(FillTask &task)
+{
+  int ret = OB_SUCCESS;
+  ObMicroBlockDiskCacheEntryHeader &header = task.header_;
+  const int64_t entry_size = task.entry_size();
+  const int64_t align_size = get_entry_align_size(entry_size);
+  ObMicroBlockCacheKey key;
+  build_key(header, key);
+  if (align_size > file_size_ / 4) {
+    // too large to cache
+  } else {
+    if (write_lsn_ % file_size_ + align_size > file_size_) {
+      // entry never wraps around the end of file
+      write_lsn_ += file_size_ - write_lsn_ % file_size_;
+    }
+    evict(write_lsn_ + align_size);
+    header.lsn_ = write_lsn_;
+    header.data_checksum_ = static_cast<int64_t>(ob_crc64(reinterpret_cast<const char *>(&task + 1), header.size_));
+    header.header_checksum_ = header.calc_header_checksum();
+    if (OB_FAIL(write_file(reinterpret_cast<const char *>(&header), entry_size, get_file_offset(write_lsn_)))) {
+      LOG_WARN("fail to write micro block disk cache file", K(ret), K(header));
+    } else if (OB_FAIL(index_.set_refactored(key.hash(), write_lsn_, 1 /* overwrite */))) {
+      LOG_WARN("fail to set micro block disk cache index", K(ret), K(header));
+    }
+    write_lsn_ += align_size;
+  }
+  return ret;
+}
+
+// Remove entries of the last round which are going to be overwritten by [.., end_lsn).
+void ObMicroBlockDiskCache::evict(const int64_t end_lsn)
+{
+  int ret = OB_SUCCESS;
+  const int64_t target_lsn = end_lsn - file_size_;
+  const int64_t buf_size = IO_BUF_SIZE;
+  while (OB_SUCC(ret) && evict_lsn_ < target_lsn) {
+    const int64_t pos = evict_lsn_ % file_size_;
+    const int64_t size = min(min(target_lsn - evict_lsn_, file_size_ - pos), buf_size);
+    int64_t read_size = 0;
+    if (OB_FAIL(read_file(io_buf_, size, SUPER_BLOCK_SIZE + pos, read_size))) {
+      LOG_WARN("fail to read micro block disk cache file", K(ret), K(pos), K(size));
+    } else {
+      for (int64_t off = 0; off + ENTRY_ALIGN_SIZE <= read_size; off += ENTRY_ALIGN_SIZE) {
+        const ObMicroBlockDiskCacheEntryHeader &header =
+            *reinterpret_cast<const ObMicroBlockDiskCacheEntryHeader *>(io_buf_ + off);
+        if (ObMicroBlockDiskCacheEntryHeader::MAGIC == header.magic_
+            && header.is_valid()
+            && evict_lsn_ + off == header.lsn_) {
+          ObMicroBlockCacheKey key;
+          build_key(header, key);
+          erase(key.hash(), header.lsn_);
+        }
+      }
+    }
+    evict_lsn_ += size;
+  }
+  if (OB_FAIL(ret)) {
+    // stale index entries left are detected and removed on read
+    evict_lsn_ = max(evict_lsn_, target_lsn);
+  }
+}
+
+void ObMicroBlockDiskCache::erase(const uint64_t hash, const int64_t lsn)
+{
+  int ret = OB_SUCCESS;
+  bool is_erased = false;
+  EraseIfLsnOp op(lsn);
+  if (OB_FAIL(index_.erase_if(hash, op, is_erased))) {
+    if (OB_HASH_NOT_EXIST != ret) {
+      LOG_WARN("fail to erase micro block disk cache index", K(ret), K(hash), K(lsn));
+    }
+  }
+}
+
+void ObMicroBlockDiskCache::free_task(FillTask *task)
+{
+  if (nullptr != task) {
+    task->~FillTask();
+    ob_free(task);
+  }
+}
+
+}//end namespace blocksstable
+}//end namespace oceanbase
@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DISK_CACHE_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DISK_CACHE_H_
+
+#include "lib/hash/ob_hashmap.h"
+#include "lib/queue/ob_lighty_queue.h"
+#include "lib/utility/ob_utility.h"
+#include "share/io/ob_io_define.h"
+#include "share/ob_thread_pool.h"
+#include "storage/blocksstable/ob_block_sstable_struct.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+class ObMicroBlockCacheKey;
+
+// Stored at the beginning of the cache file, see ObMicroBlockDiskCache.
+struct ObMicroBlockDiskCacheSuperBlock
+{
+public:
+  static const int32_t MAGIC = 0x42534344; // "DCSB"
+  static const int16_t VERSION = 1;
+  ObMicroBlockDiskCacheSuperBlock() { MEMSET(this, 0, sizeof(*this)); }
+  int64_t calc_checksum() const;
+  bool is_valid() const;
+  TO_STRING_KV(K_(magic), K_(version), K_(is_cleaning), K_(max_valid_write_seq), K_(checksum));
+public:
+  int32_t magic_;
+  int16_t version_;
+  // entries of macro blocks with larger write seq may still be left in the file
+  int16_t is_cleaning_;
+  int64_t max_valid_write_seq_;
+  int64_t checksum_;
+};
+
+struct ObMicroBlockDiskCacheEntryHeader
+{
+public:
+  static const int32_t MAGIC = 0x4B4D4344; // "DCMK"
+  static const int16_t VERSION = 3;
+  ObMicroBlockDiskCacheEntryHeader() { MEMSET(this, 0, sizeof(*this)); }
+  int64_t calc_header_checksum() const;
+  bool is_valid() const;
+  TO_STRING_KV(K_(magic), K_(version), K_(lsn), K_(tenant_id), K_(macro_first_id),
+      K_(macro_second_id), K_(macro_third_id), K_(offset), K_(size), K_(compressor_type),
+      K_(row_store_type), K_(data_checksum), K_(header_checksum));
+public:
+  int32_t magic_;
+  int16_t version_;
+  int16_t header_size_;
+  int64_t lsn_;
+  uint64_t tenant_id_;
+  int64_t macro_first_id_;
+  int64_t macro_second_id_;
+  int64_t macro_third_id_;
+  int32_t offset_;
+  int32_t size_;
+  int32_t compressor_type_;
+  int32_t row_store_type_;
+  int64_t data_checksum_;
+  int64_t header_checksum_;
+};
+
+// Second tier of the data and index micro block caches on a local disk directory.
+//
+// Raw micro blocks read from the data file are appended to one cache file used as a ring,
+// the oldest blocks are overwritten first. Each entry is an ObMicroBlockDiskCacheEntryHeader
+// followed by the raw block, the in-memory index only maps the key hash to the logical
+// position (lsn) of the entry, whose physical offset is SUPER_BLOCK_SIZE + lsn % ring size.
+// The header carries the whole key and the entry checksum, and the raw block keeps its own
+// micro block checksum, so hash collisions, overwritten and corrupted entries are detected
+// on read and treated as misses.
+//
+// The cache survives restart, the index is rebuilt from the entry headers of the cache file.
+// An entry is identified by the macro block id, whose write seq is never reused within one
+// boot. After restart the block manager continues the write seq from the largest one of the
+// blocks still in use, so a freed block with a larger write seq may get the same id again.
+// Recovery waits for that write seq, see set_restart_write_seq(), and zeroes the headers of all
+// entries above it. The super block keeps the bound until the cleaning is done, so a restart
+// in the middle of recovery still drops them.
+//
+// Blocks are written by a background thread, put() only copies the block to the fill queue
+// and drops it if the queue is full. Cached blocks are read by the io manager into the io
+// callback of the prefetch, see async_get(). Encrypted blocks are never written to the cache file.
+class ObMicroBlockDiskCache : public share::ObThreadPool
+{
+public:
+  static const int64_t ENTRY_ALIGN_SIZE = 512;
+  static const int64_t SUPER_BLOCK_SIZE = DIO_READ_ALIGN_SIZE;
+  static const int64_t MIN_CACHE_FILE_SIZE = 64L << 20; // 64MB
+  static const int64_t FILL_QUEUE_SIZE = 1024;
+  static const int64_t FILL_WAIT_TIMEOUT_US = 100 * 1000; // 100ms
+  static const int64_t IO_BUF_SIZE = 2L << 20; // 2MB
+public:
+  static ObMicroBlockDiskCache &get_instance();
+  // disabled if %dir is empty or %cache_size is 0
+  int init(const char *dir, const int64_t cache_size);
+  int start();
+  void stop();
+  void wait();
+  void destroy();
+  virtual void run1() override;
+  OB_INLINE bool is_enabled() const { return is_inited_; }
+
+  // called by the block manager after restart, recovery of the cache file starts after it
+  void set_restart_write_seq(const int64_t write_seq);
+  // issue an async read of the entry of %key to %io_handle, the entry is passed to %callback.
+  // return OB_ENTRY_NOT_EXIST if the block is not cached.
+  int async_get(
+      const ObMicroBlockCacheKey &key,
+      const common::ObIOFlag &io_desc,
+      const int64_t timeout_us,
+      common::ObIOCallback *callback,
+      common::ObIOHandle &io_handle,
+      int64_t &lsn);
+  // check the entry read at %lsn by async_get(), output the raw micro block in it.
+  // return OB_ENTRY_NOT_EXIST and remove it from index if the entry is no longer valid.
+  int check_entry(
+      const ObMicroBlockCacheKey &key,
+      const int64_t lsn,
+      const char *entry_buf,
+      const int64_t entry_size,
+      ObMicroBlockDesMeta &des_meta,
+      const char *&block_buf);
+  // add the raw micro block to the fill queue
+  int put(
+      const ObMicroBlockCacheKey &key,
+      const ObMicroBlockDesMeta &des_meta,
+      const char *buf);
+  static int64_t get_entry_size(const int64_t block_size)
+  { return sizeof(ObMicroBlockDiskCacheEntryHeader) + block_size; }
+  TO_STRING_KV(K_(is_inited), K_(fd), K_(aio_fd), K_(file_size), K_(restart_write_seq),
+      K_(write_lsn), K_(evict_lsn),
+      "entry_count", index_.size(), "fill_queue_size", fill_queue_.size());
+private:
+  struct FillTask
+  {
+    int64_t entry_size() const { return header_.header_size_ + header_.size_; }
+    ObMicroBlockDiskCacheEntryHeader header_;
+    // raw micro block follows
+  };
+  struct EraseIfLsnOp
+  {
+    explicit EraseIfLsnOp(const int64_t lsn) : lsn_(lsn) {}
+    bool operator()(common::hash::HashMapPair<uint64_t, int64_t> &entry)
+    {
+      return entry.second == lsn_;
+    }
+    int64_t lsn_;
+  };
+  typedef common::hash::ObHashMap<uint64_t, int64_t> EntryIndex;
+
+  ObMicroBlockDiskCache();
+  virtual ~ObMicroBlockDiskCache();
+  static void build_key(const ObMicroBlockDiskCacheEntryHeader &header, ObMicroBlockCacheKey &key);
+  static bool is_same_key(const ObMicroBlockDiskCacheEntryHeader &header, const ObMicroBlockCacheKey &key);
+  static int64_t get_entry_align_size(const int64_t entry_size)
+  { return common::upper_align(entry_size, ENTRY_ALIGN_SIZE); }
+  OB_INLINE int64_t get_file_offset(const int64_t lsn) const
+  { return SUPER_BLOCK_SIZE + lsn % file_size_; }
+  int read_file(char *buf, const int64_t size, const int64_t offset, int64_t &read_size);
+  int write_file(const char *buf, const int64_t size, const int64_t offset);
+  int read_super_block(ObMicroBlockDiskCacheSuperBlock &super_block);
+  int write_super_block(const int64_t max_valid_write_seq, const bool is_cleaning);
+  int recover();
+  int write_entry(FillTask &task);
+  void evict(const int64_t end_lsn);
+  void erase(const uint64_t hash, const int64_t lsn);
+  void free_task(FillTask *task);
+private:
+  bool is_inited_;
+  int fd_;
+  // O_DIRECT fd of the cache file for the io manager
+  common::ObIOFd aio_fd_;
+  // size of the ring after the super block
+  int64_t file_size_;
+  // set by the block manager, -1 before that
+  int64_t restart_write_seq_;
+  // next lsn to write, only accessed by the fill thread after recovery
+  int64_t write_lsn_;
+  // entries before evict_lsn_ in the last round have been removed from the index
+  int64_t evict_lsn_;
+  EntryIndex index_;
+  common::ObLightyQueue fill_queue_;
+  // buffer to read entry headers, only used by the fill thread
+  char *io_buf_;
+  char path_[common::OB_MAX_FILE_NAME_LENGTH];
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockDiskCache);
+};
+
+}//end namespace blocksstable
+}//end namespace oceanbase
+
+#endif //OCEANBASE_STORAGE_BLOCKSSTABLE_OB_MICRO_BLOCK_DISK_CACHE_H_
@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "storage/blocksstable/ob_micro_block_encode_pool.h"
+#include "storage/blocksstable/ob_macro_block_writer.h"
+#include "share/ob_thread_mgr.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+int ObTenantMicroBlockEncodePool::mtl_init(ObTenantMicroBlockEncodePool *&encode_pool)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(encode_pool)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("encode pool is null", K(ret));
+  } else if (OB_FAIL(encode_pool->init())) {
+    LOG_WARN("fail to init micro block encode pool", K(ret));
+  }
+  return ret;
+}
+
+ObTenantMicroBlockEncodePool::ObTenantMicroBlockEncodePool()
+  : lock_(),
+    tg_id_(-1),
+    thread_cnt_(0),
+    is_started_(false),
+    is_stopped_(false),
+    is_inited_(false)
+{
+}
+
+ObTenantMicroBlockEncodePool::~ObTenantMicroBlockEncodePool()
+{
+  destroy();
+}
+
+int ObTenantMicroBlockEncodePool::init()
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_FAIL(TG_CREATE_TENANT(lib::TGDefIDs::MicroBlkEncode, tg_id_))) {
+    LOG_WARN("fail to create micro block encode thread", K(ret));
+  } else {
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+void ObTenantMicroBlockEncodePool::stop()
+{
+  lib::ObMutexGuard guard(lock_);
+  if (is_started_) {
+    TG_STOP(tg_id_);
+  }
+}
+
+void ObTenantMicroBlockEncodePool::wait()
+{
+  lib::ObMutexGuard guard(lock_);
+  if (is_started_) {
+    // the tasks left in queue are encoded before the threads exit
+    TG_WAIT(tg_id_);
+    is_started_ = false;
+  }
+  ATOMIC_STORE(&thread_cnt_, 0);
+  ATOMIC_STORE(&is_stopped_, true);
+}
+
+void ObTenantMicroBlockEncodePool::destroy()
+{
+  if (-1 != tg_id_) {
+    TG_DESTROY(tg_id_);
+    tg_id_ = -1;
+  }
+  thread_cnt_ = 0;
+  is_started_ = false;
+  is_inited_ = false;
+}
+
+int ObTenantMicroBlockEncodePool::adjust_thread_cnt(const int64_t thread_cnt)
+{
+  int ret = OB_SUCCESS;
+  const int64_t new_thread_cnt = MIN(thread_cnt, MAX_THREAD_CNT);
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (new_thread_cnt <= 0 || new_thread_cnt == get_thread_cnt()) {
+  } else {
+    lib::ObMutexGuard guard(lock_);
+    if (is_stopped()) {
+    } else if (!is_started_) {
+      if (OB_FAIL(TG_SET_HANDLER_AND_START(tg_id_, *this))) {
+        LOG_WARN("fail to start micro block encode thread", K(ret), K_(tg_id));
+      } else {
+        is_started_ = true;
+      }
+    }
+    if (OB_FAIL(ret) || !is_started_) {
+    } else if (OB_FAIL(TG_SET_THREAD_CNT(tg_id_, new_thread_cnt))) {
+      LOG_WARN("fail to set micro block encode thread count", K(ret), K(new_thread_cnt));
+    } else {
+      LOG_INFO("micro block encode thread count changed", K(thread_cnt_), K(new_thread_cnt));
+      ATOMIC_STORE(&thread_cnt_, new_thread_cnt);
+    }
+  }
+  return ret;
+}
+
+int ObTenantMicroBlockEncodePool::push_task(ObMicroBlockEncodeTask &task)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(get_thread_cnt() <= 0 || is_stopped())) {
+    ret = OB_IN_STOP_STATE;
+  } else if (OB_FAIL(TG_PUSH_TASK(tg_id_, &task))) {
+    if (OB_EAGAIN != ret && OB_IN_STOP_STATE != ret) {
+      LOG_WARN("fail to push micro block encode task", K(ret), K_(tg_id));
+    }
+  }
+  return ret;
+}
+
+void ObTenantMicroBlockEncodePool::handle(void *task)
+{
+  if (OB_NOT_NULL(task)) {
+    ObMicroBlockEncodeTask *encode_task = static_cast<ObMicroBlockEncodeTask *>(task);
+    encode_task->pipeline_->handle_queued_task(*encode_task);
+  }
+}
+
+} // namespace blocksstable
+} // namespace oceanbase
@@ -0,0 +1,60 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODE_POOL_H_
+#define OCEANBASE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODE_POOL_H_
+
+#include "lib/thread/thread_mgr_interface.h"
+#include "lib/lock/ob_mutex.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+struct ObMicroBlockEncodeTask;
+
+// Threads of a tenant shared by the micro block encode pipelines of all its macro block writers.
+// The threads are started by the first pipeline and resized by _micro_block_encode_parallel_degree.
+// The task queue is bounded, a task failed to push is encoded by the merge thread itself.
+class ObTenantMicroBlockEncodePool : public lib::TGTaskHandler
+{
+public:
+  static const int64_t MAX_THREAD_CNT = 16;
+  static int mtl_init(ObTenantMicroBlockEncodePool *&encode_pool);
+  ObTenantMicroBlockEncodePool();
+  virtual ~ObTenantMicroBlockEncodePool();
+  int init();
+  void stop();
+  void wait();
+  void destroy();
+  // start or resize the threads, do nothing if %thread_cnt is not positive
+  int adjust_thread_cnt(const int64_t thread_cnt);
+  int push_task(ObMicroBlockEncodeTask &task);
+  virtual void handle(void *task) override;
+  // no task pushed before is touched by the threads any more
+  OB_INLINE bool is_stopped() const { return ATOMIC_LOAD(&is_stopped_); }
+  OB_INLINE int64_t get_thread_cnt() const { return ATOMIC_LOAD(&thread_cnt_); }
+  TO_STRING_KV(K_(tg_id), K_(thread_cnt), K_(is_started), K_(is_stopped), K_(is_inited));
+private:
+  lib::ObMutex lock_;
+  int tg_id_;
+  int64_t thread_cnt_;
+  bool is_started_;
+  bool is_stopped_;
+  bool is_inited_;
+  DISALLOW_COPY_AND_ASSIGN(ObTenantMicroBlockEncodePool);
+};
+
+} // namespace blocksstable
+} // namespace oceanbase
+
+#endif // OCEANBASE_BLOCKSSTABLE_OB_MICRO_BLOCK_ENCODE_POOL_H_
@@ -0,0 +1,174 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_rowkey_bloom_filter.h"
+#include "lib/utility/serialization.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace blocksstable
+{
+
+int ObRowkeyBloomFilter::prepare(const int64_t row_count, ObIArray<uint64_t> &words)
+{
+  int ret = OB_SUCCESS;
+  words.reset();
+  if (OB_UNLIKELY(row_count <= 0 || row_count > MAX_ROW_COUNT)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(row_count));
+  } else {
+    const int64_t word_cnt = (row_count * BITS_PER_KEY + 63) / 64;
+    if (OB_FAIL(words.reserve(word_cnt))) {
+      LOG_WARN("failed to reserve words", K(ret), K(word_cnt));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < word_cnt; ++i) {
+      if (OB_FAIL(words.push_back(0))) {
+        LOG_WARN("failed to push back word", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObRowkeyBloomFilter::init(const ObIArray<uint64_t> &words, ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  const int64_t size = words.count() * static_cast<int64_t>(sizeof(uint64_t));
+  char *buf = nullptr;
+  reset();
+  if (OB_UNLIKELY(words.empty() || size > MAX_FILTER_SIZE)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), "word_cnt", words.count());
+  } else if (OB_ISNULL(buf = static_cast<char *>(allocator.alloc(size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc filter bits", K(ret), K(size));
+  } else {
+    for (int64_t i = 0; i < words.count(); ++i) {
+      const uint64_t word = words.at(i);
+      MEMCPY(buf + i * sizeof(uint64_t), &word, sizeof(uint64_t));
+    }
+    bits_ = buf;
+    word_cnt_ = words.count();
+  }
+  return ret;
+}
+
+void ObRowkeyBloomFilter::batch_may_contain(
+    const uint64_t *hashes,
+    const int64_t count,
+    bool *results) const
+{
+  // compute all the word positions and prefetch them first, so the cache misses of the probes
+  // in one batch overlap instead of being serialized
+  int64_t idxs[BATCH_SIZE];
+  uint64_t masks[BATCH_SIZE];
+  const int64_t batch_cnt = MIN(count, BATCH_SIZE);
+  for (int64_t i = 0; i < batch_cnt; ++i) {
+    const uint64_t h = mix(hashes[i]);
+    idxs[i] = get_word_idx(h);
+    masks[i] = get_word_mask(h);
+    __builtin_prefetch(bits_ + idxs[i] * sizeof(uint64_t));
+  }
+  for (int64_t i = 0; i < batch_cnt; ++i) {
+    results[i] = masks[i] == (get_word(idxs[i]) & masks[i]);
+  }
+}
+
+int ObRowkeyBloomFilter::serialize(char *buf, const int64_t buf_len, int64_t &pos) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t serialize_size = get_serialize_size();
+  if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected invalid rowkey bloom filter to serialize", K(ret), KPC(this));
+  } else if (OB_UNLIKELY(serialize_size > buf_len - pos)) {
+    ret = OB_SIZE_OVERFLOW;
+    LOG_WARN("rowkey bloom filter serialize size overflow", K(ret), K(serialize_size), K(buf_len), K(pos));
+  } else if (OB_FAIL(serialization::encode_vi64(buf, buf_len, pos, ROWKEY_BLOOM_FILTER_VERSION))) {
+    LOG_WARN("failed to encode version", K(ret), K(buf_len), K(pos));
+  } else if (OB_FAIL(serialization::encode_vstr(buf, buf_len, pos, bits_, get_variable_size()))) {
+    LOG_WARN("failed to encode bits", K(ret), K(buf_len), K(pos), KPC(this));
+  }
+  return ret;
+}
+
+int ObRowkeyBloomFilter::deserialize(
+    ObIAllocator &allocator,
+    const char *buf,
+    const int64_t data_len,
+    int64_t &pos)
+{
+  int ret = OB_SUCCESS;
+  int64_t version = 0;
+  int64_t size = 0;
+  const char *bits = nullptr;
+  char *dst = nullptr;
+  reset();
+  if (OB_ISNULL(buf) || OB_UNLIKELY(data_len <= pos)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(data_len), K(pos));
+  } else if (OB_FAIL(serialization::decode_vi64(buf, data_len, pos, &version))) {
+    LOG_WARN("failed to decode version", K(ret), K(data_len), K(pos));
+  } else if (OB_UNLIKELY(ROWKEY_BLOOM_FILTER_VERSION != version)) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("unexpected rowkey bloom filter version", K(ret), K(version));
+  } else if (OB_ISNULL(bits = serialization::decode_vstr(buf, data_len, pos, &size))) {
+    ret = OB_DESERIALIZE_ERROR;
+    LOG_WARN("failed to decode bits", K(ret), K(data_len), K(pos));
+  } else if (OB_UNLIKELY(size <= 0 || size > MAX_FILTER_SIZE || 0 != size % sizeof(uint64_t))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected rowkey bloom filter size", K(ret), K(size));
+  } else if (OB_ISNULL(dst = static_cast<char *>(allocator.alloc(size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc filter bits", K(ret), K(size));
+  } else {
+    MEMCPY(dst, bits, size);
+    bits_ = dst;
+    word_cnt_ = size / static_cast<int64_t>(sizeof(uint64_t));
+  }
+  return ret;
+}
+
+int64_t ObRowkeyBloomFilter::get_serialize_size() const
+{
+  return serialization::encoded_length_vi64(ROWKEY_BLOOM_FILTER_VERSION)
+      + serialization::encoded_length_vstr(get_variable_size());
+}
+
+int ObRowkeyBloomFilter::deep_copy(
+    char *buf,
+    const int64_t buf_len,
+    int64_t &pos,
+    ObRowkeyBloomFilter &dest) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t size = get_variable_size();
+  dest.reset();
+  if (!is_valid()) {
+    // empty filter, nothing to copy
+  } else if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len - pos < size)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(buf_len), K(pos), K(size));
+  } else {
+    MEMCPY(buf + pos, bits_, size);
+    dest.bits_ = buf + pos;
+    dest.word_cnt_ = word_cnt_;
+    pos += size;
+  }
+  return ret;
+}
+
+} // namespace blocksstable
+} // namespace oceanbase
@@ -0,0 +1,106 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_BLOCKSSTABLE_OB_ROWKEY_BLOOM_FILTER_H_
+#define OCEANBASE_BLOCKSSTABLE_OB_ROWKEY_BLOOM_FILTER_H_
+
+#include "lib/allocator/ob_allocator.h"
+#include "lib/container/ob_iarray.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// Rowkey bloom filter of a whole sstable, built by the macro block writers during merge and
+// persisted in the sstable meta.
+//
+// The filter is register blocked: one 64-bit word is selected by the hash of the rowkey and
+// HASH_BIT_COUNT bits are set in it, so a probe touches a single word. The hash is the
+// murmurhash of the schema rowkey, the same one used by ObBloomFilterCache. The filter stays
+// in memory with the sstable meta, so it is kept small: sstables with more than MAX_ROW_COUNT
+// rows have no filter here. They are covered by the bloom filter of each data macro block,
+// which ObMacroBlockWriter puts into ObBloomFilterCache when the macro block is flushed.
+class ObRowkeyBloomFilter final
+{
+public:
+  static const int64_t BITS_PER_KEY = 12;
+  static const int64_t HASH_BIT_COUNT = 5;
+  static const int64_t MAX_FILTER_SIZE = 64L << 10; // 64KB
+  static const int64_t MAX_ROW_COUNT = MAX_FILTER_SIZE * 8 / BITS_PER_KEY;
+  static const int64_t BATCH_SIZE = 16;
+public:
+  ObRowkeyBloomFilter() : bits_(nullptr), word_cnt_(0) {}
+  ~ObRowkeyBloomFilter() = default;
+  void reset() { bits_ = nullptr; word_cnt_ = 0; }
+  OB_INLINE bool is_valid() const { return nullptr != bits_ && word_cnt_ > 0; }
+  // filter words are built by prepare() for %row_count rowkeys and add() of every rowkey hash
+  static int prepare(const int64_t row_count, common::ObIArray<uint64_t> &words);
+  static OB_INLINE void add(const uint64_t hash, common::ObIArray<uint64_t> &words)
+  {
+    const uint64_t h = mix(hash);
+    words.at((h >> 32) % words.count()) |= get_word_mask(h);
+  }
+  int init(const common::ObIArray<uint64_t> &words, common::ObIAllocator &allocator);
+  OB_INLINE bool may_contain(const uint64_t hash) const
+  {
+    const uint64_t h = mix(hash);
+    const uint64_t mask = get_word_mask(h);
+    return mask == (get_word(get_word_idx(h)) & mask);
+  }
+  // %results[i] is false if %hashes[i] is not in the filter, %count should not be larger than
+  // BATCH_SIZE
+  void batch_may_contain(const uint64_t *hashes, const int64_t count, bool *results) const;
+
+  int serialize(char *buf, const int64_t buf_len, int64_t &pos) const;
+  int deserialize(common::ObIAllocator &allocator, const char *buf, const int64_t data_len, int64_t &pos);
+  int64_t get_serialize_size() const;
+  int64_t get_variable_size() const { return word_cnt_ * static_cast<int64_t>(sizeof(uint64_t)); }
+  int deep_copy(char *buf, const int64_t buf_len, int64_t &pos, ObRowkeyBloomFilter &dest) const;
+  TO_STRING_KV(KP_(bits), K_(word_cnt));
+private:
+  static OB_INLINE uint64_t mix(uint64_t hash)
+  {
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    hash *= 0xC4CEB9FE1A85EC53ULL;
+    hash ^= hash >> 33;
+    return hash;
+  }
+  static OB_INLINE uint64_t get_word_mask(const uint64_t hash)
+  {
+    uint64_t mask = 0;
+    for (int64_t i = 0; i < HASH_BIT_COUNT; ++i) {
+      mask |= 1ULL << ((hash >> (i * 6)) & 63);
+    }
+    return mask;
+  }
+  OB_INLINE int64_t get_word_idx(const uint64_t hash) const { return (hash >> 32) % word_cnt_; }
+  OB_INLINE uint64_t get_word(const int64_t idx) const
+  {
+    // the filter deep copied into the sstable meta buffer may be unaligned
+    uint64_t word = 0;
+    MEMCPY(&word, bits_ + idx * sizeof(uint64_t), sizeof(uint64_t));
+    return word;
+  }
+private:
+  static const int64_t ROWKEY_BLOOM_FILTER_VERSION = 1;
+  const char *bits_;
+  int64_t word_cnt_;
+};
+
+} // namespace blocksstable
+} // namespace oceanbase
+
+#endif // OCEANBASE_BLOCKSSTABLE_OB_ROWKEY_BLOOM_FILTER_H_
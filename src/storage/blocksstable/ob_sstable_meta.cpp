@@ -381,6 +381,7 @@ ObSSTableMeta::ObSSTableMeta()
     macro_info_(),
     column_checksums_(nullptr),
     column_checksum_count_(0),
+    rowkey_bloom_filter_(),
     is_inited_(false)
 {
 }
@@ -413,6 +414,7 @@ void ObSSTableMeta::reset()
   basic_meta_.reset();
   column_checksums_ = nullptr;
   column_checksum_count_ = 0;
+  rowkey_bloom_filter_.reset();
   is_inited_ = false;
 }
 
@@ -461,6 +463,9 @@ int ObSSTableMeta::init_base_meta(
     basic_meta_.length_ = basic_meta_.get_serialize_size();
     if (OB_FAIL(prepare_column_checksum(param.column_checksums_, allocator))) {
       LOG_WARN("fail to prepare column checksum", K(ret), K(param));
+    } else if (!param.rowkey_bloom_filter_.empty()
+        && OB_FAIL(rowkey_bloom_filter_.init(param.rowkey_bloom_filter_, allocator))) {
+      LOG_WARN("fail to init rowkey bloom filter", K(ret), K(param));
     }
   }
   return ret;
@@ -584,6 +589,9 @@ int ObSSTableMeta::serialize_(char *buf, const int64_t buf_len, int64_t &pos) co
       LOG_WARN("fail to serialize data root info", K(ret), K(buf_len), K(pos), K(data_root_info_));
     } else if (OB_FAIL(macro_info_.serialize(buf, buf_len, pos))) {
       LOG_WARN("fail to serialize macro info", K(ret), K(buf_len), K(pos), K(macro_info_));
+    } else if (rowkey_bloom_filter_.is_valid()
+        && OB_FAIL(rowkey_bloom_filter_.serialize(buf, buf_len, pos))) {
+      LOG_WARN("fail to serialize rowkey bloom filter", K(ret), K(buf_len), K(pos), K(rowkey_bloom_filter_));
     }
   }
   return ret;
@@ -612,7 +620,10 @@ int ObSSTableMeta::deserialize(
     } else if (OB_UNLIKELY(version != SSTABLE_META_VERSION)) {
       ret = OB_NOT_SUPPORTED;
       LOG_WARN("object version mismatch", K(ret), K(version));
-    } else if (OB_FAIL(deserialize_(allocator, buf + pos, data_len, tmp_pos))) {
+    } else if (OB_UNLIKELY(len > data_len - pos)) {
+      ret = OB_DESERIALIZE_ERROR;
+      LOG_WARN("sstable meta length overflow", K(ret), K(len), K(data_len), K(pos));
+    } else if (OB_FAIL(deserialize_(allocator, buf + pos, len, tmp_pos))) {
       LOG_WARN("fail to deserialize_", K(ret), K(data_len), K(tmp_pos), K(pos));
     } else if (OB_UNLIKELY(len != tmp_pos)) {
       ret = OB_ERR_UNEXPECTED;
@@ -657,6 +668,8 @@ int ObSSTableMeta::deserialize_(
       LOG_WARN("fail to deserialize data root info", K(ret), K(data_len), K(pos), K(des_meta));
     } else if (OB_FAIL(macro_info_.deserialize(allocator, des_meta, buf, data_len, pos))) {
       LOG_WARN("fail to deserialize macro info", K(ret), K(data_len), K(pos), K(des_meta));
+    } else if (pos < data_len && OB_FAIL(rowkey_bloom_filter_.deserialize(allocator, buf, data_len, pos))) {
+      LOG_WARN("fail to deserialize rowkey bloom filter", K(ret), K(data_len), K(pos));
     }
   }
   return ret;
@@ -680,6 +693,9 @@ int64_t ObSSTableMeta::get_serialize_size_() const
   OB_UNIS_ADD_LEN_ARRAY(column_checksums_, column_checksum_count_);
   len += data_root_info_.get_serialize_size();
   len += macro_info_.get_serialize_size();
+  if (rowkey_bloom_filter_.is_valid()) {
+    len += rowkey_bloom_filter_.get_serialize_size();
+  }
   return len;
 }
 
@@ -687,7 +703,8 @@ int64_t ObSSTableMeta::get_variable_size() const
 {
   return sizeof(int64_t) * column_checksum_count_ // column checksums
        + data_root_info_.get_variable_size()
-       + macro_info_.get_variable_size();
+       + macro_info_.get_variable_size()
+       + rowkey_bloom_filter_.get_variable_size();
 }
 
 int ObSSTableMeta::deep_copy(
@@ -715,6 +732,8 @@ int ObSSTableMeta::deep_copy(
       LOG_WARN("fail to deep copy data root info", K(ret), KP(buf), K(buf_len), K(pos), K(data_root_info_));
     } else if (OB_FAIL(macro_info_.deep_copy(buf, buf_len, pos, dest->macro_info_))) {
       LOG_WARN("fail to deep copy macro info", K(ret), KP(buf), K(buf_len), K(pos), K(macro_info_));
+    } else if (OB_FAIL(rowkey_bloom_filter_.deep_copy(buf, buf_len, pos, dest->rowkey_bloom_filter_))) {
+      LOG_WARN("fail to deep copy rowkey bloom filter", K(ret), KP(buf), K(buf_len), K(pos), K(rowkey_bloom_filter_));
     } else {
       dest->is_inited_ = is_inited_;
     }
@@ -17,6 +17,7 @@
 #include "storage/ob_storage_schema.h"
 #include "storage/ob_i_table.h"
 #include "storage/blocksstable/index_block/ob_sstable_meta_info.h"
+#include "storage/blocksstable/ob_rowkey_bloom_filter.h"
 #include "share/scn.h"
 
 namespace oceanbase
@@ -216,6 +217,7 @@ public:
   OB_INLINE int64_t get_progressive_merge_step() const { return basic_meta_.progressive_merge_step_; }
   OB_INLINE const ObRootBlockInfo &get_root_info() const { return data_root_info_; }
   OB_INLINE const ObSSTableMacroInfo &get_macro_info() const { return macro_info_; }
+  OB_INLINE const ObRowkeyBloomFilter &get_rowkey_bloom_filter() const { return rowkey_bloom_filter_; }
   int load_root_block_data(common::ObArenaAllocator &allocator); //TODO:@jinzhu remove me after using kv cache.
   inline int transform_root_block_extra_buf(common::ObArenaAllocator &allocator)
   {
@@ -238,7 +240,8 @@ public:
       const int64_t buf_len,
       int64_t &pos,
       ObSSTableMeta *&dest) const;
-  TO_STRING_KV(K_(basic_meta), KP_(column_checksums), K_(column_checksum_count), K_(data_root_info), K_(macro_info));
+  TO_STRING_KV(K_(basic_meta), KP_(column_checksums), K_(column_checksum_count), K_(data_root_info), K_(macro_info),
+      K_(rowkey_bloom_filter));
 private:
   bool check_meta() const;
   int init_base_meta(const ObTabletCreateSSTableParam &param, common::ObArenaAllocator &allocator);
@@ -264,6 +267,8 @@ private:
   ObSSTableMacroInfo macro_info_;
   int64_t *column_checksums_;
   int64_t column_checksum_count_;
+  // only serialized if valid, absent in the meta of old sstables
+  ObRowkeyBloomFilter rowkey_bloom_filter_;
   // The following fields don't to persist
   bool is_inited_;
   DISALLOW_COPY_AND_ASSIGN(ObSSTableMeta);
@@ -372,8 +372,8 @@ int ObCGPrefetcher::prefetch_micro_data()
             } else {
               LOG_DEBUG("[COLUMNSTORE] success to agg index info", K(ret), K(block_info));
             }
-          } else if (OB_FAIL(prefetch_block_data(block_info, micro_data_handles_[prefetch_micro_idx]))) {
-            LOG_WARN("fail to prefetch_block_data", K(ret), K(block_info));
+          } else if (OB_FAIL(prefetch_data_block(block_info, micro_data_handles_[prefetch_micro_idx]))) {
+            LOG_WARN("fail to prefetch data block", K(ret), K(block_info));
           } else {
             prefetched_cnt++;
             micro_data_prefetch_idx_++;
@@ -400,6 +400,13 @@ int ObCGPrefetcher::prefetch_micro_data()
         prefetched_cnt = 0;
       }
     }
+    if ((OB_SUCC(ret) || OB_ITER_END == ret) && !read_ahead_index_infos_.empty()) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_TMP_FAIL(submit_read_ahead_io())) {
+        LOG_WARN("Fail to submit read ahead io", K(tmp_ret));
+        ret = tmp_ret;
+      }
+    }
   }
   LOG_DEBUG("[INDEX BLOCK] prefetched info", K(ret),  KPC(this));
   return ret;
@@ -630,7 +637,7 @@ int ObCGPrefetcher::get_prefetch_depth(int64_t &depth)
 {
   int ret = OB_SUCCESS;
   depth = 0;
-  prefetch_depth_ = MIN(2 * prefetch_depth_, DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT);
+  update_prefetch_depth(micro_data_prefetch_idx_ - cur_micro_data_read_idx_ - 1);
   depth = min(static_cast<int64_t>(prefetch_depth_),
               max_micro_handle_cnt_ - (micro_data_prefetch_idx_ - cur_micro_data_read_idx_));
   return ret;
@@ -16,6 +16,7 @@ namespace oceanbase
 namespace blocksstable
 {
 class ObSSTable;
+struct ObMacroBlockDesc;
 }
 namespace compaction
 {
@@ -150,6 +151,15 @@ public:
     }
     return ret;
   }
+  OB_INLINE int check_filter_macro_block(const blocksstable::ObMacroBlockDesc &macro_desc, bool &need_filter)
+  {
+    int ret = OB_SUCCESS;
+    need_filter = false;
+    if (OB_NOT_NULL(info_collector_.compaction_filter_)) {
+      ret = info_collector_.compaction_filter_->check_filter_macro_block(macro_desc, need_filter);
+    }
+    return ret;
+  }
   /* FINISH SECTION */
   virtual int update_tablet(
     const blocksstable::ObSSTable &sstable,
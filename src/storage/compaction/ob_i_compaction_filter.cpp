@@ -14,6 +14,10 @@
 
 #include "ob_i_compaction_filter.h"
 #include "storage/ob_i_store.h"
+#include "storage/ob_storage_schema.h"
+#include "storage/blocksstable/index_block/ob_index_block_macro_iterator.h"
+#include "storage/blocksstable/index_block/ob_agg_row_struct.h"
+#include "lib/timezone/ob_time_convert.h"
 
 namespace oceanbase
 {
@@ -128,6 +132,144 @@ int ObTransStatusFilter::filter(
   return ret;
 }
 
+int ObRowTTLFilter::init(
+    const int64_t filter_ts,
+    const ObIArray<ObStorageTTLColumnSchema> &ttl_columns,
+    const ObIArray<schema::ObColDesc> &multi_version_col_descs,
+    const ObIArray<schema::ObSkipIndexColumnAttr> &skip_idx_attrs)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(filter_ts <= 0 || ttl_columns.empty() || multi_version_col_descs.empty())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(filter_ts), K(ttl_columns), K(multi_version_col_descs));
+  } else if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("is inited", K(ret), K(filter_ts), K(ttl_columns));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < ttl_columns.count(); ++i) {
+      const ObStorageTTLColumnSchema &ttl_column = ttl_columns.at(i);
+      TTLColumn filter_column;
+      filter_column.col_idx_ = -1;
+      for (int64_t j = 0; j < multi_version_col_descs.count(); ++j) {
+        if (multi_version_col_descs.at(j).col_id_ == ttl_column.column_id_) {
+          filter_column.col_idx_ = j;
+          break;
+        }
+      }
+      if (OB_UNLIKELY(filter_column.col_idx_ < 0)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("ttl column is not stored", K(ret), K(ttl_column), K(multi_version_col_descs));
+      } else {
+        filter_column.nsecond_ = ttl_column.nsecond_;
+        filter_column.nmonth_ = ttl_column.nmonth_;
+        filter_column.is_datetime_ = ttl_column.is_datetime_;
+        filter_column.has_min_max_ = filter_column.col_idx_ < skip_idx_attrs.count()
+                                  && skip_idx_attrs.at(filter_column.col_idx_).has_min_max();
+        if (OB_FAIL(ttl_columns_.push_back(filter_column))) {
+          LOG_WARN("failed to push back ttl column", K(ret), K(filter_column));
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      filter_ts_ = filter_ts;
+      is_inited_ = true;
+    } else {
+      ttl_columns_.reset();
+    }
+  }
+  return ret;
+}
+
+bool ObRowTTLFilter::is_expired(const TTLColumn &ttl_column, const int64_t column_value) const
+{
+  bool bool_ret = false;
+  int tmp_ret = OB_SUCCESS;
+  int64_t column_ts = column_value;
+  int64_t expire_ts = column_value;
+  // the time zone of datetime is unknown in compaction, take the latest utc time it could be
+  if (ttl_column.is_datetime_
+      && OB_TMP_FAIL(ObTimeConverter::date_add_nsecond(column_value, DATETIME_MAX_TZ_OFFSET_SEC, 0, column_ts))) {
+    LOG_DEBUG("fail to add tz offset", K(tmp_ret), K(column_value), K(ttl_column));
+  } else if (FALSE_IT(expire_ts = column_ts)) {
+  } else if (ttl_column.nsecond_ > 0
+      && OB_TMP_FAIL(ObTimeConverter::date_add_nsecond(column_ts, ttl_column.nsecond_, 0, expire_ts))) {
+    // expire time is out of range, keep the row
+    LOG_DEBUG("fail to add nsecond", K(tmp_ret), K(column_ts), K(ttl_column));
+  } else if (ttl_column.nmonth_ > 0
+      && OB_TMP_FAIL(ObTimeConverter::date_add_nmonth(column_ts, ttl_column.nmonth_, expire_ts, true))) {
+    LOG_DEBUG("fail to add nmonth", K(tmp_ret), K(column_ts), K(ttl_column));
+  } else {
+    bool_ret = expire_ts <= filter_ts_;
+  }
+  return bool_ret;
+}
+
+int ObRowTTLFilter::filter(
+    const blocksstable::ObDatumRow &row,
+    ObFilterRet &filter_ret)
+{
+  int ret = OB_SUCCESS;
+  filter_ret = FILTER_RET_NOT_CHANGE;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (row.is_uncommitted_row() || row.row_flag_.is_delete()) {
+    // delete row is dropped by major merger itself
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && FILTER_RET_NOT_CHANGE == filter_ret && i < ttl_columns_.count(); ++i) {
+      const TTLColumn &ttl_column = ttl_columns_.at(i);
+      if (OB_UNLIKELY(row.count_ <= ttl_column.col_idx_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected row column count", K(ret), K(ttl_column), K(row));
+      } else {
+        const blocksstable::ObStorageDatum &datum = row.storage_datums_[ttl_column.col_idx_];
+        if (datum.is_null() || datum.is_nop()) {
+          // null ttl column never expires
+        } else if (is_expired(ttl_column, datum.get_int())) {
+          filter_ret = FILTER_RET_REMOVE;
+          LOG_DEBUG("filter expired row", K(ret), K(row), K(ttl_column), K_(filter_ts));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObRowTTLFilter::check_filter_macro_block(
+    const blocksstable::ObMacroBlockDesc &macro_desc,
+    bool &need_filter)
+{
+  int ret = OB_SUCCESS;
+  need_filter = false;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (!macro_desc.is_valid_with_macro_meta()
+      || nullptr == macro_desc.macro_meta_->val_.agg_row_buf_
+      || macro_desc.macro_meta_->val_.agg_row_len_ <= 0) {
+    // not pre aggregated, reuse the block and leave its expired rows to the ttl task
+  } else {
+    const blocksstable::ObDataBlockMetaVal &meta_val = macro_desc.macro_meta_->val_;
+    blocksstable::ObAggRowReader agg_row_reader;
+    if (OB_FAIL(agg_row_reader.init(meta_val.agg_row_buf_, meta_val.agg_row_len_))) {
+      LOG_WARN("failed to init agg row reader", K(ret), K(meta_val));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && !need_filter && i < ttl_columns_.count(); ++i) {
+      const TTLColumn &ttl_column = ttl_columns_.at(i);
+      blocksstable::ObStorageDatum min_datum;
+      if (!ttl_column.has_min_max_) {
+      } else if (OB_FAIL(agg_row_reader.read(blocksstable::ObSkipIndexColMeta(
+          ttl_column.col_idx_, blocksstable::ObSkipIndexColType::SK_IDX_MIN), min_datum))) {
+        LOG_WARN("failed to read min value of ttl column", K(ret), K(ttl_column));
+      } else if (min_datum.is_null()) {
+        // all values are null or not aggregated
+      } else {
+        need_filter = is_expired(ttl_column, min_datum.get_int());
+      }
+    }
+  }
+  return ret;
+}
 
 } // namespace compaction
 } // namespace oceanbase
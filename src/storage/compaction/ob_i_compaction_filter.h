@@ -21,10 +21,12 @@ namespace oceanbase
 namespace blocksstable
 {
   struct ObDatumRow;
+  struct ObMacroBlockDesc;
 }
 namespace storage
 {
 class ObStoreRow;
+struct ObStorageTTLColumnSchema;
 }
 
 namespace compaction
@@ -71,6 +73,15 @@ public:
   virtual int filter(
       const blocksstable::ObDatumRow &row,
       ObFilterRet &filter_ret) = 0;
+  // whether the macro block should be opened and filtered by rows instead of reused
+  virtual int check_filter_macro_block(
+      const blocksstable::ObMacroBlockDesc &macro_desc,
+      bool &need_filter)
+  {
+    UNUSED(macro_desc);
+    need_filter = false;
+    return common::OB_SUCCESS;
+  }
 
   VIRTUAL_TO_STRING_KV(K_(is_full_merge));
 
@@ -117,6 +128,63 @@ private:
   share::SCN max_filtered_end_scn_;
 };
 
+// drop the rows expired by the ttl definition of table in major merge, the expire time is compared
+// with the merge snapshot rather than the current time, so all replicas purge the same rows.
+// Reused macro blocks are opened only if the min value of a ttl column with min/max skip index has
+// expired, other expired rows are left to the ttl task.
+// Updates of ttl tables are written as full rows (see ObTablet::update_row), so a version newer than
+// the snapshot doesn't need the purged base row to fill the columns it didn't update.
+class ObRowTTLFilter : public ObICompactionFilter
+{
+public:
+  // datetime is the wall clock of tenant time zone, which is at most 14 hours ahead of utc
+  static const int64_t DATETIME_MAX_TZ_OFFSET_SEC = 14 * 3600;
+  ObRowTTLFilter()
+    : ObICompactionFilter(false),
+      is_inited_(false),
+      filter_ts_(0),
+      ttl_columns_()
+  {
+  }
+  ~ObRowTTLFilter() {}
+  int init(
+      const int64_t filter_ts,
+      const common::ObIArray<storage::ObStorageTTLColumnSchema> &ttl_columns,
+      const common::ObIArray<share::schema::ObColDesc> &multi_version_col_descs,
+      const common::ObIArray<share::schema::ObSkipIndexColumnAttr> &skip_idx_attrs);
+  OB_INLINE virtual void reset() override
+  {
+    ObICompactionFilter::reset();
+    filter_ts_ = 0;
+    ttl_columns_.reset();
+    is_inited_ = false;
+  }
+
+  virtual int filter(const blocksstable::ObDatumRow &row, ObFilterRet &filter_ret) override;
+  virtual int check_filter_macro_block(
+      const blocksstable::ObMacroBlockDesc &macro_desc,
+      bool &need_filter) override;
+
+  INHERIT_TO_STRING_KV("ObICompactionFilter", ObICompactionFilter, "filter_name", "ObRowTTLFilter", K_(filter_ts),
+      K_(ttl_columns));
+
+private:
+  struct TTLColumn
+  {
+    TTLColumn() : col_idx_(0), nsecond_(0), nmonth_(0), is_datetime_(false), has_min_max_(false) {}
+    TO_STRING_KV(K_(col_idx), K_(nsecond), K_(nmonth), K_(is_datetime), K_(has_min_max));
+    int64_t col_idx_; // idx in multi version row
+    int64_t nsecond_;
+    int64_t nmonth_;
+    bool is_datetime_;
+    bool has_min_max_; // min value of the column is aggregated in macro meta
+  };
+  bool is_expired(const TTLColumn &ttl_column, const int64_t column_value) const;
+  bool is_inited_;
+  int64_t filter_ts_; // us
+  common::ObSEArray<TTLColumn, 4> ttl_columns_;
+};
+
 } // namespace compaction
 } // namespace oceanbase
 
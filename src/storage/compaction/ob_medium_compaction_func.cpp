@@ -994,6 +994,9 @@ int ObMediumCompactionScheduleFunc::get_table_schema_to_merge(
     storage_schema_version =  ObStorageSchema::STORAGE_SCHEMA_VERSION;
   } else if (medium_info.medium_compat_version_ < ObMediumCompactionInfo::MEDIUM_COMPAT_VERSION_V3) {
     storage_schema_version =  ObStorageSchema::STORAGE_SCHEMA_VERSION_V2;
+  } else if (medium_info.data_version_ >= DATA_VERSION_4_3_0_1) {
+    // storage schema V4 can not be deserialized by observers before 4.3.0.1
+    storage_schema_version =  ObStorageSchema::STORAGE_SCHEMA_VERSION_V4;
   }
   // for old version medium info, need generate old version schema
   if (FAILEDx(medium_info.storage_schema_.init(
@@ -672,7 +672,8 @@ int ObPartitionMajorMerger::merge_partition(
       STORAGE_LOG(WARN, "Failed to check has_incremental_data", K(ret), KPC(merge_helper_));
     } else if (progressive_merge_helper_.is_progressive_merge_finish()
             && !has_incremental_data
-            && !merge_param_.is_full_merge()) {
+            && !merge_param_.is_full_merge()
+            && !ctx.has_filter()) { // macro blocks need to be checked by compaction filter
       if (OB_FAIL(reuse_base_sstable(*merge_helper_)) && OB_ITER_END != ret) {
         STORAGE_LOG(WARN, "Failed to reuse base sstable", K(ret), KPC(merge_helper_));
       } else {
@@ -819,6 +820,10 @@ int ObPartitionMajorMerger::try_rewrite_macro_block(const ObMacroBlockDesc &macr
     STORAGE_LOG(WARN, "failed to check need_rewrite_macro_block", K(ret), K(macro_desc));
   } else if (rewrite) {
     progressive_merge_helper_.inc_rewrite_block_cnt();
+  } else if (OB_FAIL(merge_ctx_->check_filter_macro_block(macro_desc, rewrite))) {
+    STORAGE_LOG(WARN, "failed to check filter macro block", K(ret), K(macro_desc));
+  } else if (rewrite) {
+    // rows of the block need to be filtered
   } else if (OB_FAIL(ObPartitionMerger::try_rewrite_macro_block(macro_desc, rewrite))) {
     STORAGE_LOG(WARN, "fail to try_rewrite_macro_block", K(ret));
   }
@@ -423,6 +423,57 @@ int ObTabletMajorMergeCtx::prepare_schema()
   return ret;
 }
 
+int ObTabletMajorMergeCtx::cal_merge_param()
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(static_param_.cal_major_merge_param())) {
+    LOG_WARN("failed to cal major merge param", KR(ret), "param", get_dag_param());
+  } else if (!is_major_merge_type(get_merge_type()) || get_schema()->get_ttl_columns().empty()) {
+    // no row ttl to enforce
+  } else if (OB_FAIL(prepare_compaction_filter())) {
+    LOG_WARN("failed to prepare compaction filter", KR(ret), "param", get_dag_param());
+  }
+  return ret;
+}
+
+int ObTabletMajorMergeCtx::prepare_compaction_filter()
+{
+  int ret = OB_SUCCESS;
+  void *buf = nullptr;
+  ObSEArray<share::schema::ObColDesc, 16> multi_version_col_descs;
+  ObSEArray<share::schema::ObSkipIndexColumnAttr, 16> skip_idx_attrs;
+  SCN snapshot_scn;
+  if (OB_FAIL(get_schema()->get_multi_version_column_descs(multi_version_col_descs))) {
+    LOG_WARN("failed to get multi version column descs", KR(ret), KPC(get_schema()));
+  } else if (OB_FAIL(get_schema()->get_skip_index_col_attr(skip_idx_attrs))) {
+    LOG_WARN("failed to get skip index col attr", KR(ret), KPC(get_schema()));
+  } else if (OB_FAIL(snapshot_scn.convert_for_tx(get_snapshot()))) {
+    LOG_WARN("failed to convert snapshot", KR(ret), "snapshot", get_snapshot());
+  } else if (OB_ISNULL(buf = mem_ctx_.alloc(sizeof(ObRowTTLFilter)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc row ttl filter", KR(ret));
+  } else {
+    // expired rows are compared with the merge snapshot, so the major sstable is the same on all replicas
+    ObRowTTLFilter *compaction_filter = new(buf) ObRowTTLFilter();
+    if (OB_FAIL(compaction_filter->init(snapshot_scn.convert_to_ts(),
+                                        get_schema()->get_ttl_columns(),
+                                        multi_version_col_descs,
+                                        skip_idx_attrs))) {
+      LOG_WARN("failed to init row ttl filter", KR(ret), "ttl_columns", get_schema()->get_ttl_columns());
+      compaction_filter->~ObRowTTLFilter();
+      mem_ctx_.free(buf);
+      buf = nullptr;
+    } else {
+      info_collector_.compaction_filter_ = compaction_filter;
+      // reused micro blocks are not iterated by rows, macro blocks are rewritten only if the min value
+      // of ttl column has expired, see ObRowTTLFilter::check_filter_macro_block
+      static_param_.merge_level_ = MACRO_BLOCK_MERGE_LEVEL;
+      FLOG_INFO("success to init row ttl filter", KPC(compaction_filter));
+    }
+  }
+  return ret;
+}
+
 int ObTabletMajorMergeCtx::try_swap_tablet(
   ObGetMergeTablesResult &get_merge_table_result)
 {
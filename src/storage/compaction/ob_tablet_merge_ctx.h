@@ -93,7 +93,9 @@ struct ObTabletMajorMergeCtx : public ObTabletMergeCtx
 protected:
   virtual int prepare_schema() override;
   virtual int try_swap_tablet(ObGetMergeTablesResult &get_merge_table_result) override;
-  virtual int cal_merge_param() override { return static_param_.cal_major_merge_param(); }
+  virtual int cal_merge_param() override;
+private:
+  int prepare_compaction_filter(); // for row ttl
 };
 
 } // namespace compaction
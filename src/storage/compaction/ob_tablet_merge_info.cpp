@@ -221,6 +221,10 @@ int ObTabletMergeInfo::build_create_sstable_param(const ObBasicTabletMergeCtx &c
         LOG_WARN("fail to fill column checksum", K(ret), K(res));
       }
     }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(param.rowkey_bloom_filter_.assign(res.rowkey_bloom_filter_))) {
+      LOG_WARN("fail to fill rowkey bloom filter", K(ret), K(res));
+    }
 
     if (OB_SUCC(ret) && ctx.get_tablet_id().is_ls_tx_data_tablet()) {
       ret = record_start_tx_scn_for_tx_data(ctx, param);
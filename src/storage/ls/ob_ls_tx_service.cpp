@@ -214,6 +214,18 @@ int ObLSTxService::check_scheduler_status(SCN &min_start_scn,
   return ret;
 }
 
+int ObLSTxService::purge_retired_tx_ctx()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(mgr_)) {
+    ret = OB_NOT_INIT;
+    TRANS_LOG(WARN, "not init", KR(ret), K_(ls_id));
+  } else {
+    mgr_->purge_retired_tx_ctx();
+  }
+  return ret;
+}
+
 int ObLSTxService::check_all_tx_clean_up() const
 {
   int ret = OB_SUCCESS;
@@ -697,6 +709,7 @@ int ObLSTxService::offline()
     TRANS_LOG(WARN, "block all failed", K_(ls_id));
   } else if (OB_FAIL(mgr_->kill_all_tx(graceful, unused_is_all_tx_clean_up))) {
     TRANS_LOG(WARN, "kill_all_tx failed", K_(ls_id));
+  } else if (FALSE_IT(mgr_->purge_retired_tx_ctx())) {
   } else if (mgr_->get_tx_ctx_count() > 0) {
     ret = OB_EAGAIN;
     if (REACH_TIME_INTERVAL(PRINT_LOG_INTERVAL)) {
@@ -109,6 +109,8 @@ public:
   int traverse_trans_to_submit_next_log();
   // check schduler status for gc
   int check_scheduler_status(share::SCN &min_start_scn, transaction::MinStartScnStatus &status);
+  // free the tx ctx released by their last revert in batch
+  int purge_retired_tx_ctx();
 
   // for ls gc
   // @return OB_SUCCESS, all the tx of this ls cleaned up
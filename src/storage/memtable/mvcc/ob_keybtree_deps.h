@@ -247,6 +247,7 @@ public:
   OB_INLINE void set_key_value(int pos, BtreeKey key, BtreeVal val)
   {
     kvs_[pos].key_ = key;
+    key.get_prefix(prefixes_[pos], prefix_domains_[pos]);
     ATOMIC_STORE(&kvs_[pos].val_, val);
   }
   OB_INLINE void insert_into_node(int pos, BtreeKey key, BtreeVal val)
@@ -282,11 +283,19 @@ protected:
       end = size();
     }
     is_equal = false;
+    uint64_t prefix = 0;
+    uint8_t prefix_domain = 0;
+    key.get_prefix(prefix, prefix_domain);
     while (OB_SUCC(ret) && start < end && !is_equal) {
       int mid = start + (end - start) / 2;
+      int real_pos = get_real_pos(mid, index);
       int cmp_ret = 0;
-      if (OB_FAIL(nh.compare(key, get_key(mid, index), cmp_ret))) {
-        OB_LOG(ERROR, "failed to compare", K(key), K(get_key(mid, index)));
+      if (0 != prefix_domain && prefix_domain == prefix_domains_[real_pos]
+          && prefix != prefixes_[real_pos]) {
+        // decided by inline prefix, no need to dereference the index key
+        cmp_ret = prefix < prefixes_[real_pos] ? -1 : 1;
+      } else if (OB_FAIL(nh.compare(key, kvs_[real_pos].key_, cmp_ret))) {
+        OB_LOG(ERROR, "failed to compare", K(key), K(kvs_[real_pos].key_));
       } else if (0 == cmp_ret) {
         is_equal = true;
         end = mid + 1;
@@ -322,6 +331,12 @@ private:
   RWLock lock_; // 4byte
   MultibitSet index_; // 8byte this is the real position of kv.
   BtreeKV kvs_[NODE_KEY_COUNT]; // 16 * 15 = 240byte
+  // Order-preserving prefix of kvs_[i].key_, see BtreeKey::get_prefix(). Prefixes are
+  // comparable only if they are of the same non-zero domain, most compares on the search
+  // path finish here without touching the key, full key compare is needed on tie.
+  // Node size grows from 280 to 416 bytes, about 14 bytes per row with 2/3 full leaves.
+  uint64_t prefixes_[NODE_KEY_COUNT]; // 8 * 15 = 120byte
+  uint8_t prefix_domains_[NODE_KEY_COUNT]; // 15byte
 };
 
 template<typename BtreeKey, typename BtreeVal>
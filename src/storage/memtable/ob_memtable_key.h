@@ -293,6 +293,25 @@ public:
   void reset() { rowkey_ = nullptr; }
   int compare(const ObStoreRowkeyWrapper &other, int &cmp) const { return rowkey_->compare(*(other.get_rowkey()), cmp); }
   int equal(const ObStoreRowkeyWrapper &other, bool &is_equal) const { return rowkey_->equal(*(other.get_rowkey()), is_equal); }
+  // Order-preserving 8 bytes prefix of the first rowkey column, inlined in memtable btree
+  // nodes to avoid dereferencing keys on the search path. %domain is the type class which
+  // the prefix is derived from, ObNullTC means no prefix and the full rowkey compare is used.
+  void get_prefix(uint64_t &prefix, uint8_t &domain) const
+  {
+    prefix = 0;
+    domain = common::ObNullTC;
+    if (OB_NOT_NULL(rowkey_) && rowkey_->get_obj_cnt() > 0) {
+      const common::ObObj &obj = rowkey_->get_obj_ptr()[0];
+      if (common::ObIntTC == obj.get_type_class()) {
+        // flip sign bit so that negative values are ordered before positive ones
+        prefix = static_cast<uint64_t>(obj.get_int()) ^ (1ULL << 63);
+        domain = common::ObIntTC;
+      } else if (common::ObUIntTC == obj.get_type_class()) {
+        prefix = obj.get_uint64();
+        domain = common::ObUIntTC;
+      }
+    }
+  }
   uint64_t hash() const { return rowkey_->hash(); }
   int checksum(common::ObBatchChecksum &bc) const { return rowkey_->checksum(bc); }
   int64_t to_string(char *buf, const int64_t buf_len) const { return rowkey_->to_string(buf, buf_len); }
@@ -16,6 +16,7 @@
 #include "share/ob_encryption_util.h"
 #include "share/schema/ob_column_schema.h"
 #include "share/schema/ob_schema_struct.h"
+#include "share/table/ob_ttl_util.h"
 #include "storage/ob_storage_struct.h"
 
 namespace oceanbase
@@ -125,6 +126,16 @@ OB_SERIALIZE_MEMBER(
     meta_type_,
     orig_default_value_);
 
+/*
+ * ObStorageTTLColumnSchema
+ * */
+OB_SERIALIZE_MEMBER_SIMPLE(
+    ObStorageTTLColumnSchema,
+    column_id_,
+    nsecond_,
+    nmonth_,
+    is_datetime_);
+
 int ObStorageColumnSchema::legacy_deserialize(const char *buf, const int64_t data_len, int64_t &pos)
 {
   // For schema version before 4_2_0_0
@@ -384,6 +395,7 @@ ObStorageSchema::ObStorageSchema()
     column_array_(),
     column_group_array_(),
     skip_idx_attr_array_(),
+    ttl_column_array_(),
     store_column_cnt_(0),
     has_all_column_group_(false),
     is_inited_(false)
@@ -416,6 +428,7 @@ int ObStorageSchema::init(
     column_array_.set_allocator(&allocator);
     column_group_array_.set_allocator(&allocator);
     skip_idx_attr_array_.set_allocator(&allocator);
+    ttl_column_array_.set_allocator(&allocator);
 
     storage_schema_version_ = compat_version;
     copy_from(input_schema);
@@ -430,6 +443,9 @@ int ObStorageSchema::init(
     STORAGE_LOG(WARN, "failed to generate column array", K(ret), K(input_schema));
   } else if (OB_FAIL(generate_column_group_array(input_schema, allocator))) {
     STORAGE_LOG(WARN, "Failed to generate column group array", K(ret));
+  } else if (storage_schema_version_ >= STORAGE_SCHEMA_VERSION_V4
+      && OB_FAIL(generate_ttl_column_array(input_schema))) {
+    STORAGE_LOG(WARN, "Failed to generate ttl column array", K(ret), K(input_schema.get_ttl_definition()));
   } else if (OB_UNLIKELY(!is_valid())) {
     ret = OB_ERR_UNEXPECTED;
     STORAGE_LOG(ERROR, "storage schema is invalid", K(ret));
@@ -464,8 +480,10 @@ int ObStorageSchema::init(
     column_array_.set_allocator(&allocator);
     column_group_array_.set_allocator(&allocator);
     skip_idx_attr_array_.set_allocator(&allocator);
+    ttl_column_array_.set_allocator(&allocator);
 
-    storage_schema_version_ = STORAGE_SCHEMA_VERSION_V3;
+    storage_schema_version_ = old_schema.storage_schema_version_ >= STORAGE_SCHEMA_VERSION_V4
+                            ? STORAGE_SCHEMA_VERSION_V4 : STORAGE_SCHEMA_VERSION_V3;
     copy_from(old_schema);
     compat_mode_ = old_schema.compat_mode_;
     compressor_type_ = old_schema.compressor_type_;
@@ -485,6 +503,10 @@ int ObStorageSchema::init(
       STORAGE_LOG(WARN, "failed to reserve for skip idx attr array", K(ret), K(old_schema));
     } else if (OB_FAIL(skip_idx_attr_array_.assign(old_schema.skip_idx_attr_array_))) {
       STORAGE_LOG(WARN, "failed to copy skip idx attr array", K(ret), K(old_schema));
+    } else if (OB_FAIL(ttl_column_array_.reserve(old_schema.ttl_column_array_.count()))) {
+      STORAGE_LOG(WARN, "failed to reserve for ttl column array", K(ret), K(old_schema));
+    } else if (OB_FAIL(ttl_column_array_.assign(old_schema.ttl_column_array_))) {
+      STORAGE_LOG(WARN, "failed to copy ttl column array", K(ret), K(old_schema));
     } else if (!column_info_simplified_ && OB_FAIL(deep_copy_column_array(allocator, old_schema, old_schema.column_array_.count()))) {
       STORAGE_LOG(WARN, "failed to deep copy column array", K(ret), K(old_schema));
     } else if (NULL != column_group_schema && OB_FAIL(deep_copy_column_group_array(allocator, *column_group_schema))) {
@@ -605,6 +627,7 @@ void ObStorageSchema::reset()
     column_array_.reset();
     (void) reset_column_group_array();
     skip_idx_attr_array_.reset();
+    ttl_column_array_.reset();
     has_all_column_group_ = false;
     allocator_ = nullptr;
   }
@@ -633,7 +656,8 @@ bool ObStorageSchema::is_valid() const
       || !check_column_array_valid(rowkey_array_)
       || !check_column_array_valid(column_array_)
       || !check_column_array_valid(column_group_array_)
-      || !check_column_array_valid(skip_idx_attr_array_)) {
+      || !check_column_array_valid(skip_idx_attr_array_)
+      || !check_column_array_valid(ttl_column_array_)) {
     valid_ret = false;
     STORAGE_LOG_RET(WARN, OB_INVALID_ERROR, "invalid", K_(is_inited), KP_(allocator), K_(schema_version), K_(column_cnt),
         K_(tablet_size), K_(pctfree), K_(table_type), K_(table_mode), K_(index_type));
@@ -671,7 +695,7 @@ int ObStorageSchema::serialize(char *buf, const int64_t buf_len, int64_t &pos) c
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(WARN, "invalid args", K(ret), K(buf), K(buf_len), K(pos));
   } else if (STORAGE_SCHEMA_VERSION <= storage_schema_version_
-      && STORAGE_SCHEMA_VERSION_V3 >= storage_schema_version_) {
+      && STORAGE_SCHEMA_VERSION_V4 >= storage_schema_version_) {
     LST_DO_CODE(OB_UNIS_ENCODE,
         storage_schema_version_,
         info_,
@@ -704,6 +728,10 @@ int ObStorageSchema::serialize(char *buf, const int64_t buf_len, int64_t &pos) c
         STORAGE_LOG(WARN, "failed to serialize column grups", K_(column_group_array));
       } else if (OB_FAIL(serialize_schema_array(buf, buf_len, pos, skip_idx_attr_array_))){
         STORAGE_LOG(WARN, "failed to serialize skip idx attr array", K_(skip_idx_attr_array));
+      } else if (storage_schema_version_ < STORAGE_SCHEMA_VERSION_V4) {
+        // v3 do not need ttl columns
+      } else if (OB_FAIL(serialize_schema_array(buf, buf_len, pos, ttl_column_array_))){
+        STORAGE_LOG(WARN, "failed to serialize ttl column array", K_(ttl_column_array));
       }
     }
   } else {
@@ -725,7 +753,7 @@ int ObStorageSchema::serialize_column_array(char *buf, const int64_t data_len, i
       if (OB_FAIL(column_array_.at(i).legacy_serialize(buf, data_len, pos))) {
         STORAGE_LOG(WARN, "Fail to serialize column schema for legacy version", K(ret), K(i), K_(column_array));
       }
-    } else if (STORAGE_SCHEMA_VERSION_V3 == storage_schema_version_) {
+    } else if (STORAGE_SCHEMA_VERSION_V3 <= storage_schema_version_) {
       if (OB_FAIL(column_array_.at(i).serialize(buf, data_len, pos))) {
         STORAGE_LOG(WARN, "Fail to serialize column schema", K(ret), K(i), K_(column_array));
       }
@@ -761,13 +789,14 @@ int ObStorageSchema::deserialize(
     column_array_.set_allocator(&allocator);
     column_group_array_.set_allocator(&allocator);
     skip_idx_attr_array_.set_allocator(&allocator);
+    ttl_column_array_.set_allocator(&allocator);
   }
 
   if (OB_FAIL(ret)) {
   } else if (OB_FAIL(serialization::decode(buf, data_len, pos, storage_schema_version_))) {
     STORAGE_LOG(WARN, "failed to deserialize version", K(ret), K(data_len), K(pos));
   } else if (STORAGE_SCHEMA_VERSION <= storage_schema_version_
-      && STORAGE_SCHEMA_VERSION_V3 >= storage_schema_version_) {
+      && STORAGE_SCHEMA_VERSION_V4 >= storage_schema_version_) {
     ObString tmp_encryption;
     ObString tmp_encrypt_key;
     LST_DO_CODE(OB_UNIS_DECODE,
@@ -820,6 +849,9 @@ int ObStorageSchema::deserialize(
       STORAGE_LOG(WARN, "Failed to deserialize column groups", K(ret));
     } else if (OB_FAIL(deserialize_skip_idx_attr_array(buf, data_len, pos))) {
       STORAGE_LOG(WARN, "failed to deserialize skip idx attr array", K(ret));
+    } else if (storage_schema_version_ >= STORAGE_SCHEMA_VERSION_V4
+        && OB_FAIL(deserialize_ttl_column_array(buf, data_len, pos))) {
+      STORAGE_LOG(WARN, "failed to deserialize ttl column array", K(ret));
     } // TODO(@lixia.yq) need to add compat log for column_group after transfer refresh
 
     if (OB_SUCC(ret)) {
@@ -892,7 +924,7 @@ int ObStorageSchema::deserialize_column_array(
         if (OB_FAIL(column.legacy_deserialize(buf, data_len, pos))) {
           STORAGE_LOG(WARN, "Fail to deserialize column schema for legacy version", K(ret));
         }
-      } else if (STORAGE_SCHEMA_VERSION_V3 == storage_schema_version_) {
+      } else if (STORAGE_SCHEMA_VERSION_V3 <= storage_schema_version_) {
         if (OB_FAIL(column.deserialize(buf, data_len, pos))) {
           STORAGE_LOG(WARN, "Fail to deserialize column schema", K(ret));
         }
@@ -919,6 +951,48 @@ int ObStorageSchema::deserialize_column_array(
   return ret;
 }
 
+int ObStorageSchema::generate_ttl_column_array(const ObTableSchema &input_schema)
+{
+  int ret = OB_SUCCESS;
+  ObTableTTLChecker ttl_checker;
+  if (input_schema.get_ttl_definition().empty()) {
+    // no ttl definition
+  } else if (input_schema.get_index_tid_count() > 0 || input_schema.has_lob_column()) {
+    // index and lob tablets do not know the ttl of data table, purging rows only in the data
+    // tablet breaks index back and the column checksum check, leave them to the ttl task
+    STORAGE_LOG(INFO, "skip ttl columns of table with index or lob", "table_id", input_schema.get_table_id(),
+        "index_cnt", input_schema.get_index_tid_count(), "has_lob_column", input_schema.has_lob_column());
+  } else if (OB_FAIL(ttl_checker.init(input_schema, false/*in_full_column_order*/))) {
+    STORAGE_LOG(WARN, "failed to parse ttl definition", K(ret), K(input_schema.get_ttl_definition()));
+  } else if (OB_FAIL(ttl_column_array_.reserve(ttl_checker.get_ttl_definition().count()))) {
+    STORAGE_LOG(WARN, "failed to reserve ttl column array", K(ret));
+  } else {
+    const ObIArray<ObTableTTLExpr> &ttl_exprs = ttl_checker.get_ttl_definition();
+    for (int64_t i = 0; OB_SUCC(ret) && i < ttl_exprs.count(); ++i) {
+      const ObTableTTLExpr &ttl_expr = ttl_exprs.at(i);
+      const ObColumnSchemaV2 *col_schema = input_schema.get_column_schema(ttl_expr.column_name_);
+      ObStorageTTLColumnSchema ttl_column;
+      if (OB_ISNULL(col_schema)) {
+        ret = OB_ERR_UNEXPECTED;
+        STORAGE_LOG(WARN, "ttl column not exist", K(ret), K(ttl_expr));
+      } else if ((ObTimestampType != col_schema->get_data_type() && ObDateTimeType != col_schema->get_data_type())
+          || !col_schema->is_column_stored_in_sstable()) {
+        STORAGE_LOG(INFO, "skip ttl column which can not be filtered in compaction", K(ttl_expr),
+            "column_type", col_schema->get_data_type());
+      } else {
+        ttl_column.column_id_ = col_schema->get_column_id();
+        ttl_column.nsecond_ = ttl_expr.nsecond_;
+        ttl_column.nmonth_ = ttl_expr.nmonth_;
+        ttl_column.is_datetime_ = ObDateTimeType == col_schema->get_data_type();
+        if (OB_FAIL(ttl_column_array_.push_back(ttl_column))) {
+          STORAGE_LOG(WARN, "failed to push back ttl column", K(ret), K(ttl_column));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 int ObStorageSchema::generate_column_group_array(const ObTableSchema &input_schema, ObIAllocator &allocator)
 {
   int ret = OB_SUCCESS;
@@ -1054,6 +1128,34 @@ int ObStorageSchema::deserialize_skip_idx_attr_array(const char *buf,
   return ret;
 }
 
+int ObStorageSchema::deserialize_ttl_column_array(const char *buf,
+                                                  const int64_t data_len,
+                                                  int64_t &pos)
+{
+  int ret = OB_SUCCESS;
+  int64_t count = 0;
+  if (OB_ISNULL(buf) || OB_UNLIKELY(data_len <= 0) || OB_UNLIKELY(pos > data_len)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(buf), K(data_len), K(pos), K(ret));
+  } else if (OB_FAIL(serialization::decode_vi64(buf, data_len, pos, &count))) {
+    STORAGE_LOG(WARN, "Fail to decode ttl column count", K(ret));
+  } else if (0 == count) {
+    // no ttl definition
+  } else if (OB_FAIL(ttl_column_array_.reserve(count))) {
+    STORAGE_LOG(WARN, "Fail to reserve ttl column array", K(ret), K(count));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < count; ++i) {
+      ObStorageTTLColumnSchema ttl_column;
+      if (OB_FAIL(ttl_column.deserialize(buf, data_len, pos))) {
+        STORAGE_LOG(WARN, "Failed to deserialize ttl column", K(ret));
+      } else if (OB_FAIL(ttl_column_array_.push_back(ttl_column))) {
+        STORAGE_LOG(WARN, "Fail to add ttl column", K(ret), K(ttl_column));
+      }
+    }
+  }
+  return ret;
+}
+
 int64_t ObStorageSchema::get_serialize_size() const
 {
   int64_t len = 0;
@@ -1088,6 +1190,9 @@ int64_t ObStorageSchema::get_serialize_size() const
     len += get_column_array_serialize_length(column_group_array_);
     len += get_column_array_serialize_length(skip_idx_attr_array_);
   }
+  if (storage_schema_version_ >= STORAGE_SCHEMA_VERSION_V4) {
+    len += get_column_array_serialize_length(ttl_column_array_);
+  }
   return len;
 }
 
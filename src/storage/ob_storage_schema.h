@@ -95,6 +95,33 @@ public:
   ObObj orig_default_value_;
 };
 
+// one term of the table ttl definition "column + INTERVAL n unit", only timestamp and datetime columns are recorded
+struct ObStorageTTLColumnSchema
+{
+  OB_UNIS_VERSION(1);
+public:
+  ObStorageTTLColumnSchema() { reset(); }
+  ~ObStorageTTLColumnSchema() {}
+  void reset()
+  {
+    column_id_ = 0;
+    nsecond_ = 0;
+    nmonth_ = 0;
+    is_datetime_ = false;
+  }
+  bool is_valid() const
+  {
+    return column_id_ >= common::OB_APP_MIN_COLUMN_ID && nsecond_ >= 0 && nmonth_ >= 0;
+  }
+  TO_STRING_KV(K_(column_id), K_(nsecond), K_(nmonth), K_(is_datetime));
+
+public:
+  uint64_t column_id_;
+  int64_t nsecond_;
+  int64_t nmonth_;
+  bool is_datetime_; // value is the wall clock in the tenant time zone rather than utc
+};
+
 struct ObStorageColumnGroupSchema
 {
 public:
@@ -237,6 +264,7 @@ public:
   virtual inline share::schema::ObIndexStatus get_index_status() const override { return index_status_; }
   const common::ObIArray<ObStorageColumnSchema> &get_store_column_schemas() const { return column_array_; }
   const common::ObIArray<ObStorageColumnGroupSchema> &get_column_groups() const { return column_group_array_; }
+  const common::ObIArray<ObStorageTTLColumnSchema> &get_ttl_columns() const { return ttl_column_array_; }
   virtual inline common::ObRowStoreType get_row_store_type() const override { return row_store_type_; }
   virtual inline const char *get_compress_func_name() const override {  return all_compressor_name[compressor_type_]; }
   virtual inline common::ObCompressorType get_compressor_type() const override { return compressor_type_; }
@@ -264,7 +292,8 @@ public:
       K_(master_key_id), K_(compressor_type), K_(encryption), K_(encrypt_key),
       "rowkey_cnt", rowkey_array_.count(), K_(rowkey_array), "column_cnt", column_array_.count(), K_(column_array),
       "skip_index_cnt", skip_idx_attr_array_.count(), K_(skip_idx_attr_array),
-      "column_group_cnt", column_group_array_.count(), K_(column_group_array), K_(has_all_column_group));
+      "column_group_cnt", column_group_array_.count(), K_(column_group_array), K_(has_all_column_group),
+      K_(ttl_column_array));
 private:
   void copy_from(const share::schema::ObMergeSchema &input_schema);
   int deep_copy_str(const ObString &src, ObString &dest);
@@ -274,6 +303,7 @@ private:
   int generate_str(const share::schema::ObTableSchema &input_schema);
   int generate_column_array(const share::schema::ObTableSchema &input_schema);
   int generate_column_group_array(const share::schema::ObTableSchema &input_schema, common::ObIAllocator &allocator);
+  int generate_ttl_column_array(const share::schema::ObTableSchema &input_schema);
   int get_column_ids_without_rowkey(
       common::ObIArray<share::schema::ObColDesc> &column_ids,
       bool no_virtual) const;
@@ -289,6 +319,7 @@ private:
   int deserialize_column_array(ObIAllocator &allocator, const char *buf, const int64_t data_len, int64_t &pos);
   int deserialize_column_group_array(ObIAllocator &allocator, const char *buf, const int64_t data_len, int64_t &pos);
   int deserialize_skip_idx_attr_array(const char *buf, const int64_t data_len, int64_t &pos);
+  int deserialize_ttl_column_array(const char *buf, const int64_t data_len, int64_t &pos);
   int generate_all_column_group_schema(ObStorageColumnGroupSchema &column_group, const ObRowStoreType row_store_type);
   template <typename T>
   int64_t get_column_array_serialize_length(const common::ObIArray<T> &array) const;
@@ -312,6 +343,7 @@ public:
   static const int64_t STORAGE_SCHEMA_VERSION = 1;
   static const int64_t STORAGE_SCHEMA_VERSION_V2 = 2; // add for store_column_cnt_
   static const int64_t STORAGE_SCHEMA_VERSION_V3 = 3; // add for cg_group
+  static const int64_t STORAGE_SCHEMA_VERSION_V4 = 4; // add for ttl_column_array_
 
   common::ObIAllocator *allocator_;
   int64_t storage_schema_version_;
@@ -347,6 +379,7 @@ public:
   common::ObFixedArray<ObStorageColumnSchema, common::ObIAllocator> column_array_; // column schema
   common::ObFixedArray<ObStorageColumnGroupSchema, common::ObIAllocator> column_group_array_; // column group schema
   common::ObFixedArray<share::schema::ObSkipIndexAttrWithId, common::ObIAllocator> skip_idx_attr_array_;
+  common::ObFixedArray<ObStorageTTLColumnSchema, common::ObIAllocator> ttl_column_array_; // for row ttl compaction filter
   int64_t store_column_cnt_; // NOT include virtual generated column
   bool has_all_column_group_; // for column store, no need to serialize
   bool is_inited_;
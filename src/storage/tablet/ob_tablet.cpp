@@ -3152,9 +3152,23 @@ int ObTablet::update_row(
       ObArenaAllocator allocator(common::ObMemAttr(MTL_ID(), "update_acc_ctx"));
       ObTableIterParam param;
       ObTableAccessContext context;
+      ObSEArray<int64_t, OB_ROW_DEFAULT_COLUMNS_COUNT> full_update_idx;
+      const ObIArray<int64_t> *write_update_idx = &update_idx;
       if (OB_FAIL(prepare_param_ctx(allocator, relative_table, store_ctx, param, context))) {
         LOG_WARN("prepare param ctx fail, ", K(ret));
-      } else if (OB_FAIL(write_memtable->set(param, context, col_descs, update_idx, old_row, new_row, encrypt_meta))) {
+      } else if (nullptr != relative_table.get_schema_param()
+          && relative_table.get_schema_param()->has_row_ttl()) {
+        // the base row may be purged by major merge once it expires (see ObRowTTLFilter),
+        // so an update of ttl table is written as full row instead of the updated columns
+        for (int64_t i = param.get_schema_rowkey_count(); OB_SUCC(ret) && i < new_row.row_val_.count_; ++i) {
+          if (OB_FAIL(full_update_idx.push_back(i))) {
+            LOG_WARN("failed to push back update idx", K(ret), K(i));
+          }
+        }
+        write_update_idx = &full_update_idx;
+      }
+      if (OB_FAIL(ret)) {
+      } else if (OB_FAIL(write_memtable->set(param, context, col_descs, *write_update_idx, old_row, new_row, encrypt_meta))) {
         LOG_WARN("failed to set memtable, ", K(ret));
       }
     }
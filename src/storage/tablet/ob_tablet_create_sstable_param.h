@@ -64,6 +64,7 @@ public:
       K_(column_cnt),
       K_(full_column_cnt),
       K_(column_checksums),
+      "rowkey_bloom_filter_word_cnt", rowkey_bloom_filter_.count(),
       K_(data_checksum),
       K_(occupy_size),
       K_(original_size),
@@ -109,6 +110,7 @@ public:
   int64_t column_cnt_;
   int64_t full_column_cnt_;
   common::ObSEArray<int64_t, common::OB_ROW_DEFAULT_COLUMNS_COUNT> column_checksums_;
+  common::ObArray<uint64_t> rowkey_bloom_filter_; // words of the rowkey bloom filter, may be empty
   int64_t data_checksum_;
   int64_t occupy_size_;
   int64_t original_size_;
@@ -33,7 +33,7 @@
 #include "storage/memtable/ob_memtable_context.h"
 #include "ob_xa_define.h"
 #include "share/rc/ob_context.h"
-#include "ob_trans_hashmap.h"
+#include "ob_trans_resizable_hashmap.h"
 #include "ob_tx_elr_handler.h"
 
 namespace oceanbase
@@ -93,7 +93,7 @@ static inline void protocol_error(const int64_t state, const int64_t msg_type)
 // For Example: If you change the signature of the function `commit` in
 // `ObTransCtx`, you should also modify the signatore of function `commit` in
 // `ObPartTransCtx`, `ObScheTransCtx`
-class ObTransCtx: public ObTransHashLink<ObTransCtx>
+class ObTransCtx: public ObTransResizableHashLink<ObTransCtx>
 {
   friend class CtxLock;
 public:
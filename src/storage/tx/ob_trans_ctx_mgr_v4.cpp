@@ -1641,6 +1641,7 @@ int ObTxCtxMgr::wait_ls_(const ObLSID &ls_id)
     if (OB_UNLIKELY(!ls_tx_ctx_mgr->is_stopped())) {
       ret = OB_PARTITION_IS_NOT_STOPPED;
       TRANS_LOG(WARN, "ls has not been stopped", K(ret), K(ls_id));
+    } else if (FALSE_IT(ls_tx_ctx_mgr->purge_retired_tx_ctx())) {
     } else if ((count = ls_tx_ctx_mgr->get_tx_ctx_count()) > 0) {
       if (REACH_TIME_INTERVAL(PRINT_LOG_INTERVAL)) {
         TRANS_LOG(WARN, "transaction context not empty, try again", KP(ls_tx_ctx_mgr), K(ls_id), K(count));
@@ -82,7 +82,8 @@ typedef common::ObSimpleIterator<ObLSTxCtxMgrStat,
 typedef common::ObSimpleIterator<ObTxLockStat,
         ObModIds::OB_TRANS_VIRTUAL_TABLE_TRANS_STAT, 16> ObTxLockStatIterator;
 
-typedef ObTransHashMap<ObTransID, ObTransCtx, TransCtxAlloc, common::SpinRWLock, 1 << 14 /*bucket_num*/> ObLSTxCtxMap;
+typedef ObTransResizableHashMap<ObTransID, ObTransCtx, TransCtxAlloc, common::SpinRWLock,
+                                1 << 10 /*min_bucket_num*/, 1 << 20 /*max_bucket_num*/> ObLSTxCtxMap;
 
 typedef common::LinkHashNode<share::ObLSID> ObLSTxCtxMgrHashNode;
 typedef common::LinkHashValue<share::ObLSID> ObLSTxCtxMgrHashValue;
@@ -270,6 +271,10 @@ public:
   // Get the TxCtx count in this ObLSTxCtxMgr;
   int64_t get_tx_ctx_count() const { return get_tx_ctx_count_(); }
 
+  // Free the TxCtx released by their last revert, which are counted in get_tx_ctx_count()
+  // until freed. It waits for the readers of ls_tx_ctx_map_ once for all of them.
+  void purge_retired_tx_ctx() { ls_tx_ctx_map_.purge_retired_values(); }
+
   // Get the count of active transactions which have not been committed or aborted
   int64_t get_active_tx_count() const { return ATOMIC_LOAD(&active_tx_count_); }
 
@@ -389,7 +394,8 @@ public:
   // @param [in] iter: tx_id information;
   int iterator_tx_id(ObTxIDIterator& iter);
 
-  // Get the buckets cnt of ObLSTxCtxMgr'hashtable, which is a constant value;
+  // Get the buckets cnt for iterating ObLSTxCtxMgr'hashtable, which is a constant value
+  // while the real buckets of the hashtable grow and shrink with the count of TxCtx;
   static int64_t get_tx_ctx_map_buckets_cnt()
   { return ObLSTxCtxMap::get_buckets_cnt(); }
 
@@ -0,0 +1,812 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_OB_TRANS_RESIZABLE_HASHMAP_
+#define OCEANBASE_STORAGE_OB_TRANS_RESIZABLE_HASHMAP_
+
+#include "lib/ob_define.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/allocator/ob_qsync.h"
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/container/ob_se_array.h"
+#include "storage/tx/ob_trans_hashmap.h"
+
+/*
+ * ObTransResizableHashMap has the same interface and the same ref semantics as
+ * ObTransHashMap (insert_and_get: ref + 2, get: ref + 1, revert: ref - 1), and
+ *
+ * 1. get() takes no lock. It walks the bucket chain in a QSync critical section of the
+ *    map and only refs the values whose ref is not 0. The last revert of a value puts it
+ *    on the retire list of the map, purge_retired_values() waits once until all the
+ *    readers quit and hands the whole list to AllocHandle::free_value. The owner calls
+ *    it periodically in background, and the reverting thread calls it itself when more
+ *    than RETIRE_LIMIT values are retired;
+ *
+ * 2. the buckets grow and shrink with the count of values, from MIN_BUCKETS_CNT to
+ *    MAX_BUCKETS_CNT. A resize installs a new table and the buckets of the old table
+ *    are moved bucket by bucket: a writer moves the buckets it is going to touch and
+ *    a small batch of others, nobody pays for moving the whole table.
+ *
+ * For Example
+ *
+ *   class ObTransCtx : public ObTransResizableHashLink<ObTransCtx>
+ *   {
+ *   public:
+ *     bool contain(const ObTransID &trans_id) const {  return trans_id == trans_id_; }
+ *   private:
+ *     ObTransID trans_id_;
+ *   };
+ *
+ *   ObTransResizableHashMap<ObTransID, ObTransCtx, ObTransCtxAlloc, common::SpinRWLock> CtxMap;
+ *
+ * More Attentions are as followed:
+ *
+ * 1) 'Key -> Value' must be 1:1, otherwise you should not use such hashmap;
+ * 2) a value deleted from the hashmap must not be inserted again;
+ * 3) for_each_in_one_bucket() visits the values with key.hash() % get_buckets_cnt() ==
+ *    bucket_pos, get_buckets_cnt() is MIN_BUCKETS_CNT whatever the current bucket count is.
+ */
+
+namespace oceanbase
+{
+namespace transaction
+{
+template<typename Value>
+class ObTransResizableHashLink : public ObTransHashLink<Value>
+{
+public:
+  ObTransResizableHashLink() : ObTransHashLink<Value>(), hash_(0), retire_next_(NULL) {}
+  ~ObTransResizableHashLink() { hash_ = 0; retire_next_ = NULL; }
+  // inc ref unless the value is being freed
+  inline bool try_inc_ref(int32_t x)
+  {
+    bool bool_ret = false;
+    int32_t ref = ATOMIC_LOAD(&this->ref_);
+    while (!bool_ret && ref > 0) {
+      int32_t old_ref = ref;
+      if (old_ref == (ref = ATOMIC_VCAS(&this->ref_, old_ref, old_ref + x))) {
+        bool_ret = true;
+      }
+    }
+    return bool_ret;
+  }
+  uint64_t hash_;
+  // link of the retire list, next_ is kept for the readers until the value is freed
+  Value *retire_next_;
+};
+
+template<typename Key, typename Value, typename AllocHandle, typename LockType,
+         int64_t MIN_BUCKETS_CNT = 64, int64_t MAX_BUCKETS_CNT = 1 << 20>
+class ObTransResizableHashMap
+{
+  typedef common::ObSEArray<Value *, 32> ValueArray;
+  STATIC_ASSERT(MIN_BUCKETS_CNT > 0 && 0 == (MIN_BUCKETS_CNT & (MIN_BUCKETS_CNT - 1)),
+                "MIN_BUCKETS_CNT must be power of 2");
+  STATIC_ASSERT(MAX_BUCKETS_CNT >= MIN_BUCKETS_CNT && 0 == (MAX_BUCKETS_CNT & (MAX_BUCKETS_CNT - 1)),
+                "MAX_BUCKETS_CNT must be power of 2");
+  // buckets of the old table moved by a writer besides the ones it touches
+  static const int64_t MIGRATE_BATCH_SIZE = 16;
+  // shrink when the count of values is less than bucket_cnt / SHRINK_FACTOR
+  static const int64_t SHRINK_FACTOR = 8;
+public:
+  // the reverting thread purges the retired values itself beyond it
+  static const int64_t RETIRE_LIMIT = 1024;
+  ObTransResizableHashMap()
+    : is_inited_(false), total_cnt_(0), table_(NULL), retire_list_(NULL), retire_cnt_(0),
+      resize_lock_(), mem_attr_(), qsync_() {}
+  ~ObTransResizableHashMap() { destroy(); }
+  int64_t count() const { return ATOMIC_LOAD(&total_cnt_); }
+  int64_t alloc_cnt() const { return alloc_handle_.get_alloc_cnt(); }
+  void reset()
+  {
+    if (is_inited_) {
+      Table *table = ATOMIC_TAS(&table_, NULL);
+      Table *prev = NULL;
+      Value *head = NULL;
+      Value *retired = ATOMIC_TAS(&retire_list_, NULL);
+      // detach all value from buckets of both the table and the table being moved
+      if (OB_NOT_NULL(table)) {
+        prev = ATOMIC_TAS(&table->prev_, NULL);
+        detach_values_(table, head);
+        if (OB_NOT_NULL(prev)) {
+          detach_values_(prev, head);
+        }
+      }
+      // no reader can see the values and the tables after the quiescent
+      WaitQuiescent(qsync_);
+      free_retired_values_(retired);
+      while (OB_NOT_NULL(head)) {
+        Value *next = head->next_;
+        // dec ref and free head value
+        if (0 == head->dec_ref(1)) {
+          alloc_handle_.free_value(head);
+        }
+        head = next;
+      }
+      destroy_table_(prev);
+      destroy_table_(table);
+      total_cnt_ = 0;
+      is_inited_ = false;
+    }
+  }
+
+  void destroy() { reset(); }
+
+  int init(const lib::ObMemAttr &mem_attr)
+  {
+    int ret = OB_SUCCESS;
+    Table *table = NULL;
+
+    if (OB_UNLIKELY(is_inited_)) {
+      ret = OB_INIT_TWICE;
+      TRANS_LOG(WARN, "ObTransResizableHashMap init twice", K(ret));
+    } else {
+      mem_attr_ = mem_attr;
+      if (OB_FAIL(create_table_(MIN_BUCKETS_CNT, NULL, table))) {
+        TRANS_LOG(WARN, "ObTransResizableHashMap create table fail", K(ret));
+      } else {
+        table_ = table;
+        is_inited_ = true;
+      }
+    }
+    return ret;
+  }
+
+  int insert_and_get(const Key &key, Value *value, Value **old_value)
+  { return insert__(key, value, 2, old_value); }
+  int insert(const Key &key, Value *value)
+  { return insert__(key, value, 1, 0); }
+  int insert__(const Key &key, Value *value, int ref, Value **old_value)
+  {
+    int ret = OB_SUCCESS;
+
+    if (IS_NOT_INIT) {
+      ret = OB_NOT_INIT;
+      TRANS_LOG(WARN, "ObTransResizableHashMap not init", K(ret), KP(value));
+    } else if (!key.is_valid() || OB_ISNULL(value)) {
+      ret = OB_INVALID_ARGUMENT;
+      TRANS_LOG(WARN, "invalid argument", K(key), KP(value));
+    } else {
+      const uint64_t hash = key.hash();
+      Table *retired_table = NULL;
+      {
+        CriticalGuard(qsync_);
+        bool done = false;
+        while (!done) {
+          Table *table = ATOMIC_LOAD(&table_);
+          Bucket &bucket = prepare_bucket_(table, hash);
+          BucketWLockGuard guard(bucket.lock_);
+          if (NORMAL != ATOMIC_LOAD(&bucket.state_)) {
+            // the table is being moved to a new one, retry on the new table
+          } else {
+            Value *curr = bucket.next_;
+            while (OB_NOT_NULL(curr)) {
+              if (curr->contain(key)) {
+                break;
+              } else {
+                curr = curr->next_;
+              }
+            }
+            if (OB_ISNULL(curr)) {
+              // inc ref when value in hashmap
+              value->inc_ref(ref);
+              value->hash_ = hash;
+              value->prev_ = NULL;
+              value->next_ = bucket.next_;
+              ATOMIC_STORE_REL(&bucket.next_, value);
+              ATOMIC_INC(&total_cnt_);
+            } else {
+              ret = OB_ENTRY_EXIST;
+              if (old_value) {
+                curr->inc_ref(1);
+                *old_value = curr;
+              }
+            }
+            done = true;
+          }
+        }
+        retired_table = do_pending_task_();
+      }
+      retire_table_(retired_table);
+    }
+    return ret;
+  }
+
+  int del(const Key &key, Value *value)
+  {
+    int ret = OB_SUCCESS;
+    bool deleted = false;
+
+    if (IS_NOT_INIT) {
+      ret = OB_NOT_INIT;
+      TRANS_LOG(WARN, "ObTransResizableHashMap not init", K(ret), KP(value));
+    } else if (!key.is_valid() || OB_ISNULL(value)) {
+      ret = OB_INVALID_ARGUMENT;
+      TRANS_LOG(ERROR, "invalid argument", K(key), KP(value));
+    } else {
+      del_from_bucket_(key.hash(), value, deleted);
+      if (deleted) {
+        revert(value);
+      }
+    }
+    return ret;
+  }
+
+  int get(const Key &key, Value *&value)
+  {
+    int ret = OB_SUCCESS;
+
+    if (IS_NOT_INIT) {
+      ret = OB_NOT_INIT;
+      TRANS_LOG(WARN, "ObTransResizableHashMap not init", K(ret), K(key));
+    } else if (!key.is_valid()) {
+      ret = OB_INVALID_ARGUMENT;
+      TRANS_LOG(WARN, "invalid argument", K(key));
+    } else {
+      const uint64_t hash = key.hash();
+      Value *tmp_value = NULL;
+      CriticalGuard(qsync_);
+      Table *table = ATOMIC_LOAD(&table_);
+      Table *prev = ATOMIC_LOAD(&table->prev_);
+      // the value stays in the old table until its bucket is moved
+      if (OB_NOT_NULL(prev) && MIGRATED != ATOMIC_LOAD(&locate_(prev, hash).state_)) {
+        table = prev;
+      }
+      while (OB_ISNULL(tmp_value) && OB_NOT_NULL(table)) {
+        Bucket &bucket = locate_(table, hash);
+        Value *curr = ATOMIC_LOAD_ACQ(&bucket.next_);
+        while (OB_NOT_NULL(curr)) {
+          // a value with ref 0 is deleted and being freed, skip it
+          if (curr->contain(key) && curr->try_inc_ref(1)) {
+            tmp_value = curr;
+            break;
+          } else {
+            curr = ATOMIC_LOAD_ACQ(&curr->next_);
+          }
+        }
+        if (OB_ISNULL(tmp_value)) {
+          // the chain may be rebuilt while walking through it when the bucket is moved,
+          // look up the new table after the bucket is moved
+          int64_t state = ATOMIC_LOAD(&bucket.state_);
+          while (MIGRATING == state) {
+            PAUSE();
+            state = ATOMIC_LOAD(&bucket.state_);
+          }
+          table = (NORMAL == state) ? NULL : ATOMIC_LOAD(&table->next_);
+        }
+      }
+
+      if (OB_ISNULL(tmp_value)) {
+        ret = OB_ENTRY_NOT_EXIST;
+      } else {
+        value = tmp_value;
+      }
+    }
+    return ret;
+  }
+
+  void revert(Value *value)
+  {
+    if (OB_NOT_NULL(value)) {
+      if (0 == value->dec_ref(1)) {
+        retire_value_(value);
+      }
+    }
+  }
+
+  // must be called out of critical section,
+  // free the values retired before after a single quiescent
+  void purge_retired_values()
+  {
+    Value *head = ATOMIC_TAS(&retire_list_, NULL);
+    if (OB_NOT_NULL(head)) {
+      // wait until no reader is visiting any of the values
+      WaitQuiescent(qsync_);
+      free_retired_values_(head);
+    }
+  }
+
+  int64_t get_retired_cnt() const { return ATOMIC_LOAD(&retire_cnt_); }
+
+  template <typename Function> int for_each(Function &fn)
+  {
+    int ret = common::OB_SUCCESS;
+    for (int64_t pos = 0 ; OB_SUCC(ret) && pos < MIN_BUCKETS_CNT; ++pos) {
+      ret = for_each_in_one_bucket(fn, pos);
+    }
+    return ret;
+  }
+
+  template <typename Function> int for_each_in_one_bucket(Function& fn, int64_t bucket_pos)
+  {
+    int ret = common::OB_SUCCESS;
+    if (bucket_pos < 0 || bucket_pos >= MIN_BUCKETS_CNT) {
+      ret = OB_INVALID_ARGUMENT;
+    } else if (IS_NOT_INIT) {
+      ret = OB_NOT_INIT;
+    } else {
+      ValueArray array;
+      if (OB_FAIL(generate_value_arr_(bucket_pos, array))) {
+        TRANS_LOG(WARN, "generate value array error", K(ret));
+      } else {
+        const int64_t cnt = array.count();
+        for (int64_t i = 0; i < cnt; ++i) {
+          if (OB_SUCC(ret) && !fn(array.at(i))) {
+            ret = OB_EAGAIN;
+          }
+          revert(array.at(i));
+        }
+      }
+    }
+    return ret;
+  }
+
+  template <typename Function> int remove_if(Function &fn)
+  {
+    int ret = common::OB_SUCCESS;
+
+    ValueArray array;
+    for (int64_t pos = 0 ; is_inited_ && pos < MIN_BUCKETS_CNT; ++pos) {
+      array.reset();
+      if (OB_FAIL(generate_value_arr_(pos, array))) {
+        TRANS_LOG(WARN, "generate value array error", K(ret));
+      } else {
+        const int64_t cnt = array.count();
+        for (int64_t i = 0; i < cnt; ++i) {
+          if (fn(array.at(i))) {
+            // the same as ObTransHashMap, the ref of hashmap is not released
+            bool deleted = false;
+            del_from_bucket_(array.at(i)->hash_, array.at(i), deleted);
+          }
+          revert(array.at(i));
+        }
+      }
+    }
+    return ret;
+  }
+
+  int alloc_value(Value *&value)
+  {
+    int ret = common::OB_SUCCESS;
+    if (NULL == (value = alloc_handle_.alloc_value())) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+    }
+    return ret;
+  }
+
+  // free the value which has never been inserted
+  void free_value(Value *value)
+  {
+    if (OB_NOT_NULL(value)) {
+      alloc_handle_.free_value(value);
+    }
+  }
+
+  int64_t get_total_cnt() {
+    return ATOMIC_LOAD(&total_cnt_);
+  }
+
+  static int64_t get_buckets_cnt() {
+    return MIN_BUCKETS_CNT;
+  }
+
+  // bucket count of the current table
+  int64_t get_cur_buckets_cnt() {
+    int64_t cnt = 0;
+    if (is_inited_) {
+      CriticalGuard(qsync_);
+      cnt = ATOMIC_LOAD(&table_)->bucket_cnt_;
+    }
+    return cnt;
+  }
+private:
+  enum BucketState
+  {
+    NORMAL = 0,
+    // the chain is being moved to the new table
+    MIGRATING = 1,
+    // all values are in the new table
+    MIGRATED = 2,
+  };
+
+  struct Bucket
+  {
+    Value *next_;
+    int64_t state_;
+    LockType lock_;
+
+    Bucket() : next_(NULL), state_(NORMAL) {}
+    ~Bucket() { lock_.destroy(); }
+  };
+
+  struct Table
+  {
+    Table(const int64_t bucket_cnt, Table *prev)
+      : bucket_cnt_(bucket_cnt), prev_(prev), next_(NULL), migrate_pos_(0), migrated_cnt_(0) {}
+    ~Table() {}
+    static int64_t calc_nbytes(const int64_t bucket_cnt)
+    { return sizeof(Table) + bucket_cnt * sizeof(Bucket); }
+    int64_t bucket_cnt_;
+    // the table being moved to this one, it is reset when all its buckets are moved
+    Table *prev_;
+    // the table this one is moved to
+    Table *next_;
+    // the next bucket to be moved in batch
+    int64_t migrate_pos_;
+    int64_t migrated_cnt_;
+    Bucket buckets_[0];
+  };
+
+  class BucketRLockGuard
+  {
+  public:
+    explicit BucketRLockGuard(const LockType &lock)
+        : lock_(const_cast<LockType &>(lock)), ret_(OB_SUCCESS)
+    {
+      if (OB_UNLIKELY(OB_SUCCESS != (ret_ = lock_.rdlock()))) {
+        COMMON_LOG_RET(WARN, ret_, "Fail to read lock, ", K_(ret));
+      }
+    }
+    ~BucketRLockGuard()
+    {
+      if (OB_LIKELY(OB_SUCCESS == ret_)) {
+        lock_.rdunlock();
+      }
+    }
+    inline int get_ret() const { return ret_; }
+  private:
+    LockType &lock_;
+    int ret_;
+  private:
+    DISALLOW_COPY_AND_ASSIGN(BucketRLockGuard);
+  };
+
+  class BucketWLockGuard
+  {
+  public:
+    explicit BucketWLockGuard(const LockType &lock)
+        : lock_(const_cast<LockType &>(lock)), ret_(OB_SUCCESS)
+    {
+      if (OB_UNLIKELY(OB_SUCCESS != (ret_ = lock_.wrlock()))) {
+        COMMON_LOG_RET(WARN, ret_, "Fail to write lock, ", K_(ret));
+      }
+    }
+    ~BucketWLockGuard()
+    {
+      if (OB_LIKELY(OB_SUCCESS == ret_)) {
+        lock_.wrunlock();
+      }
+    }
+    inline int get_ret() const { return ret_; }
+  private:
+    LockType &lock_;
+    int ret_;
+  private:
+    DISALLOW_COPY_AND_ASSIGN(BucketWLockGuard);
+  };
+
+  static Bucket &locate_(Table *table, const uint64_t hash)
+  {
+    return table->buckets_[hash & (table->bucket_cnt_ - 1)];
+  }
+
+  // must be called out of critical section, the ref of hashmap is not released
+  void del_from_bucket_(const uint64_t hash, Value *value, bool &deleted)
+  {
+    Table *retired_table = NULL;
+    deleted = false;
+    {
+      CriticalGuard(qsync_);
+      bool done = false;
+      while (!done) {
+        Table *table = ATOMIC_LOAD(&table_);
+        Bucket &bucket = prepare_bucket_(table, hash);
+        BucketWLockGuard guard(bucket.lock_);
+        if (NORMAL != ATOMIC_LOAD(&bucket.state_)) {
+          // the table is being moved to a new one, retry on the new table
+        } else {
+          Value **pos = &bucket.next_;
+          while (OB_NOT_NULL(*pos) && *pos != value) {
+            pos = &(*pos)->next_;
+          }
+          // the value may have been deleted
+          if (OB_NOT_NULL(*pos)) {
+            // keep the next_ of the deleted value, readers may be still on it
+            ATOMIC_STORE_REL(pos, value->next_);
+            ATOMIC_DEC(&total_cnt_);
+            deleted = true;
+          }
+          done = true;
+        }
+      }
+      retired_table = do_pending_task_();
+    }
+    retire_table_(retired_table);
+  }
+
+  int generate_value_arr_(const int64_t bucket_pos, ValueArray &arr)
+  {
+    int ret = OB_EAGAIN;
+    while (OB_EAGAIN == ret) {
+      Table *retired_table = NULL;
+      {
+        CriticalGuard(qsync_);
+        ret = generate_value_arr_in_table_(ATOMIC_LOAD(&table_), bucket_pos, arr);
+        retired_table = do_pending_task_();
+      }
+      retire_table_(retired_table);
+      if (OB_FAIL(ret)) {
+        // revert outside the critical section, which may wait for quiescent
+        const int64_t cnt = arr.count();
+        for (int64_t i = 0; i < cnt; ++i) {
+          revert(arr.at(i));
+        }
+        arr.reset();
+      }
+    }
+    return ret;
+  }
+
+  // must be called in critical section,
+  // collect values of buckets whose pos % MIN_BUCKETS_CNT == bucket_pos
+  int generate_value_arr_in_table_(Table *table, const int64_t bucket_pos, ValueArray &arr)
+  {
+    int ret = common::OB_SUCCESS;
+    for (int64_t pos = bucket_pos; OB_SUCC(ret) && pos < table->bucket_cnt_; pos += MIN_BUCKETS_CNT) {
+      Bucket &bucket = prepare_bucket_(table, pos);
+      // read lock
+      BucketRLockGuard guard(bucket.lock_);
+      if (NORMAL != ATOMIC_LOAD(&bucket.state_)) {
+        // the table is being moved to a new one, collect from the new table again
+        ret = OB_EAGAIN;
+      } else {
+        Value *val = bucket.next_;
+        while (OB_SUCC(ret) && OB_NOT_NULL(val)) {
+          val->inc_ref(1);
+          if (OB_FAIL(arr.push_back(val))) {
+            TRANS_LOG(WARN, "value array push back error", K(ret));
+            // the value is still in hashmap, its ref can not be 0
+            val->dec_ref(1);
+          }
+          val = val->next_;
+        }
+      }
+    }
+    return ret;
+  }
+
+  // must be called in critical section,
+  // move the buckets of the old table whose values may belong to the bucket of hash
+  Bucket &prepare_bucket_(Table *table, const uint64_t hash)
+  {
+    Table *prev = ATOMIC_LOAD(&table->prev_);
+    const int64_t pos = hash & (table->bucket_cnt_ - 1);
+    if (OB_NOT_NULL(prev)) {
+      // one bucket when the table grows, two buckets when it shrinks
+      for (int64_t i = pos & (prev->bucket_cnt_ - 1); i < prev->bucket_cnt_; i += table->bucket_cnt_) {
+        migrate_bucket_(prev, i);
+      }
+    }
+    return table->buckets_[pos];
+  }
+
+  // must be called in critical section
+  void migrate_bucket_(Table *table, const int64_t pos)
+  {
+    Bucket &bucket = table->buckets_[pos];
+    if (MIGRATED != ATOMIC_LOAD(&bucket.state_)) {
+      BucketWLockGuard guard(bucket.lock_);
+      if (NORMAL == bucket.state_) {
+        Table *next_table = ATOMIC_LOAD(&table->next_);
+        // the first pos is where the values stay when the table grows
+        const int64_t first_pos = pos & (next_table->bucket_cnt_ - 1);
+        Value *tails[2] = { NULL, NULL };
+        Value *curr = bucket.next_;
+        ATOMIC_STORE(&bucket.state_, MIGRATING);
+        while (OB_NOT_NULL(curr)) {
+          Value *next = curr->next_;
+          const int64_t next_pos = curr->hash_ & (next_table->bucket_cnt_ - 1);
+          Bucket &next_bucket = next_table->buckets_[next_pos];
+          Value *&tail = tails[next_pos == first_pos ? 0 : 1];
+          // append to the tail of the new chain to keep the order of the values, so
+          // readers walking through the old chain never go back
+          ATOMIC_STORE(&curr->next_, NULL);
+          if (OB_ISNULL(tail)) {
+            // the other bucket of the old table may have been moved here when shrinking
+            tail = next_bucket.next_;
+            while (OB_NOT_NULL(tail) && OB_NOT_NULL(tail->next_)) {
+              tail = tail->next_;
+            }
+          }
+          if (OB_ISNULL(tail)) {
+            ATOMIC_STORE_REL(&next_bucket.next_, curr);
+          } else {
+            ATOMIC_STORE_REL(&tail->next_, curr);
+          }
+          tail = curr;
+          curr = next;
+        }
+        ATOMIC_STORE(&bucket.next_, NULL);
+        ATOMIC_STORE(&bucket.state_, MIGRATED);
+        ATOMIC_INC(&table->migrated_cnt_);
+      }
+    }
+  }
+
+  // must be called in critical section,
+  // move a batch of buckets of the old table, and detach the old table if all of its
+  // buckets are moved, or start a resize if the count of values is out of range
+  Table *do_pending_task_()
+  {
+    Table *retired_table = NULL;
+    Table *table = ATOMIC_LOAD(&table_);
+    Table *prev = ATOMIC_LOAD(&table->prev_);
+    if (OB_NOT_NULL(prev)) {
+      int64_t start = 0;
+      if (ATOMIC_LOAD(&prev->migrate_pos_) < prev->bucket_cnt_
+          && (start = ATOMIC_FAA(&prev->migrate_pos_, MIGRATE_BATCH_SIZE)) < prev->bucket_cnt_) {
+        const int64_t end = MIN(start + MIGRATE_BATCH_SIZE, prev->bucket_cnt_);
+        for (int64_t pos = start; pos < end; ++pos) {
+          migrate_bucket_(prev, pos);
+        }
+      }
+      if (prev->bucket_cnt_ == ATOMIC_LOAD(&prev->migrated_cnt_)
+          && ATOMIC_BCAS(&table->prev_, prev, NULL)) {
+        retired_table = prev;
+      }
+    } else {
+      try_resize_(table);
+    }
+    return retired_table;
+  }
+
+  // must be called in critical section
+  void try_resize_(Table *table)
+  {
+    int tmp_ret = OB_SUCCESS;
+    const int64_t total_cnt = ATOMIC_LOAD(&total_cnt_);
+    const int64_t bucket_cnt = table->bucket_cnt_;
+    int64_t new_bucket_cnt = bucket_cnt;
+    if (total_cnt > bucket_cnt && bucket_cnt < MAX_BUCKETS_CNT) {
+      new_bucket_cnt = bucket_cnt << 1;
+    } else if (total_cnt < bucket_cnt / SHRINK_FACTOR && bucket_cnt > MIN_BUCKETS_CNT) {
+      new_bucket_cnt = bucket_cnt >> 1;
+    }
+    if (new_bucket_cnt != bucket_cnt && OB_SUCCESS == resize_lock_.trylock()) {
+      Table *new_table = NULL;
+      if (table != ATOMIC_LOAD(&table_) || OB_NOT_NULL(ATOMIC_LOAD(&table->prev_))) {
+        // resized by others
+      } else if (OB_TMP_FAIL(create_table_(new_bucket_cnt, table, new_table))) {
+        TRANS_LOG_RET(WARN, tmp_ret, "create table fail", K(bucket_cnt), K(new_bucket_cnt), K(total_cnt));
+      } else {
+        ATOMIC_STORE(&table->next_, new_table);
+        ATOMIC_STORE(&table_, new_table);
+        TRANS_LOG(INFO, "ObTransResizableHashMap resize", KP(this), K(bucket_cnt), K(new_bucket_cnt), K(total_cnt));
+      }
+      (void)resize_lock_.unlock();
+    }
+  }
+
+  int create_table_(const int64_t bucket_cnt, Table *prev, Table *&table)
+  {
+    int ret = OB_SUCCESS;
+    void *buf = NULL;
+    if (OB_ISNULL(buf = ob_malloc(Table::calc_nbytes(bucket_cnt), mem_attr_))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      TRANS_LOG(WARN, "alloc table fail", K(ret), K(bucket_cnt));
+    } else {
+      table = new (buf) Table(bucket_cnt, prev);
+      int64_t i = 0;
+      for (; OB_SUCC(ret) && i < bucket_cnt; ++i) {
+        Bucket *bucket = new (table->buckets_ + i) Bucket();
+        if (OB_FAIL(bucket->lock_.init(mem_attr_))) {
+          TRANS_LOG(WARN, "bucket lock init fail", K(ret));
+          bucket->~Bucket();
+        }
+      }
+      if (OB_FAIL(ret)) {
+        for (int64_t j = 0; j < i - 1; ++j) {
+          table->buckets_[j].~Bucket();
+        }
+        table->~Table();
+        ob_free(buf);
+        table = NULL;
+      }
+    }
+    return ret;
+  }
+
+  void destroy_table_(Table *table)
+  {
+    if (OB_NOT_NULL(table)) {
+      for (int64_t i = 0; i < table->bucket_cnt_; ++i) {
+        table->buckets_[i].~Bucket();
+      }
+      table->~Table();
+      ob_free(table);
+    }
+  }
+
+  // must be called out of critical section
+  void retire_table_(Table *table)
+  {
+    if (OB_NOT_NULL(table)) {
+      // wait until no reader is in the table
+      WaitQuiescent(qsync_);
+      TRANS_LOG(INFO, "ObTransResizableHashMap retire table", KP(this), KP(table), K(table->bucket_cnt_));
+      destroy_table_(table);
+    }
+  }
+
+  // must be called out of critical section,
+  // the value is freed by the next purge, readers may be still on it
+  void retire_value_(Value *value)
+  {
+    Value *head = ATOMIC_LOAD(&retire_list_);
+    Value *old_head = NULL;
+    do {
+      old_head = head;
+      value->retire_next_ = old_head;
+    } while (old_head != (head = ATOMIC_VCAS(&retire_list_, old_head, value)));
+    if (ATOMIC_AAF(&retire_cnt_, 1) > RETIRE_LIMIT) {
+      purge_retired_values();
+    }
+  }
+
+  // must be called after quiescent
+  void free_retired_values_(Value *head)
+  {
+    while (OB_NOT_NULL(head)) {
+      Value *next = head->retire_next_;
+      head->retire_next_ = NULL;
+      alloc_handle_.free_value(head);
+      ATOMIC_DEC(&retire_cnt_);
+      head = next;
+    }
+  }
+
+  void detach_values_(Table *table, Value *&head)
+  {
+    for (int64_t i = 0; i < table->bucket_cnt_; ++i) {
+      BucketWLockGuard guard(table->buckets_[i].lock_);
+      Value *curr = table->buckets_[i].next_;
+      table->buckets_[i].next_ = NULL;
+      while (OB_NOT_NULL(curr)) {
+        Value *next = curr->next_;
+        curr->next_ = head;
+        head = curr;
+        ATOMIC_DEC(&total_cnt_);
+        curr = next;
+      }
+    }
+  }
+
+private:
+  bool is_inited_;
+  int64_t total_cnt_;
+  Table *table_;
+  // values whose last ref is released, linked by retire_next_
+  Value *retire_list_;
+  int64_t retire_cnt_;
+  common::ObSpinLock resize_lock_;
+  lib::ObMemAttr mem_attr_;
+  // readers of this map only, a purge does not wait for the other maps
+  common::ObQSync qsync_;
+#ifndef NDEBUG
+public:
+#endif
+  AllocHandle alloc_handle_;
+};
+
+}
+}
+#endif // OCEANBASE_STORAGE_OB_TRANS_RESIZABLE_HASHMAP_
@@ -195,6 +195,9 @@ int ObTxLoopWorker::scan_all_ls_(bool can_tx_gc, bool can_gc_retain_ctx)
       if (can_gc_retain_ctx) {
         do_retain_ctx_gc_(cur_ls_ptr);
       }
+
+      // free the tx ctx released since last loop, interval = 100ms
+      do_purge_retired_ctx_(cur_ls_ptr);
     }
   }
 
@@ -281,6 +284,17 @@ void ObTxLoopWorker::do_retain_ctx_gc_(ObLS *ls_ptr)
   UNUSED(ret);
 }
 
+void ObTxLoopWorker::do_purge_retired_ctx_(ObLS *ls_ptr)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_FAIL(ls_ptr->get_tx_svr()->purge_retired_tx_ctx())) {
+    TRANS_LOG(WARN, "[Tx Loop Worker] purge retired tx ctx failed", K(ret), K(MTL_ID()), K(*ls_ptr));
+  }
+
+  UNUSED(ret);
+}
+
 }
 }
 
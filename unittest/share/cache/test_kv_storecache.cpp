@@ -396,6 +396,130 @@ TEST_F(TestKVCache, test_func)
   ASSERT_NE(OB_SUCCESS, ret);
 }
 
+TEST(ObKVCacheAdmissionFilter, normal)
+{
+  ObKVCacheAdmissionFilter filter;
+  ASSERT_TRUE(filter.record_and_admit(1));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, filter.init(OB_SERVER_TENANT_ID, 1000));
+  ASSERT_EQ(OB_SUCCESS, filter.init(OB_SERVER_TENANT_ID, 1024));
+  ASSERT_EQ(OB_INIT_TWICE, filter.init(OB_SERVER_TENANT_ID, 1024));
+
+  // nothing washed, admitted at the first put
+  ASSERT_EQ(0, filter.get_victim_frequency());
+  ASSERT_TRUE(filter.record_and_admit(100));
+  ASSERT_EQ(1, filter.estimate(100));
+
+  // admitted only if more frequent than the wash victims
+  filter.add_victim_sample(1);
+  filter.add_victim_sample(2);
+  filter.add_victim_sample(3);
+  filter.refresh_victim_frequency();
+  ASSERT_EQ(2, filter.get_victim_frequency());
+  ASSERT_FALSE(filter.record_and_admit(200));
+  ASSERT_FALSE(filter.record_and_admit(200));
+  ASSERT_TRUE(filter.record_and_admit(200));
+
+  // no victim sampled in the next wash round, the cache is not full any more
+  filter.refresh_victim_frequency();
+  ASSERT_EQ(0, filter.get_victim_frequency());
+  ASSERT_TRUE(filter.record_and_admit(300));
+
+  for (int64_t i = 0; i < 100; ++i) {
+    filter.record(100);
+  }
+  ASSERT_EQ(ObKVCacheAdmissionFilter::MAX_FREQUENCY, filter.estimate(100));
+
+  // counters are halved after SAMPLE_FACTOR * width records
+  for (uint64_t i = 1000; i < 1000 + ObKVCacheAdmissionFilter::SAMPLE_FACTOR * 1024; ++i) {
+    filter.record(i);
+  }
+  ASSERT_GE(filter.estimate(100), ObKVCacheAdmissionFilter::MAX_FREQUENCY / 2);
+  ASSERT_LT(filter.estimate(100), ObKVCacheAdmissionFilter::MAX_FREQUENCY);
+  filter.destroy();
+  ASSERT_TRUE(filter.record_and_admit(1));
+
+  // keys put once by a scan can not replace the kvs hit before
+  int64_t admit_cnt = 0;
+  ASSERT_EQ(OB_SUCCESS, filter.init(OB_SERVER_TENANT_ID));
+  filter.add_victim_sample(1);
+  filter.refresh_victim_frequency();
+  for (uint64_t i = 0; i < 10000; ++i) {
+    if (filter.record_and_admit(i)) {
+      ++admit_cnt;
+    }
+  }
+  ASSERT_LT(admit_cnt, 100);
+}
+
+TEST_F(TestKVCache, test_admission_filter)
+{
+  typedef TestKVCacheKey<16> TestKey;
+  typedef TestKVCacheValue<64> TestValue;
+  ObKVCache<TestKey, TestValue> cache;
+  TestKey key;
+  TestValue value;
+  const TestValue *pvalue = NULL;
+  ObKVCacheHandle handle;
+  ObKVCacheInstHandle inst_handle;
+  key.v_ = 900;
+  key.tenant_id_ = tenant_id_;
+  value.v_ = 4321;
+
+  ASSERT_EQ(OB_SUCCESS, cache.init("test_admit"));
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().reload_admission_filter("bf_cache, test_admit"));
+  // admitted while the cache is not full
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(value.v_, pvalue->v_);
+  ObKVCacheInstKey inst_key(cache.cache_id_, tenant_id_);
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().insts_.get_cache_inst(inst_key, inst_handle));
+  ObKVCacheInst &inst = *inst_handle.get_inst();
+  ASSERT_TRUE(inst.admission_filter_.is_inited());
+  // the put and the hit
+  ASSERT_EQ(2, inst.admission_filter_.estimate(key.hash()));
+
+  // the memblock is sampled as wash victim when nobody else refers to it
+  ObKVMemBlockHandle *mb_handle = handle.mb_handle_;
+  ObKVCacheStore &store = ObKVGlobalCache::get_instance().store_;
+  ATOMIC_STORE(&mb_handle->status_, FULL);
+  store.sample_admission_victim(mb_handle);
+  inst.admission_filter_.refresh_victim_frequency();
+  ASSERT_EQ(0, inst.admission_filter_.get_victim_frequency());
+  handle.reset();
+  store.sample_admission_victim(mb_handle);
+  inst.admission_filter_.refresh_victim_frequency();
+  ATOMIC_STORE(&mb_handle->status_, USING);
+  ASSERT_EQ(2, inst.admission_filter_.get_victim_frequency());
+
+  // rejected under memory pressure until it is more frequent than the victims
+  key.v_ = 901;
+  inst.admission_filter_.add_victim_sample(2);
+  inst.admission_filter_.refresh_victim_frequency();
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(key, pvalue, handle));
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(key, pvalue, handle));
+  ASSERT_EQ(2, inst.status_.admission_reject_cnt_.value());
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  handle.reset();
+
+  // checked by callers of alloc() and put_kvpair() before the kvpair is allocated
+  key.v_ = 903;
+  ASSERT_FALSE(cache.admit(key));
+  ASSERT_EQ(3, inst.status_.admission_reject_cnt_.value());
+
+  // disabled
+  key.v_ = 902;
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().reload_admission_filter(""));
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  handle.reset();
+  ASSERT_EQ(2, inst.status_.admission_reject_cnt_.value());
+  inst_handle.reset();
+  cache.destroy();
+}
+
 TEST_F(TestKVCache, test_large_kv)
 {
   static const int64_t K_SIZE = 16;
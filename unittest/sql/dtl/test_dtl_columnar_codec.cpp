@@ -0,0 +1,196 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_DTL
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include "lib/allocator/page_arena.h"
+#include "sql/dtl/ob_dtl_columnar_codec.h"
+#include "sql/engine/basic/ob_chunk_datum_store.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+namespace dtl
+{
+using namespace common;
+
+class TestDtlColumnarCodec : public ::testing::Test
+{
+public:
+  static const int64_t COL_CNT = 4;
+  static const int64_t BLOCK_SIZE = 1L << 20;
+
+  TestDtlColumnarCodec() : alloc_("TestColumnar"), blk_(NULL) {}
+
+  virtual void SetUp() override
+  {
+    char *mem = static_cast<char *>(alloc_.alloc(BLOCK_SIZE));
+    ASSERT_TRUE(NULL != mem);
+    ASSERT_EQ(OB_SUCCESS, ObChunkDatumStore::init_block_buffer(mem, BLOCK_SIZE, blk_));
+  }
+
+  // col 0: low cardinality string, col 1: sorted runs, col 2: narrow range int64,
+  // col 3: distinct string with nulls
+  void append_rows(const int64_t cnt)
+  {
+    const char *dict[] = { "beijing", "shanghai", "hangzhou" };
+    char str[64];
+    for (int64_t i = 0; i < cnt; i++) {
+      ObDatum datums[COL_CNT];
+      int64_t runs = i / 100;
+      int64_t v = 1000000 + i % 50;
+      datums[0].ptr_ = dict[i % 3];
+      datums[0].pack_ = static_cast<uint32_t>(strlen(dict[i % 3]));
+      datums[1].ptr_ = reinterpret_cast<const char *>(&runs);
+      datums[1].pack_ = sizeof(runs);
+      datums[2].ptr_ = reinterpret_cast<const char *>(&v);
+      datums[2].pack_ = sizeof(v);
+      if (0 == i % 7) {
+        datums[3].set_null();
+      } else {
+        int64_t len = snprintf(str, sizeof(str), "row_%ld_%ld", i, i * 7919);
+        datums[3].ptr_ = str;
+        datums[3].pack_ = static_cast<uint32_t>(len);
+      }
+      ASSERT_EQ(OB_SUCCESS, blk_->copy_datums(datums, COL_CNT, 0, NULL));
+    }
+  }
+
+  void verify_rows(const char *buf, const int64_t batch_size)
+  {
+    const int64_t rows = ObDtlColumnarDecoder::get_row_cnt(buf);
+    ObArenaAllocator decode_alloc;
+    ObDatum *datums = static_cast<ObDatum *>(alloc_.alloc(sizeof(ObDatum) * batch_size));
+    ASSERT_TRUE(NULL != datums);
+    for (int64_t col_idx = 0; col_idx < COL_CNT; col_idx++) {
+      int64_t cur_pos = 0;
+      for (int64_t start = 0; start < rows; start += batch_size) {
+        const int64_t cnt = std::min(batch_size, rows - start);
+        ASSERT_EQ(OB_SUCCESS, ObDtlColumnarDecoder::decode(buf, col_idx, start, cnt,
+                                                           datums, decode_alloc));
+        for (int64_t i = 0; i < cnt; i++) {
+          const ObChunkDatumStore::StoredRow *sr = NULL;
+          ASSERT_EQ(OB_SUCCESS, blk_->get_store_row(cur_pos, sr));
+          const ObDatum &expect = sr->cells()[col_idx];
+          ASSERT_EQ(expect.is_null(), datums[i].is_null());
+          if (!expect.is_null()) {
+            ASSERT_EQ(expect.len_, datums[i].len_);
+            ASSERT_EQ(0, MEMCMP(expect.ptr_, datums[i].ptr_, expect.len_));
+          }
+        }
+        decode_alloc.reuse();
+      }
+    }
+  }
+
+  uint8_t encoding(const char *buf, const int64_t col_idx)
+  {
+    const ObDtlColumnarHeader *header = reinterpret_cast<const ObDtlColumnarHeader *>(buf);
+    return reinterpret_cast<const ObDtlColumnarColumnHeader *>(
+        buf + header->col_offsets_[col_idx])->encoding_;
+  }
+
+protected:
+  ObArenaAllocator alloc_;
+  ObChunkDatumStore::Block *blk_;
+};
+
+TEST_F(TestDtlColumnarCodec, encode_decode)
+{
+  const int64_t rows = 2000;
+  append_rows(rows);
+  const int64_t blk_size = blk_->data_size();
+  char *buf = static_cast<char *>(alloc_.alloc(blk_size));
+  ASSERT_TRUE(NULL != buf);
+  int64_t size = 0;
+  bool encoded = false;
+  ASSERT_EQ(OB_SUCCESS, ObDtlColumnarEncoder::encode(alloc_, *blk_, buf, blk_size,
+                                                     size, encoded));
+  ASSERT_TRUE(encoded);
+  ASSERT_LT(size, blk_size);
+  LOG_INFO("columnar encoded", K(blk_size), K(size));
+  ASSERT_EQ(rows, ObDtlColumnarDecoder::get_row_cnt(buf));
+  ASSERT_EQ(COL_CNT, ObDtlColumnarDecoder::get_col_cnt(buf));
+  ASSERT_EQ(ObDtlColumnarColumnHeader::DICT, encoding(buf, 0));
+  ASSERT_EQ(ObDtlColumnarColumnHeader::RLE, encoding(buf, 1));
+  ASSERT_EQ(ObDtlColumnarColumnHeader::BIT_PACK, encoding(buf, 2));
+  ASSERT_EQ(ObDtlColumnarColumnHeader::RAW, encoding(buf, 3));
+
+  verify_rows(buf, 1);
+  verify_rows(buf, 256);
+  verify_rows(buf, 333);
+}
+
+// row iteration of receive op decodes row i into batch slot i and keeps the decoded
+// memory for the whole message, earlier rows of the batch must stay valid.
+TEST_F(TestDtlColumnarCodec, decode_row_to_slot)
+{
+  const int64_t rows = 500;
+  append_rows(rows);
+  const int64_t blk_size = blk_->data_size();
+  char *buf = static_cast<char *>(alloc_.alloc(blk_size));
+  ASSERT_TRUE(NULL != buf);
+  int64_t size = 0;
+  bool encoded = false;
+  ASSERT_EQ(OB_SUCCESS, ObDtlColumnarEncoder::encode(alloc_, *blk_, buf, blk_size,
+                                                     size, encoded));
+  ASSERT_TRUE(encoded);
+  ObArenaAllocator decode_alloc;
+  ObDatum *datums = static_cast<ObDatum *>(alloc_.alloc(sizeof(ObDatum) * rows * COL_CNT));
+  ASSERT_TRUE(NULL != datums);
+  for (int64_t i = 0; i < rows; i++) {
+    for (int64_t col_idx = 0; col_idx < COL_CNT; col_idx++) {
+      ASSERT_EQ(OB_SUCCESS, ObDtlColumnarDecoder::decode(buf, col_idx, i, 1,
+                                                         datums + col_idx * rows + i,
+                                                         decode_alloc));
+    }
+  }
+  int64_t cur_pos = 0;
+  for (int64_t i = 0; i < rows; i++) {
+    const ObChunkDatumStore::StoredRow *sr = NULL;
+    ASSERT_EQ(OB_SUCCESS, blk_->get_store_row(cur_pos, sr));
+    for (int64_t col_idx = 0; col_idx < COL_CNT; col_idx++) {
+      const ObDatum &expect = sr->cells()[col_idx];
+      const ObDatum &d = datums[col_idx * rows + i];
+      ASSERT_EQ(expect.is_null(), d.is_null());
+      if (!expect.is_null()) {
+        ASSERT_EQ(expect.len_, d.len_);
+        ASSERT_EQ(0, MEMCMP(expect.ptr_, d.ptr_, expect.len_));
+      }
+    }
+  }
+}
+
+TEST_F(TestDtlColumnarCodec, buffer_not_enough)
+{
+  append_rows(100);
+  char buf[64];
+  int64_t size = 0;
+  bool encoded = true;
+  ASSERT_EQ(OB_SUCCESS, ObDtlColumnarEncoder::encode(alloc_, *blk_, buf, sizeof(buf),
+                                                     size, encoded));
+  ASSERT_FALSE(encoded);
+}
+
+} // end namespace dtl
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
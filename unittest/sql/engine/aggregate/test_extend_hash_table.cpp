@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#include <iostream>
+#include "lib/allocator/ob_malloc.h"
+#include "lib/alloc/ob_malloc_allocator.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "sql/engine/aggregate/ob_exec_hash_struct.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+struct TestHashItem
+{
+  TestHashItem() : next_(NULL), key_(0), hash_(0) {}
+  void set_key(const int64_t key)
+  {
+    key_ = key;
+    hash_ = murmurhash(&key_, sizeof(key_), 0);
+  }
+  uint64_t hash() const { return hash_; }
+  int hash(uint64_t &hash_val) const { hash_val = hash_; return OB_SUCCESS; }
+  bool operator==(const TestHashItem &other) const { return key_ == other.key_; }
+  TestHashItem *&next() { return next_; }
+  TO_STRING_KV(K_(key), K_(hash));
+
+  TestHashItem *next_;
+  int64_t key_;
+  uint64_t hash_;
+};
+
+class TestExtendHashTable : public ::testing::Test
+{
+public:
+  TestExtendHashTable() : attr_(OB_SYS_TENANT_ID, "HashTblTest") {}
+
+  // insert %cnt distinct keys, then probe %cnt existing keys and %cnt absent keys.
+  void run(const bool tag_probe, const int64_t cnt, const int64_t probe_round,
+           int64_t &insert_us, int64_t &probe_us)
+  {
+    ObMalloc malloc;
+    malloc.set_attr(attr_);
+    ObExtendHashTable<TestHashItem> ht;
+    ht.set_tag_probe(tag_probe, false);
+    ASSERT_EQ(OB_SUCCESS, ht.init(&malloc, attr_));
+    ASSERT_EQ(tag_probe, ht.is_tag_probe());
+    TestHashItem *items = static_cast<TestHashItem *>(
+        malloc.alloc(sizeof(TestHashItem) * cnt));
+    ASSERT_TRUE(NULL != items);
+    int64_t begin = ObTimeUtil::current_time();
+    for (int64_t i = 0; i < cnt; i++) {
+      new (&items[i]) TestHashItem();
+      items[i].set_key(i * 2);
+      ASSERT_EQ(OB_SUCCESS, ht.set(items[i]));
+    }
+    insert_us = ObTimeUtil::current_time() - begin;
+    ASSERT_EQ(cnt, ht.size());
+
+    TestHashItem probe;
+    int64_t found = 0;
+    begin = ObTimeUtil::current_time();
+    for (int64_t r = 0; r < probe_round; r++) {
+      for (int64_t i = 0; i < cnt * 2; i++) {
+        // randomize access order in a deterministic way
+        probe.set_key((i * 7919) % (cnt * 2));
+        const TestHashItem *res = ht.get(probe);
+        if (NULL != res) {
+          ASSERT_EQ(probe.key_, res->key_);
+          found++;
+        } else {
+          ASSERT_EQ(1, probe.key_ % 2);
+        }
+      }
+    }
+    probe_us = ObTimeUtil::current_time() - begin;
+    ASSERT_EQ(cnt * probe_round, found);
+    ht.destroy();
+    malloc.free(items);
+  }
+
+protected:
+  lib::ObMemAttr attr_;
+};
+
+TEST_F(TestExtendHashTable, basic)
+{
+  int64_t insert_us = 0;
+  int64_t probe_us = 0;
+  // cover small table (one tag group) and rehash
+  run(false, 10, 1, insert_us, probe_us);
+  ASSERT_FALSE(HasFatalFailure());
+  run(true, 10, 1, insert_us, probe_us);
+  ASSERT_FALSE(HasFatalFailure());
+  run(false, 100000, 1, insert_us, probe_us);
+  ASSERT_FALSE(HasFatalFailure());
+  run(true, 100000, 1, insert_us, probe_us);
+  ASSERT_FALSE(HasFatalFailure());
+}
+
+TEST_F(TestExtendHashTable, same_hash_value)
+{
+  ObMalloc malloc;
+  malloc.set_attr(attr_);
+  ObExtendHashTable<TestHashItem> ht;
+  ht.set_tag_probe(true, true);
+  ASSERT_EQ(OB_SUCCESS, ht.init(&malloc, attr_));
+  ASSERT_TRUE(ht.is_inline_key());
+  TestHashItem items[3];
+  for (int64_t i = 0; i < 3; i++) {
+    items[i].set_key(i);
+    // force the same hash value, items are linked in one bucket
+    items[i].hash_ = 1024;
+    ASSERT_EQ(OB_SUCCESS, ht.set(items[i], i));
+  }
+  for (int64_t i = 0; i < 3; i++) {
+    TestHashItem probe;
+    probe.key_ = i;
+    probe.hash_ = 1024;
+    ASSERT_EQ(&items[i], ht.get(probe));
+  }
+  TestHashItem probe;
+  probe.key_ = 3;
+  probe.hash_ = 1024;
+  ASSERT_TRUE(NULL == ht.get(probe));
+  ht.reuse();
+  ASSERT_EQ(0, ht.size());
+  ASSERT_TRUE(NULL == ht.get(probe));
+}
+
+// Micro benchmark of the default layout and the tag probe layout, the hash table size
+// is far beyond the cache size.
+TEST_F(TestExtendHashTable, perf)
+{
+  const int64_t counts[] = { 1L << 10, 1L << 16, 1L << 22 };
+  for (int64_t i = 0; i < ARRAYSIZEOF(counts); i++) {
+    const int64_t cnt = counts[i];
+    const int64_t round = std::max(1L, (1L << 22) / cnt);
+    int64_t insert_us = 0;
+    int64_t probe_us = 0;
+    int64_t tag_insert_us = 0;
+    int64_t tag_probe_us = 0;
+    run(false, cnt, round, insert_us, probe_us);
+    ASSERT_FALSE(HasFatalFailure());
+    run(true, cnt, round, tag_insert_us, tag_probe_us);
+    ASSERT_FALSE(HasFatalFailure());
+    LOG_INFO("extend hash table perf", K(cnt), K(round), K(insert_us), K(probe_us),
+             K(tag_insert_us), K(tag_probe_us));
+    std::cout << "groups: " << cnt << ", probe rounds: " << round
+              << ", default layout insert/probe(us): " << insert_us << "/" << probe_us
+              << ", tag probe layout insert/probe(us): " << tag_insert_us << "/" << tag_probe_us
+              << std::endl;
+  }
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_file_name("test_extend_hash_table.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  oceanbase::lib::ObMallocAllocator::get_instance()->create_and_add_tenant_allocator(
+      oceanbase::common::OB_SYS_TENANT_ID);
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
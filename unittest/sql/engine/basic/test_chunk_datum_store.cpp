@@ -942,6 +942,49 @@ TEST_F(TestChunkDatumStore, test_only_disk_data1)
   rs.reset();
 }
 
+TEST_F(TestChunkDatumStore, test_compressed_disk_data)
+{
+  int64_t cnt = 10000;
+  LOG_INFO("starting compressed disk test: append rows", K(cnt));
+  ObChunkDatumStore rs("TEST");
+  ASSERT_EQ(OB_SUCCESS, rs.alloc_dir_id());
+  ObChunkDatumStore::Iterator it;
+  ASSERT_EQ(OB_SUCCESS, rs.init(0, tenant_id_, ctx_id_, label_));
+  rs.set_mem_limit(1L << 30);
+  rs.set_compressor_type(LZ4_COMPRESSOR);
+  // disk data
+  CALL(append_rows, rs, cnt);
+  ASSERT_EQ(OB_SUCCESS, rs.dump(false, true));
+  rs.finish_add_row();
+  ASSERT_TRUE(rs.is_compress_enabled());
+  ASSERT_GE(rs.get_compress_saved_size(), 0);
+  ASSERT_EQ(rs.get_dump_raw_size() - rs.get_file_size(), rs.get_compress_saved_size());
+
+  CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true, ObChunkDatumStore::BLOCK_SIZE);
+  it.reset();
+  CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true, 0);
+  LOG_INFO("compressed row store", K(rs.get_file_size()), K(rs.get_compress_saved_size()),
+           K(rs.is_compress_disabled_by_ratio()));
+
+  it.reset();
+  rs.reset();
+
+  // the raw size is the file size without compression
+  ObChunkDatumStore raw_rs("TEST");
+  ASSERT_EQ(OB_SUCCESS, raw_rs.alloc_dir_id());
+  ASSERT_EQ(OB_SUCCESS, raw_rs.init(0, tenant_id_, ctx_id_, label_));
+  raw_rs.set_mem_limit(1L << 30);
+  raw_rs.set_compressor_type(NONE_COMPRESSOR);
+  CALL(append_rows, raw_rs, cnt);
+  ASSERT_EQ(OB_SUCCESS, raw_rs.dump(false, true));
+  raw_rs.finish_add_row();
+  ASSERT_FALSE(raw_rs.is_compress_enabled());
+  ASSERT_GT(raw_rs.get_file_size(), 0);
+  ASSERT_EQ(raw_rs.get_file_size(), raw_rs.get_dump_raw_size());
+  ASSERT_EQ(0, raw_rs.get_compress_saved_size());
+  raw_rs.reset();
+}
+
 TEST_F(TestChunkDatumStore, test_append_block)
 {
   int ret = OB_SUCCESS;
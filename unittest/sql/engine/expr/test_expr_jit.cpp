@@ -0,0 +1,318 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include <gtest/gtest.h>
+#define private public
+#include "sql/engine/expr/ob_expr_jit.h"
+#undef private
+
+using namespace oceanbase::common;
+using namespace oceanbase::jit;
+using namespace oceanbase::sql;
+
+static int dummy_eval(const ObExpr &, ObEvalCtx &, ObDatum &)
+{
+  return OB_SUCCESS;
+}
+
+class TestExprJit : public ::testing::Test
+{
+public:
+  static const int64_t BATCH_SIZE = 100;
+  static const int64_t SKIP_WORDS = (BATCH_SIZE + 63) / 64;
+
+  TestExprJit() : allocator_("TestExprJit"), helper_(allocator_) {}
+  virtual void SetUp() { ASSERT_EQ(OB_SUCCESS, helper_.init()); }
+
+  void init_column(ObExpr &e)
+  {
+    e.type_ = T_REF_COLUMN;
+    e.datum_meta_.type_ = ObIntType;
+    e.batch_result_ = true;
+  }
+
+  void init_const(ObExpr &e)
+  {
+    e.type_ = T_INT;
+    e.datum_meta_.type_ = ObIntType;
+    e.batch_result_ = false;
+  }
+
+  void init_op(ObExpr &e, const ObItemType type, ObExpr *l, ObExpr *r, ObExpr **args)
+  {
+    e.type_ = type;
+    e.datum_meta_.type_ = ObIntType;
+    e.batch_result_ = true;
+    e.eval_func_ = dummy_eval;
+    args[0] = l;
+    args[1] = r;
+    e.args_ = args;
+    e.arg_cnt_ = 2;
+  }
+
+  int compile(ObIArray<ObExpr *> &filters, const ObIArray<ObExpr *> &evaluated,
+              ObJitFilterFunc &func)
+  {
+    int ret = OB_SUCCESS;
+    ObExprJitCompiler compiler(helper_, evaluated, leaves_, inner_exprs_);
+    if (!ObExprJitCompiler::is_jittable(filters, evaluated)) {
+      ret = OB_NOT_SUPPORTED;
+    } else if (OB_FAIL(compiler.generate(ObString("test_jit_filter"), filters))) {
+    } else {
+      helper_.compile_module(true);
+      func = reinterpret_cast<ObJitFilterFunc>(
+          helper_.get_function_address(ObString("test_jit_filter")));
+      ret = NULL == func ? OB_ERR_UNEXPECTED : OB_SUCCESS;
+    }
+    return ret;
+  }
+
+  static void set_datums(ObDatum *datums, int64_t *values, const int64_t cnt)
+  {
+    for (int64_t i = 0; i < cnt; i++) {
+      datums[i].ptr_ = reinterpret_cast<const char *>(&values[i]);
+      datums[i].pack_ = sizeof(int64_t);
+    }
+  }
+
+  static bool is_skipped(const uint64_t *skip, const int64_t i)
+  {
+    return skip[i / 64] & (1ULL << (i % 64));
+  }
+
+  static void set_skip(uint64_t *skip, const int64_t i)
+  {
+    skip[i / 64] |= 1ULL << (i % 64);
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  ObLLVMHelper helper_;
+  ObSEArray<ObExpr *, 8> leaves_;
+  ObSEArray<ObExpr *, 8> inner_exprs_;
+};
+
+// c1 > 10, NULL is not true
+TEST_F(TestExprJit, null_handling)
+{
+  ObExpr c1;
+  ObExpr ten;
+  ObExpr gt;
+  ObExpr *args[2];
+  init_column(c1);
+  init_const(ten);
+  init_op(gt, T_OP_GT, &c1, &ten, args);
+  ObSEArray<ObExpr *, 1> filters;
+  ObSEArray<ObExpr *, 1> evaluated;
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(&gt));
+  ObJitFilterFunc func = NULL;
+  ASSERT_EQ(OB_SUCCESS, compile(filters, evaluated, func));
+  ASSERT_EQ(2, leaves_.count());
+
+  int64_t c1_values[BATCH_SIZE];
+  ObDatum c1_datums[BATCH_SIZE];
+  int64_t ten_value = 10;
+  ObDatum ten_datum;
+  for (int64_t i = 0; i < BATCH_SIZE; i++) {
+    c1_values[i] = i;
+  }
+  set_datums(c1_datums, c1_values, BATCH_SIZE);
+  set_datums(&ten_datum, &ten_value, 1);
+  for (int64_t i = 0; i < BATCH_SIZE; i += 3) {
+    c1_datums[i].set_null();
+  }
+  const ObDatum *leaf_datums[2];
+  leaf_datums[leaves_.at(0) == &c1 ? 0 : 1] = c1_datums;
+  leaf_datums[leaves_.at(0) == &c1 ? 1 : 0] = &ten_datum;
+  uint64_t skip[SKIP_WORDS] = {0};
+  const int64_t cnt = func(BATCH_SIZE, reinterpret_cast<int64_t>(skip),
+                           reinterpret_cast<int64_t>(leaf_datums));
+  int64_t expect_cnt = 0;
+  for (int64_t i = 0; i < BATCH_SIZE; i++) {
+    const bool pass = !c1_datums[i].is_null() && c1_values[i] > 10;
+    expect_cnt += pass;
+    ASSERT_EQ(!pass, is_skipped(skip, i)) << "row " << i;
+  }
+  ASSERT_EQ(expect_cnt, cnt);
+}
+
+// c1 + c2 > 0, overflow of any row returns -1
+TEST_F(TestExprJit, overflow_fallback)
+{
+  ObExpr c1;
+  ObExpr c2;
+  ObExpr zero;
+  ObExpr add;
+  ObExpr gt;
+  ObExpr *add_args[2];
+  ObExpr *gt_args[2];
+  init_column(c1);
+  init_column(c2);
+  init_const(zero);
+  init_op(add, T_OP_ADD, &c1, &c2, add_args);
+  init_op(gt, T_OP_GT, &add, &zero, gt_args);
+  ObSEArray<ObExpr *, 1> filters;
+  ObSEArray<ObExpr *, 1> evaluated;
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(&gt));
+  ObJitFilterFunc func = NULL;
+  ASSERT_EQ(OB_SUCCESS, compile(filters, evaluated, func));
+  ASSERT_EQ(3, leaves_.count());
+  ASSERT_TRUE(has_exist_in_array(inner_exprs_, &add));
+  ASSERT_TRUE(has_exist_in_array(inner_exprs_, &gt));
+
+  int64_t c1_values[BATCH_SIZE];
+  int64_t c2_values[BATCH_SIZE];
+  int64_t zero_value = 0;
+  ObDatum c1_datums[BATCH_SIZE];
+  ObDatum c2_datums[BATCH_SIZE];
+  ObDatum zero_datum;
+  for (int64_t i = 0; i < BATCH_SIZE; i++) {
+    c1_values[i] = i;
+    c2_values[i] = 1;
+  }
+  set_datums(c1_datums, c1_values, BATCH_SIZE);
+  set_datums(c2_datums, c2_values, BATCH_SIZE);
+  set_datums(&zero_datum, &zero_value, 1);
+  const ObDatum *leaf_datums[3];
+  for (int64_t i = 0; i < leaves_.count(); i++) {
+    leaf_datums[i] = leaves_.at(i) == &c1 ? c1_datums
+        : (leaves_.at(i) == &c2 ? c2_datums : &zero_datum);
+  }
+  uint64_t skip[SKIP_WORDS] = {0};
+  ASSERT_EQ(BATCH_SIZE, func(BATCH_SIZE, reinterpret_cast<int64_t>(skip),
+                             reinterpret_cast<int64_t>(leaf_datums)));
+
+  // overflow on a skipped row is ignored
+  c1_values[70] = INT64_MAX;
+  memset(skip, 0, sizeof(skip));
+  set_skip(skip, 70);
+  ASSERT_EQ(BATCH_SIZE - 1, func(BATCH_SIZE, reinterpret_cast<int64_t>(skip),
+                                 reinterpret_cast<int64_t>(leaf_datums)));
+
+  memset(skip, 0, sizeof(skip));
+  ASSERT_EQ(-1, func(BATCH_SIZE, reinterpret_cast<int64_t>(skip),
+                     reinterpret_cast<int64_t>(leaf_datums)));
+}
+
+// rows skipped before filtering stay skipped and are not counted
+TEST_F(TestExprJit, skip_bitmap)
+{
+  ObExpr c1;
+  ObExpr ten;
+  ObExpr ge;
+  ObExpr *args[2];
+  init_column(c1);
+  init_const(ten);
+  init_op(ge, T_OP_GE, &c1, &ten, args);
+  ObSEArray<ObExpr *, 1> filters;
+  ObSEArray<ObExpr *, 1> evaluated;
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(&ge));
+  ObJitFilterFunc func = NULL;
+  ASSERT_EQ(OB_SUCCESS, compile(filters, evaluated, func));
+
+  int64_t c1_values[BATCH_SIZE];
+  ObDatum c1_datums[BATCH_SIZE];
+  int64_t ten_value = 10;
+  ObDatum ten_datum;
+  for (int64_t i = 0; i < BATCH_SIZE; i++) {
+    c1_values[i] = i % 20;
+  }
+  set_datums(c1_datums, c1_values, BATCH_SIZE);
+  set_datums(&ten_datum, &ten_value, 1);
+  const ObDatum *leaf_datums[2];
+  leaf_datums[leaves_.at(0) == &c1 ? 0 : 1] = c1_datums;
+  leaf_datums[leaves_.at(0) == &c1 ? 1 : 0] = &ten_datum;
+  uint64_t skip[SKIP_WORDS] = {0};
+  bool pre_skipped[BATCH_SIZE];
+  for (int64_t i = 0; i < BATCH_SIZE; i++) {
+    pre_skipped[i] = (0 == i % 7);
+    if (pre_skipped[i]) {
+      set_skip(skip, i);
+    }
+  }
+  const int64_t cnt = func(BATCH_SIZE, reinterpret_cast<int64_t>(skip),
+                           reinterpret_cast<int64_t>(leaf_datums));
+  int64_t expect_cnt = 0;
+  for (int64_t i = 0; i < BATCH_SIZE; i++) {
+    const bool pass = !pre_skipped[i] && c1_values[i] >= 10;
+    expect_cnt += pass;
+    ASSERT_EQ(!pass, is_skipped(skip, i)) << "row " << i;
+  }
+  ASSERT_EQ(expect_cnt, cnt);
+
+  // rows after %size are untouched
+  memset(skip, 0, sizeof(skip));
+  ASSERT_EQ(0, func(5, reinterpret_cast<int64_t>(skip), reinterpret_cast<int64_t>(leaf_datums)));
+  for (int64_t i = 0; i < BATCH_SIZE; i++) {
+    ASSERT_EQ(i < 5, is_skipped(skip, i)) << "row " << i;
+  }
+}
+
+// child output exprs are leaves, their arguments are not accessed.
+TEST_F(TestExprJit, evaluated_expr_as_leaf)
+{
+  ObExpr c1;
+  ObExpr c2;
+  ObExpr zero;
+  ObExpr add;
+  ObExpr func_expr;
+  ObExpr gt;
+  ObExpr *add_args[2];
+  ObExpr *func_args[2];
+  ObExpr *gt_args[2];
+  init_column(c1);
+  init_column(c2);
+  init_const(zero);
+  init_op(add, T_OP_ADD, &c1, &c2, add_args);
+  // not supported by compiler, jittable only if it is evaluated by child
+  init_op(func_expr, T_OP_MOD, &add, &c2, func_args);
+  init_op(gt, T_OP_GT, &func_expr, &zero, gt_args);
+  ObSEArray<ObExpr *, 1> filters;
+  ObSEArray<ObExpr *, 1> evaluated;
+  ASSERT_EQ(OB_SUCCESS, filters.push_back(&gt));
+  ASSERT_FALSE(ObExprJitCompiler::is_jittable(filters, evaluated));
+  ASSERT_EQ(OB_SUCCESS, evaluated.push_back(&func_expr));
+  ASSERT_TRUE(ObExprJitCompiler::is_jittable(filters, evaluated));
+
+  ObJitFilterFunc func = NULL;
+  ASSERT_EQ(OB_SUCCESS, compile(filters, evaluated, func));
+  ASSERT_EQ(2, leaves_.count());
+  ASSERT_TRUE(has_exist_in_array(leaves_, &func_expr));
+  ASSERT_FALSE(has_exist_in_array(leaves_, &c1));
+  ASSERT_FALSE(has_exist_in_array(inner_exprs_, &func_expr));
+  ASSERT_TRUE(has_exist_in_array(inner_exprs_, &gt));
+
+  int64_t values[BATCH_SIZE];
+  ObDatum datums[BATCH_SIZE];
+  int64_t zero_value = 0;
+  ObDatum zero_datum;
+  for (int64_t i = 0; i < BATCH_SIZE; i++) {
+    values[i] = i % 2;
+  }
+  set_datums(datums, values, BATCH_SIZE);
+  set_datums(&zero_datum, &zero_value, 1);
+  const ObDatum *leaf_datums[2];
+  leaf_datums[leaves_.at(0) == &func_expr ? 0 : 1] = datums;
+  leaf_datums[leaves_.at(0) == &func_expr ? 1 : 0] = &zero_datum;
+  uint64_t skip[SKIP_WORDS] = {0};
+  ASSERT_EQ(BATCH_SIZE / 2, func(BATCH_SIZE, reinterpret_cast<int64_t>(skip),
+                                 reinterpret_cast<int64_t>(leaf_datums)));
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  ObLLVMHelper::initialize();
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include <gtest/gtest.h>
+#include "sql/engine/expr/ob_expr_like.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class TestLikeSearchInstr : public ::testing::Test
+{
+public:
+  TestLikeSearchInstr() {}
+  virtual void SetUp() { srand(1234); }
+
+  // text of small alphabet, so that first/last byte candidates are frequent
+  static void fill_text(char *buf, const int64_t len, const int64_t alphabet)
+  {
+    for (int64_t i = 0; i < len; ++i) {
+      buf[i] = static_cast<char>('a' + rand() % alphabet);
+    }
+  }
+
+  static void check_search(const char *text, const int64_t text_len,
+                           const char *instr, const int64_t instr_len)
+  {
+#if OB_USE_MULTITARGET_CODE
+    const char *expect = ObExprLike::search_instr(text, text_len, instr, instr_len);
+    const char *res = ObExprLike::search_instr_avx2(text, text_len, instr, instr_len);
+    ASSERT_EQ(expect, res) << "text_len " << text_len << " instr_len " << instr_len;
+#else
+    UNUSED(text);
+    UNUSED(text_len);
+    UNUSED(instr);
+    UNUSED(instr_len);
+#endif
+  }
+};
+
+TEST_F(TestLikeSearchInstr, random_text)
+{
+#if OB_USE_MULTITARGET_CODE
+  if (!is_arch_supported(ObTargetArch::AVX2)) {
+    return;
+  }
+  const int64_t max_text_len = 256;
+  const int64_t max_instr_len = 48;
+  char text[max_text_len];
+  char instr[max_instr_len];
+  for (int64_t round = 0; round < 2000; ++round) {
+    const int64_t text_len = rand() % max_text_len;
+    const int64_t instr_len = 1 + rand() % max_instr_len;
+    const int64_t alphabet = 1 + rand() % 4;
+    fill_text(text, text_len, alphabet);
+    fill_text(instr, instr_len, alphabet);
+    check_search(text, text_len, instr, instr_len);
+    if (text_len >= instr_len) {
+      // instr copied from text, must be found
+      const int64_t pos = rand() % (text_len - instr_len + 1);
+      MEMCPY(instr, text + pos, instr_len);
+      check_search(text, text_len, instr, instr_len);
+    }
+  }
+#endif
+}
+
+// match at every position, including the tail which is not covered by a full 32 bytes block
+TEST_F(TestLikeSearchInstr, match_position)
+{
+#if OB_USE_MULTITARGET_CODE
+  if (!is_arch_supported(ObTargetArch::AVX2)) {
+    return;
+  }
+  const int64_t text_len = 130;
+  char text[text_len];
+  const char *instrs[] = { "x", "xy", "xyz", "xyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyzxyz" };
+  for (int64_t k = 0; k < static_cast<int64_t>(ARRAYSIZEOF(instrs)); ++k) {
+    const int64_t instr_len = strlen(instrs[k]);
+    for (int64_t pos = 0; pos + instr_len <= text_len; ++pos) {
+      MEMSET(text, 'a', text_len);
+      MEMCPY(text + pos, instrs[k], instr_len);
+      check_search(text, text_len, instrs[k], instr_len);
+      // first and last bytes match, middle does not
+      if (instr_len > 2) {
+        text[pos + 1] = 'a';
+        check_search(text, text_len, instrs[k], instr_len);
+      }
+    }
+  }
+  // empty text and empty instr
+  check_search(text, 0, "x", 1);
+  check_search(text, text_len, "", 0);
+#endif
+}
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
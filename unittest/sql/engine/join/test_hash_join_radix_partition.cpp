@@ -0,0 +1,177 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+
+#include "sql/engine/join/ob_hash_join_op.h"
+#include "sql/engine/ob_exec_context.h"
+#include "lib/random/ob_random.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+typedef ObHashJoinOp::RadixRow RadixRow;
+typedef ObHashJoinOp::HTBucket HTBucket;
+typedef ObHashJoinOp::PartHashJoinTable PartHashJoinTable;
+
+class TestHashJoinRadixPartition : public ::testing::Test
+{
+public:
+  TestHashJoinRadixPartition()
+    : allocator_("TestRadixHJ"),
+      exec_ctx_(allocator_),
+      spec_(allocator_, PHY_HASH_JOIN),
+      op_(exec_ctx_, spec_, NULL)
+  {}
+  virtual void SetUp() override
+  {
+    op_.enable_radix_partition_ = true;
+    op_.l2_cache_size_ = L2_CACHE_SIZE;
+  }
+  virtual void TearDown() override
+  {
+    hash_table_.free(&allocator_);
+    allocator_.reset();
+  }
+
+  RadixRow *gen_rows(const int64_t cnt, const uint64_t max_hash_val)
+  {
+    RadixRow *rows = static_cast<RadixRow *>(allocator_.alloc(sizeof(RadixRow) * cnt));
+    const int64_t row_size = sizeof(ObHashJoinStoredJoinRow) + sizeof(uint64_t);
+    char *buf = static_cast<char *>(allocator_.alloc(row_size * cnt));
+    if (NULL == rows || NULL == buf) {
+      rows = NULL;
+    } else {
+      for (int64_t i = 0; i < cnt; i++) {
+        ObHashJoinStoredJoinRow *sr = new (buf + row_size * i) ObHashJoinStoredJoinRow();
+        sr->row_size_ = row_size;
+        sr->set_hash_value(ObRandom::rand(0, max_hash_val));
+        rows[i].hash_val_ = sr->get_hash_value();
+        rows[i].stored_row_ = sr;
+      }
+    }
+    return rows;
+  }
+
+  int init_hash_table(const int64_t nbuckets)
+  {
+    int ret = OB_SUCCESS;
+    if (OB_FAIL(hash_table_.init(allocator_))) {
+      LOG_WARN("init hash table failed", K(ret));
+    } else if (FALSE_IT(hash_table_.nbuckets_ = nbuckets)) {
+    } else if (OB_FAIL(hash_table_.buckets_->init(nbuckets))) {
+      LOG_WARN("init buckets failed", K(ret), K(nbuckets));
+    }
+    return ret;
+  }
+
+protected:
+  static const int64_t L2_CACHE_SIZE = 1L << 16;
+  ObArenaAllocator allocator_;
+  ObExecContext exec_ctx_;
+  ObHashJoinSpec spec_;
+  ObHashJoinOp op_;
+  PartHashJoinTable hash_table_;
+};
+
+TEST_F(TestHashJoinRadixPartition, calc_radix_shift)
+{
+  const int64_t bucket_size = sizeof(HTBucket);
+  // bucket array fits in L2 cache
+  hash_table_.nbuckets_ = L2_CACHE_SIZE / bucket_size;
+  ASSERT_EQ(-1, op_.calc_radix_shift(hash_table_));
+  // one partition per L2 cache size
+  hash_table_.nbuckets_ = 4 * L2_CACHE_SIZE / bucket_size;
+  ASSERT_EQ(__builtin_ctzll(hash_table_.nbuckets_) - 2, op_.calc_radix_shift(hash_table_));
+  // no more than RADIX_PART_CNT partitions
+  hash_table_.nbuckets_ = (ObHashJoinOp::RADIX_PART_CNT << 4) * L2_CACHE_SIZE / bucket_size;
+  ASSERT_EQ(__builtin_ctzll(hash_table_.nbuckets_) - ObHashJoinOp::RADIX_PART_BITS,
+            op_.calc_radix_shift(hash_table_));
+  // disabled
+  op_.enable_radix_partition_ = false;
+  ASSERT_EQ(-1, op_.calc_radix_shift(hash_table_));
+}
+
+TEST_F(TestHashJoinRadixPartition, radix_cluster)
+{
+  const int64_t ROW_CNT = 10000;
+  const uint64_t mask = (1L << 16) - 1;
+  RadixRow *rows = gen_rows(ROW_CNT, ObHashJoinStoredJoinRow::HASH_VAL_MASK);
+  RadixRow *clustered_rows = static_cast<RadixRow *>(allocator_.alloc(sizeof(RadixRow) * ROW_CNT));
+  ASSERT_TRUE(NULL != rows && NULL != clustered_rows);
+  for (int64_t radix_shift = 16 - ObHashJoinOp::RADIX_PART_BITS; radix_shift <= 16; radix_shift++) {
+    ObHashJoinOp::radix_cluster(rows, ROW_CNT, mask, radix_shift, clustered_rows);
+    uint64_t hash_sum = 0;
+    for (int64_t i = 0; i < ROW_CNT; i++) {
+      hash_sum += rows[i].hash_val_ - clustered_rows[i].hash_val_;
+      ASSERT_EQ(clustered_rows[i].stored_row_->get_hash_value(), clustered_rows[i].hash_val_);
+      if (i > 0) {
+        const uint64_t prev_part = (clustered_rows[i - 1].hash_val_ & mask) >> radix_shift;
+        const uint64_t part = (clustered_rows[i].hash_val_ & mask) >> radix_shift;
+        ASSERT_LE(prev_part, part);
+        // stable, the rows of the same partition keep the order of input
+        if (prev_part == part) {
+          ASSERT_LT(clustered_rows[i - 1].stored_row_, clustered_rows[i].stored_row_);
+        }
+      }
+    }
+    ASSERT_EQ(0, hash_sum);
+  }
+  // empty input
+  ObHashJoinOp::radix_cluster(rows, 0, mask, 8, clustered_rows);
+}
+
+// Insert the clustered rows into the hash table as radix_build_hash_table() does, with
+// duplicated hash values, every row must be found in the row list of its hash value.
+// The hash value of stored row is overwritten by the next pointer, use the copied one.
+TEST_F(TestHashJoinRadixPartition, insert_clustered_rows)
+{
+  const int64_t ROW_CNT = 20000;
+  const int64_t NBUCKETS = 1L << 15;
+  const uint64_t mask = NBUCKETS - 1;
+  ASSERT_EQ(OB_SUCCESS, init_hash_table(NBUCKETS));
+  const int64_t radix_shift = op_.calc_radix_shift(hash_table_);
+  ASSERT_LT(0, radix_shift);
+  RadixRow *rows = gen_rows(ROW_CNT, NBUCKETS * 4);
+  RadixRow *clustered_rows = static_cast<RadixRow *>(allocator_.alloc(sizeof(RadixRow) * ROW_CNT));
+  ASSERT_TRUE(NULL != rows && NULL != clustered_rows);
+  ObHashJoinOp::radix_cluster(rows, ROW_CNT, mask, radix_shift, clustered_rows);
+  for (int64_t i = 0; i < ROW_CNT; i++) {
+    hash_table_.set(clustered_rows[i].hash_val_, clustered_rows[i].stored_row_);
+  }
+  for (int64_t i = 0; i < ROW_CNT; i++) {
+    bool found = false;
+    ObHashJoinStoredJoinRow *sr = hash_table_.get(rows[i].hash_val_);
+    for (; NULL != sr && !found; sr = sr->get_next()) {
+      found = (sr == rows[i].stored_row_);
+    }
+    ASSERT_TRUE(found);
+  }
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
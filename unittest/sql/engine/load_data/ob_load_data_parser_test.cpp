@@ -305,6 +305,135 @@ TEST_F(TestParser, general_parser_escape)
 
 }
 
+class ObCSVScalarParser : public ObCSVGeneralParser
+{
+public:
+  void disable_structural_index() { opt_param_.use_structural_index_ = false; }
+};
+
+static void gen_random_csv(const int64_t len, const char *alphabet[], const int64_t alphabet_cnt,
+                           std::string &data)
+{
+  data.clear();
+  while (static_cast<int64_t>(data.length()) < len) {
+    data.append(alphabet[rand() % alphabet_cnt]);
+  }
+}
+
+static void parse_all(ObCSVGeneralParser &parser, const std::string &data, char *escape_buf,
+                      const int64_t escape_buf_len, std::string &result, int64_t &rows)
+{
+  result.clear();
+  auto collect_lines = [&result](ObIArray<ObCSVGeneralParser::FieldValue> &arr) -> int {
+    for (int64_t i = 0; i < arr.count(); ++i) {
+      if (arr.at(i).is_null_) {
+        result.append("<null>");
+      } else {
+        result.append(arr.at(i).ptr_, arr.at(i).len_);
+      }
+      result.append("\x01");
+    }
+    result.append("\x02");
+    return OB_SUCCESS;
+  };
+  ObSEArray<ObCSVGeneralParser::LineErrRec, 256> error_msgs;
+  const char *ptr = data.data();
+  const char *end = data.data() + data.length();
+  rows = INT64_MAX;
+  ASSERT_EQ(OB_SUCCESS, (parser.scan<decltype(collect_lines), true>(ptr, end, rows,
+                         escape_buf, escape_buf + escape_buf_len, collect_lines, error_msgs, true)));
+  ASSERT_EQ(end, ptr);
+  for (int64_t i = 0; i < error_msgs.count(); ++i) {
+    result.append(to_cstring(error_msgs.at(i)));
+  }
+}
+
+TEST_F(TestParser, structural_index_same_result)
+{
+  const char *alphabet[] = {"a", "b", "1", "2", " ", ",", "|", "\"", "\\", "\n", "\r\n", "N", "NULL",
+                            "\xe4\xb8\xad" /*utf8*/, "\x81\x5c" /*gbk with trailing '\\'*/,
+                            "\x81\x7c" /*gbk with trailing '|'*/, "\xf0," /*invalid utf8*/,
+                            "abcdefghijklmnopqrstuvwxyz0123456789abcdefghijklmnopqrstuvwxyz"};
+  struct Format {
+    const char *field_term_;
+    const char *line_term_;
+    int64_t enclosed_char_;
+    int64_t escaped_char_;
+  } formats[] = {
+    {",", "\n", '"', '\\'},
+    {"|", "\n", INT64_MAX, '\\'},
+    {"||", "\r\n", '"', '\\'},
+    {",", "\n", '"', '"'},
+    {",", ",", INT64_MAX, INT64_MAX},
+  };
+  ObCollationType cs_types[] = {CS_TYPE_UTF8MB4_BIN, CS_TYPE_GBK_BIN, CS_TYPE_BINARY};
+  const int64_t data_len = 1 << 20;
+  // the escape buffer should be larger than the data
+  char *escape_buf = static_cast<char *>(ob_malloc(data_len * 4, ObNewModIds::TEST));
+  ASSERT_TRUE(escape_buf != NULL);
+  srand(0);
+  for (int64_t f = 0; f < ARRAYSIZEOF(formats); ++f) {
+    for (int64_t c = 0; c < ARRAYSIZEOF(cs_types); ++c) {
+      ObDataInFileStruct file_struct;
+      file_struct.field_term_str_ = formats[f].field_term_;
+      file_struct.line_term_str_ = formats[f].line_term_;
+      file_struct.field_enclosed_char_ = formats[f].enclosed_char_;
+      file_struct.field_escaped_char_ = formats[f].escaped_char_;
+      ObCSVGeneralParser parser;
+      ObCSVScalarParser scalar_parser;
+      ASSERT_EQ(OB_SUCCESS, parser.init(file_struct, 5, cs_types[c]));
+      ASSERT_EQ(OB_SUCCESS, scalar_parser.init(file_struct, 5, cs_types[c]));
+      scalar_parser.disable_structural_index();
+      std::string data;
+      std::string result;
+      std::string expect;
+      int64_t rows = 0;
+      int64_t expect_rows = 0;
+      gen_random_csv(data_len, alphabet, ARRAYSIZEOF(alphabet), data);
+      parse_all(parser, data, escape_buf, data_len * 2, result, rows);
+      parse_all(scalar_parser, data, escape_buf + data_len * 2, data_len * 2, expect, expect_rows);
+      ASSERT_EQ(expect_rows, rows) << "format " << f << " cs_type " << cs_types[c];
+      ASSERT_TRUE(expect == result) << "format " << f << " cs_type " << cs_types[c];
+    }
+  }
+  ob_free(escape_buf);
+}
+
+TEST_F(TestParser, structural_index_perf)
+{
+  // columns of lineitem like data, only a few bytes need to be checked in each field
+  const char *alphabet[] = {"1|", "155190|", "7706|", "17|", "21168.23|", "0.04|", "N|", "O|",
+                            "1996-03-13|", "DELIVER IN PERSON|", "TRUCK|",
+                            "egular courts above the|\n"};
+  const int64_t data_len = 64 << 20;
+  const int64_t column_num = 16;
+  std::string data;
+  srand(0);
+  gen_random_csv(data_len, alphabet, ARRAYSIZEOF(alphabet), data);
+  ObDataInFileStruct file_struct;
+  file_struct.field_term_str_ = "|";
+  for (int64_t i = 0; i < 2; ++i) {
+    ObCSVScalarParser parser;
+    ASSERT_EQ(OB_SUCCESS, parser.init(file_struct, column_num, CS_TYPE_UTF8MB4_BIN));
+    if (0 == i) {
+      parser.disable_structural_index();
+    }
+    auto counting_lines = [](ObIArray<ObCSVGeneralParser::FieldValue> &arr) -> int {
+      UNUSED(arr);
+      return OB_SUCCESS;
+    };
+    ObSEArray<ObCSVGeneralParser::LineErrRec, 256> error_msgs;
+    const char *ptr = data.data();
+    const char *end = data.data() + data.length();
+    int64_t rows = INT64_MAX;
+    const int64_t start_time = ObTimeUtility::current_time();
+    ASSERT_EQ(OB_SUCCESS, parser.scan(ptr, end, rows, NULL, NULL, counting_lines, error_msgs, true));
+    const int64_t time_dur = MAX(ObTimeUtility::current_time() - start_time, 1);
+    fprintf(stdout, "## %s parser rows:%ld\tspeed:%ldM/s\n", 0 == i ? "scalar" : "structural index",
+            rows, (data_len >> 20) * USECS_PER_SEC / time_dur);
+  }
+}
+
 int main(int argc, char **argv)
 {
   init_sql_factories();
@@ -0,0 +1,557 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include "lib/allocator/page_arena.h"
+#include "lib/timezone/ob_timezone_info.h"
+#include "sql/engine/table/ob_parquet_file_reader.h"
+
+static char *file_path = NULL;
+
+using namespace oceanbase::sql;
+using namespace oceanbase::common;
+
+/*
+ * The files hold the same 100 rows in row groups of 40, 40 and 20 rows, written by pyarrow:
+ *   id       int32          i
+ *   c_int64  int64          i * 1000003, null if i % 5 == 0
+ *   c_double double         i * 0.25
+ *   c_str    string         'str_' || i % 10, null if i % 11 == 0
+ *   c_date   date32         2023-01-01 + i days
+ *   c_ts     timestamp(us)  i * 3601 seconds + 123456 us
+ *   c_dec    decimal(10,2)  (i * 101 - 5000) / 100
+ * plain.parquet is plain encoded without compression in data page v1, dict_zstd.parquet is
+ * dictionary encoded and compressed by zstd in data page v2. snappy.parquet is written with the
+ * defaults of pyarrow, dictionary encoded and compressed by snappy in data page v1, and its c_ts
+ * is timestamp(us, tz='UTC'), which is adjusted to UTC.
+ */
+static const char *TEST_FILES[] = { "plain.parquet", "dict_zstd.parquet", "snappy.parquet" };
+static const int64_t SNAPPY_FILE_IDX = 2;
+static const int64_t ROW_COUNT = 100;
+static const int64_t COLUMN_COUNT = 7;
+
+class TestParquetReader : public ::testing::Test
+{
+public:
+  TestParquetReader() {}
+  ~TestParquetReader() {}
+  virtual void SetUp() {}
+  virtual void TearDown() {}
+  void load_file(const char *name, std::string &data, ObParquetFileMeta &meta);
+  void read_column(const std::string &data,
+                   const ObParquetFileMeta &meta,
+                   const int64_t column_idx,
+                   const int64_t batch_size,
+                   const int64_t skip_rows,
+                   std::vector<std::string> &values,
+                   const ObObjType datum_type = ObVarcharType,
+                   const int16_t datum_scale = -1,
+                   const ObTimeZoneInfo *tz_info = NULL);
+};
+
+// typed datums are printed as numbers, date as days and datetime as microseconds
+static std::string datum_to_string(const ObDatum &datum, const ObObjType datum_type)
+{
+  char buf[64];
+  std::string str;
+  if (datum.is_null()) {
+    str = "NULL";
+  } else {
+    switch (datum_type) {
+      case ObIntType:
+        snprintf(buf, sizeof(buf), "%ld", datum.get_int());
+        str = buf;
+        break;
+      case ObDoubleType:
+        snprintf(buf, sizeof(buf), "%.17g", datum.get_double());
+        str = buf;
+        break;
+      case ObDateType:
+        snprintf(buf, sizeof(buf), "%d", datum.get_date());
+        str = buf;
+        break;
+      case ObDateTimeType:
+      case ObTimestampType:
+        snprintf(buf, sizeof(buf), "%ld", datum.get_datetime());
+        str = buf;
+        break;
+      default:
+        str.assign(datum.ptr_, datum.len_);
+        break;
+    }
+  }
+  return str;
+}
+
+// thrift compact encoding of the page header fields read by the column reader
+static void append_varint(std::string &buf, uint64_t value)
+{
+  while (value >= 0x80) {
+    buf.push_back(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  buf.push_back(static_cast<char>(value));
+}
+
+static void append_i32_field(std::string &buf, const int16_t delta, const int32_t value)
+{
+  buf.push_back(static_cast<char>((delta << 4) | ObParquetThriftDecoder::CT_I32));
+  append_varint(buf, (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31));
+}
+
+static void append_page(std::string &buf,
+                        const int32_t page_type,
+                        const int32_t num_values,
+                        const int32_t encoding,
+                        const std::string &page)
+{
+  append_i32_field(buf, 1, page_type);
+  append_i32_field(buf, 1, static_cast<int32_t>(page.size()));
+  append_i32_field(buf, 1, static_cast<int32_t>(page.size()));
+  // data_page_header is field 5, dictionary_page_header is field 7
+  const int16_t delta = ObParquetType::DICTIONARY_PAGE == page_type ? 4 : 2;
+  buf.push_back(static_cast<char>((delta << 4) | ObParquetThriftDecoder::CT_STRUCT));
+  append_i32_field(buf, 1, num_values);
+  append_i32_field(buf, 1, encoding);
+  buf.push_back(ObParquetThriftDecoder::CT_STOP);
+  buf.push_back(ObParquetThriftDecoder::CT_STOP);
+  buf.append(page);
+}
+
+static void append_int32(std::string &buf, const int32_t value)
+{
+  buf.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+// read @count values of a required int32 column chunk built by append_page
+static int read_chunk(const std::string &chunk,
+                      const int64_t count,
+                      std::vector<std::string> &values,
+                      const ObObjType datum_type = ObVarcharType)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator allocator;
+  ObParquetColumnDesc desc;
+  ObParquetColumnChunkMeta meta;
+  ObParquetColumnReader reader;
+  std::vector<ObDatum> datums(count);
+  desc.physical_type_ = ObParquetType::INT32;
+  meta.physical_type_ = ObParquetType::INT32;
+  meta.codec_ = ObParquetType::UNCOMPRESSED;
+  meta.num_values_ = count;
+  meta.total_compressed_size_ = chunk.size();
+  meta.data_page_offset_ = 0;
+  values.clear();
+  if (OB_FAIL(reader.init(desc, meta, chunk.data(), chunk.size(), count, datum_type, -1, NULL,
+                          allocator))) {
+  } else if (OB_FAIL(reader.read(count, &datums[0], allocator))) {
+  } else {
+    for (int64_t i = 0; i < count; ++i) {
+      values.push_back(datum_to_string(datums[i], datum_type));
+    }
+  }
+  return ret;
+}
+
+void TestParquetReader::load_file(const char *name, std::string &data, ObParquetFileMeta &meta)
+{
+  std::string file_name;
+  if (file_path != NULL) {
+    file_name.append(file_path).append("/").append(name);
+  } else {
+    file_name = name;
+  }
+  std::ifstream in(file_name.c_str(), std::ios::binary);
+  ASSERT_TRUE(in.good());
+  std::stringstream ss;
+  ss << in.rdbuf();
+  data = ss.str();
+  const int64_t size = data.length();
+  ASSERT_GT(size, ObParquetType::MAGIC_LEN + ObParquetType::FOOTER_LEN);
+  ASSERT_EQ(0, MEMCMP(data.data() + size - ObParquetType::MAGIC_LEN, "PAR1", ObParquetType::MAGIC_LEN));
+  int32_t meta_len = 0;
+  MEMCPY(&meta_len, data.data() + size - ObParquetType::FOOTER_LEN, sizeof(meta_len));
+  ASSERT_EQ(OB_SUCCESS, meta.parse(data.data() + size - ObParquetType::FOOTER_LEN - meta_len, meta_len));
+}
+
+// values of every row group, skip_rows rows at the beginning of each row group are skipped
+void TestParquetReader::read_column(const std::string &data,
+                                    const ObParquetFileMeta &meta,
+                                    const int64_t column_idx,
+                                    const int64_t batch_size,
+                                    const int64_t skip_rows,
+                                    std::vector<std::string> &values,
+                                    const ObObjType datum_type,
+                                    const int16_t datum_scale,
+                                    const ObTimeZoneInfo *tz_info)
+{
+  std::vector<ObDatum> datums(batch_size);
+  values.clear();
+  for (int64_t rg = 0; rg < meta.get_row_group_count(); ++rg) {
+    const ObParquetColumnChunkMeta &chunk = meta.get_column_chunk(rg, column_idx);
+    const int64_t row_count = meta.get_row_group(rg).num_rows_;
+    ObArenaAllocator allocator;
+    ObArenaAllocator text_allocator;
+    ObParquetColumnReader reader;
+    ASSERT_EQ(OB_SUCCESS, reader.init(meta.get_column(column_idx), chunk,
+                                      data.data() + chunk.get_start_offset(),
+                                      chunk.total_compressed_size_, batch_size, datum_type,
+                                      datum_scale, tz_info, allocator));
+    int64_t read_rows = MIN(skip_rows, row_count);
+    if (read_rows > 0) {
+      ASSERT_EQ(OB_SUCCESS, reader.skip(read_rows, text_allocator));
+    }
+    while (read_rows < row_count) {
+      const int64_t count = MIN(batch_size, row_count - read_rows);
+      text_allocator.reuse();
+      ASSERT_EQ(OB_SUCCESS, reader.read(count, &datums[0], text_allocator));
+      for (int64_t i = 0; i < count; ++i) {
+        values.push_back(datum_to_string(datums[i], datum_type));
+      }
+      read_rows += count;
+    }
+  }
+}
+
+TEST_F(TestParquetReader, file_meta)
+{
+  for (int64_t f = 0; f < ARRAYSIZEOF(TEST_FILES); ++f) {
+    std::string data;
+    ObParquetFileMeta meta;
+    load_file(TEST_FILES[f], data, meta);
+    ASSERT_EQ(ROW_COUNT, meta.get_num_rows());
+    ASSERT_EQ(COLUMN_COUNT, meta.get_column_count());
+    ASSERT_EQ(3, meta.get_row_group_count());
+    ASSERT_EQ(40, meta.get_row_group(0).num_rows_);
+    ASSERT_EQ(40, meta.get_row_group(1).num_rows_);
+    ASSERT_EQ(20, meta.get_row_group(2).num_rows_);
+    ASSERT_TRUE(meta.get_column(0).name_ == "id");
+    ASSERT_EQ(ObParquetType::INT32, meta.get_column(0).physical_type_);
+    ASSERT_EQ(ObParquetType::INT64, meta.get_column(1).physical_type_);
+    ASSERT_EQ(ObParquetType::DOUBLE, meta.get_column(2).physical_type_);
+    ASSERT_EQ(ObParquetType::BYTE_ARRAY, meta.get_column(3).physical_type_);
+    ASSERT_TRUE(meta.get_column(4).is_date());
+    ASSERT_TRUE(meta.get_column(5).is_timestamp());
+    ASSERT_EQ(SNAPPY_FILE_IDX == f, meta.get_column(5).is_adjusted_to_utc_);
+    ASSERT_TRUE(meta.get_column(6).is_decimal());
+    ASSERT_EQ(2, meta.get_column(6).scale_);
+    for (int64_t i = 0; i < COLUMN_COUNT; ++i) {
+      ASSERT_EQ(1, meta.get_column(i).max_def_level_);
+      ASSERT_EQ(0, meta.get_column(i).max_rep_level_);
+    }
+    // truncated metadata
+    ObParquetFileMeta broken_meta;
+    const int64_t size = data.length();
+    int32_t meta_len = 0;
+    MEMCPY(&meta_len, data.data() + size - ObParquetType::FOOTER_LEN, sizeof(meta_len));
+    ASSERT_NE(OB_SUCCESS, broken_meta.parse(data.data() + size - ObParquetType::FOOTER_LEN - meta_len,
+                                            meta_len / 2));
+  }
+}
+
+TEST_F(TestParquetReader, read_values)
+{
+  const int64_t batch_sizes[] = { 256, 7, 1 };
+  for (int64_t f = 0; f < ARRAYSIZEOF(TEST_FILES); ++f) {
+    std::string data;
+    ObParquetFileMeta meta;
+    load_file(TEST_FILES[f], data, meta);
+    for (int64_t b = 0; b < ARRAYSIZEOF(batch_sizes); ++b) {
+      std::vector<std::string> values;
+      char buf[64];
+      read_column(data, meta, 0, batch_sizes[b], 0, values);
+      ASSERT_EQ(ROW_COUNT, values.size());
+      for (int64_t i = 0; i < ROW_COUNT; ++i) {
+        snprintf(buf, sizeof(buf), "%ld", i);
+        ASSERT_EQ(std::string(buf), values[i]);
+      }
+      read_column(data, meta, 1, batch_sizes[b], 0, values);
+      ASSERT_EQ(ROW_COUNT, values.size());
+      for (int64_t i = 0; i < ROW_COUNT; ++i) {
+        snprintf(buf, sizeof(buf), "%ld", i * 1000003);
+        ASSERT_EQ(0 == i % 5 ? std::string("NULL") : std::string(buf), values[i]);
+      }
+      read_column(data, meta, 2, batch_sizes[b], 0, values);
+      ASSERT_EQ(ROW_COUNT, values.size());
+      for (int64_t i = 0; i < ROW_COUNT; ++i) {
+        snprintf(buf, sizeof(buf), "%.17g", i * 0.25);
+        ASSERT_EQ(std::string(buf), values[i]);
+      }
+      read_column(data, meta, 3, batch_sizes[b], 0, values);
+      ASSERT_EQ(ROW_COUNT, values.size());
+      for (int64_t i = 0; i < ROW_COUNT; ++i) {
+        snprintf(buf, sizeof(buf), "str_%ld", i % 10);
+        ASSERT_EQ(0 == i % 11 ? std::string("NULL") : std::string(buf), values[i]);
+      }
+      read_column(data, meta, 4, batch_sizes[b], 0, values);
+      ASSERT_EQ(ROW_COUNT, values.size());
+      ASSERT_EQ("2023-01-01", values[0]);
+      ASSERT_EQ("2023-02-11", values[41]);
+      ASSERT_EQ("2023-04-10", values[99]);
+      read_column(data, meta, 5, batch_sizes[b], 0, values);
+      ASSERT_EQ(ROW_COUNT, values.size());
+      ASSERT_EQ("1970-01-01 00:00:00.123456", values[0]);
+      ASSERT_EQ("1970-01-02 17:00:41.123456", values[41]);
+      ASSERT_EQ("1970-01-05 03:01:39.123456", values[99]);
+      read_column(data, meta, 6, batch_sizes[b], 0, values);
+      ASSERT_EQ(ROW_COUNT, values.size());
+      ASSERT_EQ("-50.00", values[0]);
+      ASSERT_EQ("-8.59", values[41]);
+      ASSERT_EQ("49.99", values[99]);
+    }
+  }
+}
+
+TEST_F(TestParquetReader, skip_values)
+{
+  for (int64_t f = 0; f < ARRAYSIZEOF(TEST_FILES); ++f) {
+    std::string data;
+    ObParquetFileMeta meta;
+    load_file(TEST_FILES[f], data, meta);
+    for (int64_t c = 0; c < COLUMN_COUNT; ++c) {
+      std::vector<std::string> all_values;
+      std::vector<std::string> values;
+      read_column(data, meta, c, 16, 0, all_values);
+      read_column(data, meta, c, 16, 25, values);
+      // 15 + 15 + 0 rows are left in the row groups
+      ASSERT_EQ(30, values.size());
+      for (int64_t i = 0; i < 15; ++i) {
+        ASSERT_EQ(all_values[25 + i], values[i]);
+        ASSERT_EQ(all_values[65 + i], values[15 + i]);
+      }
+    }
+  }
+}
+
+TEST_F(TestParquetReader, read_typed_values)
+{
+  const int64_t batch_sizes[] = { 256, 7 };
+  for (int64_t f = 0; f < ARRAYSIZEOF(TEST_FILES); ++f) {
+    std::string data;
+    ObParquetFileMeta meta;
+    load_file(TEST_FILES[f], data, meta);
+    const bool is_adjusted = SNAPPY_FILE_IDX == f;
+    ASSERT_TRUE(ObParquetColumnReader::can_read_as(meta.get_column(0), ObIntType));
+    ASSERT_FALSE(ObParquetColumnReader::can_read_as(meta.get_column(0), ObDateType));
+    ASSERT_TRUE(ObParquetColumnReader::can_read_as(meta.get_column(1), ObIntType));
+    ASSERT_TRUE(ObParquetColumnReader::can_read_as(meta.get_column(2), ObDoubleType));
+    ASSERT_FALSE(ObParquetColumnReader::can_read_as(meta.get_column(2), ObFloatType));
+    ASSERT_FALSE(ObParquetColumnReader::can_read_as(meta.get_column(3), ObIntType));
+    ASSERT_TRUE(ObParquetColumnReader::can_read_as(meta.get_column(4), ObDateType));
+    ASSERT_FALSE(ObParquetColumnReader::can_read_as(meta.get_column(4), ObIntType));
+    ASSERT_EQ(!is_adjusted, ObParquetColumnReader::can_read_as(meta.get_column(5), ObDateTimeType));
+    ASSERT_EQ(is_adjusted, ObParquetColumnReader::can_read_as(meta.get_column(5), ObTimestampType));
+    ASSERT_FALSE(ObParquetColumnReader::can_read_as(meta.get_column(6), ObIntType));
+    for (int64_t b = 0; b < ARRAYSIZEOF(batch_sizes); ++b) {
+      std::vector<std::string> values;
+      char buf[64];
+      read_column(data, meta, 0, batch_sizes[b], 0, values, ObIntType);
+      ASSERT_EQ(ROW_COUNT, values.size());
+      for (int64_t i = 0; i < ROW_COUNT; ++i) {
+        snprintf(buf, sizeof(buf), "%ld", i);
+        ASSERT_EQ(std::string(buf), values[i]);
+      }
+      read_column(data, meta, 1, batch_sizes[b], 0, values, ObIntType);
+      ASSERT_EQ(ROW_COUNT, values.size());
+      for (int64_t i = 0; i < ROW_COUNT; ++i) {
+        snprintf(buf, sizeof(buf), "%ld", i * 1000003);
+        ASSERT_EQ(0 == i % 5 ? std::string("NULL") : std::string(buf), values[i]);
+      }
+      read_column(data, meta, 2, batch_sizes[b], 0, values, ObDoubleType);
+      ASSERT_EQ(ROW_COUNT, values.size());
+      for (int64_t i = 0; i < ROW_COUNT; ++i) {
+        snprintf(buf, sizeof(buf), "%.17g", i * 0.25);
+        ASSERT_EQ(std::string(buf), values[i]);
+      }
+      // 2023-01-01 is the 19358th day since the epoch
+      read_column(data, meta, 4, batch_sizes[b], 0, values, ObDateType);
+      ASSERT_EQ(ROW_COUNT, values.size());
+      for (int64_t i = 0; i < ROW_COUNT; ++i) {
+        snprintf(buf, sizeof(buf), "%ld", 19358 + i);
+        ASSERT_EQ(std::string(buf), values[i]);
+      }
+      // rounded to the scale of the column
+      const ObObjType ts_type = is_adjusted ? ObTimestampType : ObDateTimeType;
+      read_column(data, meta, 5, batch_sizes[b], 0, values, ts_type, 6);
+      ASSERT_EQ(ROW_COUNT, values.size());
+      for (int64_t i = 0; i < ROW_COUNT; ++i) {
+        snprintf(buf, sizeof(buf), "%ld", i * 3601 * 1000000 + 123456);
+        ASSERT_EQ(std::string(buf), values[i]);
+      }
+      read_column(data, meta, 5, batch_sizes[b], 0, values, ts_type, 0);
+      ASSERT_EQ(ROW_COUNT, values.size());
+      for (int64_t i = 0; i < ROW_COUNT; ++i) {
+        snprintf(buf, sizeof(buf), "%ld", i * 3601 * 1000000);
+        ASSERT_EQ(std::string(buf), values[i]);
+      }
+    }
+    // timestamps adjusted to UTC are rendered in the session time zone, others are not converted
+    ObTimeZoneInfo tz_info;
+    std::vector<std::string> values;
+    ASSERT_EQ(OB_SUCCESS, tz_info.set_timezone("+8:00"));
+    read_column(data, meta, 5, 16, 0, values, ObVarcharType, -1, &tz_info);
+    ASSERT_EQ(ROW_COUNT, values.size());
+    ASSERT_EQ(is_adjusted ? "1970-01-01 08:00:00.123456" : "1970-01-01 00:00:00.123456", values[0]);
+    ASSERT_EQ(is_adjusted ? "1970-01-05 11:01:39.123456" : "1970-01-05 03:01:39.123456", values[99]);
+  }
+}
+
+TEST_F(TestParquetReader, malformed_rle)
+{
+  uint32_t values[16];
+  ObParquetRleDecoder decoder;
+  // bit-packed run whose group count overflows when multiplied by the bit width, only the
+  // values inside the 3 bytes left are decoded
+  std::string data;
+  append_varint(data, (1ULL << 63) | 1);
+  data.append("\xff\xff\xff", 3);
+  ASSERT_EQ(OB_SUCCESS, decoder.init(data.data(), data.size(), 3));
+  ASSERT_EQ(OB_SUCCESS, decoder.get_batch(values, 8));
+  for (int64_t i = 0; i < 8; ++i) {
+    ASSERT_EQ(7, values[i]);
+  }
+  ASSERT_EQ(OB_INVALID_DATA, decoder.get_batch(values, 1));
+  // zero bit width takes no byte
+  data.clear();
+  append_varint(data, (1ULL << 63) | 1);
+  ASSERT_EQ(OB_SUCCESS, decoder.init(data.data(), data.size(), 0));
+  for (int64_t i = 0; i < 100; ++i) {
+    ASSERT_EQ(OB_SUCCESS, decoder.get_batch(values, 16));
+    ASSERT_EQ(0, values[15]);
+  }
+  // rle run without its value
+  data.clear();
+  append_varint(data, 10 << 1);
+  ASSERT_EQ(OB_SUCCESS, decoder.init(data.data(), data.size(), 8));
+  ASSERT_EQ(OB_INVALID_DATA, decoder.get_batch(values, 1));
+  // varint header longer than 64 bits
+  data.assign(11, '\xff');
+  ASSERT_EQ(OB_SUCCESS, decoder.init(data.data(), data.size(), 8));
+  ASSERT_EQ(OB_INVALID_DATA, decoder.get_batch(values, 1));
+  ASSERT_EQ(OB_INVALID_DATA, decoder.init(data.data(), data.size(), 33));
+}
+
+TEST_F(TestParquetReader, malformed_pages)
+{
+  std::vector<std::string> values;
+  std::string page;
+  std::string chunk;
+  std::string dict_page;
+  append_int32(dict_page, 7);
+  append_int32(dict_page, 9);
+  // plain page
+  append_int32(page, 1);
+  append_int32(page, 2);
+  append_page(chunk, ObParquetType::DATA_PAGE, 2, ObParquetType::PLAIN, page);
+  ASSERT_EQ(OB_SUCCESS, read_chunk(chunk, 2, values));
+  ASSERT_EQ("1", values[0]);
+  ASSERT_EQ("2", values[1]);
+  // negative number of values
+  chunk.clear();
+  append_page(chunk, ObParquetType::DATA_PAGE, -1, ObParquetType::PLAIN, page);
+  ASSERT_EQ(OB_INVALID_DATA, read_chunk(chunk, 2, values));
+  // more values than the page holds
+  chunk.clear();
+  append_page(chunk, ObParquetType::DATA_PAGE, 3, ObParquetType::PLAIN, page);
+  ASSERT_EQ(OB_INVALID_DATA, read_chunk(chunk, 3, values));
+  // dictionary indexes in a rle run of 3 values with bit width 2
+  page.clear();
+  page.push_back(2);
+  append_varint(page, 3 << 1);
+  page.push_back(1);
+  chunk.clear();
+  append_page(chunk, ObParquetType::DICTIONARY_PAGE, 2, ObParquetType::PLAIN, dict_page);
+  append_page(chunk, ObParquetType::DATA_PAGE, 3, ObParquetType::RLE_DICTIONARY, page);
+  ASSERT_EQ(OB_SUCCESS, read_chunk(chunk, 3, values));
+  ASSERT_EQ("9", values[2]);
+  ASSERT_EQ(OB_SUCCESS, read_chunk(chunk, 3, values, ObIntType));
+  ASSERT_EQ("9", values[2]);
+  // dictionary index out of range
+  page[page.size() - 1] = 3;
+  chunk.clear();
+  append_page(chunk, ObParquetType::DICTIONARY_PAGE, 2, ObParquetType::PLAIN, dict_page);
+  append_page(chunk, ObParquetType::DATA_PAGE, 3, ObParquetType::RLE_DICTIONARY, page);
+  ASSERT_EQ(OB_INVALID_DATA, read_chunk(chunk, 3, values));
+  // dictionary larger than its page
+  page[page.size() - 1] = 1;
+  chunk.clear();
+  append_page(chunk, ObParquetType::DICTIONARY_PAGE, 100000, ObParquetType::PLAIN, dict_page);
+  append_page(chunk, ObParquetType::DATA_PAGE, 3, ObParquetType::RLE_DICTIONARY, page);
+  ASSERT_EQ(OB_INVALID_DATA, read_chunk(chunk, 3, values));
+  // dictionary page is missing
+  chunk.clear();
+  append_page(chunk, ObParquetType::DATA_PAGE, 3, ObParquetType::RLE_DICTIONARY, page);
+  ASSERT_EQ(OB_INVALID_DATA, read_chunk(chunk, 3, values));
+}
+
+TEST_F(TestParquetReader, skip_by_statistics)
+{
+  for (int64_t f = 0; f < ARRAYSIZEOF(TEST_FILES); ++f) {
+    std::string data;
+    ObParquetFileMeta meta;
+    load_file(TEST_FILES[f], data, meta);
+    // id of the first row group is in [0, 39]
+    const ObParquetColumnDesc &desc = meta.get_column(0);
+    const ObParquetColumnChunkMeta &chunk = meta.get_column_chunk(0, 0);
+    ObDatum value;
+    int64_t value_buf = 0;
+    bool can_skip = false;
+    value.ptr_ = reinterpret_cast<const char *>(&value_buf);
+    struct {
+      ObItemType cmp_type_;
+      int64_t value_;
+      bool can_skip_;
+    } cases[] = {
+      { T_OP_EQ, 50, true },
+      { T_OP_EQ, 39, false },
+      { T_OP_EQ, -1, true },
+      { T_OP_GT, 38, false },
+      { T_OP_GT, 39, true },
+      { T_OP_GE, 39, false },
+      { T_OP_GE, 40, true },
+      { T_OP_LT, 0, true },
+      { T_OP_LT, 1, false },
+      { T_OP_LE, 0, false },
+      { T_OP_LE, -1, true },
+    };
+    for (int64_t i = 0; i < ARRAYSIZEOF(cases); ++i) {
+      value.set_int(cases[i].value_);
+      ASSERT_EQ(OB_SUCCESS, chunk.can_skip(desc, cases[i].cmp_type_, ObIntTC, value, can_skip));
+      ASSERT_EQ(cases[i].can_skip_, can_skip) << "case " << i;
+    }
+    // int values are not compared with the statistics of other types
+    ASSERT_EQ(OB_SUCCESS, meta.get_column_chunk(0, 2).can_skip(meta.get_column(2), T_OP_EQ, ObIntTC,
+                                                               value, can_skip));
+    ASSERT_FALSE(can_skip);
+    // null never satisfies a comparison, which is left to the filter
+    value.set_null();
+    ASSERT_EQ(OB_SUCCESS, chunk.can_skip(desc, T_OP_EQ, ObIntTC, value, can_skip));
+    ASSERT_FALSE(can_skip);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_parquet_file_reader.log*");
+  OB_LOGGER.set_file_name("test_parquet_file_reader.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  if (argc > 1 && argv[1] != NULL) {
+    file_path = argv[1];
+  }
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
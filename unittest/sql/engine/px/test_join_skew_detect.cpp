@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_EXE
+#include <gtest/gtest.h>
+#define private public
+#include "sql/engine/px/datahub/components/ob_dh_join_skew.h"
+#include "sql/engine/px/ob_dfo_mgr.h"
+#include "sql/optimizer/ob_join_order.h"
+#undef private
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class ObJoinSkewDetectTest : public ::testing::Test
+{
+public:
+  ObJoinSkewDetectTest() : alloc_("JoinSkewTest"), dfo_mgr_(alloc_) {}
+  virtual ~ObJoinSkewDetectTest() = default;
+  virtual void SetUp() {};
+  virtual void TearDown() {};
+protected:
+  ObArenaAllocator alloc_;
+  ObDfoMgr dfo_mgr_;
+};
+
+TEST_F(ObJoinSkewDetectTest, cost_gating)
+{
+  const int64_t min_build = JoinPath::SKEW_DETECT_MIN_BUILD_ROWS_PER_DOP;
+  const int64_t min_rows = JoinPath::SKEW_DETECT_MIN_ROWS_PER_DOP;
+  // serial join never detects skew
+  ASSERT_FALSE(JoinPath::need_runtime_skew_detect(1, 1e9, 1e9));
+  // tiny build side, header sample is meaningless
+  ASSERT_FALSE(JoinPath::need_runtime_skew_detect(8, 8 * min_build - 1, 1e9));
+  // small join, imbalance costs less than the synchronization
+  ASSERT_FALSE(JoinPath::need_runtime_skew_detect(8, 8 * min_build, 8 * min_rows - 8 * min_build - 1));
+  ASSERT_TRUE(JoinPath::need_runtime_skew_detect(8, 8 * min_build, 8 * min_rows - 8 * min_build));
+  ASSERT_TRUE(JoinPath::need_runtime_skew_detect(64, 1e8, 1e9));
+  // more workers need more rows
+  ASSERT_FALSE(JoinPath::need_runtime_skew_detect(64, 8 * min_build, 8 * min_rows));
+}
+
+TEST_F(ObJoinSkewDetectTest, process_skew_keys)
+{
+  ObJoinSkewPieceMsgCtx ctx(1, 4, INT64_MAX, 30, dfo_mgr_);
+  // 4 build tasks, 100 sampled rows each, key 7 is 40% of all rows
+  for (int64_t i = 0; i < 4; ++i) {
+    ASSERT_EQ(OB_SUCCESS, ctx.key_stats_.push_back(ObJoinSkewKeyStat(7, 40)));
+    ASSERT_EQ(OB_SUCCESS, ctx.key_stats_.push_back(ObJoinSkewKeyStat(100 + i, 20)));
+    ctx.whole_msg_.sample_row_cnt_ += 100;
+  }
+  // key 9 is 10% of all rows, reported by one task only
+  ASSERT_EQ(OB_SUCCESS, ctx.key_stats_.push_back(ObJoinSkewKeyStat(9, 40)));
+  ASSERT_EQ(OB_SUCCESS, ctx.process_skew_keys());
+  ASSERT_TRUE(ctx.whole_msg_ready_);
+  ASSERT_EQ(1, ctx.whole_msg_.skew_values_hash_.count());
+  ASSERT_EQ(7, ctx.whole_msg_.skew_values_hash_.at(0));
+
+  // too few sampled rows, never skewed
+  ctx.reset_resource();
+  ASSERT_EQ(OB_SUCCESS, ctx.key_stats_.push_back(ObJoinSkewKeyStat(7, 60)));
+  ctx.whole_msg_.sample_row_cnt_ = ObJoinSkewPieceMsgCtx::MIN_SKEW_SAMPLE_ROW_CNT - 1;
+  ASSERT_EQ(OB_SUCCESS, ctx.process_skew_keys());
+  ASSERT_TRUE(ctx.whole_msg_ready_);
+  ASSERT_EQ(0, ctx.whole_msg_.skew_values_hash_.count());
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
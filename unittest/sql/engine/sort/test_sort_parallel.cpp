@@ -0,0 +1,173 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+#include <gtest/gtest.h>
+#include <thread>
+#define private public
+#define protected public
+#include "sql/engine/sort/ob_sort_op_impl.h"
+#include "sql/engine/ob_exec_context.h"
+#undef protected
+#undef private
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+static int int_cmp(const ObDatum &l, const ObDatum &r, int &cmp_ret)
+{
+  const int64_t lv = l.get_int();
+  const int64_t rv = r.get_int();
+  cmp_ret = lv < rv ? -1 : (lv > rv ? 1 : 0);
+  return OB_SUCCESS;
+}
+
+class TestSortParallel : public ::testing::Test
+{
+public:
+  static const int64_t ROW_CNT = 200000;
+
+  TestSortParallel()
+    : allocator_("TestSortPara"), exec_ctx_(allocator_), rows_(), values_(NULL) {}
+
+  virtual void SetUp()
+  {
+    srand(1234);
+    ObSortFieldCollation collation(0, CS_TYPE_BINARY, true, NULL_FIRST);
+    ObSortCmpFunc cmp_func;
+    cmp_func.cmp_func_ = int_cmp;
+    ASSERT_EQ(OB_SUCCESS, collations_.push_back(collation));
+    ASSERT_EQ(OB_SUCCESS, cmp_funcs_.push_back(cmp_func));
+    const int64_t row_size = sizeof(ObChunkDatumStore::StoredRow) + sizeof(ObDatum);
+    char *buf = static_cast<char *>(allocator_.alloc(row_size * ROW_CNT));
+    values_ = static_cast<int64_t *>(allocator_.alloc(sizeof(int64_t) * ROW_CNT));
+    ASSERT_TRUE(NULL != buf && NULL != values_);
+    for (int64_t i = 0; i < ROW_CNT; i++) {
+      ObChunkDatumStore::StoredRow *row =
+          new (buf + row_size * i) ObChunkDatumStore::StoredRow();
+      row->cnt_ = 1;
+      row->row_size_ = static_cast<uint32_t>(row_size);
+      values_[i] = rand() % (ROW_CNT / 4);
+      row->cells()[0].ptr_ = reinterpret_cast<const char *>(&values_[i]);
+      row->cells()[0].pack_ = sizeof(int64_t);
+      ASSERT_EQ(OB_SUCCESS, rows_.push_back(row));
+    }
+  }
+
+  void init_task(ObSortOpImpl::ParallelSortTask &task, const int64_t begin, const int64_t end,
+                 const int *stop_ret)
+  {
+    task.begin_ = begin;
+    task.end_ = end;
+    ASSERT_EQ(OB_SUCCESS, task.comp_.init(&collations_, &cmp_funcs_, &exec_ctx_, false));
+    task.comp_.set_stop_ret(stop_ret);
+  }
+
+  static int64_t value(const ObChunkDatumStore::StoredRow *row)
+  {
+    return row->cells()[0].get_int();
+  }
+
+protected:
+  ObArenaAllocator allocator_;
+  // no physical plan ctx, check_status() of it fails with OB_NOT_INIT.
+  ObExecContext exec_ctx_;
+  ObSEArray<ObSortFieldCollation, 1> collations_;
+  ObSEArray<ObSortCmpFunc, 1> cmp_funcs_;
+  ObArray<ObChunkDatumStore::StoredRow *> rows_;
+  int64_t *values_;
+};
+
+// compare in px pool thread checks the stop flag, not the exec ctx of query worker.
+TEST_F(TestSortParallel, stop_ret)
+{
+  int stop_ret = OB_SUCCESS;
+  ObSortOpImpl::ParallelSortTask task(OB_SYS_TENANT_ID);
+  init_task(task, 0, ROW_CNT, &stop_ret);
+  task.sort(rows_);
+  ASSERT_EQ(OB_SUCCESS, task.ret_);
+  for (int64_t i = 1; i < ROW_CNT; i++) {
+    ASSERT_LE(value(rows_.at(i - 1)), value(rows_.at(i)));
+  }
+
+  std::random_shuffle(&rows_.at(0), &rows_.at(0) + ROW_CNT);
+  stop_ret = OB_ERR_QUERY_INTERRUPTED;
+  ObSortOpImpl::ParallelSortTask stopped_task(OB_SYS_TENANT_ID);
+  init_task(stopped_task, 0, ROW_CNT, &stop_ret);
+  stopped_task.sort(rows_);
+  ASSERT_EQ(OB_ERR_QUERY_INTERRUPTED, stopped_task.ret_);
+}
+
+// ranges sorted by concurrent threads are merged into one ordered sequence.
+TEST_F(TestSortParallel, concurrent_sort_and_merge)
+{
+  const int64_t task_cnt = 4;
+  int stop_ret = OB_SUCCESS;
+  ObMonitorNode monitor_info;
+  ObSortOpImpl sort_impl(monitor_info);
+  ASSERT_EQ(OB_SUCCESS, CURRENT_CONTEXT->CREATE_CONTEXT(sort_impl.mem_context_,
+      lib::ContextParam().set_mem_attr(OB_SYS_TENANT_ID, "TestSortPara")));
+  sort_impl.rows_ = &rows_;
+  ASSERT_EQ(OB_SUCCESS, sort_impl.comp_.init(&collations_, &cmp_funcs_, &exec_ctx_, false));
+
+  ObSortOpImpl::ParallelSortTask *tasks[task_cnt];
+  std::vector<std::thread> threads;
+  for (int64_t i = 0; i < task_cnt; i++) {
+    tasks[i] = new ObSortOpImpl::ParallelSortTask(OB_SYS_TENANT_ID);
+    init_task(*tasks[i], ROW_CNT * i / task_cnt, ROW_CNT * (i + 1) / task_cnt, &stop_ret);
+  }
+  for (int64_t i = 0; i < task_cnt; i++) {
+    ObSortOpImpl::ParallelSortTask *task = tasks[i];
+    ObArray<ObChunkDatumStore::StoredRow *> *rows = &rows_;
+    threads.push_back(std::thread([task, rows]() { task->sort(*rows); }));
+  }
+  for (int64_t i = 0; i < task_cnt; i++) {
+    threads[i].join();
+    ASSERT_EQ(OB_SUCCESS, tasks[i]->ret_);
+  }
+
+  // merge needs tasks in one array
+  ObSortOpImpl::ParallelSortTask *task_array = static_cast<ObSortOpImpl::ParallelSortTask *>(
+      allocator_.alloc(sizeof(ObSortOpImpl::ParallelSortTask) * task_cnt));
+  ASSERT_TRUE(NULL != task_array);
+  for (int64_t i = 0; i < task_cnt; i++) {
+    new (&task_array[i]) ObSortOpImpl::ParallelSortTask(OB_SYS_TENANT_ID);
+    task_array[i].begin_ = tasks[i]->begin_;
+    task_array[i].end_ = tasks[i]->end_;
+  }
+  ObChunkDatumStore::StoredRow **sorted_rows = static_cast<ObChunkDatumStore::StoredRow **>(
+      allocator_.alloc(sizeof(ObChunkDatumStore::StoredRow *) * ROW_CNT));
+  ASSERT_TRUE(NULL != sorted_rows);
+  ASSERT_EQ(OB_SUCCESS, sort_impl.merge_parallel_sorted_rows(task_array, task_cnt, sorted_rows));
+  int64_t sum = 0;
+  int64_t expect_sum = 0;
+  for (int64_t i = 0; i < ROW_CNT; i++) {
+    if (i > 0) {
+      ASSERT_LE(value(sorted_rows[i - 1]), value(sorted_rows[i]));
+    }
+    sum += value(sorted_rows[i]);
+    expect_sum += values_[i];
+  }
+  ASSERT_EQ(expect_sum, sum);
+  for (int64_t i = 0; i < task_cnt; i++) {
+    task_array[i].~ParallelSortTask();
+    delete tasks[i];
+  }
+  sort_impl.rows_ = NULL;
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("WARN");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
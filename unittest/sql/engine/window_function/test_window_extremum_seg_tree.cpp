@@ -0,0 +1,161 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+
+#include "sql/engine/window_function/ob_window_function_op.h"
+#include "lib/random/ob_random.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+typedef ObWindowFunctionOp::ExtremumSegTree ExtremumSegTree;
+typedef ObWindowFunctionOp::Frame Frame;
+
+static int cmp_int(const ObDatum &l, const ObDatum &r, int &cmp_ret)
+{
+  cmp_ret = l.get_int() < r.get_int() ? -1 : (l.get_int() > r.get_int() ? 1 : 0);
+  return OB_SUCCESS;
+}
+
+class TestExtremumSegTree : public ::testing::Test
+{
+public:
+  TestExtremumSegTree() : tree_(OB_SERVER_TENANT_ID) {}
+  virtual void SetUp() override {}
+  virtual void TearDown() override { tree_.reuse(); }
+
+  // values[i] < 0 is NULL
+  void build(const int64_t first_row_idx, const std::vector<int64_t> &values, const bool is_max)
+  {
+    ASSERT_EQ(OB_SUCCESS, tree_.init(first_row_idx, values.size(), is_max, cmp_int));
+    for (int64_t i = 0; i < values.size(); i++) {
+      ObDatum datum;
+      if (values[i] < 0) {
+        datum.set_null();
+      } else {
+        datum.ptr_ = reinterpret_cast<const char *>(&values[i]);
+        datum.pack_ = sizeof(int64_t);
+      }
+      ASSERT_EQ(OB_SUCCESS, tree_.set_leaf(first_row_idx + i, datum));
+    }
+    ASSERT_EQ(OB_SUCCESS, tree_.build());
+    ASSERT_TRUE(tree_.is_built());
+  }
+
+  // the latter row is preferred if equal, -1 if all null
+  int64_t brute_force(const int64_t first_row_idx, const std::vector<int64_t> &values,
+                      const bool is_max, const int64_t head, const int64_t tail)
+  {
+    int64_t res = -1;
+    for (int64_t i = head; i <= tail; i++) {
+      const int64_t v = values[i - first_row_idx];
+      if (v < 0) {
+      } else if (-1 == res) {
+        res = i;
+      } else {
+        const int64_t best = values[res - first_row_idx];
+        if (v == best || (is_max ? v > best : v < best)) {
+          res = i;
+        }
+      }
+    }
+    return res;
+  }
+
+protected:
+  ExtremumSegTree tree_;
+};
+
+TEST_F(TestExtremumSegTree, query)
+{
+  const int64_t first_row_idx = 1000;
+  for (int64_t round = 0; round < 4; round++) {
+    const bool is_max = 0 == round % 2;
+    const int64_t row_cnt = 0 == round / 2 ? 1 + ObRandom::rand(1, 100) : 5000;
+    std::vector<int64_t> values;
+    for (int64_t i = 0; i < row_cnt; i++) {
+      // about 10% NULL and many duplicates
+      values.push_back(0 == ObRandom::rand(0, 9) ? -1 : ObRandom::rand(0, 100));
+    }
+    build(first_row_idx, values, is_max);
+    for (int64_t i = 0; i < 2000; i++) {
+      int64_t head = first_row_idx + ObRandom::rand(0, row_cnt - 1);
+      int64_t tail = first_row_idx + ObRandom::rand(0, row_cnt - 1);
+      if (head > tail) {
+        std::swap(head, tail);
+      }
+      int64_t row_idx = -2;
+      ASSERT_EQ(OB_SUCCESS, tree_.query(head, tail, row_idx));
+      ASSERT_EQ(brute_force(first_row_idx, values, is_max, head, tail), row_idx);
+    }
+    // frame out of the partition
+    int64_t row_idx = -2;
+    ASSERT_EQ(OB_INVALID_ARGUMENT, tree_.query(first_row_idx - 1, first_row_idx, row_idx));
+    ASSERT_EQ(OB_INVALID_ARGUMENT, tree_.query(first_row_idx, first_row_idx + row_cnt, row_idx));
+    tree_.reuse();
+  }
+}
+
+TEST_F(TestExtremumSegTree, all_null)
+{
+  std::vector<int64_t> values(100, -1);
+  build(0, values, true);
+  int64_t row_idx = -2;
+  ASSERT_EQ(OB_SUCCESS, tree_.query(10, 90, row_idx));
+  ASSERT_EQ(-1, row_idx);
+}
+
+TEST_F(TestExtremumSegTree, need_build)
+{
+  Frame small_frame(0, ExtremumSegTree::MIN_FRAME_SIZE - 2);
+  Frame frame(0, ExtremumSegTree::MIN_FRAME_SIZE - 1);
+  for (int64_t i = 0; i < ExtremumSegTree::MIN_RESTART_CNT * 2; i++) {
+    ASSERT_FALSE(tree_.need_build(small_frame));
+  }
+  for (int64_t i = 0; i < ExtremumSegTree::MIN_RESTART_CNT; i++) {
+    ASSERT_FALSE(tree_.need_build(frame));
+  }
+  ASSERT_TRUE(tree_.need_build(frame));
+
+  // memory is released and the partition falls back to restart
+  std::vector<int64_t> values(1000, 1);
+  build(0, values, false);
+  ASSERT_GT(tree_.get_mem_used(), 0);
+  tree_.disable();
+  ASSERT_FALSE(tree_.is_built());
+  ASSERT_EQ(0, tree_.get_mem_used());
+  for (int64_t i = 0; i < ExtremumSegTree::MIN_RESTART_CNT * 2; i++) {
+    ASSERT_FALSE(tree_.need_build(frame));
+  }
+  // new partition
+  tree_.reuse();
+  for (int64_t i = 0; i < ExtremumSegTree::MIN_RESTART_CNT; i++) {
+    ASSERT_FALSE(tree_.need_build(frame));
+  }
+  ASSERT_TRUE(tree_.need_build(frame));
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,285 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include <gtest/gtest.h>
+#define protected public
+#define private public
+#include "storage/blocksstable/cs_encoding/ob_cs_decoding_util.h"
+#include "lib/time/ob_time_utility.h"
+#include <iostream>
+#include <random>
+#include <algorithm>
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+using namespace common;
+
+// Compare the batch filter kernels used without parent filter with the row by row kernels, on the
+// integer stream of every width, and print the time cost of both.
+class TestCSBatchFilterPerf : public ::testing::Test
+{
+public:
+  static const int64_t ROW_CNT = 64 * 1024;
+  static const int64_t ROUND = 20;
+  static const int64_t NULL_PCT = 10;
+  static const int64_t MAX_VAL = 1000;
+  static const int64_t IN_VAL_CNT = 8;
+
+  TestCSBatchFilterPerf()
+    : allocator_(),
+      batch_bitmap_(allocator_),
+      row_bitmap_(allocator_),
+      null_bitmap_(nullptr)
+  {}
+  virtual ~TestCSBatchFilterPerf() {}
+  virtual void SetUp();
+  virtual void TearDown();
+
+  template <typename T>
+  void test_all_op(const bool has_null_bitmap);
+  template <typename T>
+  void test_equal_range();
+
+private:
+  template <typename T>
+  void init_data(T *vals);
+  void preload_null(const bool has_null_bitmap, const bool is_batch, ObBitmap &bitmap);
+  void check_and_report(const char *name, const int64_t width, const bool has_null_bitmap,
+                        const int64_t batch_cost, const int64_t row_cost);
+
+private:
+  ObArenaAllocator allocator_;
+  ObBitmap batch_bitmap_;
+  ObBitmap row_bitmap_;
+  char *null_bitmap_;
+  std::mt19937_64 rand_;
+};
+
+void TestCSBatchFilterPerf::SetUp()
+{
+  ASSERT_EQ(OB_SUCCESS, batch_bitmap_.init(ROW_CNT));
+  ASSERT_EQ(OB_SUCCESS, row_bitmap_.init(ROW_CNT));
+  null_bitmap_ = static_cast<char *>(allocator_.alloc(ROW_CNT / 8));
+  ASSERT_NE(nullptr, null_bitmap_);
+  MEMSET(null_bitmap_, 0, ROW_CNT / 8);
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    if (rand_() % 100 < NULL_PCT) {
+      null_bitmap_[i / 8] |= (1 << (7 - i % 8));
+    }
+  }
+}
+
+void TestCSBatchFilterPerf::TearDown()
+{
+  batch_bitmap_.destroy();
+  row_bitmap_.destroy();
+  allocator_.reset();
+}
+
+template <typename T>
+void TestCSBatchFilterPerf::init_data(T *vals)
+{
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    vals[i] = static_cast<T>(rand_() % MAX_VAL);
+  }
+}
+
+void TestCSBatchFilterPerf::preload_null(const bool has_null_bitmap, const bool is_batch, ObBitmap &bitmap)
+{
+  bitmap.reuse();
+  if (!has_null_bitmap) {
+  } else if (is_batch) {
+    ObCSDecodingUtil::batch_test_bits(null_bitmap_, 0, ROW_CNT, bitmap.get_data());
+  } else {
+    for (int64_t i = 0; i < ROW_CNT; ++i) {
+      if (ObCSDecodingUtil::test_bit(null_bitmap_, i)) {
+        ASSERT_EQ(OB_SUCCESS, bitmap.set(i));
+      }
+    }
+  }
+}
+
+void TestCSBatchFilterPerf::check_and_report(
+    const char *name,
+    const int64_t width,
+    const bool has_null_bitmap,
+    const int64_t batch_cost,
+    const int64_t row_cost)
+{
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    ASSERT_EQ(row_bitmap_.test(i), batch_bitmap_.test(i)) << name << " width " << width << " row " << i;
+  }
+  std::cout << name << " width=" << width << " null_bitmap=" << has_null_bitmap
+            << " batch_cost=" << batch_cost << "us row_cost=" << row_cost << "us"
+            << " popcnt=" << batch_bitmap_.popcnt() << std::endl;
+}
+
+#define RUN_FILTER_PERF(name, batch_expr, row_expr) \
+  { \
+    int64_t batch_cost = 0; \
+    int64_t row_cost = 0; \
+    for (int64_t round = 0; round < ROUND; ++round) { \
+      preload_null(has_null_bitmap, true, batch_bitmap_); \
+      int64_t start_time = ObTimeUtility::current_time(); \
+      ASSERT_EQ(OB_SUCCESS, batch_expr); \
+      batch_cost += ObTimeUtility::current_time() - start_time; \
+      preload_null(has_null_bitmap, false, row_bitmap_); \
+      start_time = ObTimeUtility::current_time(); \
+      ASSERT_EQ(OB_SUCCESS, row_expr); \
+      row_cost += ObTimeUtility::current_time() - start_time; \
+    } \
+    check_and_report(name, sizeof(T), has_null_bitmap, batch_cost, row_cost); \
+  }
+
+template <typename T>
+void TestCSBatchFilterPerf::test_all_op(const bool has_null_bitmap)
+{
+  T *vals = static_cast<T *>(allocator_.alloc(sizeof(T) * ROW_CNT));
+  ASSERT_NE(nullptr, vals);
+  init_data(vals);
+  const char *buf = reinterpret_cast<const char *>(vals);
+  ObCSFilterFunctionFactory &factory = ObCSFilterFunctionFactory::instance();
+  const uint64_t filter_val = MAX_VAL / 2;
+
+  RUN_FILTER_PERF("eq",
+    factory.integer_compare_tranverse(buf, sizeof(T), filter_val, 0, ROW_CNT, has_null_bitmap,
+        sql::WHITE_OP_EQ, nullptr, batch_bitmap_),
+    (has_null_bitmap
+        ? (ObCSIntegerFilterOpFunc<T, CSEqualsOp<T>, false, true>::compare_op_tranverse)
+        : (ObCSIntegerFilterOpFunc<T, CSEqualsOp<T>, false, false>::compare_op_tranverse))(
+        buf, filter_val, 0, ROW_CNT, nullptr, row_bitmap_));
+
+  RUN_FILTER_PERF("lt",
+    factory.integer_compare_tranverse(buf, sizeof(T), filter_val, 0, ROW_CNT, has_null_bitmap,
+        sql::WHITE_OP_LT, nullptr, batch_bitmap_),
+    (has_null_bitmap
+        ? (ObCSIntegerFilterOpFunc<T, CSLessOp<T>, false, true>::compare_op_tranverse)
+        : (ObCSIntegerFilterOpFunc<T, CSLessOp<T>, false, false>::compare_op_tranverse))(
+        buf, filter_val, 0, ROW_CNT, nullptr, row_bitmap_));
+
+  const uint64_t bt_vals[] = {MAX_VAL / 4, MAX_VAL / 2};
+  RUN_FILTER_PERF("bt",
+    factory.integer_bt_tranverse(buf, sizeof(T), bt_vals, 0, ROW_CNT, has_null_bitmap,
+        nullptr, batch_bitmap_),
+    (has_null_bitmap
+        ? (ObCSIntegerFilterOpFunc<T, CSBetweenOp<T>, false, true>::between_op_tranverse)
+        : (ObCSIntegerFilterOpFunc<T, CSBetweenOp<T>, false, false>::between_op_tranverse))(
+        buf, bt_vals, 0, ROW_CNT, nullptr, row_bitmap_));
+
+  bool in_vals_valid[IN_VAL_CNT];
+  uint64_t in_vals[IN_VAL_CNT];
+  for (int64_t i = 0; i < IN_VAL_CNT; ++i) {
+    in_vals_valid[i] = (0 != i % 3);
+    in_vals[i] = rand_() % MAX_VAL;
+  }
+  RUN_FILTER_PERF("in",
+    factory.integer_in_tranverse(buf, sizeof(T), in_vals_valid, in_vals, IN_VAL_CNT, 0, ROW_CNT, 0,
+        has_null_bitmap, nullptr, batch_bitmap_),
+    (has_null_bitmap
+        ? (ObCSIntegerFilterOpFunc<T, CSEqualsOp<T>, false, true>::in_op_tranverse)
+        : (ObCSIntegerFilterOpFunc<T, CSEqualsOp<T>, false, false>::in_op_tranverse))(
+        buf, in_vals_valid, in_vals, IN_VAL_CNT, 0, ROW_CNT, 0, nullptr, row_bitmap_));
+
+  if (!has_null_bitmap) {
+    // use MAX_VAL - 1 as the null replaced value
+    const uint64_t null_replaced_val = MAX_VAL - 1;
+    RUN_FILTER_PERF("bt_with_null",
+      factory.integer_bt_tranverse_with_null(buf, sizeof(T), bt_vals, null_replaced_val, 0, ROW_CNT,
+          nullptr, batch_bitmap_),
+      (ObCSIntegerFilterOpFunc<T, CSBetweenOp<T>, false, false>::between_op_tranverse_with_null)(
+          buf, bt_vals, null_replaced_val, 0, ROW_CNT, nullptr, row_bitmap_));
+    RUN_FILTER_PERF("in_with_null",
+      factory.integer_in_tranverse_with_null(buf, sizeof(T), null_replaced_val, in_vals_valid, in_vals,
+          IN_VAL_CNT, 0, ROW_CNT, 0, nullptr, batch_bitmap_),
+      (ObCSIntegerFilterOpFunc<T, CSEqualsOp<T>, false, false>::in_op_tranverse_with_null)(
+          buf, null_replaced_val, in_vals_valid, in_vals, IN_VAL_CNT, 0, ROW_CNT, 0, nullptr, row_bitmap_));
+  }
+}
+
+TEST_F(TestCSBatchFilterPerf, test_null_bitmap)
+{
+  const int64_t row_start = 3;
+  const int64_t row_cnt = ROW_CNT - 11;
+  preload_null(false, true, batch_bitmap_);
+  ObCSDecodingUtil::batch_test_bits(null_bitmap_, row_start, row_cnt, batch_bitmap_.get_data());
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    ASSERT_EQ(ObCSDecodingUtil::test_bit(null_bitmap_, row_start + i), batch_bitmap_.test(i));
+  }
+}
+
+template <typename T>
+void TestCSBatchFilterPerf::test_equal_range()
+{
+  T *vals = static_cast<T *>(allocator_.alloc(sizeof(T) * ROW_CNT));
+  ASSERT_NE(nullptr, vals);
+  init_data(vals);
+  std::sort(vals, vals + ROW_CNT);
+  const char *buf = reinterpret_cast<const char *>(vals);
+  ObCSFilterFunctionFactory &factory = ObCSFilterFunctionFactory::instance();
+  int64_t search_cost = 0;
+  int64_t std_cost = 0;
+  for (int64_t round = 0; round < ROUND; ++round) {
+    const uint64_t val = rand_() % (MAX_VAL + 2);
+    const T cast_val = static_cast<T>(val);
+    const int64_t row_start = rand_() % ROW_CNT;
+    const int64_t row_end = row_start + rand_() % (ROW_CNT - row_start + 1);
+    int64_t lower_idx = 0;
+    int64_t upper_idx = 0;
+    int64_t start_time = ObTimeUtility::current_time();
+    factory.integer_equal_range(buf, sizeof(T), val, row_start, row_end, lower_idx, upper_idx);
+    search_cost += ObTimeUtility::current_time() - start_time;
+    start_time = ObTimeUtility::current_time();
+    const int64_t std_lower_idx = std::lower_bound(vals + row_start, vals + row_end, cast_val) - vals;
+    const int64_t std_upper_idx = std::upper_bound(vals + row_start, vals + row_end, cast_val) - vals;
+    std_cost += ObTimeUtility::current_time() - start_time;
+    ASSERT_EQ(std_lower_idx, lower_idx) << "width " << sizeof(T) << " val " << val;
+    ASSERT_EQ(std_upper_idx, upper_idx) << "width " << sizeof(T) << " val " << val;
+  }
+  std::cout << "equal_range width=" << sizeof(T) << " search_cost=" << search_cost
+            << "us std_cost=" << std_cost << "us" << std::endl;
+}
+
+TEST_F(TestCSBatchFilterPerf, test_integer_filter)
+{
+  test_all_op<uint8_t>(false);
+  test_all_op<uint8_t>(true);
+  test_all_op<uint16_t>(false);
+  test_all_op<uint16_t>(true);
+  test_all_op<uint32_t>(false);
+  test_all_op<uint32_t>(true);
+  test_all_op<uint64_t>(false);
+  test_all_op<uint64_t>(true);
+}
+
+TEST_F(TestCSBatchFilterPerf, test_integer_equal_range)
+{
+  test_equal_range<uint8_t>();
+  test_equal_range<uint16_t>();
+  test_equal_range<uint32_t>();
+  test_equal_range<uint64_t>();
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_cs_batch_filter_perf.log*");
+  OB_LOGGER.set_file_name("test_cs_batch_filter_perf.log", true, false);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
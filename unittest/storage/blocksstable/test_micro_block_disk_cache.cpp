@@ -0,0 +1,328 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+#define protected public
+#define private public
+#include "storage/blocksstable/ob_micro_block_disk_cache.h"
+#include "storage/blocksstable/ob_micro_block_cache.h"
+#include "storage/blocksstable/ob_micro_block_header.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+
+namespace unittest
+{
+static const char *TEST_DIR = "./test_micro_block_disk_cache_dir";
+
+class TestMicroBlockDiskCache : public ::testing::Test
+{
+public:
+  TestMicroBlockDiskCache()
+    : allocator_(ObModIds::TEST), des_meta_(ObCompressorType::NONE_COMPRESSOR, FLAT_ROW_STORE, 0, 0, nullptr) {}
+  virtual void SetUp()
+  {
+    system("rm -rf ./test_micro_block_disk_cache_dir");
+    ASSERT_EQ(OB_SUCCESS, cache_.init(TEST_DIR, ObMicroBlockDiskCache::MIN_CACHE_FILE_SIZE));
+  }
+  virtual void TearDown()
+  {
+    cache_.destroy();
+    allocator_.reset();
+    system("rm -rf ./test_micro_block_disk_cache_dir");
+  }
+  static void make_key(const int64_t block_index, const int64_t write_seq, const int64_t size,
+                       ObMicroBlockCacheKey &key)
+  {
+    MacroBlockId macro_id;
+    macro_id.set_block_index(block_index);
+    macro_id.set_write_seq(write_seq);
+    key.set(OB_SERVER_TENANT_ID, macro_id, 4096, size);
+  }
+  // a raw micro block of %size bytes with a valid header and payload checksum
+  static void fill_block(char *buf, const int64_t size, const char fill)
+  {
+    ObMicroBlockHeader header;
+    int64_t pos = 0;
+    header.column_count_ = 1;
+    header.rowkey_column_count_ = 1;
+    header.row_store_type_ = FLAT_ROW_STORE;
+    header.header_size_ = header.get_serialize_size();
+    const int64_t payload_size = size - header.header_size_;
+    MEMSET(buf + header.header_size_, fill, payload_size);
+    header.data_length_ = static_cast<int32_t>(payload_size);
+    header.data_zlength_ = static_cast<int32_t>(payload_size);
+    header.data_checksum_ = ob_crc64_sse42(buf + header.header_size_, payload_size);
+    header.set_header_checksum();
+    ASSERT_EQ(OB_SUCCESS, header.serialize(buf, size, pos));
+  }
+  char *make_block(const int64_t size, const char fill)
+  {
+    char *buf = static_cast<char *>(allocator_.alloc(size));
+    if (nullptr != buf) {
+      fill_block(buf, size, fill);
+    }
+    return buf;
+  }
+  // write all queued blocks like the fill thread does
+  void flush()
+  {
+    void *task = nullptr;
+    while (OB_SUCCESS == cache_.fill_queue_.pop(task)) {
+      ASSERT_EQ(OB_SUCCESS, cache_.write_entry(*static_cast<ObMicroBlockDiskCache::FillTask *>(task)));
+      cache_.free_task(static_cast<ObMicroBlockDiskCache::FillTask *>(task));
+    }
+  }
+  // read the entry like the io manager does for async_get()
+  int get(const ObMicroBlockCacheKey &key, ObMicroBlockDesMeta &des_meta, const char *&block)
+  {
+    int ret = OB_SUCCESS;
+    const int64_t entry_size = ObMicroBlockDiskCache::get_entry_size(key.get_micro_block_id().size_);
+    char *entry_buf = static_cast<char *>(allocator_.alloc(entry_size));
+    int64_t lsn = 0;
+    int64_t read_size = 0;
+    if (OB_FAIL(cache_.index_.get_refactored(key.hash(), lsn))) {
+      ret = OB_HASH_NOT_EXIST == ret ? OB_ENTRY_NOT_EXIST : ret;
+    } else if (OB_FAIL(cache_.read_file(entry_buf, entry_size, cache_.get_file_offset(lsn), read_size))) {
+    } else {
+      ret = cache_.check_entry(key, lsn, entry_buf, read_size, des_meta, block);
+    }
+    return ret;
+  }
+  void check_hit(const ObMicroBlockCacheKey &key, const char *expect)
+  {
+    ObMicroBlockDesMeta des_meta;
+    const char *buf = nullptr;
+    const int64_t size = key.get_micro_block_id().size_;
+    ASSERT_EQ(OB_SUCCESS, get(key, des_meta, buf));
+    ASSERT_EQ(0, MEMCMP(expect, buf, size));
+    ASSERT_EQ(des_meta_.compressor_type_, des_meta.compressor_type_);
+    ASSERT_EQ(des_meta_.row_store_type_, des_meta.row_store_type_);
+  }
+  void check_miss(const ObMicroBlockCacheKey &key)
+  {
+    ObMicroBlockDesMeta des_meta;
+    const char *buf = nullptr;
+    ASSERT_EQ(OB_ENTRY_NOT_EXIST, get(key, des_meta, buf));
+    ASSERT_EQ(nullptr, buf);
+  }
+  // recover like the fill thread does after the block manager sets the restart write seq
+  void recover(const int64_t restart_write_seq)
+  {
+    cache_.set_restart_write_seq(restart_write_seq);
+    cache_.stop_ = false; // the fill thread is not started in this test
+    ASSERT_EQ(OB_SUCCESS, cache_.recover());
+  }
+  void restart(const int64_t restart_write_seq)
+  {
+    cache_.destroy();
+    ASSERT_EQ(OB_SUCCESS, cache_.init(TEST_DIR, ObMicroBlockDiskCache::MIN_CACHE_FILE_SIZE));
+    recover(restart_write_seq);
+  }
+protected:
+  ObMicroBlockDiskCache cache_;
+  ObArenaAllocator allocator_;
+  ObMicroBlockDesMeta des_meta_;
+};
+
+TEST_F(TestMicroBlockDiskCache, entry_header)
+{
+  ObMicroBlockDiskCacheEntryHeader header;
+  ASSERT_FALSE(header.is_valid());
+  header.magic_ = ObMicroBlockDiskCacheEntryHeader::MAGIC;
+  header.version_ = ObMicroBlockDiskCacheEntryHeader::VERSION;
+  header.header_size_ = sizeof(ObMicroBlockDiskCacheEntryHeader);
+  header.lsn_ = 1024;
+  header.size_ = 100;
+  header.header_checksum_ = header.calc_header_checksum();
+  ASSERT_TRUE(header.is_valid());
+  ASSERT_LE(sizeof(ObMicroBlockDiskCacheEntryHeader), ObMicroBlockDiskCache::ENTRY_ALIGN_SIZE);
+
+  ObMicroBlockDiskCacheEntryHeader corrupted = header;
+  corrupted.offset_ = 1;
+  ASSERT_FALSE(corrupted.is_valid());
+  corrupted = header;
+  corrupted.version_ = 2;
+  corrupted.header_checksum_ = corrupted.calc_header_checksum();
+  ASSERT_FALSE(corrupted.is_valid());
+
+  ObMicroBlockDiskCacheSuperBlock super_block;
+  ASSERT_FALSE(super_block.is_valid());
+  ASSERT_LE(sizeof(ObMicroBlockDiskCacheSuperBlock), ObMicroBlockDiskCache::SUPER_BLOCK_SIZE);
+}
+
+TEST_F(TestMicroBlockDiskCache, put_and_get)
+{
+  ObMicroBlockCacheKey key;
+  const int64_t size = 10000;
+  make_key(10, 1, size, key);
+  char *block = make_block(size, 'a');
+  ASSERT_NE(nullptr, block);
+
+  check_miss(key);
+  ASSERT_EQ(OB_SUCCESS, cache_.put(key, des_meta_, block));
+  // not written yet
+  check_miss(key);
+  flush();
+  check_hit(key, block);
+  // entry is 512 aligned in the file
+  ASSERT_EQ(common::upper_align(sizeof(ObMicroBlockDiskCacheEntryHeader) + size,
+      ObMicroBlockDiskCache::ENTRY_ALIGN_SIZE), cache_.write_lsn_);
+
+  // same macro block reused with another write seq is a different key
+  ObMicroBlockCacheKey reused_key;
+  make_key(10, 2, size, reused_key);
+  check_miss(reused_key);
+
+  // an already cached block is not queued again
+  ASSERT_EQ(OB_SUCCESS, cache_.put(key, des_meta_, block));
+  ASSERT_EQ(0, cache_.fill_queue_.size());
+}
+
+TEST_F(TestMicroBlockDiskCache, corrupted_entry)
+{
+  ObMicroBlockCacheKey key;
+  const int64_t size = 4000;
+  make_key(11, 1, size, key);
+  char *block = make_block(size, 'b');
+  ASSERT_EQ(OB_SUCCESS, cache_.put(key, des_meta_, block));
+  flush();
+  check_hit(key, block);
+
+  // corrupt the block data, the entry is a miss and removed from index
+  char garbage[16];
+  MEMSET(garbage, 'x', sizeof(garbage));
+  ASSERT_EQ(OB_SUCCESS, cache_.write_file(garbage, sizeof(garbage),
+      cache_.get_file_offset(0) + sizeof(ObMicroBlockDiskCacheEntryHeader) + 100));
+  check_miss(key);
+  ASSERT_EQ(0, cache_.index_.size());
+}
+
+TEST_F(TestMicroBlockDiskCache, restart)
+{
+  const int64_t size = 8000;
+  ObMicroBlockCacheKey key;
+  ObMicroBlockCacheKey freed_key;
+  make_key(12, 3, size, key);
+  make_key(13, 5, size, freed_key);
+  char *block = make_block(size, 'c');
+  char *freed_block = make_block(size, 'd');
+  // first boot on a new cache file
+  recover(0);
+  ASSERT_EQ(OB_SUCCESS, cache_.put(freed_key, des_meta_, freed_block));
+  ASSERT_EQ(OB_SUCCESS, cache_.put(key, des_meta_, block));
+  flush();
+  const int64_t write_lsn = cache_.write_lsn_;
+
+  // the block of write seq 5 is freed before restart, the write seq continues from 4 and the
+  // same macro block id may be used by a different block now
+  restart(4);
+  check_hit(key, block);
+  check_miss(freed_key);
+  ASSERT_EQ(1, cache_.index_.size());
+  ASSERT_EQ(write_lsn, cache_.write_lsn_);
+  ObMicroBlockDiskCacheSuperBlock super_block;
+  ASSERT_EQ(OB_SUCCESS, cache_.read_super_block(super_block));
+  ASSERT_FALSE(super_block.is_cleaning_);
+  ASSERT_EQ(4, super_block.max_valid_write_seq_);
+
+  // the dropped entry is zeroed on disk and never comes back with a larger restart write seq
+  restart(10);
+  check_hit(key, block);
+  check_miss(freed_key);
+
+  // new entries are appended after the recovered ones
+  ObMicroBlockCacheKey new_key;
+  make_key(14, 11, size, new_key);
+  ASSERT_EQ(OB_SUCCESS, cache_.put(new_key, des_meta_, freed_block));
+  flush();
+  check_hit(new_key, freed_block);
+  ASSERT_LT(write_lsn, cache_.write_lsn_);
+}
+
+TEST_F(TestMicroBlockDiskCache, restart_before_recovered)
+{
+  const int64_t size = 8000;
+  ObMicroBlockCacheKey key;
+  make_key(15, 5, size, key);
+  char *block = make_block(size, 'e');
+
+  // a new cache file trusts nothing in it
+  recover(100);
+  ASSERT_EQ(0, cache_.restart_write_seq_);
+  ASSERT_EQ(OB_SUCCESS, cache_.put(key, des_meta_, block));
+  flush();
+  check_hit(key, block);
+
+  // restart with write seq 4 but stop before recovery, the bound is kept in the super block
+  cache_.destroy();
+  ASSERT_EQ(OB_SUCCESS, cache_.init(TEST_DIR, ObMicroBlockDiskCache::MIN_CACHE_FILE_SIZE));
+  cache_.set_restart_write_seq(4);
+  ASSERT_EQ(4, cache_.restart_write_seq_);
+
+  restart(10);
+  ASSERT_EQ(4, cache_.restart_write_seq_);
+  check_miss(key);
+  ASSERT_EQ(0, cache_.index_.size());
+}
+
+TEST_F(TestMicroBlockDiskCache, evict)
+{
+  // one entry takes 1MB of the 64MB file
+  const int64_t size = (1L << 20) - ObMicroBlockDiskCache::ENTRY_ALIGN_SIZE;
+  const int64_t entry_cnt = ObMicroBlockDiskCache::MIN_CACHE_FILE_SIZE / (1L << 20);
+  const int64_t put_cnt = entry_cnt + entry_cnt / 2;
+  char *block = make_block(size, 'e');
+  ObMicroBlockCacheKey key;
+  for (int64_t i = 0; i < put_cnt; ++i) {
+    make_key(100 + i, 1, size, key);
+    fill_block(block, size, static_cast<char>(i));
+    ASSERT_EQ(OB_SUCCESS, cache_.put(key, des_meta_, block));
+    flush();
+  }
+  ASSERT_EQ(put_cnt * (1L << 20), cache_.write_lsn_);
+  ASSERT_EQ(entry_cnt, cache_.index_.size());
+  // the oldest entries are overwritten and evicted from the index
+  for (int64_t i = 0; i < put_cnt - entry_cnt; ++i) {
+    make_key(100 + i, 1, size, key);
+    check_miss(key);
+  }
+  for (int64_t i = put_cnt - entry_cnt; i < put_cnt; ++i) {
+    make_key(100 + i, 1, size, key);
+    fill_block(block, size, static_cast<char>(i));
+    check_hit(key, block);
+  }
+
+  // too large block is not cached
+  const int64_t large_size = ObMicroBlockDiskCache::MIN_CACHE_FILE_SIZE / 2;
+  char *large_block = make_block(large_size, 'f');
+  ASSERT_NE(nullptr, large_block);
+  make_key(1, 1, large_size, key);
+  ASSERT_EQ(OB_SUCCESS, cache_.put(key, des_meta_, large_block));
+  flush();
+  check_miss(key);
+}
+
+}//end namespace unittest
+}//end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_micro_block_disk_cache.log*");
+  OB_LOGGER.set_file_name("test_micro_block_disk_cache.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#define protected public
+#define private public
+
+#include "storage/blocksstable/ob_macro_block_writer.h"
+#include "storage/blocksstable/ob_micro_block_encode_pool.h"
+#include "storage/test_schema_prepare.h"
+#include "storage/blocksstable/ob_data_file_prepare.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace storage;
+using namespace blocksstable;
+
+namespace unittest
+{
+static ObSimpleMemLimitGetter getter;
+class TestMicroBlockEncodePipeline : public blocksstable::TestDataFilePrepare
+{
+public:
+  static const int64_t BLOCK_CNT = 500;
+  TestMicroBlockEncodePipeline()
+    : blocksstable::TestDataFilePrepare(&getter, "test_micro_block_encode_pipeline"),
+      mock_ls_id_(1),
+      mock_tablet_id_(1)
+  {}
+  virtual void SetUp()
+  {
+    TestDataFilePrepare::SetUp();
+    TestSchemaPrepare::prepare_schema(table_schema_, 1/*rowkey_cnt*/, 1/*column_cnt*/);
+    ASSERT_EQ(OB_SUCCESS, data_desc_.init(table_schema_, mock_ls_id_, mock_tablet_id_,
+                                          MAJOR_MERGE, 1/*snapshot*/, 1/*cluster_version*/));
+    ASSERT_EQ(OB_SUCCESS, encode_pool_.init());
+  }
+  virtual void TearDown()
+  {
+    encode_pool_.stop();
+    encode_pool_.wait();
+    encode_pool_.destroy();
+    TestDataFilePrepare::TearDown();
+  }
+  static int64_t get_row_cnt(const int64_t block_idx) { return block_idx % 7 + 1; }
+  static int64_t get_rowkey(const int64_t block_idx, const int64_t row_idx) { return block_idx * 100 + row_idx; }
+  // append the rows of the %block_idx-th micro block into the filling task and submit it
+  static void submit_block(const int64_t block_idx, ObDatumRow &row, ObMicroBlockEncodePipeline &pipeline)
+  {
+    ObMicroBlockEncodeTask &task = pipeline.get_filling_task();
+    ASSERT_EQ(ObMicroBlockEncodeTask::FILLING, task.state_);
+    for (int64_t i = 0; i < get_row_cnt(block_idx); ++i) {
+      row.storage_datums_[0].set_int(get_rowkey(block_idx, i));
+      row.storage_datums_[1].set_int(-1);
+      row.storage_datums_[2].set_int(0);
+      row.row_flag_.set_flag(ObDmlFlag::DF_INSERT);
+      ASSERT_EQ(OB_SUCCESS, task.micro_writer_->append_row(row));
+    }
+    ObDatumRowkey last_key;
+    ASSERT_EQ(OB_SUCCESS, last_key.assign(row.storage_datums_, 1));
+    ASSERT_EQ(OB_SUCCESS, task.save_block_info(last_key, nullptr));
+    ASSERT_EQ(OB_SUCCESS, pipeline.submit_filling_task());
+  }
+  // write the encoded blocks like ObMacroBlockWriter::write_encoded_micro_blocks
+  static void write_blocks(const bool wait_all, ObMicroBlockEncodePipeline &pipeline, int64_t &write_idx)
+  {
+    bool need_write = true;
+    while (need_write && pipeline.has_pending_task()) {
+      ObMicroBlockEncodeTask *task = nullptr;
+      ASSERT_EQ(OB_SUCCESS, pipeline.get_encoded_task(wait_all || pipeline.is_full(), task));
+      if (nullptr == task) {
+        need_write = false;
+      } else {
+        ASSERT_EQ(OB_SUCCESS, task->ret_);
+        ASSERT_EQ(get_row_cnt(write_idx), task->micro_block_desc_.row_count_);
+        ASSERT_EQ(get_rowkey(write_idx, get_row_cnt(write_idx) - 1),
+                  task->micro_block_desc_.last_rowkey_.datums_[0].get_int());
+        ASSERT_EQ(OB_SUCCESS, pipeline.release_encoded_task());
+        ++write_idx;
+      }
+    }
+  }
+  void write_all_blocks(ObTenantBase *tenant_base, const int64_t task_cnt)
+  {
+    ObTenantEnv::set_tenant(tenant_base);
+    ObArenaAllocator allocator(ObModIds::TEST);
+    ObMicroBlockEncodePipeline pipeline(allocator);
+    ObDatumRow row;
+    int64_t write_idx = 0;
+    ASSERT_EQ(OB_SUCCESS, row.init(allocator, data_desc_.get_desc().get_row_column_count()));
+    ASSERT_EQ(OB_SUCCESS, pipeline.init(data_desc_.get_desc(), encode_pool_, task_cnt));
+    for (int64_t i = 0; i < BLOCK_CNT; ++i) {
+      submit_block(i, row, pipeline);
+      write_blocks(false/*wait_all*/, pipeline, write_idx);
+    }
+    write_blocks(true/*wait_all*/, pipeline, write_idx);
+    ASSERT_EQ(BLOCK_CNT, write_idx);
+    ASSERT_FALSE(pipeline.has_pending_task());
+  }
+protected:
+  share::ObLSID mock_ls_id_;
+  ObTabletID mock_tablet_id_;
+  ObTableSchema table_schema_;
+  ObWholeDataStoreDesc data_desc_;
+  ObTenantMicroBlockEncodePool encode_pool_;
+};
+
+// the micro blocks of each writer are written in submit order while encoded by the shared threads
+TEST_F(TestMicroBlockEncodePipeline, concurrent_order)
+{
+  ASSERT_EQ(OB_SUCCESS, encode_pool_.adjust_thread_cnt(4));
+  ASSERT_EQ(4, encode_pool_.get_thread_cnt());
+  ObTenantBase *tenant_base = MTL_CTX();
+  std::thread writers[4];
+  for (int64_t i = 0; i < 4; ++i) {
+    writers[i] = std::thread([&, i]() { write_all_blocks(tenant_base, i + 2); });
+  }
+  for (int64_t i = 0; i < 4; ++i) {
+    writers[i].join();
+  }
+
+  // the threads are resized by the parameter
+  ASSERT_EQ(OB_SUCCESS, encode_pool_.adjust_thread_cnt(2));
+  ASSERT_EQ(2, encode_pool_.get_thread_cnt());
+  ASSERT_EQ(OB_SUCCESS, encode_pool_.adjust_thread_cnt(ObTenantMicroBlockEncodePool::MAX_THREAD_CNT + 1));
+  ASSERT_EQ(ObTenantMicroBlockEncodePool::MAX_THREAD_CNT, encode_pool_.get_thread_cnt());
+  write_all_blocks(tenant_base, 3);
+}
+
+// the tasks failed to push are encoded by the merge thread
+TEST_F(TestMicroBlockEncodePipeline, no_thread)
+{
+  ObMicroBlockEncodeTask task;
+  ASSERT_EQ(OB_IN_STOP_STATE, encode_pool_.push_task(task));
+  write_all_blocks(MTL_CTX(), 2);
+
+  ASSERT_EQ(OB_SUCCESS, encode_pool_.adjust_thread_cnt(2));
+  encode_pool_.stop();
+  encode_pool_.wait();
+  ASSERT_TRUE(encode_pool_.is_stopped());
+  ASSERT_EQ(0, encode_pool_.get_thread_cnt());
+  ASSERT_EQ(OB_IN_STOP_STATE, encode_pool_.push_task(task));
+  ASSERT_EQ(OB_SUCCESS, encode_pool_.adjust_thread_cnt(4));
+  ASSERT_EQ(0, encode_pool_.get_thread_cnt());
+  write_all_blocks(MTL_CTX(), 3);
+}
+
+// the pipeline is freed only after the queued tasks are skipped by the threads
+TEST_F(TestMicroBlockEncodePipeline, destroy_with_pending_tasks)
+{
+  ASSERT_EQ(OB_SUCCESS, encode_pool_.adjust_thread_cnt(1));
+  ObArenaAllocator allocator(ObModIds::TEST);
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator, data_desc_.get_desc().get_row_column_count()));
+  for (int64_t round = 0; round < 100; ++round) {
+    ObMicroBlockEncodePipeline pipeline(allocator);
+    ASSERT_EQ(OB_SUCCESS, pipeline.init(data_desc_.get_desc(), encode_pool_, 4));
+    for (int64_t i = 0; i < 3; ++i) {
+      submit_block(i, row, pipeline);
+    }
+    pipeline.destroy();
+    ASSERT_EQ(0, pipeline.queued_cnt_);
+  }
+}
+
+}//end namespace unittest
+}//end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_micro_block_encode_pipeline.log*");
+  OB_LOGGER.set_file_name("test_micro_block_encode_pipeline.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -33,6 +33,8 @@
 #include "mtlenv/mock_tenant_module_env.h"
 #include "storage/blocksstable/index_block/ob_agg_row_struct.h"
 #include "storage/blocksstable/index_block/ob_skip_index_filter_executor.h"
+#include "storage/blocksstable/index_block/ob_index_block_aggregator.h"
+#include "storage/blocksstable/index_block/ob_skip_index_bloom_filter.h"
 #include "sql/engine/basic/ob_pushdown_filter.h"
 #include "ob_row_generate.h"
 
@@ -74,6 +76,12 @@ public:
     ObObj &max_obj,
     ObObj &null_count_obj,
     ObBoolMask &fal_desc);
+
+  int test_bloom_filter_pushdown(const uint64_t col_idx,
+    sql::ObPushdownWhiteFilterNode &filter_node,
+    common::ObFixedArray<ObObj, ObIAllocator> &filter_objs,
+    common::ObIArray<ObObj> &data_objs,
+    ObBoolMask &fal_desc);
 protected:
   ObRowGenerate row_generate_;
   common::ObArray<share::schema::ObColDesc> col_descs_;
@@ -294,6 +302,114 @@ int TestSkipIndexFilter::test_skip_index_filter_pushdown (
   return ret;
 }
 
+int TestSkipIndexFilter::test_bloom_filter_pushdown(
+    const uint64_t col_idx,
+    sql::ObPushdownWhiteFilterNode &filter_node,
+    common::ObFixedArray<ObObj, ObIAllocator> &filter_objs,
+    common::ObIArray<ObObj> &data_objs,
+    ObBoolMask &fal_desc)
+{
+  int ret = OB_SUCCESS;
+  // build bloom filter from data
+  ObColDesc col_desc;
+  col_desc.col_type_ = row_generate_.column_list_.at(col_idx).col_type_;
+  ObStorageDatum bloom_result;
+  ObColBloomFilterAggregator bloom_agg;
+  const ObStorageDatum *result = nullptr;
+  if (OB_FAIL(bloom_agg.init(col_desc, bloom_result))) {
+    STORAGE_LOG(WARN, "failed to init bloom filter aggregator", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < data_objs.count(); ++i) {
+    ObStorageDatum datum;
+    datum.from_obj_enhance(data_objs.at(i));
+    if (OB_FAIL(bloom_agg.eval(datum, true))) {
+      STORAGE_LOG(WARN, "failed to eval bloom filter", K(ret), K(datum));
+    }
+  }
+  if (OB_SUCC(ret) && OB_FAIL(bloom_agg.get_result(result))) {
+    STORAGE_LOG(WARN, "failed to get bloom filter", K(ret));
+  }
+
+  // genereate filter, args_[0] is the column reference
+  sql::ObExecContext exec_ctx(allocator_);
+  sql::ObEvalCtx eval_ctx(exec_ctx);
+  sql::ObPushdownExprSpec expr_spec(allocator_);
+  sql::ObPushdownOperator op(eval_ctx, expr_spec);
+  sql::ObWhiteFilterExecutor filter(allocator_, filter_node, op);
+  const int64_t count = filter_objs.count();
+  void *expr_buf1 = allocator_.alloc(sizeof(sql::ObExpr));
+  void *expr_buf2 = allocator_.alloc(sizeof(sql::ObExpr*) * (count + 1));
+  void *expr_buf3 = allocator_.alloc(sizeof(sql::ObExpr) * (count + 1));
+  void *datum_buf = allocator_.alloc(sizeof(int8_t) * 128 * count);
+  ObDatum datums[count];
+  if (OB_SUCC(ret)) {
+    filter.filter_.expr_ = new (expr_buf1) sql::ObExpr();
+    filter.filter_.expr_->arg_cnt_ = count + 1;
+    filter.filter_.expr_->args_ = reinterpret_cast<sql::ObExpr **>(expr_buf2);
+    filter.datum_params_.init(count);
+    for (int64_t i = 0; i <= count; ++i) {
+      filter.filter_.expr_->args_[i] = new (reinterpret_cast<sql::ObExpr *>(expr_buf3) + i) sql::ObExpr();
+    }
+    filter.filter_.expr_->args_[0]->type_ = T_REF_COLUMN;
+    filter.filter_.expr_->args_[0]->obj_meta_ = col_desc.col_type_;
+    for (int64_t i = 0; i < count; ++i) {
+      sql::ObExpr *arg = filter.filter_.expr_->args_[i + 1];
+      arg->type_ = T_QUESTIONMARK;
+      arg->obj_meta_ = filter_objs.at(i).get_meta();
+      arg->datum_meta_.type_ = filter_objs.at(i).get_meta().get_type();
+      datums[i].ptr_ = reinterpret_cast<char *>(datum_buf) + i * 128;
+      datums[i].from_obj(filter_objs.at(i));
+      filter.datum_params_.push_back(datums[i]);
+    }
+    filter.check_null_params();
+  }
+
+  // write bloom filter to agg row
+  ObArray<ObSkipIndexColMeta> agg_cols;
+  ObDatumRow agg_row;
+  char *buf = nullptr;
+  int64_t buf_size = 0;
+  ObAggRowWriter row_writer;
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(agg_row.init(1))) {
+    STORAGE_LOG(WARN, "failed to init agg row", K(ret));
+  } else if (OB_FAIL(agg_cols.push_back(ObSkipIndexColMeta(col_idx, SK_IDX_BLOOM_FILTER)))) {
+    STORAGE_LOG(WARN, "failed to push back agg col", K(ret));
+  } else if (FALSE_IT(agg_row.storage_datums_[0].set_string(result->ptr_, result->len_))) {
+  } else if (OB_FAIL(row_writer.init(agg_cols, agg_row, allocator_))) {
+    STORAGE_LOG(WARN, "failed to init agg row writer", K(ret));
+  } else if (FALSE_IT(buf_size = row_writer.get_data_size())) {
+  } else if (OB_ISNULL(buf = reinterpret_cast<char *>(allocator_.alloc(buf_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else {
+    int64_t pos = 0;
+    MEMSET(buf, 0, buf_size);
+    if (OB_FAIL(row_writer.write_agg_data(buf, buf_size, pos))) {
+      STORAGE_LOG(WARN, "failed to write agg row", K(ret));
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    ObMicroIndexInfo index_info;
+    ObIndexBlockRowHeader row_header;
+    ObSkipIndexFilterExecutor skip_index_filter;
+    row_header.row_count_ = row_count_;
+    index_info.agg_row_buf_ = buf;
+    index_info.agg_buf_size_ = buf_size;
+    index_info.row_header_ = &row_header;
+    ret = skip_index_filter.falsifiable_pushdown_filter(col_idx, ObSkipIndexType::BLOOM_FILTER, index_info, filter, allocator_);
+    fal_desc = filter.get_filter_bool_mask();
+  }
+
+  allocator_.free(expr_buf1);
+  allocator_.free(expr_buf2);
+  allocator_.free(expr_buf3);
+  allocator_.free(datum_buf);
+  if (nullptr != buf) {
+    allocator_.free(buf);
+  }
+  return ret;
+}
 
 TEST_F(TestSkipIndexFilter, test_eq)
 {
@@ -1313,6 +1429,196 @@ TEST_F(TestSkipIndexFilter, test_has_null)
   }
 }
 
+TEST_F(TestSkipIndexFilter, test_bloom_filter)
+{
+  sql::ObPushdownWhiteFilterNode white_filter(allocator_);
+  white_filter.op_type_ = sql::WHITE_OP_EQ;
+
+  int64_t seed0 = 0x0;
+  int64_t seed1 = 0x1;
+  int64_t seed2 = 0x2;
+  ObBoolMask fal_desc;
+
+  for (int64_t i = 0; i < full_column_cnt_ -1; ++i) {
+    if (i >= ROWKEY_CNT && i < read_info_.get_rowkey_count()) {
+      continue;
+    }
+    const ObObjType column_type = row_generate_.column_list_.at(i).col_type_.get_type();
+    if (is_lob_storage(column_type) || ob_is_decimal_int(column_type)) {
+      continue;
+    }
+    ObMalloc mallocer;
+    mallocer.set_label("SkipIndexFilter");
+    ObFixedArray<ObObj, ObIAllocator> filter_objs(mallocer, 1);
+    filter_objs.init(1);
+    ObObj ref_obj;
+    setup_obj(ref_obj, i, seed1);
+    filter_objs.push_back(ref_obj);
+
+    ObArray<ObObj> data_objs;
+    ObObj data_obj;
+    setup_obj(data_obj, i, seed0);
+    OK(data_objs.push_back(data_obj));
+    setup_obj(data_obj, i, seed2);
+    OK(data_objs.push_back(data_obj));
+
+    // a. cell not in block, expect always false
+    ASSERT_EQ(OB_SUCCESS, test_bloom_filter_pushdown(i, white_filter, filter_objs, data_objs, fal_desc));
+    ASSERT_TRUE(fal_desc.is_always_false());
+
+    // b. cell in block, expect uncertain
+    setup_obj(filter_objs.at(0), i, seed2);
+    ASSERT_EQ(OB_SUCCESS, test_bloom_filter_pushdown(i, white_filter, filter_objs, data_objs, fal_desc));
+    ASSERT_TRUE(fal_desc.is_uncertain());
+
+    // c. all values in block are null, expect always false
+    data_objs.reuse();
+    data_obj.set_null();
+    OK(data_objs.push_back(data_obj));
+    ASSERT_EQ(OB_SUCCESS, test_bloom_filter_pushdown(i, white_filter, filter_objs, data_objs, fal_desc));
+    ASSERT_TRUE(fal_desc.is_always_false());
+
+    // d. ref obj is null, expect always false
+    filter_objs.at(0).set_null();
+    setup_obj(data_obj, i, seed0);
+    OK(data_objs.push_back(data_obj));
+    ASSERT_EQ(OB_SUCCESS, test_bloom_filter_pushdown(i, white_filter, filter_objs, data_objs, fal_desc));
+    ASSERT_TRUE(fal_desc.is_always_false());
+  }
+
+  // e. not equal filter can not be falsified by bloom filter
+  white_filter.op_type_ = sql::WHITE_OP_NE;
+  ObMalloc mallocer;
+  mallocer.set_label("SkipIndexFilter");
+  ObFixedArray<ObObj, ObIAllocator> filter_objs(mallocer, 1);
+  filter_objs.init(1);
+  ObObj ref_obj;
+  setup_obj(ref_obj, ROWKEY_CNT + 1, seed1);
+  filter_objs.push_back(ref_obj);
+  ObArray<ObObj> data_objs;
+  ObObj data_obj;
+  setup_obj(data_obj, ROWKEY_CNT + 1, seed0);
+  OK(data_objs.push_back(data_obj));
+  ASSERT_EQ(OB_SUCCESS, test_bloom_filter_pushdown(ROWKEY_CNT + 1, white_filter, filter_objs, data_objs, fal_desc));
+  ASSERT_TRUE(fal_desc.is_uncertain());
+}
+
+TEST_F(TestSkipIndexFilter, test_ngram_bloom_filter)
+{
+  const int64_t size = ObSkipIndexBloomFilter::MAX_FILTER_SIZE;
+  char micro_bits[2][size];
+  MEMSET(micro_bits, 0, sizeof(micro_bits));
+  ObSkipIndexBloomFilter::add_ngrams(CS_TYPE_UTF8MB4_GENERAL_CI, ObString("hello world"), micro_bits[0], size);
+  ObSkipIndexBloomFilter::add_ngrams(CS_TYPE_UTF8MB4_GENERAL_CI, ObString("trace_id=abc123"), micro_bits[1], size);
+  ASSERT_FALSE(ObSkipIndexBloomFilter::is_saturated(micro_bits[0], size));
+
+  // merge filters of micro blocks like index level aggregation
+  char bits[size];
+  MEMSET(bits, 0, size);
+  ObSkipIndexBloomFilter::merge(micro_bits[0], size, bits, size);
+  ObSkipIndexBloomFilter::merge(micro_bits[1], size, bits, size);
+
+  const ObString escape("\\");
+  bool may_match = false;
+  OK(ObSkipIndexBloomFilter::may_match_like_pattern(CS_TYPE_UTF8MB4_GENERAL_CI, ObString("%world%"), escape, bits, size, may_match));
+  ASSERT_TRUE(may_match);
+  OK(ObSkipIndexBloomFilter::may_match_like_pattern(CS_TYPE_UTF8MB4_GENERAL_CI, ObString("%WORLD%"), escape, bits, size, may_match));
+  ASSERT_TRUE(may_match);
+  OK(ObSkipIndexBloomFilter::may_match_like_pattern(CS_TYPE_UTF8MB4_GENERAL_CI, ObString("h_llo%"), escape, bits, size, may_match));
+  ASSERT_TRUE(may_match);
+  OK(ObSkipIndexBloomFilter::may_match_like_pattern(CS_TYPE_UTF8MB4_GENERAL_CI, ObString("trace\\_id%"), escape, bits, size, may_match));
+  ASSERT_TRUE(may_match);
+  OK(ObSkipIndexBloomFilter::may_match_like_pattern(CS_TYPE_UTF8MB4_GENERAL_CI, ObString("%abc123"), escape, bits, size, may_match));
+  ASSERT_TRUE(may_match);
+  // literal parts shorter than ngram can not be checked
+  OK(ObSkipIndexBloomFilter::may_match_like_pattern(CS_TYPE_UTF8MB4_GENERAL_CI, ObString("%xy%z_"), escape, bits, size, may_match));
+  ASSERT_TRUE(may_match);
+  OK(ObSkipIndexBloomFilter::may_match_like_pattern(CS_TYPE_UTF8MB4_GENERAL_CI, ObString("%xyz%"), escape, bits, size, may_match));
+  ASSERT_FALSE(may_match);
+  OK(ObSkipIndexBloomFilter::may_match_like_pattern(CS_TYPE_UTF8MB4_GENERAL_CI, ObString("%world_abc%"), escape, bits, size, may_match));
+  ASSERT_TRUE(may_match);
+  OK(ObSkipIndexBloomFilter::may_match_like_pattern(CS_TYPE_UTF8MB4_GENERAL_CI, ObString("%worldabc%"), escape, bits, size, may_match));
+  ASSERT_FALSE(may_match);
+  // unsupported collation is never pruned
+  OK(ObSkipIndexBloomFilter::may_match_like_pattern(CS_TYPE_UTF8MB4_UNICODE_CI, ObString("%xyz%"), escape, bits, size, may_match));
+  ASSERT_TRUE(may_match);
+
+  // case sensitive collation
+  MEMSET(bits, 0, size);
+  ObSkipIndexBloomFilter::add_ngrams(CS_TYPE_UTF8MB4_BIN, ObString("hello world"), bits, size);
+  OK(ObSkipIndexBloomFilter::may_match_like_pattern(CS_TYPE_UTF8MB4_BIN, ObString("%world%"), escape, bits, size, may_match));
+  ASSERT_TRUE(may_match);
+  OK(ObSkipIndexBloomFilter::may_match_like_pattern(CS_TYPE_UTF8MB4_BIN, ObString("%WORLD%"), escape, bits, size, may_match));
+  ASSERT_FALSE(may_match);
+
+  // saturated filter
+  char str[16];
+  for (int64_t i = 0; i < 10000; ++i) {
+    const int64_t len = snprintf(str, sizeof(str), "%ld", i * 7919);
+    ObSkipIndexBloomFilter::add_ngrams(CS_TYPE_UTF8MB4_BIN, ObString(len, str), bits, size);
+  }
+  ASSERT_TRUE(ObSkipIndexBloomFilter::is_saturated(bits, size));
+}
+
+TEST_F(TestSkipIndexFilter, test_bloom_filter_size)
+{
+  ObColDesc col_desc;
+  col_desc.col_type_.set_int();
+  const sql::ObExprHashFuncType hash_func = ObDatumFuncs::get_basic_func(ObIntType, CS_TYPE_BINARY)->murmur_hash_;
+  ObStorageDatum datum;
+  uint64_t hash = 0;
+  const ObStorageDatum *result = nullptr;
+
+  // the filter of a block with few distinct values is folded to the min size
+  ObStorageDatum small_result;
+  ObColBloomFilterAggregator small_agg;
+  OK(small_agg.init(col_desc, small_result));
+  for (int64_t i = 0; i < 1000; ++i) {
+    datum.set_int(i % 10);
+    OK(small_agg.eval(datum, true));
+  }
+  OK(small_agg.get_result(result));
+  ASSERT_EQ(ObSkipIndexBloomFilter::MIN_FILTER_SIZE, result->len_);
+
+  // thousands of distinct values still get a filter without false negatives
+  ObStorageDatum large_result;
+  ObColBloomFilterAggregator large_agg;
+  OK(large_agg.init(col_desc, large_result));
+  for (int64_t i = 0; i < 3000; ++i) {
+    datum.set_int(i * 7919);
+    OK(large_agg.eval(datum, true));
+  }
+  OK(large_agg.get_result(result));
+  ASSERT_TRUE(ObSkipIndexBloomFilter::is_valid_size(result->len_));
+  ASSERT_GT(result->len_, ObSkipIndexBloomFilter::MIN_FILTER_SIZE);
+  int64_t false_positive_cnt = 0;
+  for (int64_t i = 0; i < 3000; ++i) {
+    datum.set_int(i * 7919);
+    OK(hash_func(datum, ObSkipIndexBloomFilter::HASH_SEED, hash));
+    ASSERT_TRUE(ObSkipIndexBloomFilter::may_contain(hash, result->ptr_, result->len_));
+    datum.set_int(i * 7919 + 1);
+    OK(hash_func(datum, ObSkipIndexBloomFilter::HASH_SEED, hash));
+    false_positive_cnt += ObSkipIndexBloomFilter::may_contain(hash, result->ptr_, result->len_) ? 1 : 0;
+  }
+  ASSERT_LT(false_positive_cnt, 3000 / 10);
+
+  // filters of different sizes are merged at index level
+  ObStorageDatum index_result;
+  ObColBloomFilterAggregator index_agg;
+  OK(index_agg.init(col_desc, index_result));
+  OK(index_agg.eval(small_result, false));
+  OK(index_agg.eval(large_result, false));
+  OK(index_agg.get_result(result));
+  ASSERT_TRUE(ObSkipIndexBloomFilter::is_valid_size(result->len_));
+  for (int64_t i = 0; i < 3000; ++i) {
+    datum.set_int(i * 7919);
+    OK(hash_func(datum, ObSkipIndexBloomFilter::HASH_SEED, hash));
+    ASSERT_TRUE(ObSkipIndexBloomFilter::may_contain(hash, result->ptr_, result->len_));
+    datum.set_int(i % 10);
+    OK(hash_func(datum, ObSkipIndexBloomFilter::HASH_SEED, hash));
+    ASSERT_TRUE(ObSkipIndexBloomFilter::may_contain(hash, result->ptr_, result->len_));
+  }
+}
 
 }//end namespace unittest
 }//end namespace oceanbase
@@ -604,6 +604,76 @@ TEST_F(TestSSTableMeta, test_sstable_deep_copy)
   ASSERT_EQ(full_sstable.meta_->is_inited_, tiny_sstable->meta_->is_inited_);
 }
 
+TEST_F(TestSSTableMeta, test_rowkey_bloom_filter)
+{
+  const int64_t row_count = 10000;
+  ObArray<uint64_t> hashes;
+  for (int64_t i = 0; i < row_count * 2; ++i) {
+    ASSERT_EQ(OB_SUCCESS, hashes.push_back(murmurhash(&i, sizeof(i), 0)));
+  }
+  ASSERT_EQ(OB_SUCCESS, ObRowkeyBloomFilter::prepare(row_count, param_.rowkey_bloom_filter_));
+  for (int64_t i = 0; i < row_count; ++i) {
+    ObRowkeyBloomFilter::add(hashes.at(i), param_.rowkey_bloom_filter_);
+  }
+
+  ObSSTableMeta sstable_meta;
+  ASSERT_EQ(OB_SUCCESS, sstable_meta.init(param_, allocator_));
+  ASSERT_TRUE(sstable_meta.get_rowkey_bloom_filter().is_valid());
+
+  int64_t pos = 0;
+  const int64_t buf_len = sstable_meta.get_serialize_size();
+  char *buf = static_cast<char *>(allocator_.alloc(buf_len));
+  ASSERT_TRUE(nullptr != buf);
+  ASSERT_EQ(OB_SUCCESS, sstable_meta.serialize(buf, buf_len, pos));
+  ObSSTableMeta tmp_meta;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, tmp_meta.deserialize(allocator_, buf, buf_len, pos));
+  ASSERT_EQ(buf_len, pos);
+
+  const int64_t copy_len = tmp_meta.get_deep_copy_size();
+  char *copy_buf = static_cast<char *>(allocator_.alloc(copy_len));
+  ASSERT_TRUE(nullptr != copy_buf);
+  ObSSTableMeta *copy_meta = nullptr;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, tmp_meta.deep_copy(copy_buf, copy_len, pos, copy_meta));
+  ASSERT_EQ(copy_len, pos);
+
+  // no false negative, and false positive rate of 12 bits per key is about 1%
+  const ObRowkeyBloomFilter &bf = copy_meta->get_rowkey_bloom_filter();
+  ASSERT_TRUE(bf.is_valid());
+  int64_t false_positive_cnt = 0;
+  bool results[ObRowkeyBloomFilter::BATCH_SIZE];
+  for (int64_t i = 0; i < hashes.count(); i += ObRowkeyBloomFilter::BATCH_SIZE) {
+    const int64_t cnt = MIN(ObRowkeyBloomFilter::BATCH_SIZE, hashes.count() - i);
+    bf.batch_may_contain(&hashes.at(i), cnt, results);
+    for (int64_t j = 0; j < cnt; ++j) {
+      ASSERT_EQ(bf.may_contain(hashes.at(i + j)), results[j]);
+      if (i + j < row_count) {
+        ASSERT_TRUE(results[j]);
+      } else if (results[j]) {
+        ++false_positive_cnt;
+      }
+    }
+  }
+  ASSERT_LT(false_positive_cnt, row_count / 20);
+
+  // sstable meta without rowkey bloom filter keeps the old format
+  param_.rowkey_bloom_filter_.reset();
+  ObSSTableMeta meta_without_bf;
+  ASSERT_EQ(OB_SUCCESS, meta_without_bf.init(param_, allocator_));
+  ASSERT_FALSE(meta_without_bf.get_rowkey_bloom_filter().is_valid());
+  pos = 0;
+  const int64_t old_buf_len = meta_without_bf.get_serialize_size();
+  char *old_buf = static_cast<char *>(allocator_.alloc(old_buf_len));
+  ASSERT_TRUE(nullptr != old_buf);
+  ASSERT_EQ(OB_SUCCESS, meta_without_bf.serialize(old_buf, old_buf_len, pos));
+  ObSSTableMeta old_meta;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, old_meta.deserialize(allocator_, old_buf, old_buf_len, pos));
+  ASSERT_EQ(old_buf_len, pos);
+  ASSERT_FALSE(old_meta.get_rowkey_bloom_filter().is_valid());
+}
+
 TEST_F(TestMigrationSSTableParam, test_empty_sstable_serialize_and_deserialize)
 {
   ObMigrationSSTableParam mig_param;
@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "storage/compaction/ob_i_compaction_filter.h"
+#include "storage/ob_storage_schema.h"
+#include "storage/blocksstable/ob_datum_row.h"
+#include "storage/blocksstable/index_block/ob_agg_row_struct.h"
+#include "storage/blocksstable/index_block/ob_index_block_macro_iterator.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace compaction;
+using namespace storage;
+using namespace blocksstable;
+using namespace share::schema;
+
+namespace unittest
+{
+
+// multi version row: c16(rowkey) | trans version | sql sequence | c17(timestamp) | c18(datetime)
+class TestRowTTLFilter : public ::testing::Test
+{
+public:
+  static const int64_t COLUMN_CNT = 5;
+  static const int64_t TS_COL_IDX = 3;
+  static const int64_t DATETIME_COL_IDX = 4;
+  static const int64_t HOUR_US = 3600L * 1000L * 1000L;
+  static const int64_t FILTER_TS = 1700000000L * 1000L * 1000L;
+  TestRowTTLFilter() : allocator_(ObModIds::TEST) {}
+  virtual void SetUp()
+  {
+    const uint64_t col_ids[COLUMN_CNT] = {OB_APP_MIN_COLUMN_ID, OB_HIDDEN_TRANS_VERSION_COLUMN_ID,
+        OB_HIDDEN_SQL_SEQUENCE_COLUMN_ID, OB_APP_MIN_COLUMN_ID + 1, OB_APP_MIN_COLUMN_ID + 2};
+    for (int64_t i = 0; i < COLUMN_CNT; ++i) {
+      ObColDesc col_desc;
+      col_desc.col_id_ = col_ids[i];
+      col_desc.col_type_.set_int();
+      ASSERT_EQ(OB_SUCCESS, col_descs_.push_back(col_desc));
+      ObSkipIndexColumnAttr skip_idx_attr;
+      if (TS_COL_IDX == i) {
+        skip_idx_attr.set_min_max();
+      }
+      ASSERT_EQ(OB_SUCCESS, skip_idx_attrs_.push_back(skip_idx_attr));
+    }
+    ASSERT_EQ(OB_SUCCESS, row_.init(allocator_, COLUMN_CNT));
+  }
+  void add_ttl_column(const int64_t col_idx, const int64_t nsecond, const int64_t nmonth)
+  {
+    ObStorageTTLColumnSchema ttl_column;
+    ttl_column.column_id_ = col_descs_.at(col_idx).col_id_;
+    ttl_column.nsecond_ = nsecond;
+    ttl_column.nmonth_ = nmonth;
+    ttl_column.is_datetime_ = DATETIME_COL_IDX == col_idx;
+    ASSERT_EQ(OB_SUCCESS, ttl_columns_.push_back(ttl_column));
+  }
+  // values of the ttl columns, null if negative
+  void check_row(ObRowTTLFilter &filter, const int64_t ts, const int64_t datetime,
+                 const ObICompactionFilter::ObFilterRet expected)
+  {
+    ObICompactionFilter::ObFilterRet filter_ret = ObICompactionFilter::FILTER_RET_MAX;
+    row_.storage_datums_[0].set_int(1);
+    row_.storage_datums_[1].set_int(-10);
+    row_.storage_datums_[2].set_int(0);
+    if (ts < 0) {
+      row_.storage_datums_[TS_COL_IDX].set_null();
+    } else {
+      row_.storage_datums_[TS_COL_IDX].set_timestamp(ts);
+    }
+    if (datetime < 0) {
+      row_.storage_datums_[DATETIME_COL_IDX].set_null();
+    } else {
+      row_.storage_datums_[DATETIME_COL_IDX].set_datetime(datetime);
+    }
+    ASSERT_EQ(OB_SUCCESS, filter.filter(row_, filter_ret));
+    ASSERT_EQ(expected, filter_ret);
+  }
+  // macro block with %min as the aggregated min value of the timestamp column
+  void check_macro_block(ObRowTTLFilter &filter, const int64_t min, const bool expected)
+  {
+    ObSEArray<ObSkipIndexColMeta, 3> agg_cols;
+    ObDatumRow agg_row;
+    ASSERT_EQ(OB_SUCCESS, agg_cols.push_back(ObSkipIndexColMeta(TS_COL_IDX, SK_IDX_MIN)));
+    ASSERT_EQ(OB_SUCCESS, agg_cols.push_back(ObSkipIndexColMeta(TS_COL_IDX, SK_IDX_MAX)));
+    ASSERT_EQ(OB_SUCCESS, agg_cols.push_back(ObSkipIndexColMeta(TS_COL_IDX, SK_IDX_NULL_COUNT)));
+    ASSERT_EQ(OB_SUCCESS, agg_row.init(allocator_, agg_cols.count()));
+    if (min < 0) {
+      agg_row.storage_datums_[0].set_null();
+      agg_row.storage_datums_[1].set_null();
+    } else {
+      agg_row.storage_datums_[0].set_timestamp(min);
+      agg_row.storage_datums_[1].set_timestamp(min + HOUR_US);
+    }
+    agg_row.storage_datums_[2].set_int(1);
+    ObAggRowWriter agg_row_writer;
+    ASSERT_EQ(OB_SUCCESS, agg_row_writer.init(agg_cols, agg_row, allocator_));
+    const int64_t buf_size = agg_row_writer.get_data_size();
+    char *buf = static_cast<char *>(allocator_.alloc(buf_size));
+    int64_t pos = 0;
+    ASSERT_NE(nullptr, buf);
+    MEMSET(buf, 0, buf_size);
+    ASSERT_EQ(OB_SUCCESS, agg_row_writer.write_agg_data(buf, buf_size, pos));
+
+    ObDataMacroBlockMeta macro_meta;
+    macro_meta.val_.column_count_ = COLUMN_CNT;
+    macro_meta.val_.compressor_type_ = ObCompressorType::NONE_COMPRESSOR;
+    macro_meta.val_.row_store_type_ = ObRowStoreType::FLAT_ROW_STORE;
+    macro_meta.val_.logic_id_ = ObLogicMacroBlockId(0, 1, 1);
+    macro_meta.val_.macro_id_.set_block_index(100);
+    macro_meta.val_.macro_id_.set_write_seq(1);
+    macro_meta.val_.agg_row_buf_ = buf;
+    macro_meta.val_.agg_row_len_ = pos;
+    ASSERT_EQ(OB_SUCCESS, macro_meta.end_key_.assign(row_.storage_datums_, 1));
+    ObMacroBlockDesc macro_desc;
+    macro_desc.macro_meta_ = &macro_meta;
+    ASSERT_TRUE(macro_desc.is_valid_with_macro_meta());
+    bool need_filter = !expected;
+    ASSERT_EQ(OB_SUCCESS, filter.check_filter_macro_block(macro_desc, need_filter));
+    ASSERT_EQ(expected, need_filter);
+
+    // not pre aggregated
+    macro_meta.val_.agg_row_buf_ = nullptr;
+    macro_meta.val_.agg_row_len_ = 0;
+    ASSERT_EQ(OB_SUCCESS, filter.check_filter_macro_block(macro_desc, need_filter));
+    ASSERT_FALSE(need_filter);
+  }
+protected:
+  ObArenaAllocator allocator_;
+  ObSEArray<ObColDesc, COLUMN_CNT> col_descs_;
+  ObSEArray<ObSkipIndexColumnAttr, COLUMN_CNT> skip_idx_attrs_;
+  ObSEArray<ObStorageTTLColumnSchema, 2> ttl_columns_;
+  ObDatumRow row_;
+};
+
+TEST_F(TestRowTTLFilter, init)
+{
+  ObRowTTLFilter filter;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, filter.init(FILTER_TS, ttl_columns_, col_descs_, skip_idx_attrs_));
+
+  ObStorageTTLColumnSchema not_stored_column;
+  not_stored_column.column_id_ = OB_APP_MIN_COLUMN_ID + 10;
+  ASSERT_EQ(OB_SUCCESS, ttl_columns_.push_back(not_stored_column));
+  ASSERT_EQ(OB_ERR_UNEXPECTED, filter.init(FILTER_TS, ttl_columns_, col_descs_, skip_idx_attrs_));
+  ASSERT_FALSE(filter.is_inited_);
+
+  ttl_columns_.reset();
+  add_ttl_column(TS_COL_IDX, 3600, 0);
+  add_ttl_column(DATETIME_COL_IDX, 0, 1);
+  ASSERT_EQ(OB_SUCCESS, filter.init(FILTER_TS, ttl_columns_, col_descs_, skip_idx_attrs_));
+  ASSERT_EQ(OB_INIT_TWICE, filter.init(FILTER_TS, ttl_columns_, col_descs_, skip_idx_attrs_));
+  ASSERT_EQ(2, filter.ttl_columns_.count());
+  ASSERT_EQ(TS_COL_IDX, filter.ttl_columns_.at(0).col_idx_);
+  ASSERT_TRUE(filter.ttl_columns_.at(0).has_min_max_);
+  ASSERT_FALSE(filter.ttl_columns_.at(0).is_datetime_);
+  ASSERT_EQ(DATETIME_COL_IDX, filter.ttl_columns_.at(1).col_idx_);
+  ASSERT_FALSE(filter.ttl_columns_.at(1).has_min_max_);
+  ASSERT_TRUE(filter.ttl_columns_.at(1).is_datetime_);
+  filter.reset();
+  ASSERT_FALSE(filter.is_inited_);
+}
+
+TEST_F(TestRowTTLFilter, filter_timestamp)
+{
+  ObRowTTLFilter filter;
+  add_ttl_column(TS_COL_IDX, 3600, 0);
+  ASSERT_EQ(OB_SUCCESS, filter.init(FILTER_TS, ttl_columns_, col_descs_, skip_idx_attrs_));
+  row_.row_flag_.set_flag(ObDmlFlag::DF_INSERT);
+  // expired at the merge snapshot exactly
+  check_row(filter, FILTER_TS - HOUR_US, -1, ObICompactionFilter::FILTER_RET_REMOVE);
+  check_row(filter, FILTER_TS - HOUR_US + 1, -1, ObICompactionFilter::FILTER_RET_NOT_CHANGE);
+  check_row(filter, 0, -1, ObICompactionFilter::FILTER_RET_REMOVE);
+  // null never expires
+  check_row(filter, -1, 0, ObICompactionFilter::FILTER_RET_NOT_CHANGE);
+  // delete rows are left to the major merger
+  row_.row_flag_.set_flag(ObDmlFlag::DF_DELETE);
+  check_row(filter, 0, -1, ObICompactionFilter::FILTER_RET_NOT_CHANGE);
+}
+
+TEST_F(TestRowTTLFilter, filter_datetime)
+{
+  ObRowTTLFilter filter;
+  add_ttl_column(DATETIME_COL_IDX, 3600, 0);
+  ASSERT_EQ(OB_SUCCESS, filter.init(FILTER_TS, ttl_columns_, col_descs_, skip_idx_attrs_));
+  row_.row_flag_.set_flag(ObDmlFlag::DF_INSERT);
+  // the time zone is unknown, the row is kept until it expires in every time zone
+  const int64_t max_tz_offset_us = ObRowTTLFilter::DATETIME_MAX_TZ_OFFSET_SEC * 1000L * 1000L;
+  check_row(filter, -1, FILTER_TS - HOUR_US, ObICompactionFilter::FILTER_RET_NOT_CHANGE);
+  check_row(filter, -1, FILTER_TS - HOUR_US - max_tz_offset_us + 1, ObICompactionFilter::FILTER_RET_NOT_CHANGE);
+  check_row(filter, -1, FILTER_TS - HOUR_US - max_tz_offset_us, ObICompactionFilter::FILTER_RET_REMOVE);
+  check_row(filter, -1, -1, ObICompactionFilter::FILTER_RET_NOT_CHANGE);
+}
+
+TEST_F(TestRowTTLFilter, filter_month)
+{
+  ObRowTTLFilter filter;
+  add_ttl_column(DATETIME_COL_IDX, 3600, 0);
+  add_ttl_column(TS_COL_IDX, 0, 1);
+  ASSERT_EQ(OB_SUCCESS, filter.init(FILTER_TS, ttl_columns_, col_descs_, skip_idx_attrs_));
+  row_.row_flag_.set_flag(ObDmlFlag::DF_INSERT);
+  const int64_t day_us = 24 * HOUR_US;
+  check_row(filter, FILTER_TS - 27 * day_us, FILTER_TS, ObICompactionFilter::FILTER_RET_NOT_CHANGE);
+  check_row(filter, FILTER_TS - 32 * day_us, FILTER_TS, ObICompactionFilter::FILTER_RET_REMOVE);
+  // expired by any ttl column
+  check_row(filter, FILTER_TS, 0, ObICompactionFilter::FILTER_RET_REMOVE);
+}
+
+TEST_F(TestRowTTLFilter, check_macro_block)
+{
+  ObRowTTLFilter filter;
+  add_ttl_column(TS_COL_IDX, 3600, 0);
+  ASSERT_EQ(OB_SUCCESS, filter.init(FILTER_TS, ttl_columns_, col_descs_, skip_idx_attrs_));
+  check_macro_block(filter, FILTER_TS - HOUR_US, true);
+  check_macro_block(filter, FILTER_TS - HOUR_US + 1, false);
+  check_macro_block(filter, -1, false);
+
+  // without min/max skip index the block is always reused
+  ObRowTTLFilter filter_without_skip_index;
+  skip_idx_attrs_.at(TS_COL_IDX).reset();
+  ASSERT_EQ(OB_SUCCESS, filter_without_skip_index.init(FILTER_TS, ttl_columns_, col_descs_, skip_idx_attrs_));
+  check_macro_block(filter_without_skip_index, FILTER_TS - HOUR_US, false);
+}
+
+}//end namespace unittest
+}//end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_row_ttl_filter.log*");
+  OB_LOGGER.set_file_name("test_row_ttl_filter.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -16,6 +16,7 @@
 #include "common/rowkey/ob_store_rowkey.h"
 #include "lib/allocator/ob_malloc.h"
 #include "lib/random/ob_random.h"
+#include "lib/time/ob_time_utility.h"
 #include "storage/memtable/ob_memtable_key.h"
 #include "storage/memtable/mvcc/ob_mvcc_row.h"
 
@@ -78,6 +79,11 @@ int BIND_CPU(pthread_t thread)
 
 const char *attr = ObModIds::TEST;
 
+typedef ObStoreRowkeyWrapper BtreeKey;
+typedef ObMvccRow *BtreeVal;
+typedef keybtree::BtreeNodeAllocator<BtreeKey, BtreeVal> BtreeNodeAllocator;
+typedef keybtree::BtreeIterator<BtreeKey, BtreeVal> BtreeIterator;
+
 void init_key(BtreeKey *ptr, int64_t key)
 {
   ptr->get_rowkey()->get_rowkey().get_obj_ptr()[0].set_int(key);
@@ -122,7 +128,7 @@ int64_t get_v(BtreeKey *ptr)
   return tmp;
 }
 
-typedef ObKeyBtree Btree;
+typedef ObKeyBtree<BtreeKey, BtreeVal> Btree;
 
 constexpr int64_t THREAD_COUNT = (1 << 6);
 
@@ -175,7 +181,7 @@ TEST(TestKeyBtree, smoke_test)
         IS_EQ(OB_SUCCESS, alloc_key(key, j));
         IS_EQ(OB_SUCCESS, btree.insert(*key, v));
       }
-      btree.destroy();
+      btree.destroy(false /*is_batch_destroy*/);
     });
   }
   // keep inserting at left bound
@@ -441,8 +447,8 @@ TEST(TestKeyBtree, smoke_test)
   _OB_LOG(INFO, "reinsert end");
   int32_t pos = btree.update_split_info(7);
   _OB_LOG(INFO, "btree split info %d", pos);
-  IS_EQ(OB_SUCCESS, btree.destroy());
 
+  // stop threads working on %btree before destroying it
   ATOMIC_STORE(&should_stop, true);
   for (int64_t i = 0; i < 2; ++i) {
     normal_threads[i].join();
@@ -450,6 +456,108 @@ TEST(TestKeyBtree, smoke_test)
     bad_scan_threads[i].join();
     scan_all_threads[i].join();
   }
+  IS_EQ(OB_SUCCESS, btree.destroy(false /*is_batch_destroy*/));
+}
+
+// Inline prefix of integer rowkeys keeps the order of the full rowkey compare.
+TEST(TestKeyBtree, key_prefix)
+{
+  const int64_t values[] = {INT64_MIN, INT64_MIN + 1, -1024, -1, 0, 1, 1024, INT64_MAX - 1, INT64_MAX};
+  const int64_t cnt = sizeof(values) / sizeof(values[0]);
+  BtreeKey *keys[cnt];
+  for (int64_t i = 0; i < cnt; ++i) {
+    IS_EQ(OB_SUCCESS, alloc_key(keys[i], values[i]));
+  }
+  for (int64_t i = 0; i < cnt; ++i) {
+    uint64_t l_prefix = 0;
+    uint8_t l_domain = 0;
+    keys[i]->get_prefix(l_prefix, l_domain);
+    ASSERT_EQ(ObIntTC, l_domain);
+    for (int64_t j = 0; j < cnt; ++j) {
+      uint64_t r_prefix = 0;
+      uint8_t r_domain = 0;
+      int cmp = 0;
+      keys[j]->get_prefix(r_prefix, r_domain);
+      ASSERT_EQ(OB_SUCCESS, keys[i]->compare(*keys[j], cmp));
+      ASSERT_EQ(cmp < 0, l_prefix < r_prefix);
+      ASSERT_EQ(0 == cmp, l_prefix == r_prefix);
+    }
+  }
+
+  // no prefix for other types, full rowkey compare is used
+  ObObj str_obj;
+  str_obj.set_varchar("abc");
+  str_obj.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  ObStoreRowkey str_rowkey(&str_obj, 1);
+  BtreeKey str_key(&str_rowkey);
+  uint64_t prefix = 0;
+  uint8_t domain = 0;
+  str_key.get_prefix(prefix, domain);
+  ASSERT_EQ(ObNullTC, domain);
+  ObStoreRowkeyWrapper null_key;
+  null_key.get_prefix(prefix, domain);
+  ASSERT_EQ(ObNullTC, domain);
+}
+
+// Throughput of insert and get with integer rowkeys, compares on the search path mostly
+// finish with the inline key prefix of btree nodes.
+TEST(TestKeyBtree, insert_get_perf)
+{
+  constexpr int64_t PERF_THREAD_COUNT = (1 << 3);
+  constexpr int64_t PERF_COUNT_PER_THREAD = (1 << 17);
+  lib::set_memory_limit(200 * 1024 * 1024 * 1024L);
+  BtreeNodeAllocator allocator(*FakeAllocator::get_instance());
+  Btree btree(allocator);
+  IS_EQ(OB_SUCCESS, btree.init());
+
+  BtreeKey *keys[PERF_THREAD_COUNT];
+  for (int64_t i = 0; i < PERF_THREAD_COUNT; ++i) {
+    IS_EQ(true, nullptr != (keys[i] = (BtreeKey *)ob_malloc(sizeof(BtreeKey) * PERF_COUNT_PER_THREAD, attr)));
+    for (int64_t j = 0; j < PERF_COUNT_PER_THREAD; ++j) {
+      BtreeKey *key = nullptr;
+      IS_EQ(OB_SUCCESS, alloc_key(key, ObRandom::rand(0, INT64_MAX - 1)));
+      keys[i][j] = *key;
+    }
+  }
+
+  std::thread threads[PERF_THREAD_COUNT];
+  int64_t start_ts = ObTimeUtility::current_time();
+  for (int64_t i = 0; i < PERF_THREAD_COUNT; ++i) {
+    threads[i] = std::thread([&, i]() {
+      int ret = OB_SUCCESS;
+      for (int64_t j = 0; j < PERF_COUNT_PER_THREAD; ++j) {
+        BtreeVal v = (BtreeVal)(j << 3);
+        if (OB_FAIL(btree.insert(keys[i][j], v))) {
+          IS_EQ(OB_ENTRY_EXIST, ret);
+        }
+      }
+    });
+  }
+  for (int64_t i = 0; i < PERF_THREAD_COUNT; ++i) {
+    threads[i].join();
+  }
+  int64_t insert_cost = ObTimeUtility::current_time() - start_ts;
+
+  start_ts = ObTimeUtility::current_time();
+  for (int64_t i = 0; i < PERF_THREAD_COUNT; ++i) {
+    threads[i] = std::thread([&, i]() {
+      BtreeVal tmp_value = nullptr;
+      for (int64_t j = 0; j < PERF_COUNT_PER_THREAD; ++j) {
+        IS_EQ(OB_SUCCESS, btree.get(keys[i][j], tmp_value));
+      }
+    });
+  }
+  for (int64_t i = 0; i < PERF_THREAD_COUNT; ++i) {
+    threads[i].join();
+  }
+  int64_t get_cost = ObTimeUtility::current_time() - start_ts;
+
+  const int64_t total = PERF_THREAD_COUNT * PERF_COUNT_PER_THREAD;
+  _OB_LOG(INFO, "btree perf thread_cnt=%ld insert_cnt=%ld insert_cost=%ldus insert_ops=%ld "
+          "get_cost=%ldus get_ops=%ld", PERF_THREAD_COUNT, total,
+          insert_cost, total * 1000000 / (insert_cost + 1),
+          get_cost, total * 1000000 / (get_cost + 1));
+  IS_EQ(OB_SUCCESS, btree.destroy(false /*is_batch_destroy*/));
 }
 
 }
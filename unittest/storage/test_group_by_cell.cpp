@@ -0,0 +1,308 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "storage/access/ob_pushdown_aggregate.h"
+#include "sql/engine/ob_exec_context.h"
+#include "lib/container/ob_bitmap.h"
+#undef protected
+#undef private
+
+namespace oceanbase
+{
+using namespace common;
+using namespace storage;
+
+namespace unittest
+{
+class TestGroupByCell : public ::testing::Test
+{
+public:
+  static const int64_t BATCH_SIZE = 16;
+  static const int64_t FRAME_SIZE = 64 * 1024;
+  TestGroupByCell()
+    : allocator_(ObModIds::TEST), exec_ctx_(allocator_), eval_ctx_(exec_ctx_), frame_(nullptr), frame_pos_(0) {}
+  virtual void SetUp()
+  {
+    frame_ = static_cast<char *>(allocator_.alloc(FRAME_SIZE));
+    ASSERT_NE(nullptr, frame_);
+    eval_ctx_.frames_ = &frame_;
+    frame_pos_ = 0;
+  }
+  // batch datums of the expr are in the frame, each with a result buffer
+  void init_expr(const ObItemType item_type, const ObObjType obj_type, sql::ObExpr &expr)
+  {
+    expr.type_ = item_type;
+    expr.datum_meta_.type_ = obj_type;
+    expr.obj_datum_map_ = ObDatum::get_obj_datum_map_type(obj_type);
+    expr.frame_idx_ = 0;
+    expr.datum_off_ = static_cast<uint32_t>(frame_pos_);
+    ObDatum *datums = reinterpret_cast<ObDatum *>(frame_ + frame_pos_);
+    frame_pos_ += sizeof(ObDatum) * BATCH_SIZE;
+    for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+      datums[i].ptr_ = frame_ + frame_pos_;
+      datums[i].set_null();
+      frame_pos_ += OBJ_DATUM_NUMBER_RES_SIZE;
+    }
+    ASSERT_LE(frame_pos_, FRAME_SIZE);
+  }
+  void init_group_by_cell(sql::ObExpr &col_expr, ObGroupByCell &group_by_cell)
+  {
+    void *buf = allocator_.alloc(sizeof(ObAggGroupByDatumBuf));
+    ASSERT_NE(nullptr, buf);
+    group_by_cell.group_by_col_offset_ = 0;
+    group_by_cell.group_by_col_expr_ = &col_expr;
+    group_by_cell.group_by_col_datum_buf_ = new (buf) ObAggGroupByDatumBuf(
+        col_expr.locate_batch_datums(eval_ctx_), BATCH_SIZE, OBJ_DATUM_NUMBER_RES_SIZE, allocator_);
+    group_by_cell.refs_buf_ = static_cast<uint32_t *>(allocator_.alloc(sizeof(uint32_t) * BATCH_SIZE));
+    ASSERT_NE(nullptr, group_by_cell.refs_buf_);
+    group_by_cell.can_merge_micro_block_ = true;
+  }
+  void add_agg_cell(const int32_t col_offset, sql::ObExpr &agg_expr, ObGroupByCell &group_by_cell)
+  {
+    ObAggCellBasicInfo basic_info(col_offset, col_offset, nullptr, &agg_expr, BATCH_SIZE);
+    ASSERT_EQ(OB_SUCCESS, group_by_cell.agg_cell_factory_.alloc_cell(
+        basic_info, group_by_cell.agg_cells_, false, true, &eval_ctx_));
+  }
+  void set_refs(ObGroupByCell &group_by_cell, const uint32_t *refs, const int64_t ref_cnt)
+  {
+    MEMCPY(group_by_cell.refs_buf_, refs, sizeof(uint32_t) * ref_cnt);
+    group_by_cell.set_ref_cnt(ref_cnt);
+  }
+  // read the distinct values of a micro block into tmp buf and extract the referenced ones
+  void extract_block(ObGroupByCell &group_by_cell, const int64_t *values, const int64_t value_cnt,
+                     const uint32_t *refs, const int64_t ref_cnt)
+  {
+    ObDatum *tmp_datums = group_by_cell.get_group_by_col_datums_to_fill();
+    for (int64_t i = 0; i < value_cnt; ++i) {
+      tmp_datums[i].set_int(values[i]);
+    }
+    const int64_t held_cnt = group_by_cell.is_merging() ? group_by_cell.get_distinct_cnt() : 0;
+    group_by_cell.set_distinct_cnt(held_cnt);
+    set_refs(group_by_cell, refs, ref_cnt);
+    ASSERT_EQ(OB_SUCCESS, group_by_cell.extract_distinct());
+    ASSERT_EQ(OB_SUCCESS, group_by_cell.check_distinct_and_ref_valid());
+  }
+  void check_number(const ObDatum &datum, const char *expect)
+  {
+    char buf[64];
+    int64_t pos = 0;
+    number::ObNumber nmb(datum.get_number());
+    ASSERT_EQ(OB_SUCCESS, nmb.format(buf, sizeof(buf), pos, -1));
+    buf[pos] = '\0';
+    ASSERT_STREQ(expect, buf);
+  }
+protected:
+  ObArenaAllocator allocator_;
+  sql::ObExecContext exec_ctx_;
+  sql::ObEvalCtx eval_ctx_;
+  char *frame_;
+  int64_t frame_pos_;
+};
+
+// sum on group by column is the distinct value multiplied by its row count
+TEST_F(TestGroupByCell, sum_with_ref_cnts)
+{
+  sql::ObExpr col_expr;
+  sql::ObExpr sum_expr;
+  sql::ObExpr *sum_args[1] = {&col_expr};
+  init_expr(T_REF_COLUMN, ObIntType, col_expr);
+  init_expr(T_FUN_SUM, ObNumberType, sum_expr);
+  sum_expr.args_ = sum_args;
+  sum_expr.arg_cnt_ = 1;
+  ObGroupByCell group_by_cell(BATCH_SIZE, allocator_);
+  init_group_by_cell(col_expr, group_by_cell);
+  add_agg_cell(0, sum_expr, group_by_cell);
+  ObAggCell *sum_cell = group_by_cell.get_agg_cells().at(0);
+  ASSERT_TRUE(sum_cell->can_eval_with_ref_cnts(true));
+  ASSERT_FALSE(sum_cell->can_eval_with_ref_cnts(false));
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.reserve_group_by_buf(4));
+
+  ObDatum *col_datums = group_by_cell.get_group_by_col_datums();
+  col_datums[0].set_int(10);
+  col_datums[1].set_int(-20);
+  col_datums[2].set_int(INT64_MAX);
+  col_datums[3].set_null();
+  group_by_cell.set_distinct_cnt(4);
+  const uint32_t refs[] = {0, 0, 1, 2, 2, 0, 3, 2};
+  set_refs(group_by_cell, refs, sizeof(refs) / sizeof(refs[0]));
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.eval_batch(col_datums, sizeof(refs) / sizeof(refs[0]), 0, true));
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.collect_result());
+
+  ObDatum *sum_datums = sum_expr.locate_batch_datums(eval_ctx_);
+  check_number(sum_datums[0], "30");
+  check_number(sum_datums[1], "-20");
+  // the product overflows int64, summed row by row
+  check_number(sum_datums[2], "27670116110564327421");
+  ASSERT_TRUE(sum_datums[3].is_null());
+}
+
+TEST_F(TestGroupByCell, sum_number_with_ref_cnts)
+{
+  sql::ObExpr col_expr;
+  sql::ObExpr sum_expr;
+  sql::ObExpr *sum_args[1] = {&col_expr};
+  init_expr(T_REF_COLUMN, ObNumberType, col_expr);
+  init_expr(T_FUN_SUM, ObNumberType, sum_expr);
+  sum_expr.args_ = sum_args;
+  sum_expr.arg_cnt_ = 1;
+  ObGroupByCell group_by_cell(BATCH_SIZE, allocator_);
+  init_group_by_cell(col_expr, group_by_cell);
+  add_agg_cell(0, sum_expr, group_by_cell);
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.reserve_group_by_buf(2));
+
+  ObDatum *col_datums = group_by_cell.get_group_by_col_datums();
+  number::ObNumber nmb;
+  ASSERT_EQ(OB_SUCCESS, nmb.from("1.25", allocator_));
+  col_datums[0].set_number(nmb);
+  ASSERT_EQ(OB_SUCCESS, nmb.from("-3.5", allocator_));
+  col_datums[1].set_number(nmb);
+  group_by_cell.set_distinct_cnt(2);
+  const uint32_t refs[] = {0, 1, 0, 0, 1};
+  set_refs(group_by_cell, refs, sizeof(refs) / sizeof(refs[0]));
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.eval_batch(col_datums, sizeof(refs) / sizeof(refs[0]), 0, true));
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.collect_result());
+
+  ObDatum *sum_datums = sum_expr.locate_batch_datums(eval_ctx_);
+  check_number(sum_datums[0], "3.75");
+  check_number(sum_datums[1], "-7");
+}
+
+// groups of consecutive micro blocks are merged into one batch by the group by value
+TEST_F(TestGroupByCell, merge_micro_blocks)
+{
+  sql::ObExpr col_expr;
+  sql::ObExpr sum_expr;
+  sql::ObExpr count_expr;
+  sql::ObExpr *sum_args[1] = {&col_expr};
+  init_expr(T_REF_COLUMN, ObIntType, col_expr);
+  init_expr(T_FUN_SUM, ObNumberType, sum_expr);
+  init_expr(T_FUN_COUNT, ObIntType, count_expr);
+  sum_expr.args_ = sum_args;
+  sum_expr.arg_cnt_ = 1;
+  ObGroupByCell group_by_cell(BATCH_SIZE, allocator_);
+  init_group_by_cell(col_expr, group_by_cell);
+  add_agg_cell(0, sum_expr, group_by_cell);
+  add_agg_cell(OB_COUNT_AGG_PD_COLUMN_ID, count_expr, group_by_cell);
+  const ObBitmap *bitmap = nullptr;
+  bool use_group_by = false;
+
+  // first micro block, partially read
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.decide_use_group_by(100, 60, 2, bitmap, use_group_by));
+  ASSERT_TRUE(use_group_by);
+  ASSERT_TRUE(group_by_cell.need_extract_distinct());
+  const int64_t values1[] = {1, 2};
+  const uint32_t refs1[] = {0, 1, 1};
+  extract_block(group_by_cell, values1, 2, refs1, 3);
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.eval_batch(group_by_cell.get_group_by_col_datums(), 3, 0, true));
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.eval_batch(nullptr, 3, 1, false));
+  ASSERT_TRUE(group_by_cell.can_hold_group_by_result());
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.hold_group_by_result());
+  ASSERT_TRUE(group_by_cell.is_merging());
+
+  // second micro block, value 2 is merged into the held group
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.decide_use_group_by(100, 100, 2, bitmap, use_group_by));
+  ASSERT_TRUE(use_group_by);
+  const int64_t values2[] = {3, 2};
+  const uint32_t refs2[] = {1, 0, 0};
+  extract_block(group_by_cell, values2, 2, refs2, 3);
+  ASSERT_EQ(3, group_by_cell.get_distinct_cnt());
+  ASSERT_EQ(1, group_by_cell.get_refs_buf()[0]);
+  ASSERT_EQ(2, group_by_cell.get_refs_buf()[1]);
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.eval_batch(group_by_cell.get_group_by_col_datums(), 3, 0, true));
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.eval_batch(nullptr, 3, 1, false));
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.hold_group_by_result());
+
+  // too many distinct values to merge into this batch
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.decide_use_group_by(100, 100, BATCH_SIZE - 3, bitmap, use_group_by));
+  ASSERT_FALSE(use_group_by);
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.collect_merged_result());
+  ASSERT_FALSE(group_by_cell.is_merging());
+
+  ObDatum *col_datums = group_by_cell.get_group_by_col_datums();
+  ObDatum *sum_datums = sum_expr.locate_batch_datums(eval_ctx_);
+  ObDatum *count_datums = count_expr.locate_batch_datums(eval_ctx_);
+  const int64_t expect_values[] = {1, 2, 3};
+  const char *expect_sums[] = {"1", "6", "6"};
+  const int64_t expect_counts[] = {1, 3, 2};
+  for (int64_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(expect_values[i], col_datums[i].get_int());
+    check_number(sum_datums[i], expect_sums[i]);
+    ASSERT_EQ(expect_counts[i], count_datums[i].get_int());
+  }
+
+  // held groups are dropped in next batch
+  group_by_cell.reuse();
+  ASSERT_FALSE(group_by_cell.is_merging());
+  ASSERT_EQ(0, group_by_cell.held_cnt_);
+}
+
+// string values of held groups do not refer to the released micro block
+TEST_F(TestGroupByCell, hold_string_groups)
+{
+  sql::ObExpr col_expr;
+  init_expr(T_REF_COLUMN, ObVarcharType, col_expr);
+  ObGroupByCell group_by_cell(BATCH_SIZE, allocator_);
+  init_group_by_cell(col_expr, group_by_cell);
+  const ObBitmap *bitmap = nullptr;
+  bool use_group_by = false;
+  char block_data[8];
+
+  MEMCPY(block_data, "aaaabbbb", 8);
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.decide_use_group_by(100, 60, 2, bitmap, use_group_by));
+  ASSERT_TRUE(use_group_by);
+  ObDatum *tmp_datums = group_by_cell.get_group_by_col_datums_to_fill();
+  tmp_datums[0].set_string(block_data, 4);
+  tmp_datums[1].set_string(block_data + 4, 4);
+  group_by_cell.set_distinct_cnt(0);
+  const uint32_t refs1[] = {1, 0};
+  set_refs(group_by_cell, refs1, 2);
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.extract_distinct());
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.hold_group_by_result());
+
+  // next micro block is read into the same memory
+  MEMCPY(block_data, "ccccbbbb", 8);
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.decide_use_group_by(100, 100, 2, bitmap, use_group_by));
+  ASSERT_TRUE(use_group_by);
+  tmp_datums = group_by_cell.get_group_by_col_datums_to_fill();
+  tmp_datums[0].set_string(block_data, 4);
+  tmp_datums[1].set_string(block_data + 4, 4);
+  group_by_cell.set_distinct_cnt(group_by_cell.get_distinct_cnt());
+  const uint32_t refs2[] = {1, 0, 1};
+  set_refs(group_by_cell, refs2, 3);
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.extract_distinct());
+  ASSERT_EQ(3, group_by_cell.get_distinct_cnt());
+  ASSERT_EQ(0, group_by_cell.get_refs_buf()[0]);
+  ASSERT_EQ(2, group_by_cell.get_refs_buf()[1]);
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.hold_group_by_result());
+  MEMSET(block_data, 'x', 8);
+
+  ObDatum *col_datums = group_by_cell.get_group_by_col_datums();
+  ASSERT_EQ(ObString(4, "bbbb"), col_datums[0].get_string());
+  ASSERT_EQ(ObString(4, "aaaa"), col_datums[1].get_string());
+  ASSERT_EQ(ObString(4, "cccc"), col_datums[2].get_string());
+  ASSERT_EQ(OB_SUCCESS, group_by_cell.collect_merged_result());
+}
+
+}//end namespace unittest
+}//end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_group_by_cell.log*");
+  OB_LOGGER.set_file_name("test_group_by_cell.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,150 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "storage/access/ob_micro_block_handle_mgr.h"
+#include "storage/blocksstable/ob_micro_block_cache.h"
+#undef protected
+#undef private
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+using namespace storage;
+
+namespace unittest
+{
+class TestMicroBlockHandleMgr : public ::testing::Test
+{
+public:
+  static const int64_t BLOCK_CNT = 4;
+  TestMicroBlockHandleMgr() : allocator_(ObModIds::TEST) {}
+  virtual void SetUp()
+  {
+    macro_id_.set_block_index(100);
+    macro_id_.set_write_seq(1);
+    for (int64_t i = 0; i < BLOCK_CNT; ++i) {
+      ObIndexBlockRowHeader &header = headers_[i];
+      header.version_ = ObIndexBlockRowHeader::INDEX_BLOCK_HEADER_V1;
+      header.is_data_block_ = 1;
+      header.block_offset_ = static_cast<int32_t>(4096 + i * 8192);
+      header.block_size_ = static_cast<int32_t>(4000 + i);
+      ObMicroIndexInfo micro_info;
+      micro_info.row_header_ = &header;
+      micro_info.parent_macro_id_ = macro_id_;
+      ASSERT_EQ(OB_SUCCESS, micro_infos_.push_back(micro_info));
+    }
+  }
+protected:
+  ObArenaAllocator allocator_;
+  MacroBlockId macro_id_;
+  ObIndexBlockRowHeader headers_[BLOCK_CNT];
+  ObSEArray<ObMicroIndexInfo, BLOCK_CNT> micro_infos_;
+};
+
+// the io ctx of multi block io keeps the offsets and sizes after the index infos and the index
+// block they point to are reused.
+TEST_F(TestMicroBlockHandleMgr, multi_block_io_ctx)
+{
+  ObMultiBlockIOParam io_param;
+  io_param.micro_index_infos_ = &micro_infos_;
+  io_param.start_index_ = 1;
+  io_param.block_count_ = BLOCK_CNT - 1;
+  ASSERT_TRUE(io_param.is_valid());
+
+  ObMultiDataBlockIOCallback callback;
+  ASSERT_EQ(OB_INNER_STAT_ERROR, callback.set_io_ctx(io_param));
+  callback.allocator_ = &allocator_;
+  ASSERT_EQ(OB_SUCCESS, callback.set_io_ctx(io_param));
+  ASSERT_TRUE(callback.io_ctx_.is_valid());
+  ASSERT_EQ(BLOCK_CNT - 1, callback.io_ctx_.block_count_);
+
+  micro_infos_.reuse();
+  for (int64_t i = 0; i < BLOCK_CNT; ++i) {
+    headers_[i].block_offset_ = 0;
+    headers_[i].block_size_ = 0;
+  }
+  for (int64_t i = 0; i < BLOCK_CNT - 1; ++i) {
+    ASSERT_EQ(4096 + (i + 1) * 8192, callback.io_ctx_.micro_offsets_[i]);
+    ASSERT_EQ(4000 + i + 1, callback.io_ctx_.micro_sizes_[i]);
+  }
+  callback.free_io_ctx();
+  ASSERT_FALSE(callback.io_ctx_.is_valid());
+}
+
+// rowkeys in the same data block share the handle of the multi block io by copy, only the
+// handle got from the handle mgr is accounted in the hold size.
+TEST_F(TestMicroBlockHandleMgr, copied_handle)
+{
+  ObMicroBlockHandleMgr handle_mgr;
+  {
+    ObMicroBlockDataHandle handle;
+    handle.tenant_id_ = OB_SERVER_TENANT_ID;
+    handle.macro_block_id_ = macro_id_;
+    handle.micro_info_.set(headers_[2].block_offset_, headers_[2].block_size_);
+    handle.handle_mgr_ = &handle_mgr;
+    handle.block_state_ = ObSSTableMicroBlockState::IN_BLOCK_IO;
+    handle.block_index_ = 2;
+    handle.allocator_ = &allocator_;
+    handle_mgr.current_hold_size_ += handle.get_handle_size();
+    ASSERT_EQ(headers_[2].block_size_, handle_mgr.current_hold_size_);
+
+    ObMicroBlockDataHandle copied_handle;
+    copied_handle.handle_mgr_ = &handle_mgr;
+    copied_handle = handle;
+    ASSERT_EQ(nullptr, copied_handle.handle_mgr_);
+    ASSERT_EQ(ObSSTableMicroBlockState::IN_BLOCK_IO, copied_handle.block_state_);
+    ASSERT_EQ(2, copied_handle.block_index_);
+    ASSERT_EQ(macro_id_, copied_handle.macro_block_id_);
+    ASSERT_EQ(handle.micro_info_.offset_, copied_handle.micro_info_.offset_);
+    ASSERT_EQ(handle.micro_info_.size_, copied_handle.micro_info_.size_);
+    ASSERT_EQ(&allocator_, copied_handle.allocator_);
+    ASSERT_FALSE(copied_handle.need_release_data_buf_);
+
+    copied_handle.reset();
+    ASSERT_EQ(headers_[2].block_size_, handle_mgr.current_hold_size_);
+    ASSERT_EQ(ObSSTableMicroBlockState::IN_BLOCK_IO, handle.block_state_);
+    ASSERT_EQ(2, handle.block_index_);
+  }
+  ASSERT_EQ(0, handle_mgr.current_hold_size_);
+}
+
+// the waits on index block io are not counted as the data block prefetch stalls
+TEST_F(TestMicroBlockHandleMgr, io_stall)
+{
+  ObMicroBlockHandleMgr handle_mgr;
+  ASSERT_EQ(0, handle_mgr.get_io_stall_count());
+  handle_mgr.add_io_stall(false, 100);
+  ASSERT_EQ(0, handle_mgr.get_io_stall_count());
+  handle_mgr.add_io_stall(true, 100);
+  handle_mgr.add_io_stall(true, 200);
+  ASSERT_EQ(2, handle_mgr.get_io_stall_count());
+  handle_mgr.add_io_stall(false, 100);
+  ASSERT_EQ(2, handle_mgr.get_io_stall_count());
+  handle_mgr.reset();
+  ASSERT_EQ(0, handle_mgr.get_io_stall_count());
+}
+
+}//end namespace unittest
+}//end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_micro_block_handle_mgr.log*");
+  OB_LOGGER.set_file_name("test_micro_block_handle_mgr.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
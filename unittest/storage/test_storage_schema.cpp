@@ -229,6 +229,74 @@ TEST_F(TestStorageSchema, deep_copy_str)
 
 }
 
+TEST_F(TestStorageSchema, serialize_ttl_columns)
+{
+  share::schema::ObTableSchema table_schema;
+  ObStorageSchema storage_schema;
+  TestSchemaPrepare::prepare_schema(table_schema);
+  ASSERT_EQ(OB_SUCCESS, storage_schema.init(allocator_, table_schema, lib::Worker::CompatMode::MYSQL));
+  ASSERT_EQ(ObStorageSchema::STORAGE_SCHEMA_VERSION_V3, storage_schema.storage_schema_version_);
+  ASSERT_TRUE(storage_schema.get_ttl_columns().empty());
+
+  ObStorageTTLColumnSchema ttl_column;
+  ttl_column.column_id_ = OB_APP_MIN_COLUMN_ID + 1;
+  ttl_column.nsecond_ = 3600;
+  ttl_column.is_datetime_ = true;
+  ASSERT_EQ(OB_SUCCESS, storage_schema.ttl_column_array_.reserve(1));
+  ASSERT_EQ(OB_SUCCESS, storage_schema.ttl_column_array_.push_back(ttl_column));
+  storage_schema.storage_schema_version_ = ObStorageSchema::STORAGE_SCHEMA_VERSION_V4;
+  ASSERT_TRUE(storage_schema.is_valid());
+
+  const int64_t buf_len = 1024 * 1024;
+  int64_t ser_pos = 0;
+  int64_t pos = 0;
+  char buf[buf_len];
+  ASSERT_EQ(OB_SUCCESS, storage_schema.serialize(buf, buf_len, ser_pos));
+  ASSERT_EQ(ser_pos, storage_schema.get_serialize_size());
+  ObStorageSchema des_storage_schema;
+  ASSERT_EQ(OB_SUCCESS, des_storage_schema.deserialize(allocator_, buf, ser_pos, pos));
+  ASSERT_EQ(ser_pos, pos);
+  ASSERT_EQ(true, judge_storage_schema_equal(storage_schema, des_storage_schema));
+  ASSERT_EQ(ObStorageSchema::STORAGE_SCHEMA_VERSION_V4, des_storage_schema.storage_schema_version_);
+  ASSERT_EQ(1, des_storage_schema.get_ttl_columns().count());
+  ASSERT_EQ(ttl_column.column_id_, des_storage_schema.get_ttl_columns().at(0).column_id_);
+  ASSERT_EQ(3600, des_storage_schema.get_ttl_columns().at(0).nsecond_);
+  ASSERT_EQ(0, des_storage_schema.get_ttl_columns().at(0).nmonth_);
+  ASSERT_TRUE(des_storage_schema.get_ttl_columns().at(0).is_datetime_);
+
+  // the ttl columns are kept by the copied schema
+  ObStorageSchema copied_storage_schema;
+  ASSERT_EQ(OB_SUCCESS, copied_storage_schema.init(allocator_, des_storage_schema));
+  ASSERT_EQ(ObStorageSchema::STORAGE_SCHEMA_VERSION_V4, copied_storage_schema.storage_schema_version_);
+  ASSERT_EQ(1, copied_storage_schema.get_ttl_columns().count());
+
+  // V3 schema does not carry ttl columns, so it could be read by old observers
+  storage_schema.storage_schema_version_ = ObStorageSchema::STORAGE_SCHEMA_VERSION_V3;
+  ser_pos = 0;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, storage_schema.serialize(buf, buf_len, ser_pos));
+  ASSERT_EQ(ser_pos, storage_schema.get_serialize_size());
+  des_storage_schema.reset();
+  ASSERT_EQ(OB_SUCCESS, des_storage_schema.deserialize(allocator_, buf, ser_pos, pos));
+  ASSERT_EQ(ser_pos, pos);
+  ASSERT_TRUE(des_storage_schema.get_ttl_columns().empty());
+}
+
+// rows of data table can not be purged alone if the table has index or lob columns
+TEST_F(TestStorageSchema, skip_ttl_columns_with_index)
+{
+  share::schema::ObTableSchema table_schema;
+  ObStorageSchema storage_schema;
+  TestSchemaPrepare::prepare_schema(table_schema);
+  ASSERT_EQ(OB_SUCCESS, table_schema.set_ttl_definition("c1 + INTERVAL 1 DAY"));
+  ASSERT_EQ(OB_SUCCESS, table_schema.add_simple_index_info(share::schema::ObAuxTableMetaInfo(
+      500001, share::schema::USER_INDEX, share::schema::INDEX_TYPE_NORMAL_LOCAL)));
+  ASSERT_EQ(OB_SUCCESS, storage_schema.init(allocator_, table_schema, lib::Worker::CompatMode::MYSQL,
+                                            false/*skip_column_info*/, ObStorageSchema::STORAGE_SCHEMA_VERSION_V4));
+  ASSERT_EQ(ObStorageSchema::STORAGE_SCHEMA_VERSION_V4, storage_schema.storage_schema_version_);
+  ASSERT_TRUE(storage_schema.get_ttl_columns().empty());
+}
+
 } // namespace unittest
 } // namespace oceanbase
 
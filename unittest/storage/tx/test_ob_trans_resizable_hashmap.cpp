@@ -0,0 +1,382 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "storage/tx/ob_trans_resizable_hashmap.h"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "share/ob_errno.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/time/ob_time_utility.h"
+#include "storage/tx/ob_trans_define.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace transaction;
+namespace unittest
+{
+class TestObTransResizableHashMap : public ::testing::Test
+{
+public :
+  virtual void SetUp() {}
+  virtual void TearDown() {}
+};
+
+class ObTransTestValue : public ObTransResizableHashLink<ObTransTestValue>
+{
+public:
+  static const int64_t MAGIC_NUM = 0x7472616e73;
+  ObTransTestValue() : magic_(MAGIC_NUM) {}
+  ~ObTransTestValue() { magic_ = 0; }
+  int init(const ObTransID &trans_id)
+  {
+    int ret = OB_SUCCESS;
+    if (!trans_id.is_valid()) {
+      ret = OB_INVALID_ARGUMENT;
+    } else {
+      trans_id_ = trans_id;
+    }
+    return ret;
+  }
+  bool contain(const ObTransID &trans_id) { return trans_id_ == trans_id; }
+  const ObTransID &get_trans_id() const { return trans_id_; }
+  bool is_valid() const { return MAGIC_NUM == ATOMIC_LOAD(&magic_); }
+  TO_STRING_KV(K_(trans_id), "ref", get_ref());
+private:
+  int64_t magic_;
+  ObTransID trans_id_;
+};
+
+class ObTransTestValueAlloc
+{
+public:
+  ObTransTestValue *alloc_value()
+  {
+    ATOMIC_INC(&alloc_cnt_);
+    return op_alloc(ObTransTestValue);
+  }
+  void free_value(ObTransTestValue *val)
+  {
+    if (NULL != val) {
+      ATOMIC_INC(&free_cnt_);
+      op_free(val);
+    }
+  }
+  static int64_t alloc_cnt_;
+  static int64_t free_cnt_;
+};
+int64_t ObTransTestValueAlloc::alloc_cnt_ = 0;
+int64_t ObTransTestValueAlloc::free_cnt_ = 0;
+
+typedef ObTransResizableHashMap<ObTransID, ObTransTestValue, ObTransTestValueAlloc,
+                                common::SpinRWLock, 64, 1 << 20> TestHashMap;
+// the same as ObLSTxCtxMap before being resizable
+typedef ObTransHashMap<ObTransID, ObTransTestValue, ObTransTestValueAlloc,
+                       common::SpinRWLock, 1 << 14> TestFixedHashMap;
+
+class CountFunctor
+{
+public:
+  CountFunctor() : cnt_(0) {}
+  bool operator() (ObTransTestValue *val)
+  {
+    if (NULL != val && val->is_valid()) {
+      cnt_++;
+    }
+    return true;
+  }
+  int64_t cnt_;
+};
+
+class DelFunctor
+{
+public:
+  DelFunctor(TestHashMap *map) : map_(map) {}
+  bool operator() (ObTransTestValue *val)
+  {
+    if (NULL != map_) {
+      map_->del(val->get_trans_id(), val);
+    }
+    return true;
+  }
+private:
+  TestHashMap *map_;
+};
+
+class RemoveFunctor
+{
+public:
+  bool operator() (ObTransTestValue *val)
+  {
+    UNUSED(val);
+    return true;
+  }
+};
+
+TEST_F(TestObTransResizableHashMap, ref)
+{
+  TRANS_LOG(INFO, "called", "func", test_info_->name());
+  TestHashMap map;
+  ASSERT_EQ(OB_SUCCESS, map.init(lib::ObMemAttr(OB_SERVER_TENANT_ID, "TestTxHashMap")));
+
+  // insert and get
+  ObTransID trans_id1(1);
+  ObTransTestValue *val1 = NULL;
+  ObTransTestValue *v = NULL;
+  EXPECT_EQ(OB_SUCCESS, map.alloc_value(val1));
+  EXPECT_EQ(OB_SUCCESS, val1->init(trans_id1));
+  EXPECT_EQ(OB_SUCCESS, map.insert_and_get(trans_id1, val1, &v));
+  EXPECT_EQ(2, val1->get_ref());
+  EXPECT_EQ(NULL, v);
+  map.revert(val1);
+  EXPECT_EQ(1, val1->get_ref());
+  ObTransTestValue *tmp = NULL;
+  EXPECT_EQ(OB_SUCCESS, map.get(trans_id1, tmp));
+  EXPECT_EQ(tmp, val1);
+  EXPECT_EQ(2, val1->get_ref());
+  map.revert(tmp);
+  EXPECT_EQ(1, val1->get_ref());
+
+  // entry exist
+  ObTransTestValue *val2 = NULL;
+  EXPECT_EQ(OB_SUCCESS, map.alloc_value(val2));
+  EXPECT_EQ(OB_SUCCESS, val2->init(trans_id1));
+  EXPECT_EQ(OB_ENTRY_EXIST, map.insert_and_get(trans_id1, val2, &v));
+  EXPECT_EQ(v, val1);
+  EXPECT_EQ(2, val1->get_ref());
+  EXPECT_EQ(0, val2->get_ref());
+  map.revert(v);
+  map.free_value(val2);
+
+  // del with a ref held, the value is retired by the last revert and freed by the purge
+  EXPECT_EQ(OB_SUCCESS, map.get(trans_id1, tmp));
+  EXPECT_EQ(OB_SUCCESS, map.del(trans_id1, val1));
+  EXPECT_EQ(1, val1->get_ref());
+  EXPECT_EQ(0, map.count());
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, map.get(trans_id1, tmp));
+  // del again does nothing
+  EXPECT_EQ(OB_SUCCESS, map.del(trans_id1, val1));
+  EXPECT_EQ(1, val1->get_ref());
+  const int64_t free_cnt = ObTransTestValueAlloc::free_cnt_;
+  map.revert(val1);
+  EXPECT_EQ(free_cnt, ObTransTestValueAlloc::free_cnt_);
+  EXPECT_EQ(1, map.get_retired_cnt());
+  map.purge_retired_values();
+  EXPECT_EQ(free_cnt + 1, ObTransTestValueAlloc::free_cnt_);
+  EXPECT_EQ(0, map.get_retired_cnt());
+
+  // for each and remove if
+  for (int64_t i = 100; i < 300; i++) {
+    ObTransTestValue *val = NULL;
+    EXPECT_EQ(OB_SUCCESS, map.alloc_value(val));
+    EXPECT_EQ(OB_SUCCESS, val->init(ObTransID(i)));
+    EXPECT_EQ(OB_SUCCESS, map.insert(ObTransID(i), val));
+  }
+  EXPECT_EQ(200, map.count());
+  CountFunctor count_fn;
+  EXPECT_EQ(OB_SUCCESS, map.for_each(count_fn));
+  EXPECT_EQ(200, count_fn.cnt_);
+  count_fn.cnt_ = 0;
+  for (int64_t pos = 0; pos < TestHashMap::get_buckets_cnt(); pos++) {
+    EXPECT_EQ(OB_SUCCESS, map.for_each_in_one_bucket(count_fn, pos));
+  }
+  EXPECT_EQ(200, count_fn.cnt_);
+  EXPECT_EQ(OB_INVALID_ARGUMENT, map.for_each_in_one_bucket(count_fn, TestHashMap::get_buckets_cnt()));
+  DelFunctor del_fn(&map);
+  EXPECT_EQ(OB_SUCCESS, map.for_each(del_fn));
+  EXPECT_EQ(0, map.count());
+
+  // removed values are left to the caller like ObTransHashMap
+  ObTransTestValue *val3 = NULL;
+  EXPECT_EQ(OB_SUCCESS, map.alloc_value(val3));
+  EXPECT_EQ(OB_SUCCESS, val3->init(ObTransID(3)));
+  EXPECT_EQ(OB_SUCCESS, map.insert(ObTransID(3), val3));
+  RemoveFunctor remove_fn;
+  EXPECT_EQ(OB_SUCCESS, map.remove_if(remove_fn));
+  EXPECT_EQ(0, map.count());
+  EXPECT_EQ(1, val3->get_ref());
+  map.revert(val3);
+  map.reset();
+  EXPECT_EQ(ObTransTestValueAlloc::alloc_cnt_, ObTransTestValueAlloc::free_cnt_);
+}
+
+TEST_F(TestObTransResizableHashMap, resize)
+{
+  TRANS_LOG(INFO, "called", "func", test_info_->name());
+  const int64_t VALUE_CNT = 100000;
+  TestHashMap map;
+  ASSERT_EQ(OB_SUCCESS, map.init(lib::ObMemAttr(OB_SERVER_TENANT_ID, "TestTxHashMap")));
+  EXPECT_EQ(64, map.get_cur_buckets_cnt());
+  for (int64_t i = 1; i <= VALUE_CNT; i++) {
+    ObTransTestValue *val = NULL;
+    ASSERT_EQ(OB_SUCCESS, map.alloc_value(val));
+    ASSERT_EQ(OB_SUCCESS, val->init(ObTransID(i)));
+    ASSERT_EQ(OB_SUCCESS, map.insert(ObTransID(i), val));
+    // all values can be found while the buckets are being moved
+    if (0 == i % 1000) {
+      for (int64_t j = 1; j <= i; j += 97) {
+        ObTransTestValue *tmp = NULL;
+        ASSERT_EQ(OB_SUCCESS, map.get(ObTransID(j), tmp));
+        ASSERT_EQ(ObTransID(j), tmp->get_trans_id());
+        map.revert(tmp);
+      }
+    }
+  }
+  const int64_t max_buckets_cnt = map.get_cur_buckets_cnt();
+  TRANS_LOG(INFO, "grow", K(max_buckets_cnt));
+  EXPECT_GE(max_buckets_cnt, VALUE_CNT / 2);
+  CountFunctor count_fn;
+  EXPECT_EQ(OB_SUCCESS, map.for_each(count_fn));
+  EXPECT_EQ(VALUE_CNT, count_fn.cnt_);
+
+  for (int64_t i = 1; i <= VALUE_CNT; i++) {
+    ObTransTestValue *tmp = NULL;
+    ASSERT_EQ(OB_SUCCESS, map.get(ObTransID(i), tmp));
+    ASSERT_EQ(OB_SUCCESS, map.del(ObTransID(i), tmp));
+    map.revert(tmp);
+    if (0 == i % 1000) {
+      for (int64_t j = i + 1; j <= VALUE_CNT; j += 97) {
+        ASSERT_EQ(OB_SUCCESS, map.get(ObTransID(j), tmp));
+        map.revert(tmp);
+      }
+    }
+  }
+  const int64_t min_buckets_cnt = map.get_cur_buckets_cnt();
+  TRANS_LOG(INFO, "shrink", K(min_buckets_cnt));
+  EXPECT_LT(min_buckets_cnt, max_buckets_cnt);
+  EXPECT_EQ(0, map.count());
+  // the deleted values are freed in batch without any background purge
+  const int64_t retire_limit = TestHashMap::RETIRE_LIMIT;
+  EXPECT_LE(map.get_retired_cnt(), retire_limit);
+  EXPECT_GE(ObTransTestValueAlloc::free_cnt_, ObTransTestValueAlloc::alloc_cnt_ - retire_limit);
+  map.reset();
+  EXPECT_EQ(ObTransTestValueAlloc::alloc_cnt_, ObTransTestValueAlloc::free_cnt_);
+}
+
+// Every thread keeps INFLIGHT_CNT transactions in the map, and for each new transaction,
+// gets GET_CNT transactions of all threads like the redo, commit and lock wait callbacks,
+// then deletes its oldest transaction.
+template <typename HashMap>
+class StressTester
+{
+public:
+  static const int64_t THREAD_CNT = 16;
+  static const int64_t INFLIGHT_CNT = 8192;
+  static const int64_t TX_CNT = 50000;
+  static const int64_t GET_CNT = 8;
+
+  StressTester() : map_(NULL), get_succ_cnt_(0), get_fail_cnt_(0) {}
+  void run(const char *name)
+  {
+    map_ = new HashMap();
+    ASSERT_EQ(OB_SUCCESS, map_->init(lib::ObMemAttr(OB_SERVER_TENANT_ID, "TestTxHashMap")));
+    const int64_t start_ts = ObTimeUtility::current_time();
+    std::vector<std::thread> ths;
+    for (int64_t i = 0; i < THREAD_CNT; i++) {
+      ths.push_back(std::thread(&StressTester::do_work, this, i));
+    }
+    for (int64_t i = 0; i < THREAD_CNT; i++) {
+      ths[i].join();
+    }
+    const int64_t cost_us = ObTimeUtility::current_time() - start_ts;
+    const int64_t op_cnt = THREAD_CNT * TX_CNT * (GET_CNT + 3);
+    EXPECT_EQ(0, map_->count());
+    map_->reset();
+    delete map_;
+    map_ = NULL;
+    EXPECT_EQ(ObTransTestValueAlloc::alloc_cnt_, ObTransTestValueAlloc::free_cnt_);
+    TRANS_LOG(INFO, "stress done", K(name), K(cost_us), K(op_cnt), "ops", op_cnt * 1000000 / cost_us,
+              K_(get_succ_cnt), K_(get_fail_cnt));
+    fprintf(stdout, "%s: cost=%ldus ops=%ld/s\n", name, cost_us, op_cnt * 1000000 / cost_us);
+  }
+
+  // the k-th transaction of thread i
+  static ObTransID tx_id(const int64_t i, const int64_t k) { return ObTransID(k * THREAD_CNT + i + 1); }
+
+  void do_work(const int64_t idx)
+  {
+    uint64_t seed = idx + 1;
+    int64_t get_succ_cnt = 0;
+    int64_t get_fail_cnt = 0;
+    for (int64_t k = 0; k < TX_CNT + INFLIGHT_CNT; k++) {
+      if (k < TX_CNT) {
+        ObTransTestValue *val = NULL;
+        ObTransTestValue *old = NULL;
+        ASSERT_EQ(OB_SUCCESS, map_->alloc_value(val));
+        ASSERT_EQ(OB_SUCCESS, val->init(tx_id(idx, k)));
+        ASSERT_EQ(OB_SUCCESS, map_->insert_and_get(tx_id(idx, k), val, &old));
+        map_->revert(val);
+        for (int64_t j = 0; j < GET_CNT; j++) {
+          seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+          const int64_t thread = (seed >> 33) % THREAD_CNT;
+          const int64_t tx = k - (int64_t)((seed >> 17) % INFLIGHT_CNT);
+          ObTransTestValue *tmp = NULL;
+          if (tx < 0) {
+          } else if (OB_SUCCESS == map_->get(tx_id(thread, tx), tmp)) {
+            ASSERT_TRUE(tmp->is_valid());
+            ASSERT_EQ(tx_id(thread, tx), tmp->get_trans_id());
+            map_->revert(tmp);
+            get_succ_cnt++;
+          } else {
+            // the transactions of this thread in flight must be found
+            ASSERT_NE(thread, idx);
+            get_fail_cnt++;
+          }
+        }
+      }
+      if (k >= INFLIGHT_CNT) {
+        ObTransTestValue *tmp = NULL;
+        ASSERT_EQ(OB_SUCCESS, map_->get(tx_id(idx, k - INFLIGHT_CNT), tmp));
+        ASSERT_EQ(OB_SUCCESS, map_->del(tx_id(idx, k - INFLIGHT_CNT), tmp));
+        map_->revert(tmp);
+      }
+    }
+    ATOMIC_AAF(&get_succ_cnt_, get_succ_cnt);
+    ATOMIC_AAF(&get_fail_cnt_, get_fail_cnt);
+  }
+private:
+  HashMap *map_;
+  int64_t get_succ_cnt_;
+  int64_t get_fail_cnt_;
+};
+
+TEST_F(TestObTransResizableHashMap, stress)
+{
+  TRANS_LOG(INFO, "called", "func", test_info_->name());
+  StressTester<TestHashMap> tester;
+  tester.run("resizable");
+}
+
+TEST_F(TestObTransResizableHashMap, stress_fixed_buckets)
+{
+  TRANS_LOG(INFO, "called", "func", test_info_->name());
+  StressTester<TestFixedHashMap> tester;
+  tester.run("fixed");
+}
+
+}//end of unittest
+}//end of oceanbase
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+
+int main(int argc, char **argv)
+{
+  int ret = 1;
+  ObLogger &logger = ObLogger::get_logger();
+  logger.set_file_name("test_ob_trans_resizable_hashmap.log", true);
+  logger.set_log_level(OB_LOG_LEVEL_INFO);
+  testing::InitGoogleTest(&argc, argv);
+  ret = RUN_ALL_TESTS();
+  return ret;
+}